@@ -964,6 +964,53 @@ operator*(const MatrixBase<E1>& m1, const MatrixBase<E2>& m2) {
 
 /// @}
 
+/// @name Real matrix and vector products using the BLAS
+/// When all the elements are Real these non-template overloads are chosen
+/// instead of the templates above. If the operands' elements are laid out
+/// regularly in memory (as they are for any Matrix_, Vector_, or RowVector_,
+/// their transposes, and most of their views) the work is done by the BLAS
+/// routines dgemm(), dgemv(), ddot(), daxpy(), and dscal(); otherwise the
+/// calculation is done element by element.
+///
+/// The multiplyAdd() and scaleAdd() functions update an existing result in
+/// place, so an expression like y = a*x + b*y or C = C - A*~A can be 
+/// evaluated without creating heap temporaries. The result must not share
+/// memory with any of the other operands; if it does, the calculation still
+/// gives the right answer but uses a temporary.
+/// @{
+
+/// Dot product of a row and a column, using ddot().
+SimTK_SimTKCOMMON_EXPORT Real
+operator*(const RowVectorBase<Real>& r, const VectorBase<Real>& v);
+
+/// Matrix times column, using dgemv().
+SimTK_SimTKCOMMON_EXPORT Vector_<Real>
+operator*(const MatrixBase<Real>& m, const VectorBase<Real>& v);
+
+/// Matrix product, using dgemm().
+SimTK_SimTKCOMMON_EXPORT Matrix_<Real>
+operator*(const MatrixBase<Real>& m1, const MatrixBase<Real>& m2);
+
+/// Calculate C = alpha*A*B + beta*C, where C must already have the right
+/// size. If \a beta is zero, C's original contents are ignored. A or B can 
+/// be transposed views (for example, pass ~A as B for a rank-k update).
+SimTK_SimTKCOMMON_EXPORT void
+multiplyAdd(Real alpha, const MatrixBase<Real>& A, const MatrixBase<Real>& B,
+            Real beta,  MatrixBase<Real>& C);
+
+/// Calculate y = alpha*A*x + beta*y, where y must already have the right
+/// size. If \a beta is zero, y's original contents are ignored.
+SimTK_SimTKCOMMON_EXPORT void
+multiplyAdd(Real alpha, const MatrixBase<Real>& A, const VectorBase<Real>& x,
+            Real beta,  VectorBase<Real>& y);
+
+/// Calculate y = alpha*x + beta*y, where x and y must be the same size. If
+/// \a beta is zero, y's original contents are ignored.
+SimTK_SimTKCOMMON_EXPORT void
+scaleAdd(Real alpha, const VectorBase<Real>& x, Real beta, VectorBase<Real>& y);
+
+/// @}
+
 // This "private" static method is used to implement VectorView's 
 // fillVectorViewFromStream() and Vector's readVectorFromStream() 
 // namespace-scope static methods, which are in turn used to implement 
@@ -0,0 +1,293 @@
+/* -------------------------------------------------------------------------- *
+ *                       Simbody(tm): SimTKcommon                             *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Implementation of the Real-element matrix and vector products declared in
+BigMatrix.h. These hand the work to the BLAS whenever the operands' elements
+can be described to it, that is, as a column- or row-ordered array with a
+leading dimension (matrices) or a positive stride (vectors). Anything else
+is done element by element, as the generic templates would have done. */
+
+#include "SimTKcommon/Scalar.h"
+#include "SimTKcommon/SmallMatrix.h"
+#include "SimTKcommon/internal/BigMatrix.h"
+#include "SimTKcommon/TemplatizedLapack.h"
+
+#include <limits>
+
+namespace SimTK {
+
+namespace {
+
+// How a matrix's elements are laid out, in BLAS terms. If trans is 'N'
+// element (i,j) is at data[i + j*ld]; if 'T' it is at data[i*ld + j].
+struct BlasMatrix {
+    const Real* data;
+    char        trans;
+    int         ld;
+    const Real* first() const {return data;}
+    const Real* last(int nr, int nc) const {
+        return trans=='N' ? data + (nr-1) + ptrdiff_t(nc-1)*ld
+                          : data + ptrdiff_t(nr-1)*ld + (nc-1);
+    }
+};
+
+// A vector's elements are at data[i*inc], with inc > 0.
+struct BlasVector {
+    const Real* data;
+    int         inc;
+    const Real* first() const {return data;}
+    const Real* last(int n) const {return data + ptrdiff_t(n-1)*inc;}
+};
+
+bool fitsInInt(ptrdiff_t n)
+{   return 0 < n && n <= std::numeric_limits<int>::max(); }
+
+// Find out whether the nonempty matrix m can be passed to the BLAS. This
+// requires full storage of the elements with one of the two indices having
+// unit stride.
+bool findBlasLayout(const MatrixBase<Real>& m, BlasMatrix& layout) {
+    const int nr = m.nrow(), nc = m.ncol();
+    assert(nr > 0 && nc > 0);
+    if (m.getMatrixCharacter().getStorage().getPacking()
+        != MatrixStorage::Full)
+        return false;
+
+    const Real* data = &m(0,0);
+    const ptrdiff_t rowStride = nr > 1 ? &m(1,0) - data : 1;
+    // A single column is treated as stored by rows if it isn't contiguous.
+    const ptrdiff_t colStride = nc > 1 ? &m(0,1) - data
+                                       : (rowStride == 1 ? nr : 1);
+
+    if (rowStride == 1 && colStride >= nr && fitsInInt(colStride))
+        layout.trans = 'N', layout.ld = int(colStride);
+    else if (colStride == 1 && rowStride >= nc && fitsInInt(rowStride))
+        layout.trans = 'T', layout.ld = int(rowStride);
+    else
+        return false;
+
+    layout.data = data;
+    // Double check that the last element is where it should be.
+    return &m(nr-1,nc-1) == layout.last(nr,nc);
+}
+
+// Any nonempty vector can be passed to the BLAS if its elements are stored
+// in increasing memory order.
+template <class V>
+bool findBlasLayout(const V& v, int n, BlasVector& layout) {
+    assert(n > 0);
+    const Real* data = &v[0];
+    const ptrdiff_t stride = n > 1 ? &v[1] - data : 1;
+    if (!fitsInInt(stride))
+        return false;
+    layout.data = data; layout.inc = int(stride);
+    return &v[n-1] == layout.last(n);
+}
+
+char flip(char trans) {return trans=='N' ? 'T' : 'N';}
+
+// Do the address ranges spanned by two operands overlap?
+bool overlaps(const Real* first1, const Real* last1,
+              const Real* first2, const Real* last2)
+{   return !(last1 < first2 || last2 < first1); }
+
+// Element-by-element versions, used when the BLAS can't be.
+Real slowDot(const RowVectorBase<Real>& r, const VectorBase<Real>& v) {
+    Real sum(0);
+    for (int j=0; j < r.ncol(); ++j)
+        sum += r[j] * v[j];
+    return sum;
+}
+
+void slowMultiplyInto(const MatrixBase<Real>& A, const VectorBase<Real>& x,
+                      VectorBase<Real>& y) {
+    for (int i=0; i < A.nrow(); ++i) {
+        Real sum(0);
+        for (int j=0; j < A.ncol(); ++j)
+            sum += A(i,j) * x[j];
+        y[i] = sum;
+    }
+}
+
+void slowMultiplyInto(const MatrixBase<Real>& A, const MatrixBase<Real>& B,
+                      MatrixBase<Real>& C) {
+    for (int j=0; j < C.ncol(); ++j)
+        for (int i=0; i < C.nrow(); ++i) {
+            Real sum(0);
+            for (int k=0; k < A.ncol(); ++k)
+                sum += A(i,k) * B(k,j);
+            C(i,j) = sum;
+        }
+}
+
+}   // anonymous namespace
+
+
+
+//==============================================================================
+//                                PRODUCTS
+//==============================================================================
+Real operator*(const RowVectorBase<Real>& r, const VectorBase<Real>& v) {
+    assert(r.ncol() == v.nrow());
+    const int n = r.ncol();
+    if (n == 0) return 0;
+    BlasVector rl, vl;
+    if (findBlasLayout(r, n, rl) && findBlasLayout(v, n, vl))
+        return Lapack::dot<Real>(n, rl.data, rl.inc, vl.data, vl.inc);
+    return slowDot(r, v);
+}
+
+Vector_<Real> operator*(const MatrixBase<Real>& m, const VectorBase<Real>& v) {
+    assert(m.ncol() == v.nrow());
+    Vector_<Real> res(m.nrow());
+    multiplyAdd(1, m, v, 0, res);
+    return res;
+}
+
+Matrix_<Real> operator*(const MatrixBase<Real>& m1, const MatrixBase<Real>& m2) {
+    assert(m1.ncol() == m2.nrow());
+    Matrix_<Real> res(m1.nrow(), m2.ncol());
+    multiplyAdd(1, m1, m2, 0, res);
+    return res;
+}
+
+
+
+//==============================================================================
+//                        IN-PLACE UPDATE OPERATIONS
+//==============================================================================
+void multiplyAdd(Real alpha, const MatrixBase<Real>& A,
+                 const MatrixBase<Real>& B, Real beta, MatrixBase<Real>& C) {
+    SimTK_ERRCHK4_ALWAYS(A.ncol()==B.nrow(), "multiplyAdd()",
+        "Can't multiply a %dx%d matrix by a %dx%d one.",
+        A.nrow(), A.ncol(), B.nrow(), B.ncol());
+    SimTK_ERRCHK4_ALWAYS(C.nrow()==A.nrow() && C.ncol()==B.ncol(),
+        "multiplyAdd()", "The product is %dx%d but the result is %dx%d.",
+        A.nrow(), B.ncol(), C.nrow(), C.ncol());
+
+    const int m = C.nrow(), n = C.ncol(), k = A.ncol();
+    if (m == 0 || n == 0) return;
+
+    BlasMatrix al, bl, cl;
+    const bool blasOK = k > 0 && findBlasLayout(A, al) && findBlasLayout(B, bl);
+    if (blasOK && findBlasLayout(C, cl)
+        && !overlaps(cl.first(), cl.last(m,n), al.first(), al.last(m,k))
+        && !overlaps(cl.first(), cl.last(m,n), bl.first(), bl.last(k,n)))
+    {
+        Real* c = const_cast<Real*>(cl.data);
+        if (cl.trans == 'N')
+            Lapack::gemm<Real>(al.trans, bl.trans, m, n, k,
+                               alpha, al.data, al.ld, bl.data, bl.ld,
+                               beta, c, cl.ld);
+        else // C is stored by rows; calculate ~C = ~B*~A instead.
+            Lapack::gemm<Real>(flip(bl.trans), flip(al.trans), n, m, k,
+                               alpha, bl.data, bl.ld, al.data, al.ld,
+                               beta, c, cl.ld);
+        return;
+    }
+
+    // Form the product separately, then combine.
+    Matrix_<Real> AB(m, n);
+    if (k == 0) AB = 0;
+    else if (blasOK)
+        Lapack::gemm<Real>(al.trans, bl.trans, m, n, k,
+                           1, al.data, al.ld, bl.data, bl.ld,
+                           0, &AB(0,0), m);
+    else slowMultiplyInto(A, B, AB);
+
+    for (int j=0; j < n; ++j)
+        for (int i=0; i < m; ++i)
+            C(i,j) = beta == 0 ? alpha*AB(i,j) : alpha*AB(i,j) + beta*C(i,j);
+}
+
+void multiplyAdd(Real alpha, const MatrixBase<Real>& A,
+                 const VectorBase<Real>& x, Real beta, VectorBase<Real>& y) {
+    SimTK_ERRCHK3_ALWAYS(A.ncol()==x.nrow(), "multiplyAdd()",
+        "Can't multiply a %dx%d matrix by a vector of length %d.",
+        A.nrow(), A.ncol(), x.nrow());
+    SimTK_ERRCHK2_ALWAYS(y.nrow()==A.nrow(), "multiplyAdd()",
+        "The product has length %d but the result has length %d.",
+        A.nrow(), y.nrow());
+
+    const int m = A.nrow(), n = A.ncol();
+    if (m == 0) return;
+
+    BlasMatrix al; BlasVector xl, yl;
+    const bool blasOK = n > 0 && findBlasLayout(A, al)
+                     && findBlasLayout(x, n, xl) && findBlasLayout(y, m, yl);
+    if (blasOK && !overlaps(yl.first(), yl.last(m), al.first(), al.last(m,n))
+               && !overlaps(yl.first(), yl.last(m), xl.first(), xl.last(n)))
+    {
+        // The BLAS wants the dimensions of the stored array, which are
+        // swapped if A is stored by rows.
+        if (al.trans == 'N')
+            Lapack::gemv<Real>('N', m, n, alpha, al.data, al.ld,
+                               xl.data, xl.inc,
+                               beta, const_cast<Real*>(yl.data), yl.inc);
+        else
+            Lapack::gemv<Real>('T', n, m, alpha, al.data, al.ld,
+                               xl.data, xl.inc,
+                               beta, const_cast<Real*>(yl.data), yl.inc);
+        return;
+    }
+
+    Vector_<Real> Ax(m);
+    if (n == 0) Ax = 0;
+    else slowMultiplyInto(A, x, Ax);
+    for (int i=0; i < m; ++i)
+        y[i] = beta == 0 ? alpha*Ax[i] : alpha*Ax[i] + beta*y[i];
+}
+
+void scaleAdd(Real alpha, const VectorBase<Real>& x, Real beta,
+              VectorBase<Real>& y) {
+    SimTK_ERRCHK2_ALWAYS(x.nrow()==y.nrow(), "scaleAdd()",
+        "The vectors must be the same length but were %d and %d.",
+        x.nrow(), y.nrow());
+
+    const int n = y.nrow();
+    if (n == 0) return;
+
+    BlasVector xl, yl;
+    // x and y may be the same vector, but partial overlap would change x
+    // as we go.
+    if (findBlasLayout(x, n, xl) && findBlasLayout(y, n, yl)
+        && (   (xl.data == yl.data && xl.inc == yl.inc)
+            || !overlaps(xl.first(), xl.last(n), yl.first(), yl.last(n))))
+    {
+        Real* yp = const_cast<Real*>(yl.data);
+        if (beta == 0) {
+            // Don't let the BLAS look at y, which may be garbage.
+            for (int i=0; i < n; ++i) yp[i*yl.inc] = alpha*xl.data[i*xl.inc];
+            return;
+        }
+        if (beta != 1)
+            Lapack::scal<Real>(n, beta, yp, yl.inc);
+        Lapack::axpy<Real>(n, alpha, xl.data, xl.inc, yp, yl.inc);
+        return;
+    }
+
+    const Vector_<Real> xcopy(x);
+    for (int i=0; i < n; ++i)
+        y[i] = beta == 0 ? alpha*xcopy[i] : alpha*xcopy[i] + beta*y[i];
+}
+
+} // namespace SimTK
@@ -220,7 +220,8 @@ public:
         - <tt>.obj </tt>: Wavefront OBJ file
         - <tt>.stl </tt>: 3D Systems Stereolithography file (ascii or binary)
         - <tt>.stla</tt>: ascii-only stl extension
-        - <tt>.vtp </tt>: VTK PolyData file (we can only read the ascii version)
+        - <tt>.vtp </tt>: VTK PolyData file (ascii, binary, or appended data,
+                          but not compressed)
 
     @param[in]  pathname    The name of a mesh file with a recognized extension.
     **/
@@ -242,6 +243,8 @@ public:
     /** Load a VTK PolyData (.vtp) file, adding the vertices and faces it 
     contains to this mesh and ignoring anything else in the file. The suffix 
     for these files is typically ".vtp" but we don't check here.
+    DataArrays may use the ascii, binary (base64), or appended (raw or
+    base64) formats; compressed files are not supported.
     @param[in]  pathname    The name of a .vtp file. **/
     void loadVtpFile(const String& pathname);
 
@@ -26,10 +26,17 @@
 #include "SimTKcommon/internal/String.h"
 #include "SimTKcommon/internal/Pathname.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <sstream>
 #include <string>
 #include <set>
+#include <vector>
 #include <map>
 #include <fstream>
 
@@ -135,13 +142,98 @@ void PolygonalMesh::loadFile(const String& pathname) {
     }
 }
 
+//------------------------------------------------------------------------------
+//                              PARSING HELPERS
+//------------------------------------------------------------------------------
+// Mesh files can be very large (millions of faces), so rather than reading
+// them a line at a time through formatted streams we read the whole file into
+// memory once and then scan it with these simple pointer-based helpers. The
+// buffer is always a std::string so there is a terminating null character
+// following the contents, which the scanners rely on.
+namespace {
+
+// Read everything that remains in the given stream into contents.
+void readStreamContents(std::istream& in, std::string& contents) {
+    contents.clear();
+    const std::istream::pos_type start = in.tellg();
+    if (start != std::istream::pos_type(-1)) {
+        in.seekg(0, std::ios_base::end);
+        const std::istream::pos_type end = in.tellg();
+        in.seekg(start);
+        if (end != std::istream::pos_type(-1) && end > start)
+            contents.reserve((size_t)(end - start));
+    }
+    char buf[64*1024];
+    while (in.read(buf, sizeof(buf)) || in.gcount() > 0)
+        contents.append(buf, (size_t)in.gcount());
+}
+
+// Read an entire file into memory, in binary mode so that nothing is
+// translated. Returns false if the file can't be opened or read.
+bool readFileContents(const String& pathname, std::string& contents) {
+    std::ifstream ifs(pathname, std::ios_base::binary);
+    if (!ifs.good()) return false;
+    readStreamContents(ifs, contents);
+    return !ifs.bad();
+}
+
+// Whitespace other than a newline.
+inline bool isBlank(char c)
+{   return c==' ' || c=='\t' || c=='\r' || c=='\v' || c=='\f'; }
+
+// A backslash that ends a line means the line continues on the next one.
+// Returns the number of characters in the continuation, or 0 if there
+// isn't one at p.
+inline int continuationLength(const char* p) {
+    if (*p != '\\') return 0;
+    if (p[1] == '\n') return 2;
+    if (p[1] == '\r' && p[2] == '\n') return 3;
+    return 0;
+}
+
+// Skip blanks and line continuations, but don't go past the end of a line.
+inline void skipBlanks(const char*& p) {
+    for (;;) {
+        if (isBlank(*p)) {++p; continue;}
+        const int n = continuationLength(p);
+        if (n == 0) return;
+        p += n;
+    }
+}
+
+// True if p is at the end of a line (or of the buffer).
+inline bool isEndOfLine(const char* p, const char* end)
+{   return p >= end || *p == '\n'; }
+
+// Move p to the start of the next line, honoring line continuations.
+inline void skipToNextLine(const char*& p, const char* end) {
+    while (p < end && *p != '\n') {
+        const int n = continuationLength(p);
+        p += n ? n : 1;
+    }
+    if (p < end) ++p;
+}
+
+// Parse a floating point number starting at p, which must not be at
+// whitespace (strtod() would happily skip newlines). On success p is moved
+// past the number and true is returned.
+inline bool parseReal(const char*& p, Real& value) {
+    char* numEnd;
+    value = (Real)std::strtod(p, &numEnd);
+    if (numEnd == p) return false;
+    p = numEnd;
+    return true;
+}
+
+}
+
 //------------------------------------------------------------------------------
 //                              LOAD OBJ FILE
 //------------------------------------------------------------------------------
 
 // For the pathname signature just open and punt to the istream signature.
 void PolygonalMesh::loadObjFile(const String& pathname) {
-    std::ifstream ifs(pathname);
+    std::ifstream ifs(pathname, std::ios_base::binary);
     SimTK_ERRCHK1_ALWAYS(ifs.good(), "PolygonalMesh::loadObjFile()",
         "Failed to open file '%s'", pathname.c_str());
     loadObjFile(ifs);
@@ -154,49 +246,64 @@ void PolygonalMesh::loadObjFile(std::istream& file) {
         "The supplied std::istream object was not in good condition"
         " on entrance -- did you check whether it opened successfully?");
 
-    std::string line;
-    Array_<int> indices;
-    int initialVertices = getNumVertices();
-    while (!file.eof()) {
-        SimTK_ERRCHK_ALWAYS(file.good(), methodName,
-            "An error occurred while reading the input file.");
-
-        std::getline(file, line);
-        while (line.size() > 0 && line[line.size()-1] == '\\') {
-            line[line.size()-1] = ' ';
-            std::string continuation;
-            std::getline(file, continuation);
-            line += continuation;
-        }
-        std::stringstream s(line);
-        std::string command;
-        s >> command;
-        if (command == "v") {
+    std::string contents;
+    readStreamContents(file, contents);
+    SimTK_ERRCHK_ALWAYS(!file.bad(), methodName,
+        "An error occurred while reading the input file.");
+
+    initializeHandleIfEmpty();
+    PolygonalMeshImpl& impl = updImpl();
+    const int initialVertices = getNumVertices();
+
+    const char* p = contents.c_str();
+    const char* const end = p + contents.size();
+    while (p < end) {
+        const char* const line = p;
+        skipBlanks(p);
+        // The command must be followed by whitespace or end of line.
+        const char command = *p;
+        const bool isCommand = (command=='v' || command=='f')
+            && (   isBlank(p[1]) || continuationLength(p+1)
+                || isEndOfLine(p+1, end));
+        if (isCommand && command == 'v') {
             // A vertex
-            
-            Real x, y, z;
-            s >> x;
-            s >> y;
-            s >> z;
-            SimTK_ERRCHK1_ALWAYS(!s.fail(), methodName,
-                "Found invalid vertex description: %s", line.c_str());
-            addVertex(Vec3(x, y, z));
+            ++p;
+            Vec3 v;
+            for (int i=0; i < 3; ++i) {
+                skipBlanks(p);
+                if (isEndOfLine(p, end) || !parseReal(p, v[i])) {
+                    const char* lineEnd = line;
+                    skipToNextLine(lineEnd, end);
+                    SimTK_ERRCHK1_ALWAYS(!"bad vertex", methodName,
+                        "Found invalid vertex description: %s",
+                        std::string(line, lineEnd).c_str());
+                }
+            }
+            impl.vertices.push_back(v);
         }
-        else if (command == "f") {
-            // A face
-            
-            indices.clear();
-            int index;
-            while (s >> index) {
-                s.ignore(line.size(), ' ');
+        else if (isCommand && command == 'f') {
+            // A face. Each entry is v, v/vt, v//vn, or v/vt/vn; we only
+            // care about the leading vertex number.
+            ++p;
+            for (;;) {
+                skipBlanks(p);
+                if (isEndOfLine(p, end)) break;
+                char* numEnd;
+                long index = std::strtol(p, &numEnd, 10);
+                if (numEnd == p) break;
+                p = numEnd;
+                while (!isEndOfLine(p, end) && !isBlank(*p)
+                       && !continuationLength(p))
+                    ++p;
                 if (index < 0)
-                    index += getNumVertices()-initialVertices;
+                    index += (long)impl.vertices.size()-initialVertices;
                 else
                     index--;
-                indices.push_back(index);
+                impl.faceVertexIndex.push_back((int)index);
             }
-            addFace(indices);
+            impl.faceVertexStart.push_back(impl.faceVertexIndex.size());
         }
+        skipToNextLine(p, end);
     }
 }
 
@@ -232,6 +339,7 @@ and Polys elements.
                 <Polys>...</Polys>
             </Piece>
         </PolyData>
+        <AppendedData encoding="raw">_...</AppendedData>
     </VTKFile>
 
 PointData and CellData -- Every dataset describes the data associated with 
@@ -279,9 +387,7 @@ DataArray -- All of the data and geometry specifications use DataArray elements
 to describe their actual content as follows:
 
 The DataArray element stores a sequence of values of one type. There may be 
-one or more components per value. [Simbody Note: there are also "binary" and
-"appended" formats which we do not support -- be sure to check that the
-format attribute for every DataArray is "ascii".]
+one or more components per value.
     <DataArray type="Int32" Name="offsets" format="ascii">
     10 20 30 ... </DataArray>
 
@@ -294,15 +400,253 @@ The attributes of the DataArray elements are described as follows:
         DataArray Name attribute to figure out what's being provided.]
     NumberOfComponents -- The number of components per value in the array.
     format -- The means by which the data values themselves are stored in the
-        file. This is "ascii", "binary", or "appended". [Simbody only supports
-        "ascii".]
+        file. This is "ascii", "binary", or "appended".
+    offset -- If the format attribute is "appended", this specifies the offset
+        from the beginning of the appended data section to the beginning of
+        this array's data.
     format="ascii" -- The data are listed in ASCII directly inside the 
         DataArray element. Whitespace is used for separation.
+    format="binary" -- The data are encoded in base64 and listed contiguously
+        inside the DataArray element.
+    format="appended" -- The data are stored in the AppendedData element,
+        whose encoding attribute is "raw" or "base64". The data section begins
+        after the first underscore in that element's content.
+
+Binary data (inline or appended) begins with a header giving the number of
+bytes of data that follow; the header_type attribute of the VTKFile element
+says whether that count is a UInt32 (the default) or a UInt64. The byte_order
+attribute of VTKFile says whether values are "LittleEndian" or "BigEndian".
+[Simbody Note: we don't support the optional compression of binary data;
+that is indicated by a "compressor" attribute on the VTKFile element.]
+
+Raw appended data is not legal XML so we cut it out of the file before handing
+the rest to the XML parser.
 */
+namespace {
+
+// Maps base64 characters to their 6-bit values, and everything else to -1.
+struct Base64Table {
+    Base64Table() {
+        for (int i=0; i < 256; ++i) value[i] = -1;
+        const char* alphabet =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int i=0; i < 64; ++i) value[(unsigned char)alphabet[i]] = i;
+    }
+    signed char value[256];
+};
+
+// Decode base64 characters starting at p and append the bytes to out until
+// at least "want" bytes are present in out or we run out of input. Each
+// group of four characters is decoded independently so it doesn't matter
+// whether the encoder restarted (with padding) between the header and the
+// data as some VTK versions do. Returns a pointer just past the last group
+// consumed.
+const char* decodeBase64(const char* p, const char* end, size_t want,
+                         std::string& out) {
+    // Function-local statics are initialized exactly once, thread safely.
+    static const Base64Table table;
+    int quad[4]; int nq = 0, npad = 0;
+    while (p < end && out.size() < want) {
+        const unsigned char c = (unsigned char)*p++;
+        if (c == '=') {quad[nq++] = 0; ++npad;}
+        else if (table.value[c] >= 0) quad[nq++] = table.value[c];
+        else continue; // whitespace or junk
+        if (nq < 4) continue;
+        const unsigned bits = (quad[0]<<18) | (quad[1]<<12)
+                              | (quad[2]<<6) | quad[3];
+        const char bytes[3] = {char(bits>>16), char(bits>>8), char(bits)};
+        out.append(bytes, npad >= 3 ? 0 : 3-npad);
+        nq = npad = 0;
+    }
+    return p;
+}
+
+// Everything we need to know about the VTKFile to decode its DataArrays.
+struct VtkDataSource {
+    bool            headerIs64;     // header_type="UInt64"
+    bool            swapBytes;      // file byte order is not ours
+    bool            appendedIsRaw;  // AppendedData encoding="raw"
+    const char*     appendedBegin;  // just past the '_'
+    const char*     appendedEnd;
+};
+
+// Copy a value of type S from src, which need not be aligned, reversing its
+// bytes if swap is set, and convert it to type T.
+template <class S, class T> inline void
+convertBinaryValue(const unsigned char* src, bool swap, T& dest) {
+    unsigned char bytes[sizeof(S)];
+    if (swap) {for (unsigned i=0; i < sizeof(S); ++i)
+                   bytes[i] = src[sizeof(S)-1-i];}
+    else std::memcpy(bytes, src, sizeof(S));
+    S value; std::memcpy(&value, bytes, sizeof(S));
+    dest = (T)value;
+}
+
+// Convert all the complete values of type S in [p,end) to T and append them.
+template <class S, class T> void
+appendBinaryValues(const unsigned char* p, const unsigned char* end,
+                   bool swap, Array_<T>& values) {
+    values.reserve(values.size() + (end-p)/sizeof(S));
+    T value;
+    for (; p + sizeof(S) <= end; p += sizeof(S)) {
+        convertBinaryValue<S>(p, swap, value);
+        values.push_back(value);
+    }
+}
+
+// Dispatch on the VTK type name. Returns false if it isn't recognized.
+template <class T> bool
+appendBinaryValues(const String& vtkType, const unsigned char* p,
+                   const unsigned char* end, bool swap, Array_<T>& values) {
+    if      (vtkType=="Float32") appendBinaryValues<float>   (p,end,swap,values);
+    else if (vtkType=="Float64") appendBinaryValues<double>  (p,end,swap,values);
+    else if (vtkType=="Int32")   appendBinaryValues<int32_t> (p,end,swap,values);
+    else if (vtkType=="UInt32")  appendBinaryValues<uint32_t>(p,end,swap,values);
+    else if (vtkType=="Int64")   appendBinaryValues<int64_t> (p,end,swap,values);
+    else if (vtkType=="UInt64")  appendBinaryValues<uint64_t>(p,end,swap,values);
+    else if (vtkType=="Int16")   appendBinaryValues<int16_t> (p,end,swap,values);
+    else if (vtkType=="UInt16")  appendBinaryValues<uint16_t>(p,end,swap,values);
+    else if (vtkType=="Int8")    appendBinaryValues<int8_t>  (p,end,swap,values);
+    else if (vtkType=="UInt8")   appendBinaryValues<uint8_t> (p,end,swap,values);
+    else return false;
+    return true;
+}
+
+// Given binary data that starts with a header containing the number of
+// bytes that follow, return in nbytes the number of data bytes claimed by
+// the header. Returns false if there isn't enough data for the header.
+bool getBinaryByteCount(const VtkDataSource& src, const std::string& data,
+                        size_t& nbytes) {
+    const unsigned char* p = (const unsigned char*)data.data();
+    if (src.headerIs64) {
+        if (data.size() < 8) return false;
+        uint64_t n; convertBinaryValue<uint64_t>(p, src.swapBytes, n);
+        nbytes = (size_t)n;
+    } else {
+        if (data.size() < 4) return false;
+        uint32_t n; convertBinaryValue<uint32_t>(p, src.swapBytes, n);
+        nbytes = (size_t)n;
+    }
+    return true;
+}
+
+// Read the contents of a DataArray element in any of the supported formats,
+// converting its values to type T.
+template <class T> void
+readVtkDataArray(const VtkDataSource& src, const Xml::Element& array,
+                 Array_<T>& values) {
+    const char* method = "PolygonalMesh::loadVtpFile()";
+    const String& name = array.getOptionalAttributeValue("Name");
+    const String& format = array.getRequiredAttributeValue("format");
+    values.clear();
+
+    if (format == "ascii") {
+        const String& text = array.getValue();
+        const char* p = text.c_str();
+        for (;;) {
+            while (*p && std::isspace((unsigned char)*p)) ++p;
+            if (!*p) break;
+            Real value;
+            SimTK_ERRCHK1_ALWAYS(parseReal(p, value), method,
+                "Bad value in ascii DataArray '%s'.", name.c_str());
+            values.push_back((T)value);
+        }
+        return;
+    }
+
+    const size_t headerSize = src.headerIs64 ? 8 : 4;
+    std::string data; // header followed by the array data
+    size_t nbytes = 0;
+    if (format == "binary") {
+        const String& text = array.getValue();
+        decodeBase64(text.c_str(), text.c_str()+text.size(),
+                     (size_t)-1, data);
+        SimTK_ERRCHK1_ALWAYS(getBinaryByteCount(src, data, nbytes), method,
+            "Binary DataArray '%s' is too short.", name.c_str());
+    } else if (format == "appended") {
+        SimTK_ERRCHK1_ALWAYS(src.appendedBegin != 0, method,
+            "DataArray '%s' refers to appended data but there is no"
+            " <AppendedData> element.", name.c_str());
+        const size_t offset =
+            array.getRequiredAttributeValueAs<size_t>("offset");
+        const size_t available = src.appendedEnd - src.appendedBegin;
+        SimTK_ERRCHK2_ALWAYS(offset < available, method,
+            "Offset %llu for DataArray '%s' is past the end of the"
+            " appended data.", (unsigned long long)offset, name.c_str());
+        const char* begin = src.appendedBegin + offset;
+        if (src.appendedIsRaw) {
+            data.assign(begin, std::min(headerSize, available-offset));
+            SimTK_ERRCHK1_ALWAYS(getBinaryByteCount(src, data, nbytes), method,
+                "Appended data for DataArray '%s' is too short.",
+                name.c_str());
+            data.assign(begin,
+                        std::min(headerSize+nbytes, available-offset));
+        } else {
+            const char* p =
+                decodeBase64(begin, src.appendedEnd, headerSize, data);
+            SimTK_ERRCHK1_ALWAYS(getBinaryByteCount(src, data, nbytes), method,
+                "Appended data for DataArray '%s' is too short.",
+                name.c_str());
+            decodeBase64(p, src.appendedEnd, headerSize+nbytes, data);
+        }
+    } else {
+        SimTK_ERRCHK2_ALWAYS(!"bad format", method,
+            "Unrecognized format=\"%s\" for DataArray '%s'; expected"
+            " ascii, binary, or appended.", format.c_str(), name.c_str());
+    }
+
+    SimTK_ERRCHK3_ALWAYS(data.size() >= headerSize+nbytes, method,
+        "DataArray '%s' should have %llu bytes of data but only %llu"
+        " were present.", name.c_str(), (unsigned long long)nbytes,
+        (unsigned long long)(data.size()-headerSize));
+
+    const String& type = array.getRequiredAttributeValue("type");
+    const unsigned char* p = (const unsigned char*)data.data() + headerSize;
+    SimTK_ERRCHK2_ALWAYS(
+        appendBinaryValues(type, p, p+nbytes, src.swapBytes, values), method,
+        "Unrecognized type=\"%s\" for DataArray '%s'.",
+        type.c_str(), name.c_str());
+}
+
+bool isLittleEndianMachine() {
+    const uint16_t one = 1;
+    return *(const unsigned char*)&one == 1;
+}
+
+}
+
 void PolygonalMesh::loadVtpFile(const String& pathname) {
   try
   { const char* method = "PolygonalMesh::loadVtpFile()";
-    Xml::Document vtp(pathname);
+    std::string contents;
+    SimTK_ERRCHK1_ALWAYS(readFileContents(pathname, contents), method,
+        "Failed to open file '%s'", pathname.c_str());
+
+    // If there is appended data, remove its contents from what we give to
+    // the XML parser; we'll decode it ourselves. This is required for raw
+    // data and much faster for base64 data.
+    VtkDataSource src;
+    src.appendedBegin = src.appendedEnd = 0;
+    const size_t appendedTag = contents.find("<AppendedData");
+    std::string xmlText;
+    if (appendedTag != std::string::npos) {
+        const size_t tagEnd = contents.find('>', appendedTag);
+        const size_t closeTag = contents.rfind("</AppendedData>");
+        const size_t underscore = contents.find('_', tagEnd);
+        if (   tagEnd != std::string::npos && contents[tagEnd-1] != '/'
+            && closeTag != std::string::npos && closeTag > tagEnd
+            && underscore < closeTag)
+        {
+            src.appendedBegin = contents.c_str() + underscore + 1;
+            src.appendedEnd   = contents.c_str() + closeTag;
+            xmlText.reserve(contents.size() - (closeTag-tagEnd));
+            xmlText.append(contents, 0, tagEnd+1);
+            xmlText.append(contents, closeTag, std::string::npos);
+        }
+    }
+
+    Xml::Document vtp;
+    vtp.readFromString(src.appendedBegin ? xmlText.c_str() : contents.c_str());
     // The file has been read in and parsed into memory by the Xml system.
 
     SimTK_ERRCHK1_ALWAYS(vtp.getRootTag() == "VTKFile", method,
@@ -316,6 +660,26 @@ void PolygonalMesh::loadVtpFile(const String& pathname) {
         root.getRequiredAttributeValue("type").c_str());
     // This is a VTK PolyData document.
 
+    SimTK_ERRCHK1_ALWAYS(root.getOptionalAttributeValue("compressor").empty(),
+        method, "Compressed .vtp files are not supported (compressor='%s').",
+        root.getOptionalAttributeValue("compressor").c_str());
+    src.headerIs64 =
+        root.getOptionalAttributeValue("header_type", "UInt32") == "UInt64";
+    const bool fileIsLittleEndian =
+        root.getOptionalAttributeValue("byte_order", "LittleEndian")
+            != "BigEndian";
+    src.swapBytes = fileIsLittleEndian != isLittleEndianMachine();
+    src.appendedIsRaw = false;
+    if (src.appendedBegin) {
+        Xml::Element appended = root.getRequiredElement("AppendedData");
+        const String& encoding =
+            appended.getOptionalAttributeValue("encoding", "base64");
+        SimTK_ERRCHK1_ALWAYS(encoding=="raw" || encoding=="base64", method,
+            "Unrecognized AppendedData encoding '%s'; expected raw or"
+            " base64.", encoding.c_str());
+        src.appendedIsRaw = (encoding == "raw");
+    }
+
     Xml::Element polydata = root.getRequiredElement("PolyData");
     Xml::Element piece    = polydata.getRequiredElement("Piece");
     Xml::Element points   = piece.getRequiredElement("Points");
@@ -324,32 +688,22 @@ void PolygonalMesh::loadVtpFile(const String& pathname) {
     const int numPolys  = 
         piece.getRequiredAttributeValueAs<int>("NumberOfPolys");
 
-    // Remember this because we'll have to use it to adjust the indices we use 
-    // when referencing the vertices we're about to read in. This number is
-    // the index that our first vertex will be assigned.
-    // EDIT: We actually don't use this variable. Leaving for reference.
-    // TODO const int firstVertex = getNumVertices();
-
     // The lone DataArray element in the Points element contains the points'
-    // coordinates. Read it in as a Vector of Vec3s.
-    Xml::Element pointData = points.getRequiredElement("DataArray");
-    SimTK_ERRCHK1_ALWAYS(pointData.getRequiredAttributeValue("format")
-                         == "ascii", method, 
-        "Only format=\"ascii\" is supported for .vtp file DataArray elements,"
-        " got format=\"%s\" for Points DataArray.",
-        pointData.getRequiredAttributeValue("format").c_str());
-
-    Vector_<Vec3> coords = 
-        points.getRequiredElementValueAs< Vector_<Vec3> >("DataArray");
-
-    SimTK_ERRCHK2_ALWAYS(coords.size() == numPoints, method,
+    // coordinates, 3 per point.
+    Array_<Real> coords;
+    readVtkDataArray(src, points.getRequiredElement("DataArray"), coords);
+
+    SimTK_ERRCHK2_ALWAYS((int)coords.size() == 3*numPoints, method,
         "Expected coordinates for %d points but got %d.",
-        numPoints, coords.size());
+        numPoints, (int)coords.size()/3);
 
     // Now that we have the point coordinates, use them to create the vertices
     // in our mesh.
+    initializeHandleIfEmpty();
+    PolygonalMeshImpl& impl = updImpl();
+    impl.vertices.reserve(impl.vertices.size() + numPoints);
     for (int i=0; i < numPoints; ++i)
-        addVertex(coords[i]);
+        impl.vertices.push_back(Vec3(coords[3*i],coords[3*i+1],coords[3*i+2]));
 
     // Polys are given by a connectivity array which lists the points forming
     // each polygon in a long unstructured list, then an offsets array, one per
@@ -363,12 +717,6 @@ void PolygonalMesh::loadVtpFile(const String& pathname) {
          p != polys.element_end(); ++p) 
     {       
         const String& name = p->getRequiredAttributeValue("Name");
-        SimTK_ERRCHK2_ALWAYS(p->getRequiredAttributeValue("format")
-                             == "ascii", method, 
-            "Only format=\"ascii\" is supported for .vtp file DataArray"
-            " elements, but format=\"%s\" for DataArray '%s'.",
-            p->getRequiredAttributeValue("format").c_str(), name.c_str());
-
         if (name == "connectivity") econnectivity = *p;
         else if (name == "offsets") eoffsets = *p; 
     }
@@ -379,9 +727,10 @@ void PolygonalMesh::loadVtpFile(const String& pathname) {
         " least one of them was missing.");
 
     // Read in the arrays.
-    Array_<int> offsets = eoffsets.getValueAs< Array_<int> >();
+    Array_<int> offsets;
+    readVtkDataArray(src, eoffsets, offsets);
     // Size may have changed if file is bad.
-    SimTK_ERRCHK2_ALWAYS(offsets.size() == numPolys, method,
+    SimTK_ERRCHK2_ALWAYS((int)offsets.size() == numPolys, method,
         "The number of offsets (%d) should have matched the stated "
         " NumberOfPolys value (%d).", offsets.size(), numPolys);
 
@@ -389,17 +738,26 @@ void PolygonalMesh::loadVtpFile(const String& pathname) {
     // end of the last polygon described in the connectivity array and hence
     // is the size of the connectivity array.
     const int expectedSize = numPolys ? offsets.back() : 0;
-    Array_<int> connectivity = econnectivity.getValueAs< Array_<int> >();
+    Array_<int> connectivity;
+    readVtkDataArray(src, econnectivity, connectivity);
 
-    SimTK_ERRCHK2_ALWAYS(connectivity.size()==expectedSize, method,
+    SimTK_ERRCHK2_ALWAYS((int)connectivity.size()==expectedSize, method,
         "The connectivity array was the wrong size (%d). It should"
         " match the last entry in the offsets array which was %d.",
         connectivity.size(), expectedSize);
 
+    impl.faceVertexIndex.reserve(impl.faceVertexIndex.size() + expectedSize);
+    impl.faceVertexStart.reserve(impl.faceVertexStart.size() + numPolys);
     int startPoly = 0;
     for (int i=0; i < numPolys; ++i) {
         // Now read in the face in [startOffs,endOffs]
-        addFace(connectivity(startPoly, offsets[i]-startPoly));
+        SimTK_ERRCHK3_ALWAYS(startPoly <= offsets[i]
+                             && offsets[i] <= expectedSize, method,
+            "Offset %d for polygon %d is out of order or out of range"
+            " (previous offset was %d).", offsets[i], i, startPoly);
+        for (int k=startPoly; k < offsets[i]; ++k)
+            impl.faceVertexIndex.push_back(connectivity[k]);
+        impl.faceVertexStart.push_back(impl.faceVertexIndex.size());
         startPoly = offsets[i]; // move to the next poly
     }
 
@@ -413,29 +771,186 @@ void PolygonalMesh::loadVtpFile(const String& pathname) {
 }
 
 //------------------------------------------------------------------------------
-//                              VERTEX MAP
+//                              VERTEX WELDER
 //------------------------------------------------------------------------------
 // This is a local utility class for use in weeding out duplicate vertices.
 // Set an appropriate tolerance in the constructor, then vertices all of
 // whose coordinates are within tol can be considered the same vertex.
-// This uses a map to make the complexity n log n.
+// Vertices are hashed into a grid of cubical cells that are much larger
+// than tol, so a lookup normally examines just one cell and takes expected
+// constant time. Only a vertex that lies within tol of a cell boundary
+// requires a look at the neighboring cell(s) too. The cells are kept in an
+// open-addressed hash table, which is much more cache friendly than a
+// node-based map when there are millions of vertices.
+//
+// Cells are numbered from the first vertex inserted. If the bounding box of
+// the vertices gets so big that the cell numbers could overflow, the cells
+// are enlarged to fit the box and the grid is rebuilt, so vertices that are
+// far apart never end up sharing a cell. Vertices with non-finite coordinates
+// can't match anything so they aren't put in the grid.
 namespace {
-struct VertKey {
-    VertKey(const Vec3& v, Real tol=SignificantReal) : v(v), tol(tol) {}
-    bool operator<(const VertKey& other) const {
-        const Vec3 diff = v - other.v;
-        if (diff[0] < -tol) return true;
-        if (diff[0] >  tol) return false;
-        if (diff[1] < -tol) return true;
-        if (diff[1] >  tol) return false;
-        if (diff[2] < -tol) return true;
-        if (diff[2] >  tol) return false;
-        return false; // they are numerically equal
+class VertexWelder {
+public:
+    explicit VertexWelder(Real tol=SignificantReal)
+    :   tol(tol), oneOverCellSize(1/(64*tol)), numCells(0) {}
+
+    // Avoid rehashing while n vertices are inserted.
+    void reserve(int n) {
+        entries.reserve(n);
+        size_t needed = 16;
+        while (needed < 2*(size_t)n) needed *= 2;
+        if (needed > slots.size()) rehash(needed);
+    }
+
+    // Return the index of a previously inserted vertex that is within
+    // tolerance of v, or -1 if there isn't one.
+    int find(const Vec3& v) const {
+        if (entries.empty() || !v.isFinite()) return -1;
+        long long lo[3], hi[3];
+        for (int i=0; i < 3; ++i) {
+            // Only cells in [-MaxCell,MaxCell] are occupied.
+            const Real clo = cellOf(i, v[i]-tol), chi = cellOf(i, v[i]+tol);
+            if (chi < -MaxCell || clo > MaxCell) return -1;
+            lo[i] = (long long)std::max(clo, -MaxCell);
+            hi[i] = (long long)std::min(chi, MaxCell);
+        }
+        for (long long x=lo[0]; x <= hi[0]; ++x)
+        for (long long y=lo[1]; y <= hi[1]; ++y)
+        for (long long z=lo[2]; z <= hi[2]; ++z) {
+            const Slot& slot = slots[findSlot(x,y,z)];
+            for (int e=slot.head; e >= 0; e=entries[e].next) {
+                const Vec3 diff = entries[e].v - v;
+                if (   std::abs(diff[0]) <= tol && std::abs(diff[1]) <= tol
+                    && std::abs(diff[2]) <= tol)
+                    return entries[e].index;
+            }
+        }
+        return -1;
+    }
+
+    // Record that vertex v has the given index. This doesn't check whether
+    // there is already a matching vertex.
+    void insert(const Vec3& v, int index) {
+        if (!v.isFinite()) return;
+        growToInclude(v);
+        entries.push_back(Entry(v, index));
+        addToGrid((int)entries.size()-1);
+    }
+
+    // Look for a vertex close enough to this one and return its index if
+    // found, otherwise add it to the end of verts and return its new index.
+    int getVertex(const Vec3& v, Array_<Vec3>& verts) {
+        int ix = find(v);
+        if (ix < 0) {
+            ix = (int)verts.size();
+            verts.push_back(v);
+            insert(v, ix);
+        }
+        return ix;
+    }
+
+private:
+    // A cell of the grid, with the first of its vertices; head<0 means
+    // this slot of the hash table is unused.
+    struct Slot {
+        Slot() : head(-1) {c[0]=c[1]=c[2]=0;}
+        long long c[3];
+        int head;
+    };
+    // Vertices in the same cell form a linked list through "next".
+    struct Entry {
+        Entry(const Vec3& v, int index) : v(v), index(index), next(-1) {}
+        Vec3 v; int index; int next;
+    };
+
+    // Cell numbers stay well within the range of a long long.
+    static const Real MaxCell;
+
+    Real cellOf(int i, Real x) const
+    {   return std::floor((x-origin[i])*oneOverCellSize); }
+
+    // Update the bounding box to include v, which is about to be inserted.
+    // If that leaves some vertex more than MaxCell/2 cells from the origin,
+    // make the cells big enough that the box spans only MaxCell/2 of them
+    // and put the existing vertices in their new cells.
+    void growToInclude(const Vec3& v) {
+        if (entries.empty()) {origin = boxLo = boxHi = v; return;}
+        Real extent = 0;
+        for (int i=0; i < 3; ++i) {
+            boxLo[i] = std::min(boxLo[i], v[i]);
+            boxHi[i] = std::max(boxHi[i], v[i]);
+            extent = std::max(extent, std::max(boxHi[i]-origin[i],
+                                               origin[i]-boxLo[i]));
+        }
+        if (extent*oneOverCellSize < MaxCell/2)
+            return;
+        oneOverCellSize = std::min(oneOverCellSize/2, MaxCell/(4*extent));
+        slots.assign(slots.size(), Slot());
+        numCells = 0;
+        for (int e=0; e < (int)entries.size(); ++e)
+            addToGrid(e);
+    }
+
+    // Link entry e into the list for the cell containing it.
+    void addToGrid(int e) {
+        if (2*(numCells+1) > slots.size())
+            rehash(slots.empty() ? 16 : 2*slots.size());
+        const Vec3& v = entries[e].v;
+        const long long x = (long long)cellOf(0, v[0]),
+                        y = (long long)cellOf(1, v[1]),
+                        z = (long long)cellOf(2, v[2]);
+        Slot& slot = slots[findSlot(x,y,z)];
+        if (slot.head < 0) {
+            slot.c[0]=x; slot.c[1]=y; slot.c[2]=z;
+            ++numCells;
+        }
+        entries[e].next = slot.head;
+        slot.head = e;
+    }
+
+    static size_t hash(long long x, long long y, long long z) {
+        // Combine the coordinates, then scramble the bits (this is the
+        // splitmix64 finalizer) since nearby cells differ only slightly.
+        const unsigned long long K = 0x9e3779b97f4a7c15ULL;
+        unsigned long long h = (unsigned long long)x;
+        h = h*K + (unsigned long long)y;
+        h = h*K + (unsigned long long)z;
+        h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return (size_t)(h ^ (h >> 31));
     }
-    Vec3 v;
-    Real tol;
+
+    // Return the slot holding cell x,y,z, or the empty slot where it would
+    // go. The table is never more than half full so this terminates quickly.
+    size_t findSlot(long long x, long long y, long long z) const {
+        const size_t mask = slots.size()-1;
+        size_t i = hash(x,y,z) & mask;
+        while (slots[i].head >= 0 && !(   slots[i].c[0]==x 
+                                       && slots[i].c[1]==y 
+                                       && slots[i].c[2]==z))
+            i = (i+1) & mask;
+        return i;
+    }
+
+    // Resize the table to n slots (a power of 2) and reinsert the cells.
+    void rehash(size_t n) {
+        std::vector<Slot> old(n);
+        old.swap(slots);
+        for (size_t i=0; i < old.size(); ++i)
+            if (old[i].head >= 0)
+                slots[findSlot(old[i].c[0],old[i].c[1],old[i].c[2])] = old[i];
+    }
+
+    const Real          tol;
+    Real                oneOverCellSize;
+    Vec3                origin;     // the first vertex inserted
+    Vec3                boxLo, boxHi;
+    std::vector<Slot>   slots;      // hash table of nonempty cells
+    size_t              numCells;   // number of slots in use
+    std::vector<Entry>  entries;
 };
-typedef std::map<VertKey,int> VertMap;
+
+const Real VertexWelder::MaxCell = Real(1LL << 40);
 }
 
 //------------------------------------------------------------------------------
@@ -447,9 +962,9 @@ class STLFile {
 public:
     STLFile(const String& pathname, const PolygonalMesh& mesh) 
     :   m_pathname(pathname), m_pathcstr(pathname.c_str()),
-        m_vertexTol(NTraits<float>::getSignificant()),
+        m_vertexWelder(NTraits<float>::getSignificant()),
         m_lineNo(0), m_sigLineNo(0) 
-    {   preLoadVertMap(mesh); }
+    {   readFile(); preLoadVertexWelder(mesh); }
 
     // Examine file contents to determine whether this is an ascii-format 
     // STL; otherwise it is binary.
@@ -459,45 +974,51 @@ public:
     void loadStlBinaryFile(PolygonalMesh& mesh);
 
 private:
+    // The whole file is read into memory once, then parsed from there
+    // whichever format it turns out to be.
+    void readFile() {
+        SimTK_ERRCHK1_ALWAYS(readFileContents(m_pathname, m_contents),
+            "PolygonalMesh::loadStlFile()", "Can't open file '%s'", m_pathcstr);
+        m_pos = m_contents.c_str();
+        m_end = m_pos + m_contents.size();
+    }
+
     bool getSignificantLine(bool eofOK);
 
     // If we're appending to an existing mesh we'll need to preload the
-    // vertex map with the existing vertices.
-    void preLoadVertMap(const PolygonalMesh& mesh) {
-        for (int i=0; i < mesh.getNumVertices(); ++i) {
-            const Vec3& v = mesh.getVertexPosition(i);
-            m_vertMap.insert(std::make_pair(VertKey(v,m_vertexTol), i));
-        }
+    // vertex welder with the existing vertices.
+    void preLoadVertexWelder(const PolygonalMesh& mesh) {
+        m_vertexWelder.reserve(mesh.getNumVertices());
+        for (int i=0; i < mesh.getNumVertices(); ++i)
+            m_vertexWelder.insert(mesh.getVertexPosition(i), i);
     }
 
     // Look for a vertex close enough to this one and return its index if found,
     // otherwise add to the mesh.
     int getVertex(const Vec3& v, PolygonalMesh& mesh) {
-        const VertKey key(v, m_vertexTol);
-        VertMap::const_iterator p = m_vertMap.find(key);
-        int ix;
-        if (p != m_vertMap.end()) 
-            ix = p->second;
-        else {
+        int ix = m_vertexWelder.find(v);
+        if (ix < 0) {
             ix = mesh.addVertex(v);
-            m_vertMap.insert(std::make_pair(key,ix));
+            m_vertexWelder.insert(v, ix);
         }
         return ix;
     }
 
-    // The ascii/binary determination reads some lines; counts must restart.
-    void resetLineCounts() {m_lineNo=m_sigLineNo=0;}
+    // The ascii/binary determination reads some lines; parsing must restart.
+    void rewind() {m_pos = m_contents.c_str(); m_lineNo=m_sigLineNo=0;}
 
     const String&     m_pathname;
     const char* const m_pathcstr;
-    const Real        m_vertexTol;
-    VertMap           m_vertMap;
+    VertexWelder      m_vertexWelder;
 
-    std::ifstream     m_ifs;
+    std::string       m_contents;       // the entire file
+    const char*       m_pos;            // start of next line in m_contents
+    const char*       m_end;
     int               m_lineNo;         // current line in file
     int               m_sigLineNo;      // line # not counting blanks, comments
     String            m_keyword;        // first non-blank token on line
-    std::stringstream m_restOfLine;     // full line except first token
+    const char*       m_restOfLine;     // line following first token
+    const char*       m_lineEnd;        // end of current line
 };
 
 }
@@ -551,10 +1072,6 @@ void PolygonalMesh::loadStlFile(const String& pathname) {
 // that isn't enough. We will simply try to parse the file as ascii and then
 // if that leads to an inconsistency will try binary instead.
 bool STLFile::isStlAsciiFormat() {
-    m_ifs.open(m_pathname);
-    SimTK_ERRCHK1_ALWAYS(m_ifs.good(), "PolygonalMesh::loadStlFile()",
-        "Can't open file '%s'", m_pathcstr);
-
     bool isAscii = false;
     if (getSignificantLine(true) && m_keyword == "solid") {
         // Still might be binary. Look for a "facet" or "endsolid" line.
@@ -567,17 +1084,12 @@ bool STLFile::isStlAsciiFormat() {
         }
     }
 
-    m_ifs.close();
-    resetLineCounts();
+    rewind();
     return isAscii;
 }
 
 
 void STLFile::loadStlAsciiFile(PolygonalMesh& mesh) {
-    m_ifs.open(m_pathname);
-    SimTK_ERRCHK1_ALWAYS(m_ifs.good(), "PolygonalMesh::loadStlFile()",
-        "Can't open file '%s'", m_pathcstr);
-
     Array_<int> vertices;
 
     // Don't allow EOF until we've seen two significant lines.
@@ -601,8 +1113,14 @@ void STLFile::loadStlAsciiFile(PolygonalMesh& mesh) {
             vertices.clear();
             while (m_keyword == "vertex") {
                 Vec3 vertex;
-                m_restOfLine >> vertex;
-                SimTK_ERRCHK2_ALWAYS(m_restOfLine.eof(), 
+                const char* p = m_restOfLine;
+                bool ok = true;
+                for (int i=0; ok && i < 3; ++i) {
+                    while (p < m_lineEnd && isBlank(*p)) ++p;
+                    ok = p < m_lineEnd && parseReal(p, vertex[i]);
+                }
+                while (ok && p < m_lineEnd && isBlank(*p)) ++p;
+                SimTK_ERRCHK2_ALWAYS(ok && p == m_lineEnd,
                     "PolygonalMesh::loadStlFile()",
                     "Error at line %d in ASCII STL file '%s':\n"
                     "  badly formed vertex.", m_lineNo, m_pathcstr);
@@ -639,7 +1157,6 @@ void STLFile::loadStlAsciiFile(PolygonalMesh& mesh) {
     }
 
     // We don't care if there is extra stuff in the file.
-    m_ifs.close();
 }
 
 // This is the binary STL format:
@@ -656,79 +1173,76 @@ void STLFile::loadStlAsciiFile(PolygonalMesh& mesh) {
 // TODO: the STL binary format is always little-endian, like an Intel chip.
 // The code here won't work properly on a big endian machine!
 void STLFile::loadStlBinaryFile(PolygonalMesh& mesh) {
-    // This should never fail since the above succeeded, but we'll check.
-    m_ifs.open(m_pathname, std::ios_base::binary);
-    SimTK_ERRCHK1_ALWAYS(m_ifs.good(), "PolygonalMesh::loadStlFile()",
-        "Can't open file '%s'", m_pathcstr);
-
-    unsigned char header[80];
-    m_ifs.read((char*)header, 80);
-    SimTK_ERRCHK1_ALWAYS(m_ifs.good() && m_ifs.gcount()==80, 
+    const size_t fileSize = m_contents.size();
+    const unsigned char* data = (const unsigned char*)m_contents.data();
+    SimTK_ERRCHK1_ALWAYS(fileSize >= 80,
         "PolygonalMesh::loadStlFile()", "Bad binary STL file '%s':\n"
         "  couldn't read header.", m_pathcstr);
 
     unsigned nFaces;
-    m_ifs.read((char*)&nFaces, sizeof(unsigned));
-    SimTK_ERRCHK1_ALWAYS(m_ifs.good() && m_ifs.gcount()==sizeof(unsigned), 
+    SimTK_ERRCHK1_ALWAYS(fileSize >= 80+sizeof(unsigned),
         "PolygonalMesh::loadStlFile()", "Bad binary STL file '%s':\n"
         "  couldn't read triangle count.", m_pathcstr);
+    std::memcpy(&nFaces, data+80, sizeof(unsigned));
 
+    // Each face is 50 bytes: 12 floats and a short.
+    const size_t FaceSize = 12*sizeof(float) + sizeof(short);
+    const size_t firstFace = 80 + sizeof(unsigned);
+    const size_t nComplete = (fileSize - firstFace) / FaceSize;
+    SimTK_ERRCHK3_ALWAYS(nComplete >= nFaces,
+        "PolygonalMesh::loadStlFile()", "Bad binary STL file '%s':\n"
+        "  file is too short for its %u triangles; couldn't read face %d.",
+        m_pathcstr, nFaces, (int)nComplete);
+
+    m_vertexWelder.reserve(mesh.getNumVertices() + nFaces/2);
     Array_<int> vertices(3);
-    float vbuf[3]; unsigned short sbuf;
-    const unsigned vz = 3*sizeof(float);
+    float vbuf[3];
     for (unsigned fx=0; fx < nFaces; ++fx) {
-        m_ifs.read((char*)vbuf, vz); // normal ignored
+        const unsigned char* face = data + firstFace + fx*FaceSize;
+        // The normal in the first 3 floats is ignored.
         for (int vx=0; vx < 3; ++vx) {
-            m_ifs.read((char*)vbuf, vz);
-            SimTK_ERRCHK3_ALWAYS(m_ifs.good() && m_ifs.gcount()==vz, 
-                "PolygonalMesh::loadStlFile()", "Bad binary STL file '%s':\n"
-                "  couldn't read vertex %d for face %d.", m_pathcstr, vx, fx);
+            std::memcpy(vbuf, face + (vx+1)*3*sizeof(float), sizeof(vbuf));
             const Vec3 vertex((Real)vbuf[0], (Real)vbuf[1], (Real)vbuf[2]);
             vertices[vx] = getVertex(vertex, mesh);
         }
         mesh.addFace(vertices);
-        // Now read and toss the "attribute byte count".
-        m_ifs.read((char*)&sbuf,sizeof(short));
-        SimTK_ERRCHK2_ALWAYS(m_ifs.good() && m_ifs.gcount()==sizeof(short), 
-            "PolygonalMesh::loadStlFile()", "Bad binary STL file '%s':\n"
-            "  couldn't read attribute for face %d.", m_pathcstr, fx);
+        // The "attribute byte count" at the end is ignored.
     }
 
     // We don't care if there is extra stuff in the file.
-    m_ifs.close();
 }
 
-// Return the next line from the formatted input stream, ignoring blank
-// lines and comment lines, and downshifting the returned keyword. Sets
-// m_keyword and m_restOfLine and increments line counts. If eofOK==false,
+// Return the next line from the file contents, ignoring blank lines and
+// comment lines, and downshifting the returned keyword. Sets m_keyword,
+// m_restOfLine, and m_lineEnd and increments line counts. If eofOK==false,
 // issues an error message if we hit EOF, otherwise it will quitely return
 // false at EOF.
 bool STLFile::getSignificantLine(bool eofOK) {
-    std::string line;
-    std::getline(m_ifs, line);
-    while (m_ifs.good()) {
+    while (m_pos < m_end) {
         ++m_lineNo;
-        m_keyword = String::trimWhiteSpace(line); // using keyword as a temp
-        if (   m_keyword.empty() 
-            || m_keyword[0]=='#' || m_keyword[0]=='!' || m_keyword[0]=='$') 
-        {
-            std::getline(m_ifs, line);
+        const char* p = m_pos;
+        const char* eol =
+            (const char*)std::memchr(p, '\n', m_end - p);
+        if (!eol) eol = m_end;
+        m_pos = eol < m_end ? eol+1 : m_end;
+
+        while (p < eol && std::isspace((unsigned char)*p)) ++p;
+        while (eol > p && std::isspace((unsigned char)eol[-1])) --eol;
+        if (p == eol || *p=='#' || *p=='!' || *p=='$')
             continue; // blank or comment
-        }
+
         // Found a significant line.
         ++m_sigLineNo;
+        const char* keyEnd = p;
+        while (keyEnd < eol && !std::isspace((unsigned char)*keyEnd))
+            ++keyEnd;
+        m_keyword.assign(p, keyEnd);
         m_keyword.toLower();
-        m_restOfLine.clear();
-        m_restOfLine.str(m_keyword);
-        m_restOfLine >> m_keyword; // now it's the keyword at beginning of line
+        m_restOfLine = keyEnd;
+        m_lineEnd = eol;
         return true;
     }
 
-    SimTK_ERRCHK2_ALWAYS(!(m_ifs.fail()||m_ifs.bad()),
-        "PolygonalMesh::loadStlFile()",
-        "Error at line %d in ASCII STL file '%s':\n"
-        "  error while reading file.", m_lineNo, m_pathcstr);
-
     // Must be EOF.
     SimTK_ERRCHK2_ALWAYS(eofOK, "PolygonalMesh::loadStlFile()",
         "Error at line %d in ASCII STL file '%s':\n"
@@ -740,22 +1254,9 @@ bool STLFile::getSignificantLine(bool eofOK) {
 //                            CREATE SPHERE MESH
 //------------------------------------------------------------------------------
 
-// Use unnamed namespace to keep VertKey class and VertMap type private to 
-// this file, as well as a few helper functions.
+// Use unnamed namespace to keep a few helper functions private to this file.
 namespace {
 
-
-    /* Search a list of vertices for one close enough to this one and
-    return its index if found, otherwise add to the end. */
-    int getVertex(const Vec3& v, VertMap& vmap, Array_<Vec3>& verts) {
-        VertMap::const_iterator p = vmap.find(VertKey(v));
-        if (p != vmap.end()) return p->second;
-        const int ix = (int)verts.size();
-        verts.push_back(v);
-        vmap.insert(std::make_pair(VertKey(v),ix));
-        return ix;
-    }
-
     /* Each face comes in as below, with vertices 0,1,2 on the surface
     of a sphere or radius r centered at the origin. We bisect the edges to get
     points a',b',c', then move out from the center to make points a,b,c
@@ -769,7 +1270,7 @@ namespace {
        /____\/____\          [c,2,a]
       2      a     0         [b,1,c]
     */
-    void refineSphere(Real r, VertMap& vmap, 
+    void refineSphere(Real r, VertexWelder& welder, 
                              Array_<Vec3>& verts, Array_<int>&  faces) {
         assert(faces.size() % 3 == 0);
         const int nVerts = faces.size(); // # face vertices on entry
@@ -778,9 +1279,9 @@ namespace {
             const Vec3 a = r*UnitVec3(verts[v0]+verts[v2]);
             const Vec3 b = r*UnitVec3(verts[v0]+verts[v1]);
             const Vec3 c = r*UnitVec3(verts[v1]+verts[v2]);
-            const int va=getVertex(a,vmap,verts), 
-                      vb=getVertex(b,vmap,verts), 
-                      vc=getVertex(c,vmap,verts);
+            const int va=welder.getVertex(a,verts), 
+                      vb=welder.getVertex(b,verts), 
+                      vc=welder.getVertex(c,verts);
             // Replace the existing face with the 0ba triangle, then add the
             // rest. Refer to the above picture.
             faces[i+1] = vb; faces[i+2] = va;
@@ -819,13 +1320,13 @@ createSphereMesh(Real radius, int resolution) {
     Array_<int> faceIndices;
     makeOctahedralMesh(Vec3(radius), vertices, faceIndices);
 
-    VertMap vmap;
+    VertexWelder welder;
     for (unsigned i=0; i < vertices.size(); ++i)
-        vmap[vertices[i]] = i;
+        welder.insert(vertices[i], i);
 
     int level = resolution;
     while (level > 0) {
-        refineSphere(radius, vmap, vertices, faceIndices);
+        refineSphere(radius, welder, vertices, faceIndices);
         --level;
     }
 
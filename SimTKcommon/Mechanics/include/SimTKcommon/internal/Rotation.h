@@ -1418,18 +1418,20 @@ Rotation_<P>::Rotation_(const InverseRotation_<P>& R)
 template <class P> inline Rotation_<P>&  
 Rotation_<P>::operator=(const InverseRotation_<P>& R)  
 {static_cast<Mat<3,3,P>&>(*this)  = R.asMat33();    return *this;}
+// These use Mat33 operator*() rather than Mat33::operator*=() so that the
+// SIMD versions in SmallMatrixSIMD.h are used when P is double.
 template <class P> inline Rotation_<P>&  
 Rotation_<P>::operator*=(const Rotation_<P>& R)        
-{static_cast<Mat<3,3,P>&>(*this) *= R.asMat33();    return *this;}
+{static_cast<Mat<3,3,P>&>(*this) = asMat33() * R.asMat33();    return *this;}
 template <class P> inline Rotation_<P>&  
 Rotation_<P>::operator/=(const Rotation_<P>& R)        
-{static_cast<Mat<3,3,P>&>(*this) *= (~R).asMat33(); return *this;}
+{static_cast<Mat<3,3,P>&>(*this) = asMat33() * (~R).asMat33(); return *this;}
 template <class P> inline Rotation_<P>&  
 Rotation_<P>::operator*=(const InverseRotation_<P>& R) 
-{static_cast<Mat<3,3,P>&>(*this) *= R.asMat33();    return *this;}
+{static_cast<Mat<3,3,P>&>(*this) = asMat33() * R.asMat33();    return *this;}
 template <class P> inline Rotation_<P>&  
 Rotation_<P>::operator/=(const InverseRotation_<P>& R) 
-{static_cast<Mat<3,3,P>&>(*this) *= (~R).asMat33(); return *this;}
+{static_cast<Mat<3,3,P>&>(*this) = asMat33() * (~R).asMat33(); return *this;}
 
 /// Composition of Rotation matrices via operator*.
 //@{
@@ -25,6 +25,7 @@
  * -------------------------------------------------------------------------- */
 
 #include "SimTKcommon/basics.h"
+#include "SimTKcommon/Simmatrix.h"
 
 namespace SimTK {
 
@@ -45,10 +46,15 @@ namespace SimTK {
  * This class is implemented using the SIMD-oriented Fast Mersenne Twister (SFMT) library.  It provides
  * good performance, excellent statistical properties, and a very long period.
  * 
+ * When you need many values, fillArray() or fill() is much faster than calling getValue() repeatedly; they
+ * return exactly the values that the same number of getValue() calls would have.
+ *
  * The methods of this class do not provide any synchronization or other mechanism to ensure thread safety.
  * It is therefore important that a single Random object not be accessed from multiple threads. One minor
  * concession to threads: even if you don't set the seed explicitly, each thread's Random object will
- * use a different seed so you'll get a unique series of numbers in each thread.
+ * use a different seed so you'll get a unique series of numbers in each thread. For reproducible parallel
+ * calculations, give each thread its own Random object and seed them all with setSeed(seed, stream), using
+ * the same seed and a different stream number in each thread.
  */
 
 class SimTK_SimTKCOMMON_EXPORT Random {
@@ -61,6 +67,13 @@ public:
      * Reinitialize this random number generator with a new seed value.
      */
     void setSeed(int seed);
+    /**
+     * Reinitialize this random number generator to produce stream number \a stream of the family of
+     * streams identified by \a seed. Different streams of the same seed are independent sequences, so
+     * parallel workers can each use their own stream and get reproducible results regardless of how the
+     * work is scheduled.
+     */
+    void setSeed(int seed, int stream);
     /**
      * Get the next value in the pseudo-random sequence.
      */
@@ -69,6 +82,10 @@ public:
      * Fill an array with values from the pseudo-random sequence.
      */
     void fillArray(Real array[], int length) const;
+    /**
+     * Fill a Vector or VectorView with values from the pseudo-random sequence. It keeps its current size.
+     */
+    void fill(VectorBase<Real>& values) const;
 protected:
     RandomImpl* impl;
     /**
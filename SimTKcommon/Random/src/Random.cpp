@@ -26,6 +26,7 @@
 #include "SimTKcommon/internal/Random.h"
 #include "SFMT.h"
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <cmath>
@@ -34,6 +35,13 @@ using namespace SimTK_SFMT;
 
 namespace SimTK {
 
+// Convert a 64-bit random integer to a double in [0,1). This gives the same
+// result as SFMT's to_res53(), which rounds v to 53 bits and then scales it,
+// but without going through long double so that loops over it vectorize.
+static inline double toUnitInterval(uint64_t v) {
+    return double(v) * (1.0/18446744073709551616.0);
+}
+
 /**
  * This is the private implementation class for Random.  It has a subclass corresponding to each subclass of Random.
  */
@@ -63,6 +71,16 @@ public:
         nextIndex = bufferSize;
         init_gen_rand(seed, *sfmt);
     }
+
+    // Streams are selected by seeding SFMT with the two-word key
+    // (seed, stream). SFMT's array initialization mixes every word of the key
+    // into the whole state, so each key starts at an unrelated point of the
+    // 2^19937-1 period.
+    virtual void setSeed(int seed, int stream) {
+        nextIndex = bufferSize;
+        uint32_t key[2] = {uint32_t(seed), uint32_t(stream)};
+        init_by_array(key, 2, *sfmt);
+    }
     
     virtual Real getValue() const = 0;
 
@@ -73,14 +91,29 @@ public:
             fill_array64(buffer, bufferSize, *sfmt);
             nextIndex = 0;
         }
-        return Real(to_res53(buffer[nextIndex++]));
+        return Real(toUnitInterval(buffer[nextIndex++]));
     }
 
+    // Return a pointer to the next n (at least 1) unused values in the buffer,
+    // refilling it first if it is empty. n is limited to what remains in the
+    // buffer. The caller must call consume() for the values it uses.
+    const uint64_t* getNextRandomBlock(int& n) const {
+        if (nextIndex >= bufferSize) {
+            fill_array64(buffer, bufferSize, *sfmt);
+            nextIndex = 0;
+        }
+        n = std::min(n, bufferSize-nextIndex);
+        return &buffer[nextIndex];
+    }
+    void consume(int n) const {nextIndex += n;}
+
     int getInt(int max) {
         return (int) floor(getValue()*max);
     }
 
-    void fillArray(Real array[], int length) const {
+    // Subclasses override this to generate values in bulk; they must produce
+    // the same values as repeated calls to getValue().
+    virtual void fillArray(Real array[], int length) const {
         for (int i = 0; i < length; ++i)
             array[i] = getValue();
     }
@@ -102,6 +135,19 @@ public:
     Real getValue() const override {
         return min+getNextRandom()*range;
     }
+
+    // Convert whole blocks of the SFMT buffer at a time.
+    void fillArray(Real array[], int length) const override {
+        while (length > 0) {
+            int n = length;
+            const uint64_t* block = getNextRandomBlock(n);
+            for (int i = 0; i < n; ++i)
+                array[i] = min+Real(toUnitInterval(block[i]))*range;
+            consume(n);
+            array += n;
+            length -= n;
+        }
+    }
     
     Real getMin() const {
         return min;
@@ -155,11 +201,64 @@ public:
         nextGaussianIsValid = true;
         return mean+stddev*x*multiplier;
     }
+
+    // This uses the same polar Box-Muller method as getValue(), and the same
+    // uniform values, so that it returns the same sequence. It works on a
+    // chunk of candidate pairs at a time: the conversions and acceptance
+    // tests, which are most of the work, are done in a loop the compiler can
+    // vectorize, and only the accepted pairs need a log and a square root.
+    void fillArray(Real array[], int length) const override {
+        const int ChunkPairs = 64;
+        Real x[ChunkPairs], y[ChunkPairs], r2[ChunkPairs];
+        while (length > 0) {
+            if (nextGaussianIsValid) {
+                nextGaussianIsValid = false;
+                *array++ = mean+stddev*nextGaussian;
+                --length;
+                continue;
+            }
+            int n = 2*ChunkPairs;
+            const uint64_t* block = getNextRandomBlock(n);
+            const int nPairs = n/2;
+            if (nPairs == 0) {
+                // Only one value is left in the buffer; this pair straddles
+                // a refill, so let getValue() deal with it.
+                *array++ = getValue();
+                --length;
+                continue;
+            }
+            for (int k = 0; k < nPairs; ++k) {
+                x[k] = 2*Real(toUnitInterval(block[2*k]))-1;
+                y[k] = 2*Real(toUnitInterval(block[2*k+1]))-1;
+                r2[k] = x[k]*x[k] + y[k]*y[k];
+            }
+            int k = 0;
+            for (; k < nPairs && length > 0; ++k) {
+                if (r2[k] >= 1.0 || r2[k] == 0.0)
+                    continue;
+                const Real multiplier = std::sqrt((-2*std::log(r2[k]))/r2[k]);
+                *array++ = mean+stddev*x[k]*multiplier;
+                if (--length == 0) {
+                    nextGaussian = y[k]*multiplier;
+                    nextGaussianIsValid = true;
+                } else {
+                    *array++ = mean+stddev*(y[k]*multiplier);
+                    --length;
+                }
+            }
+            consume(2*k);
+        }
+    }
     
     void setSeed(int seed) override {
         RandomImpl::setSeed(seed);
         nextGaussianIsValid = false;
     }
+
+    void setSeed(int seed, int stream) override {
+        RandomImpl::setSeed(seed, stream);
+        nextGaussianIsValid = false;
+    }
     
     Real getMean() const {
         return mean;
@@ -199,6 +298,10 @@ void Random::setSeed(int seed) {
     getImpl().setSeed(seed);
 }
 
+void Random::setSeed(int seed, int stream) {
+    getImpl().setSeed(seed, stream);
+}
+
 Real Random::getValue() const {
     return getConstImpl().getValue();
 }
@@ -208,6 +311,17 @@ void Random::fillArray(Real array[], int length) const {
     getConstImpl().fillArray(array, length);
 }
 
+void Random::fill(VectorBase<Real>& values) const {
+    if (values.hasContiguousData()) {
+        if (values.size())
+            getConstImpl().fillArray(&values[0], values.size());
+        return;
+    }
+    Vector contiguous(values.size());
+    fill(contiguous);
+    values = contiguous;
+}
+
 Random::Uniform::Uniform() {
     impl = new Random::Uniform::UniformImpl(0.0, 1.0);
 }
@@ -309,6 +309,9 @@ public:
     class Scale;
     class Differentiate;
 
+    // This evaluates a whole graph of the above arithmetic measures at once.
+    class Compiled;
+
     // These find extreme values *in time*, not among inputs at the same
     // time. They perform elementwise on aggregate types.
     class Extreme;  // base class for min/max/minabs/maxabs
@@ -664,6 +667,60 @@ public:
     SimTK_MEASURE_HANDLE_POSTSCRIPT(Scale, Measure_<T>);
 };
 
+//==============================================================================
+//                                 COMPILED
+//==============================================================================
+/** This Measure has the same value as a given \a expression Measure, but 
+evaluates the graph of %Plus, %Minus, %Scale, and %Constant measures below the
+expression as a single fused computation with a single cache entry, rather
+than visiting each of those measures and its cache entry in turn.
+
+At realizeTopology() the graph is flattened into a list of operations on a
+set of registers. Any other kind of Measure found in the graph (Time, 
+Variable, Integrate, a Sinusoid, and so on) is a leaf whose getValue() is
+called during evaluation. Measures reached along more than one path are 
+evaluated only once, as are structurally identical subexpressions like 
+<tt>a+b</tt> and <tt>b+a</tt> that were built from separate measures; 
+subexpressions involving only %Constant measures are folded into constants.
+The expression's own measures are left in place and can still be used.
+
+The value is computed on demand and cached until the expression's depends-on
+stage is invalidated, just as for the expression itself, and changing a 
+%Constant or scale factor in the graph causes a recompile at the next 
+realizeTopology(). Only the value is available; %Compiled measures have no
+time derivatives.
+@tparam T    Any type that supports the operators needed by the %Plus,
+             %Minus, and %Scale measures of the expression. In particular, 
+             Real, Vec<N>, and Vector will work. **/
+template <class T>
+class Measure_<T>::Compiled : public Measure_<T> {
+public:
+    SimTK_MEASURE_HANDLE_PREAMBLE(Compiled, Measure_<T>);
+
+    Compiled(Subsystem& sub, const Measure_<T>& expression)
+    :   Measure_<T>(sub, new Implementation(expression), 
+                    AbstractMeasure::SetHandle())
+    {   SimTK_ERRCHK_ALWAYS
+           (this->isSameSubsystem(expression.getSubsystem()),
+            "Measure_<T>::Compiled::ctor()",
+            "Argument must be in the same Subsystem as this Measure.");
+    }
+
+    /** Get the expression measure whose value this measure computes. **/
+    const Measure_<T>& getExpressionMeasure() const 
+    {   return getImpl().getExpressionMeasure(); }
+
+    /** Return the number of arithmetic operations left after compiling the 
+    expression; only valid after realizeTopology(). **/
+    int getNumOperations() const {return getImpl().getNumOperations();}
+
+    /** Return the number of distinct leaf measures whose values are used by the
+    compiled expression; only valid after realizeTopology(). **/
+    int getNumLeaves() const {return getImpl().getNumLeaves();}
+
+    SimTK_MEASURE_HANDLE_POSTSCRIPT(Compiled, Measure_<T>);
+};
+
 //==============================================================================
 //                                 INTEGRATE
 //==============================================================================
@@ -33,6 +33,12 @@
 #include "SimTKcommon/internal/SubsystemGuts.h"
 
 #include <cmath>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
 
 
 namespace SimTK {
@@ -980,6 +986,9 @@ public:
     // Default copy constructor gives us a new Implementation object,
     // but with references to the *same* operand measures.
 
+    const Measure_<T>& getLeftMeasure() const {return left;}
+    const Measure_<T>& getRightMeasure() const {return right;}
+
     // Implementations of virtual methods.
 
     // This uses the default copy constructor.
@@ -1033,6 +1042,9 @@ public:
     // Default copy constructor gives us a new Implementation object,
     // but with references to the *same* operand measures.
 
+    const Measure_<T>& getLeftMeasure() const {return left;}
+    const Measure_<T>& getRightMeasure() const {return right;}
+
     // Implementations of virtual methods.
 
     // This uses the default copy constructor.
@@ -1092,6 +1104,8 @@ public:
         this->invalidateTopologyCache();
     }
 
+    Real getScaleFactor() const {return factor;}
+
     const Measure_<T>& getOperandMeasure() const
     {
         return operand;
@@ -1132,6 +1146,208 @@ private:
 
 
 
+//==============================================================================
+//                        COMPILED :: IMPLEMENTATION
+//==============================================================================
+/** The implementation for %Compiled measures flattens the expression graph at
+realizeTopology() into a list of operations on registers; registers holding 
+constants are filled in then too. A single lazy cache entry holds the 
+registers for a particular State, and all the operations are executed together
+when the value is first requested after that cache entry was invalidated. **/
+template <class T>
+class Measure_<T>::Compiled::Implementation
+:   public Measure_<T>::Implementation 
+{
+public:
+    // We don't want the base class to allocate any cache entries; the value
+    // is kept in one of the registers instead.
+    Implementation() : Measure_<T>::Implementation(0), resultReg(-1) {}
+
+    explicit Implementation(const Measure_<T>& expression)
+    :   Measure_<T>::Implementation(0), expression(expression), 
+        resultReg(-1) {}
+
+    // Default copy constructor gives us a new Implementation object,
+    // but with a reference to the *same* expression measure.
+
+    const Measure_<T>& getExpressionMeasure() const {return expression;}
+
+    // Every leaf has one Load operation; the rest are arithmetic.
+    int getNumOperations() const 
+    {   return (int)program.size() - (int)leaves.size(); }
+    int getNumLeaves() const {return (int)leaves.size();}
+
+    // Implementations of virtual methods.
+
+    // This uses the default copy constructor.
+    Implementation* cloneVirtual() const override 
+    {   return new Implementation(*this); }
+
+    int getNumTimeDerivativesVirtual() const override {return 0;} 
+
+    Stage getDependsOnStageVirtual(int order) const override 
+    {   return expression.getDependsOnStage(order); }
+
+    const T& getUncachedValueVirtual(const State& s, int derivOrder) const
+        override
+    {   assert(derivOrder == 0); // no derivatives
+        const Subsystem& subsys = this->getSubsystem();
+        if (!subsys.isCacheValueRealized(s, registersIx)) {
+            Array_<T>& regs = Value< Array_<T> >::updDowncast
+               (subsys.updCacheEntry(s, registersIx));
+            evaluate(s, regs);
+            subsys.markCacheValueRealized(s, registersIx);
+            return regs[resultReg];
+        }
+        return Value< Array_<T> >::downcast
+           (subsys.getCacheEntry(s, registersIx)).get()[resultReg];
+    }
+
+    void realizeMeasureTopologyVirtual(State& s) const override {
+        compile();
+        registersIx = this->getSubsystem().allocateLazyCacheEntry
+           (s, this->getDependsOnStage(0), new Value< Array_<T> >(constants));
+    }
+
+private:
+    enum OpCode {Load, Add, Subtract, Multiply};
+
+    // For Load, a is the index of the leaf measure. For Multiply, the scale
+    // factor multiplies register a and b is unused.
+    struct Operation {
+        Operation(OpCode op, int dest, int a, int b, Real factor)
+        :   op(op), dest(dest), a(a), b(b), factor(factor) {}
+        OpCode  op;
+        int     dest, a, b;
+        Real    factor;
+    };
+
+    typedef std::map<const AbstractMeasure::Implementation*, int> NodeMap;
+    typedef std::map<std::tuple<int,int,int,Real>, int>           OperationMap;
+
+    // Temporaries used while compiling.
+    struct Compilation {
+        NodeMap         nodes;      // measures already compiled
+        OperationMap    operations; // arithmetic operations already emitted
+        Array_<bool>    isConstant; // one per register
+    };
+
+    void compile() const {
+        program.clear(); leaves.clear(); constants.clear();
+        Compilation comp;
+        resultReg = compileMeasure(expression, comp);
+    }
+
+    // Return the register that will hold the value of measure m, emitting
+    // whatever operations are needed to compute it.
+    int compileMeasure(const Measure_<T>& m, Compilation& comp) const {
+        SimTK_ERRCHK_ALWAYS(!m.isEmptyHandle(), 
+            "Measure_<T>::Compiled::realizeTopology()",
+            "The expression contains an empty Measure handle.");
+
+        const AbstractMeasure::Implementation* node = &m.getImpl();
+        typename NodeMap::const_iterator p = comp.nodes.find(node);
+        if (p != comp.nodes.end())
+            return p->second;
+
+        typedef typename Measure_<T>::Constant::Implementation ConstantImpl;
+        typedef typename Measure_<T>::Plus::Implementation     PlusImpl;
+        typedef typename Measure_<T>::Minus::Implementation    MinusImpl;
+        typedef typename Measure_<T>::Scale::Implementation    ScaleImpl;
+
+        int reg;
+        if (const ConstantImpl* c = dynamic_cast<const ConstantImpl*>(node))
+            reg = addRegister(c->getDefaultValue(), true, comp);
+        else if (const PlusImpl* plus = dynamic_cast<const PlusImpl*>(node))
+            reg = addOperation(Add, 
+                               compileMeasure(plus->getLeftMeasure(), comp),
+                               compileMeasure(plus->getRightMeasure(), comp),
+                               0, comp);
+        else if (const MinusImpl* minus = dynamic_cast<const MinusImpl*>(node))
+            reg = addOperation(Subtract, 
+                               compileMeasure(minus->getLeftMeasure(), comp),
+                               compileMeasure(minus->getRightMeasure(), comp),
+                               0, comp);
+        else if (const ScaleImpl* scale = dynamic_cast<const ScaleImpl*>(node))
+            reg = addOperation(Multiply,
+                               compileMeasure(scale->getOperandMeasure(), comp),
+                               -1, scale->getScaleFactor(), comp);
+        else { // anything else is a leaf
+            reg = addRegister(T(), false, comp);
+            program.push_back(Operation(Load, reg, (int)leaves.size(), -1, 0));
+            leaves.push_back(m);
+        }
+
+        comp.nodes[node] = reg;
+        return reg;
+    }
+
+    // Return a register holding the result of the given arithmetic operation,
+    // reusing an earlier one if the same operation was already emitted.
+    int addOperation(OpCode op, int a, int b, Real factor, 
+                     Compilation& comp) const {
+        // Addition commutes, so a+b and b+a are the same subexpression.
+        if (op == Add && b < a)
+            std::swap(a, b);
+
+        const Operation operation(op, -1, a, b, factor);
+        if (comp.isConstant[a] && (op == Multiply || comp.isConstant[b])) {
+            T value;
+            apply(operation, constants, value);
+            return addRegister(value, true, comp);
+        }
+
+        const std::tuple<int,int,int,Real> key(op, a, b, factor);
+        typename OperationMap::const_iterator p = comp.operations.find(key);
+        if (p != comp.operations.end())
+            return p->second;
+
+        const int reg = addRegister(T(), false, comp);
+        program.push_back(operation);
+        program.back().dest = reg;
+        comp.operations[key] = reg;
+        return reg;
+    }
+
+    int addRegister(const T& initialValue, bool isConstant, 
+                    Compilation& comp) const {
+        constants.push_back(initialValue);
+        comp.isConstant.push_back(isConstant);
+        return (int)constants.size() - 1;
+    }
+
+    static void apply(const Operation& op, const Array_<T>& regs, T& result) {
+        switch (op.op) {
+        case Add:       result = regs[op.a] + regs[op.b]; break;
+        case Subtract:  result = regs[op.a] - regs[op.b]; break;
+        case Multiply:  result = op.factor * regs[op.a];  break;
+        default:        assert(!"unexpected operation");
+        }
+    }
+
+    // Operations are in dependency order, so this is a single pass.
+    void evaluate(const State& s, Array_<T>& regs) const {
+        for (const Operation& op : program) {
+            if (op.op == Load)
+                regs[op.dest] = leaves[op.a].getValue(s);
+            else
+                apply(op, regs, regs[op.dest]);
+        }
+    }
+
+    // TOPOLOGY STATE
+    Measure_<T>                 expression;
+
+    // TOPOLOGY CACHE
+    mutable Array_<Operation>   program;
+    mutable Array_< Measure_<T> > leaves;
+    mutable Array_<T>           constants;  // initial register contents
+    mutable int                 resultReg;
+    mutable CacheEntryIndex     registersIx;
+};
+
+
+
 //==============================================================================
 //                        INTEGRATE :: IMPLEMENTATION
 //==============================================================================
@@ -1713,136 +1929,219 @@ private:
 //                         DELAY :: IMPLEMENTATION
 //==============================================================================
 /** @cond **/ // Hide from Doxygen.
+// The entries saved by a delay measure are kept in a history that is shared 
+// by the buffer in the discrete state variable, the buffer in its update cache
+// entry, and the buffers in any copies of the State. A buffer is just the 
+// range [first,end) of entry numbers that it uses, so updating one appends a
+// single entry to the shared history rather than copying the whole delay 
+// window. Entry numbers are absolute; base is the number of the oldest entry 
+// still held.
+//
+//         base            first          end
+//           v               v             v
+// History: | | | | | | | | | | | | | | | | | | |
+//                           | buffer uses |
+//
+// The history counts the buffers that start and end at each entry number. 
+// Entries older than any buffer's first entry are discarded, and entries at
+// or after the end of every buffer are overwritten by the next append. If some
+// living buffer (in a saved copy of a State, say) uses entries that an append
+// would overwrite, the appending buffer gets a new history of its own instead.
+// So the entries a living buffer uses never change, but States that share a 
+// history may be used by different threads, and the deques holding the 
+// entries are restructured as they grow and shrink. A buffer therefore locks
+// the history once for each operation, such as a search for the entries that
+// bracket a time, rather than once per entry. Entries are held in deques so
+// that references to them remain valid while entries are added or removed at
+// either end.
+template <class T>
+class Measure_Delay_History {
+public:
+    explicit Measure_Delay_History(int base) 
+    :   m_base(base), m_countBase(base), m_nFirsts(1, 0), m_nEnds(1, 0) {}
+
+    // Lock the history while a buffer reads its entries.
+    std::unique_lock<std::mutex> lock() const 
+    {   return std::unique_lock<std::mutex>(m_lock); }
+
+    // The caller must hold the lock.
+    double getTime(int i) const 
+    {   assert(m_base <= i && i < m_base + (int)m_times.size());
+        return m_times[i-m_base]; }
+    const T& getValue(int i) const 
+    {   assert(m_base <= i && i < m_base + (int)m_values.size());
+        return m_values[i-m_base]; }
+
+    // Add an entry for (t,value) as number end, replacing any entries already
+    // there or later, and register a buffer that uses entries [first,end]. 
+    // This fails and returns false if some other buffer uses entry end or 
+    // later.
+    bool append(int first, int end, double t, const T& value) {
+        std::lock_guard<std::mutex> lock(m_lock);
+        assert(m_base <= end && end <= m_base + (int)m_times.size());
+        for (int i=end+1-m_countBase; i < (int)m_nEnds.size(); ++i)
+            if (m_nEnds[i]) return false;
+        while (m_base + (int)m_times.size() > end) {
+            m_times.pop_back();
+            m_values.pop_back();
+        }
+        m_nFirsts.resize(end+1-m_countBase); m_nEnds.resize(end+1-m_countBase);
+        pushEntry(t, value);
+        addUser(first, end+1);
+        return true;
+    }
+
+    // Add an entry at the end of a new history that no buffer uses yet, so 
+    // isn't shared and needn't be locked.
+    void pushBack(double t, const T& value) 
+    {   assert(m_nFirsts.back()==0 && m_nEnds.back()==0);
+        pushEntry(t, value); }
+
+    // Register a buffer that uses entries [first,end).
+    void attach(int first, int end) 
+    {   std::lock_guard<std::mutex> lock(m_lock);
+        addUser(first, end); }
+
+    // Unregister a buffer that used entries [first,end) and discard the old
+    // entries that no buffer uses any more.
+    void detach(int first, int end) {
+        std::lock_guard<std::mutex> lock(m_lock);
+        assert(m_nFirsts[first-m_countBase] > 0 
+               && m_nEnds[end-m_countBase] > 0);
+        --m_nFirsts[first-m_countBase]; --m_nEnds[end-m_countBase];
+        while (!m_times.empty() && !m_nFirsts[m_base-m_countBase]) {
+            m_times.pop_front();
+            m_values.pop_front();
+            ++m_base;
+        }
+        // Drop the counts for discarded entries once there are as many of
+        // them as live ones, so that this takes constant time on average.
+        const int nDiscarded = m_base - m_countBase;
+        if (nDiscarded > (int)m_times.size()) {
+            m_nFirsts.erase(m_nFirsts.begin(), m_nFirsts.begin()+nDiscarded);
+            m_nEnds.erase(m_nEnds.begin(), m_nEnds.begin()+nDiscarded);
+            m_countBase = m_base;
+        }
+    }
+
+private:
+    void pushEntry(double t, const T& value) {
+        m_times.push_back(t);
+        m_values.push_back(value);
+        m_nFirsts.push_back(0); m_nEnds.push_back(0);
+    }
+    // The lock must be held.
+    void addUser(int first, int end) 
+    {   ++m_nFirsts[first-m_countBase]; ++m_nEnds[end-m_countBase]; }
+
+    mutable std::mutex  m_lock;
+    std::deque<double>  m_times;
+    std::deque<T>       m_values;
+    int                 m_base;      // entry number of m_times[0]
+    int                 m_countBase; // entry number of m_nFirsts[0]
+    // The number of buffers whose first entry, or end, is entry 
+    // m_countBase+i. These extend one past the newest entry since a buffer's
+    // end may be there.
+    std::vector<int>    m_nFirsts;
+    std::vector<int>    m_nEnds;
+};
+
 // This helper class is the contents of the discrete state variable and 
 // corresponding cache entry maintained by this measure. The variable is 
 // auto-update, meaning the value of the cache entry replaces the state 
-// variable at the start of each step.
-//
-// Circular buffers look like this:
-//
-//             oldest=0, n=0
-//                  v
-// Empty buffer:   |    available    |
-//
-// By convention, oldest=0 whenever the buffer is empty. 
-//
+// variable at the start of each step. The entries are kept in a 
+// Measure_Delay_History shared with the buffers it was copied from or updated
+// from, so copying or updating a buffer doesn't copy its entries.
 //
-//           oldest            next=(oldest+n)%capacity
-//                 v           v
-//    | available | | | | | | | available |
-//     ^                n=6                ^
-//     0                                   capacity
-//     v                                   v
-// or | | | | | | available | | | | | | | |    n=12
-//               ^           ^
-//               next        oldest
-//                 = (oldest+n)%capacity
-//
-// Number of entries = n (called size() below)
-// Empty = n==0
-// Full = n==capacity()
-// Next available = (oldest+n)%capacity()
+// Number of entries = size() = end-first
+// Empty = size()==0, in which case there may be no history at all
 template <class T>
 class Measure_Delay_Buffer {
+    typedef Measure_Delay_History<T> History;
 public:
     explicit Measure_Delay_Buffer() {initDataMembers();}
-    void clear() {initDataMembers();}
-    int  size() const {return m_size;} // # saved entries, *not* size of arrays
-    int  capacity() const {return m_times.size();}
+
+    Measure_Delay_Buffer(const Measure_Delay_Buffer& src)
+    :   m_history(src.m_history), m_first(src.m_first), m_end(src.m_end),
+        m_nHistoryCopies(src.m_nHistoryCopies), m_maxSize(src.m_maxSize)
+    {   if (m_history) m_history->attach(m_first, m_end); }
+
+    Measure_Delay_Buffer& operator=(const Measure_Delay_Buffer& src) {
+        if (&src != this) {
+            detach();
+            m_history = src.m_history;
+            m_first = src.m_first; m_end = src.m_end;
+            m_nHistoryCopies = src.m_nHistoryCopies;
+            m_maxSize = src.m_maxSize;
+            if (m_history) m_history->attach(m_first, m_end);
+        }
+        return *this;
+    }
+
+    ~Measure_Delay_Buffer() {detach();}
+
+    void clear() {detach(); initDataMembers();}
+    int  size() const {return m_end-m_first;} // # saved entries
     bool empty() const {return size()==0;}
-    bool full()  const {return size()==capacity();}
 
     double getEntryTime(int i) const
-    {   assert(i < size()); return m_times[getArrayIndex(i)];}
+    {   const std::unique_lock<std::mutex> lock(lockHistory());
+        return entryTime(i); }
+    // The entry doesn't change while this buffer uses it, so the reference 
+    // remains valid after the history is unlocked.
     const T& getEntryValue(int i) const
-    {   assert(i < size()); return m_values[getArrayIndex(i)];}
-
-    enum {  
-        InitialAllocation  = 8,  // smallest allocation 
-        GrowthFactor       = 2,  // how fast to grow (double)
-        MaxShrinkProofSize = 16, // won't shrink unless bigger
-        TooBigFactor       = 5   // 5X too much->maybe shrink
-    };
+    {   const std::unique_lock<std::mutex> lock(lockHistory());
+        return entryValue(i); }
 
     // Add a new entry to the end of the list, throwing out old entries that
     // aren't needed to answer requests at tEarliest or later.
     void append(double tEarliest, double tNow, const T& valueNow) {
-        forgetEntriesMuchOlderThan(tEarliest);
-        removeEntriesLaterOrEq(tNow);
-        if (full()) 
-            makeMoreRoom();
-        else if (capacity() > std::max((int)MaxShrinkProofSize, 
-                                       (int)TooBigFactor * (size()+1)))
-            makeLessRoom(); // less than 1/TooBigFactor full
-        const int nextFree = getArrayIndex(m_size++);
-        m_times[nextFree] = tNow;
-        m_values[nextFree] = valueNow;
-        m_maxSize = std::max(m_maxSize, size());
-    }
-
-    // Prepend an older entry to the beginning of the list. No cleanup is done.
-    void prepend(double tNewOldest, const T& value) {
-        assert(empty() || tNewOldest < m_times[m_oldest]);
-        if (full()) makeMoreRoom();
-        m_oldest = empty() ? 0 : getArrayIndex(-1);
-        m_times[m_oldest] = tNewOldest;
-        m_values[m_oldest] = value;
-        ++m_size;
-        m_maxSize = std::max(m_maxSize, size());
+        const Measure_Delay_Buffer oldBuf(*this);
+        copyInAndUpdate(oldBuf, tEarliest, tNow, valueNow);
     }
 
     // This is a specialized copy assignment for copying an old buffer
     // to a new one with updated contents. We are told the earliest time we'll
-    // be asked about from now on, and won't copy any entries older than those
-    // needed to answer that earliest request. We won't copy anything at or
+    // be asked about from now on, and won't keep any entries older than those
+    // needed to answer that earliest request. We won't keep anything at or
     // newer than tNow, and finally we'll push (tNow,valueNow) as the newest
-    // entry.
+    // entry. Unless some other buffer is using entries newer than the ones
+    // we keep, this shares the old buffer's history.
     void copyInAndUpdate(const Measure_Delay_Buffer& oldBuf, double tEarliest,
                          double tNow, const T& valueNow) {
-        // clear all current entries (no heap activity)
-        m_oldest = m_size = 0;
-
-        // determine how may old entries we have to keep
-        int firstNeeded = oldBuf.countNumUnneededOldEntries(tEarliest);
-        int lastNeeded  = oldBuf.findLastEarlier(tNow); // might be -1
-        int numOldEntriesToKeep = lastNeeded-firstNeeded+1;
-        int newSize = numOldEntriesToKeep+1; // includes the new one
-
-        int newSizeRequest = -1;
-        if (capacity() < newSize) {
-            newSizeRequest = std::max((int)InitialAllocation, 
-                                      (int)GrowthFactor * newSize);
-            ++m_nGrows;
-        } else if (capacity() > std::max((int)MaxShrinkProofSize, 
-                                         (int)TooBigFactor * newSize)) {
-            newSizeRequest = std::max((int)MaxShrinkProofSize, 
-                                      (int)GrowthFactor * newSize);
-            ++m_nShrinks;
+        if (&oldBuf == this) {
+            append(tEarliest, tNow, valueNow);
+            return;
         }
+        detach();
 
-        // Reallocate space if advisable.
-        if (newSizeRequest != -1) {
-            const double dNaN = NTraits<double>::getNaN();
-            m_values.resize(newSizeRequest); 
-            if (m_values.capacity() > m_values.size())
-                m_values.resize(m_values.capacity()); // don't waste any     
-            m_times.resize(m_values.size(), dNaN); 
+        // determine which of the old entries we have to keep
+        int firstNeeded, lastNeeded;
+        {   const std::unique_lock<std::mutex> lock(oldBuf.lockHistory());
+            firstNeeded = oldBuf.countNumUnneededOldEntries(tEarliest);
+            lastNeeded  = oldBuf.findLastEarlier(tNow); // might be -1
         }
-
-        m_maxCapacity = std::max(m_maxCapacity, capacity());
-        
-        // Copy the entries we need to keep.
-        int nxt = 0;
-        for (int i=firstNeeded; i<=lastNeeded; ++i, ++nxt) {
-            m_times[nxt]  = oldBuf.getEntryTime(i);
-            m_values[nxt] = oldBuf.getEntryValue(i);
+        const int first = oldBuf.m_first + firstNeeded;
+        const int end   = oldBuf.m_first + lastNeeded + 1;
+
+        m_nHistoryCopies = oldBuf.m_nHistoryCopies;
+        std::shared_ptr<History> history = oldBuf.m_history;
+        if (!history || !history->append(first, end, tNow, valueNow)) {
+            if (history) 
+                ++m_nHistoryCopies;
+            // Some other buffer uses entries that would be overwritten, so
+            // start a new history with copies of the entries we keep.
+            history.reset(new History(first));
+            const std::unique_lock<std::mutex> lock(oldBuf.lockHistory());
+            for (int i=firstNeeded; i <= lastNeeded; ++i)
+                history->pushBack(oldBuf.entryTime(i), oldBuf.entryValue(i));
+            history->append(first, end, tNow, valueNow);
         }
-        // Now add the newest entry and set the size.
-        m_times[nxt]  = tNow;
-        m_values[nxt] = valueNow;
-        assert(nxt+1==newSize);
-        m_size = nxt+1;
-        m_maxSize = std::max(m_maxSize, size());
+
+        m_history = history;
+        m_first = first;
+        m_end = end+1;
+        m_maxSize = std::max(oldBuf.m_maxSize, size());
     }
 
     // Given the current time and value and the earlier time at which the
@@ -1861,14 +2160,15 @@ public:
             return;
         }
 
+        const std::unique_lock<std::mutex> lock(lockHistory());
         int firstLater = findFirstLaterOrEq(tDelay);
 
         if (firstLater > 0) {
             // Normal case: tDelay is between two buffer entries.
             int firstEarlier = firstLater-1;
-            double t0=getEntryTime(firstEarlier), t1=getEntryTime(firstLater);
-            const T& v0=getEntryValue(firstEarlier);
-            const T& v1=getEntryValue(firstLater);
+            double t0=entryTime(firstEarlier), t1=entryTime(firstLater);
+            const T& v0=entryValue(firstEarlier);
+            const T& v1=entryValue(firstLater);
             Real fraction = Real((tDelay-t0)/(t1-t0));
             delayedValue = T(v0 + fraction*(v1-v0));
             return;
@@ -1877,7 +2177,7 @@ public:
         if (firstLater==0) {
             // Startup case: tDelay is at or before the oldest buffer entry.
             // Assume the value was flat before that.
-            delayedValue = getEntryValue(firstLater);
+            delayedValue = entryValue(firstLater);
             return;
         }
 
@@ -1886,68 +2186,51 @@ public:
 
         if (size() == 1) {
             // Just one entry; we'll have to assume the value is flat.
-            delayedValue = getEntryValue(0);
+            delayedValue = entryValue(0);
             return;
         }
 
         // Extrapolate using the last two entries.
-        double t0=getEntryTime(size()-2), t1=getEntryTime(size()-1);
-        const T& v0=getEntryValue(size()-2);
-        const T& v1=getEntryValue(size()-1);
+        double t0=entryTime(size()-2), t1=entryTime(size()-1);
+        const T& v0=entryValue(size()-2);
+        const T& v1=entryValue(size()-1);
         Real fraction = Real((tDelay-t0)/(t1-t0));  // > 1
         assert(fraction > 1.0);
         delayedValue = T(v0 + fraction*(v1-v0));   // Extrapolate.
     }
 
-    // Return the number of times we had to grow the buffer.
-    int getNumGrows() const {return m_nGrows;}
-    // Return the number of times we decided the buffer was so overallocated
-    // that we had to shrink it.
-    int getNumShrinks() const {return m_nShrinks;}
+    // Return the number of times this buffer or one it was updated from had
+    // to copy its entries into a new history because another buffer was 
+    // using the entries it would have replaced.
+    int getNumHistoryCopies() const {return m_nHistoryCopies;}
     // Return the largest number of values we ever had in the buffer.
     int getMaxSize() const {return m_maxSize;}
-    // Return the largest capacity the buffer ever had.
-    int getMaxCapacity() const {return m_maxCapacity;}
 
 private:
-    // Return the i'th oldest entry 
-    // (0 -> oldest, size-1 -> newest, size -> first free, -1 -> last free)
-    int getArrayIndex(int i) const 
-    {   assert(-1<=i && i<=size()); 
-        const int rawIndex = m_oldest + i;
-        if (rawIndex < 0) return rawIndex + capacity();
-        else return rawIndex % capacity(); }
-
-    // Remove all but two entries older than the given time.
-    void forgetEntriesMuchOlderThan(double tEarliest) {
-        const int numToRemove = countNumUnneededOldEntries(tEarliest);
-        if (numToRemove) {
-            m_oldest = getArrayIndex(numToRemove);
-            m_size -= numToRemove;
-        }
-    }
+    // Lock the buffer's history, if it has one, for the duration of a read.
+    std::unique_lock<std::mutex> lockHistory() const 
+    {   return m_history ? m_history->lock() : std::unique_lock<std::mutex>(); }
+
+    // Read an entry; the history must be locked.
+    double entryTime(int i) const
+    {   assert(0 <= i && i < size()); return m_history->getTime(m_first+i);}
+    const T& entryValue(int i) const
+    {   assert(0 <= i && i < size()); return m_history->getValue(m_first+i);}
 
     // Count up how many old entries at the beginning of the buffer are so old
     // that they wouldn't be needed to respond to a request at time tEarliest or
     // later. We'll keep no more than two entries earlier than tEarliest.
     int countNumUnneededOldEntries(double tEarliest) const {
-        const int firstLater = findFirstLaterOrEq(tEarliest);
+        int firstLater = findFirstLaterOrEq(tEarliest);
+        if (firstLater == -1) firstLater = size(); // all are earlier
         return std::max(0, firstLater-2);
     }
 
-    // Given the time now, delete anything at the end of the queue that is
-    // at that same time or later.
-    void removeEntriesLaterOrEq(double t) {
-        int lastEarlier = findLastEarlier(t);
-        m_size = lastEarlier+1;
-        if (m_size==0) m_oldest=0; // restart at beginning of array
-    }
-
     // Return the entry number (0..size-1) of the first entry whose time 
     // is >= the given time, or -1 if there is none such.
     int findFirstLaterOrEq(double tDelay) const {
         for (int i=0; i < size(); ++i)
-            if (getEntryTime(i) >= tDelay)
+            if (entryTime(i) >= tDelay)
                 return i;
         return -1;
     }
@@ -1956,71 +2239,32 @@ private:
     // is < the given time, or -1 if there is none such.
     int findLastEarlier(double t) const {
         for (int i=size()-1; i>=0; --i)
-            if (getEntryTime(i) < t)
+            if (entryTime(i) < t)
                 return i;
         return -1;
     }
 
-    // We don't have enough space. This is either the initial allocation or
-    // we need to double the current space.
-    void makeMoreRoom() {
-        const int newSizeRequest = std::max((int)InitialAllocation, 
-                                            (int)GrowthFactor * size());
-        resize(newSizeRequest);
-        ++m_nGrows;
-        m_maxCapacity = std::max(m_maxCapacity, capacity());
-    }
-
-    // We are wasting a lot of space, reduce the heap allocation to just 
-    // double what we're using now.
-    void makeLessRoom() {
-        const int targetMaxSize = std::max((int)MaxShrinkProofSize, 
-                                           (int)GrowthFactor * size());
-        if (capacity() > targetMaxSize) {
-            resize(targetMaxSize);
-            ++m_nShrinks;
-        }
-    }
-
-    // Reallocate memory to get more space or stop wasting space. The new
-    // size request must be big enough to hold all the current contents. The
-    // amount we actually get may be somewhat larger than the request. On 
-    // return, the times and values arrays will have been resized and the 
-    // oldest entry will now be entry 0.
-    void resize(int newSizeRequest) {
-        assert(newSizeRequest >= size());
-        const double dNaN = NTraits<double>::getNaN();
-        Array_<T,int> newValues(newSizeRequest); 
-        if (newValues.capacity() > newValues.size())
-            newValues.resize(newValues.capacity()); // don't waste any     
-        Array_<double,int> newTimes(newValues.size(), dNaN); 
-
-        // Pack existing values into start of new arrays.
-        for (int i=0; i < size(); ++i) {
-            const int ix = getArrayIndex(i);
-            newTimes[i]  = m_times[ix];
-            newValues[i] = m_values[ix];
+    // Stop using the history, if any.
+    void detach() {
+        if (m_history) {
+            m_history->detach(m_first, m_end);
+            m_history.reset();
         }
-        m_times.swap(newTimes); // switch heap space
-        m_values.swap(newValues);
-        m_oldest = 0; // starts at the beginning now; size unchanged
     }
 
     // Initialize everything to its default-constructed state.
     void initDataMembers() {
-        m_times.clear(); m_values.clear();
-        m_oldest=m_size=0;
-        m_nGrows=m_nShrinks=m_maxSize=m_maxCapacity=0;
+        m_history.reset();
+        m_first=m_end=0;
+        m_nHistoryCopies=m_maxSize=0;
     }
 
-    // These are circular buffers of the same size.
-    Array_<double,int>  m_times;
-    Array_<T,int>       m_values;
-    int                 m_oldest; // Array index of oldest (time,value)
-    int                 m_size;   // number of entries in use
+    std::shared_ptr<History>    m_history; // null if never appended to
+    int                         m_first;   // entry number of oldest entry
+    int                         m_end;     // one past the newest entry
 
     // Statistics.
-    int m_nGrows, m_nShrinks, m_maxSize, m_maxCapacity;
+    int m_nHistoryCopies, m_maxSize;
 };
 /** @endcond **/
 
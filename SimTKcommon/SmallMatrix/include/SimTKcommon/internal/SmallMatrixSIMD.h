@@ -0,0 +1,182 @@
+#ifndef SimTK_SIMMATRIX_SMALLMATRIX_SIMD_H_
+#define SimTK_SIMMATRIX_SMALLMATRIX_SIMD_H_
+
+/* -------------------------------------------------------------------------- *
+ *                       Simbody(tm): SimTKcommon                             *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/**@file
+ * This file provides explicitly vectorized versions of the most heavily used
+ * 3x3 double precision operations: Mat33*Mat33, Mat33*~Mat33 and Mat33*Vec3.
+ * Rotation and Transform composition, rotation of vectors, and the Mat33
+ * blocks of SpatialMat products all end up here. The instruction set is
+ * chosen when the including code is compiled: AVX if enabled (e.g. by
+ * setting the CMake variable BUILD_INST_SET to "avx" or "avx2"), else SSE2
+ * which every x86-64 compiler enables, else NEON on 64-bit ARM. Define
+ * SimTK_SIMD_DISABLE before including SimTKcommon headers to get the
+ * generic templates instead.
+ *
+ * Each element of the result is accumulated in the same order as in the
+ * generic (row times column) code, so results are identical unless the
+ * compiler contracts the scalar code into fused multiply-adds.
+ */
+
+#if !defined(SimTK_SIMD_DISABLE)
+    #if defined(__AVX__)
+        #define SimTK_SIMD_AVX
+        #include <immintrin.h>
+    #elif defined(__SSE2__) || defined(_M_X64) \
+          || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        #define SimTK_SIMD_SSE2
+        #include <emmintrin.h>
+    #elif defined(__aarch64__) && defined(__ARM_NEON)
+        #define SimTK_SIMD_NEON
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#if defined(SimTK_SIMD_AVX) || defined(SimTK_SIMD_SSE2) \
+    || defined(SimTK_SIMD_NEON)
+    #define SimTK_HAS_SIMD
+#endif
+
+#ifdef SimTK_HAS_SIMD
+
+namespace SimTK {
+
+// Hide from Doxygen.
+/** @cond **/
+namespace Impl {
+
+// Calculate c = a*b where a and c are packed, column-ordered 3x3 matrices
+// and element (i,j) of b is b[i*RS + j*CS]. Column j of c is built up as
+// a(0)*b(0,j) + a(1)*b(1,j) + a(2)*b(2,j), which gives each element the same
+// sum as the row-times-column dot product. c must not overlap a or b.
+template <int CS, int RS> inline void
+simdMat33Multiply(const double* a, const double* b, double* c) {
+#if defined(SimTK_SIMD_AVX)
+    // Load and store only the first 3 of 4 lanes; the 4th is ignored.
+    const __m256i mask = _mm256_set_epi64x(0, -1, -1, -1);
+    const __m256d a0 = _mm256_maskload_pd(a,   mask);
+    const __m256d a1 = _mm256_maskload_pd(a+3, mask);
+    const __m256d a2 = _mm256_maskload_pd(a+6, mask);
+    for (int j=0; j < 3; ++j) {
+        const double* bj = b + j*CS;
+        __m256d cj = _mm256_mul_pd(a0, _mm256_set1_pd(bj[0]));
+        cj = _mm256_add_pd(cj, _mm256_mul_pd(a1, _mm256_set1_pd(bj[RS])));
+        cj = _mm256_add_pd(cj, _mm256_mul_pd(a2, _mm256_set1_pd(bj[2*RS])));
+        _mm256_maskstore_pd(c + 3*j, mask, cj);
+    }
+#elif defined(SimTK_SIMD_SSE2)
+    // Rows 0 and 1 are done two at a time; row 2 is done by itself.
+    const __m128d a0 = _mm_loadu_pd(a), a1 = _mm_loadu_pd(a+3),
+                  a2 = _mm_loadu_pd(a+6);
+    for (int j=0; j < 3; ++j) {
+        const double* bj = b + j*CS;
+        __m128d cj = _mm_mul_pd(a0, _mm_set1_pd(bj[0]));
+        cj = _mm_add_pd(cj, _mm_mul_pd(a1, _mm_set1_pd(bj[RS])));
+        cj = _mm_add_pd(cj, _mm_mul_pd(a2, _mm_set1_pd(bj[2*RS])));
+        _mm_storeu_pd(c + 3*j, cj);
+        c[3*j+2] = a[2]*bj[0] + a[5]*bj[RS] + a[8]*bj[2*RS];
+    }
+#elif defined(SimTK_SIMD_NEON)
+    // Separate multiplies and adds (not vfmaq) to keep the scalar rounding.
+    const float64x2_t a0 = vld1q_f64(a), a1 = vld1q_f64(a+3),
+                      a2 = vld1q_f64(a+6);
+    for (int j=0; j < 3; ++j) {
+        const double* bj = b + j*CS;
+        float64x2_t cj = vmulq_f64(a0, vdupq_n_f64(bj[0]));
+        cj = vaddq_f64(cj, vmulq_f64(a1, vdupq_n_f64(bj[RS])));
+        cj = vaddq_f64(cj, vmulq_f64(a2, vdupq_n_f64(bj[2*RS])));
+        vst1q_f64(c + 3*j, cj);
+        c[3*j+2] = a[2]*bj[0] + a[5]*bj[RS] + a[8]*bj[2*RS];
+    }
+#endif
+}
+
+// Calculate c = a*v where a is a packed, column-ordered 3x3 matrix and
+// element i of v is v[i*S]. c must not overlap a or v.
+template <int S> inline void
+simdMat33TimesVec3(const double* a, const double* v, double* c) {
+#if defined(SimTK_SIMD_AVX)
+    const __m256i mask = _mm256_set_epi64x(0, -1, -1, -1);
+    __m256d r = _mm256_mul_pd(_mm256_maskload_pd(a, mask),
+                              _mm256_set1_pd(v[0]));
+    r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_maskload_pd(a+3, mask),
+                                       _mm256_set1_pd(v[S])));
+    r = _mm256_add_pd(r, _mm256_mul_pd(_mm256_maskload_pd(a+6, mask),
+                                       _mm256_set1_pd(v[2*S])));
+    _mm256_maskstore_pd(c, mask, r);
+#elif defined(SimTK_SIMD_SSE2)
+    __m128d r = _mm_mul_pd(_mm_loadu_pd(a), _mm_set1_pd(v[0]));
+    r = _mm_add_pd(r, _mm_mul_pd(_mm_loadu_pd(a+3), _mm_set1_pd(v[S])));
+    r = _mm_add_pd(r, _mm_mul_pd(_mm_loadu_pd(a+6), _mm_set1_pd(v[2*S])));
+    _mm_storeu_pd(c, r);
+    c[2] = a[2]*v[0] + a[5]*v[S] + a[8]*v[2*S];
+#elif defined(SimTK_SIMD_NEON)
+    float64x2_t r = vmulq_f64(vld1q_f64(a), vdupq_n_f64(v[0]));
+    r = vaddq_f64(r, vmulq_f64(vld1q_f64(a+3), vdupq_n_f64(v[S])));
+    r = vaddq_f64(r, vmulq_f64(vld1q_f64(a+6), vdupq_n_f64(v[2*S])));
+    vst1q_f64(c, r);
+    c[2] = a[2]*v[0] + a[5]*v[S] + a[8]*v[2*S];
+#endif
+}
+
+} // namespace Impl
+/** @endcond **/
+
+// These non-template overloads are preferred to the generic operator*()
+// templates when the arguments are exactly these types.
+
+/// Mat33*Mat33 for packed double precision matrices, using SIMD
+/// instructions. Same result as the generic Mat product.
+inline Mat<3,3,double>
+operator*(const Mat<3,3,double>& l, const Mat<3,3,double>& r) {
+    Mat<3,3,double> result;
+    Impl::simdMat33Multiply<3,1>(&l(0,0), &r(0,0), &result(0,0));
+    return result;
+}
+
+/// Mat33*~Mat33 (the right-hand matrix is stored by rows, as in a
+/// transposed Mat33 or an InverseRotation), using SIMD instructions.
+/// Same result as the generic Mat product.
+inline Mat<3,3,double>
+operator*(const Mat<3,3,double>& l, const Mat<3,3,double,1,3>& r) {
+    Mat<3,3,double> result;
+    Impl::simdMat33Multiply<1,3>(&l(0,0), &r(0,0), &result(0,0));
+    return result;
+}
+
+/// Mat33*Vec3 for a packed double precision matrix and vector, using SIMD
+/// instructions. Same result as the generic Mat*Vec product.
+inline Vec<3,double>
+operator*(const Mat<3,3,double>& m, const Vec<3,double>& v) {
+    Vec<3,double> result;
+    Impl::simdMat33TimesVec3<1>(&m(0,0), &v[0], &result[0]);
+    return result;
+}
+
+} //namespace SimTK
+
+#endif // SimTK_HAS_SIMD
+
+#endif //SimTK_SIMMATRIX_SMALLMATRIX_SIMD_H_
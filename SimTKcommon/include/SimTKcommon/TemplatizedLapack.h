@@ -50,6 +50,24 @@ public:
     const P b[], int ldb,
     const P& beta, P c[], int ldc) {assert(false);}
 
+        template <class P> static void
+    gemv
+   (char trans, int m, int n,
+    const P& alpha, const P a[], int lda,
+    const P x[], int incx,
+    const P& beta, P y[], int incy) {assert(false);}
+
+        template <class P> static P
+    dot(int n, const P x[], int incx, const P y[], int incy) 
+    {assert(false); return P(0);}
+
+        template <class P> static void
+    axpy(int n, const P& alpha, const P x[], int incx, P y[], int incy) 
+    {assert(false);}
+
+        template <class P> static void
+    scal(int n, const P& alpha, P x[], int incx) {assert(false);}
+
         template <class P> static void
     getri
    (int          n,
@@ -122,6 +140,49 @@ template <> inline void Lapack::gemm< complex<double> >
     );
 }
 
+    // xGEMV //
+
+template <> inline void Lapack::gemv<float>
+   (char trans, int m, int n,
+    const float& alpha, const float a[], int lda,
+    const float x[], int incx,
+    const float& beta, float y[], int incy)
+{
+    sgemv_(trans,m,n,alpha,a,lda,x,incx,beta,y,incy);
+}
+template <> inline void Lapack::gemv<double>
+   (char trans, int m, int n,
+    const double& alpha, const double a[], int lda,
+    const double x[], int incx,
+    const double& beta, double y[], int incy)
+{
+    dgemv_(trans,m,n,alpha,a,lda,x,incx,beta,y,incy);
+}
+
+    // xDOT, xAXPY, xSCAL //
+
+template <> inline float Lapack::dot<float>
+   (int n, const float x[], int incx, const float y[], int incy)
+{   return sdot_(n,x,incx,y,incy); }
+template <> inline double Lapack::dot<double>
+   (int n, const double x[], int incx, const double y[], int incy)
+{   return ddot_(n,x,incx,y,incy); }
+
+template <> inline void Lapack::axpy<float>
+   (int n, const float& alpha, const float x[], int incx, float y[], int incy)
+{   saxpy_(n,alpha,x,incx,y,incy); }
+template <> inline void Lapack::axpy<double>
+   (int n, const double& alpha, const double x[], int incx, 
+    double y[], int incy)
+{   daxpy_(n,alpha,x,incx,y,incy); }
+
+template <> inline void Lapack::scal<float>
+   (int n, const float& alpha, float x[], int incx)
+{   sscal_(n,alpha,x,incx); }
+template <> inline void Lapack::scal<double>
+   (int n, const double& alpha, double x[], int incx)
+{   dscal_(n,alpha,x,incx); }
+
     // xGETRI //
 
 template <> inline void Lapack::getri<float>
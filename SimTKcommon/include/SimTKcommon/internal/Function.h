@@ -91,6 +91,55 @@ public:
     T calcDerivative(const std::vector<int>& derivComponents, const Vector& x) const 
     {   return calcDerivative(ArrayViewConst_<int>(derivComponents),x); }
 
+    /**
+     * Calculate the value of this function at the point given by the \a n
+     * arguments pointed to by \a x. This saves the caller from constructing a
+     * Vector, which matters for callers that evaluate functions very often, 
+     * such as function-based mobilizers and coupling constraints. Pass a 
+     * fixed-size argument as, for example, calcValueAt(3, &v[0]) for a Vec3 v.
+     * 
+     * The default implementation calls calcValue() with a Vector that refers
+     * to \a x. The built-in functions override it to avoid even that 
+     * allocation; if you derive from one of them and change its calcValue(),
+     * change calcValueAt() too.
+     * 
+     * @param n     the number of arguments, which must equal the value 
+     *              returned by getArgumentSize()
+     * @param x     the arguments; not used if \a n is zero
+     */
+    virtual T calcValueAt(int n, const Real* x) const {
+        return calcValue(n ? Vector(n, x, true) : Vector());
+    }
+    /**
+     * Calculate a partial derivative of this function at the point given by
+     * the \a n arguments pointed to by \a x. The \a order input components
+     * with respect to which the derivative is taken are given in 
+     * \a derivComponents, as for calcDerivative(). Like calcValueAt(), this 
+     * is overridden by the built-in functions to avoid heap allocation.
+     */
+    virtual T calcDerivativeAt(int order, const int* derivComponents,
+                               int n, const Real* x) const {
+        return calcDerivative
+           (ArrayViewConst_<int>(derivComponents, derivComponents+order),
+            n ? Vector(n, x, true) : Vector());
+    }
+    /**
+     * Calculate the value of this function and all its first partial 
+     * derivatives at the point given by the \a n arguments pointed to by 
+     * \a x. The derivative with respect to argument i is written to 
+     * \a gradient[i], which must have room for \a n values. Functions that
+     * can share work between the value and its derivatives override this to
+     * be cheaper than separate calls.
+     * 
+     * @return the value of the function, as calcValueAt() would return
+     */
+    virtual T calcValueAndGradientAt(int n, const Real* x, T* gradient) const {
+        const Vector xv = n ? Vector(n, x, true) : Vector();
+        for (int i = 0; i < n; ++i)
+            gradient[i] = calcDerivative(ArrayViewConst_<int>(&i, &i+1), xv);
+        return calcValue(xv);
+    }
+
     /**
      * Get the number of components expected in the input vector.
      */
@@ -143,6 +192,21 @@ public:
                      const Vector& x) const override {
         return static_cast<T>(0);
     }
+    T calcValueAt(int n, const Real* x) const override {
+        assert(n == argumentSize);
+        return value;
+    }
+    T calcDerivativeAt(int order, const int* derivComponents,
+                       int n, const Real* x) const override {
+        return static_cast<T>(0);
+    }
+    T calcValueAndGradientAt(int n, const Real* x, 
+                             T* gradient) const override {
+        assert(n == argumentSize);
+        for (int i = 0; i < n; ++i)
+            gradient[i] = static_cast<T>(0);
+        return value;
+    }
     int getArgumentSize() const override {
         return argumentSize;
     }
@@ -197,6 +261,33 @@ public:
             return coefficients(derivComponents[0]);
         return static_cast<T>(0);
     }
+    T calcValueAt(int n, const Real* x) const override {
+        assert(n == coefficients.size()-1);
+        T value = static_cast<T>(0);
+        for (int i = 0; i < n; ++i)
+            value += x[i]*coefficients[i];
+        value += coefficients[n];
+        return value;
+    }
+    T calcDerivativeAt(int order, const int* derivComponents,
+                       int n, const Real* x) const override {
+        assert(n == coefficients.size()-1);
+        assert(order > 0);
+        if (order == 1)
+            return coefficients(derivComponents[0]);
+        return static_cast<T>(0);
+    }
+    T calcValueAndGradientAt(int n, const Real* x, 
+                             T* gradient) const override {
+        assert(n == coefficients.size()-1);
+        T value = static_cast<T>(0);
+        for (int i = 0; i < n; ++i) {
+            value += x[i]*coefficients[i];
+            gradient[i] = coefficients[i];
+        }
+        value += coefficients[n];
+        return value;
+    }
     int getArgumentSize() const override {
         return coefficients.size()-1;
     }
@@ -232,19 +323,31 @@ public:
     }
     T calcValue(const Vector& x) const override {
         assert(x.size() == 1);
-        Real arg = x[0];
+        const Real arg = x[0];
+        return calcValueAt(1, &arg);
+    }
+    T calcDerivative(const Array_<int>& derivComponents, 
+                     const Vector& x) const override {
+        assert(x.size() == 1);
+        const Real arg = x[0];
+        return calcDerivativeAt((int)derivComponents.size(), 
+                                derivComponents.begin(), 1, &arg);
+    }
+    T calcValueAt(int n, const Real* x) const override {
+        assert(n == 1);
+        const Real arg = x[0];
         T value = static_cast<T>(0);
         for (int i = 0; i < coefficients.size(); ++i)
             value = value*arg + coefficients[i];
         return value;
     }
-    T calcDerivative(const Array_<int>& derivComponents, 
-                     const Vector& x) const override {
-        assert(x.size() == 1);
-        assert(derivComponents.size() > 0);
-        Real arg = x[0];
+    T calcDerivativeAt(int order, const int* derivComponents,
+                       int n, const Real* x) const override {
+        assert(n == 1);
+        assert(order > 0);
+        const Real arg = x[0];
         T value = static_cast<T>(0);
-        const int derivOrder = (int)derivComponents.size();
+        const int derivOrder = order;
         const int polyOrder = coefficients.size()-1;
         for (int i = 0; i <= polyOrder-derivOrder; ++i) {
             T coeff = coefficients[i];
@@ -254,6 +357,19 @@ public:
         }
         return value;
     }
+    // Horner's rule, carrying the derivative along with the value.
+    T calcValueAndGradientAt(int n, const Real* x, 
+                             T* gradient) const override {
+        assert(n == 1);
+        const Real arg = x[0];
+        T value = static_cast<T>(0), deriv = static_cast<T>(0);
+        for (int i = 0; i < coefficients.size(); ++i) {
+            deriv = deriv*arg + value;
+            value = value*arg + coefficients[i];
+        }
+        gradient[0] = deriv;
+        return value;
+    }
     int getArgumentSize() const override {
         return 1;
     }
@@ -310,7 +426,18 @@ public:
     virtual Real calcDerivative(const Array_<int>& derivComponents,
                                 const Vector&      x) const override {
         const Real t = x[0]; // time is the only argument
-        const int order = derivComponents.size();
+        return calcDerivativeAt((int)derivComponents.size(),
+                                derivComponents.begin(), 1, &t);
+    }
+
+    Real calcValueAt(int n, const Real* x) const override {
+        const Real t = x[0]; // we expect just one argument
+        return a*std::sin(w*t + p);
+    }
+
+    Real calcDerivativeAt(int order, const int* derivComponents,
+                          int n, const Real* x) const override {
+        const Real t = x[0]; // time is the only argument
         // The n'th derivative is
         //    sign * a * w^n * sc
         // where sign is -1 if floor(order/2) is odd, else 1
@@ -328,6 +455,13 @@ public:
         }
     }
 
+    Real calcValueAndGradientAt(int n, const Real* x, 
+                                Real* gradient) const override {
+        const Real t = x[0];
+        gradient[0] = a*w*std::cos(w*t + p);
+        return a*std::sin(w*t + p);
+    }
+
     int getArgumentSize() const override {return 1;}
     int getMaxDerivativeOrder() const override {
         return std::numeric_limits<int>::max();
@@ -388,6 +522,15 @@ public:
             "Function_<T>::Step::calcValue()", 
             "Expected just one input argument but got %d.", xin.size());
 
+        const Real x = xin[0];
+        return calcValueAt(1, &x);
+    }
+
+    T calcValueAt(int n, const Real* xin) const override {
+        SimTK_ERRCHK1_ALWAYS(n == 1,
+            "Function_<T>::Step::calcValueAt()", 
+            "Expected just one input argument but got %d.", n);
+
         const Real x = xin[0];
         if ((x-m_x0)*m_sign <= 0) return m_y0;
         if ((x-m_x1)*m_sign >= 0) return m_y1;
@@ -402,7 +545,17 @@ public:
             "Function_<T>::Step::calcDerivative()", 
             "Expected just one input argument but got %d.", xin.size());
 
-        const int derivOrder = (int)derivComponents.size();
+        const Real x = xin[0];
+        return calcDerivativeAt((int)derivComponents.size(),
+                                derivComponents.begin(), 1, &x);
+    }
+
+    T calcDerivativeAt(int derivOrder, const int* derivComponents,
+                       int n, const Real* xin) const override {
+        SimTK_ERRCHK1_ALWAYS(n == 1,
+            "Function_<T>::Step::calcDerivativeAt()", 
+            "Expected just one input argument but got %d.", n);
+
         SimTK_ERRCHK1_ALWAYS(1 <= derivOrder && derivOrder <= 3,
             "Function_<T>::Step::calcDerivative()",
             "Only 1st, 2nd, and 3rd derivatives of the step are available,"
@@ -419,6 +572,19 @@ public:
         return NaN*m_yr; /*NOTREACHED*/
     }
 
+    T calcValueAndGradientAt(int n, const Real* xin, 
+                             T* gradient) const override {
+        SimTK_ERRCHK1_ALWAYS(n == 1,
+            "Function_<T>::Step::calcValueAndGradientAt()", 
+            "Expected just one input argument but got %d.", n);
+
+        const Real x = xin[0];
+        if ((x-m_x0)*m_sign <= 0) {gradient[0] = m_zero; return m_y0;}
+        if ((x-m_x1)*m_sign >= 0) {gradient[0] = m_zero; return m_y1;}
+        gradient[0] = dstepAny(1,m_x0,m_ooxr, x) * m_yr;
+        return m_y0 + stepAny(0,1,m_x0,m_ooxr, x)*m_yr;
+    }
+
     int getArgumentSize() const override {return 1;}
     int getMaxDerivativeOrder() const override {return 3;}
 
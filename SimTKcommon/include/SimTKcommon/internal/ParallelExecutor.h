@@ -123,6 +123,16 @@ public:
      * @param times   the number of times the Task should be executed
      */
     void execute(Task& task, int times);
+    /**
+     * Execute a parallel task as execute() does, except that if any
+     * invocation of the Task throws an exception, the first one thrown is
+     * rethrown here once all the invocations have finished. (An exception
+     * can't propagate out of a worker thread, so execute() just reports it.)
+     *
+     * @param task    the Task to execute
+     * @param times   the number of times the Task should be executed
+     */
+    void executeAndRethrow(Task& task, int times);
     /**
      * Get the total number of available processor cores (physical cores and
      * hyperthreads on Intel architecture). If the number of threads is not
@@ -27,6 +27,7 @@
 #include <iostream>
 #include <string>
 #include <algorithm>
+#include <exception>
 #include <mutex>
 
 using namespace std;
@@ -179,6 +180,38 @@ void ParallelExecutor::execute(Task& task, int times) {
     updImpl().execute(task, times);
 }
 
+namespace {
+// Runs another Task, saving the first exception thrown by any invocation of
+// its execute() method so that it can be rethrown on the calling thread.
+class RethrowingTask : public ParallelExecutor::Task {
+public:
+    explicit RethrowingTask(ParallelExecutor::Task& task) : task(task) {}
+
+    void execute(int index) override {
+        try {
+            task.execute(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) error = std::current_exception();
+        }
+    }
+    void initialize() override {task.initialize();}
+    void finish() override {task.finish();}
+
+    std::exception_ptr      error;
+private:
+    ParallelExecutor::Task& task;
+    std::mutex              mutex;
+};
+}
+
+void ParallelExecutor::executeAndRethrow(Task& task, int times) {
+    RethrowingTask rethrowingTask(task);
+    execute(rethrowingTask, times);
+    if (rethrowingTask.error)
+        std::rethrow_exception(rethrowingTask.error);
+}
+
 #ifdef __APPLE__
    #include <sys/sysctl.h>
    #include <dlfcn.h>
@@ -220,10 +220,79 @@ void testGaussian() {
     ASSERT(value2[2000] == 567.8)
 }
 
+/**
+ * Verify that bulk generation gives exactly the values that getValue() would have, including when the requests
+ * span several internal buffers, are interleaved with getValue(), or leave half of a Gaussian pair unused.
+ */
+
+void testBulk(Random& rand) {
+    const int lengths[] = {1, 2, 3, 1023, 1024, 1025, 5001, 7};
+    rand.setSeed(5);
+    Array_<Real> expected;
+    for (int length : lengths) {
+        for (int i = 0; i < length; ++i)
+            expected.push_back(rand.getValue());
+        expected.push_back(rand.getValue());
+    }
+    rand.setSeed(5);
+    int next = 0;
+    for (int length : lengths) {
+        Vector values(length);
+        rand.fill(values);
+        for (int i = 0; i < length; ++i)
+            ASSERT(values[i] == expected[next++])
+        ASSERT(rand.getValue() == expected[next++])
+    }
+
+    // A VectorView with a stride.
+    Matrix m(4, 3, Real(-1));
+    rand.setSeed(6);
+    Real value[3];
+    for (int i = 0; i < 3; ++i)
+        value[i] = rand.getValue();
+    rand.setSeed(6);
+    VectorView diagonal = m.updDiag();
+    rand.fill(diagonal);
+    for (int i = 0; i < 3; ++i)
+        ASSERT(m(i,i) == value[i])
+    ASSERT(m(1,0) == -1 && m(0,1) == -1 && m(3,2) == -1)
+}
+
+/**
+ * Verify that streams are reproducible and distinct from one another.
+ */
+
+void testStreams() {
+    Random::Gaussian rand;
+    Vector stream0(2000), stream1(2000), again(2000);
+    rand.setSeed(7, 0);
+    rand.fill(stream0);
+    rand.setSeed(7, 1);
+    rand.fill(stream1);
+    rand.setSeed(7, 0);
+    rand.fill(again);
+    for (int i = 0; i < 2000; ++i) {
+        ASSERT(again[i] == stream0[i])
+        ASSERT(stream1[i] != stream0[i])
+    }
+    verifyGaussianDistribution(0.0, 1.0, &stream1[0], 2000);
+
+    // A stream is not the same as the plain seed.
+    rand.setSeed(7);
+    rand.fill(again);
+    for (int i = 0; i < 2000; ++i)
+        ASSERT(again[i] != stream0[i])
+}
+
 int main() {
     try {
         testUniform();
         testGaussian();
+        Random::Uniform uniform(-2.0, 3.0);
+        testBulk(uniform);
+        Random::Gaussian gaussian(1.0, 2.0);
+        testBulk(gaussian);
+        testStreams();
     } catch(const std::exception& e) {
         cout << "exception: " << e.what() << endl;
         return 1;
@@ -104,6 +104,107 @@ void testTransform() {
     SimTK_TEST(~vs*R == -(-~vs*R));
 }
 
+// Products of Real matrices and vectors go to the BLAS when their layout
+// allows; compare them with the obvious loops for layouts that can and
+// can't be handled that way.
+static Matrix slowProduct(const Matrix& a, const Matrix& b) {
+    Matrix c(a.nrow(), b.ncol(), Real(0));
+    for (int i=0; i < a.nrow(); ++i)
+        for (int j=0; j < b.ncol(); ++j)
+            for (int k=0; k < a.ncol(); ++k)
+                c(i,j) += a(i,k)*b(k,j);
+    return c;
+}
+
+static Matrix randomMatrix(Random& rand, int m, int n) {
+    Matrix a(m, n);
+    for (int j=0; j < n; ++j)
+        for (int i=0; i < m; ++i)
+            a(i,j) = rand.getValue();
+    return a;
+}
+
+void testBlasProducts() {
+    Random::Uniform rand(-1, 1);
+    const Real tol = 1e-12;
+    const Matrix A = randomMatrix(rand, 5, 4), B = randomMatrix(rand, 4, 3);
+    const Matrix AB = slowProduct(A, B);
+
+    // Plain, transposed and sub-block operands.
+    SimTK_TEST_EQ_TOL(A*B, AB, tol);
+    const Matrix At = ~A, Bt = ~B;
+    SimTK_TEST_EQ_TOL((~At)*(~Bt), AB, tol);
+    SimTK_TEST_EQ_TOL((~At)*B, AB, tol);
+    const Matrix big = randomMatrix(rand, 9, 8);
+    const MatrixView blk = big(2,1,5,4);
+    SimTK_TEST_EQ_TOL(blk*B, slowProduct(Matrix(blk), B), tol);
+    SimTK_TEST_EQ_TOL(~blk*A, slowProduct(~Matrix(blk), A), tol);
+
+    // Vectors, including strided views of rows and columns.
+    const Vector x = B(1);
+    const VectorView xs = ~big[3](0,4);
+    Matrix xsm(4, 1); xsm(0) = xs;
+    Real xsx = 0;
+    for (int i=0; i < 4; ++i) xsx += xs[i]*x[i];
+    SimTK_TEST_EQ_TOL(A*x, AB(1), tol);
+    SimTK_TEST_EQ_TOL(A*xs, slowProduct(A, xsm)(0), tol);
+    SimTK_TEST_EQ_TOL((~At)*xs, slowProduct(A, xsm)(0), tol);
+    SimTK_TEST_EQ_TOL(big[3](0,4)*x, xsx, tol);
+    SimTK_TEST_EQ_TOL(A[2]*x, AB(2,1), tol);
+
+    // Empty inner dimension gives zeroes.
+    SimTK_TEST_EQ(Matrix(3,0)*Matrix(0,2), Matrix(3,2,Real(0)));
+    SimTK_TEST_EQ(Matrix(3,0)*Vector(0), Vector(3,Real(0)));
+    SimTK_TEST(RowVector(0)*Vector(0) == 0);
+
+    // In-place updates, including results stored by rows, results that
+    // are garbage when beta is zero, and results that overlap an operand.
+    Matrix C = randomMatrix(rand, 5, 3);
+    const Matrix C0 = C;
+    multiplyAdd(2, A, B, -1, C);
+    SimTK_TEST_EQ_TOL(C, 2*AB - C0, tol);
+    Matrix Ct = ~C0;
+    MatrixView CtView = ~Ct;
+    multiplyAdd(2, A, B, -1, CtView);
+    SimTK_TEST_EQ_TOL(Ct, ~(2*AB - C0), tol);
+    C.setToNaN();
+    multiplyAdd(1, A, B, 0, C);
+    SimTK_TEST_EQ_TOL(C, AB, tol);
+    Matrix S = randomMatrix(rand, 4, 4);
+    const Matrix SS = slowProduct(S, S);
+    multiplyAdd(1, S, S, 0, S);
+    SimTK_TEST_EQ_TOL(S, SS, tol);
+
+    Vector y = C0(2);
+    multiplyAdd(2, A, x, 3, y);
+    SimTK_TEST_EQ_TOL(y, 2*AB(1) + 3*C0(2), tol);
+    Matrix M = randomMatrix(rand, 4, 4);
+    const Vector Mc = M*Vector(M(0));
+    VectorView M0 = M(0);
+    multiplyAdd(1, M, M0, 0, M0); // result is an operand
+    SimTK_TEST_EQ_TOL(M(0), Mc, tol);
+
+    Vector z = C0(0);
+    scaleAdd(2, AB(0), 3, z);
+    SimTK_TEST_EQ_TOL(z, 2*AB(0) + 3*C0(0), tol);
+    scaleAdd(2, z, 1, z);
+    SimTK_TEST_EQ_TOL(z, 3*(2*AB(0) + 3*C0(0)), tol);
+    Matrix W = big;
+    VectorView w0 = W(0)(0,5);
+    scaleAdd(-1, ~big[1](0,5), 2, w0);
+    SimTK_TEST_EQ_TOL(w0, 2*big(0)(0,5) - ~big[1](0,5), tol);
+    Vector overlap(Vec4(1,2,3,4));
+    VectorView tail = overlap(1,3);
+    scaleAdd(1, overlap(0,3), 1, tail); // x and y share elements
+    testVector(overlap, Vec4(1,3,5,7));
+    z.setToNaN();
+    scaleAdd(2, AB(0), 0, z);
+    SimTK_TEST_EQ_TOL(z, 2*AB(0), tol);
+
+    SimTK_TEST_MUST_THROW(multiplyAdd(1, A, A, 0, C));
+    SimTK_TEST_MUST_THROW(scaleAdd(1, x, 1, y));
+}
+
 // Make sure we can instantiate all of these successfully.
 namespace SimTK {
 template class MatrixBase<double>;
@@ -145,6 +246,7 @@ int main() {
 
         testMatDivision();
         testTransform();
+        testBlasProducts();
         
         Matrix m(Mat22(1, 2, 3, 4));
         testMatrix<Matrix,2,2>(m, Mat22(1, 2, 3, 4));
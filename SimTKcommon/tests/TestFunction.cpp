@@ -196,6 +196,71 @@ void testStep() {
     SimTK_TEST(sv.calcDerivative(derivOrder2, Vector(1, -29.3)) == Vec3(0));
 }
 
+// A function that only implements the required virtuals, so is evaluated
+// through the default implementations of the pointer-based interface.
+class ProductFunction : public Function {
+public:
+    Real calcValue(const Vector& x) const override {return x[0]*x[1];}
+    Real calcDerivative(const Array_<int>& derivComponents, 
+                        const Vector& x) const override {
+        if (derivComponents.size() == 1) return x[1-derivComponents[0]];
+        if (derivComponents.size() == 2)
+            return derivComponents[0] != derivComponents[1] ? 1 : 0;
+        return 0;
+    }
+    int getArgumentSize() const override {return 2;}
+    int getMaxDerivativeOrder() const override {return 2;}
+};
+
+// Check that calcValueAt(), calcDerivativeAt() and calcValueAndGradientAt()
+// agree with calcValue() and calcDerivative() at the point x.
+template <class T>
+void checkPointerInterface(const Function_<T>& f, const Vector& x) {
+    const int n = x.size();
+    const Real* xp = &x[0];
+    SimTK_TEST_EQ(f.calcValueAt(n, xp), f.calcValue(x));
+
+    Array_<T> grad(n);
+    SimTK_TEST_EQ(f.calcValueAndGradientAt(n, xp, grad.begin()), 
+                  f.calcValue(x));
+    for (int i = 0; i < n; ++i) {
+        const Array_<int> d1(1, i);
+        SimTK_TEST_EQ(grad[i], f.calcDerivative(d1, x));
+        SimTK_TEST_EQ(f.calcDerivativeAt(1, d1.begin(), n, xp), 
+                      f.calcDerivative(d1, x));
+        for (int j = 0; j < n; ++j) {
+            Array_<int> d2(1, i); d2.push_back(j);
+            SimTK_TEST_EQ(f.calcDerivativeAt(2, d2.begin(), n, xp), 
+                          f.calcDerivative(d2, x));
+        }
+    }
+}
+
+void testPointerInterface() {
+    checkPointerInterface(Function_<Vec3>::Constant(Vec3(1, 2, 3), 2), 
+                          Vector(Vec2(.5, -1)));
+
+    Vector_<Vec3> coeff(3);
+    coeff[0] = Vec3(1, 2, 3);
+    coeff[1] = Vec3(4, 3, 2);
+    coeff[2] = Vec3(-1, -2, -3);
+    checkPointerInterface(Function_<Vec3>::Linear(coeff), 
+                          Vector(Vec2(.5, -1)));
+    checkPointerInterface(Function_<Vec3>::Polynomial(coeff), 
+                          Vector(1, Real(1.7)));
+    checkPointerInterface(Function::Sinusoid(11.23, 1.1, Pi/4), 
+                          Vector(1, Real(.23)));
+    checkPointerInterface(Function::Step(-1, 1, 0, 1), 
+                          Vector(1, Real(.3)));
+    checkPointerInterface(Function::Step(-1, 1, 0, 1), 
+                          Vector(1, Real(-2)));
+    checkPointerInterface(ProductFunction(), Vector(Vec2(3, -2)));
+
+    // A Vec can be passed directly.
+    const Vec2 x(3, -2);
+    SimTK_TEST_EQ(ProductFunction().calcValueAt(2, &x[0]), -6);
+}
+
 int main () {
     SimTK_START_TEST("TestFunction");
 
@@ -205,6 +270,7 @@ int main () {
         SimTK_SUBTEST(testSinusoid);
         SimTK_SUBTEST(testRealFunction);
         SimTK_SUBTEST(testStep);
+        SimTK_SUBTEST(testPointerInterface);
 
     SimTK_END_TEST();
 }
@@ -0,0 +1,168 @@
+/* -------------------------------------------------------------------------- *
+ *                       Simbody(tm): SimTKcommon                             *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Test the buffer used by Measure::Delay, which keeps its entries in a history
+shared with the buffers it was copied or updated from. Here the discrete 
+state variable holding the buffer and its update value are simulated directly,
+as they are used by Measure_<T>::Delay::Implementation. */
+
+#include "SimTKcommon.h"
+
+#include <iostream>
+#include <thread>
+
+using namespace SimTK;
+using std::cout; using std::endl;
+
+typedef Measure_Delay_Buffer<Real> Buffer;
+
+static const Real Delay = 0.05; // 50 ms
+static const Real Dt = 1e-4;    // at 10 kHz
+
+// A linear signal, so that the interpolated delayed values are exact.
+static Real signal(Real t) {return 3*t - 1;}
+
+// Take n steps, each starting from var. The update value is computed at the
+// end of the step and then replaces var, like an auto-update variable.
+static void takeSteps(Buffer& var, Real& t, int n) {
+    Buffer upd;
+    for (int i=0; i < n; ++i) {
+        t += Dt;
+        upd.copyInAndUpdate(var, t-Delay, t, signal(t));
+        var = upd;
+    }
+}
+
+static Real delayedValue(const Buffer& buf, Real t) {
+    Real value;
+    buf.calcValueAtTimeLinearOnly(t-Delay, value);
+    return value;
+}
+
+static void testStepping() {
+    Buffer var;
+    Real t = 0;
+    var.append(t-Delay, t, signal(t));
+    takeSteps(var, t, 2000);
+
+    SimTK_TEST(var.getNumHistoryCopies() == 0);
+    SimTK_TEST(var.size() <= Delay/Dt + 3);
+    SimTK_TEST_EQ(var.getEntryTime(var.size()-1), t);
+    SimTK_TEST_EQ(delayedValue(var, t), signal(t-Delay));
+    SimTK_TEST_EQ(delayedValue(var, t - Dt/3), signal(t - Dt/3 - Delay));
+}
+
+// Several trial updates from the same variable, as for the stages of a 
+// Runge-Kutta step, replace one another without copying.
+static void testTrialUpdates() {
+    Buffer var;
+    Real t = 0;
+    var.append(t-Delay, t, signal(t));
+    takeSteps(var, t, 1000);
+    const int n = var.size();
+
+    Buffer upd;
+    const Real trials[] = {t+Dt/2, t+Dt, t+Dt/4};
+    for (Real tTrial : trials) {
+        upd.copyInAndUpdate(var, tTrial-Delay, tTrial, signal(tTrial));
+        SimTK_TEST_EQ(upd.getEntryTime(upd.size()-1), tTrial);
+        SimTK_TEST_EQ(delayedValue(upd, tTrial), signal(tTrial-Delay));
+    }
+    SimTK_TEST(upd.getNumHistoryCopies() == 0);
+    SimTK_TEST(var.size() == n);
+    SimTK_TEST_EQ(var.getEntryTime(n-1), t);
+}
+
+// A saved copy keeps its entries while the original moves on, and updating
+// the saved copy later must not disturb the original's entries.
+static void testBranching() {
+    Buffer var;
+    Real t = 0;
+    var.append(t-Delay, t, signal(t));
+    takeSteps(var, t, 1000);
+
+    const Buffer saved(var);
+    const Real tSaved = t;
+    takeSteps(var, t, 1000);
+    SimTK_TEST(var.getNumHistoryCopies() == 0);
+    SimTK_TEST_EQ(saved.getEntryTime(saved.size()-1), tSaved);
+    SimTK_TEST_EQ(delayedValue(saved, tSaved), signal(tSaved-Delay));
+
+    // Continuing from the saved copy has to copy the history since var is
+    // using the entries after the saved ones.
+    Buffer branch(saved);
+    Real tBranch = tSaved;
+    takeSteps(branch, tBranch, 10);
+    SimTK_TEST(branch.getNumHistoryCopies() == 1);
+    SimTK_TEST_EQ(delayedValue(branch, tBranch), signal(tBranch-Delay));
+    SimTK_TEST_EQ(var.getEntryTime(var.size()-1), t);
+    SimTK_TEST_EQ(delayedValue(var, t), signal(t-Delay));
+
+    // Now var can step on without copying again.
+    takeSteps(var, t, 10);
+    SimTK_TEST(var.getNumHistoryCopies() == 0);
+}
+
+// Copies of a State may be advanced on different threads.
+static void testThreads() {
+    Buffer var;
+    Real t = 0;
+    var.append(t-Delay, t, signal(t));
+    takeSteps(var, t, 600);
+
+    Buffer var1(var), var2(var);
+    Real t1 = t, t2 = t;
+    std::thread thread1([&] {takeSteps(var1, t1, 2000);});
+    std::thread thread2([&] {takeSteps(var2, t2, 3000);});
+    thread1.join(); thread2.join();
+
+    SimTK_TEST(var1.getNumHistoryCopies() + var2.getNumHistoryCopies() <= 1);
+    SimTK_TEST_EQ(delayedValue(var1, t1), signal(t1-Delay));
+    SimTK_TEST_EQ(delayedValue(var2, t2), signal(t2-Delay));
+    SimTK_TEST_EQ(delayedValue(var, t), signal(t-Delay));
+}
+
+static void testVector() {
+    Measure_Delay_Buffer<Vector> var;
+    Real t = 0;
+    var.append(t-Delay, t, Vector(3, signal(t)));
+    Measure_Delay_Buffer<Vector> upd;
+    for (int i=0; i < 1000; ++i) {
+        t += Dt;
+        upd.copyInAndUpdate(var, t-Delay, t, Vector(3, signal(t)));
+        var = upd;
+    }
+    Vector value;
+    var.calcValueAtTimeLinearOnly(t-Delay, value);
+    SimTK_TEST_EQ(value, Vector(3, signal(t-Delay)));
+}
+
+int main() {
+    SimTK_START_TEST("TestMeasureDelayBuffer");
+        SimTK_SUBTEST(testStepping);
+        SimTK_SUBTEST(testTrialUpdates);
+        SimTK_SUBTEST(testBranching);
+        SimTK_SUBTEST(testThreads);
+        SimTK_SUBTEST(testVector);
+    SimTK_END_TEST();
+}
@@ -100,11 +100,47 @@ void testResizeThreads() {
         SimTK_TEST(executor.getMaxThreads() == x);
     }
 }
+
+// Every invocation runs even though some of them throw, and one of the
+// exceptions is rethrown on the calling thread.
+class ThrowingTask : public ParallelExecutor::Task {
+public:
+    explicit ThrowingTask(Array_<int>& flags) : flags(flags) {}
+    void execute(int index) override {
+        flags[index]++;
+        if (index % 10 == 3)
+            SimTK_THROW1(Exception::Cant, "index ends in 3");
+    }
+private:
+    Array_<int>& flags;
+};
+
+void testExecuteAndRethrow() {
+    const int numFlags = 100;
+    for (int numThreads = 1; numThreads <= 4; numThreads += 3) {
+        Array_<int> flags(numFlags, 0);
+        ParallelExecutor executor(numThreads);
+        ThrowingTask task(flags);
+        SimTK_TEST_MUST_THROW_EXC(executor.executeAndRethrow(task, numFlags),
+                                  Exception::Cant);
+        for (int j = 0; j < numFlags; ++j)
+            ASSERT(flags[j] == 1);
+
+        // Without exceptions it is the same as execute().
+        int count = 0;
+        isParallel = numThreads > 1;
+        SetFlagTask flagTask(flags, count);
+        executor.executeAndRethrow(flagTask, numFlags);
+        ASSERT(count == numFlags);
+    }
+}
+
 int main() {
     SimTK_START_TEST("TestParallelExecutor");
         SimTK_SUBTEST(testParallelExecution);
         SimTK_SUBTEST(testSingleThreadedExecution);
         SimTK_SUBTEST(testResizeThreads);
+        SimTK_SUBTEST(testExecuteAndRethrow);
     SimTK_END_TEST();
     return 0;
 }
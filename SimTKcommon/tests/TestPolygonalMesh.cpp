@@ -23,6 +23,9 @@
 
 #include "SimTKcommon.h"
 
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 
 #define ASSERT(cond) {SimTK_ASSERT_ALWAYS(cond, "Assertion failed");}
@@ -109,10 +112,187 @@ void testLoadObjFile() {
     ASSERT(mesh.getFaceVertex(3, 3) == 1);
 }
 
+// Write a small base64 encoder so we can make binary .vtp files.
+static string encodeBase64(const string& bytes) {
+    const char* alphabet =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    string out;
+    for (size_t i=0; i < bytes.size(); i += 3) {
+        const size_t n = std::min<size_t>(3, bytes.size()-i);
+        unsigned bits = 0;
+        for (size_t k=0; k < 3; ++k)
+            bits = (bits << 8) | (k < n ? (unsigned char)bytes[i+k] : 0);
+        for (size_t k=0; k < 4; ++k)
+            out += k <= n ? alphabet[(bits >> (18-6*k)) & 63] : '=';
+    }
+    return out;
+}
+
+// Binary VTK data is preceded by a UInt32 byte count.
+template <class T>
+static string makeBinaryBlock(const Array_<T>& values) {
+    const unsigned nbytes = values.size()*sizeof(T);
+    string block((const char*)&nbytes, sizeof(nbytes));
+    block.append((const char*)values.begin(), nbytes);
+    return block;
+}
+
+// A square with one quad and one triangle above it. Write it as a .vtp
+// file using the given DataArray format ("ascii", "binary", or "appended")
+// and, for appended data, encoding ("raw" or "base64").
+static void writeVtpFile(const string& fileName, const string& format,
+                         const string& encoding) {
+    Array_<float> points;
+    const float coords[] = {0,0,0, 1,0,0, 1,1,0, 0,1,0, .5f,.5f,1};
+    points.assign(coords, coords+15);
+    Array_<int> connectivity, offsets;
+    const int conn[] = {0,1,2,3, 0,1,4};
+    connectivity.assign(conn, conn+7);
+    offsets.push_back(4); offsets.push_back(7);
+
+    string appended;
+    const auto dataArray = [&](const string& type, const string& name,
+                               const string& ascii, const string& binary)
+    {   string s = "<DataArray type=\"" + type + "\" Name=\"" + name
+                   + "\" NumberOfComponents=\"" 
+                   + (name=="Points" ? "3" : "1")
+                   + "\" format=\"" + format + "\"";
+        if (format == "ascii")  return s + ">" + ascii + "</DataArray>\n";
+        if (format == "binary") 
+            return s + ">" + encodeBase64(binary) + "</DataArray>\n";
+        s += " offset=\"" + String(appended.size()) + "\"/>\n";
+        appended += encoding=="raw" ? binary : encodeBase64(binary);
+        return s;
+    };
+
+    string xml = "<?xml version=\"1.0\"?>\n"
+        "<VTKFile type=\"PolyData\" version=\"0.1\""
+        " byte_order=\"LittleEndian\">\n<PolyData>\n"
+        "<Piece NumberOfPoints=\"5\" NumberOfPolys=\"2\">\n<Points>\n";
+    xml += dataArray("Float32", "Points", "0 0 0 1 0 0 1 1 0 0 1 0 .5 .5 1",
+                     makeBinaryBlock(points));
+    xml += "</Points>\n<Polys>\n";
+    xml += dataArray("Int32", "connectivity", "0 1 2 3 0 1 4",
+                     makeBinaryBlock(connectivity));
+    xml += dataArray("Int32", "offsets", "4 7", makeBinaryBlock(offsets));
+    xml += "</Polys>\n</Piece>\n</PolyData>\n";
+    if (format == "appended")
+        xml += "<AppendedData encoding=\"" + encoding + "\">\n_"
+               + appended + "\n</AppendedData>\n";
+    xml += "</VTKFile>\n";
+
+    ofstream out(fileName.c_str(), ios_base::binary);
+    out << xml;
+}
+
+void testLoadVtpFile() {
+    const char* formats[][2] = {{"ascii",""}, {"binary",""}, 
+                                {"appended","raw"}, {"appended","base64"}};
+    for (int f=0; f < 4; ++f) {
+        const string fileName = "TestPolygonalMesh.vtp";
+        writeVtpFile(fileName, formats[f][0], formats[f][1]);
+        PolygonalMesh mesh;
+        mesh.loadFile(fileName);
+        remove(fileName.c_str());
+        ASSERT(mesh.getNumVertices() == 5);
+        ASSERT(mesh.getNumFaces() == 2);
+        ASSERT(mesh.getVertexPosition(2) == Vec3(1,1,0));
+        ASSERT(mesh.getVertexPosition(4) == Vec3(.5,.5,1));
+        ASSERT(mesh.getNumVerticesForFace(0) == 4);
+        ASSERT(mesh.getNumVerticesForFace(1) == 3);
+        ASSERT(mesh.getFaceVertex(0, 3) == 3);
+        ASSERT(mesh.getFaceVertex(1, 2) == 4);
+    }
+}
+
+// Both STL formats store each triangle's vertices separately; they must be
+// welded back together.
+void testLoadStlFile() {
+    const string asciiName = "TestPolygonalMesh.stl";
+    {   ofstream out(asciiName.c_str());
+        out << "solid square\n"
+               "  facet normal 0 0 1\n    outer loop\n"
+               "      vertex 0 0 0\n      vertex 1 0 0\n"
+               "      vertex 1 1 0\n    endloop\n  endfacet\n"
+               "# a comment\n"
+               "  FACET NORMAL 0 0 1\n    OUTER LOOP\n"
+               "      VERTEX 0 0 0\n      VERTEX 1 1 0\n"
+               "      VERTEX 0 1.0000000001 0\n    ENDLOOP\n  ENDFACET\n"
+               "endsolid square\n";
+    }
+    PolygonalMesh ascii;
+    ascii.loadFile(asciiName);
+    remove(asciiName.c_str());
+    ASSERT(ascii.getNumFaces() == 2);
+    ASSERT(ascii.getNumVertices() == 4);
+    ASSERT(ascii.getFaceVertex(1, 0) == 0);
+    ASSERT(ascii.getFaceVertex(1, 1) == 2);
+
+    // Binary version of the same thing. The header starts with "solid" to
+    // make sure we don't mistake it for ascii.
+    const string binaryName = "TestPolygonalMeshBinary.stl";
+    {   ofstream out(binaryName.c_str(), ios_base::binary);
+        char header[80] = "solid but not really";
+        out.write(header, 80);
+        const unsigned nFaces = 2;
+        out.write((const char*)&nFaces, sizeof(nFaces));
+        const float tris[2][12] = {{0,0,1, 0,0,0, 1,0,0, 1,1,0},
+                                   {0,0,1, 0,0,0, 1,1,0, 0,1,0}};
+        const unsigned short attribute = 0;
+        for (int i=0; i < 2; ++i) {
+            out.write((const char*)tris[i], sizeof(tris[i]));
+            out.write((const char*)&attribute, sizeof(attribute));
+        }
+    }
+    PolygonalMesh binary;
+    binary.loadFile(binaryName);
+    remove(binaryName.c_str());
+    ASSERT(binary.getNumFaces() == 2);
+    ASSERT(binary.getNumVertices() == 4);
+    ASSERT(binary.getFaceVertex(1, 1) == 2);
+    ASSERT(binary.getVertexPosition(3) == Vec3(0,1,0));
+}
+
+// Vertices far from the origin, or far apart, must still be welded exactly
+// when they match and kept apart when they don't.
+void testWeldHugeCoordinates() {
+    const string fileName = "TestPolygonalMeshHuge.stl";
+    const float far[4] = {0, 1e15f, -1e20f, 3e30f};
+    {   ofstream out(fileName.c_str(), ios_base::binary);
+        char header[80] = "";
+        out.write(header, 80);
+        const unsigned nFaces = 8;
+        out.write((const char*)&nFaces, sizeof(nFaces));
+        const unsigned short attribute = 0;
+        for (int f=0; f < 4; ++f) {
+            const float x = far[f];
+            // Two triangles sharing an edge, forming a unit square at x.
+            const float tris[2][12] = {{0,0,1, x,0,0, x,1,0, x,1,1},
+                                       {0,0,1, x,0,0, x,1,1, x,0,1}};
+            for (int i=0; i < 2; ++i) {
+                out.write((const char*)tris[i], sizeof(tris[i]));
+                out.write((const char*)&attribute, sizeof(attribute));
+            }
+        }
+    }
+    PolygonalMesh mesh;
+    mesh.loadFile(fileName);
+    remove(fileName.c_str());
+    ASSERT(mesh.getNumFaces() == 8);
+    ASSERT(mesh.getNumVertices() == 16);
+    for (int f=0; f < 4; ++f) {
+        ASSERT(mesh.getFaceVertex(2*f+1, 0) == mesh.getFaceVertex(2*f, 0));
+        ASSERT(mesh.getFaceVertex(2*f+1, 1) == mesh.getFaceVertex(2*f, 2));
+    }
+}
+
 int main() {
     try {
         testCreateMesh();
         testLoadObjFile();
+        testLoadVtpFile();
+        testLoadStlFile();
+        testWeldHugeCoordinates();
     } catch(const std::exception& e) {
         cout << "exception: " << e.what() << endl;
         return 1;
@@ -112,6 +112,64 @@ void testCrossProducts() {
     SimTK_TEST_EQ( vx * m33 * vx, v % m33 % v );
 }
 
+// The double precision Mat33 products in SmallMatrixSIMD.h must agree with
+// the generic row-times-column calculation. They accumulate in the same
+// order so should match to the last bit, except that the compiler may fuse
+// multiplies and adds in the scalar code.
+template <class MA, class MB>
+static Mat33 scalarProduct(const MA& a, const MB& b) {
+    Mat33 c;
+    for (int i=0; i < 3; ++i)
+        for (int j=0; j < 3; ++j)
+            c(i,j) = a(i,0)*b(0,j) + a(i,1)*b(1,j) + a(i,2)*b(2,j);
+    return c;
+}
+
+void testSIMDKernels() {
+    const Real tol = 4*NTraits<Real>::getEps();
+    for (int trial=0; trial < 100; ++trial) {
+        const Mat33 a = Test::randMat33(), b = Test::randMat33();
+        const Vec3 v = Test::randVec3();
+        SimTK_TEST_EQ_TOL(a*b, scalarProduct(a, b), tol);
+        SimTK_TEST_EQ_TOL(a*~b, scalarProduct(a, ~b), tol);
+        Vec3 av;
+        for (int i=0; i < 3; ++i)
+            av[i] = a(i,0)*v[0] + a(i,1)*v[1] + a(i,2)*v[2];
+        SimTK_TEST_EQ_TOL(a*v, av, tol);
+
+        // Rotation and Transform composition and application.
+        const Rotation R1 = Test::randRotation(), R2 = Test::randRotation();
+        SimTK_TEST_EQ_TOL((R1*R2).asMat33(),
+                          scalarProduct(R1.asMat33(), R2.asMat33()), tol);
+        SimTK_TEST_EQ_TOL((R1*~R2).asMat33(),
+                          scalarProduct(R1.asMat33(), (~R2).asMat33()), tol);
+        SimTK_TEST_EQ_TOL((~R1*R2).asMat33(),
+                          scalarProduct((~R1).asMat33(), R2.asMat33()), tol);
+        SimTK_TEST_EQ_TOL((R1/R2).asMat33(),
+                          scalarProduct(R1.asMat33(), (~R2).asMat33()), tol);
+        const Transform X(R1, v);
+        SimTK_TEST_EQ_TOL(X*v, R1.asMat33()*v + v, tol);
+        SimTK_TEST_EQ_TOL((X*X).R().asMat33(),
+                          scalarProduct(R1.asMat33(), R1.asMat33()), tol);
+
+        // The Mat33 blocks of spatial products.
+        const SpatialMat S(a, b, ~a, ~b);
+        const SpatialVec sv(v, -v);
+        const SpatialVec Ssv = S*sv;
+        SimTK_TEST_EQ_TOL(Ssv[0], a*v - b*v, tol);
+        SimTK_TEST_EQ_TOL(Ssv[1], Mat33(~a)*v - Mat33(~b)*v, tol);
+        const SpatialMat SS = S*S;
+        SimTK_TEST_EQ_TOL(SS(0,1), scalarProduct(a, b) + scalarProduct(b, ~b),
+                          2*tol);
+    }
+
+    // The result may be one of the operands.
+    Mat33 m = Test::randMat33();
+    const Mat33 mm = scalarProduct(m, m);
+    m = m*m;
+    SimTK_TEST_EQ_TOL(m, mm, tol);
+}
+
 // Individually test 2x2, 3x3, and 4x4 because the
 // smaller sizes may have specialized inline operators.
 void testSymMat() {
@@ -498,5 +556,6 @@ int main() {
         SimTK_SUBTEST(testNumericallyEqual);
         SimTK_SUBTEST(testUnitVec);
         SimTK_SUBTEST(testAppendRowCol);
+        SimTK_SUBTEST(testSIMDKernels);
     SimTK_END_TEST();
 }
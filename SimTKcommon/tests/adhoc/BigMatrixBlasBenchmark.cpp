@@ -0,0 +1,93 @@
+/* -------------------------------------------------------------------------- *
+ *                       Simbody(tm): SimTKcommon                             *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Compare element-by-element loops with the BLAS-backed Real matrix and
+vector products, and y = a*x + b*y written with temporaries versus
+scaleAdd(), for a range of sizes. */
+
+#include "SimTKcommon.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+static Matrix randomMatrix(Random& rand, int m, int n) {
+    Matrix a(m, n);
+    for (int j=0; j < n; ++j)
+        for (int i=0; i < m; ++i)
+            a(i,j) = rand.getValue();
+    return a;
+}
+
+static void loopProduct(const Matrix& a, const Matrix& b, Matrix& c) {
+    for (int j=0; j < b.ncol(); ++j)
+        for (int i=0; i < a.nrow(); ++i) {
+            Real sum = 0;
+            for (int k=0; k < a.ncol(); ++k)
+                sum += a(i,k)*b(k,j);
+            c(i,j) = sum;
+        }
+}
+
+static void loopProduct(const Matrix& a, const Vector& x, Vector& y) {
+    for (int i=0; i < a.nrow(); ++i) {
+        Real sum = 0;
+        for (int j=0; j < a.ncol(); ++j)
+            sum += a(i,j)*x[j];
+        y[i] = sum;
+    }
+}
+
+// Run f repeatedly for about a quarter second; return microseconds per call.
+template <class F>
+static double timeIt(F f) {
+    int reps = 0;
+    const double start = realTime();
+    double elapsed;
+    do {f(); ++reps;} while ((elapsed = realTime()-start) < 0.25);
+    return 1e6*elapsed/reps;
+}
+
+int main() {
+    Random::Uniform rand(-1, 1);
+    printf("%6s %12s %12s %12s %12s %12s %12s\n", "n",
+           "loop A*B", "BLAS A*B", "loop A*x", "BLAS A*x",
+           "x*a+y*b", "scaleAdd");
+    const int sizes[] = {4, 8, 16, 32, 64, 128, 256};
+    for (int n : sizes) {
+        const Matrix A = randomMatrix(rand, n, n), B = randomMatrix(rand, n, n);
+        const Vector x = B(0);
+        Matrix C(n, n);
+        Vector y(n, Real(1)), z(n);
+
+        const double loopMM = timeIt([&]{loopProduct(A, B, C);});
+        const double blasMM = timeIt([&]{multiplyAdd(1, A, B, 0, C);});
+        const double loopMV = timeIt([&]{loopProduct(A, x, z);});
+        const double blasMV = timeIt([&]{multiplyAdd(1, A, x, 0, z);});
+        const double tempAxpy = timeIt([&]{y = Real(0.5)*x + Real(0.5)*y;});
+        const double inPlace = timeIt([&]{scaleAdd(0.5, x, 0.5, y);});
+        printf("%6d %10.3fus %10.3fus %10.3fus %10.3fus %10.3fus %10.3fus\n",
+               n, loopMM, blasMM, loopMV, blasMV, tempAxpy, inPlace);
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+/* -------------------------------------------------------------------------- *
+ *                       Simbody(tm): SimTKcommon                             *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Time the per-step update of the buffer used by Measure::Delay at 10 kHz for
+several delay lengths. The buffer shares its entries with the one it was
+updated from, so the cost per step shouldn't depend on the delay. */
+
+#include "SimTKcommon.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+static const Real Dt = 1e-4;
+static const int  NumSteps = 200000;
+
+static void timeSteps(Real delay) {
+    Measure_Delay_Buffer<Vec3> var, upd;
+    Real t = 0;
+    var.append(t-delay, t, Vec3(0));
+    const double start = realTime();
+    for (int i=0; i < NumSteps; ++i) {
+        t += Dt;
+        upd.copyInAndUpdate(var, t-delay, t, Vec3(std::sin(t)));
+        var = upd;
+    }
+    const double perStep = 1e9*(realTime()-start)/NumSteps;
+    Vec3 delayed;
+    var.calcValueAtTimeLinearOnly(t-delay, delayed);
+    printf("delay %6.3f s (%5d entries) %8.1f ns/step  (ignore: %g)\n",
+           delay, var.size(), perStep, delayed[0]);
+}
+
+int main() {
+    timeSteps(0.005);
+    timeSteps(0.05);
+    timeSteps(0.5);
+    return 0;
+}
@@ -0,0 +1,131 @@
+/* -------------------------------------------------------------------------- *
+ *                       Simbody(tm): SimTKcommon                             *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Report how long it takes to load a moderately large mesh in each of the
+supported formats. The binary STL is loaded a second time with the mesh
+scaled up by 1e15, which shouldn't make vertex welding any slower. */
+
+#include "SimTKcommon.h"
+
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace SimTK;
+using namespace std;
+
+// Binary VTK data is preceded by a UInt32 byte count.
+template <class T>
+static string makeBinaryBlock(const Array_<T>& values) {
+    const unsigned nbytes = values.size()*sizeof(T);
+    string block((const char*)&nbytes, sizeof(nbytes));
+    block.append((const char*)values.begin(), nbytes);
+    return block;
+}
+
+static void writeStlFile(const char* fileName, const Array_<float>& points,
+                         const Array_<int>& triangles, float scale) {
+    ofstream out(fileName, ios_base::binary);
+    const char header[80] = "";
+    out.write(header, 80);
+    const unsigned nFaces = triangles.size()/3;
+    out.write((const char*)&nFaces, sizeof(nFaces));
+    const unsigned short attribute = 0;
+    for (unsigned t=0; t < nFaces; ++t) {
+        const float normal[3] = {0,0,1};
+        out.write((const char*)normal, sizeof(normal));
+        for (int k=0; k < 3; ++k) {
+            const float* p = &points[3*triangles[3*t+k]];
+            const float v[3] = {scale*p[0], scale*p[1], scale*p[2]};
+            out.write((const char*)v, sizeof(v));
+        }
+        out.write((const char*)&attribute, sizeof(attribute));
+    }
+}
+
+int main() {
+    const int N = 300; // (N-1)^2 quads, 2 triangles each
+    Array_<float> points;
+    for (int i=0; i < N; ++i)
+        for (int j=0; j < N; ++j) {
+            points.push_back(.01f*i); points.push_back(.01f*j);
+            points.push_back(.001f*((i*j)%7));
+        }
+    Array_<int> triangles;
+    for (int i=0; i < N-1; ++i)
+        for (int j=0; j < N-1; ++j) {
+            const int v = i*N+j;
+            const int t[6] = {v, v+N, v+N+1, v, v+N+1, v+1};
+            triangles.insert(triangles.end(), t, t+6);
+        }
+    const int nTriangles = triangles.size()/3;
+
+    {   ofstream out("benchmark.obj");
+        char buf[100];
+        for (unsigned i=0; i < points.size(); i += 3) {
+            sprintf(buf, "v %.9g %.9g %.9g\n",
+                    points[i], points[i+1], points[i+2]);
+            out << buf;
+        }
+        for (int t=0; t < nTriangles; ++t)
+            out << "f " << triangles[3*t]+1 << " " << triangles[3*t+1]+1
+                << " " << triangles[3*t+2]+1 << "\n";
+    }
+    writeStlFile("benchmark.stl", points, triangles, 1);
+    writeStlFile("benchmark_big.stl", points, triangles, 1e15f);
+    {   Array_<int> offsets;
+        for (int t=1; t <= nTriangles; ++t) offsets.push_back(3*t);
+        const string pts=makeBinaryBlock(points),
+                     conn=makeBinaryBlock(triangles),
+                     offs=makeBinaryBlock(offsets);
+        ofstream out("benchmark.vtp", ios_base::binary);
+        out << "<VTKFile type=\"PolyData\" byte_order=\"LittleEndian\">\n"
+               "<PolyData><Piece NumberOfPoints=\"" << N*N
+            << "\" NumberOfPolys=\"" << nTriangles << "\">\n"
+            << "<Points><DataArray type=\"Float32\" NumberOfComponents=\"3\""
+               " format=\"appended\" offset=\"0\"/></Points>\n"
+            << "<Polys><DataArray type=\"Int32\" Name=\"connectivity\""
+               " format=\"appended\" offset=\"" << pts.size() << "\"/>\n"
+            << "<DataArray type=\"Int32\" Name=\"offsets\""
+               " format=\"appended\" offset=\"" << pts.size()+conn.size()
+            << "\"/></Polys>\n</Piece></PolyData>\n"
+            << "<AppendedData encoding=\"raw\">_" << pts << conn << offs
+            << "</AppendedData>\n</VTKFile>\n";
+    }
+
+    const char* files[] = {"benchmark.obj", "benchmark.stl",
+                           "benchmark_big.stl", "benchmark.vtp"};
+    for (int f=0; f < 4; ++f) {
+        const std::clock_t start = std::clock();
+        PolygonalMesh mesh;
+        mesh.loadFile(files[f]);
+        const double cpu = double(std::clock()-start)/CLOCKS_PER_SEC;
+        cout << files[f] << ": " << mesh.getNumFaces() << " faces, "
+             << mesh.getNumVertices() << " vertices loaded in "
+             << cpu << "s" << endl;
+        remove(files[f]);
+    }
+    return 0;
+}
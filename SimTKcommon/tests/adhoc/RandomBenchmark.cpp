@@ -0,0 +1,59 @@
+/* -------------------------------------------------------------------------- *
+ *                       Simbody(tm): SimTKcommon                             *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Compare the time per value of Random::getValue() with that of the bulk
+Random::fill(), for uniform and Gaussian distributions. */
+
+#include "SimTKcommon.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+static const int N = 10000;     // values per fill
+static const int Reps = 1000;
+
+static void compare(const char* label, Random& rand) {
+    Vector values(N);
+    double start = realTime();
+    for (int rep=0; rep < Reps; ++rep)
+        for (int i=0; i < N; ++i)
+            values[i] = rand.getValue();
+    const double one = 1e9*(realTime()-start)/(double(Reps)*N);
+    const Real sum1 = values.sum();
+
+    start = realTime();
+    for (int rep=0; rep < Reps; ++rep)
+        rand.fill(values);
+    const double bulk = 1e9*(realTime()-start)/(double(Reps)*N);
+    printf("%-10s getValue() %6.2f ns  fill() %6.2f ns  (ignore: %g)\n",
+           label, one, bulk, sum1+values.sum());
+}
+
+int main() {
+    Random::Uniform uniform(-1, 1);
+    compare("uniform", uniform);
+    Random::Gaussian gaussian(0, 1);
+    compare("Gaussian", gaussian);
+    return 0;
+}
@@ -0,0 +1,107 @@
+/* -------------------------------------------------------------------------- *
+ *                       Simbody(tm): SimTKcommon                             *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Time the small matrix operations that have SIMD versions in
+SmallMatrixSIMD.h. Build once normally and once with SimTK_SIMD_DISABLE
+defined (or with a different BUILD_INST_SET) to compare. The SpatialInertia
+and ArticulatedInertia shifts have no SIMD versions; the ABI shift is also
+timed as the equivalent product of full SpatialMats, which does use them. */
+
+#include "SimTKcommon.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace SimTK;
+
+static const int N = 1000;      // operands, cycled through
+static const int Reps = 2000;   // passes over the operands
+
+template <class F>
+static void report(const char* label, F f) {
+    const double start = realTime();
+    for (int rep=0; rep < Reps; ++rep)
+        for (int i=0; i < N; ++i)
+            f(i);
+    const double ns = 1e9*(realTime()-start)/(double(Reps)*N);
+    printf("%-28s %8.2f ns\n", label, ns);
+}
+
+int main() {
+#ifdef SimTK_SIMD_AVX
+    printf("Using AVX\n");
+#elif defined(SimTK_SIMD_SSE2)
+    printf("Using SSE2\n");
+#elif defined(SimTK_SIMD_NEON)
+    printf("Using NEON\n");
+#else
+    printf("Using generic scalar code\n");
+#endif
+
+    std::vector<Rotation> R(N);
+    std::vector<Transform> X(N);
+    std::vector<Vec3> v(N);
+    std::vector<SpatialMat> S(N);
+    std::vector<SpatialVec> sv(N);
+    std::vector<SpatialInertia> SI(N);
+    std::vector<ArticulatedInertia> P(N);
+    for (int i=0; i < N; ++i) {
+        R[i] = Test::randRotation(); X[i] = Test::randTransform();
+        v[i] = Test::randVec3();
+        S[i] = SpatialMat(Test::randMat33(), Test::randMat33(),
+                          Test::randMat33(), Test::randMat33());
+        sv[i] = SpatialVec(Test::randVec3(), Test::randVec3());
+        SI[i] = SpatialInertia(2, Test::randVec3(), UnitInertia(1));
+        P[i] = ArticulatedInertia(Test::randSymMat33(), Test::randMat33(),
+                                  Test::randSymMat33());
+    }
+
+    // Accumulate results so that nothing is optimized away.
+    Mat33 msum(0); Vec3 vsum(0); SpatialVec svsum(Vec3(0), Vec3(0));
+    SpatialMat smsum(Mat33(0));
+    report("Mat33*Mat33",  [&](int i)
+        {msum += R[i].asMat33()*R[(i+1)%N].asMat33();});
+    report("Rotation*Rotation", [&](int i)
+        {msum += (R[i]*R[(i+1)%N]).asMat33();});
+    report("~Rotation*Rotation", [&](int i)
+        {msum += (~R[i]*R[(i+1)%N]).asMat33();});
+    report("Rotation*Vec3", [&](int i) {vsum += R[i]*v[i];});
+    report("Transform*Vec3", [&](int i) {vsum += X[i]*v[i];});
+    report("Transform*Transform", [&](int i)
+        {vsum += (X[i]*X[(i+1)%N]).p();});
+    report("SpatialMat*SpatialVec", [&](int i) {svsum += S[i]*sv[i];});
+    report("SpatialMat*SpatialMat", [&](int i)
+        {smsum += S[i]*S[(i+1)%N];});
+    report("SpatialInertia::shift", [&](int i)
+        {vsum += SI[i].shift(v[i]).getMassCenter();});
+    report("ArticulatedInertia::shift", [&](int i)
+        {msum += P[i].shift(v[i]).getMassMoment();});
+    report("ABI shift as SpatialMats", [&](int i) {
+        const Mat33 sx = crossMat(v[i]);
+        const SpatialMat Phi(Mat33(1), sx, Mat33(0), Mat33(1));
+        smsum += Phi*P[i].toSpatialMat()*~Phi;});
+
+    printf("(ignore: %g %g %g %g)\n", msum(0,0), vsum[0], svsum[0][0],
+           smsum(0,0)(0,0));
+    return 0;
+}
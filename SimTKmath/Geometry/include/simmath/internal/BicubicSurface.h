@@ -303,6 +303,32 @@ public:
     version. **/
     Real calcDerivative(const Array_<int>& derivComponents, 
                         const Vec2& XY) const;
+
+    /** Calculate the value of the surface at each of many XY coordinates in
+    a single call. This is much faster than calling calcValue() for each point
+    when there is no PatchHint available, and is faster than using a hint when
+    many points are evaluated at once, since points are located and evaluated
+    in one tight loop. Nearby points in \a XY should be adjacent for best
+    performance, as is the case for terrain queries and mesh generation.
+    @param[in]      XY
+        The (X,Y) points at which F(X,Y) is to be evaluated. Every point must
+        be on the surface; see isSurfaceDefined().
+    @param[out]     values
+        The interpolated function values, resized to match \a XY. 
+    @see buildPatchTable() to make this even faster. **/
+    void calcValues(const Array_<Vec2>& XY, Array_<Real>& values) const;
+
+    /** Same as calcValues() but also returns the outward unit normal at
+    each point, as would be obtained from calcUnitNormal().
+    @param[in]      XY
+        The (X,Y) points at which the surface is to be evaluated.
+    @param[out]     values
+        The interpolated function values, resized to match \a XY. 
+    @param[out]     normals
+        The outward unit normals, resized to match \a XY. **/
+    void calcValuesAndUnitNormals(const Array_<Vec2>& XY, 
+                                  Array_<Real>&       values,
+                                  Array_<UnitVec3>&   normals) const;
     
     /** The surface interpolation only works within the grid defined by the 
     vectors x and y used in the constructor. This function checks to see if an 
@@ -441,6 +467,29 @@ public:
     grid of individual bicubic patches from which this surface is constructed,
     returning it as a Bezier patch. Cost is roughly 330 flops. **/
     Geo::BicubicBezierPatch calcBezierPatch(int x, int y) const;
+
+    /** (Advanced) Precompute the bicubic coefficients of every patch in this
+    surface and store them in a single contiguous, cache-line aligned table.
+    After this call no patch coefficients need to be computed during surface
+    evaluation, whether or not a PatchHint is used. This costs 16 Reals of
+    memory per patch, so is best used for surfaces that are evaluated heavily,
+    such as terrain used for contact. 
+
+    The table belongs to the underlying surface so it benefits all handles
+    that share it. This is not thread-safe: build the table before sharing the
+    surface among threads. Calling this when there is already a table does
+    nothing. **/
+    void buildPatchTable();
+
+    /** (Advanced) Return \c true if buildPatchTable() has been called for
+    the underlying surface (and clearPatchTable() has not been called since).
+    **/
+    bool hasPatchTable() const;
+
+    /** (Advanced) Release the memory used by the precomputed patch table, if
+    any. Surface evaluation will then compute patch coefficients as needed, 
+    with the same results. This is not thread-safe. **/
+    void clearPatchTable();
     /**@}**/
 
     //--------------------------------------------------------------------------
@@ -64,6 +64,7 @@ class BrokenContactImpl;
 class CircularPointContactImpl;
 class EllipticalPointContactImpl;
 class BrickHalfSpaceContactImpl;
+class ConvexHullContactImpl;
 class TriangleMeshContactImpl;
 
 class PointContactImpl; // deprecated
@@ -469,6 +470,95 @@ private:
 
 
 
+//==============================================================================
+//                            CONVEX HULL CONTACT
+//==============================================================================
+/** This subclass of Contact is used when one ContactGeometry object is a
+ConvexHull and the other is a HalfSpace or another ConvexHull. It describes 
+the overlap by a single contact normal and a set of contact points (a contact 
+"manifold"), each with its own penetration depth along that normal, so that 
+resting face-to-face contact is supported at several points.
+
+The contact points are the points of surface 2 that are inside surface 1,
+moved along the normal as needed to lie on the boundary of the overlap. For 
+each one the penetration depth is the distance along the normal it would 
+have to move to get out of surface 1.
+
+The object also records the state of the search that found it so that the
+next search, a moment later, can start from there. These are the indices of
+the hull vertices that formed the final GJK simplex, in pairs, one from each 
+surface. For contact with a half-space surface 1 has no vertices and there is
+just the index of the deepest vertex of surface 2. **/
+class SimTK_SIMMATH_EXPORT ConvexHullContact : public Contact {
+public:
+    /** Create a ConvexHullContact object.
+    @param surf1        the index of the first surface
+    @param surf2        the index of the second surface, a ConvexHull
+    @param X_S1S2       the transform giving the pose of surface 2 measured 
+                        and expressed in the frame of surface 1
+    @param normal       the contact normal, pointing from surface 1 towards
+                        surface 2 and expressed in the frame of surface 1
+    @param depth        the penetration depth, the distance surface 2 would 
+                        have to move along the normal to just touch surface 1
+    @param points       the contact points, in the frame of surface 1
+    @param pointDepths  the penetration depth at each contact point
+    @param simplex1     for each simplex vertex, the index of the contributing
+                        vertex of surface 1 (empty for a half-space)
+    @param simplex2     for each simplex vertex, the index of the contributing
+                        vertex of surface 2 **/
+    ConvexHullContact(ContactSurfaceIndex     surf1,
+                      ContactSurfaceIndex     surf2,
+                      const Transform&        X_S1S2,
+                      const UnitVec3&         normal,
+                      Real                    depth,
+                      const Array_<Vec3>&     points,
+                      const Array_<Real>&     pointDepths,
+                      const Array_<int>&      simplex1,
+                      const Array_<int>&      simplex2);
+
+    /** Get the contact normal, pointing from surface 1 towards surface 2 and
+    expressed in the frame of surface 1. **/
+    const UnitVec3& getNormal() const;
+    /** Get the penetration depth. **/
+    Real getDepth() const;
+    /** Get the number of contact points. **/
+    int getNumPoints() const;
+    /** Get a contact point, in the frame of surface 1. **/
+    const Vec3& getPoint(int i) const;
+    /** Get the penetration depth at a contact point. **/
+    Real getPointDepth(int i) const;
+    /** Get the surface 1 vertex indices of the final search simplex. **/
+    const Array_<int>& getSimplexVertices1() const;
+    /** Get the surface 2 vertex indices of the final search simplex. **/
+    const Array_<int>& getSimplexVertices2() const;
+
+    /** Determine whether a Contact object is a ConvexHullContact. **/
+    static bool isInstance(const Contact& contact);
+    
+    /** Recast a Contact object to a const reference to a concrete 
+    ConvexHullContact object. **/
+    static const ConvexHullContact& getAs(const Contact& contact)
+    {   assert(isInstance(contact)); 
+        return static_cast<const ConvexHullContact&>(contact); }
+        
+    /** Recast a Contact object to a writable reference to a concrete 
+    ConvexHullContact object. **/
+    static ConvexHullContact& updAs(Contact& contact)
+    {   assert(isInstance(contact)); 
+        return static_cast<ConvexHullContact&>(contact); }
+
+    /** Obtain the unique small-integer id for the ConvexHullContact class. **/
+    static ContactTypeId classTypeId();
+
+private:
+    const ConvexHullContactImpl& getImpl() const 
+    {   assert(isInstance(*this)); 
+        return reinterpret_cast<const ConvexHullContactImpl&>
+                    (Contact::getImpl()); }
+};
+
+
+
 //==============================================================================
 //                           TRIANGLE MESH CONTACT
 //==============================================================================
@@ -493,15 +583,43 @@ public:
                         const Transform&        X_S1S2,
                         const std::set<int>&    faces1, 
                         const std::set<int>&    faces2);
-
-    /** Get the indices of all faces of surface1 that are partly or completely 
-    inside surface2. If surface1 is not a TriangleMesh, this will return an 
-    empty set. **/
-    const std::set<int>& getSurface1Faces() const;
-    /** Get the indices of all faces of surface2 that are partly or completely
-    inside surface1. If surface2 is not a TriangleMesh, this will return an 
-    empty set. **/
-    const std::set<int>& getSurface2Faces() const;
+    /** Create a TriangleMeshContact object that also records where the 
+    contact tracker's search of the meshes' OBB trees stopped; see
+    getSearchFront1(). The two fronts must be the same length if both meshes
+    were searched together; otherwise the one for a surface that isn't a
+    TriangleMesh is empty. **/
+    TriangleMeshContact(ContactSurfaceIndex     surf1, 
+                        ContactSurfaceIndex     surf2,
+                        const Transform&        X_S1S2,
+                        const std::set<int>&    faces1, 
+                        const std::set<int>&    faces2,
+                        const Array_<int>&      searchFront1,
+                        const Array_<int>&      searchFront2);
+
+    /** Get the indices, in increasing order, of all faces of surface1 that 
+    are partly or completely inside surface2. If surface1 is not a 
+    TriangleMesh, this will return an empty array. **/
+    const Array_<int>& getSurface1Faces() const;
+    /** Get the indices, in increasing order, of all faces of surface2 that 
+    are partly or completely inside surface1. If surface2 is not a 
+    TriangleMesh, this will return an empty array. **/
+    const Array_<int>& getSurface2Faces() const;
+
+    /** Get the indices (see ContactGeometry::TriangleMesh::OBBTreeNode::
+    getIndex()) of the OBB tree nodes of surface1 at which the contact tracker
+    stopped descending when it created this Contact, either because a node
+    was clear of the other surface or because it was a leaf. These nodes 
+    cover every face of the mesh exactly once, so a tracker given this 
+    Contact as the prior status can resume its search from them rather than
+    from the root, and the work for a slowly sliding contact then depends on
+    the size of the contact region rather than of the mesh. If both surfaces
+    are meshes the i'th entries of the two fronts form a pair of nodes that
+    were compared with each other. This is empty if surface1 is not a 
+    TriangleMesh or the tracker didn't record its search. **/
+    const Array_<int>& getSearchFront1() const;
+    /** Get the OBB tree nodes of surface2 at which the contact tracker 
+    stopped; see getSearchFront1(). **/
+    const Array_<int>& getSearchFront2() const;
 
     /** Determine whether a Contact object is a TriangleMeshContact. **/
     static bool isInstance(const Contact& contact);
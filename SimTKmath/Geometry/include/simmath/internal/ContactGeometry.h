@@ -116,6 +116,7 @@ class Torus;
 class SmoothHeightMap;
 class Cylinder;
 class Brick;
+class ConvexHull;
 class TriangleMesh;
 
 // TODO
@@ -1137,6 +1138,90 @@ Impl& updImpl(); /**< Internal use only. **/
 };
 
 
+//==============================================================================
+//                               CONVEX HULL
+//==============================================================================
+/** This ContactGeometry subclass represents the convex hull of a set of points,
+typically the vertices of a PolygonalMesh approximating some convex part. The
+hull is computed once when the object is constructed; the faces of the
+original mesh are ignored and any of its vertices that lie inside the hull are
+discarded. The result is stored as a closed mesh of triangular faces, each
+with an outward normal, together with the edge connectivity of its vertices.
+
+The connectivity is used to find support points (the vertex furthest in a
+given direction) by walking from vertex to vertex uphill. Because the hull is
+convex, that walk always ends at the true support vertex. Started from the
+support vertex found for a nearby direction, as happens from one time step to
+the next, it typically takes only a step or two, making this shape suitable
+for the GJK and EPA algorithms used by ContactTracker::ConvexHullPair.
+
+Coplanar faces in the mesh are split into several triangles, and points that
+are within a small tolerance of the hull are considered to be on it. It is an
+error to construct a %ConvexHull from fewer than four points or from points
+that all lie in a plane. **/
+class SimTK_SIMMATH_EXPORT ContactGeometry::ConvexHull 
+:   public ContactGeometry {
+public:
+/** Create the convex hull of the vertices of the given PolygonalMesh, in the
+mesh's frame. **/
+explicit ConvexHull(const PolygonalMesh& mesh);
+
+/** Get the number of vertices of the hull. **/
+int getNumVertices() const;
+/** Get the position of a hull vertex, in the hull's frame. **/
+const Vec3& getVertexPosition(int vertex) const;
+/** Get the number of triangular faces of the hull. **/
+int getNumFaces() const;
+/** Get the index of one of the three vertices of a face, ordered
+counterclockwise when viewed from outside.
+@param face    the index of the face, 0 <= face < getNumFaces()
+@param which   which vertex of the face, 0, 1 or 2 **/
+int getFaceVertex(int face, int which) const;
+/** Get the outward normal of a face, in the hull's frame. **/
+const UnitVec3& getFaceNormal(int face) const;
+/** Get the number of vertices that share an edge with the given one. **/
+int getNumVertexNeighbors(int vertex) const;
+/** Get one of the vertices that share an edge with the given one.
+@param vertex  the index of the vertex
+@param which   0 <= which < getNumVertexNeighbors(vertex) **/
+int getVertexNeighbor(int vertex, int which) const;
+
+/** Find the hull vertex that is furthest in the given direction, by walking
+uphill along the hull edges from \a startVertex. The closer \a startVertex is
+to the answer, the fewer vertices are visited, so pass the result of a
+previous query with a similar direction when you have one.
+@param direction    the search direction, in the hull's frame
+@param startVertex  the vertex at which to start the search
+@return the index of a vertex with the largest projection on \a direction **/
+int findSupportVertex(const UnitVec3& direction, int startVertex=0) const;
+
+/** Return true if the given point, expressed in the hull's frame, is inside
+or on the hull. **/
+bool containsPoint(const Vec3& point) const;
+
+/** Create a PolygonalMesh object representing the hull. **/
+PolygonalMesh createPolygonalMesh() const;
+
+/** Return true if the supplied ContactGeometry object is a convex hull. **/
+static bool isInstance(const ContactGeometry& geo)
+{   return geo.getTypeId()==classTypeId(); }
+/** Cast the supplied ContactGeometry object to a const convex hull. **/
+static const ConvexHull& getAs(const ContactGeometry& geo)
+{   assert(isInstance(geo)); return static_cast<const ConvexHull&>(geo); }
+/** Cast the supplied ContactGeometry object to a writable convex hull. **/
+static ConvexHull& updAs(ContactGeometry& geo)
+{   assert(isInstance(geo)); return static_cast<ConvexHull&>(geo); }
+
+/** Obtain the unique id for ConvexHull contact geometry. **/
+static ContactGeometryTypeId classTypeId();
+
+class Impl; /**< Internal use only. **/
+const Impl& getImpl() const; /**< Internal use only. **/
+Impl& updImpl(); /**< Internal use only. **/
+};
+
+
+
 //==============================================================================
 //                              TRIANGLE MESH
 //==============================================================================
@@ -1308,6 +1393,12 @@ bool intersectsRay(const Vec3& origin, const UnitVec3& direction, Real& distance
 /** Get the OBBTreeNode which forms the root of this mesh's Oriented Bounding 
 Box Tree. **/
 OBBTreeNode getOBBTreeNode() const;
+/** Get the number of nodes in this mesh's Oriented Bounding Box Tree. **/
+int getNumOBBTreeNodes() const;
+/** Get an OBBTreeNode from its index (see OBBTreeNode::getIndex()). Node 0 is
+the root. Indices are the same in every copy of this mesh, so they can be
+saved (in a Contact, say) and used later to resume a search of the tree. **/
+OBBTreeNode getOBBTreeNode(int nodeIndex) const;
 
 /** Generate a PolygonalMesh from this TriangleMesh; useful mostly for debugging
 because you can create a DecorativeMesh from this and then look at it. **/
@@ -1361,6 +1452,9 @@ const Array_<int>& getTriangles() const;
 this is the total number of triangles contained by all children of this
 node. **/
 int getNumTriangles() const;
+/** Get the index of this node within its tree, in the range 0 to
+TriangleMesh::getNumOBBTreeNodes()-1. The root node has index 0. **/
+int getIndex() const;
 
 private:
 const OBBTreeNodeImpl* impl;
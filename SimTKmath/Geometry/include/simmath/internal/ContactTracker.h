@@ -64,12 +64,14 @@ public:
 class HalfSpaceSphere;
 class HalfSpaceEllipsoid;
 class HalfSpaceBrick;
+class HalfSpaceConvexHull;
 class HalfSpaceTriangleMesh;
 class HalfSpaceConvexImplicit;
 class SphereSphere;
 class SphereTriangleMesh;
 class TriangleMeshTriangleMesh;
 class ConvexImplicitPair;
+class ConvexHullPair;
 class GeneralImplicitPair;
 
 /** Base class constructor for use by the concrete classes. **/
@@ -245,6 +247,34 @@ bool trackContact
 
 
 
+//==============================================================================
+//                   HALFSPACE-CONVEX HULL CONTACT TRACKER
+//==============================================================================
+/** This ContactTracker handles contacts between a ContactGeometry::HalfSpace
+and a ContactGeometry::ConvexHull, in that order. Every hull vertex that is 
+below the half-space surface becomes a point of the resulting 
+ConvexHullContact. The search for the lowest vertex starts from the one found
+the previous time, and the others are found by flooding outwards from it 
+along the hull edges, so the cost doesn't depend on the size of the hull. **/
+class SimTK_SIMMATH_EXPORT ContactTracker::HalfSpaceConvexHull 
+:   public ContactTracker {
+public:
+HalfSpaceConvexHull() 
+:   ContactTracker(ContactGeometry::HalfSpace::classTypeId(),
+                   ContactGeometry::ConvexHull::classTypeId()) {}
+
+bool trackContact
+   (const Contact&         priorStatus,
+    const Transform& X_GS1, 
+    const ContactGeometry& surface1,
+    const Transform& X_GS2, 
+    const ContactGeometry& surface2,
+    Real                   cutoff,
+    Contact&               currentStatus) const override;
+};
+
+
+
 //==============================================================================
 //                       SPHERE-SPHERE CONTACT TRACKER
 //==============================================================================
@@ -273,7 +303,9 @@ bool trackContact
 //                 HALFSPACE-TRIANGLE MESH CONTACT TRACKER
 //==============================================================================
 /** This ContactTracker handles contacts between a ContactGeometry::HalfSpace
-and a ContactGeometry::TriangleMesh, in that order. **/
+and a ContactGeometry::TriangleMesh, in that order. The search of the mesh's
+OBB tree resumes from where the prior contact's search stopped (see
+TriangleMeshContact::getSearchFront2()). **/
 class SimTK_SIMMATH_EXPORT ContactTracker::HalfSpaceTriangleMesh
 :   public ContactTracker {
 public:
@@ -294,7 +326,8 @@ private:
 void processBox(const ContactGeometry::TriangleMesh&              mesh, 
                 const ContactGeometry::TriangleMesh::OBBTreeNode& node, 
                 const Transform& X_HM, const UnitVec3& hsNormal_M, 
-                Real hsFaceHeight_M, std::set<int>& insideFaces) const;
+                Real hsFaceHeight_M, std::set<int>& insideFaces,
+                Array_<int>& searchFront, int& numClear) const;
 void addAllTriangles(const ContactGeometry::TriangleMesh::OBBTreeNode& node, 
                      std::set<int>& insideFaces) const; 
 };
@@ -305,7 +338,9 @@ void addAllTriangles(const ContactGeometry::TriangleMesh::OBBTreeNode& node,
 //                 SPHERE - TRIANGLE MESH CONTACT TRACKER
 //==============================================================================
 /** This ContactTracker handles contacts between a ContactGeometry::Sphere
-and a ContactGeometry::TriangleMesh, in that order. **/
+and a ContactGeometry::TriangleMesh, in that order. Like HalfSpaceTriangleMesh,
+it resumes its search of the mesh's OBB tree from where the prior one 
+stopped. **/
 class SimTK_SIMMATH_EXPORT ContactTracker::SphereTriangleMesh
 :   public ContactTracker {
 public:
@@ -327,7 +362,8 @@ void processBox
    (const ContactGeometry::TriangleMesh&              mesh, 
     const ContactGeometry::TriangleMesh::OBBTreeNode& node, 
     const Vec3& center_M, Real radius2,   
-    std::set<int>& insideFaces) const ;
+    std::set<int>& insideFaces,
+    Array_<int>& searchFront, int& numClear) const;
 };
 
 
@@ -336,7 +372,11 @@ void processBox
 //             TRIANGLE MESH - TRIANGLE MESH CONTACT TRACKER
 //==============================================================================
 /** This ContactTracker handles contacts between two 
-ContactGeometry::TriangleMesh surfaces. **/
+ContactGeometry::TriangleMesh surfaces. The search for intersecting faces
+resumes from the pairs of OBB tree nodes at which the prior contact's search
+stopped, and faces buried in the other mesh are found by working inward from
+the intersecting ones, so the cost of a persistent contact depends on the
+size of the contact region rather than on the size of the meshes. **/
 class SimTK_SIMMATH_EXPORT ContactTracker::TriangleMeshTriangleMesh
 :   public ContactTracker {
 public:
@@ -362,19 +402,16 @@ void findIntersectingFaces
     const OrientedBoundingBox&                          node2Bounds_M1,
     const Transform&                                    X_M1M2, 
     std::set<int>&                                      insideFaces1, 
-    std::set<int>&                                      insideFaces2) const; 
+    std::set<int>&                                      insideFaces2,
+    Array_<int>&                                        searchFront1,
+    Array_<int>&                                        searchFront2,
+    int&                                                numClear) const; 
 
 void findBuriedFaces
    (const ContactGeometry::TriangleMesh&    mesh,
     const ContactGeometry::TriangleMesh&    otherMesh,
     const Transform&                        X_OM, 
     std::set<int>&                          insideFaces) const;
-
-void tagFaces(const ContactGeometry::TriangleMesh&   mesh, 
-              Array_<int>&                           faceType,
-              std::set<int>&                         triangles, 
-              int                                    index,
-              int                                    depth) const;
 };
 
 
@@ -429,6 +466,41 @@ bool trackContact
 };
 
 
+//==============================================================================
+//                     CONVEX HULL PAIR CONTACT TRACKER
+//==============================================================================
+/** This ContactTracker handles contacts between two ContactGeometry::ConvexHull
+objects. The GJK algorithm decides whether the hulls overlap and, if they do, 
+the EPA algorithm finds the penetration depth and the contact normal. The 
+hull vertices that are inside the other hull then become the points of the 
+resulting ConvexHullContact. If there are none, as when two edges cross, the 
+single deepest point found by EPA is used instead.
+
+When the prior status is a ConvexHullContact, GJK starts from the simplex it 
+ended with the last time. While the hulls stay in contact that simplex 
+usually still encloses the origin, in which case the overlap is confirmed 
+without any new support point searches, and every support search starts from
+the vertex that answered it the last time. If the hulls are separated by
+less than the \a cutoff distance, a single-point contact with negative depth 
+is reported. **/
+class SimTK_SIMMATH_EXPORT ContactTracker::ConvexHullPair 
+:   public ContactTracker {
+public:
+ConvexHullPair() 
+:   ContactTracker(ContactGeometry::ConvexHull::classTypeId(),
+                   ContactGeometry::ConvexHull::classTypeId()) {}
+
+bool trackContact
+   (const Contact&         priorStatus,
+    const Transform& X_GS1, 
+    const ContactGeometry& surface1,
+    const Transform& X_GS2, 
+    const ContactGeometry& surface2,
+    Real                   cutoff,
+    Contact&               currentStatus) const override;
+};
+
+
 //==============================================================================
 //                GENERAL IMPLICIT SURFACE PAIR CONTACT TRACKER
 //==============================================================================
@@ -163,6 +163,24 @@ public:
     {   assert(x.size() == 1);
         return calcDerivative((int)derivComponents.size(), x[0]); }
 
+    /** Allocation-free form of the generic Function_ interface; \a x must
+    point to the single independent variable. **/
+    T calcValueAt(int n, const Real* x) const override
+    {   assert(n == 1);
+        return calcValue(x[0]); }
+    /** Allocation-free form of the generic Function_ interface; only
+    \a order matters since all the \a derivComponents must be 0. **/
+    T calcDerivativeAt(int order, const int* derivComponents,
+                       int n, const Real* x) const override
+    {   assert(n == 1);
+        return calcDerivative(order, x[0]); }
+    /** Calculate the value and first derivative of the spline at \a x[0],
+    returning the value and writing the derivative to \a gradient[0]. **/
+    T calcValueAndGradientAt(int n, const Real* x, T* gradient) const override
+    {   assert(n == 1);
+        gradient[0] = calcDerivative(1, x[0]);
+        return calcValue(x[0]); }
+
     /** Required by the Function_ interface. **/
     int getArgumentSize() const override {return 1;}
     /** Required by the Function_ interface. **/
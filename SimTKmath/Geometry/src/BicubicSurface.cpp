@@ -34,6 +34,7 @@ BicubicSurface, BicubicSurface::Guts, and BicubicSurface::PatchHint. **/
 #include "BicubicSurface_Guts.h"
 
 #include <algorithm>
+#include <cstdint>
 
 using namespace SimTK;
 using namespace std;
@@ -174,6 +175,34 @@ Geo::BicubicBezierPatch BicubicSurface::
 calcBezierPatch(int x, int y) const
 {   PatchHint hint; return guts->calcBezierPatch(x,y, hint); }
 
+void BicubicSurface::calcValues
+   (const Array_<Vec2>& XY, Array_<Real>& values) const {
+    SimTK_ERRCHK_ALWAYS(!isEmpty(), "BicubicSurface::calcValues()",
+        "This method can't be called on an empty handle.");
+    guts->calcValues(XY, values, 0);
+}
+
+void BicubicSurface::calcValuesAndUnitNormals
+   (const Array_<Vec2>& XY, Array_<Real>& values, 
+    Array_<UnitVec3>& normals) const {
+    SimTK_ERRCHK_ALWAYS(!isEmpty(), 
+        "BicubicSurface::calcValuesAndUnitNormals()",
+        "This method can't be called on an empty handle.");
+    guts->calcValues(XY, values, &normals);
+}
+
+void BicubicSurface::buildPatchTable() {
+    SimTK_ERRCHK_ALWAYS(!isEmpty(), "BicubicSurface::buildPatchTable()",
+        "This method can't be called on an empty handle.");
+    guts->buildPatchTable();
+}
+
+bool BicubicSurface::hasPatchTable() const 
+{   return getGuts().hasPatchTable(); }
+
+void BicubicSurface::clearPatchTable() 
+{   if (guts) guts->clearPatchTable(); }
+
 bool BicubicSurface::isSurfaceDefined(const Vec2& XY) const 
 {   return getGuts().isSurfaceDefined(XY); }
 
@@ -370,6 +399,8 @@ constructFromSplines(const Matrix& af, Real smoothness)
             fij[Fxy] = ydxspline.calcDerivative(deriv1,coord);
         }
     }
+
+    setUpPatchLookup();
 }
 
 // This is the advanced constructor where everything is known already.
@@ -459,6 +490,37 @@ constructFromKnownFunction
             fij[Fxy]  = afxy(i,j);
         }
     }
+
+    setUpPatchLookup();
+}
+
+// Return true if the n>=2 entries in v are evenly spaced by h to within
+// roundoff.
+static bool isEvenlySpaced(const Vector& v, Real h) {
+    const Real tol = SqrtEps*h;
+    for (int i=1; i < v.size(); ++i)
+        if (std::abs(v[i] - (v[0] + i*h)) > tol)
+            return false;
+    return true;
+}
+
+// Called at the end of construction once _x and _y are known to be good.
+// Sample locations given explicitly are often evenly spaced anyway (terrain
+// data usually is); in that case we treat the grid as regularly spaced so
+// that patches can be found without searching. The computed patch index is
+// only a starting guess that is checked against _x and _y, so roundoff in
+// the spacing can't produce wrong answers.
+void BicubicSurface::Guts::setUpPatchLookup() {
+    if (!_hasRegularSpacing) {
+        const int nx = _x.size(), ny = _y.size();
+        const Vec2 spacing((_x[nx-1]-_x[0])/(nx-1), (_y[ny-1]-_y[0])/(ny-1));
+        if (isEvenlySpaced(_x, spacing[0]) && isEvenlySpaced(_y, spacing[1])) {
+            _hasRegularSpacing = true;
+            _spacing = spacing;
+        }
+    }
+    if (_hasRegularSpacing)
+        _ooSpacing = Vec2(1/_spacing[0], 1/_spacing[1]);
 }
 
 //_____________________________________________________________________________
@@ -566,39 +628,181 @@ getPatchInfoIfNeeded(int x0, int y0, BicubicSurface::PatchHint::Guts& h) const {
         // dimension can be zero since we don't allow duplicates in x or y.
         h.xS = _x(x1)-_x(x0);
         h.yS = _y(y1)-_y(y0);
-        h.ooxS = 1/h.xS; h.ooxS2 = h.ooxS*h.ooxS; h.ooxS3=h.ooxS*h.ooxS2;
-        h.ooyS = 1/h.yS; h.ooyS2 = h.ooyS*h.ooyS; h.ooyS3=h.ooyS*h.ooyS2;
-
-        // Form the vector f and multiply Ainv*f to form coefficient vector a.
-
-        const Vec4& f00 = _ff(x0,y0);
-        const Vec4& f01 = _ff(x0,y1);
-        const Vec4& f10 = _ff(x1,y0);
-        const Vec4& f11 = _ff(x1,y1);
-
-        h.fV[0] = f00[F];
-        h.fV[1] = f10[F];
-        h.fV[2] = f01[F];
-        h.fV[3] = f11[F];
-
-        // Can't precalculate these scaled values because the same grid point
-        // is used for up to four different patches, each scaled differently.
-        h.fV[4] = f00[Fx]*h.xS;
-        h.fV[5] = f10[Fx]*h.xS;
-        h.fV[6] = f01[Fx]*h.xS;
-        h.fV[7] = f11[Fx]*h.xS;
-    
-        h.fV[8]  = f00[Fy]*h.yS;
-        h.fV[9]  = f10[Fy]*h.yS;
-        h.fV[10] = f01[Fy]*h.yS;
-        h.fV[11] = f11[Fy]*h.yS;
 
-        h.fV[12]  = f00[Fxy]*h.xS*h.yS;
-        h.fV[13]  = f10[Fxy]*h.xS*h.yS;
-        h.fV[14]  = f01[Fxy]*h.xS*h.yS;
-        h.fV[15]  = f11[Fxy]*h.xS*h.yS;
+        // Form the vector f and multiply Ainv*f to form coefficient vector a,
+        // unless that has already been done for every patch.
+        calcPatchFunctionVector(x0,y0,h.xS,h.yS,h.fV);
+        if (hasPatchTable()) {
+            h.a = Vec<16>::getAs(getPatchTableEntry(x0,y0));
+            h.ooxS = _ooxS[x0]; h.ooyS = _ooyS[y0];
+        } else {
+            getCoefficients(h.fV,h.a);
+            h.ooxS = 1/h.xS; h.ooyS = 1/h.yS;
+        }
+        h.ooxS2 = h.ooxS*h.ooxS; h.ooxS3=h.ooxS*h.ooxS2;
+        h.ooyS2 = h.ooyS*h.ooyS; h.ooyS3=h.ooyS*h.ooyS2;
+    }
+}
+
+/* Fill in the function vector for the patch indexed (x0,y0), with patch
+dimensions xS and yS, in the order given by PatchHint::Guts::fV. */
+void BicubicSurface::Guts::
+calcPatchFunctionVector(int x0, int y0, Real xS, Real yS, Vec<16>& fV) const {
+    const int x1 = x0+1, y1 = y0+1;
 
-        getCoefficients(h.fV,h.a);
+    const Vec4& f00 = _ff(x0,y0);
+    const Vec4& f01 = _ff(x0,y1);
+    const Vec4& f10 = _ff(x1,y0);
+    const Vec4& f11 = _ff(x1,y1);
+
+    fV[0] = f00[F];
+    fV[1] = f10[F];
+    fV[2] = f01[F];
+    fV[3] = f11[F];
+
+    // Can't precalculate these scaled values because the same grid point
+    // is used for up to four different patches, each scaled differently.
+    fV[4] = f00[Fx]*xS;
+    fV[5] = f10[Fx]*xS;
+    fV[6] = f01[Fx]*xS;
+    fV[7] = f11[Fx]*xS;
+
+    fV[8]  = f00[Fy]*yS;
+    fV[9]  = f10[Fy]*yS;
+    fV[10] = f01[Fy]*yS;
+    fV[11] = f11[Fy]*yS;
+
+    fV[12]  = f00[Fxy]*xS*yS;
+    fV[13]  = f10[Fxy]*xS*yS;
+    fV[14]  = f01[Fxy]*xS*yS;
+    fV[15]  = f11[Fxy]*xS*yS;
+}
+
+/* Find the patch containing the point aXY, which must be on the surface. On
+entry (x0,y0) is a guess, which may be (-1,-1) if there is none; on return it
+is the lower-left corner of the patch. Returns 0 if the guess was right, 1 if
+the patch was nearby, and 2 if we had to search. */
+int BicubicSurface::Guts::findPatch(const Vec2& aXY, int& x0, int& y0) const {
+    // We're going to feed calcLowerBoundIndex() our best guess as to the
+    // patch this point is on. For regularly-spaced grid points we can find
+    // it exactly, except for some possible roundoff. Otherwise the best we
+    // can do is supply the given guess.
+    if (_hasRegularSpacing) {
+        x0 = clamp(0, (int)std::floor((aXY[0]-_x[0])*_ooSpacing[0]),
+                   _x.size()-2); // can't be last index
+        y0 = clamp(0, (int)std::floor((aXY[1]-_y[0])*_ooSpacing[1]),
+                   _y.size()-2);
+    }
+
+    int howResolvedX, howResolvedY;
+    x0 = calcLowerBoundIndex(_x,aXY[0],x0,howResolvedX);
+    y0 = calcLowerBoundIndex(_y,aXY[1],y0,howResolvedY);
+    return std::max(howResolvedX, howResolvedY);
+}
+
+/* Compute the coefficients of every patch into a single table so that
+surface evaluation never has to. The table starts on a cache line boundary
+and each patch takes 16 consecutive Reals (two cache lines when Real is
+double). */
+void BicubicSurface::Guts::buildPatchTable() {
+    if (hasPatchTable())
+        return;
+
+    const int nxp = _x.size()-1, nyp = _y.size()-1;
+    const unsigned CacheLineSize = 64;
+    const unsigned Pad = CacheLineSize/sizeof(Real) - 1;
+
+    _patchTable.resize(16*nxp*nyp + Pad);
+    const std::uintptr_t addr = 
+        reinterpret_cast<std::uintptr_t>(_patchTable.cbegin());
+    _patchTableOffset = 
+        unsigned((CacheLineSize - addr % CacheLineSize) % CacheLineSize)
+        / sizeof(Real);
+
+    _ooxS.resize(nxp); _ooyS.resize(nyp);
+    for (int i=0; i < nxp; ++i) _ooxS[i] = 1/(_x[i+1]-_x[i]);
+    for (int j=0; j < nyp; ++j) _ooyS[j] = 1/(_y[j+1]-_y[j]);
+
+    Vec<16> fV;
+    for (int j=0; j < nyp; ++j)
+        for (int i=0; i < nxp; ++i) {
+            calcPatchFunctionVector(i, j, _x[i+1]-_x[i], _y[j+1]-_y[j], fV);
+            Vec<16>& a = Vec<16>::updAs(const_cast<Real*>
+                                        (getPatchTableEntry(i,j)));
+            getCoefficients(fV, a);
+        }
+}
+
+void BicubicSurface::Guts::clearPatchTable() {
+    _patchTable.clear(); _patchTable.shrink_to_fit();
+    _ooxS.clear(); _ooxS.shrink_to_fit();
+    _ooyS.clear(); _ooyS.shrink_to_fit();
+    _patchTableOffset = 0;
+}
+
+/* Evaluate many points in one loop. Points are located starting from the
+previous point's patch, and the coefficients are taken from the patch table if
+there is one or computed only when we move to a new patch. We evaluate just
+the function value and first derivatives, using Horner's rule on the rows of
+coefficients. */
+void BicubicSurface::Guts::
+calcValues(const Array_<Vec2>& aXY, Array_<Real>& values,
+           Array_<UnitVec3>* normals) const {
+    const int n = (int)aXY.size();
+    values.resize(n);
+    if (normals) normals->resize(n);
+
+    const bool useTable = hasPatchTable();
+    Vec<16> aLocal, fV;
+    const Real* a = 0;
+    Real ooxS = NaN, ooyS = NaN;
+    int x0 = -1, y0 = -1;
+
+    for (int k=0; k < n; ++k) {
+        const Vec2& XY = aXY[k];
+        ++numAccesses;
+        SimTK_ERRCHK6_ALWAYS(isSurfaceDefined(XY), 
+            "BicubicSurface::calcValues()", 
+            "BicubicSurface is not defined at requested location (%g,%g)."
+            " The surface is valid from x[%g %g], y[%g %g].", XY[0], XY[1],
+            _x[0], _x[_x.size()-1], _y[0], _y[_y.size()-1]);
+
+        int px = x0, py = y0;
+        const int howResolved = findPatch(XY, px, py);
+        if      (howResolved == 0) ++numAccessesSamePatch;
+        else if (howResolved == 1) ++numAccessesNearbyPatch;
+
+        if (px != x0 || py != y0 || !a) {
+            x0 = px; y0 = py;
+            if (useTable) {
+                a = getPatchTableEntry(x0,y0);
+                ooxS = _ooxS[x0]; ooyS = _ooyS[y0];
+            } else {
+                const Real xS = _x[x0+1]-_x[x0], yS = _y[y0+1]-_y[y0];
+                calcPatchFunctionVector(x0,y0,xS,yS,fV);
+                getCoefficients(fV,aLocal);
+                a = &aLocal[0];
+                ooxS = 1/xS; ooyS = 1/yS;
+            }
+        }
+
+        const Real xpt = (XY[0]-_x[x0])*ooxS, ypt = (XY[1]-_y[y0])*ooyS;
+
+        // c[j] is the x polynomial multiplying ypt^j; d[j] is its derivative
+        // with respect to xpt. The coefficients a[4j+i] multiply xpt^i ypt^j.
+        Real c[4], d[4];
+        for (int j=0; j < 4; ++j) {
+            const Real* aj = a + 4*j;
+            c[j] = ((aj[3]*xpt + aj[2])*xpt + aj[1])*xpt + aj[0];
+            d[j] = (3*aj[3]*xpt + 2*aj[2])*xpt + aj[1];
+        }
+        values[k] = ((c[3]*ypt + c[2])*ypt + c[1])*ypt + c[0];
+
+        if (normals) {
+            const Real fx = (((d[3]*ypt + d[2])*ypt + d[1])*ypt + d[0])*ooxS;
+            const Real fy = ((3*c[3]*ypt + 2*c[2])*ypt + c[1])*ooyS;
+            (*normals)[k] = UnitVec3(-fx, -fy, 1); // (1,0,fx) X (0,1,fy)
+        }
     }
 }
 
@@ -660,27 +864,13 @@ getFdF(const Vec2& aXY, int wantLevel, PatchHint& hint) const {
     h.xy = aXY;
     h.level = -1; // we don't know anything about this point
 
-    // We're going to feed calcLowerBoundIndex() our best guess as to the
-    // patch this point is on. For regularly-spaced grid points we can find
-    // it exactly, except for some possible roundoff. Otherwise the best we
-    // can do is supply the current index from the hint.
-    int pXidx = h.x0, pYidx = h.y0;
-    if (_hasRegularSpacing) {
-        pXidx = clamp(0, (int)std::floor((h.xy[0]-_x[0])/_spacing[0]),
-                      _x.size()-2); // can't be last index
-        pYidx = clamp(0, (int)std::floor((h.xy[1]-_y[0])/_spacing[1]),
-                      _y.size()-2);
-    }
-
-    // Compute the indices that define the patch containing this value.
-    int howResolvedX, howResolvedY;
-    const int x0 = calcLowerBoundIndex(_x,aXY[0],pXidx,howResolvedX);
-    const int x1 = x0+1;
-    const int y0 = calcLowerBoundIndex(_y,aXY[1],pYidx,howResolvedY);
-    const int y1 = y0+1;
+    // Compute the indices that define the patch containing this value,
+    // starting with the patch in the hint.
+    int x0 = h.x0, y0 = h.y0;
+    const int howResolved = findPatch(aXY, x0, y0);
+    const int x1 = x0+1, y1 = y0+1;
 
     // 0->same patch, 1->nearby patch, 2->had to search
-    const int howResolved = std::max(howResolvedX, howResolvedY);
     if      (howResolved == 0) ++numAccessesSamePatch;
     else if (howResolved == 1) ++numAccessesNearbyPatch;
  
@@ -1019,7 +1209,6 @@ getCoefficients(const Vec<16>& fV, Vec<16>& aV) const {
 // quads where the surface is denser.
 void BicubicSurface::Guts::
 createPolygonalMesh(Real resolution, PolygonalMesh& mesh) const {
-    PatchHint hint;
     // Number of patches in x and y direction.
     const int nxpatch = _x.size()-1;
     const int nypatch = _y.size()-1;
@@ -1056,23 +1245,27 @@ createPolygonalMesh(Real resolution, PolygonalMesh& mesh) const {
     yVals[nxt++] = _y[_y.size()-1];
     assert(nxt == ny);
 
+    // Each row of vertices is evaluated in a single batch.
+    Array_<Vec2> rowXY(ny);
+    Array_<Real> rowZ(ny);
+    for (int j=0; j < ny; ++j)
+        rowXY[j][1] = yVals[j];
+
     // Fill in the zeroth row.
-    Vec2 pt; pt[0] = xVals[0];
-    for (int j=0; j < ny; ++j) {
-        pt[1] = yVals[j];
-        const Real z = calcValue(pt, hint);
-        (*prevRowVerts)[j] = mesh.addVertex(Vec3(pt[0],pt[1],z));
-    }
+    for (int j=0; j < ny; ++j)
+        rowXY[j][0] = xVals[0];
+    calcValues(rowXY, rowZ, 0);
+    for (int j=0; j < ny; ++j)
+        (*prevRowVerts)[j] = mesh.addVertex(rowXY[j].append1(rowZ[j]));
 
     // For each remaining row, generate vertices and then a strip of faces.
     Array_<int> face(4);
     for (int i=1; i < nx; ++i) {
-        Vec2 pt; pt[0] = xVals[i];
-        for (int j=0; j < ny; ++j) {
-            pt[1] = yVals[j];
-            const Real z = calcValue(pt, hint);
-            (*curRowVerts)[j] = mesh.addVertex(Vec3(pt[0],pt[1],z));
-        }
+        for (int j=0; j < ny; ++j)
+            rowXY[j][0] = xVals[i];
+        calcValues(rowXY, rowZ, 0);
+        for (int j=0; j < ny; ++j)
+            (*curRowVerts)[j] = mesh.addVertex(rowXY[j].append1(rowZ[j]));
         for (int j=1; j < ny; ++j) {
             face[0] = (*curRowVerts)[j-1]; // counterclockwise
             face[1] = (*curRowVerts)[j];
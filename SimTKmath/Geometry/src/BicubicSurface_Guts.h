@@ -147,6 +147,16 @@ public:
     // point at XY.
     void calcParaboloid
        (const Vec2& XY, PatchHint& hint, Transform& X_SP, Vec2& k) const;
+
+    // Calculate the value of the surface at many XY coordinates, and 
+    // optionally the unit normals there also (if normals is not null).
+    void calcValues(const Array_<Vec2>& XY, Array_<Real>& values,
+                    Array_<UnitVec3>* normals) const;
+
+    // Precompute the coefficients of every patch, or throw them away.
+    void buildPatchTable();
+    void clearPatchTable();
+    bool hasPatchTable() const {return !_patchTable.empty();}
    
     void getNumPatches(int& nx, int &ny) const {
         nx = _ff.nrow()-1;
@@ -274,6 +284,9 @@ public:
 private:
     int calcLowerBoundIndex(const Vector& vecV, Real value, int pIdx,
                             int& howResolved) const;
+    int findPatch(const Vec2& aXY, int& x0, int& y0) const;
+    void calcPatchFunctionVector(int x0, int y0, Real xS, Real yS,
+                                 Vec<16>& fV) const;
     void getCoefficients(const Vec<16>& f, Vec<16>& aV) const;
     void getFdF(const Vec2& aXY, int wantLevel,
                 BicubicSurface::PatchHint& hint) const;
@@ -285,6 +298,7 @@ private:
         referenceCount = 0;
         resetStatistics();
         _hasRegularSpacing = false;
+        _patchTableOffset = 0;
         _debug = false;
     }
 
@@ -302,6 +316,14 @@ private:
     void constructFromKnownFunction
        (const Matrix& f, const Matrix& fx, const Matrix& fy,
         const Matrix& fxy);
+    void setUpPatchLookup();
+
+    // Return the precomputed coefficients for patch (x0,y0); only valid
+    // if there is a patch table.
+    const Real* getPatchTableEntry(int x0, int y0) const {
+        assert(hasPatchTable());
+        return &_patchTable[_patchTableOffset + 16*(y0*(_x.size()-1) + x0)];
+    }
 
 //=============================================================================
 // MEMBER VARIABLES
@@ -333,8 +355,11 @@ private:
     // here and use it instead of searching when we need to move to a new patch.
     // Note that the grid values are _x[0]+i*spacing[0] and _y[0]+j*spacing[1],
     // but you still have to check in _x and _y to avoid roundoff problems.
+    // If the supplied sample locations happen to be evenly spaced we
+    // detect that and treat the grid as though it had been specified with
+    // regular spacing. _ooSpacing holds the reciprocals of the spacing.
     bool _hasRegularSpacing;
-    Vec2 _spacing;
+    Vec2 _spacing, _ooSpacing;
 
     // 2D nx X ny z values that correspond to the values at the grid defined
     // by x and y, and the partial differentials at those grid points. The
@@ -342,6 +367,16 @@ private:
     enum {F=0, Fx=1, Fy=2, Fxy=3}; 
     Matrix_<Vec4> _ff;
 
+    // Optional table of the bicubic coefficients of every patch, in the
+    // same order as PatchHint::Guts::a, with x varying fastest from one patch
+    // to the next. The storage is over-allocated so that the table can begin
+    // at a cache line boundary, _patchTableOffset Reals into the array. The
+    // reciprocal patch dimensions 1/(x[i+1]-x[i]) and 1/(y[j+1]-y[j]) are
+    // kept alongside. These are all empty unless buildPatchTable() is called.
+    Array_<Real> _patchTable;
+    unsigned     _patchTableOffset;
+    Array_<Real> _ooxS, _ooyS;
+
     //A private debugging flag - if set to true, a lot of useful debugging
     //data will be printed tot the screen
     bool _debug;
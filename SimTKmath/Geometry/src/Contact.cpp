@@ -223,6 +223,47 @@ bool BrickHalfSpaceContact::isInstance(const Contact& contact) {
 {   return BrickHalfSpaceContactImpl::classTypeId(); }
 
 
+//==============================================================================
+//                            CONVEX HULL CONTACT
+//==============================================================================
+ConvexHullContact::ConvexHullContact
+   (ContactSurfaceIndex     surf1, 
+    ContactSurfaceIndex     surf2,
+    const Transform&        X_S1S2,
+    const UnitVec3&         normal,
+    Real                    depth,
+    const Array_<Vec3>&     points,
+    const Array_<Real>&     pointDepths,
+    const Array_<int>&      simplex1,
+    const Array_<int>&      simplex2)
+:   Contact(new ConvexHullContactImpl(surf1,surf2,X_S1S2,normal,depth,
+                                      points,pointDepths,simplex1,simplex2)) 
+{   assert(points.size() == pointDepths.size()); }
+
+const UnitVec3& ConvexHullContact::getNormal() const
+{   return getImpl().normal; }
+Real ConvexHullContact::getDepth() const
+{   return getImpl().depth; }
+int ConvexHullContact::getNumPoints() const
+{   return (int)getImpl().points.size(); }
+const Vec3& ConvexHullContact::getPoint(int i) const
+{   return getImpl().points[i]; }
+Real ConvexHullContact::getPointDepth(int i) const
+{   return getImpl().pointDepths[i]; }
+const Array_<int>& ConvexHullContact::getSimplexVertices1() const
+{   return getImpl().simplex1; }
+const Array_<int>& ConvexHullContact::getSimplexVertices2() const
+{   return getImpl().simplex2; }
+
+bool ConvexHullContact::isInstance(const Contact& contact) {
+    return (dynamic_cast<const ConvexHullContactImpl*>
+        (&contact.getImpl()) != 0);
+}
+
+/*static*/ ContactTypeId ConvexHullContact::classTypeId() 
+{   return ConvexHullContactImpl::classTypeId(); }
+
+
 //==============================================================================
 //                      TRIANGLE MESH CONTACT & IMPL
 //==============================================================================
@@ -231,12 +272,26 @@ TriangleMeshContact::TriangleMeshContact
     const Transform& X_S1S2,
     const std::set<int>& faces1, const std::set<int>& faces2) 
 :   Contact(new TriangleMeshContactImpl(surf1, surf2, X_S1S2, 
-                                        faces1, faces2)) {}
+                                        faces1, faces2, 
+                                        Array_<int>(), Array_<int>())) {}
+
+TriangleMeshContact::TriangleMeshContact
+   (ContactSurfaceIndex surf1, ContactSurfaceIndex surf2,
+    const Transform& X_S1S2,
+    const std::set<int>& faces1, const std::set<int>& faces2,
+    const Array_<int>& searchFront1, const Array_<int>& searchFront2) 
+:   Contact(new TriangleMeshContactImpl(surf1, surf2, X_S1S2, 
+                                        faces1, faces2, 
+                                        searchFront1, searchFront2)) {}
 
-const set<int>& TriangleMeshContact::getSurface1Faces() const 
+const Array_<int>& TriangleMeshContact::getSurface1Faces() const 
 {   return getImpl().faces1; }
-const set<int>& TriangleMeshContact::getSurface2Faces() const 
+const Array_<int>& TriangleMeshContact::getSurface2Faces() const 
 {   return getImpl().faces2; }
+const Array_<int>& TriangleMeshContact::getSearchFront1() const 
+{   return getImpl().searchFront1; }
+const Array_<int>& TriangleMeshContact::getSearchFront2() const 
+{   return getImpl().searchFront2; }
 
 /*static*/ bool TriangleMeshContact::isInstance(const Contact& contact) 
 {   return (dynamic_cast<const TriangleMeshContactImpl*>(&contact.getImpl())
@@ -248,8 +303,11 @@ const set<int>& TriangleMeshContact::getSurface2Faces() const
 TriangleMeshContactImpl::TriangleMeshContactImpl
    (ContactSurfaceIndex surf1, ContactSurfaceIndex surf2,
     const Transform& X_S1S2,
-    const set<int>& faces1, const set<int>& faces2) 
-:   ContactImpl(surf1, surf2, X_S1S2), faces1(faces1), faces2(faces2) {}
+    const set<int>& faces1, const set<int>& faces2,
+    const Array_<int>& searchFront1, const Array_<int>& searchFront2) 
+:   ContactImpl(surf1, surf2, X_S1S2), 
+    faces1(faces1.begin(), faces1.end()), faces2(faces2.begin(), faces2.end()),
+    searchFront1(searchFront1), searchFront2(searchFront2) {}
 
 
 
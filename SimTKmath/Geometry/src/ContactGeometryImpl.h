@@ -977,13 +977,79 @@ private:
 
 
 
+//==============================================================================
+//                             CONVEX HULL IMPL
+//==============================================================================
+class ContactGeometry::ConvexHull::Impl : public ContactGeometryImpl {
+public:
+    explicit Impl(const ArrayViewConst_<Vec3>& points);
+
+    ContactGeometryImpl* clone() const override {
+        return new Impl(*this);
+    }
+
+    ContactGeometryTypeId getTypeId() const override {return classTypeId();}
+
+    DecorativeGeometry createDecorativeGeometry() const override;
+    Vec3 findNearestPoint(const Vec3& position, bool& inside, 
+                          UnitVec3& normal) const override;
+    bool intersectsRay(const Vec3& origin, const UnitVec3& direction, 
+                       Real& distance, UnitVec3& normal) const override;
+    void getBoundingSphere(Vec3& center, Real& radius) const override {
+        center = m_center;
+        radius = m_radius;
+    }
+
+    bool isSmooth() const override {return false;}
+    bool isConvex() const override {return true;}
+    bool isFinite() const override {return true;}
+
+    Vec3 calcSupportPoint(const UnitVec3& direction) const override {
+        return m_vertices[findSupportVertex(direction, 0)];
+    }
+
+    int findSupportVertex(const Vec3& direction, int startVertex) const;
+    bool containsPoint(const Vec3& point) const;
+    void createPolygonalMesh(PolygonalMesh& mesh) const;
+
+    int getNumVertices() const {return (int)m_vertices.size();}
+    const Vec3& getVertexPosition(int v) const {return m_vertices[v];}
+    int getNumFaces() const {return (int)m_faceNormals.size();}
+    int getFaceVertex(int f, int which) const {return m_faces[3*f+which];}
+    const UnitVec3& getFaceNormal(int f) const {return m_faceNormals[f];}
+    int getNumVertexNeighbors(int v) const 
+    {   return m_neighborStart[v+1]-m_neighborStart[v]; }
+    int getVertexNeighbor(int v, int which) const 
+    {   return m_neighbors[m_neighborStart[v]+which]; }
+
+    static ContactGeometryTypeId classTypeId() {
+        static const ContactGeometryTypeId id = 
+            createNewContactGeometryTypeId();
+        return id;
+    }
+private:
+    Array_<Vec3>        m_vertices;
+    Array_<int>         m_faces;        // 3 vertices per face, ccw from out
+    Array_<UnitVec3>    m_faceNormals;
+    Array_<Real>        m_faceOffsets;  // dot(normal, any point on face)
+    // Vertex adjacency, stored compactly: the neighbors of vertex v are
+    // m_neighbors[m_neighborStart[v]] up to m_neighbors[m_neighborStart[v+1]].
+    Array_<int>         m_neighborStart;
+    Array_<int>         m_neighbors;
+    Real                m_tolerance;    // points this close are on the hull
+    Vec3                m_center;       // bounding sphere
+    Real                m_radius;
+};
+
+
+
 //==============================================================================
 //                            OBB TREE NODE IMPL
 //==============================================================================
 class OBBTreeNodeImpl {
 public:
-    OBBTreeNodeImpl() : child1(NULL), child2(NULL), numTriangles(0) {
-    }
+    OBBTreeNodeImpl() 
+    :   child1(NULL), child2(NULL), numTriangles(0), index(-1) {}
     OBBTreeNodeImpl(const OBBTreeNodeImpl& copy);
     ~OBBTreeNodeImpl();
     OrientedBoundingBox bounds;
@@ -991,6 +1057,7 @@ public:
     OBBTreeNodeImpl* child2;
     Array_<int> triangles;
     int numTriangles;
+    int index; // position of this node in a preorder walk of the tree
     Vec3 findNearestPoint(const ContactGeometry::TriangleMesh::Impl& mesh, 
                           const Vec3& position, Real cutoff2, Real& distance2, 
                           int& face, Vec2& uv) const;
@@ -1013,6 +1080,7 @@ public:
     Impl(const ArrayViewConst_<Vec3>& vertexPositions, 
          const ArrayViewConst_<int>& faceIndices, bool smooth);
     Impl(const PolygonalMesh& mesh, bool smooth);
+    Impl(const Impl& source);
     ContactGeometryImpl* clone() const override {
         return new Impl(*this);
     }
@@ -1049,6 +1117,7 @@ public:
 private:
     void init(const Array_<Vec3>& vertexPositions, const Array_<int>& faceIndices);
     void createObbTree(OBBTreeNodeImpl& node, const Array_<int>& faceIndices);
+    void indexObbTree(OBBTreeNodeImpl& node);
     void splitObbAxis(const Array_<int>& parentIndices, 
                       Array_<int>& child1Indices, 
                       Array_<int>& child2Indices, int axis);
@@ -1064,6 +1133,8 @@ private:
     Real            boundingSphereRadius;
     OBBTreeNodeImpl obb;
     bool            smooth;
+    // The nodes of the OBB tree, indexed by OBBTreeNodeImpl::index.
+    Array_<const OBBTreeNodeImpl*> obbNodes;
 };
 
 
@@ -0,0 +1,439 @@
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+#include "simmath/internal/common.h"
+#include "simmath/internal/ContactGeometry.h"
+
+#include "ContactGeometryImpl.h"
+
+#include <set>
+#include <utility>
+
+using namespace SimTK;
+using std::pair;
+using std::set;
+
+
+//==============================================================================
+//                     CONTACT GEOMETRY :: CONVEX HULL
+//==============================================================================
+
+static Array_<Vec3> getMeshVertices(const PolygonalMesh& mesh) {
+    Array_<Vec3> points(mesh.getNumVertices());
+    for (int i=0; i < mesh.getNumVertices(); ++i)
+        points[i] = mesh.getVertexPosition(i);
+    return points;
+}
+
+ContactGeometry::ConvexHull::ConvexHull(const PolygonalMesh& mesh)
+:   ContactGeometry(new ConvexHull::Impl(getMeshVertices(mesh))) {}
+
+int ContactGeometry::ConvexHull::getNumVertices() const
+{   return getImpl().getNumVertices(); }
+
+const Vec3& ContactGeometry::ConvexHull::getVertexPosition(int vertex) const {
+    assert(0 <= vertex && vertex < getNumVertices());
+    return getImpl().getVertexPosition(vertex);
+}
+
+int ContactGeometry::ConvexHull::getNumFaces() const
+{   return getImpl().getNumFaces(); }
+
+int ContactGeometry::ConvexHull::getFaceVertex(int face, int which) const {
+    assert(0 <= face && face < getNumFaces() && 0 <= which && which < 3);
+    return getImpl().getFaceVertex(face, which);
+}
+
+const UnitVec3& ContactGeometry::ConvexHull::getFaceNormal(int face) const {
+    assert(0 <= face && face < getNumFaces());
+    return getImpl().getFaceNormal(face);
+}
+
+int ContactGeometry::ConvexHull::getNumVertexNeighbors(int vertex) const {
+    assert(0 <= vertex && vertex < getNumVertices());
+    return getImpl().getNumVertexNeighbors(vertex);
+}
+
+int ContactGeometry::ConvexHull::getVertexNeighbor(int vertex, int which) const
+{   assert(0 <= which && which < getNumVertexNeighbors(vertex));
+    return getImpl().getVertexNeighbor(vertex, which); }
+
+int ContactGeometry::ConvexHull::
+findSupportVertex(const UnitVec3& direction, int startVertex) const {
+    SimTK_INDEXCHECK_ALWAYS(startVertex, getNumVertices(),
+        "ContactGeometry::ConvexHull::findSupportVertex()");
+    return getImpl().findSupportVertex(direction, startVertex);
+}
+
+bool ContactGeometry::ConvexHull::containsPoint(const Vec3& point) const
+{   return getImpl().containsPoint(point); }
+
+PolygonalMesh ContactGeometry::ConvexHull::createPolygonalMesh() const {
+    PolygonalMesh mesh;
+    getImpl().createPolygonalMesh(mesh);
+    return mesh;
+}
+
+/*static*/ ContactGeometryTypeId ContactGeometry::ConvexHull::classTypeId()
+{   return ContactGeometry::ConvexHull::Impl::classTypeId(); }
+
+const ContactGeometry::ConvexHull::Impl& ContactGeometry::ConvexHull::
+getImpl() const {
+    assert(impl);
+    return static_cast<const ConvexHull::Impl&>(*impl);
+}
+
+ContactGeometry::ConvexHull::Impl& ContactGeometry::ConvexHull::
+updImpl() {
+    assert(impl);
+    return static_cast<ConvexHull::Impl&>(*impl);
+}
+
+
+
+//==============================================================================
+//                            CONVEX HULL IMPL
+//==============================================================================
+
+namespace {
+// A face of a hull that is under construction.
+struct HullFace {
+    HullFace(int a, int b, int c, const ArrayViewConst_<Vec3>& points)
+    :   normal((points[b]-points[a]) % (points[c]-points[a])),
+        offset(dot(normal, points[a]))
+    {   v[0]=a; v[1]=b; v[2]=c; }
+
+    Real calcHeight(const Vec3& point) const
+    {   return dot(normal, point) - offset; }
+
+    int         v[3];
+    UnitVec3    normal;
+    Real        offset;
+};
+}
+
+// This is the incremental algorithm: start with a tetrahedron and then, for
+// each point that is outside the current hull, replace the faces that the
+// point can see by a fan of faces connecting the point to the horizon edges.
+// That is quadratic in the worst case but it only happens once. Returns false
+// if the points are all in a plane (within the tolerance).
+static bool findHullFaces(const ArrayViewConst_<Vec3>& points, Real tol,
+                          Array_<HullFace>& faces) {
+    const int n = (int)points.size();
+    faces.clear();
+
+    // Find four points that are far apart: the leftmost one, the one furthest
+    // from it, the one furthest from the line through those, and the one
+    // furthest from the plane through those three.
+    int p[4] = {0, 0, 0, 0};
+    for (int i=1; i < n; ++i)
+        if (points[i][0] < points[p[0]][0]) p[0] = i;
+    Real best = 0;
+    for (int i=0; i < n; ++i) {
+        const Real d = (points[i]-points[p[0]]).norm();
+        if (d > best) best = d, p[1] = i;
+    }
+    if (best <= tol) return false;
+    const UnitVec3 line(points[p[1]]-points[p[0]]);
+    best = 0;
+    for (int i=0; i < n; ++i) {
+        const Real d = ((points[i]-points[p[0]]) % line).norm();
+        if (d > best) best = d, p[2] = i;
+    }
+    if (best <= tol) return false;
+    const UnitVec3 normal(  (points[p[1]]-points[p[0]])
+                          % (points[p[2]]-points[p[0]]));
+    best = 0;
+    for (int i=0; i < n; ++i) {
+        const Real d = std::abs(dot(points[i]-points[p[0]], normal));
+        if (d > best) best = d, p[3] = i;
+    }
+    if (best <= tol) return false;
+
+    const Vec3 inside = (points[p[0]]+points[p[1]]+points[p[2]]+points[p[3]])/4;
+    const int tet[4][3] = {{0,1,2}, {0,1,3}, {0,2,3}, {1,2,3}};
+    for (int f=0; f < 4; ++f) {
+        HullFace face(p[tet[f][0]], p[tet[f][1]], p[tet[f][2]], points);
+        if (face.calcHeight(inside) > 0) // make the normal point out
+            face = HullFace(p[tet[f][0]], p[tet[f][2]], p[tet[f][1]], points);
+        faces.push_back(face);
+    }
+
+    Array_<HullFace> nextFaces;
+    set< pair<int,int> > visibleEdges;
+    for (int i=0; i < n; ++i) {
+        if (i==p[0] || i==p[1] || i==p[2] || i==p[3])
+            continue;
+        nextFaces.clear(); visibleEdges.clear();
+        for (unsigned f=0; f < faces.size(); ++f) {
+            const HullFace& face = faces[f];
+            if (face.calcHeight(points[i]) <= tol) {
+                nextFaces.push_back(face);
+                continue;
+            }
+            for (int k=0; k < 3; ++k)
+                visibleEdges.insert(pair<int,int>(face.v[k], face.v[(k+1)%3]));
+        }
+        if (visibleEdges.empty())
+            continue; // this point is inside or on the hull
+
+        // An edge of a visible face is on the horizon if the face on its other
+        // side (which has the same edge going the other way) isn't visible.
+        set< pair<int,int> >::const_iterator e = visibleEdges.begin();
+        for (; e != visibleEdges.end(); ++e)
+            if (!visibleEdges.count(pair<int,int>(e->second, e->first)))
+                nextFaces.push_back(HullFace(e->first, e->second, i, points));
+        faces.swap(nextFaces);
+    }
+    return true;
+}
+
+// A point that was added to the hull early can end up in the middle of a
+// face or an edge once later points are added. A true corner is one where 
+// the normals of the faces that meet there span all three dimensions.
+static Array_<Vec3> findCorners(const ArrayViewConst_<Vec3>& points,
+                                const Array_<HullFace>& faces) {
+    const Real flat = 100*SqrtEps; // angle, in radians
+    Array_< Array_<int> > vertexFaces(points.size());
+    for (unsigned f=0; f < faces.size(); ++f)
+        for (int k=0; k < 3; ++k)
+            vertexFaces[faces[f].v[k]].push_back(f);
+    Array_<Vec3> corners;
+    for (unsigned v=0; v < points.size(); ++v) {
+        const Array_<int>& vf = vertexFaces[v];
+        if (vf.empty()) continue;
+        const UnitVec3& n1 = faces[vf[0]].normal;
+        int rank = 1; Vec3 n12;
+        for (unsigned i=1; i < vf.size() && rank < 3; ++i) {
+            const UnitVec3& n = faces[vf[i]].normal;
+            if (rank == 1) {
+                n12 = n1 % n;
+                if (n12.norm() > flat) rank = 2;
+            } else if (std::abs(dot(n12, n)) > flat*n12.norm())
+                rank = 3;
+        }
+        if (rank == 3)
+            corners.push_back(points[v]);
+    }
+    return corners;
+}
+
+ContactGeometry::ConvexHull::Impl::Impl(const ArrayViewConst_<Vec3>& points) {
+    const int n = (int)points.size();
+    SimTK_APIARGCHECK1_ALWAYS(n >= 4,
+        "ContactGeometry::ConvexHull::Impl", "ConvexHull::Impl",
+        "A convex hull needs at least 4 points but only %d were given.", n);
+
+    Vec3 lo = points[0], hi = points[0];
+    for (int i=1; i < n; ++i)
+        for (int k=0; k < 3; ++k) {
+            lo[k] = std::min(lo[k], points[i][k]);
+            hi[k] = std::max(hi[k], points[i][k]);
+        }
+    m_tolerance = SqrtEps*(hi-lo).norm();
+
+    Array_<HullFace> faces;
+    SimTK_APIARGCHECK_ALWAYS(findHullFaces(points, m_tolerance, faces),
+        "ContactGeometry::ConvexHull::Impl", "ConvexHull::Impl",
+        "The points all lie in a plane so their convex hull has no volume.");
+
+    // Build it again from just the corners.
+    const Array_<Vec3> corners = findCorners(points, faces);
+    const bool found = findHullFaces(corners, m_tolerance, faces);
+    SimTK_ASSERT_ALWAYS(found, "ContactGeometry::ConvexHull::Impl(): "
+        "the corners of a hull should have had a hull of their own.");
+
+    // Keep only the points that ended up as hull vertices.
+    Array_<int> vertexIndex(corners.size(), -1);
+    for (unsigned f=0; f < faces.size(); ++f) {
+        for (int k=0; k < 3; ++k) {
+            int& vx = vertexIndex[faces[f].v[k]];
+            if (vx < 0) {
+                vx = (int)m_vertices.size();
+                m_vertices.push_back(corners[faces[f].v[k]]);
+            }
+            m_faces.push_back(vx);
+        }
+        m_faceNormals.push_back(faces[f].normal);
+        m_faceOffsets.push_back(faces[f].offset);
+    }
+
+    // Each edge a-b appears as a->b in one face and b->a in the other, so
+    // counting the outgoing edges of each face gives each neighbor once.
+    const int nv = (int)m_vertices.size();
+    m_neighborStart.assign(nv+1, 0);
+    for (unsigned i=0; i < m_faces.size(); ++i)
+        ++m_neighborStart[m_faces[i]+1];
+    for (int v=0; v < nv; ++v)
+        m_neighborStart[v+1] += m_neighborStart[v];
+    m_neighbors.resize(m_faces.size());
+    Array_<int> next(m_neighborStart.begin(), m_neighborStart.end()-1);
+    for (int f=0; f < getNumFaces(); ++f)
+        for (int k=0; k < 3; ++k)
+            m_neighbors[next[m_faces[3*f+k]]++] = m_faces[3*f+(k+1)%3];
+
+    m_center = Vec3(0);
+    for (int v=0; v < nv; ++v)
+        m_center += m_vertices[v];
+    m_center /= nv;
+    m_radius = 0;
+    for (int v=0; v < nv; ++v)
+        m_radius = std::max(m_radius, (m_vertices[v]-m_center).norm());
+}
+
+// On a convex polyhedron any vertex that is at least as far in the given
+// direction as all its neighbors is a support vertex, so we can just walk
+// uphill. Ties don't matter since we only move when strictly improving.
+int ContactGeometry::ConvexHull::Impl::
+findSupportVertex(const Vec3& direction, int startVertex) const {
+    int  best = startVertex;
+    Real bestHeight = dot(m_vertices[best], direction);
+    int  current;
+    do {
+        current = best;
+        const int end = m_neighborStart[current+1];
+        for (int i=m_neighborStart[current]; i < end; ++i) {
+            const int  nbr = m_neighbors[i];
+            const Real height = dot(m_vertices[nbr], direction);
+            if (height > bestHeight)
+                best = nbr, bestHeight = height;
+        }
+    } while (best != current);
+    return best;
+}
+
+bool ContactGeometry::ConvexHull::Impl::containsPoint(const Vec3& point) const {
+    for (int f=0; f < getNumFaces(); ++f)
+        if (dot(m_faceNormals[f], point) - m_faceOffsets[f] > m_tolerance)
+            return false;
+    return true;
+}
+
+void ContactGeometry::ConvexHull::Impl::
+createPolygonalMesh(PolygonalMesh& mesh) const {
+    for (int v=0; v < getNumVertices(); ++v)
+        mesh.addVertex(m_vertices[v]);
+    Array_<int> vertices(3);
+    for (int f=0; f < getNumFaces(); ++f) {
+        for (int k=0; k < 3; ++k)
+            vertices[k] = m_faces[3*f+k];
+        mesh.addFace(vertices);
+    }
+}
+
+DecorativeGeometry ContactGeometry::ConvexHull::Impl::
+createDecorativeGeometry() const {
+    PolygonalMesh mesh;
+    createPolygonalMesh(mesh);
+    return DecorativeMesh(mesh);
+}
+
+// Find the point of triangle abc that is closest to p. See Ericson, Real-Time
+// Collision Detection, section 5.1.5.
+static Vec3 findClosestPointOnTriangle
+   (const Vec3& p, const Vec3& a, const Vec3& b, const Vec3& c) {
+    const Vec3 ab = b-a, ac = c-a, ap = p-a;
+    const Real d1 = dot(ab,ap), d2 = dot(ac,ap);
+    if (d1 <= 0 && d2 <= 0) return a;
+    const Vec3 bp = p-b;
+    const Real d3 = dot(ab,bp), d4 = dot(ac,bp);
+    if (d3 >= 0 && d4 <= d3) return b;
+    const Real vc = d1*d4 - d3*d2;
+    if (vc <= 0 && d1 >= 0 && d3 <= 0) return a + (d1/(d1-d3))*ab;
+    const Vec3 cp = p-c;
+    const Real d5 = dot(ab,cp), d6 = dot(ac,cp);
+    if (d6 >= 0 && d5 <= d6) return c;
+    const Real vb = d5*d2 - d1*d6;
+    if (vb <= 0 && d2 >= 0 && d6 <= 0) return a + (d2/(d2-d6))*ac;
+    const Real va = d3*d6 - d5*d4;
+    if (va <= 0 && d4 >= d3 && d5 >= d6)
+        return b + ((d4-d3)/((d4-d3)+(d5-d6)))*(c-b);
+    const Real denom = 1/(va+vb+vc);
+    return a + (vb*denom)*ab + (vc*denom)*ac;
+}
+
+Vec3 ContactGeometry::ConvexHull::Impl::
+findNearestPoint(const Vec3& position, bool& inside, UnitVec3& normal) const {
+    // If the point is inside, the nearest point is on the nearest face plane.
+    int  nearestFace = 0;
+    Real maxHeight = -Infinity;
+    for (int f=0; f < getNumFaces(); ++f) {
+        const Real h = dot(m_faceNormals[f], position) - m_faceOffsets[f];
+        if (h > maxHeight) maxHeight = h, nearestFace = f;
+    }
+    if (maxHeight <= 0) {
+        inside = true;
+        normal = m_faceNormals[nearestFace];
+        return position - maxHeight*normal;
+    }
+
+    // Outside; only faces that can see the point can hold the answer.
+    inside = false;
+    Vec3 nearest = position; Real dist2 = Infinity;
+    for (int f=0; f < getNumFaces(); ++f) {
+        if (dot(m_faceNormals[f], position) - m_faceOffsets[f] <= 0)
+            continue;
+        const Vec3 q = findClosestPointOnTriangle(position,
+            m_vertices[m_faces[3*f]], m_vertices[m_faces[3*f+1]],
+            m_vertices[m_faces[3*f+2]]);
+        const Real d2 = (q-position).normSqr();
+        if (d2 < dist2) nearest = q, dist2 = d2;
+    }
+    normal = UnitVec3(position-nearest);
+    return nearest;
+}
+
+// Clip the ray against each face plane in turn.
+bool ContactGeometry::ConvexHull::Impl::
+intersectsRay(const Vec3& origin, const UnitVec3& direction,
+              Real& distance, UnitVec3& normal) const {
+    Real tEnter = -Infinity, tExit = Infinity;
+    int  enterFace = -1, exitFace = -1;
+    for (int f=0; f < getNumFaces(); ++f) {
+        const Real h = dot(m_faceNormals[f], origin) - m_faceOffsets[f];
+        const Real rate = dot(m_faceNormals[f], direction);
+        if (rate == 0) {
+            if (h > 0) return false; // parallel and outside
+            continue;
+        }
+        const Real t = -h/rate;
+        if (rate < 0) {
+            if (t > tEnter) tEnter = t, enterFace = f;
+        } else {
+            if (t < tExit) tExit = t, exitFace = f;
+        }
+        if (tEnter > tExit) return false;
+    }
+    if (tEnter >= 0 && enterFace >= 0) {
+        distance = tEnter;
+        normal = m_faceNormals[enterFace];
+        return true;
+    }
+    if (tExit >= 0 && exitFace >= 0) { // origin was inside
+        distance = tExit;
+        normal = m_faceNormals[exitFace];
+        return true;
+    }
+    return false;
+}
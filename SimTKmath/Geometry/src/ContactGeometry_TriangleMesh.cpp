@@ -188,6 +188,17 @@ ContactGeometry::TriangleMesh::getOBBTreeNode() const {
     return OBBTreeNode(getImpl().obb);
 }
 
+int ContactGeometry::TriangleMesh::getNumOBBTreeNodes() const {
+    return getImpl().obbNodes.size();
+}
+
+ContactGeometry::TriangleMesh::OBBTreeNode 
+ContactGeometry::TriangleMesh::getOBBTreeNode(int nodeIndex) const {
+    SimTK_INDEXCHECK_ALWAYS(nodeIndex, getNumOBBTreeNodes(),
+        "ContactGeometry::TriangleMesh::getOBBTreeNode()");
+    return OBBTreeNode(*getImpl().obbNodes[nodeIndex]);
+}
+
 PolygonalMesh ContactGeometry::TriangleMesh::createPolygonalMesh() const {
     PolygonalMesh mesh;
     getImpl().createPolygonalMesh(mesh);
@@ -307,6 +318,17 @@ ContactGeometry::TriangleMesh::Impl::Impl
     init(vertexPositions, faceIndices);
 }
 
+// The copied OBB tree has new nodes, so it must be indexed again rather than
+// sharing the source's table of node pointers.
+ContactGeometry::TriangleMesh::Impl::Impl(const Impl& source)
+:   ContactGeometryImpl(source), edges(source.edges), faces(source.faces),
+    vertices(source.vertices), 
+    boundingSphereCenter(source.boundingSphereCenter),
+    boundingSphereRadius(source.boundingSphereRadius), obb(source.obb),
+    smooth(source.smooth) {
+    indexObbTree(obb);
+}
+
 ContactGeometry::TriangleMesh::Impl::Impl
    (const PolygonalMesh& mesh, bool smooth) 
 :   ContactGeometryImpl(), smooth(smooth) 
@@ -535,6 +557,7 @@ void ContactGeometry::TriangleMesh::Impl::init
     for (int i = 0; i < (int) allFaces.size(); i++)
         allFaces[i] = i;
     createObbTree(obb, allFaces);
+    indexObbTree(obb);
     
     // Find the bounding sphere.
     Array_<const Vec3*> points(vertices.size());
@@ -624,6 +647,19 @@ void ContactGeometry::TriangleMesh::Impl::createObbTree
                           faceIndices.end());
 }
 
+// Number the nodes in preorder so the root is node 0, and record where each
+// one is so that a node can be found again from its index.
+void ContactGeometry::TriangleMesh::Impl::indexObbTree(OBBTreeNodeImpl& node) {
+    if (&node == &obb)
+        obbNodes.clear();
+    node.index = obbNodes.size();
+    obbNodes.push_back(&node);
+    if (node.child1 != NULL) {
+        indexObbTree(*node.child1);
+        indexObbTree(*node.child2);
+    }
+}
+
 void ContactGeometry::TriangleMesh::Impl::splitObbAxis
    (const Array_<int>& parentIndices, Array_<int>& child1Indices, 
     Array_<int>& child2Indices, int axis) 
@@ -773,7 +809,7 @@ Vec3 ContactGeometry::TriangleMesh::Impl::findNearestPointToFace
 
 OBBTreeNodeImpl::OBBTreeNodeImpl(const OBBTreeNodeImpl& copy) 
 :   bounds(copy.bounds), triangles(copy.triangles), 
-    numTriangles(copy.numTriangles) {
+    numTriangles(copy.numTriangles), index(copy.index) {
     if (copy.child1 == NULL) {
         child1 = NULL;
         child2 = NULL;
@@ -1026,6 +1062,10 @@ getTriangles() const {
     return impl->triangles;
 }
 
+int ContactGeometry::TriangleMesh::OBBTreeNode::getIndex() const {
+    return impl->index;
+}
+
 int ContactGeometry::TriangleMesh::OBBTreeNode::getNumTriangles() const {
     return impl->numTriangles;
 }
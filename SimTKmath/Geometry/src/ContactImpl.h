@@ -229,6 +229,39 @@ friend class BrickHalfSpaceContact;
 
 
 
+//==============================================================================
+//                          CONVEX HULL CONTACT IMPL
+//==============================================================================
+/** This is the internal implementation class for ConvexHullContact. **/
+class ConvexHullContactImpl : public ContactImpl {
+public:
+    ConvexHullContactImpl
+       (ContactSurfaceIndex surf1, ContactSurfaceIndex surf2,
+        const Transform& X_S1S2, const UnitVec3& normal, Real depth,
+        const Array_<Vec3>& points, const Array_<Real>& pointDepths,
+        const Array_<int>& simplex1, const Array_<int>& simplex2)
+    :   ContactImpl(surf1, surf2, X_S1S2), normal(normal), depth(depth),
+        points(points), pointDepths(pointDepths), 
+        simplex1(simplex1), simplex2(simplex2) {}
+
+    ContactTypeId getTypeId() const override {return classTypeId();}
+    static ContactTypeId classTypeId() {
+        static const ContactTypeId tid = createNewContactTypeId();
+        return tid;
+    }
+
+private:
+friend class ConvexHullContact;
+    UnitVec3        normal;
+    Real            depth;
+    Array_<Vec3>    points;
+    Array_<Real>    pointDepths;
+    Array_<int>     simplex1;
+    Array_<int>     simplex2;
+};
+
+
+
 //==============================================================================
 //                            TRIANGLE MESH IMPL
 //==============================================================================
@@ -239,7 +272,9 @@ public:
                             ContactSurfaceIndex     surf2,
                             const Transform&        X_S1S2,
                             const std::set<int>&    faces1, 
-                            const std::set<int>&    faces2);
+                            const std::set<int>&    faces2,
+                            const Array_<int>&      searchFront1,
+                            const Array_<int>&      searchFront2);
 
     ContactTypeId getTypeId() const override {return classTypeId();}
     static ContactTypeId classTypeId() {
@@ -250,8 +285,11 @@ public:
 private:
 friend class TriangleMeshContact;
 
-    const std::set<int> faces1;
-    const std::set<int> faces2;
+    // Inside faces, copied from the std::sets so they stay sorted.
+    const Array_<int>   faces1;
+    const Array_<int>   faces2;
+    const Array_<int>   searchFront1;
+    const Array_<int>   searchFront2;
 };
 
 
@@ -692,6 +692,78 @@ bool ContactTracker::HalfSpaceBrick::trackContact
 
 
 
+//==============================================================================
+//                   HALFSPACE-CONVEX HULL CONTACT TRACKER
+//==============================================================================
+bool ContactTracker::HalfSpaceConvexHull::trackContact
+   (const Contact&         priorStatus,
+    const Transform&       X_GH, 
+    const ContactGeometry& geoHalfSpace,
+    const Transform&       X_GC, 
+    const ContactGeometry& geoHull,
+    Real                   cutoff,
+    Contact&               currentStatus) const
+{
+    SimTK_ASSERT
+       (   geoHalfSpace.getTypeId()==ContactGeometry::HalfSpace::classTypeId()
+        && geoHull.getTypeId()==ContactGeometry::ConvexHull::classTypeId(),
+       "ContactTracker::HalfSpaceConvexHull::trackContact()");
+
+    const ContactGeometry::HalfSpace& halfSpace =
+        ContactGeometry::HalfSpace::getAs(geoHalfSpace);
+    // This is the half-space outward normal in its own frame.
+    const UnitVec3 n_H = halfSpace.getNormal();
+
+    const ContactGeometry::ConvexHull& hull = 
+        ContactGeometry::ConvexHull::getAs(geoHull);
+
+    const Transform X_HC = ~X_GH * X_GC;
+
+    // Start looking for the lowest vertex where we found it last time.
+    int start = 0;
+    if (ConvexHullContact::isInstance(priorStatus)) {
+        const Array_<int>& prev = 
+            ConvexHullContact::getAs(priorStatus).getSimplexVertices2();
+        if (!prev.empty()) start = prev[0];
+    }
+    const UnitVec3 nn_C = ~X_HC.R()*(-n_H);
+    const int lowestVertex = hull.findSupportVertex(nn_C, start);
+    const Real height = dot(X_HC*hull.getVertexPosition(lowestVertex), n_H);
+
+    if (height >= cutoff) {
+        currentStatus.clear(); // not touching
+        return true; // successful return
+    }
+
+    // The vertices below any plane are connected by hull edges, so we can
+    // find them all by flooding outwards from the lowest one.
+    Array_<Vec3> points; Array_<Real> depths;
+    Array_<int> toVisit(1, lowestVertex);
+    std::set<int> seen; seen.insert(lowestVertex);
+    while (!toVisit.empty()) {
+        const int v = toVisit.back(); toVisit.pop_back();
+        const Vec3 p_H = X_HC*hull.getVertexPosition(v);
+        const Real h = dot(p_H, n_H);
+        if (h >= cutoff)
+            continue;
+        points.push_back(p_H); depths.push_back(-h);
+        for (int i=0; i < hull.getNumVertexNeighbors(v); ++i) {
+            const int nbr = hull.getVertexNeighbor(v, i);
+            if (seen.insert(nbr).second)
+                toVisit.push_back(nbr);
+        }
+    }
+
+    currentStatus = ConvexHullContact(priorStatus.getSurface1(),
+                                      priorStatus.getSurface2(),
+                                      X_HC, n_H, -height, points, depths,
+                                      Array_<int>(), 
+                                      Array_<int>(1, lowestVertex));
+    return true; // success
+}
+
+
+
 //==============================================================================
 //                       SPHERE-SPHERE CONTACT TRACKER
 //==============================================================================
@@ -768,10 +840,68 @@ bool ContactTracker::SphereSphere::trackContact
 
 
 
+//==============================================================================
+//                    TRIANGLE MESH OBB TREE SEARCH FRONTS
+//==============================================================================
+// The mesh trackers record in each TriangleMeshContact the OBB tree nodes (or
+// pairs of nodes) at which their search stopped. Those nodes cover each mesh
+// exactly once, so the next search can start from them instead of from the 
+// root and still find exactly the same faces.
+
+// Get the search fronts recorded in the prior Contact for whichever of the
+// two surfaces are meshes (pass null for one that isn't). If there aren't
+// usable ones, start from the root of each mesh's tree instead.
+static void getPriorSearchFronts(const Contact&                       prior,
+                                 const ContactGeometry::TriangleMesh* mesh1,
+                                 const ContactGeometry::TriangleMesh* mesh2,
+                                 Array_<int>&                         front1,
+                                 Array_<int>&                         front2)
+{
+    front1.clear(); front2.clear();
+    if (TriangleMeshContact::isInstance(prior)) {
+        const TriangleMeshContact& contact = TriangleMeshContact::getAs(prior);
+        front1 = contact.getSearchFront1();
+        front2 = contact.getSearchFront2();
+    }
+    const ContactGeometry::TriangleMesh* mesh[2]  = {mesh1, mesh2};
+    const Array_<int>*                   front[2] = {&front1, &front2};
+    bool usable = !(mesh1 && mesh2) || front1.size() == front2.size();
+    for (int m=0; m < 2 && usable; ++m) {
+        if (!mesh[m]) {usable = front[m]->empty(); continue;}
+        usable = !front[m]->empty();
+        for (unsigned i=0; i < front[m]->size() && usable; ++i)
+            usable = (*front[m])[i] < mesh[m]->getNumOBBTreeNodes();
+    }
+    if (!usable) {
+        front1.clear(); front2.clear();
+        if (mesh1) front1.push_back(0); // the root
+        if (mesh2) front2.push_back(0);
+    }
+}
+
+// A front that has followed a sliding contact keeps the small nodes it 
+// descended to in places that are no longer touching. A fresh search from the
+// root would stop at about treeDepth nodes for each one still in contact, so
+// once the clear ones greatly outnumber that it's cheaper to drop the front 
+// and start from the root next time.
+static bool isSearchFrontCompact(int frontSize, int numClear, int treeDepth) {
+    return numClear <= 4*treeDepth*(frontSize - numClear + 1);
+}
+
+// Bound the depth of a balanced tree with this many nodes.
+static int calcTreeDepth(int numNodes) {
+    int depth = 1;
+    while (numNodes >>= 1) ++depth;
+    return depth;
+}
+
+
+
 //==============================================================================
 //                  HALFSPACE - TRIANGLE MESH CONTACT TRACKER
 //==============================================================================
-// Cost is TODO
+// Cost is proportional to the number of OBB tree nodes in the search front,
+// which for a persistent contact is about the size of the contact region.
 bool ContactTracker::HalfSpaceTriangleMesh::trackContact
    (const Contact&         priorStatus,
     const Transform&       X_GH, 
@@ -805,31 +935,43 @@ bool ContactTracker::HalfSpaceTriangleMesh::trackContact
     // from the mesh origin.
     const Real hsFaceHeight_M = dot((~X_HM).p(), hsNormal_M);
     // Now collect all the faces that are all or partially below the 
-    // halfspace surface.
+    // halfspace surface, starting from where the prior search stopped.
+    Array_<int> noFront, priorFront, searchFront;
+    getPriorSearchFronts(priorStatus, 0, &mesh, noFront, priorFront);
     std::set<int> insideFaces;
-    processBox(mesh, mesh.getOBBTreeNode(), X_HM, 
-               hsNormal_M, hsFaceHeight_M, insideFaces);
+    int numClear = 0;
+    for (unsigned i=0; i < priorFront.size(); ++i)
+        processBox(mesh, mesh.getOBBTreeNode(priorFront[i]), X_HM, 
+                   hsNormal_M, hsFaceHeight_M, insideFaces, 
+                   searchFront, numClear);
     
     if (insideFaces.empty()) {
         currentStatus.clear(); // not touching
         return true; // successful return
     }
+
+    if (!isSearchFrontCompact(searchFront.size(), numClear, 
+                              calcTreeDepth(mesh.getNumOBBTreeNodes())))
+        searchFront.clear();
     
     currentStatus = TriangleMeshContact(priorStatus.getSurface1(), 
                                         priorStatus.getSurface2(), 
                                         X_HM, 
-                                        std::set<int>(), insideFaces);
+                                        std::set<int>(), insideFaces,
+                                        Array_<int>(), searchFront);
     return true; // success
 }
 
 
 // Check a single OBB and its contents (recursively) against the halfspace,
-// appending any penetrating faces to the insideFaces list.
+// appending any penetrating faces to the insideFaces list. Nodes at which the
+// search stops are appended to the searchFront, and counted in numClear if 
+// they don't penetrate.
 void ContactTracker::HalfSpaceTriangleMesh::processBox
    (const ContactGeometry::TriangleMesh&              mesh, 
     const ContactGeometry::TriangleMesh::OBBTreeNode& node, 
     const Transform& X_HM, const UnitVec3& hsNormal_M, Real hsFaceHeight_M, 
-    std::set<int>& insideFaces) const 
+    std::set<int>& insideFaces, Array_<int>& searchFront, int& numClear) const 
 {   // First check against the node's bounding box.
     
     const OrientedBoundingBox& bounds = node.getBounds();
@@ -850,9 +992,12 @@ void ContactTracker::HalfSpaceTriangleMesh::processBox
     // Subtract the halfspace surface position to get the height of the 
     // box center over the halfspace.
     const Real boxCenterHeight = boxCenterHeight_M - hsFaceHeight_M;
-    if (boxCenterHeight >= extent)
+    if (boxCenterHeight >= extent) {
+        searchFront.push_back(node.getIndex()); ++numClear;
         return;                             // no penetration
+    }
     if (boxCenterHeight <= -extent) {
+        searchFront.push_back(node.getIndex());
         addAllTriangles(node, insideFaces); // box is entirely in halfspace
         return;
     }
@@ -861,14 +1006,15 @@ void ContactTracker::HalfSpaceTriangleMesh::processBox
     // check its children.
     if (!node.isLeafNode()) {
         processBox(mesh, node.getFirstChildNode(), X_HM, hsNormal_M, 
-                   hsFaceHeight_M, insideFaces);
+                   hsFaceHeight_M, insideFaces, searchFront, numClear);
         processBox(mesh, node.getSecondChildNode(), X_HM, hsNormal_M, 
-                   hsFaceHeight_M, insideFaces);
+                   hsFaceHeight_M, insideFaces, searchFront, numClear);
         return;
     }
     
     // This is a leaf OBB node that is penetrating, so some of its triangles
     // may be penetrating.
+    searchFront.push_back(node.getIndex());
     const Array_<int>& triangles = node.getTriangles();
     for (int i = 0; i < (int) triangles.size(); i++) {
         for (int vx=0; vx < 3; ++vx) {
@@ -903,7 +1049,8 @@ void ContactTracker::HalfSpaceTriangleMesh::addAllTriangles
 //==============================================================================
 //                  SPHERE - TRIANGLE MESH CONTACT TRACKER
 //==============================================================================
-// Cost is TODO
+// Cost is proportional to the number of OBB tree nodes in the search front,
+// as for HalfSpaceTriangleMesh.
 bool ContactTracker::SphereTriangleMesh::trackContact
    (const Contact&         priorStatus,
     const Transform&       X_GS, 
@@ -933,46 +1080,61 @@ bool ContactTracker::SphereTriangleMesh::trackContact
 
     // Want the sphere center measured and expressed in the mesh frame.
     const Vec3 p_MC = (~X_SM).p();
+    Array_<int> noFront, priorFront, searchFront;
+    getPriorSearchFronts(priorStatus, 0, &mesh, noFront, priorFront);
     std::set<int> insideFaces;
-    processBox(mesh, mesh.getOBBTreeNode(), p_MC, square(sphere.getRadius()), 
-               insideFaces);
+    int numClear = 0;
+    for (unsigned i=0; i < priorFront.size(); ++i)
+        processBox(mesh, mesh.getOBBTreeNode(priorFront[i]), p_MC, 
+                   square(sphere.getRadius()), insideFaces, 
+                   searchFront, numClear);
     
     if (insideFaces.empty()) {
         currentStatus.clear(); // not touching
         return true; // successful return
     }
+
+    if (!isSearchFrontCompact(searchFront.size(), numClear, 
+                              calcTreeDepth(mesh.getNumOBBTreeNodes())))
+        searchFront.clear();
     
     currentStatus = TriangleMeshContact(priorStatus.getSurface1(), 
                                         priorStatus.getSurface2(), 
                                         X_SM, 
-                                        std::set<int>(), insideFaces);
+                                        std::set<int>(), insideFaces,
+                                        Array_<int>(), searchFront);
     return true; // success
 }
 
 // Check a single OBB and its contents (recursively) against the sphere
 // whose center location in M and radius squared is given, appending any 
-// penetrating faces to the insideFaces list.
+// penetrating faces to the insideFaces list. Nodes at which the search stops
+// are appended to the searchFront, and counted in numClear if they don't
+// penetrate.
 void ContactTracker::SphereTriangleMesh::processBox
    (const ContactGeometry::TriangleMesh&              mesh, 
     const ContactGeometry::TriangleMesh::OBBTreeNode& node, 
     const Vec3& center_M, Real radius2, 
-    std::set<int>& insideFaces) const 
+    std::set<int>& insideFaces, Array_<int>& searchFront, int& numClear) const 
 {   // First check against the node's bounding box.
 
     const Vec3 nearest_M = node.getBounds().findNearestPoint(center_M);
-    if ((nearest_M-center_M).normSqr() >= radius2)
+    if ((nearest_M-center_M).normSqr() >= radius2) {
+        searchFront.push_back(node.getIndex()); ++numClear;
         return; // no intersection possible
+    }
     
     // Bounding box is penetrating. If it's not a leaf node, check its children.
     if (!node.isLeafNode()) {
         processBox(mesh, node.getFirstChildNode(), center_M, radius2,
-                   insideFaces);
+                   insideFaces, searchFront, numClear);
         processBox(mesh, node.getSecondChildNode(), center_M, radius2,
-                   insideFaces);
+                   insideFaces, searchFront, numClear);
         return;
     }
     
     // This is a leaf node that may be penetrating; check the triangles.
+    searchFront.push_back(node.getIndex());
     const Array_<int>& triangles = node.getTriangles();
     for (unsigned i = 0; i < triangles.size(); i++) {
         Vec2 uv;
@@ -988,7 +1150,8 @@ void ContactTracker::SphereTriangleMesh::processBox
 //==============================================================================
 //               TRIANGLE MESH - TRIANGLE MESH CONTACT TRACKER
 //==============================================================================
-// Cost is TODO
+// Cost is proportional to the number of node pairs in the search front plus
+// the number of faces in or next to the contact region.
 bool ContactTracker::TriangleMeshTriangleMesh::trackContact
    (const Contact&         priorStatus,
     const Transform&       X_GM1, 
@@ -1017,15 +1180,22 @@ bool ContactTracker::TriangleMeshTriangleMesh::trackContact
     const Transform X_M1M2 = ~X_GM1*X_GM2; 
     std::set<int> insideFaces1, insideFaces2;
 
-    // Get M2's bounding box in M1's frame.
-    const OrientedBoundingBox 
-        mesh2Bounds_M1 = X_M1M2*mesh2.getOBBTreeNode().getBounds();
-
     // Find the faces that are actually intersecting faces on the other
-    // surface (this doesn't yet include faces that may be completely buried).
-    findIntersectingFaces(mesh1, mesh2, 
-                          mesh1.getOBBTreeNode(), mesh2.getOBBTreeNode(), 
-                          mesh2Bounds_M1, X_M1M2, insideFaces1, insideFaces2);
+    // surface (this doesn't yet include faces that may be completely buried),
+    // starting from the pairs of nodes where the prior search stopped.
+    Array_<int> priorFront1, priorFront2, searchFront1, searchFront2;
+    getPriorSearchFronts(priorStatus, &mesh1, &mesh2, priorFront1, priorFront2);
+    int numClear = 0;
+    for (unsigned i=0; i < priorFront1.size(); ++i) {
+        const ContactGeometry::TriangleMesh::OBBTreeNode 
+            node1 = mesh1.getOBBTreeNode(priorFront1[i]),
+            node2 = mesh2.getOBBTreeNode(priorFront2[i]);
+        // Get node2's bounding box in M1's frame.
+        findIntersectingFaces(mesh1, mesh2, node1, node2,
+                              X_M1M2*node2.getBounds(), X_M1M2, 
+                              insideFaces1, insideFaces2, 
+                              searchFront1, searchFront2, numClear);
+    }
     
     // It should never be the case that one set of faces is empty and the
     // other isn't, however it is conceivable that roundoff error could cause
@@ -1041,10 +1211,16 @@ bool ContactTracker::TriangleMeshTriangleMesh::trackContact
     findBuriedFaces(mesh1, mesh2, ~X_M1M2, insideFaces1);
     findBuriedFaces(mesh2, mesh1,  X_M1M2, insideFaces2);
 
+    if (!isSearchFrontCompact(searchFront1.size(), numClear,
+                              calcTreeDepth(mesh1.getNumOBBTreeNodes())
+                            + calcTreeDepth(mesh2.getNumOBBTreeNodes())))
+        searchFront1.clear(), searchFront2.clear();
+
     currentStatus = TriangleMeshContact(priorStatus.getSurface1(), 
                                         priorStatus.getSurface2(), 
                                         X_M1M2, 
-                                        insideFaces1, insideFaces2);
+                                        insideFaces1, insideFaces2,
+                                        searchFront1, searchFront2);
     return true; // success
 }
 
@@ -1057,11 +1233,18 @@ findIntersectingFaces
     const OrientedBoundingBox&                          node2Bounds_M1,
     const Transform&                                    X_M1M2, 
     std::set<int>&                                      triangles1, 
-    std::set<int>&                                      triangles2) const 
+    std::set<int>&                                      triangles2,
+    Array_<int>&                                        searchFront1,
+    Array_<int>&                                        searchFront2,
+    int&                                                numClear) const 
 {   // See if the bounding boxes intersect.
     
-    if (!node1.getBounds().intersectsBox(node2Bounds_M1))
+    if (!node1.getBounds().intersectsBox(node2Bounds_M1)) {
+        searchFront1.push_back(node1.getIndex());
+        searchFront2.push_back(node2.getIndex());
+        ++numClear;
         return;
+    }
     
     // If either node is not a leaf node, process the children recursively.
     
@@ -1071,14 +1254,14 @@ findIntersectingFaces
                 X_M1M2*node2.getFirstChildNode().getBounds();
             const OrientedBoundingBox secondChildBounds = 
                 X_M1M2*node2.getSecondChildNode().getBounds();
-            findIntersectingFaces(mesh1, mesh2, node1.getFirstChildNode(), node2.getFirstChildNode(), firstChildBounds, X_M1M2, triangles1, triangles2);
-            findIntersectingFaces(mesh1, mesh2, node1.getFirstChildNode(), node2.getSecondChildNode(), secondChildBounds, X_M1M2, triangles1, triangles2);
-            findIntersectingFaces(mesh1, mesh2, node1.getSecondChildNode(), node2.getFirstChildNode(), firstChildBounds, X_M1M2, triangles1, triangles2);
-            findIntersectingFaces(mesh1, mesh2, node1.getSecondChildNode(), node2.getSecondChildNode(), secondChildBounds, X_M1M2, triangles1, triangles2);
+            findIntersectingFaces(mesh1, mesh2, node1.getFirstChildNode(), node2.getFirstChildNode(), firstChildBounds, X_M1M2, triangles1, triangles2, searchFront1, searchFront2, numClear);
+            findIntersectingFaces(mesh1, mesh2, node1.getFirstChildNode(), node2.getSecondChildNode(), secondChildBounds, X_M1M2, triangles1, triangles2, searchFront1, searchFront2, numClear);
+            findIntersectingFaces(mesh1, mesh2, node1.getSecondChildNode(), node2.getFirstChildNode(), firstChildBounds, X_M1M2, triangles1, triangles2, searchFront1, searchFront2, numClear);
+            findIntersectingFaces(mesh1, mesh2, node1.getSecondChildNode(), node2.getSecondChildNode(), secondChildBounds, X_M1M2, triangles1, triangles2, searchFront1, searchFront2, numClear);
         }
         else {
-            findIntersectingFaces(mesh1, mesh2, node1.getFirstChildNode(), node2, node2Bounds_M1, X_M1M2, triangles1, triangles2);
-            findIntersectingFaces(mesh1, mesh2, node1.getSecondChildNode(), node2, node2Bounds_M1, X_M1M2, triangles1, triangles2);
+            findIntersectingFaces(mesh1, mesh2, node1.getFirstChildNode(), node2, node2Bounds_M1, X_M1M2, triangles1, triangles2, searchFront1, searchFront2, numClear);
+            findIntersectingFaces(mesh1, mesh2, node1.getSecondChildNode(), node2, node2Bounds_M1, X_M1M2, triangles1, triangles2, searchFront1, searchFront2, numClear);
         }
         return;
     }
@@ -1087,12 +1270,14 @@ findIntersectingFaces
             X_M1M2*node2.getFirstChildNode().getBounds();
         const OrientedBoundingBox secondChildBounds = 
             X_M1M2*node2.getSecondChildNode().getBounds();
-        findIntersectingFaces(mesh1, mesh2, node1, node2.getFirstChildNode(), firstChildBounds, X_M1M2, triangles1, triangles2);
-        findIntersectingFaces(mesh1, mesh2, node1, node2.getSecondChildNode(), secondChildBounds, X_M1M2, triangles1, triangles2);
+        findIntersectingFaces(mesh1, mesh2, node1, node2.getFirstChildNode(), firstChildBounds, X_M1M2, triangles1, triangles2, searchFront1, searchFront2, numClear);
+        findIntersectingFaces(mesh1, mesh2, node1, node2.getSecondChildNode(), secondChildBounds, X_M1M2, triangles1, triangles2, searchFront1, searchFront2, numClear);
         return;
     }
     
     // These are both leaf nodes, so check triangles for intersections.
+    searchFront1.push_back(node1.getIndex());
+    searchFront2.push_back(node2.getIndex());
     
     const Array_<int>& node1triangles = node1.getTriangles();
     const Array_<int>& node2triangles = node2.getTriangles();
@@ -1117,10 +1302,28 @@ findIntersectingFaces
     }
 }
 
-static const int Outside  = -1;
-static const int Unknown  =  0;
-static const int Boundary =  1;
-static const int Inside   =  2;
+// Return the face that shares the i'th edge of the given face.
+static int getAdjacentFace(const ContactGeometry::TriangleMesh& mesh, 
+                           int face, int i) {
+    const int edge = mesh.getFaceEdge(face, i);
+    return mesh.getEdgeFace(edge, 0) == face ? mesh.getEdgeFace(edge, 1) 
+                                             : mesh.getEdgeFace(edge, 0);
+}
+
+// Trace a ray from the center of a face along its normal to determine whether
+// the face is inside the other mesh.
+static bool isFaceInside(const ContactGeometry::TriangleMesh& mesh,
+                         const ContactGeometry::TriangleMesh& otherMesh,
+                         const Transform& X_OM, int face) {
+    const Vec3     origin_O    = X_OM    * mesh.findCentroid(face);
+    const UnitVec3 direction_O = X_OM.R()* mesh.getFaceNormal(face);
+    Real distance;
+    int otherFace;
+    Vec2 uv;
+    return otherMesh.intersectsRay(origin_O, direction_O, distance, 
+                                   otherFace, uv) 
+        && ~direction_O*otherMesh.getFaceNormal(otherFace) > 0;
+}
 
 void ContactTracker::TriangleMeshTriangleMesh::
 findBuriedFaces(const ContactGeometry::TriangleMesh&    mesh,       // M 
@@ -1130,60 +1333,36 @@ findBuriedFaces(const ContactGeometry::TriangleMesh&    mesh,       // M
 {  
     // Find which faces are inside.
     // We're passed in the list of Boundary faces, that is, those faces of
-    // "mesh" that intersect faces of "otherMesh".
-    Array_<int> faceType(mesh.getNumFaces(), Unknown);
-    for (std::set<int>::iterator iter = insideFaces.begin(); 
-                                 iter != insideFaces.end(); ++iter)
-        faceType[*iter] = Boundary;
-
-    for (int i = 0; i < (int) faceType.size(); i++) {
-        if (faceType[i] == Unknown) {
-            // Trace a ray from its center to determine whether it is inside.           
-            const Vec3     origin_O    = X_OM    * mesh.findCentroid(i);
-            const UnitVec3 direction_O = X_OM.R()* mesh.getFaceNormal(i);
-            Real distance;
-            int face;
-            Vec2 uv;
-            if (   otherMesh.intersectsRay(origin_O, direction_O, distance, 
-                                           face, uv) 
-                && ~direction_O*otherMesh.getFaceNormal(face) > 0) 
-            {
-                faceType[i] = Inside;
-                insideFaces.insert(i);
-            } else
-                faceType[i] = Outside;
-            
-            // Recursively mark adjacent inside or outside Faces.           
-            tagFaces(mesh, faceType, insideFaces, i, 0);
-        }
-    }
-}
-
-//TODO: the following method uses depth-first recursion to iterate through
-//unmarked faces. For a large mesh this was observed to produce a stack
-//overflow in OpenSim. Here we limit the recursion depth; after we get that
-//deep we'll pop back out and do another expensive intersectsRay() test in
-//the method above.
-static const int MaxRecursionDepth = 500;
-
-void ContactTracker::TriangleMeshTriangleMesh::
-tagFaces(const ContactGeometry::TriangleMesh&   mesh, 
-         Array_<int>&                           faceType,
-         std::set<int>&                         triangles, 
-         int                                    index,
-         int                                    depth) const 
-{
-    for (int i = 0; i < 3; i++) {
-        const int edge = mesh.getFaceEdge(index, i);
-        const int face = (mesh.getEdgeFace(edge, 0) == index 
-                            ? mesh.getEdgeFace(edge, 1) 
-                            : mesh.getEdgeFace(edge, 0));
-        if (faceType[face] == Unknown) {
-            faceType[face] = faceType[index];
-            if (faceType[index] > 0)
-                triangles.insert(face);
-            if (depth < MaxRecursionDepth)
-                tagFaces(mesh, faceType, triangles, face, depth+1);
+    // "mesh" that intersect faces of "otherMesh". Any buried face is reached
+    // from those through other buried faces, so we only need to test the
+    // neighbors of the boundary faces and then spread from the ones that are
+    // inside until we get back to the boundary. Faces elsewhere in the mesh
+    // are never looked at.
+    const std::set<int> boundaryFaces(insideFaces);
+    std::set<int> outsideFaces;
+    Array_<int> toVisit;
+    for (std::set<int>::const_iterator iter = boundaryFaces.begin(); 
+                                       iter != boundaryFaces.end(); ++iter) {
+        for (int i = 0; i < 3; i++) {
+            const int start = getAdjacentFace(mesh, *iter, i);
+            if (insideFaces.count(start) || outsideFaces.count(start))
+                continue;
+            if (!isFaceInside(mesh, otherMesh, X_OM, start)) {
+                outsideFaces.insert(start);
+                continue;
+            }
+            insideFaces.insert(start);
+            toVisit.push_back(start);
+            while (!toVisit.empty()) {
+                const int face = toVisit.back(); toVisit.pop_back();
+                for (int j = 0; j < 3; j++) {
+                    const int next = getAdjacentFace(mesh, face, j);
+                    if (!insideFaces.count(next) && !outsideFaces.count(next)) {
+                        insideFaces.insert(next);
+                        toVisit.push_back(next);
+                    }
+                }
+            }
         }
     }
 }
@@ -1359,6 +1538,435 @@ bool ContactTracker::ConvexImplicitPair::trackContact
 
 
 
+//==============================================================================
+//                     CONVEX HULL PAIR CONTACT TRACKER
+//==============================================================================
+// GJK and EPA work with the Minkowski difference A-B of the two hulls, which
+// contains the origin exactly when they overlap. See van den Bergen, G.
+// "Collision Detection in Interactive 3D Environments", Morgan Kaufmann, 2004.
+// All the work here is done in A's frame.
+
+namespace {
+
+// A vertex of the Minkowski difference, with the hull vertices it came from.
+struct HullPairVertex {
+    Vec3 w;     // a-b
+    int  a, b;  // vertex indices in A and B
+};
+
+// Finds support vertices of A-B. Each search starts from the vertices found
+// by the previous one since successive directions are usually similar.
+class HullPairSupport {
+public:
+    HullPairSupport(const ContactGeometry::ConvexHull& hullA,
+                    const ContactGeometry::ConvexHull& hullB,
+                    const Transform&                   X_AB)
+    :   hullA(hullA), hullB(hullB), X_AB(X_AB), lastA(0), lastB(0) {}
+
+    HullPairVertex make(int a, int b) const {
+        HullPairVertex v; v.a = a; v.b = b;
+        v.w = hullA.getVertexPosition(a) - X_AB*hullB.getVertexPosition(b);
+        return v;
+    }
+
+    // Direction d is in A and need not be a unit vector.
+    HullPairVertex find(const Vec3& d) {
+        const UnitVec3 dir(d);
+        lastA = hullA.findSupportVertex(dir, lastA);
+        lastB = hullB.findSupportVertex(~X_AB.R()*(-dir), lastB);
+        return make(lastA, lastB);
+    }
+
+    const ContactGeometry::ConvexHull&  hullA;
+    const ContactGeometry::ConvexHull&  hullB;
+    const Transform&                    X_AB;
+    int                                 lastA, lastB;
+};
+
+// Project the origin onto the affine hull of the k selected simplex vertices,
+// returning the barycentric weights. Returns false if those vertices are
+// (nearly) degenerate or the projection isn't strictly inside them.
+bool projectOriginOnSubsimplex(const Array_<HullPairVertex>& simplex,
+                               const int* which, int k, Vec4& lambda) {
+    lambda = 0;
+    if (k == 1) {lambda[0] = 1; return true;}
+    const Vec3& w0 = simplex[which[0]].w;
+    Vec3 e[3];
+    for (int i=1; i < k; ++i) e[i-1] = simplex[which[i]].w - w0;
+    Vec3 mu(0);
+    if (k == 2) {
+        const Real ee = e[0].normSqr();
+        if (ee <= 0) return false;
+        mu[0] = -dot(e[0],w0)/ee;
+    } else if (k == 3) {
+        const Mat22 G(dot(e[0],e[0]), dot(e[0],e[1]),
+                      dot(e[1],e[0]), dot(e[1],e[1]));
+        if (det(G) <= SignificantReal*G(0,0)*G(1,1)) return false;
+        const Vec2 m = G.invert()*Vec2(-dot(e[0],w0), -dot(e[1],w0));
+        mu[0] = m[0]; mu[1] = m[1];
+    } else {
+        Mat33 G;
+        for (int i=0; i < 3; ++i)
+            for (int j=0; j < 3; ++j)
+                G(i,j) = dot(e[i],e[j]);
+        if (det(G) <= SignificantReal*G(0,0)*G(1,1)*G(2,2)) return false;
+        mu = G.invert()*Vec3(-dot(e[0],w0), -dot(e[1],w0), -dot(e[2],w0));
+    }
+    lambda[0] = 1;
+    for (int i=1; i < k; ++i) {
+        if (mu[i-1] <= 0) return false;
+        lambda[i] = mu[i-1]; lambda[0] -= mu[i-1];
+    }
+    return lambda[0] > 0;
+}
+
+// Find the point of the simplex (1 to 4 vertices) that is closest to the
+// origin, and reduce the simplex to the vertices needed to express it. The 
+// simplex is so small that we can just try every subset of its vertices; the
+// answer is the closest of the projections that are inside their subsets.
+// The barycentric weights of the remaining vertices are returned in lambda.
+Vec3 reduceSimplex(Array_<HullPairVertex>& simplex, Array_<Real>& lambda) {
+    const int n = simplex.size();
+    int  bestWhich[4], bestK = 0;
+    Vec4 bestLambda;
+    Vec3 bestPoint(NaN);
+    Real bestDist2 = Infinity;
+    for (int subset=1; subset < (1<<n); ++subset) {
+        int which[4], k = 0;
+        for (int i=0; i < n; ++i)
+            if (subset & (1<<i)) which[k++] = i;
+        Vec4 lam;
+        if (!projectOriginOnSubsimplex(simplex, which, k, lam))
+            continue;
+        Vec3 point(0);
+        for (int i=0; i < k; ++i) point += lam[i]*simplex[which[i]].w;
+        const Real dist2 = point.normSqr();
+        if (dist2 < bestDist2) {
+            bestDist2 = dist2; bestPoint = point; bestLambda = lam; bestK = k;
+            for (int i=0; i < k; ++i) bestWhich[i] = which[i];
+        }
+    }
+    assert(bestK > 0); // a single vertex always works
+
+    Array_<HullPairVertex> kept(bestK);
+    lambda.resize(bestK);
+    for (int i=0; i < bestK; ++i) {
+        kept[i] = simplex[bestWhich[i]];
+        lambda[i] = bestLambda[i];
+    }
+    simplex.swap(kept);
+    return bestPoint;
+}
+
+// Run GJK starting from the given simplex, or from the support vertex in
+// the guessed direction if the simplex is empty. Returns true if A-B contains
+// the origin (or comes within tol of it) in which case the simplex encloses
+// the origin if it has 4 vertices. Otherwise v is the point of A-B closest to
+// the origin and simplex and lambda express it.
+bool runGJK(HullPairSupport& support, const Vec3& guess, Real tol, 
+            Array_<HullPairVertex>& simplex, Array_<Real>& lambda, Vec3& v) {
+    if (simplex.empty())
+        simplex.push_back(support.find(guess));
+    for (int iter=0; iter < 64; ++iter) {
+        v = reduceSimplex(simplex, lambda);
+        const Real dist = v.norm();
+        if (simplex.size() == 4 || dist <= tol)
+            return true;
+        const HullPairVertex w = support.find(-v);
+        // Quit if the new vertex gets us no closer to the origin.
+        if (dist*dist - dot(v, w.w) <= tol*dist)
+            return false;
+        for (unsigned i=0; i < simplex.size(); ++i)
+            if (simplex[i].a == w.a && simplex[i].b == w.b)
+                return false;
+        simplex.push_back(w);
+    }
+    return false;
+}
+
+// GJK can stop with fewer than 4 vertices if the origin lies on the boundary
+// of its simplex, as happens when edges cross. Add support vertices in 
+// directions away from the simplex until it is a tetrahedron still containing
+// the origin, as EPA requires. Returns false if A-B is flat (within tol) in 
+// every direction tried, meaning the hulls are just touching.
+bool completeSimplex(HullPairSupport& support, Real tol,
+                     Array_<HullPairVertex>& simplex) {
+    while (simplex.size() < 4) {
+        const Vec3& w0 = simplex[0].w;
+        Array_<Vec3> dirs;
+        if (simplex.size() == 1) {
+            for (int i=0; i < 3; ++i) dirs.push_back(Vec3(0)), dirs.back()[i]=1;
+        } else if (simplex.size() == 2) {
+            const Vec3 e = simplex[1].w - w0;
+            for (int i=0; i < 3; ++i) {
+                Vec3 axis(0); axis[i] = 1;
+                const Vec3 d = e % axis;
+                if (d.norm() > SignificantReal*e.norm()) dirs.push_back(d);
+            }
+        } else {
+            dirs.push_back((simplex[1].w - w0) % (simplex[2].w - w0));
+        }
+
+        bool grown = false;
+        for (unsigned i=0; i < dirs.size() && !grown; ++i) {
+            for (int sign=1; sign >= -1 && !grown; sign -= 2) {
+                const HullPairVertex w = support.find(sign*dirs[i]);
+                const Vec3 r = w.w - w0;
+                Real dist;
+                if (simplex.size() == 1) dist = r.norm();
+                else if (simplex.size() == 2) {
+                    const Vec3 e = simplex[1].w - w0;
+                    dist = (r % e).norm() / e.norm();
+                } else dist = std::abs(dot(r, UnitVec3(dirs[i])));
+                if (dist > tol) {simplex.push_back(w); grown = true;}
+            }
+        }
+        if (!grown) return false;
+    }
+    return true;
+}
+
+struct EPAFace {
+    EPAFace(const Array_<HullPairVertex>& verts, int i, int j, int k)
+    :   normal((verts[j].w-verts[i].w) % (verts[k].w-verts[i].w)),
+        dist(dot(normal, verts[i].w))
+    {   v[0]=i; v[1]=j; v[2]=k; }
+
+    int         v[3];
+    UnitVec3    normal;
+    Real        dist;   // from the origin
+};
+
+// Given a simplex of 4 vertices enclosing the origin, grow it into a polytope
+// inside A-B until its face nearest the origin is on the boundary of A-B.
+// That face gives the penetration depth and normal, and the deepest point of
+// B (in A's frame) is found from the barycentric weights of its vertices.
+void runEPA(HullPairSupport& support, const Array_<HullPairVertex>& simplex, 
+            Real tol, UnitVec3& normal, Real& depth, Vec3& pointB) {
+    assert(simplex.size() == 4);
+    Array_<HullPairVertex> verts(simplex);
+    Array_<EPAFace> faces, nextFaces;
+    const int tet[4][4] = {{0,1,2,3}, {0,1,3,2}, {0,2,3,1}, {1,2,3,0}};
+    for (int f=0; f < 4; ++f) {
+        const int* t = tet[f];
+        EPAFace face(verts, t[0], t[1], t[2]);
+        if (dot(face.normal, verts[t[3]].w) > face.dist) // make it point out
+            face = EPAFace(verts, t[0], t[2], t[1]);
+        faces.push_back(face);
+    }
+
+    std::set< pair<int,int> > visibleEdges;
+    int nearest = 0;
+    for (int iter=0; iter < 100; ++iter) {
+        nearest = 0;
+        for (unsigned f=1; f < faces.size(); ++f)
+            if (faces[f].dist < faces[nearest].dist) nearest = f;
+        const EPAFace& face = faces[nearest];
+        const HullPairVertex w = support.find(face.normal);
+        if (dot(face.normal, w.w) - face.dist <= tol)
+            break; // this face is on the boundary
+        bool known = false;
+        for (unsigned i=0; i < verts.size() && !known; ++i)
+            known = (verts[i].a == w.a && verts[i].b == w.b);
+        if (known)
+            break;
+
+        // Replace the faces that can see the new vertex by a fan of faces
+        // connecting it to their horizon, as for building a convex hull.
+        verts.push_back(w);
+        const int iw = verts.size()-1;
+        nextFaces.clear(); visibleEdges.clear();
+        for (unsigned f=0; f < faces.size(); ++f) {
+            if (dot(faces[f].normal, w.w) <= faces[f].dist) {
+                nextFaces.push_back(faces[f]);
+                continue;
+            }
+            for (int k=0; k < 3; ++k)
+                visibleEdges.insert(make_pair(faces[f].v[k],
+                                              faces[f].v[(k+1)%3]));
+        }
+        std::set< pair<int,int> >::const_iterator e = visibleEdges.begin();
+        for (; e != visibleEdges.end(); ++e)
+            if (!visibleEdges.count(make_pair(e->second, e->first)))
+                nextFaces.push_back(EPAFace(verts, e->first, e->second, iw));
+        faces.swap(nextFaces);
+        nearest = -1;
+    }
+    if (nearest < 0) { // ran out of iterations; use the best we have
+        nearest = 0;
+        for (unsigned f=1; f < faces.size(); ++f)
+            if (faces[f].dist < faces[nearest].dist) nearest = f;
+    }
+
+    const EPAFace& face = faces[nearest];
+    normal = face.normal;
+    depth  = face.dist;
+
+    // Barycentric weights of the origin's projection onto the face.
+    const Vec3& w0 = verts[face.v[0]].w;
+    const Vec3 e1 = verts[face.v[1]].w - w0, e2 = verts[face.v[2]].w - w0;
+    const Vec3 p = depth*normal - w0;
+    const Real d11=dot(e1,e1), d12=dot(e1,e2), d22=dot(e2,e2);
+    const Real dp1=dot(p,e1),  dp2=dot(p,e2);
+    const Real den = d11*d22 - d12*d12;
+    Vec3 lambda(1,0,0);
+    if (den > 0) {
+        lambda[1] = (d22*dp1 - d12*dp2)/den;
+        lambda[2] = (d11*dp2 - d12*dp1)/den;
+        lambda[0] = 1 - lambda[1] - lambda[2];
+    }
+    pointB = Vec3(0);
+    for (int i=0; i < 3; ++i)
+        pointB += lambda[i]*(support.X_AB
+                    * support.hullB.getVertexPosition(verts[face.v[i]].b));
+}
+
+// Flood out from vertex start of hull F (posed in A by X_AF) over the vertices
+// whose height along dir_A is below limit, keeping those that are inside
+// hull O (posed in A by X_AO). Their positions in A and their depths below
+// limit are appended to the given arrays.
+void collectInsideVertices
+   (const ContactGeometry::ConvexHull& hullF, const Transform& X_AF, int start,
+    const UnitVec3& dir_A, Real limit,
+    const ContactGeometry::ConvexHull& hullO, const Transform& X_AO,
+    Array_<Vec3>& points_A, Array_<Real>& depths) {
+    Array_<int> toVisit(1, start);
+    std::set<int> seen; seen.insert(start);
+    while (!toVisit.empty()) {
+        const int v = toVisit.back(); toVisit.pop_back();
+        const Vec3 p_A = X_AF*hullF.getVertexPosition(v);
+        const Real depth = limit - dot(p_A, dir_A);
+        if (depth <= 0)
+            continue;
+        if (hullO.containsPoint(~X_AO*p_A))
+            points_A.push_back(p_A), depths.push_back(depth);
+        for (int i=0; i < hullF.getNumVertexNeighbors(v); ++i) {
+            const int nbr = hullF.getVertexNeighbor(v, i);
+            if (seen.insert(nbr).second)
+                toVisit.push_back(nbr);
+        }
+    }
+}
+
+}
+
+bool ContactTracker::ConvexHullPair::trackContact
+   (const Contact&         priorStatus,
+    const Transform&       X_GA, 
+    const ContactGeometry& geoA,
+    const Transform&       X_GB, 
+    const ContactGeometry& geoB,
+    Real                   cutoff,
+    Contact&               currentStatus) const
+{
+    SimTK_ASSERT
+       (   geoA.getTypeId()==ContactGeometry::ConvexHull::classTypeId()
+        && geoB.getTypeId()==ContactGeometry::ConvexHull::classTypeId(),
+       "ContactTracker::ConvexHullPair::trackContact()");
+
+    const ContactGeometry::ConvexHull& hullA =
+        ContactGeometry::ConvexHull::getAs(geoA);
+    const ContactGeometry::ConvexHull& hullB =
+        ContactGeometry::ConvexHull::getAs(geoB);
+
+    const Transform X_AB = ~X_GA * X_GB;
+    HullPairSupport support(hullA, hullB, X_AB);
+
+    Vec3 centerA, centerB; Real radiusA, radiusB;
+    geoA.getBoundingSphere(centerA, radiusA);
+    geoB.getBoundingSphere(centerB, radiusB);
+    const Real tol = SqrtEps*(radiusA+radiusB);
+
+    // Start from the simplex we ended with last time, if any.
+    Array_<HullPairVertex> simplex;
+    if (ConvexHullContact::isInstance(priorStatus)) {
+        const ConvexHullContact& prior = ConvexHullContact::getAs(priorStatus);
+        const Array_<int>& prior1 = prior.getSimplexVertices1();
+        const Array_<int>& prior2 = prior.getSimplexVertices2();
+        for (unsigned i=0; i < prior1.size(); ++i)
+            simplex.push_back(support.make(prior1[i], prior2[i]));
+        if (!simplex.empty())
+            support.lastA = prior1[0], support.lastB = prior2[0];
+    }
+    Vec3 guess = X_AB*centerB - centerA;
+    if (guess == 0) guess = Vec3(1,0,0);
+
+    Array_<Real> lambda;
+    Vec3 v;
+    const bool overlapping = runGJK(support, guess, tol, simplex, lambda, v);
+
+    Array_<int> simplex1(simplex.size()), simplex2(simplex.size());
+    for (unsigned i=0; i < simplex.size(); ++i)
+        simplex1[i] = simplex[i].a, simplex2[i] = simplex[i].b;
+
+    if (!overlapping) {
+        const Real dist = v.norm();
+        if (dist >= cutoff) {
+            currentStatus.clear(); // not touching
+            return true; // successful return
+        }
+        // Close enough to report; v = a-b points from B to A.
+        Vec3 pointB(0);
+        for (unsigned i=0; i < simplex.size(); ++i)
+            pointB += lambda[i]*(X_AB*hullB.getVertexPosition(simplex[i].b));
+        currentStatus = ConvexHullContact(priorStatus.getSurface1(),
+                                          priorStatus.getSurface2(),
+                                          X_AB, UnitVec3(-v), -dist,
+                                          Array_<Vec3>(1, pointB),
+                                          Array_<Real>(1, -dist),
+                                          simplex1, simplex2);
+        return true;
+    }
+
+    if (!completeSimplex(support, tol, simplex)) { // just touching
+        currentStatus.clear();
+        return true;
+    }
+
+    UnitVec3 normal; Real depth; Vec3 deepestB;
+    runEPA(support, simplex, tol, normal, depth, deepestB);
+    if (depth <= 0) {
+        currentStatus.clear();
+        return true;
+    }
+
+    // The contact points are the vertices of B that are inside A, measured
+    // from A's support plane along the normal, and the vertices of A that
+    // are inside B, moved down to B's support plane. 
+    Array_<Vec3> points; Array_<Real> depths;
+    const UnitVec3 nn_B = ~X_AB.R()*(-normal);
+    const int topA = hullA.findSupportVertex(normal, support.lastA);
+    const int bottomB = hullB.findSupportVertex(nn_B, support.lastB);
+    const Real heightA = dot(hullA.getVertexPosition(topA), normal);
+    const Real heightB = dot(X_AB*hullB.getVertexPosition(bottomB), normal);
+    collectInsideVertices(hullB, X_AB, bottomB, normal, heightA,
+                          hullA, Transform(), points, depths);
+    const int numFromB = points.size();
+    Array_<Vec3> pointsA; Array_<Real> depthsA;
+    collectInsideVertices(hullA, Transform(), topA, -normal, -heightB,
+                          hullB, X_AB, pointsA, depthsA);
+    for (unsigned i=0; i < pointsA.size(); ++i) {
+        const Vec3 p = pointsA[i] - depthsA[i]*normal;
+        bool duplicate = false;
+        for (int j=0; j < numFromB && !duplicate; ++j)
+            duplicate = (points[j]-p).normSqr() <= tol*tol;
+        if (!duplicate)
+            points.push_back(p), depths.push_back(depthsA[i]);
+    }
+    if (points.empty()) { // e.g. edge-edge; use the EPA point
+        points.push_back(deepestB);
+        depths.push_back(depth);
+    }
+
+    currentStatus = ConvexHullContact(priorStatus.getSurface1(),
+                                      priorStatus.getSurface2(),
+                                      X_AB, normal, depth, points, depths,
+                                      simplex1, simplex2);
+    return true;
+}
+
+
+
 //==============================================================================
 //                GENERAL IMPLICIT SURFACE PAIR CONTACT TRACKER
 //==============================================================================
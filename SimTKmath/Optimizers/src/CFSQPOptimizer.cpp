@@ -261,11 +261,10 @@ void CFSQPOptimizer::
 dpdxFunc(int nparam,int j,double *x,double *dpdx,
     void (*dummy)(int,int,double *,double *,void *),void *cd)
 {
-    // TODO; support numerical gradients
     CFSQPOptimizer *cfsqp = (CFSQPOptimizer *)cd;
     int nx=cfsqp->getOptimizerSystem().getNumParameters();
-    Vector temp(nx,dpdx,true);
-    cfsqp->getOptimizerSystem().gradientFunc(Vector(nx,x,true),true,temp);
+    // This calculates a numerical gradient if requested.
+    gradientFuncWrapper(nx,x,true,dpdx,cfsqp);
 }
 
 //______________________________________________________________________________
@@ -289,7 +288,6 @@ dcdxFunc(int nparam,int j,double *x,double *dcdx,
     void (*dummy)(int,int,double *,double *,void *),
     void *cd)
 {
-    // TODO: support numerical gradients
     CFSQPOptimizer *cfsqp = (CFSQPOptimizer *)cd;
     int nx=cfsqp->getOptimizerSystem().getNumParameters();
     int nc=cfsqp->getOptimizerSystem().getNumConstraints();
@@ -424,14 +422,14 @@ computeConstraintGradient(const SimTK::Vector &x, const bool new_coefficients, S
     }
 
     if(!cached_value_available) {
-        status = getOptimizerSystem().constraintJacobian(x,new_coefficients,_cachedConstraintJacobian);
+        status = calcConstraintJacobian(x,new_coefficients,_cachedConstraintJacobian);
         _cachedConstraintJacobianParameters.resize(nx);
         _cachedConstraintJacobianParameters = x;
     } 
     for(int col=0;col<nx;col++) dcdx[col]=_cachedConstraintJacobian(ic,col);
 #else
     SimTK::Matrix jacobian(nc,nx);
-    status = constraintJacobian(getOptimizerSystem(),x,new_coefficients,jacobian);
+    status = calcConstraintJacobian(x,new_coefficients,jacobian);
     for(int col=0;col<nx;col++) dcdx[col]=jacobian(ic,col);
 #endif
     return status;
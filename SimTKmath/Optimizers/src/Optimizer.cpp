@@ -195,6 +195,7 @@ bool Optimizer::setAdvancedVectorOption( const char *option, const Vector value
 }
 
 Real Optimizer::optimize(SimTK::Vector   &results) {
+    updRep().setDifferentiatorNumThreadsFromOptions();
     return updRep().optimize(results);
 }
 
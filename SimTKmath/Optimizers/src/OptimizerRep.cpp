@@ -125,6 +125,18 @@ setDifferentiatorMethod(Differentiator::Method method) {
      diffMethod = method;
 }
 
+void Optimizer::OptimizerRep::setDifferentiatorNumThreadsFromOptions() {
+    int numThreads = 1;
+    std::string parallel;
+    if (getAdvancedStrOption("parallel", parallel) 
+        && parallel == "multithreading") {
+        numThreads = ParallelExecutor::getNumProcessors();
+        getAdvancedIntOption("nthreads", numThreads);
+    }
+    if (gradDiff) gradDiff->setNumThreads(numThreads);
+    if (jacDiff)  jacDiff->setNumThreads(numThreads);
+}
+
 void Optimizer::OptimizerRep::
 useNumericalGradient(bool flag, Real objEstAccuracy) {
     objectiveEstimatedAccuracy = 
@@ -233,14 +245,7 @@ int Optimizer::OptimizerRep::constraintJacobianWrapper
     const Vector    params(n,x,true);   // This Vector refers to existing space 
     Matrix          jac(m,n);           // This is a new local temporary. TODO: get rid of this
 
-    int status = -1;
-    if( rep->isUsingNumericalJacobian() ) {
-        Vector sfy0(m);            
-        status = rep->getOptimizerSystem().constraintFunc(params, true, sfy0);
-        rep->getJacobianDifferentiator().calcJacobian( params, sfy0, jac);
-    } else {
-        status = rep->getOptimizerSystem().constraintJacobian(params, isNewParam, jac);
-    }
+    const int status = rep->calcConstraintJacobian(params, isNewParam, jac);
 
     // Transpose the jacobian because Ipopt indexes in Row major format.
     Real *ptr = values;
@@ -251,6 +256,19 @@ int Optimizer::OptimizerRep::constraintJacobianWrapper
     return (status==0) ? 1 : 0;
 }
 
+int Optimizer::OptimizerRep::calcConstraintJacobian
+   (const Vector& params, bool isNewParam, Matrix& jac) const
+{
+    if (isUsingNumericalJacobian()) {
+        Vector sfy0(getOptimizerSystem().getNumConstraints());
+        const int status = 
+            getOptimizerSystem().constraintFunc(params, true, sfy0);
+        getJacobianDifferentiator().calcJacobian(params, sfy0, jac);
+        return status;
+    }
+    return getOptimizerSystem().constraintJacobian(params, isNewParam, jac);
+}
+
 // TODO finish hessianWrapper
 int Optimizer::OptimizerRep::hessianWrapper
    (int n, const Real* x, int newX, Real obj_factor,
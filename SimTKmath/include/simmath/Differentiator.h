@@ -73,6 +73,21 @@ namespace SimTK {
  * Then the derivative, gradient element, or Jacobian column is computed 
  * as df/dy=[f(x+h)-f(x)]/h (1st order) or df/dy=[f(x+h)-f(x-h)]/(2h) 
  * (2nd order).
+ *
+ * @par Faster Jacobians
+ *
+ * Normally each parameter is perturbed separately, so a Jacobian costs one
+ * function evaluation per parameter (two for central differences). If you
+ * know which entries of the Jacobian can be nonzero, give that sparsity
+ * pattern to setJacobianSparsityPattern(). Columns that have no nonzero rows
+ * in common are then perturbed together (the Curtis-Powell-Reid method), so 
+ * for example a banded Jacobian of bandwidth b costs about 2b+1 evaluations
+ * no matter how many parameters there are.
+ *
+ * The perturbed evaluations are independent of one another so they can also
+ * be done concurrently. Use setNumThreads() to allow that; it takes effect
+ * only for a GradientFunction or JacobianFunction that overrides clone(), 
+ * since each thread needs its own copy of the function.
  */
 class SimTK_SIMMATH_EXPORT Differentiator {
 public:
@@ -123,6 +138,34 @@ public:
     Vector calcGradient  (const Vector& y0, Method=UnspecifiedMethod) const;
     Matrix calcJacobian  (const Vector& y0, Method=UnspecifiedMethod) const;
 
+    /** Allow calcGradient() and calcJacobian() to evaluate the function at
+    the perturbed points on up to \a numThreads threads. This has no effect
+    unless the function overrides clone() to provide a separate copy for
+    each thread; those copies are created the first time they are needed.
+    Calling this discards any copies already made, even if \a numThreads is
+    unchanged, so call it again if the function changes in a way its copies
+    wouldn't see. The results are identical to serial evaluation. The default
+    is 1, meaning no parallelism. **/
+    Differentiator& setNumThreads(int numThreads);
+    int             getNumThreads() const;
+
+    /** Specify which entries of the Jacobian calculated by calcJacobian() 
+    might be nonzero; the rest will be set to exactly zero without being
+    computed. \a rowsInColumn has one entry per parameter; entry j lists 
+    the indices of the functions whose value may depend on parameter j. We
+    group together columns that have no rows in common and perturb each
+    group's parameters simultaneously, so the number of function evaluations
+    is the number of groups rather than the number of parameters. **/
+    Differentiator& setJacobianSparsityPattern
+                        (const Array_< Array_<int> >& rowsInColumn);
+    /** Go back to treating the Jacobian as dense. **/
+    Differentiator& clearJacobianSparsityPattern();
+    bool            hasJacobianSparsityPattern() const;
+    /** Return the number of groups of columns that are perturbed together
+    when calculating a Jacobian. This is the number of parameters unless a
+    sparsity pattern has been set. **/
+    int             getNumJacobianColumnGroups() const;
+
     // Statistics (mutable)
     void resetAllStatistics();                 // reset all stats to zero
     int getNumDifferentiations() const;        // total # calls of calcWhatever
@@ -169,7 +212,7 @@ public:
     class FunctionRep;
 protected:
     Function();
-    ~Function();
+    virtual ~Function();
 
     // opaque implementation for binary compatibility
     FunctionRep* rep;
@@ -209,6 +252,14 @@ class SimTK_SIMMATH_EXPORT Differentiator::GradientFunction : public Differentia
 public:
     virtual int f(const Vector& y, Real& fy) const=0;
 
+    /** Override this to allow a Differentiator to evaluate this function on
+    several threads at once (see Differentiator::setNumThreads()). Return a
+    new heap-allocated copy of this function whose f() may be called
+    concurrently with this one's and with those of other copies. The
+    Differentiator takes over ownership of the copy. The default returns 
+    null, meaning the function must be evaluated serially. **/
+    virtual GradientFunction* clone() const {return nullptr;}
+
 protected:
     explicit GradientFunction(int ny=-1, Real acc=-1);
     virtual ~GradientFunction() { }
@@ -228,6 +279,10 @@ class SimTK_SIMMATH_EXPORT Differentiator::JacobianFunction : public Differentia
 public:
     virtual int f(const Vector& y, Vector& fy) const=0;
 
+    /** Override this to allow a Differentiator to evaluate this function on
+    several threads at once; see GradientFunction::clone() for details. **/
+    virtual JacobianFunction* clone() const {return nullptr;}
+
 protected:
     explicit JacobianFunction(int nf=-1, int ny=-1, Real acc=-1); 
     virtual ~JacobianFunction() { }
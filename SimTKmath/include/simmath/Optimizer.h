@@ -85,6 +85,21 @@ public:
         setNumParameters(nParameters);
     }
 
+    /// Copy constructor makes a deep copy of the parameter limits.
+    OptimizerSystem(const OptimizerSystem& source) {copyFrom(source);}
+
+    /// Copy assignment makes a deep copy of the parameter limits.
+    OptimizerSystem& operator=(const OptimizerSystem& source) {
+        if (&source != this) {
+            if( useLimits ) {
+                delete lowerLimits;
+                delete upperLimits;
+            }
+            copyFrom(source);
+        }
+        return *this;
+    }
+
     virtual ~OptimizerSystem() {
         if( useLimits ) {
             delete lowerLimits;
@@ -92,6 +107,22 @@ public:
         }
     }
 
+    /// Return a new heap-allocated copy of this %OptimizerSystem whose 
+    /// objectiveFunc() and constraintFunc() may be called concurrently with
+    /// this one's. Override this to allow numerical gradients and Jacobians
+    /// to be calculated on several threads, with a separate copy for each
+    /// thread; see the <b>parallel</b> option of Optimizer. The caller takes
+    /// over ownership of the copy. The default returns null, in which case
+    /// numerical derivatives are always calculated serially.
+    ///
+    /// Each call to Optimizer::optimize() makes its copies afresh, one per
+    /// thread, the first time it calculates a numerical derivative, so any
+    /// change made to this system between optimizations is seen by the 
+    /// copies. The copies are deleted at the start of the next optimize() or
+    /// when the Optimizer is destroyed. Changes made to this system during an
+    /// optimization are not seen by the copies.
+    virtual OptimizerSystem* clone() const {return nullptr;}
+
     /// Objective/cost function which is to be optimized; return 0 when successful.
     /// The value of f upon entry into the function is undefined.
     /// This method must be supplied by concrete class.
@@ -232,6 +263,18 @@ public:
    }
 
 private:
+   // The limits must already have been freed.
+   void copyFrom(const OptimizerSystem& source) {
+       numParameters = source.numParameters;
+       numEqualityConstraints = source.numEqualityConstraints;
+       numInequalityConstraints = source.numInequalityConstraints;
+       numLinearEqualityConstraints = source.numLinearEqualityConstraints;
+       numLinearInequalityConstraints = source.numLinearInequalityConstraints;
+       useLimits = source.useLimits;
+       lowerLimits = useLimits ? new Vector(*source.lowerLimits) : 0;
+       upperLimits = useLimits ? new Vector(*source.upperLimits) : 0;
+   }
+
    int numParameters;
    int numEqualityConstraints;
    int numInequalityConstraints;
@@ -278,6 +321,22 @@ private:
  *
  * For now, we only have detailed documentation for the CMAES algorithm.
  *
+ * <h4> Numerical derivatives </h4>
+ *
+ * After useNumericalGradient() or useNumericalJacobian(), the gradient-based
+ * algorithms (InteriorPoint, LBFGS, LBFGSB, and CFSQP) approximate the
+ * derivatives by finite differences, calling OptimizerSystem::objectiveFunc()
+ * or OptimizerSystem::constraintFunc() once or twice per parameter. Those 
+ * calls can be spread over several threads with the same advanced options
+ * that CMAES uses:
+ * - <b>parallel</b> (str) Set this to "multithreading" to evaluate the 
+ *   perturbed parameters concurrently. This has no effect unless your
+ *   OptimizerSystem overrides OptimizerSystem::clone(); each thread uses its
+ *   own copy of the system. The derivatives are identical to those calculated
+ *   serially.
+ * - <b>nthreads</b> (int) The number of threads to use (by default, this is
+ *   the number of processors/threads on the machine).
+ *
  * <h4> CMAES </h4>
  *
  * This is the c-cmaes algorithm written by Niko Hansen
@@ -28,6 +28,7 @@
 #include "simmath/Optimizer.h"
 #include "simmath/Differentiator.h"
 #include <map>
+#include <memory>
 
 namespace SimTK {
 
@@ -42,7 +43,21 @@ public:
     int f(const Vector& y, Real& fy) const override  {
          return(sysp->objectiveFunc(y, true, fy));   // class user's objectiveFunc
     }
+
+    // Each thread calculating a numerical gradient uses its own clone of
+    // the OptimizerSystem, if the user's system can be cloned.
+    SysObjectiveFunc* clone() const override {
+        OptimizerSystem* sysCopy = sysp->clone();
+        if (!sysCopy) return nullptr;
+        SysObjectiveFunc* copy = 
+            new SysObjectiveFunc(getNumParameters(), sysCopy);
+        copy->ownSys.reset(sysCopy);
+        copy->setEstimatedAccuracy(getEstimatedAccuracy());
+        return copy;
+    }
+
     const OptimizerSystem* sysp;
+    std::unique_ptr<const OptimizerSystem> ownSys; // only set in clones
 };
 
 
@@ -56,7 +71,20 @@ class SysConstraintFunc : public Differentiator::JacobianFunction {
     int f(const Vector& y, Vector& fy) const override  {
        return(sysp->constraintFunc(y, true, fy));  // calls user's contraintFunc
     }
+
+    // See SysObjectiveFunc::clone().
+    SysConstraintFunc* clone() const override {
+        OptimizerSystem* sysCopy = sysp->clone();
+        if (!sysCopy) return nullptr;
+        SysConstraintFunc* copy = new SysConstraintFunc
+           (getNumFunctions(), getNumParameters(), sysCopy);
+        copy->ownSys.reset(sysCopy);
+        copy->setEstimatedAccuracy(getEstimatedAccuracy());
+        return copy;
+    }
+
     const OptimizerSystem* sysp;
+    std::unique_ptr<const OptimizerSystem> ownSys; // only set in clones
 };
 
 
@@ -136,6 +164,11 @@ public:
     void useNumericalGradient(bool flag, Real objEstAccuracy); 
     void useNumericalJacobian(bool flag, Real consEstAccuracy);  
     void setDifferentiatorMethod( Differentiator::Method method);
+    // Set the number of threads used by the numerical differentiators from
+    // the "parallel" and "nthreads" advanced options. This also discards the
+    // differentiators' clones of the OptimizerSystem, so that each call to
+    // optimize() clones the system as it is then.
+    void setDifferentiatorNumThreadsFromOptions();
 
     bool isUsingNumericalGradient() const { return numericalGradient; }
     bool isUsingNumericalJacobian() const { return numericalJacobian; }
@@ -179,6 +212,11 @@ protected:
                                 int nele_hess, int* iRow, int* jCol,
                                 Real* values, void* rep);
 
+    // Calculate the (dense) constraint Jacobian, numerically if requested.
+    // Returns the status from the OptimizerSystem, 0 if successful.
+    int calcConstraintJacobian(const Vector& params, bool isNewParam, 
+                               Matrix& jac) const;
+
     int diagnosticsLevel;
     Real convergenceTolerance;
     Real constraintTolerance;
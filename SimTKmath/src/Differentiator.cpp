@@ -30,6 +30,9 @@
 #include "simmath/Differentiator.h"
 
 #include <exception>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace SimTK {
 
@@ -120,7 +123,8 @@ public:
     DifferentiatorRep(Differentiator* handle,
                       const Differentiator::Function::FunctionRep&,
                       Differentiator::Method defaultMethod);
-    // default destructor, no default constructor, no copy or copy assign
+    ~DifferentiatorRep() {deleteClones();}
+    // no default constructor, no copy or copy assign
 
     // This constant is the algorithm we'll use by default.
     static const Differentiator::Method DefaultDefaultMethod 
@@ -144,6 +148,18 @@ public:
         nDifferentiations = nDifferentiationFailures = nCallsToUserFunction = 0;
     }
 
+    void setNumThreads(int n) {
+        deleteClones();
+        if (n == numThreads) return;
+        numThreads = n;
+        executor.reset();
+    }
+
+    void setJacobianSparsityPattern(const Array_< Array_<int> >& rowsInCol);
+    void clearJacobianSparsityPattern() 
+    {   rowsInColumn.clear(); columnGroups.clear(); }
+    bool hasJacobianSparsityPattern() const {return !columnGroups.empty();}
+
     // Statistics
     mutable int nDifferentiations; 
     mutable int nDifferentiationFailures; 
@@ -172,6 +188,30 @@ private:
     // The *values* do not persist across calls.
     mutable Vector ytmp;           // [NParameters]
     mutable Vector fyptmp, fymtmp; // [NFunctions]
+    mutable Vector htmp;           // [NParameters] perturbation sizes
+
+    // Optional sparsity pattern for the Jacobian, and the groups of columns
+    // with no rows in common which we perturb together. Both are empty if 
+    // the Jacobian is dense.
+    Array_< Array_<int> > rowsInColumn; // [NParameters]
+    Array_< Array_<int> > columnGroups;
+
+    // Parallel evaluation of perturbations. The executor and the clones of
+    // the user's function (one per thread) are created when first needed.
+    int                                         numThreads;
+    mutable std::unique_ptr<ParallelExecutor>   executor;
+    mutable Array_<Differentiator::Function*>   clones;
+
+    // Call evalGroup() for each group of parameters that are perturbed
+    // together, serially or in parallel; see below.
+    template <class FRep, class EvalGroup>
+    void evaluateGroups(const FRep& f, const Vector& y0, int numGroups,
+                        const EvalGroup& evalGroup) const;
+    bool createClones() const;
+    void deleteClones() const {
+        for (unsigned i=0; i < clones.size(); ++i) delete clones[i];
+        clones.clear();
+    }
 
     // suppress
     DifferentiatorRep(const DifferentiatorRep&);
@@ -221,6 +261,15 @@ public:
         nCalls = nFailures = 0;
     }
 
+    // Accumulate the statistics from a clone used on another thread.
+    void addStatistics(const FunctionRep& other) const {
+        nCalls += other.nCalls; nFailures += other.nFailures;
+    }
+
+    // Return a new copy of the user's function for use on another thread,
+    // or null if the function doesn't support that.
+    virtual Differentiator::Function* cloneFunction() const {return 0;}
+
 protected:
     // Stats
     mutable int nCalls;
@@ -302,6 +351,8 @@ public:
 
     // Virtuals (from FunctionRep)
     String functionKind() const override {return "GradientFunction";}
+    Differentiator::Function* cloneFunction() const override 
+    {   return gf.clone(); }
 
     void calcDerivative(const Differentiator::DifferentiatorRep& diff, Differentiator::Method m,
                         Real y0, const Real* fy0p, Real& dfdy) const override
@@ -368,6 +419,8 @@ public:
 
     // Virtuals (from FunctionRep)
     String functionKind() const override {return "JacobianFunction";}
+    Differentiator::Function* cloneFunction() const override 
+    {   return jf.clone(); }
 
     void calcDerivative(const Differentiator::DifferentiatorRep& diff, Differentiator::Method m,
                         Real y0, const Real* fy0p, Real& dfdy) const override
@@ -451,6 +504,50 @@ Differentiator::Method Differentiator::getDefaultMethod() const {
     return rep->defaultMethod;
 }
 
+Differentiator& Differentiator::setNumThreads(int numThreads) {
+    SimTK_APIARGCHECK1_ALWAYS(numThreads>=1, "Differentiator", "setNumThreads",
+        "The number of threads was %d but must be at least 1", numThreads);
+    rep->setNumThreads(numThreads);
+    return *this;
+}
+
+int Differentiator::getNumThreads() const {
+    return rep->numThreads;
+}
+
+Differentiator& Differentiator::setJacobianSparsityPattern
+   (const Array_< Array_<int> >& rowsInColumn) 
+{
+    SimTK_APIARGCHECK2_ALWAYS((int)rowsInColumn.size()==rep->NParameters,
+        "Differentiator", "setJacobianSparsityPattern",
+        "Expecting a list of rows for each of the %d parameters but got %d",
+        rep->NParameters, (int)rowsInColumn.size());
+    for (int j=0; j < (int)rowsInColumn.size(); ++j)
+        for (unsigned k=0; k < rowsInColumn[j].size(); ++k) {
+            const int i = rowsInColumn[j][k];
+            SimTK_APIARGCHECK3_ALWAYS(0<=i && i<rep->NFunctions,
+                "Differentiator", "setJacobianSparsityPattern",
+                "Row %d listed for column %d is not a valid function index;"
+                " there are %d functions", i, j, rep->NFunctions);
+        }
+    rep->setJacobianSparsityPattern(rowsInColumn);
+    return *this;
+}
+
+Differentiator& Differentiator::clearJacobianSparsityPattern() {
+    rep->clearJacobianSparsityPattern();
+    return *this;
+}
+
+bool Differentiator::hasJacobianSparsityPattern() const {
+    return rep->hasJacobianSparsityPattern();
+}
+
+int Differentiator::getNumJacobianColumnGroups() const {
+    return rep->hasJacobianSparsityPattern() ? (int)rep->columnGroups.size()
+                                             : rep->NParameters;
+}
+
 void Differentiator::calcDerivative
    (Real y0, Real fy0, Real& dfdy, Differentiator::Method m) const 
 {
@@ -687,7 +784,8 @@ Differentiator::DifferentiatorRep::DifferentiatorRep
     EstimatedAccuracy(fr.getEstimatedAccuracy()),
     defaultMethod(getMethodOrThrow(defMthd, DefaultDefaultMethod, "Differentiator")),
     AccFac1(std::sqrt(EstimatedAccuracy)),
-    AccFac2(std::pow(EstimatedAccuracy, OneThird))
+    AccFac2(std::pow(EstimatedAccuracy, OneThird)),
+    numThreads(1)
 {
     //TODO
     assert(NParameters >= 0 && NFunctions >= 0 && EstimatedAccuracy > 0);
@@ -696,6 +794,154 @@ Differentiator::DifferentiatorRep::DifferentiatorRep
     ytmp.resize(NParameters);
     fyptmp.resize(NFunctions);
     fymtmp.resize(NFunctions);
+    htmp.resize(NParameters);
+}
+
+// Partition the columns into groups such that no two columns in a group have
+// a nonzero in the same row, using the greedy sequential method of Curtis, 
+// Powell, and Reid. Each column goes in the lowest-numbered group that has no
+// conflict with it. For a banded matrix of bandwidth b this produces 2b+1 
+// groups.
+void Differentiator::DifferentiatorRep::setJacobianSparsityPattern
+   (const Array_< Array_<int> >& rowsInCol) 
+{
+    rowsInColumn = rowsInCol;
+    columnGroups.clear();
+
+    Array_< Array_<int> > columnsInRow(NFunctions);
+    for (int j=0; j < NParameters; ++j)
+        for (unsigned k=0; k < rowsInColumn[j].size(); ++k)
+            columnsInRow[rowsInColumn[j][k]].push_back(j);
+
+    Array_<int> groupOf(NParameters, -1);
+    // groupConflict[g]==j means group g already contains a column that 
+    // shares a row with column j.
+    Array_<int> groupConflict;
+    for (int j=0; j < NParameters; ++j) {
+        for (unsigned k=0; k < rowsInColumn[j].size(); ++k) {
+            const Array_<int>& cols = columnsInRow[rowsInColumn[j][k]];
+            for (unsigned c=0; c < cols.size(); ++c)
+                if (groupOf[cols[c]] >= 0) groupConflict[groupOf[cols[c]]] = j;
+        }
+        int g = 0;
+        while (g < (int)columnGroups.size() && groupConflict[g] == j) 
+            ++g;
+        if (g == (int)columnGroups.size()) {
+            columnGroups.push_back(Array_<int>());
+            groupConflict.push_back(-1);
+        }
+        groupOf[j] = g;
+        columnGroups[g].push_back(j);
+    }
+}
+
+// Make sure we have a clone of the user's function for each thread. Returns
+// false if the function can't be cloned, in which case we must run serially.
+bool Differentiator::DifferentiatorRep::createClones() const {
+    while ((int)clones.size() < numThreads) {
+        Differentiator::Function* clone = frep.cloneFunction();
+        if (!clone) return false;
+        clones.push_back(clone);
+        SimTK_ERRCHK4_ALWAYS(
+               clone->getNumFunctions() == NFunctions 
+            && clone->getNumParameters() == NParameters,
+            "Differentiator", "The clone of a %dx%d function to be"
+            " differentiated had dimensions %dx%d.", NFunctions, NParameters,
+            clone->getNumFunctions(), clone->getNumParameters());
+    }
+    return true;
+}
+
+namespace {
+// Each thread evaluating perturbations needs its own copy of the function
+// and its own temporaries.
+struct PerturbationWorkspace {
+    Vector  y, fyp, fym;
+    int     nCalls;
+};
+
+// This is the ParallelExecutor task for evaluating perturbation groups. A
+// free workspace is claimed for each group; there are as many workspaces as
+// threads so one is always available.
+template <class FRep, class EvalGroup>
+class PerturbationTask : public ParallelExecutor::Task {
+public:
+    PerturbationTask(const Array_<const FRep*>& reps,
+                     std::vector<PerturbationWorkspace>& workspaces,
+                     const EvalGroup& evalGroup)
+    :   reps(reps), workspaces(workspaces), evalGroup(evalGroup) {
+        for (int w=(int)workspaces.size()-1; w >= 0; --w)
+            freeWorkspaces.push_back(w);
+    }
+
+    void execute(int group) override {
+        int w;
+        {   std::lock_guard<std::mutex> lock(mutex);
+            w = freeWorkspaces.back(); freeWorkspaces.pop_back(); }
+        PerturbationWorkspace& ws = workspaces[w];
+        try {
+            evalGroup(*reps[w], group, ws.y, ws.fyp, ws.fym, ws.nCalls);
+        } catch (...) {
+            release(w);
+            throw;
+        }
+        release(w);
+    }
+
+private:
+    void release(int w) {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeWorkspaces.push_back(w);
+    }
+
+    const Array_<const FRep*>&          reps;
+    std::vector<PerturbationWorkspace>& workspaces;
+    const EvalGroup&                    evalGroup;
+    std::mutex                          mutex;
+    std::vector<int>                    freeWorkspaces;
+};
+}
+
+// Evaluate each of the numGroups groups of simultaneously-perturbed 
+// parameters by calling
+//     evalGroup(f, group, y, fyp, fym, nCalls)
+// which must leave y==y0 on return, use fyp and fym as temporaries, and 
+// increment nCalls for each call it makes to the function f. If we've been
+// asked to use multiple threads and the function can be cloned, the groups
+// are evaluated in parallel with each thread using its own clone of f and 
+// its own temporaries. Otherwise this is just a loop.
+template <class FRep, class EvalGroup> void
+Differentiator::DifferentiatorRep::evaluateGroups
+   (const FRep& f, const Vector& y0, int numGroups, 
+    const EvalGroup& evalGroup) const
+{
+    if (numThreads <= 1 || numGroups <= 1 || !createClones()) {
+        ytmp = y0;
+        for (int g=0; g < numGroups; ++g)
+            evalGroup(f, g, ytmp, fyptmp, fymtmp, nCallsToUserFunction);
+        return;
+    }
+
+    Array_<const FRep*> reps(numThreads);
+    std::vector<PerturbationWorkspace> workspaces(numThreads);
+    for (int t=0; t < numThreads; ++t) {
+        reps[t] = static_cast<const FRep*>(clones[t]->rep);
+        workspaces[t].y = y0;
+        workspaces[t].fyp.resize(NFunctions);
+        workspaces[t].fym.resize(NFunctions);
+        workspaces[t].nCalls = 0;
+    }
+
+    if (!executor) executor.reset(new ParallelExecutor(numThreads));
+    PerturbationTask<FRep,EvalGroup> task(reps, workspaces, evalGroup);
+    executor->executeAndRethrow(task, numGroups);
+
+    // Fold the clones' statistics into the original function's.
+    for (int t=0; t < numThreads; ++t) {
+        nCallsToUserFunction += workspaces[t].nCalls;
+        frep.addStatistics(*clones[t]->rep);
+        clones[t]->resetAllStatistics();
+    }
 }
 
 void Differentiator::DifferentiatorRep::calcDerivative
@@ -736,24 +982,30 @@ void Differentiator::DifferentiatorRep::calcGradient
 
     gradf.resize(NParameters);
 
-    ytmp = y0;
     const int order = Differentiator::getMethodOrder(method);
-
-    for (int i=0; i < f.getNumParameters(); ++i) {
+    for (int i=0; i < NParameters; ++i) {
         const Real hEst = getAccFac(order)*std::max(std::abs(y0[i]), YMin);
-        const Real h = cleanUpH(hEst, y0[i]);
+        htmp[i] = cleanUpH(hEst, y0[i]);
+    }
+
+    // Each parameter is perturbed separately.
+    const Vector& h = htmp;
+    const auto evalGroup = [&](const GradientFunctionRep& fr, int i, 
+                               Vector& y, Vector&, Vector&, int& nCalls) 
+    {
         Real fyplus, fyminus;
-        ytmp[i] = y0[i]+h; 
-        nCallsToUserFunction++; f.call(ytmp, fyplus);
+        y[i] = y0[i]+h[i]; 
+        nCalls++; fr.call(y, fyplus);
         if (order==1) {
-            gradf[i] = (fyplus-fy0)/h;
+            gradf[i] = (fyplus-fy0)/h[i];
         } else {
-            ytmp[i] = y0[i]-h; 
-            nCallsToUserFunction++; f.call(ytmp, fyminus);
-            gradf[i] = (fyplus-fyminus)/(2*h);
+            y[i] = y0[i]-h[i]; 
+            nCalls++; fr.call(y, fyminus);
+            gradf[i] = (fyplus-fyminus)/(2*h[i]);
         }
-        ytmp[i] = y0[i]; // restore
-    }
+        y[i] = y0[i]; // restore
+    };
+    evaluateGroups(f, y0, NParameters, evalGroup);
 }
 
 void Differentiator::DifferentiatorRep::calcJacobian
@@ -771,22 +1023,49 @@ void Differentiator::DifferentiatorRep::calcJacobian
     dfdy.resize(NFunctions,NParameters);
 
     const int order = Differentiator::getMethodOrder(method);
+    for (int j=0; j < NParameters; ++j) {
+        const Real hEst = getAccFac(order)*std::max(std::abs(y0[j]), YMin);
+        htmp[j] = cleanUpH(hEst, y0[j]);
+    }
 
-    ytmp = y0;
-    for (int i=0; i < NParameters; ++i) {
-        const Real hEst = getAccFac(order)*std::max(std::abs(y0[i]), YMin);
-        const Real h = cleanUpH(hEst, y0[i]);
-        ytmp[i] = y0[i]+h; 
-        nCallsToUserFunction++; f.call(ytmp, fyptmp);
-        if (order==1) {
-            dfdy(i) = (fyptmp-fy0)/h;
-        } else {
-            ytmp[i] = y0[i]-h; 
-            nCallsToUserFunction++; f.call(ytmp, fymtmp);
-            dfdy(i) = (fyptmp-fymtmp)/(2*h);
+    // Without a sparsity pattern each column is its own group and every
+    // entry is calculated. Otherwise all the columns in a group are 
+    // perturbed at once, and only the entries in the pattern are filled in.
+    const bool isSparse = hasJacobianSparsityPattern();
+    if (isSparse) dfdy.setToZero();
+    const int numGroups = isSparse ? (int)columnGroups.size() : NParameters;
+
+    const Vector& h = htmp;
+    const auto evalGroup = [&](const JacobianFunctionRep& fr, int g, 
+                               Vector& y, Vector& fyp, Vector& fym, 
+                               int& nCalls) 
+    {
+        const int* cols = isSparse ? columnGroups[g].begin() : &g;
+        const int  ncols = isSparse ? (int)columnGroups[g].size() : 1;
+
+        for (int c=0; c < ncols; ++c) 
+            y[cols[c]] = y0[cols[c]]+h[cols[c]];
+        nCalls++; fr.call(y, fyp);
+        if (order==2) {
+            for (int c=0; c < ncols; ++c) 
+                y[cols[c]] = y0[cols[c]]-h[cols[c]];
+            nCalls++; fr.call(y, fym);
         }
-        ytmp[i] = y0[i]; // restore
-    }
+        for (int c=0; c < ncols; ++c) 
+            y[cols[c]] = y0[cols[c]]; // restore
+
+        for (int c=0; c < ncols; ++c) {
+            const int j = cols[c];
+            const int nrows = isSparse ? (int)rowsInColumn[j].size() 
+                                       : NFunctions;
+            for (int r=0; r < nrows; ++r) {
+                const int i = isSparse ? rowsInColumn[j][r] : r;
+                dfdy(i,j) = order==1 ? (fyp[i]-fy0[i])/h[j]
+                                     : (fyp[i]-fym[i])/(2*h[j]);
+            }
+        }
+    };
+    evaluateGroups(f, y0, numGroups, evalGroup);
 }
 
 } // namespace SimTK
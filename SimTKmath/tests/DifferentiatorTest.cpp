@@ -27,6 +27,7 @@
  */
 
 #include "SimTKmath.h"
+#include "SimTKcommon/Testing.h"
 
 // Just so we can get the version number:
 #include "SimTKlapack.h"
@@ -38,6 +39,7 @@ using SimTK::Real;
 using SimTK::Vector;
 using SimTK::Matrix;
 using SimTK::Differentiator;
+using SimTK::Array_;
 using std::printf;
 using std::cout;
 using std::endl;
@@ -191,6 +193,112 @@ static void doSinOmegaExample() {
 };
 
 
+// A tridiagonal system f_i = y_{i-1}*y_i + sin(y_{i+1}), that can be
+// cloned for parallel evaluation.
+class TridiagonalFunc : public Differentiator::JacobianFunction {
+public:
+    explicit TridiagonalFunc(int n) 
+    :   Differentiator::JacobianFunction(n,n) { }
+
+    int f(const Vector& y, Vector& fy) const override {
+        const int n = y.size();
+        for (int i=0; i < n; ++i)
+            fy[i] = (i>0 ? y[i-1]*y[i] : y[i]) + (i<n-1 ? std::sin(y[i+1]) : 0);
+        return 0;
+    }
+    TridiagonalFunc* clone() const override 
+    {   return new TridiagonalFunc(getNumFunctions()); }
+
+    Matrix exactJacobian(const Vector& y) const {
+        const int n = y.size();
+        Matrix J(n,n); J = 0;
+        for (int i=0; i < n; ++i) {
+            if (i>0) {J(i,i-1) = y[i]; J(i,i) = y[i-1];}
+            else J(i,i) = 1;
+            if (i<n-1) J(i,i+1) = std::cos(y[i+1]);
+        }
+        return J;
+    }
+};
+
+// Sum of squares of the tridiagonal functions, for testing gradients.
+class TridiagonalNormFunc : public Differentiator::GradientFunction {
+public:
+    explicit TridiagonalNormFunc(int n) 
+    :   Differentiator::GradientFunction(n), tri(n) { }
+
+    int f(const Vector& y, Real& fy) const override {
+        Vector fv(y.size());
+        tri.f(y, fv);
+        fy = fv.normSqr();
+        return 0;
+    }
+    TridiagonalNormFunc* clone() const override 
+    {   return new TridiagonalNormFunc(getNumParameters()); }
+private:
+    TridiagonalFunc tri;
+};
+
+// Check that sparse and parallel Jacobians agree with the plain ones, and 
+// that the sparsity pattern reduces the number of function evaluations.
+static void testSparseAndParallel() {
+    const int n = 50;
+    TridiagonalFunc tri(n);
+    Vector y0(n);
+    for (int i=0; i < n; ++i) y0[i] = 1 + 0.1*i;
+    Vector fy0(n);
+    tri.f(y0, fy0);
+    const Matrix exact = tri.exactJacobian(y0);
+
+    Differentiator dense(tri);
+    Matrix denseJ;
+    dense.calcJacobian(y0, fy0, denseJ, Differentiator::CentralDifference);
+    SimTK_TEST_EQ_TOL(denseJ, exact, 1e-8);
+    SimTK_TEST(dense.getNumCallsToUserFunction() == 2*n);
+
+    Array_< Array_<int> > pattern(n);
+    for (int j=0; j < n; ++j)
+        for (int i=std::max(j-1,0); i <= std::min(j+1,n-1); ++i)
+            pattern[j].push_back(i);
+    Differentiator sparse(tri);
+    sparse.setJacobianSparsityPattern(pattern);
+    SimTK_TEST(sparse.hasJacobianSparsityPattern());
+    SimTK_TEST(sparse.getNumJacobianColumnGroups() == 3);
+    Matrix sparseJ;
+    sparse.calcJacobian(y0, fy0, sparseJ, Differentiator::CentralDifference);
+    SimTK_TEST(sparse.getNumCallsToUserFunction() == 2*3);
+    SimTK_TEST_EQ_TOL(sparseJ, exact, 1e-8);
+
+    // Parallel evaluation must give exactly the same answers.
+    for (int threads=2; threads <= 4; threads += 2) {
+        Differentiator parallel(tri);
+        parallel.setNumThreads(threads);
+        SimTK_TEST(parallel.getNumThreads() == threads);
+        Matrix parallelJ;
+        tri.resetAllStatistics();
+        parallel.calcJacobian(y0, fy0, parallelJ, 
+                              Differentiator::CentralDifference);
+        SimTK_TEST((parallelJ - denseJ).normRMS() == 0);
+        SimTK_TEST(parallel.getNumCallsToUserFunction() == 2*n);
+        SimTK_TEST(tri.getNumCalls() == 2*n);
+
+        parallel.setJacobianSparsityPattern(pattern);
+        parallel.calcJacobian(y0, fy0, parallelJ, 
+                              Differentiator::CentralDifference);
+        SimTK_TEST((parallelJ - sparseJ).normRMS() == 0);
+    }
+    sparse.clearJacobianSparsityPattern();
+    SimTK_TEST(sparse.getNumJacobianColumnGroups() == n);
+
+    TridiagonalNormFunc norm(n);
+    Differentiator serialGrad(norm), parallelGrad(norm);
+    parallelGrad.setNumThreads(3);
+    const Vector grad1 = serialGrad.calcGradient(y0);
+    const Vector grad2 = parallelGrad.calcGradient(y0);
+    SimTK_TEST((grad1 - grad2).normRMS() == 0);
+    SimTK_TEST_EQ_TOL(grad1, 2*(~exact*fy0), 1e-5);
+}
+
 static Real mysin(Real x) {
     return std::sin(x);
 }
@@ -225,6 +333,8 @@ int main() {
 
     int returnValue = 0; // assume success
   try {
+    testSparseAndParallel();
+
     gradf.setDefaultMethod(Differentiator::ForwardDifference);
     df.setDefaultMethod(Differentiator::UnspecifiedMethod);
 
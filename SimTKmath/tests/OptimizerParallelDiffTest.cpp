@@ -0,0 +1,246 @@
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Numerical gradients and constraint Jacobians can be calculated on several
+threads if the OptimizerSystem can be cloned. The threads must not change the
+answer: each perturbed function evaluation is the same whichever thread does
+it, so the serial and parallel optimizations should agree exactly. */
+
+#include "SimTKmath.h"
+
+#include <atomic>
+#include <iostream>
+using std::cout; using std::endl;
+
+using namespace SimTK;
+
+static std::atomic<int> numClones(0);
+
+// Extended Rosenbrock function; the minimum is at (1,1,...,1).
+class Rosenbrock : public OptimizerSystem {
+public:
+    Rosenbrock(int n, bool clonable)
+    :   OptimizerSystem(n), clonable(clonable) {}
+
+    Rosenbrock* clone() const override {
+        if (!clonable) return nullptr;
+        ++numClones;
+        return new Rosenbrock(*this);
+    }
+
+    int objectiveFunc(const Vector& x, bool newX, Real& f) const override {
+        f = 0;
+        for (int i=0; i < x.size()-1; ++i)
+            f += 100*square(x[i+1]-square(x[i])) + square(1-x[i]);
+        return 0;
+    }
+private:
+    bool clonable;
+};
+
+// A weighted quadratic bowl whose minimum, at (c,c,...,c), can be moved
+// between optimizations.
+class Bowl : public OptimizerSystem {
+public:
+    explicit Bowl(int n) : OptimizerSystem(n), center(0) {}
+
+    Bowl* clone() const override {
+        ++numClones;
+        return new Bowl(*this);
+    }
+
+    void setCenter(Real c) {center = c;}
+
+    int objectiveFunc(const Vector& x, bool newX, Real& f) const override {
+        f = 0;
+        for (int i=0; i < x.size(); ++i)
+            f += (i+1)*square(x[i]-center);
+        return 0;
+    }
+private:
+    Real center;
+};
+
+// Ipopt's hs071 example; see IpoptDiffTest.
+class HS071 : public OptimizerSystem {
+public:
+    HS071() : OptimizerSystem(4) {
+        setNumEqualityConstraints(1);
+        setNumInequalityConstraints(1);
+        setParameterLimits(Vector(4, 1.), Vector(4, 5.));
+    }
+
+    HS071* clone() const override {
+        ++numClones;
+        return new HS071(*this);
+    }
+
+    int objectiveFunc(const Vector& x, bool newX, Real& f) const override {
+        f = x[0]*x[3]*(x[0]+x[1]+x[2]) + x[2];
+        return 0;
+    }
+
+    int constraintFunc(const Vector& x, bool newX,
+                       Vector& constraints) const override {
+        constraints[0] = x.normSqr() - 40;
+        constraints[1] = x[0]*x[1]*x[2]*x[3] - 25;
+        return 0;
+    }
+};
+
+static bool isIdentical(const Vector& a, const Vector& b) {
+    if (a.size() != b.size()) return false;
+    for (int i=0; i < a.size(); ++i)
+        if (a[i] != b[i]) return false;
+    return true;
+}
+
+static Vector optimize(const OptimizerSystem& sys, OptimizerAlgorithm alg,
+                       const Vector& x0, int nthreads) {
+    Optimizer opt(sys, alg);
+    opt.useNumericalGradient(true);
+    opt.useNumericalJacobian(true);
+    opt.setConvergenceTolerance(1e-6);
+    opt.setMaxIterations(1000);
+    if (nthreads > 1) {
+        opt.setAdvancedStrOption("parallel", "multithreading");
+        opt.setAdvancedIntOption("nthreads", nthreads);
+    }
+    Vector x(x0);
+    opt.optimize(x);
+    return x;
+}
+
+static void testParallelMatchesSerial(const OptimizerSystem& sys,
+                                      OptimizerAlgorithm alg,
+                                      const Vector& x0, const Vector& xopt,
+                                      Real tol) {
+    numClones = 0;
+    const Vector serial = optimize(sys, alg, x0, 1);
+    SimTK_TEST(numClones == 0);
+    SimTK_TEST_EQ_TOL(serial, xopt, tol);
+
+    const Vector parallel = optimize(sys, alg, x0, 4);
+    cout << "  " << numClones << " clones" << endl;
+    SimTK_TEST(numClones > 0);
+    SimTK_TEST(isIdentical(parallel, serial));
+}
+
+static void testLBFGS() {
+    if (!Optimizer::isAlgorithmAvailable(LBFGS)) return;
+    const int n = 12;
+    testParallelMatchesSerial(Rosenbrock(n, true), LBFGS,
+                              Vector(n, 0.5), Vector(n, 1.), 1e-3);
+}
+
+static void testLBFGSB() {
+    if (!Optimizer::isAlgorithmAvailable(LBFGSB)) return;
+    const int n = 12;
+    Rosenbrock sys(n, true);
+    sys.setParameterLimits(Vector(n, -2.), Vector(n, 2.));
+    testParallelMatchesSerial(sys, LBFGSB, Vector(n, 0.5), Vector(n, 1.),
+                              1e-3);
+}
+
+static void testInteriorPoint() {
+    if (!Optimizer::isAlgorithmAvailable(InteriorPoint)) return;
+    testParallelMatchesSerial(HS071(), InteriorPoint, Vector(Vec4(1,5,5,1)),
+        Vector(Vec4(1.00000000, 4.74299963, 3.82114998, 1.37940829)), 1e-3);
+}
+
+// Without a clone() override the derivatives are calculated serially even
+// if threads are requested, with the same result.
+static void testNotClonable() {
+    if (!Optimizer::isAlgorithmAvailable(LBFGS)) return;
+    const int n = 12;
+    Rosenbrock sys(n, false);
+    numClones = 0;
+    const Vector serial = optimize(sys, LBFGS, Vector(n, 0.5), 1);
+    const Vector parallel = optimize(sys, LBFGS, Vector(n, 0.5), 4);
+    SimTK_TEST(numClones == 0);
+    SimTK_TEST(isIdentical(parallel, serial));
+}
+
+// The copies of the system are made afresh by each optimize(), so they see
+// changes made to the system since the last one.
+static void testChangeBetweenOptimizations() {
+    if (!Optimizer::isAlgorithmAvailable(LBFGS)) return;
+    const int n = 6;
+    Vector results[2]; // serial, parallel
+    for (int k=0; k < 2; ++k) {
+        Bowl sys(n);
+        Optimizer opt(sys, LBFGS);
+        opt.useNumericalGradient(true);
+        opt.setConvergenceTolerance(1e-8);
+        if (k == 1) {
+            opt.setAdvancedStrOption("parallel", "multithreading");
+            opt.setAdvancedIntOption("nthreads", 3);
+        }
+        sys.setCenter(1);
+        Vector x(n, 0.);
+        opt.optimize(x);
+        SimTK_TEST_EQ_TOL(x, Vector(n, 1.), 1e-4);
+
+        numClones = 0;
+        sys.setCenter(3);
+        opt.optimize(x);
+        SimTK_TEST_EQ_TOL(x, Vector(n, 3.), 1e-4);
+        SimTK_TEST(numClones == (k == 1 ? 3 : 0));
+        results[k] = x;
+    }
+    SimTK_TEST(isIdentical(results[1], results[0]));
+}
+
+// A copy of an OptimizerSystem has its own parameter limits.
+static void testCopyLimits() {
+    Rosenbrock* sys = new Rosenbrock(3, true);
+    sys->setParameterLimits(Vector(Vec3(-1,-2,-3)), Vector(Vec3(1,2,3)));
+    Rosenbrock* copy = sys->clone();
+    delete sys;
+
+    SimTK_TEST(copy->getHasLimits());
+    Real *lower, *upper;
+    copy->getParameterLimits(&lower, &upper);
+    for (int i=0; i < 3; ++i) {
+        SimTK_TEST(lower[i] == -(i+1));
+        SimTK_TEST(upper[i] == i+1);
+    }
+
+    Rosenbrock other(3, true);
+    other = *copy;
+    delete copy;
+    SimTK_TEST(other.getHasLimits());
+    other.getParameterLimits(&lower, &upper);
+    SimTK_TEST(lower[2] == -3 && upper[2] == 3);
+}
+
+int main() {
+    SimTK_START_TEST("OptimizerParallelDiffTest");
+        SimTK_SUBTEST(testLBFGS);
+        SimTK_SUBTEST(testLBFGSB);
+        SimTK_SUBTEST(testInteriorPoint);
+        SimTK_SUBTEST(testNotClonable);
+        SimTK_SUBTEST(testChangeBetweenOptimizations);
+        SimTK_SUBTEST(testCopyLimits);
+    SimTK_END_TEST();
+}
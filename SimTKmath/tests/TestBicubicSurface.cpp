@@ -1035,12 +1035,79 @@ void testHint() {
 
 }
 
+// Check that the precomputed patch table and the batch evaluators give the
+// same answers as ordinary hint-based evaluation, for a surface whose evenly
+// spaced samples are given explicitly and for one given by its spacing.
+void testPatchTable() {
+    const int nx = 7, ny = 5;
+    Vector x(nx), y(ny);
+    Matrix f(nx,ny);
+    for (int i=0; i < nx; ++i) x[i] = -1 + Real(.5)*i;
+    for (int j=0; j < ny; ++j) y[j] =  2 + Real(.25)*j;
+    for (int i=0; i < nx; ++i)
+        for (int j=0; j < ny; ++j)
+            f(i,j) = std::sin(x[i])*std::cos(2*y[j]);
+
+    BicubicSurface explicitSurf(x, y, f);
+    BicubicSurface spacedSurf(Vec2(-1,2), Vec2(.5,.25), f);
+
+    // Include points on the grid lines and the far corner.
+    Array_<Vec2> pts;
+    pts.push_back(Vec2(-1,2)); pts.push_back(Vec2(2,3)); 
+    pts.push_back(Vec2(.5,2.5)); pts.push_back(Vec2(2,2.1));
+    Random::Uniform rand; rand.setSeed(42);
+    for (int k=0; k < 200; ++k)
+        pts.push_back(Vec2(-1 + 3*rand.getValue(), 2 + rand.getValue()));
+
+    Array_<Real> expected; Array_<UnitVec3> expectedNormals;
+    BicubicSurface::PatchHint hint;
+    for (unsigned k=0; k < pts.size(); ++k) {
+        expected.push_back(explicitSurf.calcValue(pts[k], hint));
+        expectedNormals.push_back(explicitSurf.calcUnitNormal(pts[k], hint));
+    }
+
+    Array_<Real> values; Array_<UnitVec3> normals;
+    spacedSurf.calcValuesAndUnitNormals(pts, values, normals);
+    SimTK_TEST(values.size() == pts.size() && normals.size() == pts.size());
+    for (unsigned k=0; k < pts.size(); ++k) {
+        SimTK_TEST_EQ(values[k], expected[k]);
+        SimTK_TEST_EQ(normals[k], expectedNormals[k]);
+    }
+
+    SimTK_TEST(!explicitSurf.hasPatchTable());
+    explicitSurf.buildPatchTable();
+    SimTK_TEST(explicitSurf.hasPatchTable());
+
+    // The table is shared by all handles to the same surface.
+    BicubicSurface copy(explicitSurf);
+    SimTK_TEST(copy.hasPatchTable());
+
+    hint.clear();
+    for (unsigned k=0; k < pts.size(); ++k) {
+        SimTK_TEST_EQ(copy.calcValue(pts[k], hint), expected[k]);
+        SimTK_TEST_EQ(copy.calcUnitNormal(pts[k], hint), expectedNormals[k]);
+        SimTK_TEST_EQ(copy.calcValue(pts[k]), expected[k]);
+    }
+
+    explicitSurf.calcValues(pts, values);
+    for (unsigned k=0; k < pts.size(); ++k)
+        SimTK_TEST_EQ(values[k], expected[k]);
+
+    SimTK_TEST_MUST_THROW(
+        explicitSurf.calcValues(Array_<Vec2>(1, Vec2(2.1,2.5)), values));
+
+    explicitSurf.clearPatchTable();
+    SimTK_TEST(!copy.hasPatchTable());
+    SimTK_TEST_EQ(copy.calcValue(pts[2]), expected[2]);
+}
+
 int main() {
     //Evaluate the bicubic surface interpolation against an analytical 
     //function. Throw an error if the values of the function are different
     //at the knot points, or different within tolerance at the mid grid points
     SimTK_START_TEST("Testing Bicubic Interpolation");
         SimTK_SUBTEST(testHint);
+        SimTK_SUBTEST(testPatchTable);
 
     cout << "\n---------------------------------------------"<< endl;
     cout<< "\n\nANALYTICAL FUNCTION COMPARISON:" << endl;
@@ -439,6 +439,45 @@ void testAnalyticalCylinderGeodesic() {
     testAnalyticalGeodesicRandom(cylinder);
 }
 
+// Shoot a fan of geodesics over a sphere and compare them with the great
+// circle arcs they must follow. Then ask for the geodesics joining the same
+// end points and check that their lengths are recovered.
+void testShootSphereGeodesics() {
+    ContactGeometry::Sphere sphere(r);
+    const Vec3 P(r,0,0);
+    const int NumGeod = 8;
+
+    for (int i=0; i < NumGeod; ++i) {
+        const Real angle = i*Pi/NumGeod;
+        const UnitVec3 tP(0, std::cos(angle), std::sin(angle));
+        const Real length = r*(Real(0.2) + Real(0.1)*i);
+        const Real theta = length/r; // arc angle on the great circle
+        const Vec3 Q = r*(std::cos(theta)*UnitVec3(XAxis)
+                          + std::sin(theta)*tP);
+
+        Geodesic geod;
+        sphere.shootGeodesicInDirectionUntilLengthReached
+           (P, tP, length, GeodesicOptions(), geod);
+        assertEqual(geod.getLength(), length);
+        assertEqual(geod.getPointQ(), Q);
+
+        // Shooting again into the same Geodesic must overwrite, not append.
+        const int numPoints = geod.getNumPoints();
+        sphere.shootGeodesicInDirectionUntilLengthReached
+           (P, tP, length, GeodesicOptions(), geod);
+        ASSERT(geod.getNumPoints() == numPoints);
+
+        Geodesic joined;
+        sphere.continueGeodesic(P, Q, Geodesic(), GeodesicOptions(), joined);
+        assertEqual(joined.getLength(), length);
+
+        // Continuing from the geodesic we just found should give it back.
+        Geodesic continued;
+        sphere.continueGeodesic(P, Q, joined, GeodesicOptions(), continued);
+        assertEqual(continued.getLength(), length);
+    }
+}
+
 void testProjectDownhillToNearestPoint(const ContactGeometry& geom, Real r) {
 
     bool inside;
@@ -473,6 +512,7 @@ int main() {
         // TODO clean up these tests and use them
 //        testAnalyticalSphereGeodesic();
 //        testAnalyticalCylinderGeodesic();
+        testShootSphereGeodesics();
         testProjectDownhillToNearestPoint(ContactGeometry::Sphere(r), r);
         testProjectDownhillToNearestPoint(ContactGeometry::Ellipsoid(Vec3(1.5, 2.2, 3.1)), r);
 //        testProjectDownhillToNearestPoint(ContactGeometry::Torus(3*r, r), 3*r);
@@ -0,0 +1,236 @@
+/* -------------------------------------------------------------------------- *
+ *                        Simbody(tm): SimTKmath                              *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Test ContactGeometry::ConvexHull and the HalfSpaceConvexHull and
+// ConvexHullPair contact trackers.
+
+#include "SimTKmath.h"
+#include "SimTKcommon/Testing.h"
+
+using namespace SimTK;
+using namespace std;
+
+// Check the hull's support vertex against a brute force search.
+static void checkSupport(const ContactGeometry::ConvexHull& hull,
+                         const UnitVec3& dir, int start) {
+    const int v = hull.findSupportVertex(dir, start);
+    Real best = -Infinity;
+    for (int i=0; i < hull.getNumVertices(); ++i)
+        best = std::max(best, dot(hull.getVertexPosition(i), dir));
+    SimTK_TEST_EQ(dot(hull.getVertexPosition(v), dir), best);
+}
+
+void testBrickHull() {
+    // Interior vertices of the brick faces are not hull vertices.
+    const ContactGeometry::ConvexHull hull
+        (PolygonalMesh::createBrickMesh(Vec3(1,2,3), 3));
+    SimTK_TEST(hull.getNumVertices() == 8);
+    SimTK_TEST(hull.getNumFaces() == 12);
+
+    int nEdges = 0;
+    for (int v=0; v < hull.getNumVertices(); ++v) {
+        const Vec3& p = hull.getVertexPosition(v);
+        SimTK_TEST_EQ(Vec3(std::abs(p[0]),std::abs(p[1]),std::abs(p[2])),
+                      Vec3(1,2,3));
+        nEdges += hull.getNumVertexNeighbors(v);
+    }
+    nEdges /= 2;
+    SimTK_TEST(hull.getNumVertices() - nEdges + hull.getNumFaces() == 2);
+
+    for (int f=0; f < hull.getNumFaces(); ++f) {
+        const Vec3& p0 = hull.getVertexPosition(hull.getFaceVertex(f,0));
+        SimTK_TEST(dot(hull.getFaceNormal(f), p0) > 0);
+    }
+
+    Random::Gaussian random(0, 1);
+    for (int i=0; i < 50; ++i) {
+        const UnitVec3 dir(Vec3(random.getValue(), random.getValue(),
+                                random.getValue()));
+        checkSupport(hull, dir, i % hull.getNumVertices());
+    }
+
+    SimTK_TEST(hull.containsPoint(Vec3(0.9, -1.9, 2.9)));
+    SimTK_TEST(!hull.containsPoint(Vec3(1.1, 0, 0)));
+
+    bool inside; UnitVec3 normal;
+    Vec3 nearest = hull.findNearestPoint(Vec3(0.5,0,0), inside, normal);
+    SimTK_TEST(inside);
+    SimTK_TEST_EQ(nearest, Vec3(1,0,0));
+    SimTK_TEST_EQ(normal, UnitVec3(XAxis));
+    nearest = hull.findNearestPoint(Vec3(2,3,0), inside, normal);
+    SimTK_TEST(!inside);
+    SimTK_TEST_EQ(nearest, Vec3(1,2,0));
+
+    Real distance;
+    SimTK_TEST(hull.intersectsRay(Vec3(-5,0,0), UnitVec3(XAxis),
+                                  distance, normal));
+    SimTK_TEST_EQ(distance, 4);
+    SimTK_TEST_EQ(normal, -UnitVec3(XAxis));
+    SimTK_TEST(!hull.intersectsRay(Vec3(-5,0,0), -UnitVec3(XAxis),
+                                   distance, normal));
+
+    Vec3 center; Real radius;
+    hull.getBoundingSphere(center, radius);
+    SimTK_TEST_EQ(center, Vec3(0));
+    SimTK_TEST_EQ(radius, Vec3(1,2,3).norm());
+}
+
+void testSphereHull() {
+    const PolygonalMesh mesh = PolygonalMesh::createSphereMesh(1, 2);
+    const ContactGeometry::ConvexHull hull(mesh);
+    // All the vertices are on the sphere so they are all hull vertices.
+    SimTK_TEST(hull.getNumVertices() == mesh.getNumVertices());
+    SimTK_TEST(hull.getNumFaces() == 2*hull.getNumVertices()-4);
+
+    Random::Gaussian random(0, 1);
+    for (int i=0; i < 100; ++i) {
+        const UnitVec3 dir(Vec3(random.getValue(), random.getValue(),
+                                random.getValue()));
+        checkSupport(hull, dir, i % hull.getNumVertices());
+    }
+
+    // A copy of the hull's own mesh gives the same hull.
+    const ContactGeometry::ConvexHull copy(hull.createPolygonalMesh());
+    SimTK_TEST(copy.getNumVertices() == hull.getNumVertices());
+    SimTK_TEST(copy.getNumFaces() == hull.getNumFaces());
+}
+
+void testFlatHullThrows() {
+    PolygonalMesh flat;
+    for (int i=0; i < 5; ++i)
+        flat.addVertex(Vec3(std::cos(i*2*Pi/5), std::sin(i*2*Pi/5), 0));
+    SimTK_TEST_MUST_THROW(ContactGeometry::ConvexHull hull(flat));
+}
+
+// A half-space whose normal is +y in Ground.
+static const Transform X_GH(Rotation(-Pi/2, ZAxis), Vec3(0));
+
+void testHalfSpaceConvexHull() {
+    const ContactGeometry::HalfSpace halfSpace;
+    const ContactGeometry::ConvexHull box
+        (PolygonalMesh::createBrickMesh(Vec3(1,2,3)));
+    const ContactTracker::HalfSpaceConvexHull tracker;
+    const UntrackedContact untracked(ContactSurfaceIndex(0),
+                                     ContactSurfaceIndex(1));
+
+    // Resting on its face, slightly sunk in.
+    Contact contact;
+    tracker.trackContact(untracked, X_GH, halfSpace,
+                         Transform(Vec3(0,1.99,0)), box, 0, contact);
+    SimTK_TEST(ConvexHullContact::isInstance(contact));
+    const ConvexHullContact& flat = ConvexHullContact::getAs(contact);
+    SimTK_TEST_EQ(X_GH.R()*flat.getNormal(), UnitVec3(YAxis));
+    SimTK_TEST_EQ(flat.getDepth(), 0.01);
+    SimTK_TEST(flat.getNumPoints() == 4);
+    for (int i=0; i < flat.getNumPoints(); ++i) {
+        SimTK_TEST_EQ(flat.getPointDepth(i), 0.01);
+        SimTK_TEST_EQ(std::abs((X_GH*flat.getPoint(i))[0]), 1);
+    }
+
+    // Tipped over a little, so only one edge is in.
+    const Transform X_GC(Rotation(0.1, ZAxis), Vec3(0,2.05,0));
+    Contact tipped;
+    tracker.trackContact(contact, X_GH, halfSpace, X_GC, box, 0, tipped);
+    SimTK_TEST(ConvexHullContact::isInstance(tipped));
+    const ConvexHullContact& edge = ConvexHullContact::getAs(tipped);
+    SimTK_TEST(edge.getNumPoints() == 2);
+    Real lowest = Infinity;
+    for (int v=0; v < box.getNumVertices(); ++v)
+        lowest = std::min(lowest, (X_GC*box.getVertexPosition(v))[1]);
+    SimTK_TEST_EQ(edge.getDepth(), -lowest);
+
+    Contact separated;
+    tracker.trackContact(tipped, X_GH, halfSpace,
+                         Transform(Vec3(0,2.5,0)), box, 0, separated);
+    SimTK_TEST(separated.isEmpty());
+}
+
+void testConvexHullPair() {
+    const ContactGeometry::ConvexHull cube
+        (PolygonalMesh::createBrickMesh(Vec3(1)));
+    const ContactTracker::ConvexHullPair tracker;
+    const UntrackedContact untracked(ContactSurfaceIndex(0),
+                                     ContactSurfaceIndex(1));
+
+    // One cube sitting on another, slightly sunk in.
+    Contact contact;
+    tracker.trackContact(untracked, Transform(), cube,
+                         Transform(Vec3(0.3,1.98,0)), cube, 0, contact);
+    SimTK_TEST(ConvexHullContact::isInstance(contact));
+    const ConvexHullContact& stacked = ConvexHullContact::getAs(contact);
+    SimTK_TEST_EQ(stacked.getNormal(), UnitVec3(YAxis));
+    SimTK_TEST_EQ(stacked.getDepth(), 0.02);
+    // Two vertices of the top cube and two of the bottom one.
+    SimTK_TEST(stacked.getNumPoints() == 4);
+    for (int i=0; i < stacked.getNumPoints(); ++i) {
+        SimTK_TEST_EQ(stacked.getPointDepth(i), 0.02);
+        SimTK_TEST_EQ(stacked.getPoint(i)[1], 0.98);
+    }
+    SimTK_TEST(stacked.getSimplexVertices1().size() == 4);
+
+    // Starting from the previous simplex gives the same answer as a cold
+    // start after a small motion.
+    const Transform X_AB(Rotation(0.05, XAxis), Vec3(0.31,1.97,0.01));
+    Contact warm, cold;
+    tracker.trackContact(contact, Transform(), cube, X_AB, cube, 0, warm);
+    tracker.trackContact(untracked, Transform(), cube, X_AB, cube, 0, cold);
+    const ConvexHullContact& warmHull = ConvexHullContact::getAs(warm);
+    const ConvexHullContact& coldHull = ConvexHullContact::getAs(cold);
+    SimTK_TEST_EQ(warmHull.getNormal(), coldHull.getNormal());
+    SimTK_TEST_EQ(warmHull.getDepth(), coldHull.getDepth());
+    SimTK_TEST(warmHull.getNumPoints() == coldHull.getNumPoints());
+
+    // Crossed edges: neither cube has a vertex inside the other.
+    const Transform X_GA(Rotation(Pi/4, ZAxis), Vec3(0));
+    const Transform X_GB(Rotation(Pi/4, XAxis), Vec3(0,2*Sqrt2-0.01,0));
+    Contact crossed;
+    tracker.trackContact(untracked, X_GA, cube, X_GB, cube, 0, crossed);
+    SimTK_TEST(ConvexHullContact::isInstance(crossed));
+    const ConvexHullContact& edges = ConvexHullContact::getAs(crossed);
+    SimTK_TEST_EQ_TOL(X_GA.R()*edges.getNormal(), UnitVec3(YAxis), 1e-6);
+    SimTK_TEST_EQ_TOL(edges.getDepth(), 0.01, 1e-6);
+    SimTK_TEST(edges.getNumPoints() == 1);
+    SimTK_TEST_EQ_TOL(X_GA*edges.getPoint(0), Vec3(0,Sqrt2-0.01,0), 1e-6);
+
+    // Separated, but within the cutoff.
+    Contact apart;
+    tracker.trackContact(untracked, Transform(), cube,
+                         Transform(Vec3(0,2.5,0)), cube, 0, apart);
+    SimTK_TEST(apart.isEmpty());
+    tracker.trackContact(untracked, Transform(), cube,
+                         Transform(Vec3(0,2.5,0)), cube, 1, apart);
+    SimTK_TEST(ConvexHullContact::isInstance(apart));
+    SimTK_TEST_EQ(ConvexHullContact::getAs(apart).getDepth(), -0.5);
+    SimTK_TEST_EQ(ConvexHullContact::getAs(apart).getNormal(),
+                  UnitVec3(YAxis));
+}
+
+int main() {
+    SimTK_START_TEST("TestConvexHull");
+        SimTK_SUBTEST(testBrickHull);
+        SimTK_SUBTEST(testSphereHull);
+        SimTK_SUBTEST(testFlatHullThrows);
+        SimTK_SUBTEST(testHalfSpaceConvexHull);
+        SimTK_SUBTEST(testConvexHullPair);
+    SimTK_END_TEST();
+}
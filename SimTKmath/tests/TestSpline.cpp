@@ -148,6 +148,16 @@ void testRealSpline() {
                               coeff[i]+fract*(coeff[i+1]-coeff[i]), TESTTOL);
             SimTK_TEST_EQ_TOL(spline.calcDerivative(deriv, Vector(1, t)), 
                               (coeff[i+1]-coeff[i])/(x[i+1]-x[i]), TESTTOL);
+
+            // The allocation-free interface should agree.
+            const Function& f = spline;
+            Real dfdt;
+            SimTK_TEST_EQ(f.calcValueAt(1, &t), spline.calcValue(t));
+            SimTK_TEST_EQ(f.calcDerivativeAt(1, &deriv[0], 1, &t),
+                          spline.calcDerivative(1, t));
+            SimTK_TEST_EQ(f.calcValueAndGradientAt(1, &t, &dfdt),
+                          spline.calcValue(t));
+            SimTK_TEST_EQ(dfdt, spline.calcDerivative(1, t));
         }
     }
     SimTK_TEST_EQ_TOL(1, spline.getControlPointValues()[1], TESTTOL);
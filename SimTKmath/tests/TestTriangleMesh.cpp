@@ -201,6 +201,85 @@ void testOBBTree() {
         SimTK_TEST(faceReferenceCount[i] == 1);
 }
 
+void testOBBTreeNodeIndices() {
+    ContactGeometry::TriangleMesh 
+        mesh(PolygonalMesh::createSphereMesh(1, 3));
+    const int numNodes = mesh.getNumOBBTreeNodes();
+    SimTK_TEST(numNodes > 1);
+    SimTK_TEST(mesh.getOBBTreeNode().getIndex() == 0);
+    for (int i=0; i < numNodes; ++i) {
+        const ContactGeometry::TriangleMesh::OBBTreeNode 
+            node = mesh.getOBBTreeNode(i);
+        SimTK_TEST(node.getIndex() == i);
+        if (!node.isLeafNode()) { // preorder
+            SimTK_TEST(node.getFirstChildNode().getIndex() == i+1);
+            SimTK_TEST(node.getSecondChildNode().getIndex() > i+1);
+        }
+    }
+    SimTK_TEST_MUST_THROW(mesh.getOBBTreeNode(numNodes));
+
+    // A copy has its own tree but the same node numbering.
+    const ContactGeometry::TriangleMesh copy(mesh);
+    SimTK_TEST(copy.getNumOBBTreeNodes() == numNodes);
+    for (int i=0; i < numNodes; ++i) {
+        SimTK_TEST(copy.getOBBTreeNode(i).getIndex() == i);
+        SimTK_TEST(copy.getOBBTreeNode(i).getNumTriangles() 
+                   == mesh.getOBBTreeNode(i).getNumTriangles());
+    }
+}
+
+// Slide a mesh along a surface in small steps, tracking each step both from
+// the previous contact and from scratch. Resuming the search from the prior
+// contact's front must find exactly the same faces.
+void checkResumedSearch(const ContactTracker& tracker,
+                        const ContactGeometry& surface1,
+                        const ContactGeometry& surface2,
+                        const Transform& X_GS1, const Vec3& start, 
+                        const Vec3& step, int numSteps) {
+    const UntrackedContact untracked(ContactSurfaceIndex(0),
+                                     ContactSurfaceIndex(1));
+    Contact prior = untracked;
+    int numResumed = 0;
+    for (int i=0; i < numSteps; ++i) {
+        const Transform X_GS2(Rotation(0.01*i, YAxis), start + i*step);
+        Contact warm, cold;
+        tracker.trackContact(prior, X_GS1, surface1, X_GS2, surface2, 0, warm);
+        tracker.trackContact(untracked, X_GS1, surface1, X_GS2, surface2, 0,
+                             cold);
+        SimTK_TEST(warm.isEmpty() == cold.isEmpty());
+        if (cold.isEmpty()) {prior = untracked; continue;}
+        const TriangleMeshContact& w = TriangleMeshContact::getAs(warm);
+        const TriangleMeshContact& c = TriangleMeshContact::getAs(cold);
+        SimTK_TEST(w.getSurface1Faces() == c.getSurface1Faces());
+        SimTK_TEST(w.getSurface2Faces() == c.getSurface2Faces());
+        SimTK_TEST(!w.getSearchFront2().empty());
+        SimTK_TEST(w.getSearchFront1().size() 
+                   == (ContactGeometry::TriangleMesh::isInstance(surface1) 
+                       ? w.getSearchFront2().size() : 0));
+        if (!prior.isEmpty() && TriangleMeshContact::isInstance(prior))
+            ++numResumed;
+        prior = warm;
+    }
+    SimTK_TEST(numResumed > numSteps/2);
+}
+
+void testTrackerSearchFront() {
+    const ContactGeometry::TriangleMesh 
+        ball(PolygonalMesh::createSphereMesh(1, 3));
+    // Ground half space with +y up, and a sphere partly buried in it.
+    checkResumedSearch(ContactTracker::HalfSpaceTriangleMesh(),
+                       ContactGeometry::HalfSpace(), ball,
+                       Transform(Rotation(-Pi/2, ZAxis), Vec3(0)),
+                       Vec3(0, 0.8, 0), Vec3(0.05, 0, 0.01), 40);
+    checkResumedSearch(ContactTracker::SphereTriangleMesh(),
+                       ContactGeometry::Sphere(0.5), ball,
+                       Transform(), Vec3(-1.2, 0.3, 0), 
+                       Vec3(0.05, 0, 0), 50);
+    checkResumedSearch(ContactTracker::TriangleMeshTriangleMesh(),
+                       ball, ball, Transform(), Vec3(-1.8, 0.2, 0), 
+                       Vec3(0.05, 0, 0), 60);
+}
+
 void testRayIntersection() {
     // Create an octrohedral mesh.
     
@@ -312,6 +391,8 @@ int main() {
         SimTK_SUBTEST(testTriangleMesh);
         SimTK_SUBTEST(testIncorrectMeshes);
         SimTK_SUBTEST(testOBBTree);
+        SimTK_SUBTEST(testOBBTreeNodeIndices);
+        SimTK_SUBTEST(testTrackerSearchFront);
         SimTK_SUBTEST(testRayIntersection);
         SimTK_SUBTEST(testSmoothMesh);
         SimTK_SUBTEST(testFindNearestPoint);
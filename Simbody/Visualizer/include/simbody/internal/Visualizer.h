@@ -89,6 +89,23 @@ that simply captures and queues all user input, with the intent that a running
 simulation will occasionally stop to poll the InputSilo to process any input
 that has been collected. 
 
+<h3>Recording</h3>
+
+A %Visualizer created with createRecorder() does not launch the
+simbody-visualizer display at all. Instead the same stream of mesh definitions
+and per-frame scene data that would have been sent to the display is written
+to a file, along with an index of where each frame starts. No graphics context
+is needed, so this can be used on headless machines. In PassThrough mode
+every reported frame is recorded without any frame rate throttling. The file
+writes are done on a background thread. The recording can be viewed later
+with
+<pre>
+    simbody-visualizer --replay filename
+</pre>
+which plays it back and permits seeking to any frame: space pauses or resumes,
+the left and right arrow keys step one frame while paused, and Home and End
+jump to the first and last frames.
+
 <h3>Implementation notes</h3>
 
 RealTime mode is worth some discussion. There is a simulation thread that
@@ -200,6 +217,22 @@ constructor's documentation for more information. **/
 Visualizer(const MultibodySystem& system,
            const Array_<String>&  searchPath);
 
+/** Create a %Visualizer that records to a file rather than launching the
+simbody-visualizer display. See the "Recording" section of the Visualizer class
+documentation for details. The file is created (or overwritten) immediately,
+and is completed when the last reference to the returned %Visualizer is
+deleted, or when shutdown() is called. Input listeners will never receive any
+input from a recording %Visualizer.
+@param[in]  system              The System whose frames are to be recorded.
+@param[in]  recordingFileName   Name of the file to write; must not be empty.
+@see isRecording() **/
+static Visualizer createRecorder(const MultibodySystem& system,
+                                 const String&          recordingFileName);
+
+/** Return true if this %Visualizer was created with createRecorder() and is
+writing to a file rather than to a display. **/
+bool isRecording() const;
+
 /** Copy constructor has reference counted, shallow copy semantics;
 that is, the Visualizer copy is just another reference to the same
 Visualizer object. **/
@@ -213,7 +246,9 @@ destroyed here when the last reference is deleted. **/
 ~Visualizer();
 
 /** Ask the visualizer to shut itself down immediately. This will cause the
-display window to close and the associated process to die. This method returns
+display window to close and the associated process to die. For a recording
+%Visualizer this instead completes the recording file; any later frames are
+discarded. This method returns
 immediately but it may be some time later when the visualizer acts on the
 instruction; there is no way to wait for it to die. Normally the visualizer
 will persist even after the death of the simulator connection unless you have
@@ -138,6 +138,25 @@ static int inPipe, outPipe;
 // and can no longer write to the simulator.
 static std::atomic<bool> writeToSimulator{true};
 
+// When replaying a recording made by Visualizer::createRecorder() the whole
+// file is held in memory and readData() takes bytes from it rather than from
+// the pipe. The listener thread plays the command stream just as though it
+// were arriving from a simulator, but can be paused or sent to any frame
+// using the frame index stored at the end of the file.
+static bool replaying = false;
+static vector<unsigned char> replayData;
+static size_t replayPos, replayEnd; // replayEnd is where the index starts
+static vector<long long> replayFrameOffsets;
+static bool replayMeshesDefined = false;
+
+// These are shared between the listener thread and the keyboard callbacks.
+static std::mutex replayMutex;
+static std::condition_variable replayControlChanged;
+static int replayNextFrame = 0;     // the next frame to be shown
+static int replaySeekTo = -1;       // requested frame, if >= 0
+static bool replayPaused = false;
+static void replayKeyPressed(int key, bool isSpecialKey);
+
 static void computeBoundingSphereForVertices(const vector<float>& vertices, float& radius, fVec3& center) {
     fVec3 lower(vertices[0], vertices[1], vertices[2]);
     fVec3 upper = lower;
@@ -162,7 +181,7 @@ static void computeBoundingSphereForVertices(const vector<float>& vertices, floa
 
 class Mesh {
 public:
-    Mesh(vector<float>& vertices, vector<float>& normals, vector<GLushort>& faces) 
+    Mesh(vector<float>& vertices, vector<float>& normals, vector<GLuint>& faces) 
     :   numVertices((int)(vertices.size()/3)), faces(faces) {
         // Build OpenGL buffers.
 
@@ -177,16 +196,16 @@ public:
 
         // Create the list of edges.
 
-        set<pair<GLushort, GLushort> > edgeSet;
+        set<pair<GLuint, GLuint> > edgeSet;
         for (int i = 0; i < (int) faces.size(); i += 3) {
-            GLushort v1 = faces[i];
-            GLushort v2 = faces[i+1];
-            GLushort v3 = faces[i+2];
+            GLuint v1 = faces[i];
+            GLuint v2 = faces[i+1];
+            GLuint v3 = faces[i+2];
             edgeSet.insert(make_pair(min(v1, v2), max(v1, v2)));
             edgeSet.insert(make_pair(min(v2, v3), max(v2, v3)));
             edgeSet.insert(make_pair(min(v3, v1), max(v3, v1)));
         }
-        for (set<pair<GLushort, GLushort> >::const_iterator iter = edgeSet.begin(); iter != edgeSet.end(); ++iter) {
+        for (set<pair<GLuint, GLuint> >::const_iterator iter = edgeSet.begin(); iter != edgeSet.end(); ++iter) {
             edges.push_back(iter->first);
             edges.push_back(iter->second);
         }
@@ -201,11 +220,11 @@ public:
         glBindBuffer(GL_ARRAY_BUFFER, normBuffer);
         glNormalPointer(GL_FLOAT, 0, 0);
         if (representation == DecorativeGeometry::DrawSurface)
-            glDrawElements(GL_TRIANGLES, (GLsizei)faces.size(), GL_UNSIGNED_SHORT, &faces[0]);
+            glDrawElements(GL_TRIANGLES, (GLsizei)faces.size(), GL_UNSIGNED_INT, &faces[0]);
         else if (representation == DecorativeGeometry::DrawPoints)
             glDrawArrays(GL_POINTS, 0, numVertices);
         else if (representation == DecorativeGeometry::DrawWireframe)
-            glDrawElements(GL_LINES, (GLsizei)edges.size(), GL_UNSIGNED_SHORT, &edges[0]);
+            glDrawElements(GL_LINES, (GLsizei)edges.size(), GL_UNSIGNED_INT, &edges[0]);
     }
     void getBoundingSphere(float& radius, fVec3& center) {
         radius = this->radius;
@@ -214,7 +233,7 @@ public:
 private:
     int numVertices;
     GLuint vertBuffer, normBuffer;
-    vector<GLushort> edges, faces;
+    vector<GLuint> edges, faces;
     fVec3 center;
     float radius;
 };
@@ -223,7 +242,7 @@ static vector<vector<Mesh*> > meshes;
 
 class RenderedMesh {
 public:
-    RenderedMesh(const fTransform& transform, const fVec3& scale, const fVec4& color, short representation, unsigned short meshIndex, unsigned short resolution) :
+    RenderedMesh(const fTransform& transform, const fVec3& scale, const fVec4& color, short representation, unsigned meshIndex, unsigned resolution) :
             transform(transform), scale(scale), representation(representation), meshIndex(meshIndex), resolution(resolution) {
         this->color[0] = color[0];
         this->color[1] = color[1];
@@ -258,7 +277,7 @@ private:
     fVec3 scale;
     GLfloat color[4];
     short representation;
-    unsigned short meshIndex, resolution;
+    unsigned meshIndex, resolution;
 };
 
 class RenderedLine {
@@ -495,7 +514,7 @@ public:
     }
     vector<float> vertices;
     vector<float> normals;
-    vector<GLushort> faces;
+    vector<GLuint> faces;
     int index;
 };
 
@@ -506,10 +525,10 @@ static void addVec(vector<float>& data, float x, float y, float z) {
     data.push_back(z);
 }
 
-static void addVec(vector<unsigned short>& data, int x, int y, int z) {
-    data.push_back((unsigned short) x);
-    data.push_back((unsigned short) y);
-    data.push_back((unsigned short) z);
+static void addVec(vector<GLuint>& data, int x, int y, int z) {
+    data.push_back((GLuint) x);
+    data.push_back((GLuint) y);
+    data.push_back((GLuint) z);
 }
 
 static Mesh* makeBox()  {
@@ -518,7 +537,7 @@ static Mesh* makeBox()  {
     const float halfz = 1;
     vector<GLfloat> vertices;
     vector<GLfloat> normals;
-    vector<GLushort> faces;
+    vector<GLuint> faces;
 
     // lower x face
     addVec(vertices, -halfx, -halfy, -halfz);
@@ -595,7 +614,7 @@ static Mesh* makeSphere(unsigned short resolution) {
     const float radius = 1.0f;
     vector<GLfloat> vertices;
     vector<GLfloat> normals;
-    vector<GLushort> faces;
+    vector<GLuint> faces;
     addVec(vertices, 0, radius, 0);
     addVec(normals, 0, 1, 0);
     for (int i = 0; i < numLatitude; i++) {
@@ -642,7 +661,7 @@ static Mesh* makeCylinder(unsigned short resolution) {
     const float radius = 1;
     vector<GLfloat> vertices;
     vector<GLfloat> normals;
-    vector<GLushort> faces;
+    vector<GLuint> faces;
 
     // Create the top face.
 
@@ -704,7 +723,7 @@ static Mesh* makeCircle(unsigned short resolution) {
     const float radius = 1;
     vector<GLfloat> vertices;
     vector<GLfloat> normals;
-    vector<GLushort> faces;
+    vector<GLuint> faces;
 
     // Create the front face.
 
@@ -741,10 +760,10 @@ static Mesh* makeCircle(unsigned short resolution) {
 
 class PendingStandardMesh : public PendingCommand {
 public:
-    PendingStandardMesh(unsigned short meshIndex, unsigned short resolution) : meshIndex(meshIndex), resolution(resolution) {
+    PendingStandardMesh(unsigned meshIndex, unsigned resolution) : meshIndex(meshIndex), resolution(resolution) {
     }
     void execute() override {
-        if ((int) meshes[meshIndex].size() <= resolution)
+        if (meshes[meshIndex].size() <= resolution)
             meshes[meshIndex].resize(resolution+1, NULL);
         if (meshes[meshIndex][resolution] == NULL) {
             switch (meshIndex) {
@@ -763,7 +782,7 @@ public:
             }
         }
     }
-    unsigned short meshIndex, resolution;
+    unsigned meshIndex, resolution;
 };
 
 // Caution -- make sure scene is locked before you call this function.
@@ -1838,6 +1857,10 @@ static void mouseMoved(int x, int y) {
 // ones like arrows and function keys. We will map either case
 // into the same "key pressed" command to send to the simulator.
 static void ordinaryKeyPressed(unsigned char key, int x, int y) {
+    if (replaying) {
+        replayKeyPressed(key, false);
+        return;
+    }
     if (writeToSimulator) {
         char command = KeyPressed;
         WRITE(outPipe, &command, 1);
@@ -1856,6 +1879,10 @@ static void ordinaryKeyPressed(unsigned char key, int x, int y) {
 }
 
 static void specialKeyPressed(int key, int x, int y) {
+    if (replaying) {
+        replayKeyPressed(key, true);
+        return;
+    }
     if (writeToSimulator) {
         char command = KeyPressed;
         WRITE(outPipe, &command, 1);
@@ -2036,11 +2063,33 @@ static void readDataFromPipe(int srcPipe, unsigned char* buffer, int bytes) {
         totalRead += retval;
     }
 }
-// Throws ReadingInterrupted if inPipe is closed.
+// Throws ReadingInterrupted if inPipe is closed, or if we run off the end
+// of a recording.
 static void readData(unsigned char* buffer, int bytes) {
+    if (replaying) {
+        if (replayPos + bytes > replayEnd) throw ReadingInterrupted();
+        memcpy(buffer, &replayData[replayPos], bytes);
+        replayPos += bytes;
+        return;
+    }
     readDataFromPipe(inPipe, buffer, bytes);
 }
 
+// The simulator sends each scene as a single block preceded by its size.
+// We pull the whole block off the pipe at once and then decode the scene
+// from memory. The block is reused across frames so it stops allocating
+// once it is big enough for the largest scene.
+static vector<unsigned char> sceneData;
+static size_t sceneDataPos;
+
+// Copy the next bytes of the current scene block into the given buffer.
+static void readSceneData(unsigned char* buffer, int bytes) {
+    SimTK_ERRCHK_ALWAYS(sceneDataPos + bytes <= sceneData.size(),
+        "simbody-visualizer", "Scene data ended unexpectedly.");
+    memcpy(buffer, &sceneData[sceneDataPos], bytes);
+    sceneDataPos += bytes;
+}
+
 // We have just processed a StartOfScene command. Read in all the scene
 // elements until we see an EndOfScene command. We allocate a new Scene
 // object to hold the scene and return a pointer to it. Don't forget to
@@ -2051,15 +2100,21 @@ static Scene* readNewScene() {
     int*            intBuffer   = (int*)            buffer;
     unsigned short* shortBuffer = (unsigned short*) buffer;
 
+    unsigned frameSize;
+    readData((unsigned char*)&frameSize, sizeof(unsigned));
+    sceneData.resize(frameSize);
+    readData(sceneData.data(), (int)frameSize);
+    sceneDataPos = 0;
+
     Scene* newScene = new Scene;
 
     // Simulated time for this frame comes first.
-    readData(buffer, sizeof(float));
+    readSceneData(buffer, sizeof(float));
     newScene->simTime = floatBuffer[0];
 
     bool finished = false;
     while (!finished) {
-        readData(buffer, 1);
+        readSceneData(buffer, 1);
         char command = buffer[0];
 
         switch (command) {
@@ -2072,26 +2127,31 @@ static Scene* readNewScene() {
             finished = true;
             break;
 
-        // Add a scene element that uses an already-cached mesh.
+        // Add scene elements that are instances of an already-cached mesh.
         case AddPointMesh:
         case AddWireframeMesh:
         case AddSolidMesh: {
-            readData(buffer, 13*sizeof(float)+2*sizeof(short));
-            fTransform position;
-            position.updR().setRotationToBodyFixedXYZ(fVec3(floatBuffer[0], floatBuffer[1], floatBuffer[2]));
-            position.updP() = fVec3(floatBuffer[3], floatBuffer[4], floatBuffer[5]);
-            fVec3 scale = fVec3(floatBuffer[6], floatBuffer[7], floatBuffer[8]);
-            fVec4 color = fVec4(floatBuffer[9], floatBuffer[10], floatBuffer[11], floatBuffer[12]);
+            readSceneData(buffer, 3*sizeof(unsigned));
+            const unsigned* header = (const unsigned*)buffer;
+            const unsigned meshIndex = header[0];
+            const unsigned resolution = header[1];
+            const unsigned numInstances = header[2];
             short representation = (command == AddPointMesh ? DecorativeGeometry::DrawPoints : (command == AddWireframeMesh ? DecorativeGeometry::DrawWireframe : DecorativeGeometry::DrawSurface));
-            unsigned short meshIndex = shortBuffer[13*sizeof(float)/sizeof(short)];
-            unsigned short resolution = shortBuffer[13*sizeof(float)/sizeof(short)+1];
-            RenderedMesh mesh(position, scale, color, representation, meshIndex, resolution);
-            if (command != AddSolidMesh)
-                newScene->drawnMeshes.push_back(mesh);
-            else if (color[3] == 1)
-                newScene->solidMeshes.push_back(mesh);
-            else
-                newScene->transparentMeshes.push_back(mesh);
+            for (unsigned i = 0; i < numInstances; ++i) {
+                readSceneData(buffer, 13*sizeof(float));
+                fTransform position;
+                position.updR().setRotationToBodyFixedXYZ(fVec3(floatBuffer[0], floatBuffer[1], floatBuffer[2]));
+                position.updP() = fVec3(floatBuffer[3], floatBuffer[4], floatBuffer[5]);
+                fVec3 scale = fVec3(floatBuffer[6], floatBuffer[7], floatBuffer[8]);
+                fVec4 color = fVec4(floatBuffer[9], floatBuffer[10], floatBuffer[11], floatBuffer[12]);
+                RenderedMesh mesh(position, scale, color, representation, meshIndex, resolution);
+                if (command != AddSolidMesh)
+                    newScene->drawnMeshes.push_back(mesh);
+                else if (color[3] == 1)
+                    newScene->solidMeshes.push_back(mesh);
+                else
+                    newScene->transparentMeshes.push_back(mesh);
+            }
             if (meshIndex < NumPredefinedMeshes && (meshes[meshIndex].size() <= resolution || meshes[meshIndex][resolution] == NULL)) {
                 // A real mesh will be generated from this the next
                 // time the scene is redrawn.
@@ -2103,7 +2163,7 @@ static Scene* readNewScene() {
         }
 
         case AddLine: {
-            readData(buffer, 10*sizeof(float));
+            readSceneData(buffer, 10*sizeof(float));
             fVec3 color = fVec3(floatBuffer[0], floatBuffer[1], floatBuffer[2]);
             float thickness = floatBuffer[3];
             int index;
@@ -2123,7 +2183,7 @@ static Scene* readNewScene() {
         }
 
         case AddText: {
-            readData(buffer, 12*sizeof(float)+3*sizeof(short));
+            readSceneData(buffer, 12*sizeof(float)+3*sizeof(short));
             fTransform X_GT;
             X_GT.updR().setRotationToBodyFixedXYZ(fVec3(floatBuffer[0], floatBuffer[1], floatBuffer[2]));
             X_GT.updP() = fVec3(floatBuffer[3], floatBuffer[4], floatBuffer[5]);
@@ -2133,7 +2193,7 @@ static Scene* readNewScene() {
             bool faceCamera = (shortp[0] != 0);
             bool isScreenText = (shortp[1] != 0);
             short length = shortp[2];
-            readData(buffer, length);
+            readSceneData(buffer, length);
 
             if (isScreenText)
                 newScene->screenText.push_back(
@@ -2145,7 +2205,7 @@ static Scene* readNewScene() {
         }
 
         case AddCoords: {
-            readData(buffer, 12*sizeof(float));
+            readSceneData(buffer, 12*sizeof(float));
             fRotation rotation;
             rotation.setRotationToBodyFixedXYZ(fVec3(floatBuffer[0], 
                                                      floatBuffer[1], 
@@ -2197,19 +2257,71 @@ static Scene* readNewScene() {
         // index. It will be cached here and then can be referenced in this
         // scene and others by using it mesh index.
         case DefineMesh: {
-            readData(buffer, 2*sizeof(short));
+            readSceneData(buffer, 3*sizeof(unsigned));
+            const unsigned* counts = (const unsigned*)buffer;
+            const unsigned numVertices = counts[0];
+            const unsigned numPolygons = counts[1];
+            const unsigned numFaceVertexRefs = counts[2];
+            if (replayMeshesDefined) {
+                // Already done when the recording was loaded; skip it.
+                sceneDataPos += 3*numVertices*sizeof(float) 
+                                + (numPolygons+numFaceVertexRefs)*sizeof(unsigned);
+                break;
+            }
             PendingMesh* mesh = new PendingMesh(); // assigns next mesh index
-            int numVertices = shortBuffer[0];
-            int numFaces = shortBuffer[1];
-            mesh->vertices.resize(3*numVertices, 0);
-            mesh->normals.resize(3*numVertices);
-            mesh->faces.resize(3*numFaces);
-            readData((unsigned char*)&mesh->vertices[0], (int)(mesh->vertices.size()*sizeof(float)));
-            readData((unsigned char*)&mesh->faces[0], (int)(mesh->faces.size()*sizeof(short)));
+            mesh->vertices.resize(3*numVertices);
+            if (numVertices)
+                readSceneData((unsigned char*)&mesh->vertices[0], 
+                              (int)(mesh->vertices.size()*sizeof(float)));
+            vector<unsigned> polygonSizes(numPolygons), polygons(numFaceVertexRefs);
+            if (numPolygons)
+                readSceneData((unsigned char*)&polygonSizes[0], 
+                              (int)(numPolygons*sizeof(unsigned)));
+            if (numFaceVertexRefs)
+                readSceneData((unsigned char*)&polygons[0], 
+                              (int)(numFaceVertexRefs*sizeof(unsigned)));
+
+            // Triangulate the polygons; this used to be done by the simulator.
+            vector<GLuint>& faces = mesh->faces;
+            faces.reserve(3*numFaceVertexRefs);
+            unsigned next = 0; // first vertex of the current polygon
+            for (unsigned i = 0; i < numPolygons; next += polygonSizes[i++]) {
+                const unsigned numVert = polygonSizes[i];
+                SimTK_ERRCHK_ALWAYS(next + numVert <= numFaceVertexRefs,
+                    "simbody-visualizer", "Mesh definition is damaged.");
+                const unsigned* v = &polygons[next];
+                for (unsigned j = 0; j < numVert; j++)
+                    SimTK_ERRCHK_ALWAYS(v[j] < numVertices,
+                        "simbody-visualizer", "Mesh definition is damaged.");
+                if (numVert < 3)
+                    continue; // Ignore it.
+                if (numVert == 3)
+                    addVec(faces, v[0], v[1], v[2]);
+                else if (numVert == 4) {
+                    // Split it into two triangles.
+                    addVec(faces, v[0], v[1], v[2]);
+                    addVec(faces, v[2], v[3], v[0]);
+                } else {
+                    // Add a vertex at the center, then split it into triangles.
+                    fVec3 center(0);
+                    for (unsigned j = 0; j < numVert; j++)
+                        center += fVec3(&mesh->vertices[3*v[j]]);
+                    center /= (float)numVert;
+                    const unsigned newIndex = (unsigned)(mesh->vertices.size()/3);
+                    addVec(mesh->vertices, center[0], center[1], center[2]);
+                    for (unsigned j = 0; j < numVert-1; j++)
+                        addVec(faces, v[j], v[j+1], newIndex);
+                    // Close the face (thanks, Alexandra Zobova).
+                    addVec(faces, v[numVert-1], v[0], newIndex);
+                }
+            }
+            const int numFaces = (int)(faces.size()/3);
+            const int numAllVertices = (int)(mesh->vertices.size()/3);
+            mesh->normals.resize(3*numAllVertices);
 
             // Compute normal vectors for the mesh.
 
-            vector<fVec3> normals(numVertices, fVec3(0));
+            vector<fVec3> normals(numAllVertices, fVec3(0));
             for (int i = 0; i < numFaces; i++) {
                 int v1 = mesh->faces[3*i];
                 int v2 = mesh->faces[3*i+1];
@@ -2226,7 +2338,7 @@ static Scene* readNewScene() {
                     normals[v3] += norm;
                 }
             }
-            for (int i = 0; i < numVertices; i++) {
+            for (int i = 0; i < numAllVertices; i++) {
                 normals[i] = normals[i].normalize();
                 mesh->normals[3*i] = normals[i][0];
                 mesh->normals[3*i+1] = normals[i][1];
@@ -2248,6 +2360,55 @@ static Scene* readNewScene() {
     return newScene;
 }
 
+// Called by the listener thread before each command while replaying. This
+// handles seek requests, and blocks while we're paused at a frame or have
+// reached the end of the recording.
+static void waitForReplayToContinue() {
+    std::unique_lock<std::mutex> lock(replayMutex);
+    const int numFrames = (int)replayFrameOffsets.size();
+    while (true) {
+        if (replaySeekTo >= 0) {
+            // Show the requested frame even if we're paused.
+            replayNextFrame = replaySeekTo;
+            replaySeekTo = -1;
+            replayPos = (size_t)replayFrameOffsets[replayNextFrame];
+            return;
+        }
+        const bool atFrame = replayNextFrame < numFrames 
+            && replayPos == (size_t)replayFrameOffsets[replayNextFrame];
+        if (replayPos < replayEnd && !(atFrame && replayPaused))
+            return;
+        replayControlChanged.wait(lock);
+    }
+}
+
+// Handle a key press from the user while we're replaying; there is no
+// simulator to send it to.
+static void replayKeyPressed(int key, bool isSpecialKey) {
+    std::lock_guard<std::mutex> lock(replayMutex);
+    const int numFrames = (int)replayFrameOffsets.size();
+    if (numFrames == 0) return;
+    // The frame on screen is the one before the next one, unless we
+    // already have a seek pending.
+    const int current = replaySeekTo >= 0 ? replaySeekTo 
+                                          : max(replayNextFrame-1, 0);
+    if (!isSpecialKey && key == ' ')
+        replayPaused = !replayPaused;
+    else if (isSpecialKey && key == GLUT_KEY_RIGHT) {
+        replayPaused = true;
+        replaySeekTo = min(current+1, numFrames-1);
+    } else if (isSpecialKey && key == GLUT_KEY_LEFT) {
+        replayPaused = true;
+        replaySeekTo = max(current-1, 0);
+    } else if (isSpecialKey && key == GLUT_KEY_HOME)
+        replaySeekTo = 0;
+    else if (isSpecialKey && key == GLUT_KEY_END)
+        replaySeekTo = numFrames-1;
+    else
+        return;
+    replayControlChanged.notify_one();
+}
+
 // This is the main program for the listener thread. It reads continuously
 // from the input pipe, which contains data from the simulator's calls
 // to a Visualizer object. Any changes to the scene must wait until the
@@ -2261,8 +2422,23 @@ void listenForInput() {
     unsigned short* shortBuffer = (unsigned short*) buffer;
 
     try
-  { while (true) {
+  { if (replaying) {
+        // Define every mesh in the recording up front so that we can jump
+        // to any frame, then start over from the beginning.
+        const size_t startPos = replayPos;
+        for (unsigned i=0; i < replayFrameOffsets.size(); ++i) {
+            replayPos = (size_t)replayFrameOffsets[i] + 1; // skip command
+            delete readNewScene();
+        }
+        replayMeshesDefined = true;
+        replayPos = startPos;
+    }
+
+    double prevReplayFrameTime = realTime();
+    while (true) {
         bool issuedActiveRedisplay = false;
+        if (replaying)
+            waitForReplayToContinue();
         // Read commands from the simulator.
         readData(buffer, 1);
         switch (buffer[0]) {
@@ -2284,6 +2460,7 @@ void listenForInput() {
                 readData((unsigned char*)&textBuffer[0], intBuffer[1]);
                 items[index].first = string(&textBuffer[0], intBuffer[1]);
             }
+            if (replaying) break; // no simulator to respond to the menu
             std::lock_guard<std::mutex> lock(sceneMutex); //---- LOCK SCENE ----
             menus.push_back(Menu(title, menuId, items, menuSelected));
             break;                                        //--- UNLOCK SCENE ---
@@ -2295,6 +2472,7 @@ void listenForInput() {
             readData((unsigned char*)&titleBuffer[0], titleLength);
             string title(&titleBuffer[0], titleLength);
             readData(buffer, sizeof(int)+3*sizeof(float));
+            if (replaying) break; // no simulator to respond to the slider
             std::lock_guard<std::mutex> lock(sceneMutex); //---- LOCK SCENE ----
             sliders.push_back(Slider(title, intBuffer[0], floatBuffer[1], floatBuffer[2], floatBuffer[3]));
             break;                                        //--- UNLOCK SCENE ---
@@ -2451,6 +2629,16 @@ void listenForInput() {
             lock.unlock();                                 //-- UNLOCK SCENE ---
             forceActiveRedisplay();               //------- ACTIVE REDISPLAY ---
             issuedActiveRedisplay = true;
+            if (replaying) {
+                {   std::lock_guard<std::mutex> replayLock(replayMutex);
+                    ++replayNextFrame; }
+                // There is no simulator to pace us; play back at no more
+                // than the recorded maximum frame rate.
+                const double frameTime = 1/(double)maxFrameRate;
+                const double elapsed = realTime() - prevReplayFrameTime;
+                if (elapsed < frameTime) sleepInSec(frameTime - elapsed);
+                prevReplayFrameTime = realTime();
+            }
             break;
         }
 
@@ -2739,6 +2927,76 @@ static void shakeHandsWithSimulator(int fromSimPipe, int toSimPipe) {
     WRITE(outPipe, &ProtocolVersion, sizeof(unsigned));
 }
 
+// This is executed from the main thread at startup, in place of
+// shakeHandsWithSimulator(), when we were asked to replay a recording.
+static void loadRecording(const string& fileName) {
+    FILE* file = fopen(fileName.c_str(), "rb");
+    SimTK_ERRCHK3_ALWAYS(file != NULL, "simbody-visualizer::loadRecording()",
+        "Can't open recording file '%s'; errno=%d (%s).",
+        fileName.c_str(), errno, strerror(errno));
+    fseek(file, 0, SEEK_END);
+    const long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    replayData.resize(fileSize > 0 ? (size_t)fileSize : 0);
+    const size_t numRead = fread(replayData.data(), 1, replayData.size(), file);
+    fclose(file);
+
+    const size_t headerSize = 8 + sizeof(unsigned) + 3*sizeof(int);
+    const size_t footerSize = 2*sizeof(long long) + 8;
+    SimTK_ERRCHK1_ALWAYS(numRead == replayData.size() 
+        && replayData.size() >= headerSize + footerSize
+        && memcmp(&replayData[0], RecordingFileTag, 8) == 0,
+        "simbody-visualizer::loadRecording()",
+        "File '%s' is not a Simbody Visualizer recording.", fileName.c_str());
+    SimTK_ERRCHK1_ALWAYS(memcmp(&replayData[replayData.size()-8], 
+                                RecordingIndexTag, 8) == 0,
+        "simbody-visualizer::loadRecording()",
+        "Recording '%s' is incomplete; it has no frame index. Perhaps the "
+        "recording simulator did not exit cleanly?", fileName.c_str());
+
+    // Same information as would come from a simulator in the handshake.
+    unsigned recordedVersion;
+    memcpy(&recordedVersion, &replayData[8], sizeof(unsigned));
+    SimTK_ERRCHK2_ALWAYS(recordedVersion == ProtocolVersion,
+        "simbody-visualizer::loadRecording()",
+        "The recording was made with Visualizer protocol version %u which is "
+        "not compatible with simbody-visualizer protocol %u. Can't continue.",
+        recordedVersion, ProtocolVersion);
+    memcpy(simbodyVersion, &replayData[8+sizeof(unsigned)], 3*sizeof(int));
+    simbodyVersionStr = String(simbodyVersion[0]) + "." + String(simbodyVersion[1]);
+    if (simbodyVersion[2]) simbodyVersionStr += "." + String(simbodyVersion[2]);
+    unsigned exeNameLength;
+    memcpy(&exeNameLength, &replayData[headerSize], sizeof(unsigned));
+    SimTK_ASSERT_ALWAYS(exeNameLength <= 255,
+        "simbody-visualizer: executable name length violates protocol.");
+    replayPos = headerSize + sizeof(unsigned) + exeNameLength;
+    simulatorExecutableName = "replay of " + std::string(
+        (const char*)&replayData[headerSize + sizeof(unsigned)], exeNameLength);
+
+    // Now the frame index.
+    const size_t footerPos = replayData.size() - footerSize;
+    long long numFrames, indexPos;
+    memcpy(&numFrames, &replayData[footerPos], sizeof(long long));
+    memcpy(&indexPos, &replayData[footerPos + sizeof(long long)], 
+           sizeof(long long));
+    SimTK_ERRCHK1_ALWAYS(numFrames >= 0 && indexPos >= (long long)replayPos
+        && indexPos + numFrames*(long long)sizeof(long long) 
+           == (long long)footerPos,
+        "simbody-visualizer::loadRecording()",
+        "The frame index in recording '%s' is damaged.", fileName.c_str());
+    replayFrameOffsets.resize((size_t)numFrames);
+    if (numFrames)
+        memcpy(&replayFrameOffsets[0], &replayData[(size_t)indexPos], 
+               (size_t)numFrames*sizeof(long long));
+    for (unsigned i=0; i < replayFrameOffsets.size(); ++i)
+        SimTK_ERRCHK1_ALWAYS(replayFrameOffsets[i] >= (long long)replayPos 
+                             && replayFrameOffsets[i] < indexPos,
+            "simbody-visualizer::loadRecording()",
+            "The frame index in recording '%s' is damaged.", fileName.c_str());
+    replayEnd = (size_t)indexPos;
+    replaying = true;
+}
+
 // Received Shutdown message from simulator. Die immediately.
 static void shutdown() {
     printf("\nsimbody-visualizer: received Shutdown message. Goodbye.\n");
@@ -2748,8 +3006,12 @@ static void shutdown() {
 int main(int argc, char** argv) {
   try
   { bool talkingToSimulator = false;
+    string replayFileName;
       
-    if (argc >= 3) {
+    if (argc >= 3 && string(argv[1]) == "--replay") {
+        replayFileName = argv[2];
+        talkingToSimulator = true; // well, to a recording of one
+    } else if (argc >= 3) {
         stringstream(argv[1]) >> inPipe;
         stringstream(argv[2]) >> outPipe;
         talkingToSimulator = true; // presumably those were the pipes
@@ -2766,7 +3028,10 @@ int main(int argc, char** argv) {
     // from the main thread here.
     glutInit(&argc, argv);
 
-    if (talkingToSimulator)
+    if (!replayFileName.empty()) {
+        loadRecording(replayFileName);
+        writeToSimulator = false;
+    } else if (talkingToSimulator)
         shakeHandsWithSimulator(inPipe, outPipe);
     else {
         simbodyVersionStr = "?.?.?";
@@ -96,10 +96,12 @@ public:
 // Implementation of the Visualizer.
 class Visualizer::Impl {
 public:
-    // Create a Visualizer and put it in PassThrough mode.
+    // Create a Visualizer and put it in PassThrough mode. If a recording
+    // file name is given we write to that file instead of launching a GUI.
     Impl(Visualizer* owner, const MultibodySystem& system,
-         const Array_<String>& searchPath) 
-    :   m_system(system), m_protocol(*owner, searchPath),
+         const Array_<String>& searchPath,
+         const String& recordingFileName = String()) 
+    :   m_system(system), m_protocol(*owner, searchPath, recordingFileName),
         m_shutdownWhenDestructed(false), m_upDirection(YAxis), m_groundHeight(0),
         m_mode(PassThrough), m_frameRateFPS(DefaultFrameRateFPS), 
         m_simTimeUnitsPerSec(1), 
@@ -772,6 +774,20 @@ Visualizer::Visualizer(const MultibodySystem& system,
     impl->incrRefCount();
 }
 
+Visualizer Visualizer::createRecorder(const MultibodySystem& system,
+                                      const String& recordingFileName) {
+    SimTK_APIARGCHECK_ALWAYS(!recordingFileName.empty(), "Visualizer",
+        "createRecorder", "A recording file name is required.");
+    Visualizer recorder((Impl*)0);
+    recorder.impl = new Impl(&recorder, system, Array_<String>(), 
+                             recordingFileName);
+    recorder.impl->incrRefCount();
+    return recorder;
+}
+
+bool Visualizer::isRecording() const
+{   return getImpl().m_protocol.isRecording(); }
+
 Visualizer::Visualizer(const Visualizer& source) : impl(0) {
     if (source.impl) {
         impl = source.impl;
@@ -835,7 +851,10 @@ void Visualizer::report(const State& state) const {
         rep.m_nextFrameDueAdjRT = realTimeInNs(); // now
 
     // If someone asked for an infinite frame rate just send this along now.
-    if (rep.m_timeBetweenFramesInNs == 0LL) {
+    // Same if we're recording every frame to a file; there is no reason to
+    // hold up the simulation then.
+    if (rep.m_timeBetweenFramesInNs == 0LL 
+        || (rep.m_mode == PassThrough && rep.m_protocol.isRecording())) {
         drawFrameNow(state);
         return;
     }
@@ -32,6 +32,9 @@
 #include <cerrno>
 #include <cstring>
 #include <string>
+#include <algorithm>
+#include <deque>
+#include <condition_variable>
 
 using namespace SimTK;
 using namespace std;
@@ -193,6 +196,23 @@ static void readData(unsigned char* buffer, int bytes)
     readDataFromPipe(inPipe, buffer, bytes);
 }
 
+// A single write() to a pipe may transfer fewer bytes than requested when
+// the buffer is large (as a whole scene can be), so keep going until it has
+// all been sent.
+static void writeDataToPipe(int dstPipe, const unsigned char* buffer, 
+                            size_t bytes) {
+    size_t totalWritten = 0;
+    while (totalWritten < bytes) {
+        const unsigned chunk = 
+            (unsigned)std::min(bytes - totalWritten, (size_t)(1u << 30));
+        auto retval = WRITEFUNC(dstPipe, buffer + totalWritten, chunk);
+        SimTK_ERRCHK4_ALWAYS(retval!=-1, "VisualizerProtocol",
+            "An attempt to write() %u bytes to pipe %d failed with errno=%d (%s).",
+            chunk, dstPipe, errno, strerror(errno));
+        totalWritten += retval;
+    }
+}
+
 static void listenForVisualizerEvents(Visualizer& visualizer) {
     unsigned char buffer[256];
 
@@ -248,9 +268,146 @@ static void listenForVisualizerEvents(Visualizer& visualizer) {
     }
 }
 
+//==============================================================================
+//                                 RECORDER
+//==============================================================================
+// When recording, the command stream is accumulated in memory on the
+// simulation thread and handed off in large blocks to a background thread
+// that does the actual file writes, so that disk I/O never stalls the
+// simulation. The frame index is written at close().
+class VisualizerProtocol::Recorder {
+public:
+    explicit Recorder(const String& fileName) 
+    :   fileName(fileName), bytesRecorded(0), closed(false), 
+        stopWriting(false), writeErrno(0) {
+        file = fopen(fileName.c_str(), "wb");
+        SimTK_ERRCHK3_ALWAYS(file != nullptr, "Visualizer::createRecorder()",
+            "Unable to open recording file '%s' for writing; errno=%d (%s).",
+            fileName.c_str(), errno, strerror(errno));
+        writerThread = std::thread(&Recorder::writeBlocksInBackground, this);
+    }
+
+    ~Recorder() {
+        try {close();} catch (...) {}
+    }
+
+    // Call with sceneMutex held.
+    void append(const void* data, size_t len) {
+        if (closed) return;
+        const unsigned char* bytes = (const unsigned char*)data;
+        pending.insert(pending.end(), bytes, bytes + len);
+        bytesRecorded += len;
+        if (pending.size() >= BlockSize) {
+            SimTK_ERRCHK3_ALWAYS(writeErrno == 0, 
+                "VisualizerProtocol::Recorder",
+                "Failed writing recording file '%s'; errno=%d (%s).",
+                fileName.c_str(), (int)writeErrno, strerror(writeErrno));
+            handOffPendingBlock();
+        }
+    }
+
+    // Note that the next byte to be appended starts a frame.
+    void markStartOfFrame() {
+        if (!closed) frameOffsets.push_back(bytesRecorded);
+    }
+
+    // Flush everything, wait for the writer to finish, then append the frame
+    // index. Further appends are ignored.
+    void close() {
+        if (closed) return;
+        closed = true;
+        handOffPendingBlock();
+        {   std::lock_guard<std::mutex> lock(blockMutex);
+            stopWriting = true; }
+        blockReady.notify_one();
+        writerThread.join();
+
+        const long long indexOffset = bytesRecorded;
+        const long long numFrames = (long long)frameOffsets.size();
+        bool ok = writeErrno == 0;
+        if (ok && numFrames)
+            ok = fwrite(frameOffsets.data(), sizeof(long long), 
+                        frameOffsets.size(), file) == frameOffsets.size();
+        ok = ok && fwrite(&numFrames, sizeof(long long), 1, file) == 1
+                && fwrite(&indexOffset, sizeof(long long), 1, file) == 1
+                && fwrite(RecordingIndexTag, 1, 8, file) == 8;
+        const int err = writeErrno ? (int)writeErrno : errno;
+        ok = (fclose(file) == 0) && ok;
+        file = nullptr;
+        SimTK_ERRCHK3_ALWAYS(ok, "VisualizerProtocol::Recorder::close()",
+            "Failed writing recording file '%s'; errno=%d (%s).",
+            fileName.c_str(), err, strerror(err));
+    }
+
+private:
+    // Blocks are this big before we bother the writer thread with them.
+    static const size_t BlockSize = 1 << 20;
+
+    // Called on the simulation thread.
+    void handOffPendingBlock() {
+        if (pending.empty()) return;
+        std::vector<unsigned char> next;
+        {   std::lock_guard<std::mutex> lock(blockMutex);
+            fullBlocks.push_back(std::move(pending));
+            if (!spareBlocks.empty()) {
+                next = std::move(spareBlocks.back());
+                spareBlocks.pop_back();
+            } }
+        blockReady.notify_one();
+        next.clear();
+        pending = std::move(next);
+    }
+
+    // This is the main program for the writer thread.
+    void writeBlocksInBackground() {
+        std::unique_lock<std::mutex> lock(blockMutex);
+        while (true) {
+            blockReady.wait(lock, 
+                [&] {return stopWriting || !fullBlocks.empty();});
+            if (fullBlocks.empty())
+                return; // told to stop and there is nothing left to do
+            std::vector<unsigned char> block = std::move(fullBlocks.front());
+            fullBlocks.pop_front();
+            lock.unlock();
+            if (writeErrno == 0 
+                && fwrite(block.data(), 1, block.size(), file) != block.size())
+                writeErrno = errno ? errno : EIO;
+            lock.lock();
+            spareBlocks.push_back(std::move(block));
+        }
+    }
+
+    const String                            fileName;
+    FILE*                                   file;
+    std::vector<unsigned char>              pending;
+    long long                               bytesRecorded;
+    std::vector<long long>                  frameOffsets;
+    bool                                    closed;
+
+    std::mutex                              blockMutex;
+    std::condition_variable                 blockReady;
+    std::deque<std::vector<unsigned char>>  fullBlocks;  // waiting to write
+    std::vector<std::vector<unsigned char>> spareBlocks; // for reuse
+    bool                                    stopWriting;
+    std::atomic<int>                        writeErrno;
+    std::thread                             writerThread;
+};
+
+//==============================================================================
+//                           VISUALIZER PROTOCOL
+//==============================================================================
 VisualizerProtocol::VisualizerProtocol
-   (Visualizer& visualizer, const Array_<String>& userSearchPath) 
+   (Visualizer& visualizer, const Array_<String>& userSearchPath,
+    const String& recordingFileName) 
+:   outPipe(-1)
 {
+    if (!recordingFileName.empty()) {
+        // No GUI and no listener thread; just a file.
+        recorder.reset(new Recorder(recordingFileName));
+        writeRecordingHeader();
+        return;
+    }
+
     // Launch the GUI application. We'll first look for one in the same
     // directory as the running executable; then if that doesn't work we'll
     // look in the bin subdirectory of the SimTK installation.
@@ -398,7 +555,31 @@ void VisualizerProtocol::shakeHandsWithGUI(int toGUIPipe, int fromGUIPipe) {
     // Handshake was successful.
 }
 
+// This is executed on the main thread at startup when recording, in place of
+// shakeHandsWithGUI(), and thus does not require locking.
+void VisualizerProtocol::writeRecordingHeader() {
+    send(RecordingFileTag, 8);
+    send(&ProtocolVersion, sizeof(unsigned int));
+    int version[3];
+    SimTK_version_simbody(&version[0], &version[1], &version[2]);
+    send(version, 3*sizeof(int));
+    bool isAbsolutePath;
+    std::string directory, fileName, extension;
+    Pathname::deconstructPathname(Pathname::getThisExecutablePath(),
+        isAbsolutePath, directory, fileName, extension);
+    unsigned nameLength = std::min((unsigned)fileName.size(), (unsigned)255);
+    send(&nameLength, sizeof(unsigned));
+    send(fileName.c_str(), nameLength);
+}
+
 void VisualizerProtocol::shutdownGUI() {
+    if (recorder) {
+        // There is no GUI; just finish off the recording file.
+        std::lock_guard<std::mutex> lock(sceneMutex);
+        recorder->close();
+        return;
+    }
+
     // Don't wait for scene completion; kill GUI now.
     
     // We no longer need to listen for events from the GUI. Stop the listener
@@ -416,6 +597,15 @@ VisualizerProtocol::~VisualizerProtocol() {
     // If shutdownGUI() was not called, then the listener thread is still
     // running and we should kill it.
     stopListeningIfNecessary();
+    if (recorder) {
+        // Report but don't throw; we're in a destructor.
+        try {recorder->close();}
+        catch (const std::exception& e) {
+            std::cout << "Warning in Simbody VisualizerProtocol: "
+                      << e.what() << std::endl;
+        }
+        return;
+    }
     int retval = CLOSE(outPipe); // TODO(chrisdembia) is this necessary?
     if (retval == -1) {
         std::cout << "Warning in Simbody VisualizerProtocol: "
@@ -442,20 +632,46 @@ void VisualizerProtocol::stopListeningIfNecessary() {
 
 void VisualizerProtocol::beginScene(Real time) {
     sceneLockBeginFinishScene.lock();
-    char command = StartOfScene;
-    WRITE(outPipe, &command, 1);
+    // Leave room for the StartOfScene command and the frame size, which
+    // are filled in by finishScene() once the size is known.
+    sceneData.resize(1 + sizeof(unsigned));
+    sceneData[0] = StartOfScene;
+    meshInstances.clear();
     float fTime = (float)time;
-    WRITE(outPipe, &fTime, sizeof(float));
+    addToScene(&fTime, sizeof(float));
     // The sceneMutex is NOT unlocked at the end of this scope
     // (sceneLockBeginFinishScene is a member variable); see finishScene().
 }
 
 void VisualizerProtocol::finishScene() {
-    char command = EndOfScene;
-    WRITE(outPipe, &command, 1);
+    addMeshInstancesToScene();
+    addToScene(&EndOfScene, 1);
+    const unsigned frameSize = 
+        (unsigned)(sceneData.size() - (1 + sizeof(unsigned)));
+    std::memcpy(&sceneData[1], &frameSize, sizeof(unsigned));
+    if (recorder) {
+        recorder->markStartOfFrame();
+        recorder->append(sceneData.data(), sceneData.size());
+    } else {
+        // The whole frame goes out in one write rather than one per 
+        // decoration.
+        writeDataToPipe(outPipe, sceneData.data(), sceneData.size());
+    }
     sceneLockBeginFinishScene.unlock();
 }
 
+void VisualizerProtocol::send(const void* data, size_t len) const {
+    if (recorder)
+        recorder->append(data, len);
+    else
+        writeDataToPipe(outPipe, (const unsigned char*)data, len);
+}
+
+void VisualizerProtocol::addToScene(const void* data, size_t len) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    sceneData.insert(sceneData.end(), bytes, bytes + len);
+}
+
 void VisualizerProtocol::drawBox(const Transform& X_GB, const Vec3& scale, const Vec4& color, int representation) {
     drawMesh(X_GB, scale, color, (short) representation, MeshBox, 0);
 }
@@ -474,7 +690,7 @@ void VisualizerProtocol::drawCircle(const Transform& X_GB, const Vec3& scale, co
 
 void VisualizerProtocol::drawPolygonalMesh(const PolygonalMesh& mesh, const Transform& X_GM, const Vec3& scale, const Vec4& color, int representation) {
     const void* impl = &mesh.getImpl();
-    map<const void*, unsigned short>::const_iterator iter = meshes.find(impl);
+    map<const void*, unsigned>::const_iterator iter = meshes.find(impl);
 
     if (iter != meshes.end()) {
         // This mesh was already cached; just reference it by index number.
@@ -482,96 +698,54 @@ void VisualizerProtocol::drawPolygonalMesh(const PolygonalMesh& mesh, const Tran
         return;
     }
 
-    // This is a new mesh, so we need to send it to the visualizer. Build lists
-    // of vertices and faces, triangulating as necessary.
-
-    vector<float> vertices;
-    vector<unsigned short> faces;
-    for (int i = 0; i < mesh.getNumVertices(); i++) {
-        Vec3 pos = mesh.getVertexPosition(i);
-        vertices.push_back((float) pos[0]);
-        vertices.push_back((float) pos[1]);
-        vertices.push_back((float) pos[2]);
+    // This is a new mesh, so we need to send it to the visualizer. We send
+    // the faces as polygons and leave the triangulation to the GUI so that 
+    // it doesn't cost the simulation thread anything.
+    const unsigned numVertices = (unsigned)mesh.getNumVertices();
+    const unsigned numFaces = (unsigned)mesh.getNumFaces();
+    unsigned numFaceVertexRefs = 0;
+    for (unsigned i = 0; i < numFaces; i++)
+        numFaceVertexRefs += (unsigned)mesh.getNumVerticesForFace(i);
+
+    const unsigned index = NumPredefinedMeshes + (unsigned)meshes.size();
+    meshes[impl] = index;    // insert new mesh
+
+    addToScene(&DefineMesh, 1);
+    const unsigned counts[3] = {numVertices, numFaces, numFaceVertexRefs};
+    addToScene(counts, 3*sizeof(unsigned));
+    for (unsigned i = 0; i < numVertices; i++) {
+        const Vec3& pos = mesh.getVertexPosition(i);
+        const float fpos[3] = {(float)pos[0], (float)pos[1], (float)pos[2]};
+        addToScene(fpos, 3*sizeof(float));
     }
-    for (int i = 0; i < mesh.getNumFaces(); i++) {
-        int numVert = mesh.getNumVerticesForFace(i);
-        if (numVert < 3)
-            continue; // Ignore it.
-        if (numVert == 3) {
-            faces.push_back((unsigned short) mesh.getFaceVertex(i, 0));
-            faces.push_back((unsigned short) mesh.getFaceVertex(i, 1));
-            faces.push_back((unsigned short) mesh.getFaceVertex(i, 2));
-        }
-        else if (numVert == 4) {
-            // Split it into two triangles.
-
-            faces.push_back((unsigned short) mesh.getFaceVertex(i, 0));
-            faces.push_back((unsigned short) mesh.getFaceVertex(i, 1));
-            faces.push_back((unsigned short) mesh.getFaceVertex(i, 2));
-            faces.push_back((unsigned short) mesh.getFaceVertex(i, 2));
-            faces.push_back((unsigned short) mesh.getFaceVertex(i, 3));
-            faces.push_back((unsigned short) mesh.getFaceVertex(i, 0));
-        }
-        else {
-            // Add a vertex at the center, then split it into triangles.
-
-            Vec3 center(0);
-            for (int j = 0; j < numVert; j++) {
-                Vec3 pos = mesh.getVertexPosition(mesh.getFaceVertex(i,j));
-                center += pos;
-            }
-            center /= numVert;
-            vertices.push_back((float) center[0]);
-            vertices.push_back((float) center[1]);
-            vertices.push_back((float) center[2]);
-            const unsigned newIndex = (unsigned)(vertices.size()/3-1);
-            for (int j = 0; j < numVert-1; j++) {
-                faces.push_back((unsigned short) mesh.getFaceVertex(i, j));
-                faces.push_back((unsigned short) mesh.getFaceVertex(i, j+1));
-                faces.push_back((unsigned short) newIndex);
-            }
-            // Close the face (thanks, Alexandra Zobova).
-            faces.push_back((unsigned short) mesh.getFaceVertex(i, numVert-1));
-            faces.push_back((unsigned short) mesh.getFaceVertex(i, 0));
-            faces.push_back((unsigned short) newIndex);
+    for (unsigned i = 0; i < numFaces; i++) {
+        const unsigned numVert = (unsigned)mesh.getNumVerticesForFace(i);
+        addToScene(&numVert, sizeof(unsigned));
+    }
+    for (unsigned i = 0; i < numFaces; i++) {
+        const int numVert = mesh.getNumVerticesForFace(i);
+        for (int j = 0; j < numVert; j++) {
+            const unsigned v = (unsigned)mesh.getFaceVertex(i, j);
+            addToScene(&v, sizeof(unsigned));
         }
     }
-    SimTK_ERRCHK1_ALWAYS(vertices.size() <= 65535*3, 
-        "VisualizerProtocol::drawPolygonalMesh()",
-        "Can't display a DecorativeMesh with more than 65535 vertices;"
-        " received one with %llu.", (unsigned long long)vertices.size());
-    SimTK_ERRCHK1_ALWAYS(faces.size() <= 65535*3, 
-        "VisualizerProtocol::drawPolygonalMesh()",
-        "Can't display a DecorativeMesh with more than 65535 vertices;"
-        " received one with %llu.", (unsigned long long)faces.size());
-
-    const int index = NumPredefinedMeshes + (int)meshes.size();
-    SimTK_ERRCHK_ALWAYS(index <= 65535,
-        "VisualizerProtocol::drawPolygonalMesh()",
-        "Too many unique DecorativeMesh objects; max is 65535.");
-    
-    meshes[impl] = (unsigned short)index;    // insert new mesh
-    WRITE(outPipe, &DefineMesh, 1);
-    unsigned short numVertices = (unsigned short)(vertices.size()/3);
-    unsigned short numFaces = (unsigned short)(faces.size()/3);
-    WRITE(outPipe, &numVertices, sizeof(short));
-    WRITE(outPipe, &numFaces, sizeof(short));
-    WRITE(outPipe, &vertices[0], (unsigned)(vertices.size()*sizeof(float)));
-    WRITE(outPipe, &faces[0], (unsigned)(faces.size()*sizeof(short)));
 
-    drawMesh(X_GM, scale, color, (short) representation, (unsigned short)index, 0);
+    drawMesh(X_GM, scale, color, (short) representation, index, 0);
 }
 
 void VisualizerProtocol::
 drawMesh(const Transform& X_GM, const Vec3& scale, const Vec4& color, 
-         short representation, unsigned short meshIndex, unsigned short resolution)
+         short representation, unsigned meshIndex, unsigned short resolution)
 {
-    char command = (representation == DecorativeGeometry::DrawPoints 
-                    ? AddPointMesh 
-                    : (representation == DecorativeGeometry::DrawWireframe 
-                        ? AddWireframeMesh : AddSolidMesh));
-    WRITE(outPipe, &command, 1);
-    float buffer[13];
+    meshInstances.push_back(MeshInstance());
+    MeshInstance& instance = meshInstances.back();
+    instance.command = (representation == DecorativeGeometry::DrawPoints 
+                        ? AddPointMesh 
+                        : (representation == DecorativeGeometry::DrawWireframe 
+                            ? AddWireframeMesh : AddSolidMesh));
+    instance.meshIndex = meshIndex;
+    instance.resolution = resolution;
+    float* buffer = instance.data;
     Vec3 rot = X_GM.R().convertRotationToBodyFixedXYZ();
     buffer[0] = (float) rot[0];
     buffer[1] = (float) rot[1];
@@ -586,17 +760,34 @@ drawMesh(const Transform& X_GM, const Vec3& scale, const Vec4& color,
     buffer[10] = (float) color[1];
     buffer[11] = (float) color[2];
     buffer[12] = (float) color[3];
-    WRITE(outPipe, buffer, 13*sizeof(float));
-    unsigned short buffer2[2];
-    buffer2[0] = meshIndex;
-    buffer2[1] = resolution;
-    WRITE(outPipe, buffer2, 2*sizeof(unsigned short));
+}
+
+// Send one command for each distinct mesh/resolution/representation used in
+// this scene, carrying the poses and colors of all its instances. Any mesh
+// definitions have already been added to the scene ahead of these.
+void VisualizerProtocol::addMeshInstancesToScene() {
+    std::stable_sort(meshInstances.begin(), meshInstances.end());
+    for (size_t first = 0; first < meshInstances.size(); ) {
+        const MeshInstance& inst = meshInstances[first];
+        size_t last = first + 1;
+        while (last < meshInstances.size() 
+               && !(inst < meshInstances[last])) // i.e., same group
+            ++last;
+        addToScene(&inst.command, 1);
+        const unsigned header[3] = 
+            {inst.meshIndex, inst.resolution, (unsigned)(last-first)};
+        addToScene(header, 3*sizeof(unsigned));
+        for (size_t i = first; i < last; ++i)
+            addToScene(meshInstances[i].data, 13*sizeof(float));
+        first = last;
+    }
+    meshInstances.clear();
 }
 
 void VisualizerProtocol::
 drawLine(const Vec3& end1, const Vec3& end2, const Vec4& color, Real thickness)
 {
-    WRITE(outPipe, &AddLine, 1);
+    addToScene(&AddLine, 1);
     float buffer[10];
     buffer[0] = (float) color[0];
     buffer[1] = (float) color[1];
@@ -608,7 +799,7 @@ drawLine(const Vec3& end1, const Vec3& end2, const Vec4& color, Real thickness)
     buffer[7] = (float) end2[0];
     buffer[8] = (float) end2[1];
     buffer[9] = (float) end2[2];
-    WRITE(outPipe, buffer, 10*sizeof(float));
+    addToScene(buffer, 10*sizeof(float));
 }
 
 void VisualizerProtocol::
@@ -618,7 +809,7 @@ drawText(const Transform& X_GT, const Vec3& scale, const Vec4& color,
         "VisualizerProtocol::drawText()",
         "Can't display DecorativeText longer than 256 characters;"
         " received text of length %u.", (unsigned)string.size());
-    WRITE(outPipe, &AddText, 1);
+    addToScene(&AddText, 1);
     float buffer[12];
     const Vec3 rot = X_GT.R().convertRotationToBodyFixedXYZ();
     buffer[0] = (float) rot[0];
@@ -633,19 +824,19 @@ drawText(const Transform& X_GT, const Vec3& scale, const Vec4& color,
     buffer[9] = (float) color[0];
     buffer[10]= (float) color[1];
     buffer[11]= (float) color[2];
-    WRITE(outPipe, buffer, 12*sizeof(float));
+    addToScene(buffer, 12*sizeof(float));
     short face = (short)faceCamera;
-    WRITE(outPipe, &face, sizeof(short));
+    addToScene(&face, sizeof(short));
     short screen = (short)isScreenText;
-    WRITE(outPipe, &screen, sizeof(short));
+    addToScene(&screen, sizeof(short));
     short length = (short)string.size();
-    WRITE(outPipe, &length, sizeof(short));
-    WRITE(outPipe, &string[0], length);
+    addToScene(&length, sizeof(short));
+    addToScene(&string[0], length);
 }
 
 void VisualizerProtocol::
 drawCoords(const Transform& X_GF, const Vec3& axisLengths, const Vec4& color) {
-    WRITE(outPipe, &AddCoords, 1);
+    addToScene(&AddCoords, 1);
     float buffer[12];
     const Vec3 rot = X_GF.R().convertRotationToBodyFixedXYZ();
     buffer[0] = (float) rot[0];
@@ -660,72 +851,72 @@ drawCoords(const Transform& X_GF, const Vec3& axisLengths, const Vec4& color) {
     buffer[9] = (float) color[0];
     buffer[10]= (float) color[1];
     buffer[11]= (float) color[2];
-    WRITE(outPipe, buffer, 12*sizeof(float));
+    addToScene(buffer, 12*sizeof(float));
 }
 
 void VisualizerProtocol::
 addMenu(const String& title, int id, const Array_<pair<String, int> >& items) {
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &DefineMenu, 1);
+    send(&DefineMenu, 1);
     short titleLength = (short)title.size();
-    WRITE(outPipe, &titleLength, sizeof(short));
-    WRITE(outPipe, title.c_str(), titleLength);
-    WRITE(outPipe, &id, sizeof(int));
+    send(&titleLength, sizeof(short));
+    send(title.c_str(), titleLength);
+    send(&id, sizeof(int));
     short numItems = (short)items.size();
-    WRITE(outPipe, &numItems, sizeof(short));
+    send(&numItems, sizeof(short));
     for (int i = 0; i < numItems; i++) {
         int buffer[] = {items[i].second, items[i].first.size()};
-        WRITE(outPipe, buffer, 2*sizeof(int));
-        WRITE(outPipe, items[i].first.c_str(), items[i].first.size());
+        send(buffer, 2*sizeof(int));
+        send(items[i].first.c_str(), items[i].first.size());
     }
 }
 
 void VisualizerProtocol::
 addSlider(const String& title, int id, Real minVal, Real maxVal, Real value) {
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &DefineSlider, 1);
+    send(&DefineSlider, 1);
     short titleLength = (short)title.size();
-    WRITE(outPipe, &titleLength, sizeof(short));
-    WRITE(outPipe, title.c_str(), titleLength);
-    WRITE(outPipe, &id, sizeof(int));
+    send(&titleLength, sizeof(short));
+    send(title.c_str(), titleLength);
+    send(&id, sizeof(int));
     float buffer[3];
     buffer[0] = (float) minVal;
     buffer[1] = (float) maxVal;
     buffer[2] = (float) value;
-    WRITE(outPipe, buffer, 3*sizeof(float));
+    send(buffer, 3*sizeof(float));
 }
 
 
 void VisualizerProtocol::setSliderValue(int id, Real newValue) const {
     const float value = (float)newValue;
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetSliderValue, 1);
-    WRITE(outPipe, &id, sizeof(int));
-    WRITE(outPipe, &value, sizeof(float));
+    send(&SetSliderValue, 1);
+    send(&id, sizeof(int));
+    send(&value, sizeof(float));
 }
 
 void VisualizerProtocol::setSliderRange(int id, Real newMin, Real newMax) const {
     float buffer[2];
     buffer[0] = (float)newMin; buffer[1] = (float)newMax;
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetSliderRange, 1);
-    WRITE(outPipe, &id, sizeof(int));
-    WRITE(outPipe, buffer, 2*sizeof(float));
+    send(&SetSliderRange, 1);
+    send(&id, sizeof(int));
+    send(buffer, 2*sizeof(float));
 }
 
 void VisualizerProtocol::setWindowTitle(const String& title) const {
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetWindowTitle, 1);
+    send(&SetWindowTitle, 1);
     short titleLength = (short)title.size();
-    WRITE(outPipe, &titleLength, sizeof(short));
-    WRITE(outPipe, title.c_str(), titleLength);
+    send(&titleLength, sizeof(short));
+    send(title.c_str(), titleLength);
 }
 
 void VisualizerProtocol::setMaxFrameRate(Real rate) const {
     const float frameRate = (float)rate;
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetMaxFrameRate, 1);
-    WRITE(outPipe, &frameRate, sizeof(float));
+    send(&SetMaxFrameRate, 1);
+    send(&frameRate, sizeof(float));
 }
 
 
@@ -735,48 +926,48 @@ void VisualizerProtocol::setBackgroundColor(const Vec3& color) const {
     buffer[1] = (float)color[1]; 
     buffer[2] = (float)color[2];
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetBackgroundColor, 1);
-    WRITE(outPipe, buffer, 3*sizeof(float));
+    send(&SetBackgroundColor, 1);
+    send(buffer, 3*sizeof(float));
 }
 
 void VisualizerProtocol::setShowShadows(bool shouldShow) const {
     const short show = (short)shouldShow; // 0 or 1
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetShowShadows, 1);
-    WRITE(outPipe, &show, sizeof(short));
+    send(&SetShowShadows, 1);
+    send(&show, sizeof(short));
 }
 
 void VisualizerProtocol::setShowFrameRate(bool shouldShow) const {
     const short show = (short)shouldShow; // 0 or 1
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetShowFrameRate, 1);
-    WRITE(outPipe, &show, sizeof(short));
+    send(&SetShowFrameRate, 1);
+    send(&show, sizeof(short));
 }
 
 void VisualizerProtocol::setShowSimTime(bool shouldShow) const {
     const short show = (short)shouldShow; // 0 or 1
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetShowSimTime, 1);
-    WRITE(outPipe, &show, sizeof(short));
+    send(&SetShowSimTime, 1);
+    send(&show, sizeof(short));
 }
 
 void VisualizerProtocol::setShowFrameNumber(bool shouldShow) const {
     const short show = (short)shouldShow; // 0 or 1
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetShowFrameNumber, 1);
-    WRITE(outPipe, &show, sizeof(short));
+    send(&SetShowFrameNumber, 1);
+    send(&show, sizeof(short));
 }
 
 void VisualizerProtocol::setBackgroundType(Visualizer::BackgroundType type) const {
     const short backgroundType = (short)type;
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetBackgroundType, 1);
-    WRITE(outPipe, &backgroundType, sizeof(short));
+    send(&SetBackgroundType, 1);
+    send(&backgroundType, sizeof(short));
 }
 
 void VisualizerProtocol::setCameraTransform(const Transform& X_GC) const {
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetCamera, 1);
+    send(&SetCamera, 1);
     float buffer[6];
     Vec3 rot = X_GC.R().convertRotationToBodyFixedXYZ();
     buffer[0] = (float) rot[0];
@@ -785,17 +976,17 @@ void VisualizerProtocol::setCameraTransform(const Transform& X_GC) const {
     buffer[3] = (float) X_GC.p()[0];
     buffer[4] = (float) X_GC.p()[1];
     buffer[5] = (float) X_GC.p()[2];
-    WRITE(outPipe, buffer, 6*sizeof(float));
+    send(buffer, 6*sizeof(float));
 }
 
 void VisualizerProtocol::zoomCamera() const {
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &ZoomCamera, 1);
+    send(&ZoomCamera, 1);
 }
 
 void VisualizerProtocol::lookAt(const Vec3& point, const Vec3& upDirection) const {
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &LookAt, 1);
+    send(&LookAt, 1);
     float buffer[6];
     buffer[0] = (float) point[0];
     buffer[1] = (float) point[1];
@@ -803,41 +994,41 @@ void VisualizerProtocol::lookAt(const Vec3& point, const Vec3& upDirection) cons
     buffer[3] = (float) upDirection[0];
     buffer[4] = (float) upDirection[1];
     buffer[5] = (float) upDirection[2];
-    WRITE(outPipe, buffer, 6*sizeof(float));
+    send(buffer, 6*sizeof(float));
 }
 
 void VisualizerProtocol::setFieldOfView(Real fov) const {
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetFieldOfView, 1);
+    send(&SetFieldOfView, 1);
     float buffer[1];
     buffer[0] = (float)fov;
-    WRITE(outPipe, buffer, sizeof(float));
+    send(buffer, sizeof(float));
 }
 
 void VisualizerProtocol::setClippingPlanes(Real near, Real far) const {
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetClipPlanes, 1);
+    send(&SetClipPlanes, 1);
     float buffer[2];
     buffer[0] = (float)near;
     buffer[1] = (float)far;
-    WRITE(outPipe, buffer, 2*sizeof(float));
+    send(buffer, 2*sizeof(float));
 }
 
 void VisualizerProtocol::
 setSystemUpDirection(const CoordinateDirection& upDir) {
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetSystemUpDirection, 1);
+    send(&SetSystemUpDirection, 1);
     const unsigned char axis = (unsigned char)upDir.getAxis();
     const signed char   sign = (signed char)upDir.getDirection();
-    WRITE(outPipe, &axis, 1);
-    WRITE(outPipe, &sign, 1);
+    send(&axis, 1);
+    send(&sign, 1);
 }
 
 void VisualizerProtocol::setGroundHeight(Real height) {
     std::lock_guard<std::mutex> lock(sceneMutex);
-    WRITE(outPipe, &SetGroundHeight, 1);
+    send(&SetGroundHeight, 1);
     float heightBuffer = (float) height;
-    WRITE(outPipe, &heightBuffer, sizeof(float));
+    send(&heightBuffer, sizeof(float));
 }
 
 
@@ -28,6 +28,8 @@
 #include "simbody/internal/Visualizer.h"
 #include <utility>
 #include <map>
+#include <vector>
+#include <memory>
 #include <atomic>
 
 /** @file
@@ -37,19 +39,29 @@
 
 // Increment this every time you make *any* change to the protocol;
 // we insist on an exact match.
-static const unsigned ProtocolVersion   = 34;
+static const unsigned ProtocolVersion   = 37;
+
+// A recording Visualizer writes, in place of the startup handshake, this
+// tag followed by the ProtocolVersion, the Simbody version (3 ints) and the
+// executable name (unsigned length then characters). After that comes the
+// same command stream that would have been sent to the GUI. When the
+// recording is closed we append a frame index: one 64-bit file offset per
+// frame (locating its StartOfScene command), the 64-bit frame count, the
+// 64-bit file offset of the index itself, and finally RecordingIndexTag.
+static const char RecordingFileTag[8]  = {'S','i','m','T','K','v','i','z'};
+static const char RecordingIndexTag[8] = {'S','i','m','T','K','i','d','x'};
 
 // The visualizer has several predefined cached meshes for common
 // shapes so that we don't have to send them. These are the mesh 
 // indices for them; they must start with zero.
-static const unsigned short MeshBox              = 0;
-static const unsigned short MeshEllipsoid        = 1;    // works for sphere
-static const unsigned short MeshCylinder         = 2;
-static const unsigned short MeshCircle           = 3;
+static const unsigned MeshBox                    = 0;
+static const unsigned MeshEllipsoid              = 1;    // works for sphere
+static const unsigned MeshCylinder               = 2;
+static const unsigned MeshCircle                 = 3;
 
 // This serves as the first index number for unique meshes that are 
 // defined during this run.
-static const unsigned short NumPredefinedMeshes  = 4;
+static const unsigned NumPredefinedMeshes        = 4;
 
 // Commands sent to the GUI.
 
@@ -57,14 +69,25 @@ static const unsigned short NumPredefinedMeshes  = 4;
 // we're talking to a compatible protocol.
 static const unsigned char StartupHandshake      = 1;
 
+// A StartOfScene command is followed by an unsigned byte count for the
+// rest of the frame (simulated time, scene commands, and EndOfScene), so
+// that the GUI can pick up an entire frame with a single read.
 static const unsigned char StartOfScene          = 2;
 static const unsigned char EndOfScene            = 3;
+// Each of the AddXXXMesh commands draws one or more instances of a cached 
+// mesh. They are followed by three unsigned ints (mesh index, resolution, 
+// number of instances n), then 13*n floats giving each instance's
+// body-fixed XYZ rotation angles, position, scale factors, and RGBA color.
 static const unsigned char AddSolidMesh          = 4;
 static const unsigned char AddPointMesh          = 5;
 static const unsigned char AddWireframeMesh      = 6;
 static const unsigned char AddLine               = 7;
 static const unsigned char AddText               = 8;
 static const unsigned char AddCoords             = 9;
+// DefineMesh is followed by three unsigned ints (number of vertices nv, 
+// number of faces nf, total number of face vertex references nr), then 
+// 3*nv float vertex coordinates, nf unsigned face vertex counts, and nr
+// unsigned vertex indices. Faces are sent as polygons; the GUI triangulates.
 static const unsigned char DefineMesh            = 10;
 static const unsigned char DefineMenu            = 11;
 static const unsigned char DefineSlider          = 12;
@@ -102,10 +125,15 @@ static const unsigned char SliderMoved           = 4;
 namespace SimTK {
 class VisualizerProtocol {
 public:
+    // If recordingFileName is non-empty no GUI is launched; the command
+    // stream is written to that file instead by a background thread.
     VisualizerProtocol(Visualizer& visualizer,
-                       const Array_<String>& searchPath);
+                       const Array_<String>& searchPath,
+                       const String& recordingFileName = String());
     ~VisualizerProtocol();
+    bool isRecording() const {return recorder != nullptr;}
     void shakeHandsWithGUI(int toGUIPipe, int fromGUIPipe);
+    void writeRecordingHeader();
     void shutdownGUI();
     void stopListeningIfNecessary();
     void beginScene(Real simTime);
@@ -154,14 +182,51 @@ public:
     void setFieldOfView(Real fov) const;
     void setClippingPlanes(Real near, Real far) const;
 private:
+    // Add an instance of a cached mesh to the current scene. Instances are
+    // grouped by mesh, resolution and representation and sent to the GUI
+    // by finishScene().
     void drawMesh(const Transform& transform, const Vec3& scale, 
                   const Vec4& color, short representation, 
-                  unsigned short meshIndex, unsigned short resolution);
+                  unsigned meshIndex, unsigned short resolution);
+    void addMeshInstancesToScene();
+    // Append bytes to the frame being built between beginScene() and
+    // finishScene(); nothing is written to the pipe until finishScene().
+    void addToScene(const void* data, size_t len);
+    // Send a command to the GUI, or to the recording file if recording.
+    // Callers must hold sceneMutex except during construction.
+    void send(const void* data, size_t len) const;
     int outPipe;
 
+    // Only present if we are recording to a file rather than talking
+    // to a GUI; defined in VisualizerProtocol.cpp.
+    class Recorder;
+    std::unique_ptr<Recorder> recorder;
+
+    // Encoded contents of the current frame. This is reused from frame to
+    // frame so that it stops allocating once it reaches the size needed
+    // for the largest scene. Guarded by sceneMutex.
+    std::vector<unsigned char> sceneData;
+
     // For user-defined meshes, map their unique memory addresses to the 
     // assigned visualizer cache index.
-    mutable std::map<const void*, unsigned short> meshes;
+    mutable std::map<const void*, unsigned> meshes;
+
+    // Mesh instances drawn so far in the current scene. This is reused from
+    // frame to frame. Guarded by sceneMutex.
+    struct MeshInstance {
+        unsigned char   command;    // AddSolidMesh, etc.
+        unsigned        meshIndex;
+        unsigned        resolution;
+        float           data[13];   // rotation, position, scale, color
+        bool operator<(const MeshInstance& other) const {
+            if (meshIndex != other.meshIndex) 
+                return meshIndex < other.meshIndex;
+            if (resolution != other.resolution)
+                return resolution < other.resolution;
+            return command < other.command;
+        }
+    };
+    std::vector<MeshInstance> meshInstances;
 
     mutable std::mutex sceneMutex;
     // This lock should only be used in beginScene() and finishScene().
@@ -64,6 +64,7 @@ will include this one). **/
 #include "simbody/internal/SmoothSphereHalfSpaceForce.h"
 #include "simbody/internal/DecorationSubsystem.h"
 #include "simbody/internal/TextDataEventReporter.h"
+#include "simbody/internal/BinaryDataEventReporter.h"
 #include "simbody/internal/ObservedPointFitter.h"
 #include "simbody/internal/Assembler.h"
 #include "simbody/internal/AssemblyCondition.h"
@@ -73,6 +74,7 @@ will include this one). **/
 #include "simbody/internal/LocalEnergyMinimizer.h"
 #include "simbody/internal/ContactTrackerSubsystem.h"
 #include "simbody/internal/CompliantContactSubsystem.h"
+#include "simbody/internal/SleepingSubsystem.h"
 #include "simbody/internal/CableTrackerSubsystem.h"
 #include "simbody/internal/CablePath.h"
 #include "simbody/internal/CableSpring.h"
@@ -610,11 +610,17 @@ void setInternalStateFromFreeQs(const Vector& freeQs) {
 }
 
 Vector getFreeQsFromInternalState() const {
-    Vector freeQs(getNumFreeQs());
+    Vector freeQs;
+    getFreeQsFromInternalState(freeQs);
+    return freeQs;
+}
+
+// Same, but reuses the space in freeQs if it is already the right size.
+void getFreeQsFromInternalState(Vector& freeQs) const {
+    freeQs.resize(getNumFreeQs());
     const Vector& q = internalState.getQ();
     for (FreeQIndex fx(0); fx < getNumFreeQs(); ++fx)
         freeQs[fx] = q[getQIndexOfFreeQ(fx)];
-    return freeQs;
 }
 
 void reinitializeWithExtraQsLocked
@@ -683,6 +689,10 @@ class AssemblerSystem; // local class
 mutable AssemblerSystem* asmSys;
 mutable Optimizer*       optimizer;
 
+// The free q's being optimized by track(), kept to avoid reallocating
+// at every frame.
+Vector                   trackFreeQs;
+
 mutable int nAssemblySteps;   // count assemble() and track() calls
 mutable int nInitializations; // # times we had to reinitialize
 
@@ -44,6 +44,13 @@ expect a perfect fit, but you can use these as a set of assembly error
 conditions if there are enough degrees of freedom to achieve a near-perfect 
 solution. 
 
+When used as a required condition (weight Infinity), each marker produces 
+three position error equations, but a body's pose has only six degrees of 
+freedom. So use at most two active markers per body in that case; with three 
+or more the equations are redundant, and inconsistent if the observations are 
+not exactly rigid, which the assembly solver may fail to satisfy. There is no 
+such limit when the markers are used as a goal. 
+
 Markers are defined one at a time and assigned sequential marker index values
 of type Markers::MarkerIx. They may optionally be given unique, case-sensitive
 names, and we will keep a map from name to MarkerIx. A default name will be 
@@ -507,6 +514,19 @@ Array_<Vec3,ObservationIx>      observations;
 // least at the start of the assembly.
 typedef std::map<MobilizedBodyIndex,Array_<MarkerIx> > PerBodyMarkers;
 mutable PerBodyMarkers          bodiesWithMarkers;
+
+// After initialize, this lists the same markers as bodiesWithMarkers, in the
+// same order, along with their bodies and stations. This defines the order
+// of the assembly errors, three per marker.
+mutable Array_<MarkerIx>            activeMarkers;
+mutable Array_<MobilizedBodyIndex>  activeMarkerBodies;
+mutable Array_<Vec3>                activeMarkerStations;
+
+// Temporaries reused from one evaluation to the next so that tracking a
+// sequence of frames doesn't have to allocate memory.
+mutable Matrix                      stationJacobian;
+mutable Vector_<SpatialVec>         dEdR;
+mutable Vector                      uTemp, qTemp;
 };
 
 } // namespace SimTK
@@ -516,6 +516,19 @@ Array_<Rotation,ObservationIx>  observations;
 // least at the start of the assembly.
 typedef std::map<MobilizedBodyIndex,Array_<OSensorIx> > PerBodyOSensors;
 mutable PerBodyOSensors         bodiesWithOSensors;
+
+// After initialize, this lists the same osensors as bodiesWithOSensors, in
+// the same order, along with their bodies. This defines the order of the
+// assembly errors, three per osensor.
+mutable Array_<OSensorIx>           activeOSensors;
+mutable Array_<MobilizedBodyIndex>  activeOSensorBodies;
+mutable Array_<Vec3>                activeOSensorOrigins; // all zero
+
+// Temporaries reused from one evaluation to the next so that tracking a
+// sequence of frames doesn't have to allocate memory.
+mutable Matrix                      frameJacobian;
+mutable Vector_<SpatialVec>         dEdR;
+mutable Vector                      uTemp, qTemp;
 };
 
 } // namespace SimTK
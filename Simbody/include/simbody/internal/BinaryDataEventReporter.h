@@ -0,0 +1,155 @@
+#ifndef SimTK_SIMBODY_BINARY_DATA_EVENT_REPORTER_H_
+#define SimTK_SIMBODY_BINARY_DATA_EVENT_REPORTER_H_
+
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+#include "simbody/internal/common.h"
+
+namespace SimTK {
+
+class MultibodySystem;
+class MobilizedBody;
+
+/** This is an EventReporter which records numeric data at regular intervals
+into a binary file, for simulations that produce too much output for
+TextDataEventReporter. Each channel is a single number recorded at every
+report; the available channels are the generalized coordinates q, the
+generalized speeds u, any Real-valued Measure, and the pose of any body.
+Time is always recorded as the first channel.
+
+The simulation thread only copies the values into a block of memory. Full
+blocks are handed to a background thread, without locking, to be written
+to the file, so formatting and file output don't slow the simulation down.
+Use it like this:
+@code
+    BinaryDataEventReporter* reporter =
+        new BinaryDataEventReporter(system, "run.bin", 0.001);
+    reporter->addQ();
+    reporter->addMeasure(energy, "energy");
+    reporter->addBodyPose(pelvis, "pelvis");
+    system.addEventReporter(reporter); // system takes ownership
+    // ... run the simulation
+    reporter->close(); // or wait until the System is destroyed
+
+    BinaryDataEventReporter::Reader data("run.bin");
+    Vector energyHistory = data.getChannel(data.findChannelIndex("energy"));
+@endcode
+
+<h3>File format</h3>
+All values are stored in the byte order of the machine that wrote them. The
+file starts with the 8 characters "SimTKbin", then a 32-bit version number
+(currently 1) and a 32-bit channel count n. Each channel name follows as a
+32-bit length and that many characters. The rest of the file is a sequence
+of blocks, each starting with a 32-bit row count m, then the m values of
+channel 0 as doubles, then the m values of channel 1, and so on. Every block
+but the last has the same number of rows. **/
+class SimTK_SIMBODY_EXPORT BinaryDataEventReporter
+:   public PeriodicEventReporter {
+public:
+    class Reader;
+
+    /** Create a reporter that records into the file \a fileName (replacing
+    it if it exists) every \a reportInterval time units. Rows are written to
+    the file in blocks of \a rowsPerBlock. Add channels before the first
+    report. **/
+    BinaryDataEventReporter(const MultibodySystem&  system,
+                            const String&           fileName,
+                            Real                    reportInterval,
+                            int                     rowsPerBlock = 1024);
+
+    /** The destructor writes any rows not yet in the file and closes it, as
+    close() does, but without looking at the System, which may already be
+    partly destroyed. So if nothing was reported the file has no q or u
+    channels. **/
+    ~BinaryDataEventReporter();
+
+    /** Record all the generalized coordinates, as channels named "q0",
+    "q1", and so on. **/
+    void addQ();
+    /** Record all the generalized speeds, as channels named "u0", "u1", and
+    so on. **/
+    void addU();
+    /** Record the value of a Real-valued Measure, as a channel with the given
+    \a name. The Measure's value must be available in the reported State. **/
+    void addMeasure(const Measure& measure, const String& name);
+    /** Record the pose of a body in Ground as seven channels: the
+    orientation as a quaternion, named name.qw, name.qx, name.qy, name.qz,
+    then the origin location, named name.px, name.py, name.pz. **/
+    void addBodyPose(const MobilizedBody& body, const String& name);
+
+    /** Write any rows not yet in the file, stop the writing thread, and
+    close the file. Nothing more is recorded after this. It is harmless to
+    call this more than once. The channels are fixed by the first report; if
+    there wasn't one, the numbers of q's and u's are obtained from the 
+    System if its topology has been realized. **/
+    void close();
+
+    /** Return the number of rows recorded so far, including those not yet
+    written. **/
+    int getNumRows() const;
+
+    /** This is the implementation of the EventReporter virtual. **/
+    void handleEvent(const State& state) const override;
+
+    class Impl;
+protected:
+    Impl* impl;
+    const Impl& getImpl() const {assert(impl); return *impl;}
+    Impl&       updImpl() const {assert(impl); return *impl;}
+};
+
+/** This reads a file written by a BinaryDataEventReporter into memory. **/
+class SimTK_SIMBODY_EXPORT BinaryDataEventReporter::Reader {
+public:
+    /** Read the whole of the file \a fileName. An exception is thrown if the
+    file can't be read or isn't in the expected format. **/
+    explicit Reader(const String& fileName);
+
+    /** Return the number of channels, including time. **/
+    int getNumChannels() const {return (int)m_names.size();}
+    /** Return the name of channel \a i; channel 0 is "time". **/
+    const String& getChannelName(int i) const {return m_names[i];}
+    /** Return the index of the channel with the given \a name, or -1 if
+    there is none. **/
+    int findChannelIndex(const String& name) const;
+
+    /** Return the number of rows (reports) in the file. **/
+    int getNumRows() const {return m_data.nrow();}
+    /** Return the recorded values of channel \a i. **/
+    VectorView getChannel(int i) const {return m_data(i);}
+    /** Return the report times; the same as getChannel(0). **/
+    VectorView getTimes() const {return m_data(0);}
+    /** Return all the data, with one row per report and one column per
+    channel. **/
+    const Matrix& getData() const {return m_data;}
+
+private:
+    Array_<String>  m_names;
+    Matrix          m_data;
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SIMBODY_BINARY_DATA_EVENT_REPORTER_H_
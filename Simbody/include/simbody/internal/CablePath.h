@@ -160,6 +160,19 @@ may be initiated if necessary the first time this is called at this state
 but will be saved in the cache for subsequent accesses. **/
 Real getCableLengthDot(const State& state) const;
 
+/** Return the number of Newton iterations that were needed to solve for this
+cable's path in the configuration supplied in \a state. Each solution starts
+from the path found at the previous step, so during a smooth simulation this
+is usually small. State must have been realized through Position stage. **/
+int getNumPathSolverIterations(const State& state) const;
+
+/** Return the CPU time in seconds that was spent solving for this cable's
+path in the configuration supplied in \a state. This is measured on the 
+thread that solved the path (see CableTrackerSubsystem::setNumThreads()), so
+the times for all the cables add up to the total work even when the cables are
+solved concurrently. State must have been realized through Position stage. **/
+Real getPathSolverCPUTime(const State& state) const;
+
 /** Given a tension > 0 acting uniformly along this cable, apply the resulting
 forces to the bodies it touches. The body forces are added into the appropriate
 slots in the supplied Array which has one entry per body in the same format
@@ -80,6 +80,18 @@ const CablePath& getCablePath(CablePathIndex cableIx) const;
 /** Get writable access to a particular cable path. **/
 CablePath& updCablePath(CablePathIndex cableIx);
 
+/** Set the number of threads used to solve for the cable paths at Position
+stage and their rates at Velocity stage. The default is 1. Each cable path
+depends only on the poses and velocities of the bodies carrying its own 
+obstacles, so with more threads the paths are solved concurrently, each in
+its own cache entries and starting from its own previous solution. The 
+results are identical to those obtained with a single thread. This is not a
+topological change. **/
+void setNumThreads(int numThreads);
+/** Get the number of threads used to solve for the cable paths.
+@see setNumThreads() **/
+int getNumThreads() const;
+
 /** @cond **/ // Hide from Doxygen.
 SimTK_PIMPL_DOWNCAST(CableTrackerSubsystem, Subsystem);
 class Impl;
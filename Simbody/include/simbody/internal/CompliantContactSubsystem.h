@@ -85,10 +85,23 @@ has not been set.
 @see getDissipatedEnergy(),setDissipatedEnergy(),setTrackDissipatedEnergy() **/
 bool getTrackDissipatedEnergy() const;
 
+/** Set the number of threads used to calculate contact forces. The default is
+1. With more threads the active contacts are divided into contiguous chunks
+that are processed concurrently, each into its own list of forces; the lists
+are then joined in chunk order so the results are identical to those computed
+with a single thread. Every ContactForceGenerator in use must then be safe to
+call from several threads at once; the built-in ones are. This is not a
+topological change. **/
+void setNumThreads(int numThreads);
+/** Get the number of threads used to calculate contact forces.
+@see setNumThreads() **/
+int getNumThreads() const;
+
 /** Determine how many of the active Contacts are currently generating
 contact forces. You can call this at Velocity stage or later; the contact
 forces will be realized first if necessary before we report how many there 
-are. **/
+are. Contacts between bodies that are asleep (see SleepingSubsystem) or 
+Ground don't generate forces. **/
 int getNumContactForces(const State& state) const;
 /** For each active Contact, get a reference to the most recently calculated
 force there; the ContactId that produced this force is available from the
@@ -622,6 +635,7 @@ class HertzElliptical;          // for EllipticalPointContact
 // Penalty-based models enforcing non-penetration but without attempting
 // to model the contacting materials physically.
 class BrickHalfSpacePenalty;    // for BrickHalfSpaceContact
+class ConvexHullPenalty;        // for ConvexHullContact
 
 // These are for response to unknown ContactTypeIds.
 class DoNothing;     // do nothing if called
@@ -773,6 +787,34 @@ void calcContactPatch
 
 
 
+//==============================================================================
+//                          CONVEX HULL GENERATOR
+//==============================================================================
+
+/** This ContactForceGenerator handles contact between a convex hull and a 
+half-space or another convex hull. It applies the same penalty model as
+BrickHalfSpacePenalty at each point of the ConvexHullContact. **/
+class SimTK_SIMBODY_EXPORT ContactForceGenerator::ConvexHullPenalty 
+:   public ContactForceGenerator {
+public:
+ConvexHullPenalty() 
+:   ContactForceGenerator(ConvexHullContact::classTypeId()) {}
+
+void calcContactForce
+   (const State&            state,
+    const Contact&          overlapping,
+    const SpatialVec&       V_S1S2,
+    ContactForce&           contactForce) const override;
+
+void calcContactPatch
+   (const State&            state,
+    const Contact&          overlapping,
+    const SpatialVec&       V_S1S2,
+    ContactPatch&           patch) const override;
+};
+
+
+
 //==============================================================================
 //                       ELASTIC FOUNDATION GENERATOR
 //==============================================================================
@@ -807,14 +849,14 @@ void calcContactForceAndDetails
 
 void calcWeightedPatchCentroid
    (const ContactGeometry::TriangleMesh&    mesh,
-    const std::set<int>&                    insideFaces,
+    const Array_<int>&                      insideFaces,
     Vec3&                                   weightedPatchCentroid,
     Real&                                   patchArea) const;
                        
 void processOneMesh
    (const State&                            state,
     const ContactGeometry::TriangleMesh&    mesh,
-    const std::set<int>&                    insideFaces,
+    const Array_<int>&                      insideFaces,
     const Transform&                        X_MO, 
     const SpatialVec&                       V_MO,
     const ContactGeometry&                  other,
@@ -175,6 +175,13 @@ public:
     virtual bool isProximal(const State& state, Real ptol) const 
     {   return m_sign*getPerr(state) <= ptol; }
 
+    /** Return true if this contact can't move because every mobilizer 
+    between Ground and the bodies it connects is locked, as it is for bodies
+    that a SleepingSubsystem has put to sleep. No impulse could change the 
+    velocities of such a contact, so a TimeStepper can leave it out of its 
+    impulse problem. The default implementation returns false. **/
+    virtual bool isLocked(const State& state) const {return false;}
+
     /** Return the multiplier index Simbody assigned for the unilateral 
     contact constraint (for contact, this is the normal constraint). If the
     constraint is not enabled, there is no multiplier and the returned index
@@ -221,6 +228,12 @@ public:
 
     void setMyIndex(UnilateralContactIndex cx) {m_myIx = cx;}
     UnilateralContactIndex getMyIndex() const {return m_myIx;}
+protected:
+    /** Return true if every mobilizer between Ground and the bodies or 
+    mobilizers restricted by the given \a constraint is locked; derived
+    classes use this to implement isLocked(). **/
+    static bool isConstraintLocked(const State&       state, 
+                                   const Constraint&  constraint);
 private:
     Real                    m_sign; // 1 or -1
     UnilateralContactIndex  m_myIx;
@@ -353,6 +366,9 @@ public:
     bool isEnabled(const State& state) const override 
     {   return !m_upper.isDisabled(state); }
 
+    bool isLocked(const State& state) const override
+    {   return isConstraintLocked(state, m_upper); }
+
     // Returns the contact point in the Ground frame.
     Vec3 whereToDisplay(const State& state) const override;
 
@@ -411,6 +427,9 @@ public:
     bool isEnabled(const State& state) const override 
     {   return !m_lower.isDisabled(state); }
 
+    bool isLocked(const State& state) const override
+    {   return isConstraintLocked(state, m_lower); }
+
     // Returns the contact point in the Ground frame.
     Vec3 whereToDisplay(const State& state) const override;
 
@@ -471,6 +490,9 @@ public:
     bool isEnabled(const State& state) const override 
     {   return !m_rod.isDisabled(state); }
 
+    bool isLocked(const State& state) const override
+    {   return isConstraintLocked(state, m_rod); }
+
     // Returns half-way location in the Ground frame.
     Vec3 whereToDisplay(const State& state) const override;
 
@@ -526,6 +548,10 @@ public:
         return !m_ptInPlane.isDisabled(state);
     }
 
+    bool isLocked(const State& state) const override {
+        return isConstraintLocked(state, m_ptInPlane);
+    }
+
     // Returns the contact point in the Ground frame.
     Vec3 whereToDisplay(const State& state) const override;
 
@@ -598,6 +624,10 @@ public:
         return !m_ptInPlane.isDisabled(state);
     }
 
+    bool isLocked(const State& state) const override {
+        return isConstraintLocked(state, m_ptInPlane);
+    }
+
     // Returns the contact point in the Ground frame.
     Vec3 whereToDisplay(const State& state) const override;
 
@@ -690,6 +720,10 @@ public:
         return !m_sphereOnPlane.isDisabled(state);
     }
 
+    bool isLocked(const State& state) const override {
+        return isConstraintLocked(state, m_sphereOnPlane);
+    }
+
     // Returns the contact point in the Ground frame.
     Vec3 whereToDisplay(const State& state) const override;
 
@@ -780,6 +814,10 @@ public:
         return !m_sphereOnSphere.isDisabled(state);
     }
 
+    bool isLocked(const State& state) const override {
+        return isConstraintLocked(state, m_sphereOnSphere);
+    }
+
     // Returns the contact point in the Ground frame.
     Vec3 whereToDisplay(const State& state) const override;
 
@@ -876,6 +914,10 @@ public:
         return !m_lineOnLine.isDisabled(state);
     }
 
+    bool isLocked(const State& state) const override {
+        return isConstraintLocked(state, m_lineOnLine);
+    }
+
     // Returns the contact point in the Ground frame.
     Vec3 whereToDisplay(const State& state) const override;
 
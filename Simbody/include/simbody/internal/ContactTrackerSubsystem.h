@@ -218,6 +218,19 @@ const Transform& getContactSurfaceTransform(ContactSurfaceIndex surfIx) const;
 /**@}**/
 
 
+/**@name                          Sleeping bodies
+Bodies that are known not to be moving can be marked as asleep; normally that
+is done by a SleepingSubsystem. A pair of contact surfaces on sleeping bodies
+or Ground is not tracked: an existing Contact between them is carried over
+unchanged and no new Contact is looked for. **/
+/**@{**/
+/** Mark a mobilized body as asleep or awake. This is an Instance stage 
+change. Ground is always considered to be at rest so it can't be marked. **/
+void setBodyAsleep(State& state, MobilizedBodyIndex mobod, bool asleep) const;
+/** Return true if the given mobilized body has been marked as asleep. **/
+bool isBodyAsleep(const State& state, MobilizedBodyIndex mobod) const;
+/**@}**/
+
 /**@name                     Contact Tracker management
 Most users won't need to use these methods. **/
 /**@{**/
@@ -167,12 +167,70 @@ public:
     }
 
     void clearStats(int phase) const {
-        SimTK_ERRCHK2(0<=phase&&phase<MaxNumPhases,
-            "ImpulseSolver::clearStats(phase)",
-            "Phase must be 0..%d but was %d\n", MaxNumPhases-1, phase);
+        checkPhase(phase, "ImpulseSolver::clearStats(phase)");
         m_nSolves[phase] = m_nIters[phase] = m_nFail[phase] = 0;
+        m_solveTime[phase] = 0;
+    }
+
+    /** Get the number of calls to solve() for this phase since the stats
+    were last cleared. **/
+    long long getNumSolves(int phase) const 
+    {   checkPhase(phase, "ImpulseSolver::getNumSolves(phase)");
+        return m_nSolves[phase]; }
+    /** Get the total number of iterations taken by solve() for this phase;
+    the meaning of an iteration depends on the concrete solver. **/
+    long long getNumIterations(int phase) const 
+    {   checkPhase(phase, "ImpulseSolver::getNumIterations(phase)");
+        return m_nIters[phase]; }
+    /** Get the number of calls to solve() for this phase that failed to
+    converge. **/
+    long long getNumFailures(int phase) const 
+    {   checkPhase(phase, "ImpulseSolver::getNumFailures(phase)");
+        return m_nFail[phase]; }
+    /** Get the total elapsed (wall clock) time in seconds spent in solve()
+    for this phase. **/
+    double getSolveTime(int phase) const 
+    {   checkPhase(phase, "ImpulseSolver::getSolveTime(phase)");
+        return m_solveTime[phase]; }
+
+    long long getNumBilateralSolves() const {return m_nBilateralSolves;}
+    long long getNumBilateralIterations() const {return m_nBilateralIters;}
+    long long getNumBilateralFailures() const {return m_nBilateralFail;}
+
+    /** Add the stats accumulated by another solver into this one's, for
+    example from a clone() that was used on another thread. **/
+    void addStats(const ImpulseSolver& other) const {
+        for (int i=0; i < MaxNumPhases; ++i) {
+            m_nSolves[i]   += other.m_nSolves[i];
+            m_nIters[i]    += other.m_nIters[i];
+            m_nFail[i]     += other.m_nFail[i];
+            m_solveTime[i] += other.m_solveTime[i];
+        }
+        m_nBilateralSolves += other.m_nBilateralSolves;
+        m_nBilateralIters  += other.m_nBilateralIters;
+        m_nBilateralFail   += other.m_nBilateralFail;
     }
 
+    /** Return a new copy of this solver, with cleared stats, that can be used
+    to solve a separate problem at the same time as this one is used on
+    another thread. Returns null if the concrete solver doesn't support that,
+    which is the default. The caller owns the returned object. **/
+    virtual ImpulseSolver* clone() const {return nullptr;}
+
+    /** Forget any information saved from previous solves that would be used
+    to speed up the next one, such as a warm start guess. Call this when 
+    starting a new simulation. The default implementation does nothing. **/
+    virtual void clearWarmStart() const {}
+
+    /** Forget any information saved from previous solves about unilateral
+    contacts other than the given ones. A time stepper calls this at the start
+    of each step with the contacts that may take part in it, so that a contact
+    doesn't later start from what was saved for it, or for another contact
+    with the same index, before it dropped out. The default implementation
+    does nothing. **/
+    virtual void retainWarmStart
+       (const Array_<UnilateralContactIndex>& uniContacts) const {}
+
     /** Solve. **/
     virtual bool solve
        (int                                 phase,
@@ -233,6 +291,11 @@ public:
                                 const Array_<UniContactRT>& uniContacts);
 
 protected:
+    void checkPhase(int phase, const char* methodName) const {
+        SimTK_ERRCHK2(0<=phase&&phase<MaxNumPhases, methodName,
+            "Phase must be 0..%d but was %d\n", MaxNumPhases-1, phase);
+    }
+
     Real m_maxRollingTangVel; // Sliding above this speed if solver cares.
     Real m_convergenceTol;    // Meaning depends on concrete solver.
     int  m_maxIters;          // Meaning depends on concrete solver.
@@ -240,6 +303,7 @@ protected:
     mutable long long m_nSolves[MaxNumPhases];
     mutable long long m_nIters[MaxNumPhases];
     mutable long long m_nFail[MaxNumPhases];
+    mutable double    m_solveTime[MaxNumPhases]; // seconds
     mutable long long m_nBilateralSolves;
     mutable long long m_nBilateralIters;
     mutable long long m_nBilateralFail;
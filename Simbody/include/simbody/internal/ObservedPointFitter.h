@@ -115,6 +115,64 @@ public:
                     tolerance);
     }
 
+    /**
+     * Improve the fit of a MultibodySystem to a set of target locations for stations, starting from the
+     * configuration already in \a state. Unlike findBestFit(), this makes no attempt to find a good starting
+     * guess, so it is only suitable when \a state is already close to the answer, for example when tracking
+     * a marker trajectory where the previous frame's solution is the starting point for the next frame. In
+     * that case it is much faster than findBestFit(). It uses Levenberg-Marquardt iterations on the weighted
+     * station errors, with derivatives from SimbodyMatterSubsystem::calcStationJacobian(). Position
+     * constraints other than quaternion normalization are ignored.
+     *
+     * The arguments and return value are the same as for findBestFit(). Iteration stops when a step moves the
+     * stations by less than 1% of \a tolerance (RMS), or when no further improvement is possible.
+     */
+
+    static Real refineFit
+       (const MultibodySystem&             system, 
+        State&                             state, 
+        const Array_<MobilizedBodyIndex>&  bodyIxs, 
+        const Array_<Array_<Vec3> >&       stations, 
+        const Array_<Array_<Vec3> >&       targetLocations, 
+        const Array_<Array_<Real> >&       weights, 
+        Real                               tolerance=0.001);
+
+    /**
+     * Find the best fit configuration for every frame of a trajectory of target locations. The first frame is
+     * solved with findBestFit(), starting from \a initialState; each later frame is solved with refineFit(),
+     * starting from the solution for the frame before it.
+     *
+     * With more than one thread the frames are split into that many contiguous segments. The first frame of
+     * each segment is solved with findBestFit(), one segment after another, and then the rest of the segments'
+     * frames are solved concurrently. Since each segment starts afresh, the results can differ slightly from
+     * those obtained with a single thread.
+     *
+     * @param system          the MultibodySystem being analyzed
+     * @param initialState    the starting guess for the first frame; it also supplies everything but the q's
+     *                        in the output States
+     * @param bodyIxs         as for findBestFit()
+     * @param stations        as for findBestFit()
+     * @param targetTrajectory    targetTrajectory[k] gives the target locations for frame k, in the same form
+     *                        as the \a targetLocations argument of findBestFit()
+     * @param weights         as for findBestFit()
+     * @param states          on exit, states[k] holds the best fit for frame k
+     * @param errors          on exit, errors[k] is the RMS distance of the stations from their targets in frame k
+     * @param tolerance       as for findBestFit()
+     * @param numThreads      the number of threads to use
+     */
+
+    static void findBestFitTrajectory
+       (const MultibodySystem&                     system, 
+        const State&                               initialState, 
+        const Array_<MobilizedBodyIndex>&          bodyIxs, 
+        const Array_<Array_<Vec3> >&               stations, 
+        const Array_<Array_<Array_<Vec3> > >&      targetTrajectory, 
+        const Array_<Array_<Real> >&               weights, 
+        Array_<State>&                             states, 
+        Array_<Real>&                              errors, 
+        Real                                       tolerance=0.001,
+        int                                        numThreads=1);
+
 
 private:
     static void createClonedSystem(const MultibodySystem& original, MultibodySystem& copy, const Array_<MobilizedBodyIndex>& originalBodyIxs, Array_<MobilizedBodyIndex>& copyBodyIxs, bool& hasArtificialBaseBody);
@@ -122,6 +180,8 @@ private:
     static void findDownstreamBodies(MobilizedBodyIndex currentBodyIx, const Array_<int> numStations, const Array_<Array_<MobilizedBodyIndex> > children, Array_<MobilizedBodyIndex>& bodyIxs, int& requiredStations);
     static int findBodiesForClonedSystem(MobilizedBodyIndex primaryBodyIx, const Array_<int> numStations, const SimbodyMatterSubsystem& matter, const Array_<Array_<MobilizedBodyIndex> > children, Array_<MobilizedBodyIndex>& bodyIxs);
     class OptimizerFunction;
+    class LeastSquaresFitter;
+    class TrajectorySegmentTask;
 };
 
 } // namespace SimTK
@@ -26,6 +26,9 @@
 
 #include "simbody/internal/ImpulseSolver.h"
 
+#include <memory>
+#include <mutex>
+
 namespace SimTK {
 
 /** Projected Gauss Seidel impulse solver.
@@ -50,6 +53,29 @@ When piUnknown_z[k] hits its upper limit of 0, we must have v_z[k] >= 0
 depends on all diag(A)[z[k]] > 0. That means that if v_z[k]<0 we could improve
 the solution by making piUnknown_z[k] negative, so it wouldn't have hit the
 limit.
+
+<h3>Warm starting</h3>
+By default the multipliers of each unilateral contact are initialized from the
+impulse that was found for that same contact (identified by its 
+UnilateralContactIndex) the last time it was solved for the same phase. In a
+time stepping simulation the contact impulses change slowly from step to step
+so this usually cuts the number of iterations dramatically. Contacts that were
+not participating the last time they were solved start from zero, as do those
+that were left out of a step since then (see retainWarmStart()). Copies made
+with clone() share the saved impulses, so a problem may be split into 
+independent pieces that are solved by different copies. Call clearWarmStart()
+to forget the saved impulses, or setUseWarmStart(false) to always start from
+zero.
+
+<h3>Parallel sweeps</h3>
+If you set more than one thread with setNumThreads(), the unilateral contacts
+are colored so that no two contacts of the same color are coupled through the
+matrix A (that is, they share no mobilities), and then all the contacts of one
+color are updated concurrently. The contacts are visited one color after
+another rather than in their given order, so the iterates differ from those of
+the single-threaded sweep, but the result does not depend on the number of 
+threads. Coloring costs about as much as one sweep so this pays off only for
+problems with many contacts.
 **/
 
 class SimTK_SIMBODY_EXPORT PGSImpulseSolver : public ImpulseSolver {
@@ -58,7 +84,44 @@ public:
     :   ImpulseSolver(roll2slipTransitionSpeed,
                       1e-6, // default PGS convergence tolerance
                       100), // default PGS max number iterations
-        m_SOR(1.2) {}
+        m_SOR(1.2), m_useWarmStart(true), m_numThreads(1),
+        m_warmStart(std::make_shared<WarmStart>()) {}
+
+    /** The copy shares this solver's saved warm start impulses. **/
+    PGSImpulseSolver* clone() const override {
+        PGSImpulseSolver* copy = new PGSImpulseSolver(*this);
+        copy->clearStats();
+        return copy;
+    }
+
+    /** Enable or disable warm starting from the impulses found in the 
+    previous solve; it is on by default. **/
+    void setUseWarmStart(bool useWarmStart) {m_useWarmStart = useWarmStart;}
+    bool getUseWarmStart() const {return m_useWarmStart;}
+
+    /** Forget the saved contact impulses so that the next solve for each 
+    phase starts from zero. **/
+    void clearWarmStart() const override {
+        std::lock_guard<std::mutex> lock(m_warmStart->mutex);
+        for (int i=0; i < MaxNumPhases; ++i)
+            m_warmStart->impulses[i].clear();
+    }
+
+    /** Forget the saved impulses of all unilateral contacts except the given
+    ones. **/
+    void retainWarmStart
+       (const Array_<UnilateralContactIndex>& uniContacts) const override;
+
+    /** Set the number of threads to use for the unilateral contact sweeps.
+    The default is 1, which uses the original serial sweep. **/
+    void setNumThreads(int numThreads) {
+        SimTK_APIARGCHECK1_ALWAYS(numThreads > 0, "PGSImpulseSolver",
+            "setNumThreads", "Number of threads must be positive but was %d.",
+            numThreads);
+        if (numThreads != m_numThreads) m_executor.reset();
+        m_numThreads = numThreads;
+    }
+    int getNumThreads() const {return m_numThreads;}
 
     /** Solve with conditional constraints. In the common underdetermined
     case (redundant contact) we will return the first solution encountered but
@@ -95,7 +158,44 @@ public:
         ) const override;
 
 private:
+    // Initialize pi for participating unilateral contacts from the impulses
+    // saved for this phase, then save the new ones after solving.
+    void applyWarmStart(int phase, const Array_<UniContactRT>& uniContact,
+                        Vector& pi) const;
+    void saveWarmStart(int phase, const Array_<UniContactRT>& uniContact,
+                       const Vector& pi) const;
+
+    // Perform one multithreaded sweep over the unilateral contacts, one
+    // color at a time. Returns the squared errors in sum2all and sum2enf.
+    void sweepColoredContacts(const Array_<MultiplierIndex>& participating,
+                              const Matrix& A, const Vector& D,
+                              const Vector& rhs, const Vector& piExpand,
+                              Real sor, Array_<UniContactRT>& uniContact,
+                              Vector& pi, Real& sum2all, Real& sum2enf) const;
+    void colorContacts(const Array_<MultiplierIndex>& participating,
+                       const Matrix& A,
+                       const Array_<UniContactRT>& uniContact) const;
+
     Real m_SOR; 
+    bool m_useWarmStart;
+    int  m_numThreads;
+
+    // Saved impulses (friction x, friction y, normal) for each phase, indexed
+    // by UnilateralContactIndex; NaN if the multiplier did not participate.
+    // This is shared by clones, which may be running on other threads.
+    struct WarmStart {
+        std::mutex      mutex;
+        Array_<Vec3>    impulses[MaxNumPhases];
+        Array_<bool>    retain; // temporary for retainWarmStart()
+    };
+    std::shared_ptr<WarmStart> m_warmStart;
+
+    // Contact coloring for the current solve(); see colorContacts().
+    mutable Array_<Array_<int> >        m_colors;       // contacts by color
+    mutable Array_<int>                 m_contactColor; // -1 if not colored
+    mutable Array_<int>                 m_multContact;  // owner, or -1
+    mutable Array_<Real>                m_er2all, m_er2enf; // per contact
+    mutable ClonePtr<ParallelExecutor>  m_executor;
 };
 
 } // namespace SimTK
@@ -41,6 +41,12 @@ public:
         m_cosMaxSlidingDirChange(std::cos(Pi/6)) // 30 degrees
     {}
 
+    PLUSImpulseSolver* clone() const override {
+        PLUSImpulseSolver* copy = new PLUSImpulseSolver(*this);
+        copy->clearStats();
+        return copy;
+    }
+
     /** Solve with conditional constraints. **/
     bool solve
        (int                                 phase,
@@ -31,6 +31,8 @@
 #include "simbody/internal/PGSImpulseSolver.h"
 #include "simbody/internal/PLUSImpulseSolver.h"
 
+#include <functional>
+
 namespace SimTK {
 
 /** A low-accuracy, high performance, velocity-level time stepper for
@@ -44,6 +46,18 @@ solve the constraint equations and satisfy all the constraint inequalities.
 Generally there are multiple solutions possible, and different ImpulseSolver
 objects use different criteria.
 
+The constraints are split into independent "islands" that share no
+mobilities, such as separate objects resting on the ground. Only each island's
+diagonal block of the projected inverse mass matrix G M\ ~G is formed, and
+each island is solved separately, optionally with several islands at once on
+different threads; see setNumThreads().
+
+Events are handled at the end of each step rather than localized: scheduled
+events whose time was reached during the step, and triggered events whose 
+witness functions (those realized by Stage::Dynamics) made a transition they 
+are waiting for. Unilateral contacts whose bodies are all locked, for example
+by a SleepingSubsystem, are left out of the step's impulse problem.
+
 A variety of options are available for different methods of handling impacts,
 to facilitate comparison of methods. For production, we recommend using the
 default options.
@@ -101,9 +115,16 @@ public:
     Real getAdvancedTime() const {return m_state.getTime();}
 
     /** Advance to the indicated time in one or more steps, using repeated
-    induced impacts. **/
+    induced impacts. Events that occurred during the step are handled at its
+    end. If an event handler asks for the simulation to terminate this 
+    returns Integrator::EndOfSimulation and isSimulationOver() becomes true;
+    stepTo() may not be called again until the next initialize(). **/
     Integrator::SuccessfulStepStatus stepTo(Real time);
 
+    /** Return true if an event handler has asked for the simulation to 
+    terminate since the last initialize(). **/
+    bool isSimulationOver() const {return m_isSimulationOver;}
+
     /** Set integration accuracy; requires variable length steps. **/
     void setAccuracy(Real accuracy) {m_accuracy=accuracy;}
     /** Set the tolerance to which constraints must be satisfied. **/
@@ -151,6 +172,22 @@ public:
     ImpulseSolverType getImpulseSolverType() const 
     {   return m_solverType; }
 
+    /** Set the number of threads used to solve independent islands of
+    constraints concurrently. The default is 1. Each thread uses its own copy
+    of the ImpulseSolver made with ImpulseSolver::clone(), and their stats are
+    added into the ImpulseSolver's stats; if the solver can't be cloned the
+    islands are solved one at a time. The multithreading options of the
+    ImpulseSolver itself (if any) still apply within each island. **/
+    void setNumThreads(int numThreads) {
+        SimTK_APIARGCHECK1_ALWAYS(numThreads > 0, 
+            "SemiExplicitEulerTimeStepper", "setNumThreads",
+            "Number of threads must be positive but was %d.", numThreads);
+        if (numThreads != m_numThreads) 
+        {   m_executor.reset(); clearSolverClones(); }
+        m_numThreads = numThreads;
+    }
+    int getNumThreads() const {return m_numThreads;}
+
     /** Set the impact capture velocity to be used by default when a contact
     does not provide its own. This is the impact velocity below which the
     coefficient of restitution is to be treated as zero. This avoids a Zeno's
@@ -264,6 +301,17 @@ public:
             "No solver is currently allocated.");
         return *m_solver;
     }
+    /** (Advanced) Get writable access to the ImpulseSolver, for example to
+    change its settings. The copies of the solver used on other threads (see
+    setNumThreads()) are remade at the next step to pick up the changes, so
+    call this again for changes made after that. **/
+    ImpulseSolver& updImpulseSolver() {
+        SimTK_ERRCHK_ALWAYS(m_solver!=0, 
+            "SemiExplicitEulerTimeStepper::updImpulseSolver()",
+            "No solver is currently allocated.");
+        clearSolverClones();
+        return *m_solver;
+    }
     /** (Advanced) Set your own ImpulseSolver; the %TimeStepper takes over
     ownership so don't delete afterwards! **/
     void setImpulseSolver(ImpulseSolver* impulseSolver) {
@@ -272,6 +320,7 @@ public:
     }
     /** (Advanced) Delete the existing ImpulseSolver if any. **/
     void clearImpulseSolver() {
+        clearSolverClones();
         delete m_solver; m_solver=0;
     }
 
@@ -302,6 +351,14 @@ private:
     // Easy if there are no constraints active.
     void takeUnconstrainedStep(State& s, Real h);
 
+    // Handle the events that occurred during the step just taken, leaving 
+    // the State realized through Stage::Dynamics. Returns true if a handler
+    // asked for the simulation to terminate.
+    bool handleEvents(State& s);
+    // Record the event trigger values and the next scheduled event time, 
+    // against which the end of the next step is compared.
+    void findNextEvents(const State& s);
+
     // If we're in Newton restitution mode, calculating the verr change
     // that is needed to represent restitution. Output must already be
     // the same size as verr on entry if we're in Newton mode.
@@ -387,6 +444,44 @@ private:
                                    Vector&      pverr, // in/out
                                    Vector&      positionImpulse);
 
+    // Partition the m proximal constraint multipliers into islands that have
+    // no coupling through G M\ ~G and calculate each island's block of that
+    // matrix.
+    void findIslands(const State& state, int m);
+
+    // These take the place of the ImpulseSolver's solve() and 
+    // solveBilateral() methods, using the island blocks for A. The problem
+    // is split into islands that are solved separately and then the results
+    // are put back together.
+    bool solveIslands
+       (int                                                 phase,
+        const Array_<MultiplierIndex>&                      participating,
+        const Array_<MultiplierIndex>&                      expanding,
+        Vector&                                             piExpand,
+        Vector&                                             verrStart,
+        Vector&                                             verrApplied,
+        Vector&                                             pi,
+        Array_<ImpulseSolver::UncondRT>&                    unconditional,
+        Array_<ImpulseSolver::UniContactRT>&                uniContact,
+        Array_<ImpulseSolver::UniSpeedRT>&                  uniSpeed,
+        Array_<ImpulseSolver::BoundedRT>&                   bounded,
+        Array_<ImpulseSolver::ConstraintLtdFrictionRT>&     consLtdFriction,
+        Array_<ImpulseSolver::StateLtdFrictionRT>&          stateLtdFriction);
+    bool solveIslandsBilateral(const Array_<MultiplierIndex>& participating,
+                               const Vector&                  rhs,
+                               Vector&                        pi);
+
+    // Call solveIsland(solver,i) for every island i, using multiple threads
+    // if requested. Each call gets a solver that no other thread is using.
+    void forEachIsland(const std::function<void(const ImpulseSolver&,int)>& 
+                       solveIsland);
+
+    void clearSolverClones() {
+        for (unsigned i=0; i < m_solverClones.size(); ++i)
+            delete m_solverClones[i];
+        m_solverClones.clear();
+    }
+
 
 private:
     const MultibodySystem&      m_mbs;
@@ -405,14 +500,38 @@ private:
     Real                        m_minSignificantForce;
 
     ImpulseSolver*              m_solver;
+    int                         m_numThreads;
+    Array_<ImpulseSolver*>      m_solverClones; // for use on other threads
+    ClonePtr<ParallelExecutor>  m_executor;
+    Array_<const ImpulseSolver*> m_freeSolvers; // temporary for forEachIsland()
 
     // Persistent runtime data.
     State                       m_state;
+    Vector                      m_eventTriggers; // at the last step's end
+    Real                        m_nextEventTime; // next scheduled event
+    Array_<EventId>             m_nextEventIds;
+    Array_<EventTriggerInfo>    m_triggerInfo;
+    bool                        m_isSimulationOver;
     Vector                      m_emptyVector; // don't change this!
 
     // Step temporaries.
-    Matrix                      m_GMInvGt; // G M\ ~G
     Vector                      m_D; // soft diagonal
+
+    // Islands of constraints; see findIslands(). Each island's multipliers 
+    // are in increasing order, and A is its block of G M\ ~G.
+    struct IslandWorkspace {
+        Array_<int>                             contacts; // m_uniContact index
+        Array_<MultiplierIndex>                 participating, expanding;
+        Vector                                  D, piExpand, verrStart, 
+                                                verrApplied, pi;
+        Array_<ImpulseSolver::UniContactRT>     uniContact;
+        bool                                    converged;
+    };
+    Array_<Array_<MultiplierIndex> >            m_islandMults;
+    Array_<Matrix>                              m_islandA;
+    Array_<IslandWorkspace>                     m_islandWork;
+    Array_<int>                                 m_multIsland; // per mult
+    Array_<int>                                 m_multLocal;  // index in it
     Vector                      m_deltaU;
     Vector                      m_verr;
     Vector                      m_totalImpulse;
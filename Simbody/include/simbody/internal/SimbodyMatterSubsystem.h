@@ -1428,6 +1428,29 @@ it in O(m*n) time with O(n) intermediate storage, which is a \e lot better.
 void calcProjectedMInv(const State&   s,
                        Matrix&        GMInvGt) const;
 
+/** Calculate only the diagonal blocks of the projected inverse mass matrix
+W=G*M^-1*~G that belong to the given groups of multipliers. The groups must be
+mutually uncoupled, meaning that W(i,j)=0 whenever multipliers i and j are in
+different groups. That is the case when the constraints in different groups
+act on bodies that have no mobilities in common, for example separate objects
+resting on the ground. The block for group g is returned in blocks[g], with
+blocks[g](r,c) = W(groups[g][r], groups[g][c]).
+
+Because the groups are uncoupled, one column of every block can be obtained
+from each application of the O(n) operators described for 
+calcProjectedMInv(s,GMInvGt), so the cost is O(k*n) where k is the size of the
+largest group, rather than O(m*n), and only the blocks are stored rather than
+the whole m X m matrix. If the groups are not in fact uncoupled the result is
+wrong, with no warning.
+
+@par Required stage
+  \c Stage::Velocity (articulated body inertias realized first if necessary)
+
+@see calcProjectedMInv(s,GMInvGt) **/
+void calcProjectedMInv(const State&                            s,
+                       const Array_<Array_<MultiplierIndex> >& groups,
+                       Array_<Matrix>&                         blocks) const;
+
 /** Given a set of desired constraint-space speed changes, calculate the
 corresponding constraint-space impulses that would cause those changes. Here we 
 are solving the equation
@@ -0,0 +1,118 @@
+#ifndef SimTK_SIMBODY_SLEEPING_SUBSYSTEM_H_
+#define SimTK_SIMBODY_SLEEPING_SUBSYSTEM_H_
+
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+#include "simbody/internal/common.h"
+
+namespace SimTK {
+
+class MultibodySystem;
+class ContactTrackerSubsystem;
+
+//==============================================================================
+//                            SLEEPING SUBSYSTEM
+//==============================================================================
+/** This subsystem puts groups of mobilized bodies that have come to rest to
+sleep, so that they no longer cost anything to simulate, and wakes them up
+again when something comes near them. This is useful for example in a
+simulation where many objects settle into a pile.
+
+Bodies are grouped into "islands" that can only sleep and wake together. An
+island consists of all the bodies in the subtrees of base bodies (those whose
+parent is Ground) that are connected to one another by enabled Constraints or
+by active contacts found by the given ContactTrackerSubsystem. Contact with
+Ground does not connect bodies.
+
+At regular intervals (see setCheckInterval()) each island is checked to see
+whether the spatial velocities of all its bodies have stayed below the linear
+and angular thresholds for at least the sleep delay time. If so, and no other
+moving body is nearby, the island goes to sleep: each of its mobilizers is
+locked at velocity level with u=0, and the ContactTrackerSubsystem is told that
+its bodies are asleep. Contacts among sleeping bodies and Ground are then
+neither tracked nor given forces by a CompliantContactSubsystem. An island
+that touches a sleeping island when it goes to sleep joins that island.
+
+A sleeping island is woken as soon as the bounding sphere of a contact surface
+on any moving body comes within the wake margin of the bounding sphere of a
+contact surface in the island. The check for sleeping islands is a
+PeriodicEventHandler and the wake condition is the witness function of a
+TriggeredEventHandler, both added to the MultibodySystem when this subsystem
+is constructed, so sleeping and waking are ordinary events that are handled by
+the TimeStepper. Mobilizers that are already locked or are driven by a Motion
+prevent their island from sleeping. **/
+class SimTK_SIMBODY_EXPORT SleepingSubsystem : public Subsystem {
+public:
+/** Create a %SleepingSubsystem that isn't part of any System. **/
+SleepingSubsystem();
+/** Create a %SleepingSubsystem that finds contacts using the given
+ContactTrackerSubsystem and install it into the given MultibodySystem. **/
+SleepingSubsystem(MultibodySystem&, ContactTrackerSubsystem&);
+
+/** Set the speed below which a body's origin is considered to be at rest;
+default is 0.01 length units/time unit. **/
+SleepingSubsystem& setLinearVelocityThreshold(Real speed);
+/** Set the angular speed below which a body is considered to be at rest;
+default is 0.05 radian/time unit. **/
+SleepingSubsystem& setAngularVelocityThreshold(Real angularSpeed);
+/** Set how long all the bodies in an island must have been at rest before
+the island can go to sleep; default is 0.5 time unit. **/
+SleepingSubsystem& setSleepDelay(Real delay);
+/** Set the interval between checks for islands that can go to sleep;
+default is 0.1 time unit. This is the interval of the PeriodicEventHandler
+that this subsystem added to the System. **/
+SleepingSubsystem& setCheckInterval(Real interval);
+/** Set how close (as a gap between bounding spheres) a moving body has to
+come to a sleeping one to wake it up; default is 0.01 length units. This
+must be greater than zero. **/
+SleepingSubsystem& setWakeMargin(Real margin);
+
+Real getLinearVelocityThreshold() const;
+Real getAngularVelocityThreshold() const;
+Real getSleepDelay() const;
+Real getCheckInterval() const;
+Real getWakeMargin() const;
+
+/** Return true if the given mobilized body is asleep in this \a state. Ground
+is never asleep. **/
+bool isAsleep(const State& state, MobilizedBodyIndex mobod) const;
+/** Return the number of mobilized bodies that are currently asleep. **/
+int getNumSleepingBodies(const State& state) const;
+
+/** Wake all sleeping bodies, unlocking their mobilizers. Their u's will be
+zero. This is an Instance stage change. **/
+void wakeAll(State& state) const;
+
+/** @cond **/ // Hide from Doxygen.
+SimTK_PIMPL_DOWNCAST(SleepingSubsystem, Subsystem);
+class Impl;
+Impl& updImpl();
+const Impl& getImpl() const;
+/** @endcond **/
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SIMBODY_SLEEPING_SUBSYSTEM_H_
@@ -28,6 +28,7 @@
 #include "simbody/internal/Assembler.h"
 #include "simbody/internal/AssemblyCondition.h"
 #include <map>
+#include <memory>
 #include <iostream>
 using std::cout; using std::endl;
 
@@ -102,7 +103,7 @@ public:
             // Jacobian is already the right shape.
             matter.calcPq(state, jacobian);
         } else {
-            Matrix fullJac(state.getNQErr(), nq);
+            fullJac.resize(state.getNQErr(), nq);
             matter.calcPq(state, fullJac);
             // Extract just the columns corresponding to free Qs
             for (Assembler::FreeQIndex fx(0); fx < np; ++fx)
@@ -132,7 +133,7 @@ public:
             // Nothing locked; analytic gradient is the right size
             matter.multiplyByPqTranspose(state, state.getQErr(), grad);
         } else {
-            Vector fullGrad(nq);
+            fullGrad.resize(nq);
             matter.multiplyByPqTranspose(state, state.getQErr(), fullGrad);
             // Extract just the entries corresponding to free Qs
             for (Assembler::FreeQIndex fx(0); fx < np; ++fx)
@@ -144,6 +145,9 @@ public:
     }
 
 private:
+    // Temporaries for when some q's are locked; kept to avoid reallocating.
+    mutable Matrix fullJac;
+    mutable Vector fullGrad;
 };
 } // end anonymous namespace
 
@@ -163,7 +167,8 @@ public:
     // Convenient interface to objective function.
     Real calcCurrentGoal() const {
         Real val;
-        const int status = objectiveFunc(getFreeQsFromInternalState(),true,val);
+        getFreeQsFromInternalState(freeQs);
+        const int status = objectiveFunc(freeQs,true,val);
         SimTK_ERRCHK1_ALWAYS(status==0, 
             "AssemblerSystem::calcCurrentGoal()",
             "objectiveFunc() returned status %d.", status);
@@ -181,11 +186,13 @@ public:
         return grad;
     }
 
-    // Convenient interface to assembly constraint error function.
-    Vector calcCurrentErrors() const {
-        Vector errs(getNumEqualityConstraints());
-        const int status = 
-            constraintFunc(getFreeQsFromInternalState(), true, errs);
+    // Convenient interface to assembly constraint error function. The 
+    // returned reference is to a temporary that is overwritten by the next
+    // call.
+    const Vector& calcCurrentErrors() const {
+        errs.resize(getNumEqualityConstraints());
+        getFreeQsFromInternalState(freeQs);
+        const int status = constraintFunc(freeQs, true, errs);
         SimTK_ERRCHK1_ALWAYS(status==0, 
             "AssemblerSystem::calcCurrentErrors()",
             "constraintFunc() returned status %d.", status);
@@ -284,10 +291,10 @@ public:
         // This will record the indices of any goals we encounter that can't
         // provide their own gradients; we'll handle them all together at
         // the end.
-        Array_<AssemblyConditionIndex> needNumericalGradient;
+        needNumericalGradient.clear();
 
         gradient = 0;
-        Vector tmpGradient(gradient.size());
+        tmpGradient.resize(gradient.size());
         for (unsigned i=0; i < assembler.goals.size(); ++i) {
             AssemblyConditionIndex   goalIx = assembler.goals[i];
             const AssemblyCondition& cond   = *assembler.conditions[goalIx];
@@ -308,16 +315,30 @@ public:
         if (!needNumericalGradient.empty()) {
             //cout << "Need numerical gradient for " 
             //     << needNumericalGradient.size() << " goals." << endl;
-            NumGradientFunc numGoals(assembler, needNumericalGradient);
-            // Essential to use central difference here so that the
-            // approximate gradient is actually zero at the optimum
-            // solution, otherwise IpOpt won't converge.
-            Differentiator gradNumGoals
-               (numGoals,Differentiator::CentralDifference);
+            // The function refers to needNumericalGradient so sees the 
+            // current list of goals; we only have to create it once.
+            if (!gradNumGoals) {
+                numGoals.reset
+                   (new NumGradientFunc(assembler, needNumericalGradient));
+                // Essential to use central difference here so that the
+                // approximate gradient is actually zero at the optimum
+                // solution, otherwise IpOpt won't converge.
+                gradNumGoals.reset(new Differentiator
+                   (*numGoals,Differentiator::CentralDifference));
+            }
+            getFreeQsFromInternalState(freeQs);
+            Real fy0;
+            const int stat = numGoals->f(freeQs, fy0);
+            if (stat != 0)
+                return stat;
+            const int nCallsBefore = gradNumGoals->getNumCallsToUserFunction();
+            numGradient.resize(gradient.size());
+            gradNumGoals->calcGradient(freeQs, fy0, numGradient);
             // weights are already included here
-            gradient += gradNumGoals.calcGradient(getFreeQsFromInternalState());
+            gradient += numGradient;
 
-            nEvalObjective += gradNumGoals.getNumCallsToUserFunction();
+            nEvalObjective += 1 + gradNumGoals->getNumCallsToUserFunction() 
+                                - nCallsBefore;
         }
 
         //cout << "Grad=" << gradient << endl;
@@ -412,10 +433,10 @@ public:
         // This will record the indices of any constraints we encounter that 
         // can't provide their own gradients; we'll handle them all together 
         // at the end.
-        Array_<AssemblyConditionIndex> needNumericalJacobian;
-        Array_<int>                    firstEqn;
-        Array_<int>                    nEqns;
-        int                            needy = 0;
+        needNumericalJacobian.clear();
+        firstEqn.clear();
+        nEqns.clear();
+        int needy = 0;
 
         int nxtEqn = 0;
         for (unsigned i=0; i < assembler.errors.size(); ++i) {
@@ -439,14 +460,27 @@ public:
         if (!needNumericalJacobian.empty()) {
             //cout << "Need numerical Jacobian for " 
             //     << needNumericalJacobian.size() << " constraints." << endl;
-            NumJacobianFunc numCons(assembler, needNumericalJacobian, 
-                                    nEqns, needy);
-            // Forward difference should be fine here, unlike for the
-            // gradient because we converge on the solution value 
-            // rather than the derivative norm.
-            Differentiator jacNumCons(numCons);
-            Matrix numJ = jacNumCons.calcJacobian(getFreeQsFromInternalState());
-            nEvalConstraints += jacNumCons.getNumCallsToUserFunction();
+            // The function refers to the lists above so only has to be 
+            // recreated if the number of equations changes.
+            if (!jacNumCons || numCons->getNumFunctions() != needy) {
+                jacNumCons.reset();
+                numCons.reset(new NumJacobianFunc(assembler, 
+                                    needNumericalJacobian, nEqns, needy));
+                // Forward difference should be fine here, unlike for the
+                // gradient because we converge on the solution value 
+                // rather than the derivative norm.
+                jacNumCons.reset(new Differentiator(*numCons));
+            }
+            getFreeQsFromInternalState(freeQs);
+            numErrs.resize(needy);
+            const int stat = numCons->f(freeQs, numErrs);
+            if (stat != 0)
+                return stat;
+            const int nCallsBefore = jacNumCons->getNumCallsToUserFunction();
+            numJ.resize(needy, n);
+            jacNumCons->calcJacobian(freeQs, numErrs, numJ);
+            nEvalConstraints += 1 + jacNumCons->getNumCallsToUserFunction()
+                                  - nCallsBefore;
 
             // Fill in the missing rows.
             int nxtInNumJ = 0;
@@ -481,11 +515,28 @@ private:
     {   return assembler.getFreeQIndexOfQ(qx); }
     Vector getFreeQsFromInternalState() const 
     {   return assembler.getFreeQsFromInternalState(); }
+    void getFreeQsFromInternalState(Vector& freeQs) const 
+    {   assembler.getFreeQsFromInternalState(freeQs); }
     void setInternalStateFromFreeQs(const Vector& freeQs) const 
     {   assembler.setInternalStateFromFreeQs(freeQs); }
 
     Assembler& assembler;
 
+    // Temporaries, and the numerical differentiation machinery for any
+    // conditions that don't provide analytic derivatives. These are kept
+    // from one evaluation to the next so that assembling or tracking a 
+    // series of frames doesn't have to allocate memory.
+    mutable Vector                          freeQs, errs;
+    mutable Vector                          tmpGradient, numGradient, numErrs;
+    mutable Matrix                          numJ;
+    mutable Array_<AssemblyConditionIndex>  needNumericalGradient;
+    mutable Array_<AssemblyConditionIndex>  needNumericalJacobian;
+    mutable Array_<int>                     firstEqn, nEqns;
+    mutable std::unique_ptr<NumGradientFunc> numGoals;
+    mutable std::unique_ptr<Differentiator>  gradNumGoals;
+    mutable std::unique_ptr<NumJacobianFunc> numCons;
+    mutable std::unique_ptr<Differentiator>  jacNumCons;
+
     mutable int nEvalObjective;
     mutable int nEvalConstraints;
     mutable int nEvalGradient;
@@ -804,7 +855,7 @@ Real Assembler::calcCurrentErrorNorm() const {
     initialize();
     const int nc = asmSys->getNumEqualityConstraints();
     if (nc == 0) return 0;
-    const Vector errs = asmSys->calcCurrentErrors();
+    const Vector& errs = asmSys->calcCurrentErrors();
     return useRMSErrorNorm
         ? std::sqrt(~errs*errs / errs.size())   // RMS
         : max(abs(errs));                       // infinity norm
@@ -937,8 +988,10 @@ Real Assembler::track(Real frameTime) {
     // std::cout << "track(): initial tol/goal is " 
     //         << calcCurrentError() << "/" << calcCurrentGoal() << std::endl;
 
-    // Optimize
-    Vector freeQs = getFreeQsFromInternalState();
+    // Optimize. The optimizer and AssemblerSystem are reused from one frame
+    // to the next as long as nothing has uninitialized the Assembler.
+    Vector& freeQs = trackFreeQs;
+    getFreeQsFromInternalState(freeQs);
     optimizer->setConvergenceTolerance(getAccuracyInUse());
     optimizer->setConstraintTolerance(getErrorToleranceInUse());
     try
@@ -957,8 +1010,6 @@ Real Assembler::track(Real frameTime) {
         }
     }
 
-    // This will ensure that the internalState has its q's set to match the
-    // parameters.
     // This will ensure that the internalState has its q's set to match the
     // parameters.
     setInternalStateFromFreeQs(freeQs);
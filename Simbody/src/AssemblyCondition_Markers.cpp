@@ -89,7 +89,7 @@ int Markers::calcGoalGradient(const State& state, Vector& gradient) const {
     assert(gradient.size() == np);
     const SimbodyMatterSubsystem& matter = getMatterSubsystem();
 
-    Vector_<SpatialVec> dEdR(matter.getNumBodies());
+    dEdR.resize(matter.getNumBodies());
     dEdR = SpatialVec(Vec3(0), Vec3(0));
     // Loop over each body that has one or more active markers.
     Real wtot = 0;
@@ -115,7 +115,7 @@ int Markers::calcGoalGradient(const State& state, Vector& gradient) const {
         }
     }
     // Convert spatial forces dEdR to generalized forces dEdU.
-    Vector dEdU;
+    Vector& dEdU = uTemp;
     matter.multiplyBySystemJacobianTranspose(state, dEdR, dEdU);
 
     dEdU /= wtot;
@@ -124,7 +124,8 @@ int Markers::calcGoalGradient(const State& state, Vector& gradient) const {
     if (np == nq) // gradient is full length
         matter.multiplyByNInv(state, true, dEdU, gradient);
     else { // calculate full gradient; extract the relevant parts
-        Vector fullGradient(nq);
+        Vector& fullGradient = qTemp;
+        fullGradient.resize(nq);
         matter.multiplyByNInv(state, true, dEdU, fullGradient);
         for (Assembler::FreeQIndex fx(0); fx < np; ++fx)
             gradient[fx] = fullGradient[getQIndexOfFreeQ(fx)];
@@ -134,18 +135,69 @@ int Markers::calcGoalGradient(const State& state, Vector& gradient) const {
     return 0;
 }
 
+// The errors are the three Ground-frame components of each active marker's
+// position error, unweighted since each error must be satisfied on its own.
+// A marker whose observation is NaN in the current frame contributes zero 
+// errors, so that the number of errors is the same for every frame.
 // TODO: We want the constraint version to minimize the same goal as above. But
 // there can never be more than six independent constraints on the pose of
 // a rigid body; this method should attempt to produce a minimal set so that
 // the optimizer doesn't have to figure it out.
-int Markers::calcErrors(const State& state, Vector& err) const
-{   return AssemblyCondition::calcErrors(state,err); } //TODO
+int Markers::calcErrors(const State& state, Vector& err) const {
+    const SimbodyMatterSubsystem& matter = getMatterSubsystem();
+    err.resize(3*activeMarkers.size());
+    for (unsigned i=0; i < activeMarkers.size(); ++i) {
+        const MarkerIx  mx = activeMarkers[i];
+        const Marker&   marker = markers[mx];
+        const Vec3& location = observations[getObservationIxForMarker(mx)];
+        Vec3 err_G(0);
+        if (location.isFinite()) { // skip NaNs
+            const MobilizedBody& mobod = matter.getMobilizedBody(marker.bodyB);
+            err_G = mobod.getBodyTransform(state)*marker.markerInB - location;
+        }
+        for (int k=0; k < 3; ++k)
+            err[3*i+k] = err_G[k];
+    }
+    return 0;
+}
 
+// The marker errors change with q just as the markers do, so the error 
+// Jacobian is the station Jacobian JS=d p_G/du of the markers, converted 
+// to q's with N^-1 (dp/dq = JS N^-1), keeping only the columns for free q's.
+int Markers::calcErrorJacobian(const State& state, Matrix& jacobian) const {
+    const SimbodyMatterSubsystem& matter = getMatterSubsystem();
+    const int np = getNumFreeQs();
+    const int nq = state.getNQ();
+    const int nerr = 3*activeMarkers.size();
+
+    jacobian.resize(nerr, np);
+    if (nerr == 0)
+        return 0;
+
+    matter.calcStationJacobian(state, activeMarkerBodies, activeMarkerStations,
+                               stationJacobian);
+    qTemp.resize(nq);
+    for (unsigned i=0; i < activeMarkers.size(); ++i) {
+        const Vec3& location = 
+            observations[getObservationIxForMarker(activeMarkers[i])];
+        for (int k=0; k < 3; ++k) {
+            const int row = 3*i+k;
+            if (!location.isFinite()) { // error is always zero
+                jacobian[row] = 0;
+                continue;
+            }
+            // Row of JS*N^-1 is ~(~N^-1 * ~row of JS).
+            uTemp = ~stationJacobian[row];
+            matter.multiplyByNInv(state, true, uTemp, qTemp);
+            for (Assembler::FreeQIndex fx(0); fx < np; ++fx)
+                jacobian(row,fx) = qTemp[getQIndexOfFreeQ(fx)];
+        }
+    }
+    return 0;
+}
 
-int Markers::calcErrorJacobian(const State& state, Matrix& jacobian) const
-{   return AssemblyCondition::calcErrorJacobian(state,jacobian); } //TODO
 int Markers::getNumErrors(const State& state) const
-{   return AssemblyCondition::getNumErrors(state); } //TODO
+{   return 3*activeMarkers.size(); }
 
 // Run through all the Markers to find all the bodies that have at least one
 // active marker. For each of those bodies, we collect all its markers so that
@@ -166,11 +218,27 @@ int Markers::initializeCondition() const {
         if (hasObservation(mx) && marker.weight > 0)
             bodiesWithMarkers[marker.bodyB].push_back(mx);
     }
+
+    activeMarkers.clear(); 
+    activeMarkerBodies.clear(); 
+    activeMarkerStations.clear();
+    PerBodyMarkers::const_iterator bodyp = bodiesWithMarkers.begin();
+    for (; bodyp != bodiesWithMarkers.end(); ++bodyp) {
+        const Array_<MarkerIx>& bodyMarkers = bodyp->second;
+        for (unsigned m=0; m < bodyMarkers.size(); ++m) {
+            activeMarkers.push_back(bodyMarkers[m]);
+            activeMarkerBodies.push_back(bodyp->first);
+            activeMarkerStations.push_back(markers[bodyMarkers[m]].markerInB);
+        }
+    }
     return 0;
 }
 
-// Throw away the bodiesWithMarkers map.
+// Throw away the bodiesWithMarkers map and the active marker lists.
 void Markers::uninitializeCondition() const {
     bodiesWithMarkers.clear();
+    activeMarkers.clear(); 
+    activeMarkerBodies.clear(); 
+    activeMarkerStations.clear();
 }
 
@@ -93,7 +93,7 @@ calcGoalGradient(const State& state, Vector& gradient) const {
     assert(gradient.size() == np);
     const SimbodyMatterSubsystem& matter = getMatterSubsystem();
 
-    Vector_<SpatialVec> dEdR(matter.getNumBodies());
+    dEdR.resize(matter.getNumBodies());
     dEdR = SpatialVec(Vec3(0), Vec3(0));
     // Loop over each body that has one or more active osensors.
     Real wtot = 0;
@@ -123,7 +123,7 @@ calcGoalGradient(const State& state, Vector& gradient) const {
         }
     }
     // Convert spatial forces dEdR to generalized forces dEdU.
-    Vector dEdU;
+    Vector& dEdU = uTemp;
     matter.multiplyBySystemJacobianTranspose(state, dEdR, dEdU);
 
     dEdU /= wtot;
@@ -132,7 +132,8 @@ calcGoalGradient(const State& state, Vector& gradient) const {
     if (np == nq) // gradient is full length
         matter.multiplyByNInv(state, true, dEdU, gradient);
     else { // calculate full gradient; extract the relevant parts
-        Vector fullGradient(nq);
+        Vector& fullGradient = qTemp;
+        fullGradient.resize(nq);
         matter.multiplyByNInv(state, true, dEdU, fullGradient);
         for (Assembler::FreeQIndex fx(0); fx < np; ++fx)
             gradient[fx] = fullGradient[getQIndexOfFreeQ(fx)];
@@ -142,18 +143,108 @@ calcGoalGradient(const State& state, Vector& gradient) const {
     return 0;
 }
 
+// Return the rotation vector phi=a*k (angle a, unit axis k) of the osensor
+// error rotation R_SO, expressed in S (or O; they're the same for the axis).
+static Vec3 calcRotationError(const Rotation& R_GS, const Rotation& R_GO) {
+    const Rotation R_SO = ~R_GS*R_GO; // error, in S
+    const Vec4 aa_SO = R_SO.convertRotationToAngleAxis();
+    return aa_SO[0] * aa_SO.getSubVec<3>(1);
+}
+
+// The errors are the three components of each active osensor's rotation 
+// error vector (see calcRotationError()), unweighted since each error must be
+// satisfied on its own. An osensor whose observation is NaN in the current 
+// frame contributes zero errors, so that the number of errors is the same for
+// every frame.
 // TODO: We want the constraint version to minimize the same goal as above. But
 // there can never be more than six independent constraints on the pose of
 // a rigid body; this method should attempt to produce a minimal set so that
 // the optimizer doesn't have to figure it out.
-int OrientationSensors::calcErrors(const State& state, Vector& err) const
-{   return AssemblyCondition::calcErrors(state,err); } //TODO
+int OrientationSensors::calcErrors(const State& state, Vector& err) const {
+    const SimbodyMatterSubsystem& matter = getMatterSubsystem();
+    err.resize(3*activeOSensors.size());
+    for (unsigned i=0; i < activeOSensors.size(); ++i) {
+        const OSensorIx mx = activeOSensors[i];
+        const OSensor&  osensor = osensors[mx];
+        const Rotation& R_GO = observations[getObservationIxForOSensor(mx)];
+        Vec3 phi(0);
+        if (R_GO.isFinite()) { // skip NaNs
+            const MobilizedBody& mobod = matter.getMobilizedBody(osensor.bodyB);
+            const Rotation R_GS = mobod.getBodyRotation(state) 
+                                  * osensor.orientationInB;
+            phi = calcRotationError(R_GS, R_GO);
+        }
+        for (int k=0; k < 3; ++k)
+            err[3*i+k] = phi[k];
+    }
+    return 0;
+}
+
+// If the body has angular velocity w_G, the error rotation changes as
+// d/dt R_SO = -[w_S]x R_SO with w_S = ~R_GS w_G. The rotation vector of a
+// rotation perturbed that way changes as d/dt phi = -Jl^-1(phi) w_S, where 
+// Jl^-1 is the inverse of the left Jacobian of SO(3):
+//      Jl^-1(phi) = I - [phi]x/2 + c [phi]x^2,
+//      c = 1/a^2 - (1+cos a)/(2 a sin a)    (c -> 1/12 as a -> 0).
+// So the error Jacobian is -Jl^-1(phi) ~R_GS JW N^-1 where JW is the 
+// angular part of the body's frame Jacobian; we keep only the columns for
+// free q's. This is singular at a=pi, where the rotation vector itself is
+// not unique.
+int OrientationSensors::
+calcErrorJacobian(const State& state, Matrix& jacobian) const {
+    const SimbodyMatterSubsystem& matter = getMatterSubsystem();
+    const int np = getNumFreeQs();
+    const int nq = state.getNQ();
+    const int nerr = 3*activeOSensors.size();
+
+    jacobian.resize(nerr, np);
+    if (nerr == 0)
+        return 0;
 
+    // 6 rows per osensor; angular rows first.
+    matter.calcFrameJacobian(state, activeOSensorBodies, activeOSensorOrigins,
+                             frameJacobian);
+    const int nu = frameJacobian.ncol();
+    qTemp.resize(nq); uTemp.resize(nu);
+    for (unsigned i=0; i < activeOSensors.size(); ++i) {
+        const OSensorIx mx = activeOSensors[i];
+        const OSensor&  osensor = osensors[mx];
+        const Rotation& R_GO = observations[getObservationIxForOSensor(mx)];
+        if (!R_GO.isFinite()) { // error is always zero
+            for (int k=0; k < 3; ++k)
+                jacobian[3*i+k] = 0;
+            continue;
+        }
+
+        const MobilizedBody& mobod = matter.getMobilizedBody(osensor.bodyB);
+        const Rotation R_GS = mobod.getBodyRotation(state) 
+                              * osensor.orientationInB;
+        const Vec3 phi = calcRotationError(R_GS, R_GO);
+        const Real a = phi.norm();
+        const Real c = a < Real(1e-4) 
+                        ? Real(1)/12 
+                        : 1/square(a) - (1+std::cos(a))/(2*a*std::sin(a));
+        const Mat33 phix = crossMat(phi);
+        const Mat33 JlInv = Mat33(1) - phix/2 + c*phix*phix;
+        const Mat33 M = -JlInv * ~R_GS.asMat33(); // d phi/d w_G
+
+        for (int k=0; k < 3; ++k) {
+            const int row = 3*i+k;
+            // Row of M*JW, then convert to q's: row of M*JW*N^-1.
+            for (int j=0; j < nu; ++j)
+                uTemp[j] = M(k,0)*frameJacobian(6*i,   j) 
+                         + M(k,1)*frameJacobian(6*i+1, j)
+                         + M(k,2)*frameJacobian(6*i+2, j);
+            matter.multiplyByNInv(state, true, uTemp, qTemp);
+            for (Assembler::FreeQIndex fx(0); fx < np; ++fx)
+                jacobian(row,fx) = qTemp[getQIndexOfFreeQ(fx)];
+        }
+    }
+    return 0;
+}
 
-int OrientationSensors::calcErrorJacobian(const State& state, Matrix& jacobian) const
-{   return AssemblyCondition::calcErrorJacobian(state,jacobian); } //TODO
 int OrientationSensors::getNumErrors(const State& state) const
-{   return AssemblyCondition::getNumErrors(state); } //TODO
+{   return 3*activeOSensors.size(); }
 
 // Run through all the OSensors to find all the bodies that have at least one
 // active osensor. For each of those bodies, we collect all its osensors so that
@@ -175,11 +266,27 @@ int OrientationSensors::initializeCondition() const {
         if (hasObservation(mx) && osensor.weight > 0)
             bodiesWithOSensors[osensor.bodyB].push_back(mx);
     }
+
+    activeOSensors.clear(); 
+    activeOSensorBodies.clear(); 
+    activeOSensorOrigins.clear();
+    PerBodyOSensors::const_iterator bodyp = bodiesWithOSensors.begin();
+    for (; bodyp != bodiesWithOSensors.end(); ++bodyp) {
+        const Array_<OSensorIx>& bodyOSensors = bodyp->second;
+        for (unsigned m=0; m < bodyOSensors.size(); ++m) {
+            activeOSensors.push_back(bodyOSensors[m]);
+            activeOSensorBodies.push_back(bodyp->first);
+            activeOSensorOrigins.push_back(Vec3(0));
+        }
+    }
     return 0;
 }
 
-// Throw away the bodiesWithOSensors map.
+// Throw away the bodiesWithOSensors map and the active osensor lists.
 void OrientationSensors::uninitializeCondition() const {
     bodiesWithOSensors.clear();
+    activeOSensors.clear(); 
+    activeOSensorBodies.clear(); 
+    activeOSensorOrigins.clear();
 }
 
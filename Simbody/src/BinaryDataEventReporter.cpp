@@ -0,0 +1,479 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+
+#include "simbody/internal/common.h"
+#include "simbody/internal/MultibodySystem.h"
+#include "simbody/internal/SimbodyMatterSubsystem.h"
+#include "simbody/internal/MobilizedBody.h"
+#include "simbody/internal/BinaryDataEventReporter.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace SimTK;
+
+namespace {
+
+const char     FileMagic[8] = {'S','i','m','T','K','b','i','n'};
+const unsigned FileVersion  = 1;
+
+// Rows are collected in blocks, stored by column so the writer can write
+// each column straight from memory.
+struct Block {
+    Block(int rowCapacity, int numChannels)
+    :   values(size_t(rowCapacity)*numChannels), numRows(0) {}
+    std::vector<double> values; // value (row,channel) at channel*capacity+row
+    int                 numRows;
+};
+
+// Hands pointers from one thread to one other thread without locking. One
+// slot is always left empty to distinguish full from empty.
+class HandoffRing {
+public:
+    explicit HandoffRing(int capacity) : m_slots(capacity+1) {}
+
+    // Producer only. Returns false if the ring is full.
+    bool push(Block* block) {
+        const unsigned tail = m_tail.load(std::memory_order_relaxed);
+        const unsigned next = (tail+1) % m_slots.size();
+        if (next == m_head.load()) return false;
+        m_slots[tail] = block;
+        m_tail.store(next);
+        return true;
+    }
+
+    // Consumer only. Returns null if the ring is empty.
+    Block* pop() {
+        const unsigned head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load()) return nullptr;
+        Block* block = m_slots[head];
+        m_head.store((head+1) % m_slots.size());
+        return block;
+    }
+
+    bool isEmpty() const {return m_head.load() == m_tail.load();}
+
+private:
+    std::vector<Block*>     m_slots;
+    std::atomic<unsigned>   m_head{0}, m_tail{0};
+};
+
+// Blocks in flight: a couple being filled or written and the rest queued.
+const int MaxBlocks = 8;
+
+}   // anonymous namespace
+
+
+
+//==============================================================================
+//                    BINARY DATA EVENT REPORTER :: IMPL
+//==============================================================================
+class BinaryDataEventReporter::Impl {
+public:
+    // What each addSomething() call asked for; a source may supply several
+    // channels.
+    enum SourceKind {SourceQ, SourceU, SourceMeasure, SourceBodyPose};
+    struct Source {
+        SourceKind          kind;
+        String              name;
+        Measure             measure;
+        MobilizedBodyIndex  body;
+    };
+
+    Impl(const MultibodySystem& system, const String& fileName,
+         int rowsPerBlock)
+    :   m_system(system), m_fileName(fileName), m_rowsPerBlock(rowsPerBlock),
+        m_full(MaxBlocks), m_free(MaxBlocks)
+    {
+        m_file.open(fileName.c_str(),
+                    std::ios_base::binary | std::ios_base::trunc);
+        SimTK_ERRCHK1_ALWAYS(m_file.good(),
+            "BinaryDataEventReporter::BinaryDataEventReporter()",
+            "Failed to open file '%s'", fileName.c_str());
+    }
+
+    // The System may be partly destroyed by now (it owns the reporter), so
+    // it must not be looked at here.
+    ~Impl() {
+        try {finish(0, 0);} catch (...) {}
+        for (Block* block : m_blocks) delete block;
+    }
+
+    void addSource(SourceKind kind, const String& name,
+                   const Measure& measure = Measure(),
+                   MobilizedBodyIndex body = MobilizedBodyIndex()) {
+        SimTK_ERRCHK_ALWAYS(!m_started && !m_closed,
+            "BinaryDataEventReporter::add...()",
+            "Channels must be added before the first report.");
+        Source source;
+        source.kind = kind; source.name = name;
+        source.measure = measure; source.body = body;
+        m_sources.push_back(source);
+    }
+
+    // Called from the simulation thread.
+    void record(const State& state) {
+        if (m_closed) return;
+        if (!m_started) start(state.getNQ(), state.getNU());
+        SimTK_ERRCHK_ALWAYS(state.getNQ()==m_nq && state.getNU()==m_nu,
+            "BinaryDataEventReporter::handleEvent()",
+            "The number of q's or u's changed after the first report.");
+        if (!m_current) m_current = takeFreeBlock();
+
+        const int row = m_current->numRows;
+        double* value = &m_current->values[row];
+        const int stride = m_rowsPerBlock;
+        *value = state.getTime(); value += stride;
+        const SimbodyMatterSubsystem& matter = m_system.getMatterSubsystem();
+        for (const Source& source : m_sources) {
+            switch (source.kind) {
+            case SourceQ:
+                for (int i=0; i < state.getNQ(); ++i, value += stride)
+                    *value = state.getQ()[i];
+                break;
+            case SourceU:
+                for (int i=0; i < state.getNU(); ++i, value += stride)
+                    *value = state.getU()[i];
+                break;
+            case SourceMeasure:
+                *value = source.measure.getValue(state); value += stride;
+                break;
+            case SourceBodyPose: {
+                const Transform& X_GB =
+                    matter.getMobilizedBody(source.body).getBodyTransform(state);
+                const Quaternion quat = X_GB.R().convertRotationToQuaternion();
+                for (int i=0; i < 4; ++i, value += stride) *value = quat[i];
+                for (int i=0; i < 3; ++i, value += stride) *value = X_GB.p()[i];
+                break;
+            }
+            }
+        }
+
+        ++m_numRows;
+        if (++m_current->numRows == m_rowsPerBlock) {
+            handOff(m_current);
+            m_current = nullptr;
+        }
+    }
+
+    // Called by the user, who still has the System.
+    void close() {
+        if (m_closed) return;
+        int nq = 0, nu = 0;
+        if (!m_started && m_system.systemTopologyHasBeenRealized()) {
+            // Nothing was recorded; get the numbers of q's and u's for the
+            // header from the System instead.
+            State state = m_system.getDefaultState();
+            m_system.realizeModel(state);
+            nq = state.getNQ(); nu = state.getNU();
+        }
+        finish(nq, nu);
+    }
+
+    int getNumRows() const {return m_numRows;}
+
+private:
+    // Write the remaining rows and stop the writer thread. The channel
+    // layout was fixed by the first report; if there wasn't one, the header
+    // lists nq q's and nu u's.
+    void finish(int nq, int nu) {
+        if (m_closed) return;
+        if (!m_started) start(nq, nu);
+        m_closed = true;
+        if (m_current && m_current->numRows) handOff(m_current);
+        m_current = nullptr;
+        m_stopRequested.store(true);
+        wake(m_writerWaiting, m_blocksQueued);
+        m_writer.join();
+        m_file.close();
+        SimTK_ERRCHK1_ALWAYS(!m_writeFailed,
+            "BinaryDataEventReporter::close()",
+            "Failed while writing to file '%s'.", m_fileName.c_str());
+    }
+
+    // Fix the channel list now that we know how many q's and u's there
+    // are, and start the writer thread.
+    void start(int nq, int nu) {
+        m_nq = nq; m_nu = nu;
+        m_channelNames.clear();
+        m_channelNames.push_back("time");
+        for (const Source& source : m_sources) {
+            switch (source.kind) {
+            case SourceQ:
+                for (int i=0; i < nq; ++i)
+                    m_channelNames.push_back("q" + String(i));
+                break;
+            case SourceU:
+                for (int i=0; i < nu; ++i)
+                    m_channelNames.push_back("u" + String(i));
+                break;
+            case SourceMeasure:
+                m_channelNames.push_back(source.name);
+                break;
+            case SourceBodyPose: {
+                static const char* suffix[] =
+                    {".qw",".qx",".qy",".qz",".px",".py",".pz"};
+                for (const char* s : suffix)
+                    m_channelNames.push_back(source.name + s);
+                break;
+            }
+            }
+        }
+        m_started = true;
+        m_writer = std::thread(&Impl::writerMain, this);
+    }
+
+    // Get an empty block from the writer thread, or make a new one if there
+    // aren't too many already. If the writer has fallen behind we have to
+    // wait for it.
+    Block* takeFreeBlock() {
+        for (;;) {
+            if (Block* block = m_free.pop()) return block;
+            if ((int)m_blocks.size() < MaxBlocks) {
+                m_blocks.push_back(new Block(m_rowsPerBlock,
+                                             (int)m_channelNames.size()));
+                return m_blocks.back();
+            }
+            waitFor(m_producerWaiting, m_blockFreed,
+                    [this]{return !m_free.isEmpty();});
+        }
+    }
+
+    void handOff(Block* block) {
+        // There are never more than MaxBlocks blocks so this must fit.
+        const bool pushed = m_full.push(block);
+        assert(pushed); (void)pushed;
+        wake(m_writerWaiting, m_blocksQueued);
+    }
+
+    // The two threads only take the lock to go to sleep or wake the other
+    // one up. The waiting flag is set before checking for work, and the
+    // work is made available before checking the flag, so a wakeup can't
+    // be missed. The timeout is just a safety net.
+    template <class Pred>
+    void waitFor(std::atomic<bool>& waiting, std::condition_variable& cv,
+                 Pred ready) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        waiting.store(true);
+        if (!ready())
+            cv.wait_for(lock, std::chrono::milliseconds(10));
+        waiting.store(false);
+    }
+
+    void wake(std::atomic<bool>& waiting, std::condition_variable& cv) {
+        if (waiting.load()) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            cv.notify_one();
+        }
+    }
+
+    void writerMain() {
+        writeHeader();
+        for (;;) {
+            if (Block* block = m_full.pop()) {
+                writeBlock(*block);
+                block->numRows = 0;
+                m_free.push(block);
+                wake(m_producerWaiting, m_blockFreed);
+                continue;
+            }
+            // Check for more blocks again after seeing the stop request
+            // since close() hands off the last one before asking.
+            if (m_stopRequested.load() && m_full.isEmpty())
+                break;
+            waitFor(m_writerWaiting, m_blocksQueued, [this]
+                {return !m_full.isEmpty() || m_stopRequested.load();});
+        }
+        m_file.flush();
+        if (!m_file.good()) m_writeFailed = true;
+    }
+
+    void writeHeader() {
+        m_file.write(FileMagic, sizeof(FileMagic));
+        writeUnsigned(FileVersion);
+        writeUnsigned((unsigned)m_channelNames.size());
+        for (const String& name : m_channelNames) {
+            writeUnsigned((unsigned)name.size());
+            m_file.write(name.c_str(), name.size());
+        }
+    }
+
+    void writeBlock(const Block& block) {
+        writeUnsigned((unsigned)block.numRows);
+        for (int c=0; c < (int)m_channelNames.size(); ++c)
+            m_file.write((const char*)&block.values[size_t(c)*m_rowsPerBlock],
+                         block.numRows*sizeof(double));
+    }
+
+    void writeUnsigned(unsigned n) {
+        const std::uint32_t n32 = n;
+        m_file.write((const char*)&n32, sizeof(n32));
+    }
+
+    const MultibodySystem&  m_system;
+    const String            m_fileName;
+    const int               m_rowsPerBlock;
+    Array_<Source>          m_sources;
+    Array_<String>          m_channelNames;
+    int                     m_nq = 0, m_nu = 0;
+    bool                    m_started = false;
+    bool                    m_closed = false;
+    int                     m_numRows = 0;
+
+    // Owned by the simulation thread.
+    std::vector<Block*>     m_blocks;   // all of them, for deletion
+    Block*                  m_current = nullptr;
+
+    // Shared with the writer thread.
+    HandoffRing             m_full;     // filled, to be written
+    HandoffRing             m_free;     // written, to be reused
+    std::atomic<bool>       m_stopRequested{false};
+    std::atomic<bool>       m_writerWaiting{false};
+    std::atomic<bool>       m_producerWaiting{false};
+    std::mutex              m_mutex;
+    std::condition_variable m_blocksQueued;
+    std::condition_variable m_blockFreed;
+
+    // Owned by the writer thread until it is joined.
+    std::ofstream           m_file;
+    bool                    m_writeFailed = false;
+    std::thread             m_writer;
+};
+
+
+
+//==============================================================================
+//                      BINARY DATA EVENT REPORTER
+//==============================================================================
+BinaryDataEventReporter::BinaryDataEventReporter
+   (const MultibodySystem& system, const String& fileName,
+    Real reportInterval, int rowsPerBlock)
+:   PeriodicEventReporter(reportInterval), impl(nullptr) {
+    SimTK_ERRCHK1_ALWAYS(rowsPerBlock > 0,
+        "BinaryDataEventReporter::BinaryDataEventReporter()",
+        "rowsPerBlock must be positive but was %d.", rowsPerBlock);
+    impl = new Impl(system, fileName, rowsPerBlock);
+}
+
+BinaryDataEventReporter::~BinaryDataEventReporter() {
+    delete impl;
+}
+
+void BinaryDataEventReporter::addQ()
+{   updImpl().addSource(Impl::SourceQ, "q"); }
+
+void BinaryDataEventReporter::addU()
+{   updImpl().addSource(Impl::SourceU, "u"); }
+
+void BinaryDataEventReporter::
+addMeasure(const Measure& measure, const String& name)
+{   updImpl().addSource(Impl::SourceMeasure, name, measure); }
+
+void BinaryDataEventReporter::
+addBodyPose(const MobilizedBody& body, const String& name) {
+    updImpl().addSource(Impl::SourceBodyPose, name, Measure(),
+                        body.getMobilizedBodyIndex());
+}
+
+void BinaryDataEventReporter::close() {updImpl().close();}
+
+int BinaryDataEventReporter::getNumRows() const
+{   return getImpl().getNumRows(); }
+
+void BinaryDataEventReporter::handleEvent(const State& state) const {
+    updImpl().record(state);
+}
+
+
+
+//==============================================================================
+//                   BINARY DATA EVENT REPORTER :: READER
+//==============================================================================
+BinaryDataEventReporter::Reader::Reader(const String& fileName) {
+    static const char* method = "BinaryDataEventReporter::Reader::Reader()";
+    std::ifstream in(fileName.c_str(), std::ios_base::binary);
+    SimTK_ERRCHK1_ALWAYS(in.good(), method,
+        "Failed to open file '%s'", fileName.c_str());
+
+    auto readUnsigned = [&in]() {
+        std::uint32_t n = 0;
+        in.read((char*)&n, sizeof(n));
+        return (unsigned)n;
+    };
+
+    char magic[sizeof(FileMagic)];
+    in.read(magic, sizeof(magic));
+    SimTK_ERRCHK1_ALWAYS(in.good()
+                         && std::memcmp(magic, FileMagic, sizeof(magic)) == 0,
+        method, "File '%s' was not written by a BinaryDataEventReporter.",
+        fileName.c_str());
+    const unsigned version = readUnsigned();
+    SimTK_ERRCHK2_ALWAYS(in.good() && version == FileVersion, method,
+        "File '%s' has unsupported format version %u.",
+        fileName.c_str(), version);
+
+    const unsigned numChannels = readUnsigned();
+    for (unsigned c=0; in.good() && c < numChannels; ++c) {
+        std::string name(readUnsigned(), '\0');
+        if (!name.empty()) in.read(&name[0], name.size());
+        m_names.push_back(String(name));
+    }
+    SimTK_ERRCHK1_ALWAYS(in.good() && numChannels > 0, method,
+        "The header of file '%s' is damaged.", fileName.c_str());
+
+    // Read the blocks, which are by column, and then assemble the columns.
+    std::vector< std::vector<double> > columns(numChannels);
+    for (;;) {
+        const unsigned numRows = readUnsigned();
+        if (in.eof()) break;
+        for (unsigned c=0; c < numChannels && in.good(); ++c) {
+            std::vector<double>& column = columns[c];
+            const size_t start = column.size();
+            column.resize(start + numRows);
+            in.read((char*)&column[start], numRows*sizeof(double));
+        }
+        SimTK_ERRCHK1_ALWAYS(in.good(), method,
+            "File '%s' ends in the middle of a block.", fileName.c_str());
+    }
+
+    const int numRows = (int)columns[0].size();
+    m_data.resize(numRows, numChannels);
+    for (unsigned c=0; c < numChannels; ++c)
+        for (int r=0; r < numRows; ++r)
+            m_data(r, c) = columns[c][r];
+}
+
+int BinaryDataEventReporter::Reader::findChannelIndex(const String& name) const {
+    for (int i=0; i < getNumChannels(); ++i)
+        if (m_names[i] == name) return i;
+    return -1;
+}
@@ -167,6 +167,12 @@ Real CablePath::getCableLength(const State& state) const
 Real CablePath::getCableLengthDot(const State& state) const 
 {   return getImpl().getCableLengthDot(state); }
 
+int CablePath::getNumPathSolverIterations(const State& state) const 
+{   return getImpl().getNumPathSolverIterations(state); }
+
+Real CablePath::getPathSolverCPUTime(const State& state) const 
+{   return getImpl().getPathSolverCPUTime(state); }
+
 void CablePath::applyBodyForces(const State& state, Real tension, 
                      Vector_<SpatialVec>& bodyForcesInG) const
 {   getImpl().applyBodyForces(state,tension,bodyForcesInG); }
@@ -617,7 +623,9 @@ ensurePositionKinematicsCalculated(const State& state) const {
     const PathPosEntry&     prevPPE  = getPrevPosEntry(state);
     PathPosEntry&           ppe      = updPosEntry(state);
 
+    const double startCPUTime = threadCpuTime();
     solveForPathPoints(state, instInfo, ppe);
+    ppe.solverCPUTime = threadCpuTime() - startCPUTime;
 
 
     //TODO: combine with earlier loop
@@ -726,35 +734,6 @@ ensureVelocityKinematicsCalculated(const State& state) const {
     cables->markDiscreteVarUpdateValueRealized(state, velEntryIx);
 }
 
-// Numerical Jacobian calculation.
-
-class PathError : public Differentiator::JacobianFunction {
-public:
-    // Caution: we're holding references.
-    PathError(int nx, 
-              const CablePath::Impl&  path,
-              const State&            state,
-              const PathInstanceInfo& instInfo,
-              const PathPosEntry&     ppe, 
-              Real                    accuracy)
-    :   Differentiator::JacobianFunction(nx, nx), path(path),
-        state(state),instInfo(instInfo),localPpe(ppe)
-    {   setEstimatedAccuracy(accuracy); }
-
-    int f(const Vector& x, Vector& fx) const override {
-        localPpe.x = x;
-        path.calcPathError(state, instInfo, localPpe);
-        fx = localPpe.err;
-        return 0;
-    }
-
-private:
-    const CablePath::Impl&  path;
-    const State&            state;
-    const PathInstanceInfo& instInfo;
-    mutable PathPosEntry    localPpe;
-};
-
 //------------------------------------------------------------------------------
 //                         PROJECT ONTO SURFACE
 //------------------------------------------------------------------------------
@@ -805,22 +784,16 @@ solveForPathPoints(const State& state, const PathInstanceInfo& instInfo,
 
     calcPathError(state,instInfo,ppe);
 
+    ppe.numIterations = 0;
     if (ppe.x.size() == 0)
         return; // only via points; no iteration to do
 
     const Real ftol = Real(1e-12)*1000; // TODO
     const Real xtol = Real(1e-12)*1000;
 
-    const Real estimatedPathErrorAccuracy = ftol;
-    PathError pathErrorFnc(ppe.x.size(), *this, state, instInfo, ppe, 
-                           estimatedPathErrorAccuracy);
-    Differentiator diff(pathErrorFnc);
-
     Vector dx, xold, xchg;
 
     Real f = ppe.err.norm();
-    cout << "\n***PATH solveForPathPoints@t=" << state.getTime() 
-         << " err=" << f << "\n"; 
 
     Real fold, lam = 1, nextlam = 1;
     Real dxnormPrev = Infinity;
@@ -829,23 +802,14 @@ solveForPathPoints(const State& state, const PathInstanceInfo& instInfo,
         // We always need a Jacobian even if the path is already good enough
         // because we use it to solve for xdot. So we might as well do one
         // iteration.
-        if (i > 0 && f <= ftol) {
-            std::cout << "\n***PATH converged in " 
-                << i << " iterations err=" << f << "\n\n";
+        if (i > 0 && f <= ftol)
             break;
-        }
-        //cout << "obstacle err = " << f << ", x = " << ppe.x << endl;
 
-        //diff.calcJacobian(ppe.x, ppe.err, ppe.J, 
-        //                  Differentiator::ForwardDifference);
-       // Matrix Jnum = ppe.J;
+        // The Jacobian is assembled from the obstacles' analytic surface
+        // path error Jacobians; see calcPathErrorJacobian().
         calcPathErrorJacobian(state, instInfo, ppe);
-
-        //cout << "DIFF J=" << Jnum-ppe.J;
-        //cout << "DIFF NORM=" << (Jnum-ppe.J).norm() << "\n";
-
         ppe.JInv.factor(ppe.J);
-        //ppe.JInv.factor(Jnum);
+        ++ppe.numIterations;
 
         fold = f;
         xold = ppe.x;
@@ -853,10 +817,9 @@ solveForPathPoints(const State& state, const PathInstanceInfo& instInfo,
         ppe.JInv.solve(ppe.err, dx);
 
         const Real dxnorm = std::sqrt(dx.normSqr()/ppe.x.size()); // rms
-        cout << "|dx| = " << dxnorm << endl;
         if (dxnorm > Real(.99)*dxnormPrev) {
-           std::cout << "\nPATH stalled in " 
-                << i << " iterations err=" << f << " |dx|=" << dxnorm << "\n\n";
+            SimTK_DEBUG3("PATH stalled in %d iterations err=%g |dx|=%g\n",
+                         i, (double)f, (double)dxnorm);
             break;
         }
 
@@ -104,7 +104,7 @@ public:
 // quantities.
 class PathPosEntry {
 public:
-    PathPosEntry() : length(NaN) {}
+    PathPosEntry() : length(NaN), numIterations(0), solverCPUTime(0) {}
 
     // Set the number of obstacles to n. If there is any information already
     // in this object, it is lost.
@@ -121,6 +121,8 @@ public:
     // mapToActive, mapToActiveSurface and mapToCoords are already allocated.
     void initialize(int na, int nas, int nx) {
         length = NaN;
+        numIterations = 0;
+        solverCPUTime = 0;
         // Active obstacles
         eIn_G.clear(); eIn_G.resize(na); // all NaN
         Fu_GB.clear(); Fu_GB.resize(na, SpatialVec(Vec3(NaN)));
@@ -154,6 +156,12 @@ public:
     // configuration and values for contact point coordinates x stored here.
     Real length;
 
+    // Solver statistics for the most recent path solution: the number of
+    // Newton iterations taken and the CPU time in seconds used by the thread
+    // that did the solving.
+    int    numIterations;
+    double solverCPUTime;
+
     //                         ALL OBSTACLES
 
     // Map each cable obstacle to its ActiveObstacleIndex if it is currently
@@ -419,6 +427,12 @@ public:
         return velEntry.lengthDot;
     }
 
+    int getNumPathSolverIterations(const State& state) const 
+    {   return getPosEntry(state).numIterations; }
+
+    Real getPathSolverCPUTime(const State& state) const 
+    {   return Real(getPosEntry(state).solverCPUTime); }
+
     void applyBodyForces(const State& state, Real tension, 
                          Vector_<SpatialVec>& bodyForcesInG) const;
 
@@ -85,3 +85,11 @@ CablePath& CableTrackerSubsystem::
 updCablePath(CablePathIndex cableIx)
 {   return updImpl().updCablePath(cableIx); }
 
+void CableTrackerSubsystem::setNumThreads(int numThreads) {
+    SimTK_APIARGCHECK1_ALWAYS(numThreads > 0, 
+        "CableTrackerSubsystem", "setNumThreads",
+        "Number of threads must be positive but was %d.", numThreads);
+    updImpl().setNumThreads(numThreads);
+}
+int CableTrackerSubsystem::getNumThreads() const
+{   return getImpl().getNumThreads(); }
@@ -48,7 +48,7 @@ class CableTrackerSubsystem::Impl : public Subsystem::Guts {
 public:
 // Constructor registers a default set of Trackers to use with geometry
 // we know about. These can be overridden later.
-Impl() {}
+Impl() : numThreads(1) {}
 
 ~Impl() {}
 
@@ -69,6 +69,12 @@ CablePathIndex adoptCablePath(CablePath& path) {
     return CablePathIndex(cablePaths.size()-1);
 }
 
+void setNumThreads(int nThreads) {
+    if (nThreads != numThreads) executor.reset();
+    numThreads = nThreads;
+}
+int getNumThreads() const {return numThreads;}
+
 // Return the MultibodySystem which owns this CableTrackerSubsystem.
 const MultibodySystem& getMultibodySystem() const 
 {   return MultibodySystem::downcast(getSystem()); }
@@ -125,21 +131,39 @@ int realizeSubsystemInstanceImpl(const State& state) const override {
 }
 
 int realizeSubsystemPositionImpl(const State& state) const override {
-    for (CablePathIndex ix(0); ix < cablePaths.size(); ++ix) {
-        const CablePath& path = getCablePath(ix);
-        path.getImpl().realizePosition(state);
-    }
+    realizeCablePaths(state, Stage::Position);
     return 0;
 }
 
 int realizeSubsystemVelocityImpl(const State& state) const override {
-    for (CablePathIndex ix(0); ix < cablePaths.size(); ++ix) {
-        const CablePath& path = getCablePath(ix);
-        path.getImpl().realizeVelocity(state);
-    }
+    realizeCablePaths(state, Stage::Velocity);
     return 0;
 }
 
+// Solve for every cable path at the given stage (Position or Velocity). The
+// paths are independent of one another so with more than one thread they are
+// handed out to a ParallelExecutor one path at a time; paths differ a lot in
+// cost depending on how many obstacles they are wrapping.
+void realizeCablePaths(const State& state, Stage stage) const {
+    if (numThreads == 1 || cablePaths.size() < 2) {
+        for (CablePathIndex ix(0); ix < cablePaths.size(); ++ix)
+            realizeCablePath(state, stage, ix);
+        return;
+    }
+
+    if (!executor)
+        executor = new ParallelExecutor(numThreads);
+    CablePathTask task(*this, state, stage);
+    executor->executeAndRethrow(task, cablePaths.size());
+}
+
+void realizeCablePath(const State& state, Stage stage, 
+                      CablePathIndex ix) const {
+    const CablePath::Impl& path = getCablePath(ix).getImpl();
+    if (stage == Stage::Position) path.realizePosition(state);
+    else                          path.realizeVelocity(state);
+}
+
 
 int realizeSubsystemAccelerationImpl(const State& state) const override {
     for (CablePathIndex ix(0); ix < cablePaths.size(); ++ix) {
@@ -258,8 +282,29 @@ int calcDecorativeGeometryAndAppendImpl
 SimTK_DOWNCAST(Impl, Subsystem::Guts);
 
 private:
+// This is the ParallelExecutor task for realizing one cable path.
+class CablePathTask : public ParallelExecutor::Task {
+public:
+    CablePathTask(const Impl& impl, const State& state, Stage stage)
+    :   impl(impl), state(state), stage(stage) {}
+
+    void execute(int ix) override {
+        impl.realizeCablePath(state, stage, CablePathIndex(ix));
+    }
+
+private:
+    const Impl&         impl;
+    const State&        state;
+    const Stage         stage;
+};
+
 // TOPOLOGY STATE
 Array_<CablePath, CablePathIndex> cablePaths;
+
+// Number of threads to use for realizing cable paths, and the executor that
+// runs them (created when first needed).
+int                                 numThreads;
+mutable ClonePtr<ParallelExecutor>  executor;
 };
 
 } // namespace SimTK
@@ -36,6 +36,7 @@ patch analysis methods.
 #include "simbody/internal/SimbodyMatterSubsystem.h"
 #include "simbody/internal/MultibodySystem.h"
 
+
 namespace SimTK {
 
 //==============================================================================
@@ -50,7 +51,7 @@ CompliantContactSubsystemImpl(const ContactTrackerSubsystem& tracker)
 :   ForceSubsystemRep("CompliantContactSubsystem", "0.0.1"),
     m_tracker(tracker), m_transitionVelocity(Real(0.01)), 
     m_ooTransitionVelocity(1/m_transitionVelocity), 
-    m_trackDissipatedEnergy(false), m_defaultGenerator(0) 
+    m_trackDissipatedEnergy(false), m_defaultGenerator(0), m_numThreads(1)
 {   
 }
 
@@ -67,6 +68,12 @@ void setTrackDissipatedEnergy(bool shouldTrack) {
 }
 bool getTrackDissipatedEnergy() const {return m_trackDissipatedEnergy;}
 
+void setNumThreads(int numThreads) {
+    if (numThreads != m_numThreads) m_executor.reset();
+    m_numThreads = numThreads;
+}
+int getNumThreads() const {return m_numThreads;}
+
 int getNumContactForces(const State& s) const {
     ensureForceCacheValid(s);
     const Array_<ContactForce>& forces = getForceCache(s);
@@ -168,6 +175,7 @@ void adoptForceGenerator(CompliantContactSubsystem* subsys,
     assert(generator);
     generator->setCompliantContactSubsystem(subsys);
     invalidateSubsystemTopologyCache();
+    m_generatorTable.clear(); // rebuilt by realizeTopology()
     GeneratorMap::iterator p=m_generators.find(generator->getContactTypeId());
     if (p != m_generators.end()) {
         // We're replacing an existing generator.
@@ -184,6 +192,7 @@ void adoptForceGenerator(CompliantContactSubsystem* subsys,
 void adoptDefaultForceGenerator(CompliantContactSubsystem* subsys, 
                                 ContactForceGenerator* generator) {
     invalidateSubsystemTopologyCache();
+    m_generatorTable.clear(); // rebuilt by realizeTopology()
     delete m_defaultGenerator;
     m_defaultGenerator = generator; // just copying the pointer
     if (m_defaultGenerator) 
@@ -199,9 +208,13 @@ bool hasDefaultForceGenerator() const
 {   return m_defaultGenerator != 0; }
 
 // Get the generator registered for this type of contact or the default
-// generator if nothing is registered. 
+// generator if nothing is registered. After realizeTopology() this is just
+// an index into the generator table.
 const ContactForceGenerator& getForceGenerator(ContactTypeId type) const 
-{   GeneratorMap::const_iterator p=m_generators.find(type);
+{   if (type.isValid() && type < (int)m_generatorTable.size()
+        && m_generatorTable[type])
+        return *m_generatorTable[type];
+    GeneratorMap::const_iterator p=m_generators.find(type);
     return p != m_generators.end() ? *p->second : getDefaultForceGenerator(); }
 
 // Get the default generator.
@@ -222,6 +235,18 @@ int realizeSubsystemTopologyImpl(State& s) const override {
     CompliantContactSubsystemImpl* wThis = 
         const_cast<CompliantContactSubsystemImpl*>(this);
 
+    // Flatten the generator map into a table indexed by ContactTypeId so
+    // that finding the generator for a contact doesn't need a map lookup.
+    // Unregistered types get the default generator, which may be null.
+    wThis->m_generatorTable.clear();
+    if (!m_generators.empty()) {
+        wThis->m_generatorTable.resize(m_generators.rbegin()->first + 1,
+                                       m_defaultGenerator);
+        for (GeneratorMap::const_iterator p  = m_generators.begin(); 
+                                          p != m_generators.end(); ++p)
+            wThis->m_generatorTable[p->first] = p->second;
+    }
+
     // Calculating forces includes calculating PE for each force.
     wThis->m_forceCacheIx = allocateLazyCacheEntry(s, 
         Stage::Velocity, new Value<Array_<ContactForce> >());
@@ -357,6 +382,24 @@ void markForceCacheValid(const State& s) const
 void ensurePotentialEnergyCacheValid(const State&) const;
 void ensureForceCacheValid(const State&) const;
 
+// Calculate the force for one active contact, measured and expressed in 
+// Ground, and append it to the given list if the contact produces one.
+void appendContactForce(const State&, const Contact&, 
+                        Array_<ContactForce>& forces) const;
+
+class ForceChunkTask;
+
+// Return true if neither of the bodies in this contact can move because they
+// are Ground or have been put to sleep.
+bool isContactAtRest(const State& state, const Contact& contact) const {
+    const MobilizedBodyIndex mbx1 = 
+        m_tracker.getMobilizedBody(contact.getSurface1()).getMobilizedBodyIndex();
+    const MobilizedBodyIndex mbx2 = 
+        m_tracker.getMobilizedBody(contact.getSurface2()).getMobilizedBodyIndex();
+    return (mbx1 == 0 || m_tracker.isBodyAsleep(state, mbx1))
+        && (mbx2 == 0 || m_tracker.isBodyAsleep(state, mbx2));
+}
+
 
 
     // TOPOLOGY "STATE"
@@ -383,6 +426,11 @@ GeneratorMap                        m_generators;
 // this will either do nothing silently or throw an error.
 ContactForceGenerator*              m_defaultGenerator;
 
+// Number of threads to use for calculating contact forces, and the executor
+// that runs them (created when first needed).
+int                                 m_numThreads;
+mutable ClonePtr<ParallelExecutor>  m_executor;
+
     // TOPOLOGY "CACHE"
 
 // These must be set during realizeTopology and treated as const thereafter.
@@ -391,6 +439,10 @@ ContactForceGenerator*              m_defaultGenerator;
 ZIndex                              m_dissipatedEnergyIx;
 CacheEntryIndex                     m_potEnergyCacheIx;
 CacheEntryIndex                     m_forceCacheIx;
+
+// The generator to use for each ContactTypeId up to the largest registered
+// one; the pointers refer to the generators owned above.
+Array_<const ContactForceGenerator*> m_generatorTable;
 };
 
 void CompliantContactSubsystemImpl::
@@ -421,6 +473,8 @@ ensurePotentialEnergyCacheValid(const State& state) const {
     const int nContacts = active.getNumContacts();
     for (int i=0; i<nContacts; ++i) {
         const Contact& contact = active.getContact(i);
+        if (isContactAtRest(state, contact))
+            continue;
         const ContactForceGenerator& generator = 
             getForceGenerator(contact.getTypeId());
         ContactForce force;
@@ -432,6 +486,35 @@ ensurePotentialEnergyCacheValid(const State& state) const {
 }
 
 
+// This is the ParallelExecutor task for calculating contact forces. Each 
+// chunk is a contiguous range of the active contacts and gets its own list of
+// forces so the lists can be joined in order afterwards.
+class CompliantContactSubsystemImpl::ForceChunkTask 
+:   public ParallelExecutor::Task {
+public:
+    ForceChunkTask(const CompliantContactSubsystemImpl& impl, 
+                   const State& state, const ContactSnapshot& active,
+                   Array_< Array_<ContactForce> >& chunkForces)
+    :   impl(impl), state(state), active(active), chunkForces(chunkForces) {}
+
+    void execute(int chunk) override {
+        const int nContacts = active.getNumContacts();
+        const int nChunks   = (int)chunkForces.size();
+        const int first = (int)((long long)chunk*nContacts/nChunks);
+        const int last  = (int)((long long)(chunk+1)*nContacts/nChunks);
+        Array_<ContactForce>& forces = chunkForces[chunk];
+        forces.clear();
+        for (int i=first; i < last; ++i)
+            impl.appendContactForce(state, active.getContact(i), forces);
+    }
+
+private:
+    const CompliantContactSubsystemImpl&    impl;
+    const State&                            state;
+    const ContactSnapshot&                  active;
+    Array_< Array_<ContactForce> >&         chunkForces;
+};
+
 void CompliantContactSubsystemImpl::
 ensureForceCacheValid(const State& state) const {
     if (isForceCacheValid(state)) return;
@@ -442,53 +525,78 @@ ensureForceCacheValid(const State& state) const {
     Array_<ContactForce>& forces = updForceCache(state);
     forces.clear();
 
-
     const ContactSnapshot& active = m_tracker.getActiveContacts(state);
     const int nContacts = active.getNumContacts();
-    for (int i=0; i<nContacts; ++i) {
-        const Contact& contact = active.getContact(i);
-        if (contact.getCondition() == Contact::Broken) {
-            // No need to generate forces; this will be gone next time.
-            continue;
-        }
-        const Transform& X_S1S2 = contact.getTransform();
-        const ContactSurfaceIndex surf1(contact.getSurface1());
-        const ContactSurfaceIndex surf2(contact.getSurface2());
-        const MobilizedBody& mobod1 = m_tracker.getMobilizedBody(surf1);
-        const MobilizedBody& mobod2 = m_tracker.getMobilizedBody(surf2);
-
-        // TODO: These two are expensive (63 flops each) and shouldn't have 
-        // to be recalculated here since we must have used them in creating
-        // the Contact and X_S1S2.
-        const Transform X_GS1 = mobod1.findFrameTransformInGround
-            (state, m_tracker.getContactSurfaceTransform(surf1));
-        const Transform X_GS2 = mobod2.findFrameTransformInGround
-            (state, m_tracker.getContactSurfaceTransform(surf2));
-
-        const SpatialVec V_GS1 = mobod1.findFrameVelocityInGround
-            (state, m_tracker.getContactSurfaceTransform(surf1));
-        const SpatialVec V_GS2 = mobod2.findFrameVelocityInGround
-            (state, m_tracker.getContactSurfaceTransform(surf2));
-
-        // Calculate the relative velocity of S2 in S1, expressed in S1.
-        const SpatialVec V_S1S2 =
-            findRelativeVelocity(X_GS1, V_GS1, X_GS2, V_GS2);   // 51 flops
 
-        const ContactForceGenerator& generator = 
-            getForceGenerator(contact.getTypeId());
-        forces.push_back(); // allocate a new garbage ContactForce
-        // Calculate the contact force measured and expressed in S1.
-        generator.calcContactForce(state, contact, V_S1S2, forces.back());
-        // Re-express the contact force in Ground for later use.
-        if (forces.back().isValid())
-            forces.back().changeFrameInPlace(X_GS1); // switch to Ground
-        else
-            forces.pop_back(); // never mind ...
+    if (m_numThreads == 1 || nContacts < 2) {
+        for (int i=0; i<nContacts; ++i)
+            appendContactForce(state, active.getContact(i), forces);
+        markForceCacheValid(state);
+        return;
     }
 
+    // Use a few chunks per thread so that an expensive contact (a mesh, say)
+    // doesn't leave the other threads idle.
+    const int nChunks = std::min(nContacts, 4*m_numThreads);
+    Array_< Array_<ContactForce> > chunkForces(nChunks);
+    if (!m_executor)
+        m_executor = new ParallelExecutor(m_numThreads);
+    ForceChunkTask task(*this, state, active, chunkForces);
+    m_executor->executeAndRethrow(task, nChunks);
+
+    for (int c=0; c < nChunks; ++c)
+        for (unsigned i=0; i < chunkForces[c].size(); ++i)
+            forces.push_back(chunkForces[c][i]);
+
     markForceCacheValid(state);
 }
 
+void CompliantContactSubsystemImpl::
+appendContactForce(const State& state, const Contact& contact, 
+                   Array_<ContactForce>& forces) const {
+    if (contact.getCondition() == Contact::Broken) {
+        // No need to generate forces; this will be gone next time.
+        return;
+    }
+    if (isContactAtRest(state, contact)) {
+        // Both bodies are asleep (or Ground) so their mobilizers are
+        // locked and a force would have no effect.
+        return;
+    }
+    const ContactSurfaceIndex surf1(contact.getSurface1());
+    const ContactSurfaceIndex surf2(contact.getSurface2());
+    const MobilizedBody& mobod1 = m_tracker.getMobilizedBody(surf1);
+    const MobilizedBody& mobod2 = m_tracker.getMobilizedBody(surf2);
+
+    // TODO: These two are expensive (63 flops each) and shouldn't have 
+    // to be recalculated here since we must have used them in creating
+    // the Contact and X_S1S2.
+    const Transform X_GS1 = mobod1.findFrameTransformInGround
+        (state, m_tracker.getContactSurfaceTransform(surf1));
+    const Transform X_GS2 = mobod2.findFrameTransformInGround
+        (state, m_tracker.getContactSurfaceTransform(surf2));
+
+    const SpatialVec V_GS1 = mobod1.findFrameVelocityInGround
+        (state, m_tracker.getContactSurfaceTransform(surf1));
+    const SpatialVec V_GS2 = mobod2.findFrameVelocityInGround
+        (state, m_tracker.getContactSurfaceTransform(surf2));
+
+    // Calculate the relative velocity of S2 in S1, expressed in S1.
+    const SpatialVec V_S1S2 =
+        findRelativeVelocity(X_GS1, V_GS1, X_GS2, V_GS2);   // 51 flops
+
+    const ContactForceGenerator& generator = 
+        getForceGenerator(contact.getTypeId());
+    forces.push_back(); // allocate a new garbage ContactForce
+    // Calculate the contact force measured and expressed in S1.
+    generator.calcContactForce(state, contact, V_S1S2, forces.back());
+    // Re-express the contact force in Ground for later use.
+    if (forces.back().isValid())
+        forces.back().changeFrameInPlace(X_GS1); // switch to Ground
+    else
+        forces.pop_back(); // never mind ...
+}
+
 
 //==============================================================================
 //                      COMPLIANT CONTACT SUBSYSTEM
@@ -525,6 +633,7 @@ CompliantContactSubsystem::CompliantContactSubsystem
     adoptForceGenerator(new ContactForceGenerator::HertzCircular());
     adoptForceGenerator(new ContactForceGenerator::HertzElliptical());
     adoptForceGenerator(new ContactForceGenerator::BrickHalfSpacePenalty());
+    adoptForceGenerator(new ContactForceGenerator::ConvexHullPenalty());
     adoptForceGenerator(new ContactForceGenerator::ElasticFoundation());
     adoptDefaultForceGenerator(new ContactForceGenerator::DoNothing());
 }
@@ -545,6 +654,15 @@ void CompliantContactSubsystem::setTrackDissipatedEnergy(bool shouldTrack)
 bool CompliantContactSubsystem::getTrackDissipatedEnergy() const
 {   return getImpl().getTrackDissipatedEnergy(); }
 
+void CompliantContactSubsystem::setNumThreads(int numThreads) {
+    SimTK_APIARGCHECK1_ALWAYS(numThreads > 0, 
+        "CompliantContactSubsystem", "setNumThreads",
+        "Number of threads must be positive but was %d.", numThreads);
+    updImpl().setNumThreads(numThreads);
+}
+int CompliantContactSubsystem::getNumThreads() const
+{   return getImpl().getNumThreads(); }
+
 int CompliantContactSubsystem::getNumContactForces(const State& s) const
 {   return getImpl().getNumContactForces(s); }
 
@@ -1179,19 +1297,22 @@ void ContactForceGenerator::HertzElliptical::calcContactPatch
                                        &patch_S1.m_elements);
 }
 
-// Given a set of vertices of surface B penetrating a halfspace H with given
-// surface normal n, generate at each vertex a normal force resisting 
-// its penetration and penetration rate, and a tangential force resisting slip.
-// The model applied at each vertex is just a kx force; that really only makes
-// sense for face-face contact where the contact area doesn't change with
-// the penetration depth. A single-vertex contact displaces a volume 
-// proportional to x^3, a single-edge contact displaces x^2 but we're 
-// igoring that here.
-static void calcPointHalfSpacePenaltyForce
+// Given a set of points of surface B that have penetrated surface H by given
+// depths along H's surface normal n, generate at each point a normal force 
+// resisting its penetration and penetration rate, and a tangential force 
+// resisting slip. The model applied at each point is just a kx force; that 
+// really only makes sense for face-face contact where the contact area doesn't
+// change with the penetration depth. A single-vertex contact displaces a 
+// volume proportional to x^3, a single-edge contact displaces x^2 but we're 
+// igoring that here. At least one point must have positive depth.
+static void calcPointPenaltyForce
    (const CompliantContactSubsystem& subsys,
     const ContactTrackerSubsystem&   tracker, 
     const State&                     state,
-    const BrickHalfSpaceContact&     contact,
+    const Contact&                   contact,
+    const UnitVec3&                  normal_H,
+    const Array_<Vec3>&              points_H, // undeformed, in H
+    const Array_<Real>&              depths,   // along normal_H
     const SpatialVec&                V_HB, // relative surface velocity, B in H
     ContactForce&                    contactForce_H,
     Array_<ContactDetail>*           details) // pass as null if you don't care
@@ -1199,19 +1320,11 @@ static void calcPointHalfSpacePenaltyForce
     contactForce_H.clear(); // no contact; invalidate return result
     if (details) details->clear();
 
-    const int lowestVertex = contact.getLowestVertex();
-    const Real lowestDepth = contact.getDepth();
-
-    if (lowestDepth <= 0) {
-        return; // not contacting
-    }
-
     const ContactSurfaceIndex surfHx = contact.getSurface1();
     const ContactSurfaceIndex surfBx = contact.getSurface2();
     const Transform&          X_HB   = contact.getTransform();
 
     // Abbreviations.
-    const Rotation& R_HB = X_HB.R(); // orientation of B in H
     const Vec3&     p_HB = X_HB.p(); // position of Bo in H
     const Vec3&     w_HB = V_HB[0];  // ang. vel. of B in H
     const Vec3&     v_HB = V_HB[1];  // vel. of Bo in H
@@ -1221,35 +1334,6 @@ static void calcPointHalfSpacePenaltyForce
     const ContactMaterial& matH   = surfH.getMaterial();
     const ContactMaterial& matB   = surfB.getMaterial();
 
-    const ContactGeometry::HalfSpace& halfSpace =
-        ContactGeometry::HalfSpace::getAs(surfH.getShape());
-    const ContactGeometry::Brick& brick = 
-        ContactGeometry::Brick::getAs(surfB.getShape());
-
-    const UnitVec3 normal_H = halfSpace.getNormal();
-
-    // The Box represents the Brick surface as a convex mesh with known 
-    // connectivity. We know the vertex that is most penetrated. There are
-    // three faces connected to that vertex; we want the one whose normal
-    // is closest to antiparallel to the half-space normal.
-    const Geo::Box& box = brick.getGeoBox();
-    int faces[3], which[3];
-    box.getVertexFaces(lowestVertex, faces, which);
-    // We want the most negative cosine we can get.
-    int bestFace = -1, bestWhich = -1; Real bestCos = Infinity;
-    for (int f=0; f < 3; ++f) {
-        const int face = faces[f];
-        const Real cos = 
-            dot(normal_H, R_HB.getAxisUnitVec(box.getFaceCoordinateDirection(face)));
-        if (cos < bestCos)
-            bestFace=face, bestWhich=which[f], bestCos=cos;
-    }
-
-    SimTK_ASSERT_ALWAYS(bestCos < 0,
-      "calcPointHalfSpacePenaltyForce(): lowest vertex should have had a face "
-      "roughly antiparallel to the half-space. Is something wrong with the box "
-      "mesh connectivity?");
-
     // Calculate composite material properties.
     // TODO: this pairwise material calculation (~60 flops) could be cached.
 
@@ -1294,14 +1378,10 @@ static void calcPointHalfSpacePenaltyForce
     Real totalNormalMoment = 0;
 
 
-    int vertices[4];
-    box.getFaceVertices(bestFace, vertices);
     int nActiveVertices = 0;
-    for (int i=0; i < 4; ++i) {
-        const int  vx  = vertices[i];
-        const Vec3 v_B = box.getVertexPos(vx);
-        const Vec3 v_H = X_HB * v_B;          // 18 flops
-        const Real x   = -dot(v_H, normal_H); // undeformed pen. depth; 6 flops
+    for (unsigned i=0; i < points_H.size(); ++i) {
+        const Vec3& v_H = points_H[i];
+        const Real  x   = depths[i];  // undeformed penetration depth
         if (x <= 0) continue; // not penetrated (1 flop)
 
         // Actual contact point moves closer to stiffer surface. Would be at
@@ -1417,6 +1497,75 @@ static void calcPointHalfSpacePenaltyForce
     contactForce_H.setPowerDissipation(totalPower);
 }
 
+// Apply the point penalty force at the vertices of the brick face that is in 
+// contact with the halfspace.
+static void calcPointHalfSpacePenaltyForce
+   (const CompliantContactSubsystem& subsys,
+    const ContactTrackerSubsystem&   tracker, 
+    const State&                     state,
+    const BrickHalfSpaceContact&     contact,
+    const SpatialVec&                V_HB, // relative surface velocity, B in H
+    ContactForce&                    contactForce_H,
+    Array_<ContactDetail>*           details) // pass as null if you don't care
+{
+    contactForce_H.clear(); // no contact; invalidate return result
+    if (details) details->clear();
+
+    const int lowestVertex = contact.getLowestVertex();
+    const Real lowestDepth = contact.getDepth();
+
+    if (lowestDepth <= 0) {
+        return; // not contacting
+    }
+
+    const Transform& X_HB = contact.getTransform();
+    const Rotation&  R_HB = X_HB.R(); // orientation of B in H
+
+    const ContactSurface& surfH = tracker.getContactSurface(contact.getSurface1());
+    const ContactSurface& surfB = tracker.getContactSurface(contact.getSurface2());
+
+    const ContactGeometry::HalfSpace& halfSpace =
+        ContactGeometry::HalfSpace::getAs(surfH.getShape());
+    const ContactGeometry::Brick& brick = 
+        ContactGeometry::Brick::getAs(surfB.getShape());
+
+    const UnitVec3 normal_H = halfSpace.getNormal();
+
+    // The Box represents the Brick surface as a convex mesh with known 
+    // connectivity. We know the vertex that is most penetrated. There are
+    // three faces connected to that vertex; we want the one whose normal
+    // is closest to antiparallel to the half-space normal.
+    const Geo::Box& box = brick.getGeoBox();
+    int faces[3], which[3];
+    box.getVertexFaces(lowestVertex, faces, which);
+    // We want the most negative cosine we can get.
+    int bestFace = -1, bestWhich = -1; Real bestCos = Infinity;
+    for (int f=0; f < 3; ++f) {
+        const int face = faces[f];
+        const Real cos = 
+            dot(normal_H, R_HB.getAxisUnitVec(box.getFaceCoordinateDirection(face)));
+        if (cos < bestCos)
+            bestFace=face, bestWhich=which[f], bestCos=cos;
+    }
+
+    SimTK_ASSERT_ALWAYS(bestCos < 0,
+      "calcPointHalfSpacePenaltyForce(): lowest vertex should have had a face "
+      "roughly antiparallel to the half-space. Is something wrong with the box "
+      "mesh connectivity?");
+
+    int vertices[4];
+    box.getFaceVertices(bestFace, vertices);
+    Array_<Vec3> points_H(4); Array_<Real> depths(4);
+    for (int i=0; i < 4; ++i) {
+        const Vec3 v_B = box.getVertexPos(vertices[i]);
+        points_H[i] = X_HB * v_B;                  // 18 flops
+        depths[i]   = -dot(points_H[i], normal_H); // 6 flops
+    }
+
+    calcPointPenaltyForce(subsys, tracker, state, contact, normal_H,
+                          points_H, depths, V_HB, contactForce_H, details);
+}
+
 //==============================================================================
 //                      BRICK HALFSPACE PENALTY GENERATOR
 //==============================================================================
@@ -1472,6 +1621,65 @@ void ContactForceGenerator::BrickHalfSpacePenalty::calcContactPatch
 
 
 
+//==============================================================================
+//                          CONVEX HULL PENALTY GENERATOR
+//==============================================================================
+// The ConvexHullContact already has the contact normal and the penetrating
+// points, so this is just the point penalty force.
+static void calcConvexHullPenaltyForce
+   (const CompliantContactSubsystem& subsys,
+    const Contact&                   overlap,
+    const SpatialVec&                V_S1S2,
+    const State&                     state,
+    ContactForce&                    contactForce_S1,
+    Array_<ContactDetail>*           details)
+{
+    SimTK_ASSERT(ConvexHullContact::isInstance(overlap),
+        "ContactForceGenerator::ConvexHullPenalty: expected"
+        " ConvexHullContact.");
+
+    const ConvexHullContact& contact = ConvexHullContact::getAs(overlap);
+    if (contact.getDepth() <= 0) {
+        contactForce_S1.clear(); // not contacting
+        if (details) details->clear();
+        return;
+    }
+
+    Array_<Vec3> points(contact.getNumPoints()); 
+    Array_<Real> depths(contact.getNumPoints());
+    for (int i=0; i < contact.getNumPoints(); ++i) {
+        points[i] = contact.getPoint(i);
+        depths[i] = contact.getPointDepth(i);
+    }
+
+    calcPointPenaltyForce(subsys, subsys.getContactTrackerSubsystem(), state,
+                          contact, contact.getNormal(), points, depths,
+                          V_S1S2, contactForce_S1, details);
+}
+
+void ContactForceGenerator::ConvexHullPenalty::calcContactForce
+   (const State&            state,
+    const Contact&          overlap,    // contains X_S1S2
+    const SpatialVec&       V_S1S2,     // relative surface velocity, S2 in S1
+    ContactForce&           contactForce_S1) const
+{
+    calcConvexHullPenaltyForce(getCompliantContactSubsystem(), overlap, V_S1S2,
+                               state, contactForce_S1, 0);
+}
+
+void ContactForceGenerator::ConvexHullPenalty::calcContactPatch
+   (const State&      state,
+    const Contact&    overlap,
+    const SpatialVec& V_S1S2,
+    ContactPatch&     patch_S1) const
+{
+    calcConvexHullPenaltyForce(getCompliantContactSubsystem(), overlap, V_S1S2,
+                               state, patch_S1.m_resultant, 
+                               &patch_S1.m_elements);
+}
+
+
+
 //==============================================================================
 //                         ELASTIC FOUNDATION GENERATOR
 //==============================================================================
@@ -1610,6 +1818,9 @@ void ContactForceGenerator::ElasticFoundation::calcContactForceAndDetails
     // Now generate forces using the meshed surfaces only (one or two).
 
 
+    const Array_<int>& faces1 = contact.getSurface1Faces();
+    const Array_<int>& faces2 = contact.getSurface2Faces();
+
     // We want both patches to accumulate forces at the same point in
     // space. For numerical reasons this should be near the center of the
     // patch.
@@ -1619,7 +1830,7 @@ void ContactForceGenerator::ElasticFoundation::calcContactForceAndDetails
         const ContactGeometry::TriangleMesh& mesh1 = 
             ContactGeometry::TriangleMesh::getAs(shape1);
 
-        calcWeightedPatchCentroid(mesh1, contact.getSurface1Faces(),
+        calcWeightedPatchCentroid(mesh1, faces1,
                                   weightedPatchCentroid1_S1, patchArea1);
     }
     if (shape2.getTypeId() == ContactGeometry::TriangleMesh::classTypeId()) {
@@ -1627,7 +1838,7 @@ void ContactForceGenerator::ElasticFoundation::calcContactForceAndDetails
             ContactGeometry::TriangleMesh::getAs(shape2);
         Vec3 weightedPatchCentroid2_S2;
 
-        calcWeightedPatchCentroid(mesh2, contact.getSurface2Faces(),
+        calcWeightedPatchCentroid(mesh2, faces2,
                                   weightedPatchCentroid2_S2, patchArea2);
         // Remeasure patch2's weighted centroid from surface1's frame;
         // be sure to weight the new offset also.
@@ -1695,7 +1906,7 @@ void ContactForceGenerator::ElasticFoundation::calcContactForceAndDetails
             ContactGeometry::TriangleMesh::getAs(shape1);
 
         processOneMesh(state, 
-            mesh, contact.getSurface1Faces(),
+            mesh, faces1,
             X_S1S2, V_S1S2, shape2,
             s1, areaScale1,
             kh, c, us, ud, uv,
@@ -1725,7 +1936,7 @@ void ContactForceGenerator::ElasticFoundation::calcContactForceAndDetails
             wantDetails ? contactDetails_S1->size() : 0;
 
         processOneMesh(state, 
-            mesh, contact.getSurface2Faces(),
+            mesh, faces2,
             X_S2S1, V_S2S1, shape1,
             s2, areaScale2,
             kh, c, us, ud, uv,
@@ -1790,14 +2001,13 @@ void ContactForceGenerator::ElasticFoundation::calcContactForceAndDetails
 void ContactForceGenerator::ElasticFoundation::
 calcWeightedPatchCentroid
    (const ContactGeometry::TriangleMesh&    mesh,
-    const std::set<int>&                    insideFaces,
+    const Array_<int>&                      insideFaces,
     Vec3&                                   weightedPatchCentroid,
     Real&                                   patchArea) const
 {
     weightedPatchCentroid = Vec3(0); patchArea = 0;
-    for (std::set<int>::const_iterator iter = insideFaces.begin(); 
-                                       iter != insideFaces.end(); ++iter)
-    {   const int  face = *iter;
+    for (unsigned i=0; i < insideFaces.size(); ++i)
+    {   const int  face = insideFaces[i];
         const Real area = mesh.getFaceArea(face);
         weightedPatchCentroid   += area*mesh.findCentroid(face); 
         patchArea               += area; 
@@ -1824,7 +2034,7 @@ void ContactForceGenerator::ElasticFoundation::
 processOneMesh
    (const State&                            state,
     const ContactGeometry::TriangleMesh&    mesh,
-    const std::set<int>&                    insideFaces,
+    const Array_<int>&                      insideFaces,
     const Transform&                        X_MO, 
     const SpatialVec&                       V_MO,
     const ContactGeometry&                  other,
@@ -1864,9 +2074,8 @@ processOneMesh
     // Now loop over all the faces again, evaluate the force from each 
     // spring, and apply it at the patch centroid.
     // This costs roughly 300 flops per contacting face.
-    for (std::set<int>::const_iterator iter = insideFaces.begin(); 
-                                       iter != insideFaces.end(); ++iter) 
-    {   const int   face        = *iter;
+    for (unsigned i=0; i < insideFaces.size(); ++i) 
+    {   const int   face        = insideFaces[i];
         const Vec3  springPos_M = mesh.findCentroid(face);
         const Real  faceArea    = areaScaleFactor*mesh.getFaceArea(face);
 
@@ -30,6 +30,37 @@
 
 namespace SimTK {
 
+//==============================================================================
+//                            UNILATERAL CONTACT
+//==============================================================================
+// A body can't move if its mobilizer and those of all its ancestors are
+// locked or have no mobilities (welds).
+static bool isPathToGroundLocked(const State& state, 
+                                 const MobilizedBody& mobod) {
+    for (const MobilizedBody* b = &mobod; !b->isGround(); 
+         b = &b->getParentMobilizedBody())
+        if (b->getNumU(state) && !b->isLocked(state))
+            return false;
+    return true;
+}
+
+bool UnilateralContact::
+isConstraintLocked(const State& state, const Constraint& constraint) {
+    for (ConstrainedBodyIndex cbx(0); 
+         cbx < constraint.getNumConstrainedBodies(); ++cbx)
+        if (!isPathToGroundLocked(state, 
+                constraint.getMobilizedBodyFromConstrainedBody(cbx)))
+            return false;
+    for (ConstrainedMobilizerIndex cmx(0); 
+         cmx < constraint.getNumConstrainedMobilizers(); ++cmx)
+        if (!isPathToGroundLocked(state, 
+                constraint.getMobilizedBodyFromConstrainedMobilizer(cmx)))
+            return false;
+    return true;
+}
+
+
+
 //==============================================================================
 //                           HARD STOP UPPER / LOWER
 //==============================================================================
@@ -2429,7 +2429,8 @@ Constraint::CoordinateCouplerImpl::CoordinateCouplerImpl
     const Array_<MobilizerQIndex>&      coordQIndex)
 :   Implementation(matter, 1, 0, 0), function(function), 
     coordBodies(coordMobod.size()), coordIndices(coordQIndex),
-    temp(coordBodies.size()), referenceCount(new int[1]) 
+    temp(coordBodies.size()), tempGradient(coordBodies.size()), 
+    referenceCount(new int[1]) 
 {
     assert(coordBodies.size() == coordIndices.size());
     assert(coordIndices.size() == function->getArgumentSize());
@@ -2450,7 +2451,7 @@ calcPositionErrors
 {
     for (int i = 0; i < temp.size(); ++i)
         temp[i] = getOneQ(s, constrainedQ, coordBodies[i], coordIndices[i]);
-    perr[0] = function->calcValue(temp);
+    perr[0] = function->calcValueAt(temp.size(), &temp[0]);
 }
 
 void Constraint::CoordinateCouplerImpl::
@@ -2463,10 +2464,10 @@ calcPositionDotErrors
     pverr[0] = 0;
     for (int i = 0; i < temp.size(); ++i)
         temp[i] = getOneQFromState(s, coordBodies[i], coordIndices[i]);
-    Array_<int> components(1);
+    function->calcValueAndGradientAt(temp.size(), &temp[0], 
+                                     &tempGradient[0]);
     for (int i = 0; i < temp.size(); ++i) {
-        components[0] = i;
-        pverr[0] += function->calcDerivative(components, temp)
+        pverr[0] += tempGradient[i]
                     * getOneQDot(s, constrainedQDot, 
                                  coordBodies[i], coordIndices[i]);
     }
@@ -2484,22 +2485,23 @@ calcPositionDotDotErrors
         temp[i] = getOneQFromState(s, coordBodies[i], coordIndices[i]);
 
     // TODO this could be made faster by using symmetry.
-    Array_<int> components(2);
+    int components[2];
     for (int i = 0; i < temp.size(); ++i) {
         components[0] = i;
         Real qdoti = getOneQDotFromState(s, coordBodies[i], coordIndices[i]);
         for (int j = 0; j < temp.size(); ++j) {
             components[1] = j;
             Real qdotj = getOneQDotFromState(s, coordBodies[j], coordIndices[j]);
-            paerr[0] += function->calcDerivative(components, temp)
+            paerr[0] += function->calcDerivativeAt(2, components, 
+                                                   temp.size(), &temp[0])
                         * qdoti * qdotj;
         }
     }
 
-    Array_<int> component(1);
+    function->calcValueAndGradientAt(temp.size(), &temp[0], 
+                                     &tempGradient[0]);
     for (int i = 0; i < temp.size(); ++i) {
-        component[0] = i;
-        paerr[0] += function->calcDerivative(component, temp)
+        paerr[0] += tempGradient[i]
                     * getOneQDotDot(s, constrainedQDotDot, 
                                     coordBodies[i], coordIndices[i]);
     }
@@ -2520,10 +2522,10 @@ addInPositionConstraintForces
     for (int i = 0; i < temp.size(); ++i)
         temp[i] = getOneQFromState(s, coordBodies[i], coordIndices[i]);
 
-    Array_<int> components(1);
+    function->calcValueAndGradientAt(temp.size(), &temp[0], 
+                                     &tempGradient[0]);
     for (int i = 0; i < temp.size(); ++i) {
-        components[0] = i;
-        const Real fq = lambda * function->calcDerivative(components, temp);
+        const Real fq = lambda * tempGradient[i];
         addInOneQForce(s, coordBodies[i], coordIndices[i], fq, qForces);
     }
 }
@@ -2562,7 +2564,8 @@ Constraint::SpeedCouplerImpl::SpeedCouplerImpl
 :   Implementation(matter, 0, 1, 0), function(function), 
     speedBodies(speedBody.size()), speedIndices(speedIndex), 
     coordBodies(coordBody), coordIndices(coordIndex),
-    temp(speedBody.size()+coordBody.size()), referenceCount(new int[1]) 
+    temp(speedBody.size()+coordBody.size()), 
+    tempGradient(speedBody.size()+coordBody.size()), referenceCount(new int[1]) 
 {
     assert(speedBodies.size() == speedIndices.size());
     assert(coordBodies.size() == coordIndices.size());
@@ -2590,7 +2593,7 @@ calcVelocityErrors
         temp[i+speedBodies.size()] = 
             getMatterSubsystem().getMobilizedBody(coordBodies[i])
                                 .getOneQ(s, coordIndices[i]);
-    verr[0] = function->calcValue(temp);
+    verr[0] = function->calcValueAt(temp.size(), &temp[0]);
 }
 
 // d verr / dt = (df/du)*udot + (df/dq)*qdot.
@@ -2609,21 +2612,20 @@ calcVelocityDotErrors
         temp[i+speedBodies.size()] = q;
     }
 
-    Array_<int> components(1);
+    function->calcValueAndGradientAt(temp.size(), &temp[0], 
+                                     &tempGradient[0]);
     vaerr[0] = 0;
     // Differentiate the u-dependent terms here.
     for (int i = 0; i < (int)speedBodies.size(); ++i) {
-        components[0] = i;
-        vaerr[0] += function->calcDerivative(components, temp)
+        vaerr[0] += tempGradient[i]
                     * getOneUDot(s, constrainedUDot, 
                                  speedBodies[i], speedIndices[i]);
     }
     // Differentiate the q-dependent terms here.
     for (int i = 0; i < (int)coordBodies.size(); ++i) {
-        components[0] = i + speedBodies.size();
         const Real qdot = getMatterSubsystem().getMobilizedBody(coordBodies[i])
                                               .getOneQDot(s, coordIndices[i]);
-        vaerr[0] += function->calcDerivative(components, temp) * qdot;
+        vaerr[0] += tempGradient[i + speedBodies.size()] * qdot;
     }
 }
 
@@ -2645,11 +2647,10 @@ addInVelocityConstraintForces
             getMatterSubsystem().getMobilizedBody(coordBodies[i])
                                 .getOneQ(s, coordIndices[i]);
 
-    Array_<int> components(1);
     // Only the u-dependent terms generate forces.
     for (int i = 0; i < (int) speedBodies.size(); ++i) {
-        components[0] = i;
-        const Real force = function->calcDerivative(components, temp)
+        const Real force = function->calcDerivativeAt(1, &i, temp.size(), 
+                                                      &temp[0])
                            * lambda;
         addInOneMobilityForce(s, speedBodies[i], speedIndices[i], 
                               force, mobilityForces);
@@ -2674,7 +2675,7 @@ Constraint::PrescribedMotionImpl::PrescribedMotionImpl
     MobilizedBodyIndex coordBody, 
     MobilizerQIndex coordIndex)
 :   Implementation(matter, 1, 0, 0), function(function), 
-    coordIndex(coordIndex), temp(1), referenceCount(new int[1]) 
+    coordIndex(coordIndex), referenceCount(new int[1]) 
 {
     assert(function->getArgumentSize() == 1);
     assert(function->getMaxDerivativeOrder() >= 2);
@@ -2691,9 +2692,9 @@ calcPositionErrors
     const Array_<Real,     ConstrainedQIndex>&      constrainedQ,
     Array_<Real>&                                   perr) const
 {
-    temp[0] = s.getTime();
+    const Real t = s.getTime();
     perr[0] = getOneQ(s, constrainedQ, coordBody, coordIndex) 
-              - function->calcValue(temp);
+              - function->calcValueAt(1, &t);
 }
 
 void Constraint::PrescribedMotionImpl::
@@ -2703,10 +2704,10 @@ calcPositionDotErrors
     const Array_<Real,      ConstrainedQIndex>&     constrainedQDot,
     Array_<Real>&                                   pverr) const
 {
-    temp[0] = s.getTime();
-    Array_<int> components(1, 0); // i.e., components={0}
+    const Real t = s.getTime();
+    const int components[1] = {0};
     pverr[0] = getOneQDot(s, constrainedQDot, coordBody, coordIndex) 
-               - function->calcDerivative(components, temp);
+               - function->calcDerivativeAt(1, components, 1, &t);
 }
 
 void Constraint::PrescribedMotionImpl::
@@ -2716,10 +2717,10 @@ calcPositionDotDotErrors
     const Array_<Real,      ConstrainedQIndex>&     constrainedQDotDot,
     Array_<Real>&                                   paerr) const
 {
-    temp[0] = s.getTime();
-    Array_<int> components(2, 0); // i.e., components={0,0}
+    const Real t = s.getTime();
+    const int components[2] = {0,0};
     paerr[0] = getOneQDotDot(s, constrainedQDotDot, coordBody, coordIndex)  
-               - function->calcDerivative(components, temp);
+               - function->calcDerivativeAt(2, components, 1, &t);
 }
 
 void Constraint::PrescribedMotionImpl::
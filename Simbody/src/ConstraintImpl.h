@@ -3128,9 +3128,10 @@ Array_<MobilizerQIndex>             coordIndices;
 //  TOPOLOGY CACHE
 //  None.
 
-//  A reusable temporary variable allocated to the correct size
-//  to hold all the Function arguments.
+//  Reusable temporary variables allocated to the correct size
+//  to hold all the Function arguments and its gradient.
 mutable Vector                      temp;
+mutable Vector                      tempGradient;
 
 // This allows copies to be made of this constraint which share
 // the function object.
@@ -3193,6 +3194,7 @@ Array_<MobilizedBodyIndex>          coordBodies;
 Array_<MobilizerUIndex>             speedIndices;
 Array_<MobilizerQIndex>             coordIndices;
 mutable Vector                      temp;
+mutable Vector                      tempGradient;
 };
 
 
@@ -3250,7 +3252,6 @@ const Function*             function;
 int*                        referenceCount;
 ConstrainedMobilizerIndex   coordBody;
 MobilizerQIndex             coordIndex;
-mutable Vector              temp;
 };
 
 
@@ -134,6 +134,8 @@ ContactTrackerSubsystemImpl() : m_defaultTracker(0) {
     adoptContactTracker(new ContactTracker::HalfSpaceTriangleMesh());
     adoptContactTracker(new ContactTracker::SphereTriangleMesh());
     adoptContactTracker(new ContactTracker::TriangleMeshTriangleMesh());
+    adoptContactTracker(new ContactTracker::HalfSpaceConvexHull());
+    adoptContactTracker(new ContactTracker::ConvexHullPair());
 
     // Handle sphere-ellipsoid and ellipsoid-ellipsoid by treating them as
     // convex objects represented by their implicit functions.
@@ -208,6 +210,22 @@ ContactSnapshot& updNextPredictedContacts(const State& state) const {
         (updDiscreteVarUpdateValue(state, m_predictedContactsIx));
     return contacts;
 }
+const Array_<bool,MobilizedBodyIndex>& getAsleep(const State& state) const {
+    return Value<Array_<bool,MobilizedBodyIndex> >::downcast
+        (getDiscreteVariable(state, m_asleepIx));
+}
+Array_<bool,MobilizedBodyIndex>& updAsleep(State& state) const {
+    return Value<Array_<bool,MobilizedBodyIndex> >::updDowncast
+        (updDiscreteVariable(state, m_asleepIx));
+}
+
+// A surface is at rest if its body is Ground or is asleep.
+bool isSurfaceAtRest(const Array_<bool,MobilizedBodyIndex>& asleep,
+                     ContactSurfaceIndex surf) const {
+    const MobilizedBodyIndex mbx = 
+        m_surfaces[surf].mobod->getMobilizedBodyIndex();
+    return mbx == 0 || asleep[mbx];
+}
 
 // Run through all the bodies to find the contact surfaces, assigning each
 // a unique ContactSurfaceIndex. Then for each surface, get its geometry
@@ -228,6 +246,10 @@ int realizeSubsystemTopologyImpl(State& state) const override {
     const SimbodyMatterSubsystem& matter = getMatterSubsystem();
 
     const int numBodies = matter.getNumBodies();
+    wThis->m_asleepIx = allocateDiscreteVariable
+        (state, Stage::Instance, 
+         new Value<Array_<bool,MobilizedBodyIndex> >
+                (Array_<bool,MobilizedBodyIndex>(numBodies, false)));
     wThis->m_mobodContactSurfaceIndex.resize(numBodies);
     wThis->m_surfaces.clear();
     wThis->m_bubbles.clear();
@@ -277,6 +299,7 @@ int realizeSubsystemVelocityImpl(const State& state) const override {
 // Adds new pairs to the existing set, if not already present.
 void addInBroadPhasePairs(const State& state, PairMap& pairs) const {
     const int numBubbles = getNumBubbles();
+    const Array_<bool,MobilizedBodyIndex>& asleep = getAsleep(state);
     
     // Perform a sweep-and-prune on a single axis to identify potential 
     // contacts. First, find which axis has the most variation in body 
@@ -340,6 +363,9 @@ void addInBroadPhasePairs(const State& state, PairMap& pairs) const {
             // Ignore if on the same body.
             if (surf1.mobod == surf2.mobod) continue;
             assert(bubb1.surface != bubb2.surface); // duh!
+            // Ignore if neither one can move.
+            if (   isSurfaceAtRest(asleep, bubb1.surface) 
+                && isSurfaceAtRest(asleep, bubb2.surface)) continue;
             // Ignore if surfaces are in a common clique.
             if (surf1.surface->isInSameClique(*surf2.surface)) continue;
             // We'll need to do a narrow phase investigation of these two
@@ -380,6 +406,7 @@ void ensureActiveContactsUpdated(const State& state) const {
     const ContactSnapshot& active     = getPrevActiveContacts(state);
     const ContactSnapshot& predicted  = getPrevPredictedContacts(state);
     ContactSnapshot&       nextActive = updNextActiveContacts(state);
+    const Array_<bool,MobilizedBodyIndex>& asleep = getAsleep(state);
 
     // TODO: Can we reuse heap space in this cache entry?
     nextActive.clear();
@@ -417,10 +444,22 @@ void ensureActiveContactsUpdated(const State& state) const {
         const ContactGeometry& geom1 = m_surfaces[index1].surface->getShape();
         const ContactGeometryTypeId typeId1 = geom1.getTypeId();
 
+        const bool atRest1 = isSurfaceAtRest(asleep, index1);
+
         const ContactSurfaceSet& others = p->second;
         ContactSurfaceSet::const_iterator q = others.begin();
         for (; q != others.end(); ++q) {
             const ContactSurfaceIndex index2 = q->first;
+
+            // Neither surface has moved so the previous Contact, if any, is
+            // still correct.
+            if (atRest1 && isSurfaceAtRest(asleep, index2)) {
+                if (q->second && q->second->getCondition() != Contact::Broken)
+                {   Contact same(*q->second); // shallow copy
+                    nextActive.adoptContact(same); }
+                continue;
+            }
+
             const Transform transform2 = 
                 m_surfaces[index2].mobod->getBodyTransform(state)
                     * m_surfaces[index2].X_BS;
@@ -591,6 +630,7 @@ Array_<Surface,ContactSurfaceIndex>     m_surfaces;
 Array_<Bubble,BubbleIndex>              m_bubbles;
 DiscreteVariableIndex                   m_activeContactsIx;
 DiscreteVariableIndex                   m_predictedContactsIx;
+DiscreteVariableIndex                   m_asleepIx;
 };
 
 } // namespace SimTK
@@ -669,6 +709,19 @@ getContactTracker(ContactGeometryTypeId surface1,
                   bool& reverseOrder) const
 {   return getImpl().getContactTracker(surface1,surface2,reverseOrder); }
 
+void ContactTrackerSubsystem::
+setBodyAsleep(State& state, MobilizedBodyIndex mobod, bool asleep) const {
+    SimTK_APIARGCHECK_ALWAYS(mobod != 0, "ContactTrackerSubsystem", 
+        "setBodyAsleep", "Ground can't be marked as asleep.");
+    const ContactTrackerSubsystemImpl& impl = getImpl();
+    if (impl.getAsleep(state)[mobod] != asleep)
+        impl.updAsleep(state)[mobod] = asleep;
+}
+
+bool ContactTrackerSubsystem::
+isBodyAsleep(const State& state, MobilizedBodyIndex mobod) const
+{   return getImpl().getAsleep(state)[mobod]; }
+
 const ContactSnapshot& ContactTrackerSubsystem::
 getPreviousActiveContacts(const State& state) const
 {   return getImpl().getPrevActiveContacts(state); }
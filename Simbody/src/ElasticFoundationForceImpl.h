@@ -49,7 +49,7 @@ public:
     void processContact(const State& state, ContactSurfaceIndex meshIndex, 
                         ContactSurfaceIndex otherBodyIndex, 
                         const Parameters& param, 
-                        const std::set<int>& insideFaces,
+                        const Array_<int>& insideFaces,
                         Real areaScale,
                         Vector_<SpatialVec>& bodyForces, Real& pe) const;
 private:
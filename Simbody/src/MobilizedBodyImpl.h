@@ -1199,6 +1199,7 @@ public:
         for (int i = 0; i < (int)functions.size(); ++i) {
             assert(functions[i]->getArgumentSize() == coordIndices[i].size());
             assert(functions[i]->getMaxDerivativeOrder() >= 2);
+            checkNumArguments(coordIndices[i]);
         }
         Arot = Mat33(1);
         Atrans = Mat33(1);
@@ -1212,6 +1213,7 @@ public:
         for (int i = 0; i < (int)functions.size(); ++i) {
             assert(functions[i]->getArgumentSize() == coordIndices[i].size());
             assert(functions[i]->getMaxDerivativeOrder() >= 2);
+            checkNumArguments(coordIndices[i]);
         }
         double tol = 1e-5;
         // Verify that none of the rotation axes are colinear
@@ -1249,13 +1251,13 @@ public:
         for(int i=0; i < 6; i++){
             //Coordinates for this function
             int nc = coordIndices[i].size();
-            Vector fcoords(nc);
+            Vec6 fcoords;
     
             for(int j=0; j < nc; j++)
-                fcoords(j) = q[coordIndices[i][j]];            
+                fcoords[j] = q[coordIndices[i][j]];            
             
-            //default behavior of constant function should take a Vector of length 0
-            spatialCoords(i) = functions[i]->calcValue(fcoords);
+            //default behavior of constant function should take 0 arguments
+            spatialCoords(i) = functions[i]->calcValueAt(nc, &fcoords[0]);
         }
 
 /*
@@ -1702,6 +1704,16 @@ public:
     }
 
 private:
+    // Function arguments are gathered into a Vec6 so that evaluating the
+    // functions doesn't require heap allocation; a mobilizer has at most six
+    // q's so there is no reason for a function to take more arguments.
+    static void checkNumArguments(const Array_<int>& coords) {
+        SimTK_ERRCHK1_ALWAYS(coords.size() <= 6, 
+            "MobilizedBody::FunctionBased", 
+            "A spatial function can depend on at most 6 coordinates but"
+            " this one was given %d.", (int)coords.size());
+    }
+
     const SubsystemIndex subsystem;
     const int nu;
     mutable CacheEntryIndex cacheIndex;
@@ -1720,26 +1732,22 @@ private:
             // Cycle through each row (function describing spatial coordinate)
             Fq = Mat<6,N>(0);
             Vec6 spatialCoords(0);
-            Array_<int> deriv(1);
-            Vector fcoords(coordIndices[0].size()); 
+            Vec6 fcoords, dfdc;
 
             for(int i=0; i < 6; i++){
                 // Determine the number of coordinates for this function
                 int nc = coordIndices[i].size();
-                if (fcoords.size() != nc)
-                    fcoords.resize(nc);
 
                 if (nc > 0) {
                     // Get coordinate values to evaluate the function
                     for(int k = 0; k < nc; k++)
-                        fcoords(k) = q(coordIndices[i][k]);
+                        fcoords[k] = q(coordIndices[i][k]);
 
-                    for (int j = 0; j < nc; j++) {
-                        deriv[0] = j;
-                        Fq(i, coordIndices[i][j]) = functions[i]->calcDerivative(deriv, fcoords);
-                    }
-                    //default behavior of constant function should take a Vector of length 0
-                    spatialCoords(i) = functions[i]->calcValue(fcoords);
+                    // Value and all first derivatives in one call.
+                    spatialCoords(i) = functions[i]->calcValueAndGradientAt
+                                                (nc, &fcoords[0], &dfdc[0]);
+                    for (int j = 0; j < nc; j++)
+                        Fq(i, coordIndices[i][j]) = dfdc[j];
                 }
 
             }
@@ -1769,19 +1777,17 @@ private:
         {
             Mat<6,N> Fqdot(0);
             Vec6 spatialCoords;
-            Array_<int> derivs(2);
-            Vector fcoords(coordIndices[0].size()); 
+            Vec6 fcoords;
+            int derivs[2];
 
             for(int i=0; i < 6; i++){
                 // Determine the number of coordinates for this function
                 int nc = coordIndices[i].size();
-                if (fcoords.size() != nc)
-                    fcoords.resize(nc);
                 
                 if (nc > 0) {
                     // Get coordinate values to evaluate the function
                     for(int k = 0; k < nc; k++)
-                        fcoords(k) = q(coordIndices[i][k]);
+                        fcoords[k] = q(coordIndices[i][k]);
 
                     // function is dependent on a mobility if its index is in the list of function coordIndices
                     // cycle through the mobilities
@@ -1789,12 +1795,12 @@ private:
                         derivs[0] = j;
                         for (int k = 0; k < nc; k++) {
                             derivs[1] = k;
-                            Fqdot(i, coordIndices[i][j]) += functions[i]->calcDerivative(derivs, fcoords)*u[coordIndices[i][k]];
+                            Fqdot(i, coordIndices[i][j]) += functions[i]->calcDerivativeAt(2, derivs, nc, &fcoords[0])*u[coordIndices[i][k]];
                         }
                     }
                 }
-                //default behavior of constant function should take a Vector of length 0
-                spatialCoords(i) = functions[i]->calcValue(fcoords);
+                //default behavior of constant function should take 0 arguments
+                spatialCoords(i) = functions[i]->calcValueAt(nc, &fcoords[0]);
             }
 
             Rotation R_F1 = Rotation(spatialCoords(0), UnitVec3::getAs(&Arot(0,0)));
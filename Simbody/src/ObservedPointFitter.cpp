@@ -28,6 +28,7 @@
 #include "simbody/internal/MultibodySystem.h"
 #include "simbody/internal/ObservedPointFitter.h"
 #include "simbody/internal/SimbodyMatterSubsystem.h"
+#include <algorithm>
 #include <map>
 
 using namespace SimTK;
@@ -41,7 +42,9 @@ static const Real MinimumShift = 1; // add to objective to get minimum away from
 
 class ObservedPointFitter::OptimizerFunction : public OptimizerSystem {
 public:
-    OptimizerFunction(const MultibodySystem& system, const State& state, Array_<MobilizedBodyIndex> bodyIxs, Array_<Array_<Vec3> > stations, Array_<Array_<Vec3> > targetLocations, Array_<Array_<Real> > weights) :
+    OptimizerFunction(const MultibodySystem& system, const State& state, const Array_<MobilizedBodyIndex>& bodyIxs,
+                      const Array_<Array_<Vec3> >& stations, const Array_<Array_<Vec3> >& targetLocations,
+                      const Array_<Array_<Real> >& weights) :
         OptimizerSystem(state.getNQ()), system(system), state(state), bodyIxs(bodyIxs), stations(stations), targetLocations(targetLocations), weights(weights) {
         system.realize(state, Stage::Instance);
         setNumEqualityConstraints(state.getNQErr());
@@ -110,13 +113,284 @@ public:
     }
 private:
     const MultibodySystem& system;
-    const Array_<MobilizedBodyIndex> bodyIxs;
-    const Array_<Array_<Vec3> > stations;
-    const Array_<Array_<Vec3> > targetLocations;
-    const Array_<Array_<Real> > weights;
+    // These belong to the caller, and must outlive this object.
+    const Array_<MobilizedBodyIndex>& bodyIxs;
+    const Array_<Array_<Vec3> >& stations;
+    const Array_<Array_<Vec3> >& targetLocations;
+    const Array_<Array_<Real> >& weights;
     mutable State state;
 };
 
+// Levenberg-Marquardt parameters used by refineFit().
+static const int MaxFitIterations = 100;
+static const Real InitialDamping = Real(1e-3), MinDamping = Real(1e-9), MaxDamping = Real(1e10);
+
+/**
+ * This class solves the weighted least squares station fitting problem with Levenberg-Marquardt iterations,
+ * starting from the configuration in the given State. The stations, weights, and all the work space are set
+ * up once so that a sequence of frames can be fit without any further heap allocation.
+ */
+
+class ObservedPointFitter::LeastSquaresFitter {
+public:
+    LeastSquaresFitter(const MultibodySystem& system, const Array_<MobilizedBodyIndex>& bodyIxs,
+                       const Array_<Array_<Vec3> >& stations, const Array_<Array_<Real> >& weights) :
+        system(system), matter(system.getMatterSubsystem()), totalWeight(0) {
+        // Only stations with nonzero weight take part. Stations on the same body share that body's
+        // Jacobian, so we keep a list of the distinct bodies.
+        Array_<int> slotOfBody(matter.getNumBodies(), -1);
+        for (int i = 0; i < (int)bodyIxs.size(); ++i) {
+            for (int j = 0; j < (int)stations[i].size(); ++j) {
+                totalWeight += weights[i][j];
+                if (weights[i][j] == 0)
+                    continue;
+                if (slotOfBody[bodyIxs[i]] == -1) {
+                    slotOfBody[bodyIxs[i]] = (int)taskBodies.size();
+                    taskBodies.push_back(bodyIxs[i]);
+                }
+                taskSlot.push_back(slotOfBody[bodyIxs[i]]);
+                taskStation.push_back(stations[i][j]);
+                taskSqrtWeight.push_back(std::sqrt(weights[i][j]));
+                taskGroup.push_back(i);
+                taskMember.push_back(j);
+            }
+        }
+        taskTarget.resize(taskStation.size());
+    }
+
+    // Improve the q's in state, and return the weighted RMS error.
+    Real fit(State& state, const Array_<Array_<Vec3> >& targetLocations, Real tolerance) {
+        const int nt = (int)taskStation.size(), nq = state.getNQ(), nu = state.getNU();
+        for (int k = 0; k < nt; ++k)
+            taskTarget[k] = targetLocations[taskGroup[k]][taskMember[k]];
+        resize(nt, nq, nu);
+
+        system.realize(state, Stage::Position);
+        Real cost = calcResidual(state, residual);
+        if (nt == 0 || nu == 0)
+            return calcRMS(cost);
+
+        const Real minStepSqr = square(tolerance/100)*totalWeight;
+        Real lambda = InitialDamping;
+        for (int iter = 0; iter < MaxFitIterations; ++iter) {
+            // Form the Gauss-Newton normal equations A du = g with A = ~J*J and g = ~J*r; J and r already
+            // include the square roots of the weights.
+            calcJacobian(state);
+            multiplyAdd(1, ~jacobian, jacobian, 0, normal);
+            multiplyAdd(1, ~jacobian, residual, 0, gradient);
+            Real maxDiag = 0;
+            for (int i = 0; i < nu; ++i)
+                maxDiag = std::max(maxDiag, normal(i,i));
+            if (maxDiag == 0)
+                break; // the stations don't depend on q
+
+            // Try steps, increasing the damping until one reduces the error. A rejected step needs only a
+            // new factorization; the normal equations are reused.
+            savedQ = state.getQ();
+            bool improved = false;
+            while (lambda < MaxDamping) {
+                factor = normal;
+                for (int i = 0; i < nu; ++i)
+                    factor(i,i) += lambda*std::max(normal(i,i), Real(1e-8)*maxDiag);
+                if (!choleskyFactor(factor)) {
+                    lambda *= 10;
+                    continue;
+                }
+                step = gradient;
+                choleskySolve(factor, step);
+                matter.multiplyByN(state, false, step, stepQ);
+                state.updQ() += stepQ;
+                matter.normalizeQuaternions(state);
+                system.realize(state, Stage::Position);
+                const Real trialCost = calcResidual(state, trialResidual);
+                if (trialCost < cost) {
+                    cost = trialCost;
+                    residual = trialResidual;
+                    lambda = std::max(lambda/10, MinDamping);
+                    improved = true;
+                    break;
+                }
+                // multiplyByN() above needs the restored q's realized.
+                state.updQ() = savedQ;
+                system.realize(state, Stage::Position);
+                lambda *= 10;
+            }
+            if (!improved)
+                break; // no step helps; we're at a minimum
+            // Stop when the step moved the stations a negligible amount.
+            multiplyAdd(1, jacobian, step, 0, trialResidual);
+            if (trialResidual.normSqr() <= minStepSqr)
+                break;
+        }
+        return calcRMS(cost);
+    }
+
+private:
+    void resize(int nt, int nq, int nu) {
+        if (residual.size() != 3*nt) {
+            residual.resize(3*nt);
+            trialResidual.resize(3*nt);
+        }
+        if (jacobian.nrow() != 3*nt || jacobian.ncol() != nu)
+            jacobian.resize(3*nt, nu);
+        if (bodyJacobian.nrow() != 6*(int)taskBodies.size() || bodyJacobian.ncol() != nu)
+            bodyJacobian.resize(6*(int)taskBodies.size(), nu);
+        if (normal.nrow() != nu) {
+            normal.resize(nu, nu);
+            factor.resize(nu, nu);
+            gradient.resize(nu);
+            step.resize(nu);
+        }
+        if (stepQ.size() != nq)
+            stepQ.resize(nq);
+        if (bodyForces.size() != matter.getNumBodies()) {
+            bodyForces.resize(matter.getNumBodies());
+            bodyForces.setToZero();
+        }
+        column.resize(nu);
+    }
+
+    // Calculate r = sqrt(w)*(target - station location) for every station and return the weighted sum of
+    // squared errors.
+    Real calcResidual(const State& state, Vector& r) const {
+        Real cost = 0;
+        for (int k = 0; k < (int)taskStation.size(); ++k) {
+            const MobilizedBody& body = matter.getMobilizedBody(taskBodies[taskSlot[k]]);
+            const Vec3 error = taskSqrtWeight[k]*(taskTarget[k] - body.getBodyTransform(state)*taskStation[k]);
+            r[3*k] = error[0]; r[3*k+1] = error[1]; r[3*k+2] = error[2];
+            cost += error.normSqr();
+        }
+        return cost;
+    }
+
+    Real calcRMS(Real cost) const {
+        return totalWeight > 0 ? std::sqrt(cost/totalWeight) : 0;
+    }
+
+    // Form the weighted 3nt X nu station Jacobian. Each body's 6 X nu spatial Jacobian is found with 6
+    // passes of ~J*F, then each station on it gets v_S = v_B + w_B x p_S.
+    void calcJacobian(const State& state) {
+        const int nu = state.getNU();
+        for (int b = 0; b < (int)taskBodies.size(); ++b) {
+            SpatialVec& F = bodyForces[taskBodies[b]];
+            for (int i = 0; i < 6; ++i) {
+                F[i/3][i%3] = 1;
+                matter.multiplyBySystemJacobianTranspose(state, bodyForces, column);
+                F[i/3][i%3] = 0;
+                for (int c = 0; c < nu; ++c)
+                    bodyJacobian(6*b+i, c) = column[c];
+            }
+        }
+        for (int k = 0; k < (int)taskStation.size(); ++k) {
+            const int b = taskSlot[k];
+            const Vec3 p_G = matter.getMobilizedBody(taskBodies[b]).expressVectorInGroundFrame(state, taskStation[k]);
+            for (int c = 0; c < nu; ++c) {
+                const Vec3 w(bodyJacobian(6*b,c), bodyJacobian(6*b+1,c), bodyJacobian(6*b+2,c));
+                const Vec3 v(bodyJacobian(6*b+3,c), bodyJacobian(6*b+4,c), bodyJacobian(6*b+5,c));
+                const Vec3 vS = taskSqrtWeight[k]*(v + w % p_G);
+                jacobian(3*k,c) = vS[0]; jacobian(3*k+1,c) = vS[1]; jacobian(3*k+2,c) = vS[2];
+            }
+        }
+    }
+
+    // Replace the lower triangle of the symmetric matrix a with its Cholesky factor L (a = L*~L). Returns
+    // false if a is not positive definite.
+    static bool choleskyFactor(Matrix& a) {
+        const int n = a.nrow();
+        for (int j = 0; j < n; ++j) {
+            Real d = a(j,j);
+            for (int k = 0; k < j; ++k)
+                d -= square(a(j,k));
+            if (!(d > 0))
+                return false;
+            d = std::sqrt(d);
+            a(j,j) = d;
+            for (int i = j+1; i < n; ++i) {
+                Real sum = a(i,j);
+                for (int k = 0; k < j; ++k)
+                    sum -= a(i,k)*a(j,k);
+                a(i,j) = sum/d;
+            }
+        }
+        return true;
+    }
+
+    // Solve L*~L*x = b in place, given L from choleskyFactor().
+    static void choleskySolve(const Matrix& L, Vector& x) {
+        const int n = L.nrow();
+        for (int i = 0; i < n; ++i) {
+            for (int k = 0; k < i; ++k)
+                x[i] -= L(i,k)*x[k];
+            x[i] /= L(i,i);
+        }
+        for (int i = n-1; i >= 0; --i) {
+            for (int k = i+1; k < n; ++k)
+                x[i] -= L(k,i)*x[k];
+            x[i] /= L(i,i);
+        }
+    }
+
+    const MultibodySystem& system;
+    const SimbodyMatterSubsystem& matter;
+    Real totalWeight;
+    Array_<MobilizedBodyIndex> taskBodies;  // distinct bodies with stations
+    Array_<int> taskSlot;                   // for each station, its body in taskBodies
+    Array_<Vec3> taskStation;
+    Array_<Real> taskSqrtWeight;
+    Array_<int> taskGroup, taskMember;      // where each station's target is in targetLocations
+    Array_<Vec3> taskTarget;
+    // Work space.
+    Vector residual, trialResidual, gradient, step, stepQ, savedQ, column;
+    Matrix jacobian, bodyJacobian, normal, factor;
+    Vector_<SpatialVec> bodyForces;
+};
+
+/**
+ * This is the ParallelExecutor task for fitting the frames after the first one in each segment of a trajectory.
+ * The first frames are fit beforehand with findBestFit(), which can't be called concurrently since the optimizer it
+ * uses is not thread safe.
+ */
+
+class ObservedPointFitter::TrajectorySegmentTask : public ParallelExecutor::Task {
+public:
+    TrajectorySegmentTask(const MultibodySystem& system, const Array_<MobilizedBodyIndex>& bodyIxs,
+                          const Array_<Array_<Vec3> >& stations, const Array_<Array_<Array_<Vec3> > >& targetTrajectory,
+                          const Array_<Array_<Real> >& weights, Array_<State>& states, Array_<Real>& errors,
+                          Real tolerance, int numSegments) :
+        system(system), bodyIxs(bodyIxs), stations(stations), targetTrajectory(targetTrajectory),
+        weights(weights), states(states), errors(errors), tolerance(tolerance), numSegments(numSegments) {
+    }
+
+    // Return the first frame of a segment; the segment ends where the next one starts.
+    static int getFirstFrame(int numFrames, int segment, int numSegments) {
+        return (int)((long long)numFrames*segment/numSegments);
+    }
+
+    void execute(int segment) override {
+        const int numFrames = (int)targetTrajectory.size();
+        const int first = getFirstFrame(numFrames, segment, numSegments);
+        const int last = getFirstFrame(numFrames, segment+1, numSegments);
+        if (last - first < 2)
+            return;
+        LeastSquaresFitter fitter(system, bodyIxs, stations, weights);
+        for (int frame = first+1; frame < last; ++frame) {
+            states[frame] = states[frame-1];
+            errors[frame] = fitter.fit(states[frame], targetTrajectory[frame], tolerance);
+        }
+    }
+
+private:
+    const MultibodySystem& system;
+    const Array_<MobilizedBodyIndex>& bodyIxs;
+    const Array_<Array_<Vec3> >& stations;
+    const Array_<Array_<Array_<Vec3> > >& targetTrajectory;
+    const Array_<Array_<Real> >& weights;
+    Array_<State>& states;
+    Array_<Real>& errors;
+    const Real tolerance;
+    const int numSegments;
+};
+
 /**
  * Create a new MultibodySystem which is identical to a subset of the original MultibodySystem.  This is called once for each MobilizedBody
  * in the original system, and is used to find an initial estimate of that MobilizedBody's conformation.
@@ -375,3 +649,59 @@ Real ObservedPointFitter::findBestFit
 
     return std::sqrt((error-MinimumShift)/totalWeight);
 }
+
+Real ObservedPointFitter::refineFit
+   (const MultibodySystem& system, State& state, 
+    const Array_<MobilizedBodyIndex>&  bodyIxs, 
+    const Array_<Array_<Vec3> >&       stations, 
+    const Array_<Array_<Vec3> >&       targetLocations, 
+    const Array_<Array_<Real> >&       weights, 
+    Real tolerance) 
+{
+    const SimbodyMatterSubsystem& matter = system.getMatterSubsystem();
+    SimTK_APIARGCHECK(bodyIxs.size() == stations.size() && stations.size() == targetLocations.size() && stations.size() == weights.size(), "ObservedPointFitter", "refineFit", "bodyIxs, stations, targetLocations, and weights must all be the same length");
+    for (int i = 0; i < (int)stations.size(); ++i) {
+        SimTK_APIARGCHECK(bodyIxs[i] >= 0 && bodyIxs[i] < matter.getNumBodies(), "ObservedPointFitter", "refineFit", "Illegal body ID");
+        SimTK_APIARGCHECK(stations[i].size() == targetLocations[i].size() && stations[i].size() == weights[i].size(), "ObservedPointFitter", "refineFit", "Different number of stations, target locations, and weights for body");
+    }
+    LeastSquaresFitter fitter(system, bodyIxs, stations, weights);
+    return fitter.fit(state, targetLocations, tolerance);
+}
+
+void ObservedPointFitter::findBestFitTrajectory
+   (const MultibodySystem& system, const State& initialState, 
+    const Array_<MobilizedBodyIndex>&       bodyIxs, 
+    const Array_<Array_<Vec3> >&            stations, 
+    const Array_<Array_<Array_<Vec3> > >&   targetTrajectory, 
+    const Array_<Array_<Real> >&            weights, 
+    Array_<State>&                          states, 
+    Array_<Real>&                           errors, 
+    Real tolerance, int numThreads) 
+{
+    SimTK_APIARGCHECK1(numThreads > 0, "ObservedPointFitter", "findBestFitTrajectory", "Number of threads must be positive but was %d.", numThreads);
+    SimTK_APIARGCHECK(bodyIxs.size() == stations.size() && stations.size() == weights.size(), "ObservedPointFitter", "findBestFitTrajectory", "bodyIxs, stations, and weights must all be the same length");
+    for (int k = 0; k < (int)targetTrajectory.size(); ++k) {
+        SimTK_APIARGCHECK(targetTrajectory[k].size() == stations.size(), "ObservedPointFitter", "findBestFitTrajectory", "Every frame must have target locations for every body in bodyIxs");
+        for (int i = 0; i < (int)stations.size(); ++i)
+            SimTK_APIARGCHECK(targetTrajectory[k][i].size() == stations[i].size(), "ObservedPointFitter", "findBestFitTrajectory", "Different number of stations and target locations for body");
+    }
+
+    const int numFrames = (int)targetTrajectory.size();
+    states.resize(numFrames);
+    errors.resize(numFrames);
+    const int numSegments = std::max(1, std::min(numThreads, numFrames));
+    for (int segment = 0; segment < numSegments; ++segment) {
+        const int first = TrajectorySegmentTask::getFirstFrame(numFrames, segment, numSegments);
+        if (first == numFrames)
+            continue;
+        states[first] = initialState;
+        errors[first] = findBestFit(system, states[first], bodyIxs, stations, targetTrajectory[first], weights, tolerance);
+    }
+    TrajectorySegmentTask task(system, bodyIxs, stations, targetTrajectory, weights, states, errors, tolerance, numSegments);
+    if (numSegments == 1)
+        task.execute(0);
+    else {
+        ParallelExecutor executor(numSegments);
+        executor.executeAndRethrow(task, numSegments);
+    }
+}
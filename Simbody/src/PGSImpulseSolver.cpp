@@ -212,6 +212,140 @@ boundFriction(Real mu,
     for (unsigned i=0; i<IF.size(); ++i) pi[IF[i]] *= scale;
     return ImpulseSolver::Sliding;
 }
+
+// Contacts with fewer than this many members in one color are updated 
+// serially since there isn't enough work to be worth waking up the threads.
+const int MinParallelColorSize = 16;
+
+// Return in mults the multipliers of a unilateral contact that participate
+// in the solve: the normal unless it is Known, and the friction components
+// unless the contact is just Observing.
+void getParticipatingMults(const ImpulseSolver::UniContactRT& rt,
+                           Array_<MultiplierIndex>&           mults)
+{
+    mults.clear();
+    if (rt.m_type == ImpulseSolver::Observing)
+        return;
+    if (rt.m_type == ImpulseSolver::Participating)
+        mults.push_back(rt.m_Nk);
+    for (unsigned i=0; i < rt.m_Fk.size(); ++i)
+        mults.push_back(rt.m_Fk[i]);
+}
+
+// Same as doRowSum() except that we skip the columns that belong to contacts
+// of the given color other than contact "self". Those columns have no 
+// coupling with this row but their pi entries may be getting updated by 
+// another thread.
+Real doRowSumExcluding(const Array_<MultiplierIndex>& columns,
+                       const MultiplierIndex&         row,
+                       const Matrix&                  A,
+                       const Vector&                  D,
+                       const Vector&                  pi,
+                       const Array_<int>&             multContact,
+                       const Array_<int>&             contactColor,
+                       int                            self,
+                       int                            color)
+{
+    assert(pi.hasContiguousData());
+    const Real* pip = &pi[0];
+    const int m = A.nrow();
+
+    assert(A.hasContiguousData()); // packed
+    assert(A(0).hasContiguousData()); // in column order
+    const Real* Ap = &A(0,0);
+
+    Real rowSum = 0;
+    for (unsigned c=0; c < columns.size(); ++c) {
+        const MultiplierIndex cx = columns[c];
+        const int owner = multContact[cx];
+        if (owner >= 0 && owner != self && contactColor[owner] == color)
+            continue;
+        const Real* cp = Ap + cx*m; // point to start of column
+        rowSum += cp[row]*pip[cx];
+    }
+    if (D.size()) {
+        assert(D.hasContiguousData());
+        const Real* Dp = &D[0];
+        rowSum += Dp[row]*pip[row];
+    }
+    return rowSum;
+}
+
+// This is the ParallelExecutor task for updating all the unilateral contacts
+// of one color. Each contact is updated as in the serial sweep, normal first
+// and then friction, except that the friction rows are updated one at a time.
+// The squared errors are saved per contact so that they can be summed in a
+// fixed order afterwards, making the result independent of the number of
+// threads.
+class ColoredSweepTask : public ParallelExecutor::Task {
+public:
+    ColoredSweepTask(const Array_<int>&                   contacts,
+                     int                                  color,
+                     const Array_<MultiplierIndex>&       participating,
+                     const Matrix&                        A,
+                     const Vector&                        D,
+                     const Vector&                        rhs,
+                     const Vector&                        piExpand,
+                     Real                                 sor,
+                     const Array_<int>&                   multContact,
+                     const Array_<int>&                   contactColor,
+                     Array_<ImpulseSolver::UniContactRT>& uniContact,
+                     Vector&                              pi,
+                     Array_<Real>&                        er2all,
+                     Array_<Real>&                        er2enf)
+    :   contacts(contacts), color(color), participating(participating), 
+        A(A), D(D), rhs(rhs), piExpand(piExpand), sor(sor), 
+        multContact(multContact), contactColor(contactColor),
+        uniContact(uniContact), pi(pi), er2all(er2all), er2enf(er2enf) {}
+
+    void execute(int i) override {
+        const int k = contacts[i];
+        ImpulseSolver::UniContactRT& rt = uniContact[k];
+        const MultiplierIndex Nk = rt.m_Nk;
+        Real sum2all = 0, sum2enf = 0;
+        if (rt.m_type == ImpulseSolver::Participating) {
+            const Real rowSum = doRowSumExcluding(participating, Nk, A, D, pi,
+                                    multContact, contactColor, k, color);
+            const Real er2 = doUpdate(Nk, A, D, rhs, sor, rowSum, pi);
+            sum2all += er2;
+            rt.m_contactCond = boundUnilateral(rt.m_sign, pi[Nk]);
+            if (rt.m_contactCond == ImpulseSolver::UniActive)
+                sum2enf += er2;
+        }
+        if (rt.m_type != ImpulseSolver::Observing && rt.hasFriction()) {
+            const Array_<MultiplierIndex>& Fk = rt.m_Fk;
+            Real er2 = 0;
+            for (unsigned j=0; j < Fk.size(); ++j) {
+                const Real rowSum = doRowSumExcluding(participating, Fk[j], 
+                                    A, D, pi, multContact, contactColor, 
+                                    k, color);
+                er2 += doUpdate(Fk[j], A, D, rhs, sor, rowSum, pi);
+            }
+            sum2all += er2;
+            const Real N = std::abs(pi[Nk] + piExpand[Nk]);
+            rt.m_frictionCond = boundVector(rt.m_effMu*N, Fk, pi);
+            if (rt.m_frictionCond == ImpulseSolver::Rolling)
+                sum2enf += er2;
+        }
+        er2all[k] = sum2all;
+        er2enf[k] = sum2enf;
+    }
+private:
+    const Array_<int>&                      contacts;
+    const int                               color;
+    const Array_<MultiplierIndex>&          participating;
+    const Matrix&                           A;
+    const Vector&                           D;
+    const Vector&                           rhs;
+    const Vector&                           piExpand;
+    const Real                              sor;
+    const Array_<int>&                      multContact;
+    const Array_<int>&                      contactColor;
+    Array_<ImpulseSolver::UniContactRT>&    uniContact;
+    Vector&                                 pi;
+    Array_<Real>&                           er2all;
+    Array_<Real>&                           er2enf;
+};
 }
 
 namespace SimTK {
@@ -304,6 +438,7 @@ solve(int                                 phase,
     SimTK_DEBUG("\n-----------------\n");
     SimTK_DEBUG(  "START PGS SOLVER:\n");
     ++m_nSolves[phase];
+    const double startTime = realTime();
 
 #ifndef NDEBUG
    {FactorQTZ fac(A);
@@ -384,10 +519,19 @@ solve(int                                 phase,
 
     if (p == 0) {
         SimTK_DEBUG1("PGS %d: nothing to do; converged in 0 iters.\n", phase);
+        if (m_useWarmStart) saveWarmStart(phase, uniContact, pi);
+        m_solveTime[phase] += realTime() - startTime;
         // Returning pi=0; can still have piExpand!=0 so verr is updated.
         return true;
     }
 
+    // Start from the previous solution for contacts we've seen before.
+    if (m_useWarmStart) applyWarmStart(phase, uniContact, pi);
+
+    // With multiple threads, contacts are updated concurrently by color.
+    const bool colored = m_numThreads > 1 && mUniCont > 0;
+    if (colored) colorContacts(participating, A, uniContact);
+
     // Track total error for all included equations, and the error for just
     // those equations that are being enforced.
     bool converged = false;
@@ -408,8 +552,15 @@ solve(int                                 phase,
             sum2all += er2; sum2enf += er2;
         }
 
+        // UNILATERAL CONTACTS, by color. Each contact's normal is done 
+        // before its friction.
+        if (colored) {
+            sweepColoredContacts(participating,A,D,verrStart,piExpand,sor,
+                                 uniContact,pi,sum2all,sum2enf);
+        }
+
         // UNILATERAL CONTACT NORMALS. Do all of these before any friction.
-        for (int k=0; k < mUniCont; ++k) {
+        for (int k=0; k < mUniCont && !colored; ++k) {
             UniContactRT& rt = uniContact[k];
             if (rt.m_type != Participating)
                 continue;
@@ -424,7 +575,7 @@ solve(int                                 phase,
 
         // UNILATERAL CONTACT FRICTION. These are limited by the normal
         // multiplier or by a known normal force during Poisson expansion.
-        for (int k=0; k < mUniCont; ++k) {
+        for (int k=0; k < mUniCont && !colored; ++k) {
             UniContactRT& rt = uniContact[k];
             if (rt.m_type == Observing || !rt.hasFriction())
                 continue;
@@ -519,12 +670,15 @@ solve(int                                 phase,
         ++m_nFail[phase];
     }
 
+    if (m_useWarmStart) saveWarmStart(phase, uniContact, pi);
+
     verrStart -= A*pi;
     verrStart -= D.elementwiseMultiply(pi);
     #ifndef NDEBUG
     cout << "FINAL@" << its << " pi=" << pi << " verr=" << verrStart
          <<  " resid=" << normRMSenf << endl;
     #endif
+    m_solveTime[phase] += realTime() - startTime;
     return converged;
 }
 
@@ -631,4 +785,179 @@ solveBilateral
 }
 
 
-} // namespace SimTK
\ No newline at end of file
+
+//------------------------------------------------------------------------------
+//                        APPLY / SAVE WARM START
+//------------------------------------------------------------------------------
+void PGSImpulseSolver::
+applyWarmStart(int phase, const Array_<UniContactRT>& uniContact,
+               Vector& pi) const
+{
+    std::lock_guard<std::mutex> lock(m_warmStart->mutex);
+    const Array_<Vec3>& saved = m_warmStart->impulses[phase];
+    for (unsigned k=0; k < uniContact.size(); ++k) {
+        const UniContactRT& rt = uniContact[k];
+        if (   rt.m_type == Observing || !rt.m_ucx.isValid()
+            || (int)rt.m_ucx >= (int)saved.size())
+            continue;
+        const Vec3& impulse = saved[rt.m_ucx];
+        if (rt.m_type == Participating && !isNaN(impulse[2]))
+            pi[rt.m_Nk] = impulse[2];
+        if (rt.hasFriction() && rt.m_Fk.size() <= 2)
+            for (unsigned i=0; i < rt.m_Fk.size(); ++i)
+                if (!isNaN(impulse[i]))
+                    pi[rt.m_Fk[i]] = impulse[i];
+    }
+}
+
+// Only the given contacts are updated; others may belong to a different
+// piece of the problem that is being solved by a clone. Those that are no
+// longer proximal are cleared by retainWarmStart() at the next step.
+void PGSImpulseSolver::
+saveWarmStart(int phase, const Array_<UniContactRT>& uniContact,
+              const Vector& pi) const
+{
+    std::lock_guard<std::mutex> lock(m_warmStart->mutex);
+    Array_<Vec3>& saved = m_warmStart->impulses[phase];
+    for (unsigned k=0; k < uniContact.size(); ++k) {
+        const UniContactRT& rt = uniContact[k];
+        if (!rt.m_ucx.isValid())
+            continue;
+        if ((int)rt.m_ucx >= (int)saved.size())
+            saved.resize(rt.m_ucx+1, Vec3(NaN));
+        Vec3& impulse = saved[rt.m_ucx];
+        impulse = Vec3(NaN);
+        if (rt.m_type == Observing)
+            continue;
+        if (rt.m_type == Participating)
+            impulse[2] = pi[rt.m_Nk];
+        if (rt.hasFriction() && rt.m_Fk.size() <= 2)
+            for (unsigned i=0; i < rt.m_Fk.size(); ++i)
+                impulse[i] = pi[rt.m_Fk[i]];
+    }
+}
+
+
+void PGSImpulseSolver::
+retainWarmStart(const Array_<UnilateralContactIndex>& uniContacts) const {
+    std::lock_guard<std::mutex> lock(m_warmStart->mutex);
+    Array_<bool>& retain = m_warmStart->retain;
+    unsigned n = 0;
+    for (int phase=0; phase < MaxNumPhases; ++phase)
+        n = std::max(n, m_warmStart->impulses[phase].size());
+    retain.resize(n); retain.fill(false);
+    for (unsigned k=0; k < uniContacts.size(); ++k)
+        if (uniContacts[k].isValid() && (unsigned)uniContacts[k] < n)
+            retain[uniContacts[k]] = true;
+    for (int phase=0; phase < MaxNumPhases; ++phase) {
+        Array_<Vec3>& saved = m_warmStart->impulses[phase];
+        for (unsigned i=0; i < saved.size(); ++i)
+            if (!retain[i]) saved[i] = Vec3(NaN);
+    }
+}
+
+//------------------------------------------------------------------------------
+//                            COLOR CONTACTS
+//------------------------------------------------------------------------------
+// Greedy coloring of the unilateral contacts so that no two contacts of the
+// same color are coupled through A. A is symmetric so instead of looking
+// along the rows of a contact's multipliers we look down the columns, which
+// are contiguous. This costs about as much as one PGS sweep.
+void PGSImpulseSolver::
+colorContacts(const Array_<MultiplierIndex>& participating,
+              const Matrix&                  A,
+              const Array_<UniContactRT>&    uniContact) const
+{
+    const int m = A.nrow();
+    const int nc = (int)uniContact.size();
+
+    m_multContact.resize(m); m_multContact.fill(-1);
+    m_contactColor.resize(nc); m_contactColor.fill(-1);
+    m_colors.clear();
+
+    Array_<MultiplierIndex> mults;
+    for (int k=0; k < nc; ++k) {
+        getParticipatingMults(uniContact[k], mults);
+        for (unsigned i=0; i < mults.size(); ++i)
+            m_multContact[mults[i]] = k;
+    }
+
+    assert(A.hasContiguousData()); // packed
+    assert(A(0).hasContiguousData()); // in column order
+    const Real* Ap = &A(0,0);
+
+    // usedBy[c]==k means color c is already taken by a neighbor of k.
+    Array_<int> usedBy;
+    for (int k=0; k < nc; ++k) {
+        getParticipatingMults(uniContact[k], mults);
+        if (mults.empty())
+            continue;
+        for (unsigned i=0; i < mults.size(); ++i) {
+            const Real* cp = Ap + mults[i]*m; // point to start of column
+            for (unsigned r=0; r < participating.size(); ++r) {
+                const MultiplierIndex rx = participating[r];
+                if (cp[rx] == 0) 
+                    continue;
+                const int owner = m_multContact[rx];
+                if (owner < 0 || owner == k || m_contactColor[owner] < 0)
+                    continue;
+                usedBy[m_contactColor[owner]] = k;
+            }
+        }
+        int color = 0;
+        while (color < (int)usedBy.size() && usedBy[color] == k)
+            ++color;
+        if (color == (int)usedBy.size()) {
+            usedBy.push_back(-1);
+            m_colors.push_back();
+        }
+        m_contactColor[k] = color;
+        m_colors[color].push_back(k);
+    }
+    SimTK_DEBUG2("PGS: %d contacts in %d colors\n", nc, (int)m_colors.size());
+}
+
+
+
+//------------------------------------------------------------------------------
+//                        SWEEP COLORED CONTACTS
+//------------------------------------------------------------------------------
+void PGSImpulseSolver::
+sweepColoredContacts(const Array_<MultiplierIndex>& participating,
+                     const Matrix&                  A,
+                     const Vector&                  D,
+                     const Vector&                  rhs,
+                     const Vector&                  piExpand,
+                     Real                           sor,
+                     Array_<UniContactRT>&          uniContact,
+                     Vector&                        pi,
+                     Real&                          sum2all,
+                     Real&                          sum2enf) const
+{
+    const int nc = (int)uniContact.size();
+    m_er2all.resize(nc); m_er2all.fill(Real(0));
+    m_er2enf.resize(nc); m_er2enf.fill(Real(0));
+
+    if (!m_executor)
+        m_executor = new ParallelExecutor(m_numThreads);
+
+    for (int c=0; c < (int)m_colors.size(); ++c) {
+        const Array_<int>& contacts = m_colors[c];
+        ColoredSweepTask task(contacts, c, participating, A, D, rhs, piExpand,
+                              sor, m_multContact, m_contactColor, uniContact,
+                              pi, m_er2all, m_er2enf);
+        if ((int)contacts.size() < MinParallelColorSize) {
+            for (int i=0; i < (int)contacts.size(); ++i)
+                task.execute(i);
+        } else
+            m_executor->executeAndRethrow(task, (int)contacts.size());
+    }
+
+    for (int k=0; k < nc; ++k) {
+        sum2all += m_er2all[k];
+        sum2enf += m_er2enf[k];
+    }
+}
+
+
+} // namespace SimTK
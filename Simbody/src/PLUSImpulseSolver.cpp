@@ -158,6 +158,7 @@ solve(int                                 phase,
     SimTK_DEBUG("\n--------------------------------\n");
     SimTK_DEBUG(  "START SUCCESSIVE PRUNING SOLVER:\n");
     ++m_nSolves[phase];
+    const double startTime = realTime();
 
     const int m=A.nrow(); assert(A.ncol()==m); 
     assert(D.size()==m);
@@ -252,6 +253,7 @@ solve(int                                 phase,
             // verr is updated.
             if (hasAppliedImpulse) verrStart += verrApplied;
             if (nx)                verrStart += m_verrExpand;
+            m_solveTime[phase] += realTime() - startTime;
             return true;
         }
 
@@ -705,6 +707,7 @@ solve(int                                 phase,
     cout << "SP FINAL " << interval << " intervals, piTotal=" << piTotal 
          <<  " errNorm=" << m_errActive.norm() << endl;
     #endif
+    m_solveTime[phase] += realTime() - startTime;
     return converged;
 }
 
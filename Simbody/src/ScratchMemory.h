@@ -0,0 +1,174 @@
+#ifndef SimTK_SIMBODY_SCRATCH_MEMORY_H_
+#define SimTK_SIMBODY_SCRATCH_MEMORY_H_
+
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Per-thread scratch memory for the O(n) operators of SimbodyMatterSubsystem.
+
+Those operators need temporaries sized by the number of bodies, mobilities, or
+constraint equations, and they are often called many times per time step (from
+controllers, for example). Even an empty Vector allocates heap memory for its
+handle, so local temporaries cost several allocations per call. Instead, a
+temporary is borrowed here from a pool that belongs to the calling thread and
+is returned to the pool when it goes out of scope, so after the first few calls
+no heap allocation is done at all.
+
+A ScratchVector_ is always given a Vector_ of exactly the requested size, so
+its contents are whatever was left there by its previous user. A ScratchArray_
+is given an empty Array_ that keeps the capacity it acquired in earlier use,
+so it is meant for arrays that are resized repeatedly. Use them like this:
+@code
+    ScratchVector_<SpatialVec> scratchA_GB(nb);
+    Vector_<SpatialVec>& A_GB = *scratchA_GB;
+@endcode
+Scratch objects must be destroyed on the thread that created them, which is
+always the case for local variables. */
+
+#include "SimTKcommon.h"
+
+namespace SimTK {
+
+// A pool of unused containers of type C, one per thread. Only a limited number
+// of free containers is kept so that memory doesn't pile up when a thread
+// works on Systems of many different sizes.
+template <class C>
+class ScratchPool_ {
+public:
+    static ScratchPool_& getThreadPool() {
+        static thread_local ScratchPool_ pool;
+        return pool;
+    }
+
+    ~ScratchPool_() {
+        for (C* c : m_free)
+            delete c;
+    }
+
+    // Remove and return the most recently returned container of size n, or
+    // return null if there is none.
+    C* takeOfSize(int n) {
+        for (int i = (int)m_free.size()-1; i >= 0; --i)
+            if ((int)m_free[i]->size() == n)
+                return takeAt(i);
+        return nullptr;
+    }
+
+    // Remove and return the most recently returned container, or return null
+    // if the pool is empty.
+    C* takeAny() {
+        return m_free.empty() ? nullptr : takeAt((int)m_free.size()-1);
+    }
+
+    // Return a container to the pool, which takes over ownership. If the pool
+    // is full the oldest container is deleted.
+    void give(C* c) {
+        if (m_free.size() == MaxFree) {
+            delete m_free.front();
+            m_free.erase(m_free.begin());
+        }
+        m_free.push_back(c);
+    }
+
+private:
+    enum {MaxFree = 32};
+
+    ScratchPool_() {m_free.reserve(MaxFree);}
+
+    C* takeAt(int i) {
+        C* c = m_free[i];
+        m_free.erase(m_free.begin()+i);
+        return c;
+    }
+
+    Array_<C*> m_free;
+};
+
+// A Vector_<T> of fixed size borrowed from the calling thread's pool. A
+// default-constructed ScratchVector_ doesn't borrow anything until borrow() is
+// called, so it is free if it turns out not to be needed.
+template <class T>
+class ScratchVector_ {
+    typedef ScratchPool_<Vector_<T> > Pool;
+public:
+    ScratchVector_() : m_vec(nullptr) {}
+    explicit ScratchVector_(int n) : m_vec(nullptr) {borrow(n);}
+    ~ScratchVector_() {giveBack();}
+
+    // Borrow a Vector_ of length n, returning any previously borrowed one.
+    Vector_<T>& borrow(int n) {
+        giveBack();
+        m_vec = Pool::getThreadPool().takeOfSize(n);
+        if (!m_vec)
+            m_vec = new Vector_<T>(n);
+        return *m_vec;
+    }
+
+    Vector_<T>& operator*()  const {assert(m_vec); return *m_vec;}
+    Vector_<T>* operator->() const {assert(m_vec); return m_vec;}
+
+private:
+    ScratchVector_(const ScratchVector_&) = delete;
+    ScratchVector_& operator=(const ScratchVector_&) = delete;
+
+    void giveBack() {
+        if (m_vec) {
+            Pool::getThreadPool().give(m_vec);
+            m_vec = nullptr;
+        }
+    }
+
+    Vector_<T>*     m_vec;
+};
+
+typedef ScratchVector_<Real> ScratchVector;
+
+// An Array_<T,X> borrowed from the calling thread's pool. It starts out with
+// size n (default constructed elements) but may be resized freely; it won't
+// need heap allocation unless it grows beyond the largest size it has had
+// before.
+template <class T, class X=unsigned>
+class ScratchArray_ {
+    typedef ScratchPool_<Array_<T,X> > Pool;
+public:
+    explicit ScratchArray_(int n=0) : m_array(Pool::getThreadPool().takeAny()) {
+        if (!m_array)
+            m_array = new Array_<T,X>();
+        m_array->clear();
+        m_array->resize(n);
+    }
+    ~ScratchArray_() {Pool::getThreadPool().give(m_array);}
+
+    Array_<T,X>& operator*()  const {return *m_array;}
+    Array_<T,X>* operator->() const {return m_array;}
+
+private:
+    ScratchArray_(const ScratchArray_&) = delete;
+    ScratchArray_& operator=(const ScratchArray_&) = delete;
+
+    Array_<T,X>*    m_array;
+};
+
+} // namespace SimTK
+
+#endif // SimTK_SIMBODY_SCRATCH_MEMORY_H_
@@ -29,6 +29,7 @@
 #include "SimbodyMatterSubsystemRep.h"
 
 #include <iostream>
+#include <mutex>
 using std::cout; using std::endl;
 
 using namespace SimTK;
@@ -48,6 +49,39 @@ namespace {
         DefImpulseSolverType   = SemiExplicitEulerTimeStepper::PLUS;
     const SemiExplicitEulerTimeStepper::PositionProjectionMethod 
         DefPosProjMethod = SemiExplicitEulerTimeStepper::Bilateral;
+
+// This is the ParallelExecutor task for solving islands. Each island claims
+// one of the free solvers; there are at least as many solvers as threads so
+// one is always available.
+class IslandTask : public ParallelExecutor::Task {
+public:
+    IslandTask(Array_<const ImpulseSolver*>& freeSolvers,
+               const std::function<void(const ImpulseSolver&,int)>& solve)
+    :   freeSolvers(freeSolvers), solve(solve) {}
+
+    void execute(int island) override {
+        const ImpulseSolver* solver;
+        {   std::lock_guard<std::mutex> lock(mutex);
+            solver = freeSolvers.back(); freeSolvers.pop_back(); }
+        try {
+            solve(*solver, island);
+        } catch (...) {
+            release(solver);
+            throw;
+        }
+        release(solver);
+    }
+
+private:
+    void release(const ImpulseSolver* solver) {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeSolvers.push_back(solver);
+    }
+
+    Array_<const ImpulseSolver*>&                           freeSolvers;
+    const std::function<void(const ImpulseSolver&,int)>&    solve;
+    std::mutex                                              mutex;
+};
 }
 
 namespace SimTK {
@@ -68,7 +102,8 @@ SemiExplicitEulerTimeStepper(const MultibodySystem& mbs)
     m_defaultMinCORVelocity(0),     // means: use capture velocity
     m_defaultTransitionVelocity(0), // means: use 2 x constraintTol
     m_minSignificantForce(DefMinSignificantForce),
-    m_solver(0)
+    m_solver(0), m_numThreads(1), m_nextEventTime(Infinity),
+    m_isSimulationOver(false)
 {}
 
 
@@ -82,6 +117,11 @@ stepTo(Real time) {
     const SimbodyMatterSubsystem&       matter = mbs.getMatterSubsystem();
     State&                              s      = m_state;
 
+    SimTK_ERRCHK1_ALWAYS(!m_isSimulationOver,
+        "SemiExplicitEulerTimeStepper::stepTo()",
+        "Attempted stepTo(t=%g) after an event handler asked for the "
+        "simulation to terminate. Call initialize() to restart.", time);
+
     const Real t0 = m_state.getTime();
     const Real h = time - t0;    // max timestep
 
@@ -89,6 +129,8 @@ stepTo(Real time) {
     mbs.realize(s, Stage::Position); 
     // Determine which constraints will be involved for this step.
     findProximalConstraints(s);
+    // Warm start information about any other contacts is out of date.
+    m_solver->retainWarmStart(m_proximalUniContacts);
     // Enable all proximal constraints, reassigning multipliers if needed.
     enableProximalConstraints(s);
     collectConstraintInfo(s);
@@ -105,6 +147,10 @@ stepTo(Real time) {
 
     if (m==0) {
         takeUnconstrainedStep(s, h);
+        if (handleEvents(s)) {
+            m_isSimulationOver = true;
+            return Integrator::EndOfSimulation;
+        }
         return Integrator::ReachedScheduledEvent;
     }
 
@@ -114,8 +160,9 @@ stepTo(Real time) {
     // separate and no time is going by during an impact.
     calcCoefficientsOfFriction(s, verr0);
 
-    // Calculate the constraint compliance matrix A=GM\~G.
-    matter.calcProjectedMInv(s, m_GMInvGt); // m X m
+    // Calculate the constraint compliance matrix A=GM\~G, one diagonal block
+    // for each independent island of constraints.
+    findIslands(s, m);
 
     // TODO: this is for soft constraints. D >= 0.
     m_D.resize(m); m_D.setToZero();
@@ -404,6 +451,7 @@ stepTo(Real time) {
     matterRep.markCacheValueRealized(s, topo.constrainedAccelerationCacheIndex);
     matterRep.markCacheValueRealized(s, topo.treeAccelerationCacheIndex);
 
+    m_isSimulationOver = handleEvents(s);
 
     #ifndef NDEBUG
     printf("END OF STEP (%g,%g):\n", t0,s.getTime());
@@ -418,7 +466,8 @@ stepTo(Real time) {
     }
     #endif
 
-    return Integrator::ReachedScheduledEvent;
+    return m_isSimulationOver ? Integrator::EndOfSimulation
+                              : Integrator::ReachedScheduledEvent;
 }
 
 //------------------------------------------------------------------------------
@@ -734,6 +783,70 @@ void SemiExplicitEulerTimeStepper::initialize(const State& initState) {
     // Make sure the impulse solve knows our tolerance for slip velocity
     // during rolling.
     m_solver->setMaxRollingSpeed(getDefaultFrictionTransitionVelocityInUse());
+
+    // Impulses saved from a previous simulation are no use here.
+    m_solver->clearWarmStart();
+    clearSolverClones(); // in case the solver settings changed
+
+    m_isSimulationOver = false;
+    findNextEvents(m_state);
+}
+
+//------------------------------------------------------------------------------
+//                              HANDLE EVENTS
+//------------------------------------------------------------------------------
+// Steps are taken as requested so events aren't localized. A scheduled event
+// is handled at the end of the step during which its time arrived, and a 
+// triggered event at the end of the step over which its witness made a 
+// transition it is waiting for. Only witnesses realized by Stage::Dynamics are
+// checked since that is as far as a step realizes the State. If a scheduled
+// event's handler asks to terminate, the triggered events aren't handled.
+bool SemiExplicitEulerTimeStepper::handleEvents(State& s) {
+    const int nTriggers = s.getEventTriggerStartByStage(Stage::Acceleration);
+    Array_<EventId> triggeredIds;
+    if (nTriggers == m_eventTriggers.size()) {
+        const Vector& triggers = s.getEventTriggers();
+        m_mbs.calcEventTriggerInfo(s, m_triggerInfo);
+        for (int i=0; i < nTriggers; ++i) {
+            const Event::Trigger transition = Event::maskTransition
+               (Event::classifyTransition(sign(m_eventTriggers[i]), 
+                                          sign(triggers[i])),
+                m_triggerInfo[i].calcTransitionMask());
+            if (transition != Event::NoEventTrigger)
+                triggeredIds.push_back(m_triggerInfo[i].getEventId());
+        }
+    }
+
+    const HandleEventsOptions options(m_accuracy);
+    bool changed = false, shouldTerminate = false;
+    if (s.getTime() >= m_nextEventTime) {
+        HandleEventsResults results;
+        m_mbs.handleEvents(s, Event::Cause::Scheduled, m_nextEventIds,
+                           options, results);
+        changed = results.getLowestModifiedStage() <= Stage::Dynamics;
+        shouldTerminate = 
+            results.getExitStatus()==HandleEventsResults::ShouldTerminate;
+    }
+    if (!triggeredIds.empty() && !shouldTerminate) {
+        if (changed)
+            m_mbs.realize(s, Stage::Dynamics);
+        HandleEventsResults results;
+        m_mbs.handleEvents(s, Event::Cause::Triggered, triggeredIds,
+                           options, results);
+        shouldTerminate = 
+            results.getExitStatus()==HandleEventsResults::ShouldTerminate;
+    }
+    m_mbs.realize(s, Stage::Dynamics); // no-op unless something changed
+
+    findNextEvents(s);
+    return shouldTerminate;
+}
+
+void SemiExplicitEulerTimeStepper::findNextEvents(const State& s) {
+    const int nTriggers = s.getEventTriggerStartByStage(Stage::Acceleration);
+    m_eventTriggers = s.getEventTriggers()(0, nTriggers);
+    m_mbs.calcTimeOfNextScheduledEvent(s, m_nextEventTime, m_nextEventIds,
+                                       false);
 }
 
 //------------------------------------------------------------------------------
@@ -783,7 +896,9 @@ findProximalConstraints(const State& s) { //TODO: redo
 
     for (UnilateralContactIndex ux(0); ux < nUniContacts; ++ux) {
         const UnilateralContact& contact = matter.getUnilateralContact(ux);
-        if (contact.isProximal(s, m_consTol)) // may be scaled
+        // A contact that can't move (e.g. asleep) needs no impulse.
+        if (contact.isProximal(s, m_consTol) // may be scaled
+            && !contact.isLocked(s))
             m_proximalUniContacts.push_back(ux);
         else m_distalUniContacts.push_back(ux);
     }
@@ -1156,10 +1271,11 @@ doCompressionPhase(const State& s, Vector& verrStart, Vector& verrApplied,
     cout << "  verrStart=" << verrStart << endl;
     cout << "  verrApplied=" << verrApplied << endl;
 #endif
-    // TODO: improve initial guess
+    // The solver may use impulses saved from the last step as its initial
+    // guess (PGS does).
     m_expansionImpulse.setToZero(); //TODO: shouldn't need to zero this
-    bool converged = m_solver->solve(0,
-        m_allParticipating,m_GMInvGt,m_D,
+    bool converged = solveIslands(0,
+        m_allParticipating,
         Array_<MultiplierIndex>(), m_expansionImpulse, 
         verrStart, verrApplied, 
         compImpulse,
@@ -1184,8 +1300,8 @@ doExpansionPhase(const State&   state,
                  Vector&        verrStart, 
                  Vector&        reactionImpulse) {
     // TODO: improve initial guess
-    bool converged = m_solver->solve(1,
-        m_participating,m_GMInvGt,m_D,
+    bool converged = solveIslands(1,
+        m_participating,
         expanding,expansionImpulse, verrStart,m_emptyVector,
         reactionImpulse,
         m_unconditional,m_uniContact,m_uniSpeed,m_bounded,
@@ -1209,8 +1325,8 @@ doInducedImpactRound(const State& s,
 #ifndef NDEBUG
     printf("IMP t=%.15g verr=", s.getTime()); cout << verrStart << endl;
 #endif
-    bool converged = m_solver->solve(0,
-        m_participating,m_GMInvGt,m_D,
+    bool converged = solveIslands(0,
+        m_participating,
         expanding,expansionImpulse, verrStart,m_emptyVector,
         impulse,
         m_unconditional,m_uniContact,m_uniSpeed,m_bounded,
@@ -1233,8 +1349,8 @@ doPositionCorrectionPhase(const State& state, Vector& pverr,
         SimTK_DEBUG1("UNILATERAL POSITION CORRECTION, %d participators\n",
                      (int)m_posParticipating.size());
         m_expansionImpulse.setToZero(); //TODO: shouldn't need to zero this
-        converged = m_solver->solve(2,
-            m_posParticipating,m_GMInvGt,m_D,
+        converged = solveIslands(2,
+            m_posParticipating,
             Array_<MultiplierIndex>(), m_expansionImpulse,
             pverr, m_emptyVector,
             positionImpulse,
@@ -1255,8 +1371,313 @@ doPositionCorrectionPhase(const State& state, Vector& pverr,
         }
         SimTK_DEBUG1("BILATERAL POSITION CORRECTION, %d participators\n",
                     (int)m_participating.size());
-        converged = m_solver->solveBilateral(m_participating,m_GMInvGt,m_D,
-                                             pverr, positionImpulse);
+        converged = solveIslandsBilateral(m_participating, 
+                                          pverr, positionImpulse);
+    }
+    return converged;
+}
+
+//------------------------------------------------------------------------------
+//                              FIND ISLANDS
+//------------------------------------------------------------------------------
+// M\ couples only the mobilities within the subtree of a single base body
+// (a body whose parent is Ground), so the only coupling between subtrees in 
+// A=GM\~G comes from constraints that act on more than one of them. We start
+// with each base body in its own island and merge the islands of all the 
+// base bodies touched by each enabled constraint. Islands are numbered in 
+// order of their lowest multiplier. A multiplier whose constraint acts only 
+// on Ground gets an island to itself.
+//
+// Then we form the block of A for each island. That takes only as many 
+// passes through the O(n) operators as there are multipliers in the largest
+// island, rather than m passes for all of A.
+void SemiExplicitEulerTimeStepper::
+findIslands(const State& s, int m) {
+    const SimbodyMatterSubsystem& matter = m_mbs.getMatterSubsystem();
+
+    m_islandMults.clear();
+    m_multIsland.resize(m); m_multIsland.fill(-1);
+    m_multLocal.resize(m);
+
+    // The solver inputs other than unilateral contacts aren't split into
+    // islands yet; if there are any we just solve everything together.
+    const bool oneIsland = !(m_unconditional.empty() && m_uniSpeed.empty()
+        && m_bounded.empty() && m_consLtdFriction.empty() 
+        && m_stateLtdFriction.empty() && m_posUnconditional.empty());
+
+    if (oneIsland) {
+        m_islandMults.resize(1);
+        for (MultiplierIndex mx(0); mx < m; ++mx) {
+            m_islandMults[0].push_back(mx);
+            m_multIsland[mx] = 0; m_multLocal[mx] = mx;
+        }
+    } else {
+        // Union-find over the mobilized bodies, although only base bodies 
+        // are used. multBase[mx] is some base body of mx's constraint.
+        const int nb = matter.getNumBodies();
+        Array_<int> parent(nb);
+        for (int b=0; b < nb; ++b) parent[b] = b;
+        auto findRoot = [&parent](int b) {
+            while (parent[b] != b) b = parent[b] = parent[parent[b]];
+            return b;
+        };
+        Array_<int> multBase(m, -1);
+        Array_<MobilizedBodyIndex> bases;
+        for (ConstraintIndex cx(0); cx < matter.getNumConstraints(); ++cx) {
+            const Constraint& constraint = matter.getConstraint(cx);
+            if (constraint.isDisabled(s))
+                continue;
+            int mp, mv, ma;
+            constraint.getNumConstraintEquationsInUse(s, mp, mv, ma);
+            if (mp+mv+ma == 0)
+                continue;
+
+            bases.clear();
+            const int ncb = constraint.getNumConstrainedBodies();
+            for (ConstrainedBodyIndex cbx(0); cbx < ncb; ++cbx) {
+                const MobilizedBody& mobod = 
+                    constraint.getMobilizedBodyFromConstrainedBody(cbx);
+                if (!mobod.isGround())
+                    bases.push_back(
+                        mobod.getBaseMobilizedBody().getMobilizedBodyIndex());
+            }
+            const int ncm = constraint.getNumConstrainedMobilizers();
+            for (ConstrainedMobilizerIndex cmx(0); cmx < ncm; ++cmx) {
+                const MobilizedBody& mobod = 
+                    constraint.getMobilizedBodyFromConstrainedMobilizer(cmx);
+                if (!mobod.isGround())
+                    bases.push_back(
+                        mobod.getBaseMobilizedBody().getMobilizedBodyIndex());
+            }
+            if (bases.empty())
+                continue;
+            const int root = findRoot(bases[0]);
+            for (unsigned i=1; i < bases.size(); ++i)
+                parent[findRoot(bases[i])] = root;
+
+            MultiplierIndex px0, vx0, ax0;
+            constraint.getIndexOfMultipliersInUse(s, px0, vx0, ax0);
+            for (int i=0; i < mp; ++i) multBase[px0+i] = root;
+            for (int i=0; i < mv; ++i) multBase[vx0+i] = root;
+            for (int i=0; i < ma; ++i) multBase[ax0+i] = root;
+        }
+
+        Array_<int> rootIsland(nb, -1);
+        for (MultiplierIndex mx(0); mx < m; ++mx) {
+            int island;
+            if (multBase[mx] < 0) 
+                island = -1;
+            else {
+                const int root = findRoot(multBase[mx]);
+                island = rootIsland[root];
+                if (island < 0) rootIsland[root] = (int)m_islandMults.size();
+            }
+            if (island < 0) {
+                island = (int)m_islandMults.size();
+                m_islandMults.push_back();
+            }
+            m_multIsland[mx] = island;
+            m_multLocal[mx]  = (int)m_islandMults[island].size();
+            m_islandMults[island].push_back(mx);
+        }
+    }
+
+    SimTK_DEBUG2("%d multipliers in %d islands\n", m, 
+                 (int)m_islandMults.size());
+    matter.calcProjectedMInv(s, m_islandMults, m_islandA);
+
+    // Make copies of the solver for the other threads if we don't have them
+    // yet. They are discarded whenever the solver, its settings, or the
+    // number of threads may have changed.
+    if (   m_solverClones.empty() && m_numThreads > 1 
+        && m_islandMults.size() > 1) {
+        for (int i=1; i < m_numThreads; ++i) {
+            ImpulseSolver* clone = m_solver->clone();
+            if (!clone) break;
+            m_solverClones.push_back(clone);
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//                             FOR EACH ISLAND
+//------------------------------------------------------------------------------
+void SemiExplicitEulerTimeStepper::
+forEachIsland(const std::function<void(const ImpulseSolver&,int)>& 
+              solveIsland) {
+    const int ni = (int)m_islandMults.size();
+    if (m_solverClones.empty()) {
+        for (int i=0; i < ni; ++i)
+            solveIsland(*m_solver, i);
+        return;
+    }
+
+    Array_<const ImpulseSolver*>& freeSolvers = m_freeSolvers;
+    freeSolvers.assign(1, m_solver);
+    for (unsigned i=0; i < m_solverClones.size(); ++i)
+        freeSolvers.push_back(m_solverClones[i]);
+    if (!m_executor || m_executor->getMaxThreads() != (int)freeSolvers.size())
+        m_executor = new ParallelExecutor((int)freeSolvers.size());
+    IslandTask task(freeSolvers, solveIsland);
+    m_executor->executeAndRethrow(task, ni);
+
+    // Count the clones' work in the stats of the solver the user sees.
+    for (unsigned i=0; i < m_solverClones.size(); ++i) {
+        m_solver->addStats(*m_solverClones[i]);
+        m_solverClones[i]->clearStats();
+    }
+}
+
+//------------------------------------------------------------------------------
+//                              SOLVE ISLANDS
+//------------------------------------------------------------------------------
+// Gather each island's part of the problem into its workspace, using 
+// multiplier indices local to the island, solve the islands, then scatter
+// the results back.
+bool SemiExplicitEulerTimeStepper::
+solveIslands
+   (int                                                 phase,
+    const Array_<MultiplierIndex>&                      participating,
+    const Array_<MultiplierIndex>&                      expanding,
+    Vector&                                             piExpand,
+    Vector&                                             verrStart,
+    Vector&                                             verrApplied,
+    Vector&                                             pi,
+    Array_<ImpulseSolver::UncondRT>&                    unconditional,
+    Array_<ImpulseSolver::UniContactRT>&                uniContact,
+    Array_<ImpulseSolver::UniSpeedRT>&                  uniSpeed,
+    Array_<ImpulseSolver::BoundedRT>&                   bounded,
+    Array_<ImpulseSolver::ConstraintLtdFrictionRT>&     consLtdFriction,
+    Array_<ImpulseSolver::StateLtdFrictionRT>&          stateLtdFriction)
+{
+    // With only one island the local and global indices are the same.
+    if (m_islandMults.size() == 1)
+        return m_solver->solve(phase, participating, m_islandA[0], m_D, 
+                               expanding, piExpand, verrStart, verrApplied, 
+                               pi, unconditional, uniContact, uniSpeed, 
+                               bounded, consLtdFriction, stateLtdFriction);
+
+    // Otherwise we know there are only unilateral contacts; see findIslands().
+    assert(unconditional.empty() && uniSpeed.empty() && bounded.empty()
+           && consLtdFriction.empty() && stateLtdFriction.empty());
+
+    const int ni = (int)m_islandMults.size();
+    const bool hasApplied = verrApplied.size() > 0;
+    m_islandWork.resize(ni);
+    for (int i=0; i < ni; ++i) {
+        IslandWorkspace& w = m_islandWork[i];
+        const Array_<MultiplierIndex>& mults = m_islandMults[i];
+        const int mi = (int)mults.size();
+        w.contacts.clear(); w.participating.clear(); w.expanding.clear();
+        w.D.resize(mi); w.piExpand.resize(mi); w.verrStart.resize(mi);
+        w.verrApplied.resize(hasApplied ? mi : 0);
+        for (int r=0; r < mi; ++r) {
+            w.D[r]         = m_D[mults[r]];
+            w.piExpand[r]  = piExpand[mults[r]];
+            w.verrStart[r] = verrStart[mults[r]];
+            if (hasApplied) w.verrApplied[r] = verrApplied[mults[r]];
+        }
+    }
+    for (unsigned i=0; i < participating.size(); ++i) {
+        const MultiplierIndex mx = participating[i];
+        m_islandWork[m_multIsland[mx]].participating
+            .push_back(MultiplierIndex(m_multLocal[mx]));
+    }
+    for (unsigned i=0; i < expanding.size(); ++i) {
+        const MultiplierIndex mx = expanding[i];
+        m_islandWork[m_multIsland[mx]].expanding
+            .push_back(MultiplierIndex(m_multLocal[mx]));
+    }
+    for (unsigned k=0; k < uniContact.size(); ++k)
+        m_islandWork[m_multIsland[uniContact[k].m_Nk]].contacts.push_back(k);
+
+    forEachIsland([&](const ImpulseSolver& solver, int i) {
+        IslandWorkspace& w = m_islandWork[i];
+        w.uniContact.resize(w.contacts.size());
+        for (unsigned j=0; j < w.contacts.size(); ++j) {
+            ImpulseSolver::UniContactRT& rt = w.uniContact[j];
+            rt = uniContact[w.contacts[j]];
+            rt.m_Nk = MultiplierIndex(m_multLocal[rt.m_Nk]);
+            for (unsigned f=0; f < rt.m_Fk.size(); ++f)
+                rt.m_Fk[f] = MultiplierIndex(m_multLocal[rt.m_Fk[f]]);
+        }
+        w.converged = solver.solve(phase, w.participating, m_islandA[i], w.D,
+            w.expanding, w.piExpand, w.verrStart, w.verrApplied, w.pi,
+            unconditional, w.uniContact, uniSpeed, bounded, consLtdFriction,
+            stateLtdFriction);
+    });
+
+    bool converged = true;
+    pi.resize(verrStart.size());
+    for (int i=0; i < ni; ++i) {
+        const IslandWorkspace& w = m_islandWork[i];
+        const Array_<MultiplierIndex>& mults = m_islandMults[i];
+        for (unsigned r=0; r < mults.size(); ++r) {
+            pi[mults[r]]        = w.pi[r];
+            piExpand[mults[r]]  = w.piExpand[r];
+            verrStart[mults[r]] = w.verrStart[r];
+            if (hasApplied) verrApplied[mults[r]] = w.verrApplied[r];
+        }
+        // Copy back the solver's working values; indices stay global.
+        for (unsigned j=0; j < w.contacts.size(); ++j) {
+            const ImpulseSolver::UniContactRT& local = w.uniContact[j];
+            ImpulseSolver::UniContactRT& rt = uniContact[w.contacts[j]];
+            rt.m_contactCond  = local.m_contactCond;
+            rt.m_frictionCond = local.m_frictionCond;
+            rt.m_slipVel      = local.m_slipVel;
+            rt.m_slipMag      = local.m_slipMag;
+            rt.m_impulse      = local.m_impulse;
+        }
+        converged = converged && w.converged;
+    }
+    return converged;
+}
+
+//------------------------------------------------------------------------------
+//                         SOLVE ISLANDS BILATERAL
+//------------------------------------------------------------------------------
+bool SemiExplicitEulerTimeStepper::
+solveIslandsBilateral(const Array_<MultiplierIndex>& participating,
+                      const Vector&                  rhs,
+                      Vector&                        pi)
+{
+    if (m_islandMults.size() == 1)
+        return m_solver->solveBilateral(participating, m_islandA[0], m_D, 
+                                        rhs, pi);
+
+    const int ni = (int)m_islandMults.size();
+    m_islandWork.resize(ni);
+    for (int i=0; i < ni; ++i) {
+        IslandWorkspace& w = m_islandWork[i];
+        const Array_<MultiplierIndex>& mults = m_islandMults[i];
+        const int mi = (int)mults.size();
+        w.participating.clear();
+        w.D.resize(mi); w.verrStart.resize(mi); // verrStart holds rhs
+        for (int r=0; r < mi; ++r) {
+            w.D[r]         = m_D[mults[r]];
+            w.verrStart[r] = rhs[mults[r]];
+        }
+    }
+    for (unsigned i=0; i < participating.size(); ++i) {
+        const MultiplierIndex mx = participating[i];
+        m_islandWork[m_multIsland[mx]].participating
+            .push_back(MultiplierIndex(m_multLocal[mx]));
+    }
+
+    forEachIsland([&](const ImpulseSolver& solver, int i) {
+        IslandWorkspace& w = m_islandWork[i];
+        w.converged = solver.solveBilateral(w.participating, m_islandA[i], 
+                                            w.D, w.verrStart, w.pi);
+    });
+
+    bool converged = true;
+    pi.resize(rhs.size());
+    for (int i=0; i < ni; ++i) {
+        const IslandWorkspace& w = m_islandWork[i];
+        const Array_<MultiplierIndex>& mults = m_islandMults[i];
+        for (unsigned r=0; r < mults.size(); ++r)
+            pi[mults[r]] = w.pi[r];
+        converged = converged && w.converged;
     }
     return converged;
 }
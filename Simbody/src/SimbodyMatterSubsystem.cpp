@@ -31,6 +31,7 @@
 
 #include "MobilizedBodyImpl.h"
 #include "SimbodyMatterSubsystemRep.h"
+#include "ScratchMemory.h"
 class RigidBodyNode;
 
 #include <string>
@@ -269,35 +270,34 @@ void SimbodyMatterSubsystem::calcResidualForceIgnoringConstraints
     Vector*                     cresid      = &residualMobilityForces;
     bool needToCopyBack = false;
 
-    // We'll allocate these or not as needed.
-    Vector contig_mobForces, contig_udot, contig_resid;
-    Vector_<SpatialVec> contig_bodyForces;
+    // We'll borrow these or not as needed.
+    ScratchVector contig_mobForces, contig_udot, contig_resid;
+    ScratchVector_<SpatialVec> contig_bodyForces;
 
     if (!appliedMobilityForces.hasContiguousData()) {
-        contig_mobForces.resize(nu); // contiguous memory
-        contig_mobForces(0, nu) = appliedMobilityForces; // copy, no reallocation
-        cmobForces = (const Vector*)&contig_mobForces;
+        Vector& copy = contig_mobForces.borrow(nu); // contiguous memory
+        copy = appliedMobilityForces; // copy, no reallocation
+        cmobForces = &copy;
     }
     if (!appliedBodyForcesInG.hasContiguousData()) {
-        contig_bodyForces.resize(nb); // contiguous memory
-        contig_bodyForces(0, nb) = appliedBodyForcesInG; // copy, no reallocation
-        cbodyForces = (const Vector_<SpatialVec>*)&contig_bodyForces;
+        Vector_<SpatialVec>& copy = contig_bodyForces.borrow(nb); // contiguous
+        copy = appliedBodyForcesInG; // copy, no reallocation
+        cbodyForces = &copy;
     }
     if (!knownUdot.hasContiguousData()) {
-        contig_udot.resize(nu); // contiguous memory
-        contig_udot(0, nu) = knownUdot; // copy, no reallocation
-        cudot = (const Vector*)&contig_udot;
+        Vector& copy = contig_udot.borrow(nu); // contiguous memory
+        copy = knownUdot; // copy, no reallocation
+        cudot = &copy;
     }
     if (!residualMobilityForces.hasContiguousData()) {
-        contig_resid.resize(nu); // contiguous memory
-        cresid = (Vector*)&contig_resid;
+        cresid = &contig_resid.borrow(nu); // contiguous memory
         needToCopyBack = true;
     }
 
-    Vector_<SpatialVec> A_GB(nb); // temp for unwanted result
+    ScratchVector_<SpatialVec> A_GB(nb); // temp for unwanted result
     rep.calcTreeResidualForces(state,
         *cmobForces, *cbodyForces, *cudot,
-        A_GB, *cresid);
+        *A_GB, *cresid);
 
     if (needToCopyBack)
         residualMobilityForces = *cresid;
@@ -352,12 +352,15 @@ void SimbodyMatterSubsystem::calcResidualForce
     }
 
     // There are some lambdas, so calculate the forces they produce, with
-    // the result going in newly-allocated contiguous storage. We have to
+    // the result going in borrowed contiguous storage. We have to
     // negate lambda to make the constraint forces have the sign of applied
     // forces; we'll do that into a contiguous Vector also.
-    Vector_<SpatialVec> bodyForcesInG(nb);
-    Vector              mobilityForces(nu);
-    Vector              negLambda = -knownLambda;
+    ScratchVector_<SpatialVec> scratchBodyForces(nb);
+    ScratchVector              scratchMobilityForces(nu), scratchNegLambda(m);
+    Vector_<SpatialVec>& bodyForcesInG  = *scratchBodyForces;
+    Vector&              mobilityForces = *scratchMobilityForces;
+    Vector&              negLambda      = *scratchNegLambda;
+    negLambda = knownLambda; negLambda *= -1;
     rep.calcConstraintForcesFromMultipliers(state, negLambda,
         bodyForcesInG, mobilityForces);
 
@@ -400,18 +403,17 @@ void SimbodyMatterSubsystem::multiplyByM(const State&  state,
     Vector*       cMa   = &Ma;
     bool needToCopyBack = false;
 
-    // We'll allocate these or not as needed.
-    Vector contig_a, contig_Ma;
+    // We'll borrow these or not as needed.
+    ScratchVector contig_a, contig_Ma;
 
     if (!a.hasContiguousData()) {
-        contig_a.resize(nu); // contiguous memory
-        contig_a(0, nu) = a; // copy, prevent reallocation
-        ca = (const Vector*)&contig_a;
+        Vector& copy = contig_a.borrow(nu); // contiguous memory
+        copy = a; // copy, no reallocation
+        ca = &copy;
     }
 
     if (!Ma.hasContiguousData()) {
-        contig_Ma.resize(nu); // contiguous memory
-        cMa = (Vector*)&contig_Ma;
+        cMa = &contig_Ma.borrow(nu); // contiguous memory
         needToCopyBack = true;
     }
 
@@ -449,18 +451,17 @@ void SimbodyMatterSubsystem::multiplyByMInv(const State&    state,
     Vector*       cMInvV   = &MInvV;
     bool needToCopyBack = false;
 
-    // We'll allocate these or not as needed.
-    Vector contig_v, contig_MInvV;
+    // We'll borrow these or not as needed.
+    ScratchVector contig_v, contig_MInvV;
 
     if (!v.hasContiguousData()) {
-        contig_v.resize(nu); // contiguous memory
-        contig_v(0, nu) = v; // copy, prevent reallocation
-        cv = (const Vector*)&contig_v;
+        Vector& copy = contig_v.borrow(nu); // contiguous memory
+        copy = v; // copy, no reallocation
+        cv = &copy;
     }
 
     if (!MInvV.hasContiguousData()) {
-        contig_MInvV.resize(nu); // contiguous memory
-        cMInvV = (Vector*)&contig_MInvV;
+        cMInvV = &contig_MInvV.borrow(nu); // contiguous memory
         needToCopyBack = true;
     }
 
@@ -485,6 +486,12 @@ void SimbodyMatterSubsystem::calcProjectedMInv(const State&   s,
                                                Matrix&        GMInvGt) const
 {   getRep().calcGMInvGt(s, GMInvGt); }
 
+void SimbodyMatterSubsystem::
+calcProjectedMInv(const State&                            s,
+                  const Array_<Array_<MultiplierIndex> >& groups,
+                  Array_<Matrix>&                         blocks) const
+{   getRep().calcGMInvGtBlocks(s, groups, blocks); }
+
 void SimbodyMatterSubsystem::
 solveForConstraintImpulses(const State&     state,
                            const Vector&    deltaV,
@@ -548,18 +555,17 @@ multiplyByGTranspose(const State&  s,
     Vector*       cf      = &f;
     bool needToCopyBack = false;
 
-    // We'll allocate these or not as needed.
-    Vector contig_lambda, contig_f;
+    // We'll borrow these or not as needed.
+    ScratchVector contig_lambda, contig_f;
 
     if (!lambda.hasContiguousData()) {
-        contig_lambda.resize(m); // contiguous memory
-        contig_lambda(0, m) = lambda; // copy, prevent reallocation
-        clambda = (const Vector*)&contig_lambda;
+        Vector& copy = contig_lambda.borrow(m); // contiguous memory
+        copy = lambda; // copy, no reallocation
+        clambda = &copy;
     }
 
     if (!f.hasContiguousData()) {
-        contig_f.resize(nu); // contiguous memory
-        cf = (Vector*)&contig_f;
+        cf = &contig_f.borrow(nu); // contiguous memory
         needToCopyBack = true;
     }
 
@@ -603,18 +609,17 @@ multiplyByPqTranspose(const State&  s,
     Vector*       cfq      = &fq;
     bool needToCopyBack = false;
 
-    // We'll allocate these or not as needed.
-    Vector contig_lambdap, contig_fq;
+    // We'll borrow these or not as needed.
+    ScratchVector contig_lambdap, contig_fq;
 
     if (!lambdap.hasContiguousData()) {
-        contig_lambdap.resize(mp); // contiguous memory
-        contig_lambdap(0, mp) = lambdap; // copy, prevent reallocation
-        clambdap = (const Vector*)&contig_lambdap;
+        Vector& copy = contig_lambdap.borrow(mp); // contiguous memory
+        copy = lambdap; // copy, no reallocation
+        clambdap = &copy;
     }
 
     if (!fq.hasContiguousData()) {
-        contig_fq.resize(nq); // contiguous memory
-        cfq = (Vector*)&contig_fq;
+        cfq = &contig_fq.borrow(nq); // contiguous memory
         needToCopyBack = true;
     }
 
@@ -665,22 +670,21 @@ multiplyByG(const State&  s,
     Vector*       cGulike = &Gulike;
     bool needToCopyBack = false;
 
-    // We'll allocate these or not as needed.
-    Vector contig_ulike, contig_bias, contig_Gulike;
+    // We'll borrow these or not as needed.
+    ScratchVector contig_ulike, contig_bias, contig_Gulike;
 
     if (!ulike.hasContiguousData()) {
-        contig_ulike.resize(nu); // contiguous memory
-        contig_ulike(0, nu) = ulike; // copy, prevent reallocation
-        culike = (const Vector*)&contig_ulike;
+        Vector& copy = contig_ulike.borrow(nu); // contiguous memory
+        copy = ulike; // copy, no reallocation
+        culike = &copy;
     }
     if (!bias.hasContiguousData()) {
-        contig_bias.resize(m); // contiguous memory
-        contig_bias(0, m) = bias; // copy, prevent reallocation
-        cbias = (const Vector*)&contig_bias;
+        Vector& copy = contig_bias.borrow(m); // contiguous memory
+        copy = bias; // copy, no reallocation
+        cbias = &copy;
     }
     if (!Gulike.hasContiguousData()) {
-        contig_Gulike.resize(m); // contiguous memory
-        cGulike = (Vector*)&contig_Gulike;
+        cGulike = &contig_Gulike.borrow(m); // contiguous memory
         needToCopyBack = true;
     }
 
@@ -714,7 +718,8 @@ calcBiasForMultiplyByG(const State& state,
     if (bias.hasContiguousData()) {
         getRep().calcBiasForMultiplyByPVA(state, true, true, true, bias);
     } else {
-        Vector tmpbias(m); // contiguous
+        ScratchVector scratchBias(m); // contiguous
+        Vector& tmpbias = *scratchBias;
         getRep().calcBiasForMultiplyByPVA(state, true, true, true, tmpbias);
         bias = tmpbias;
     }
@@ -747,7 +752,8 @@ calcBiasForAccelerationConstraints(const State& state,
     if (bias.hasContiguousData()) {
         getRep().calcBiasForAccelerationConstraints(state,true,true,true,bias);
     } else {
-        Vector tmpbias(m); // contiguous
+        ScratchVector scratchBias(m); // contiguous
+        Vector& tmpbias = *scratchBias;
         getRep().calcBiasForAccelerationConstraints(state,true,true,true,tmpbias);
         bias = tmpbias;
     }
@@ -785,8 +791,8 @@ calcConstraintAccelerationErrors(const State&               state,
     // If the arguments use contiguous memory we'll work in place, otherwise
     // we'll work in contiguous temporaries and copy back.
 
-    Vector        udotspace; // allocate only if we need to
-    Vector        pvaerrspace;
+    ScratchVector udotspace; // borrow only if we need to
+    ScratchVector pvaerrspace;
 
     const Vector* udotp;
     Vector*       pvaerrp;
@@ -794,25 +800,26 @@ calcConstraintAccelerationErrors(const State&               state,
     if (knownUDot.hasContiguousData()) {
         udotp = &knownUDot;
     } else {
-        udotspace.resize(nu); // contiguous memory
-        udotspace(0, nu) = knownUDot; // prevent reallocation
-        udotp = (const Vector*)&udotspace;
+        Vector& copy = udotspace.borrow(nu); // contiguous memory
+        copy = knownUDot; // copy, no reallocation
+        udotp = &copy;
     }
 
     bool needToCopyBack = false;
     if (pvaerr.hasContiguousData()) {
         pvaerrp = &pvaerr;
     } else {
-        pvaerrspace.resize(m); // contiguous memory
-        pvaerrp = &pvaerrspace;
+        pvaerrp = &pvaerrspace.borrow(m); // contiguous memory
         needToCopyBack = true;
     }
 
     // Obtain consistent A_GB and qdotdot.
-    Vector_<SpatialVec> A_GB;
+    ScratchVector_<SpatialVec> scratchA_GB(getNumBodies());
+    Vector_<SpatialVec>& A_GB = *scratchA_GB;
     rep.calcBodyAccelerationFromUDot(state, *udotp, A_GB);
 
-    Vector qdotdot;
+    ScratchVector scratchQDotDot(state.getNQ());
+    Vector& qdotdot = *scratchQDotDot;
     rep.calcQDotDot(state, *udotp, qdotdot);
 
     rep.calcConstraintAccelerationErrors(state, A_GB, *udotp, qdotdot,
@@ -862,22 +869,21 @@ multiplyByPq(const State&   s,
     Vector*       cPqXqlike = &PqXqlike;
     bool needToCopyBack = false;
 
-    // We'll allocate these or not as needed.
-    Vector contig_qlike, contig_biasp, contig_PqXqlike;
+    // We'll borrow these or not as needed.
+    ScratchVector contig_qlike, contig_biasp, contig_PqXqlike;
 
     if (!qlike.hasContiguousData()) {
-        contig_qlike.resize(nq); // contiguous memory
-        contig_qlike(0, nq) = qlike; // copy, prevent reallocation
-        cqlike = (const Vector*)&contig_qlike;
+        Vector& copy = contig_qlike.borrow(nq); // contiguous memory
+        copy = qlike; // copy, no reallocation
+        cqlike = &copy;
     }
     if (!biasp.hasContiguousData()) {
-        contig_biasp.resize(mp); // contiguous memory
-        contig_biasp(0, mp) = biasp; // copy, prevent reallocation
-        cbiasp = (const Vector*)&contig_biasp;
+        Vector& copy = contig_biasp.borrow(mp); // contiguous memory
+        copy = biasp; // copy, no reallocation
+        cbiasp = &copy;
     }
     if (!PqXqlike.hasContiguousData()) {
-        contig_PqXqlike.resize(mp); // contiguous memory
-        cPqXqlike = (Vector*)&contig_PqXqlike;
+        cPqXqlike = &contig_PqXqlike.borrow(mp); // contiguous memory
         needToCopyBack = true;
     }
 
@@ -912,7 +918,8 @@ calcBiasForMultiplyByPq(const State& state,
         // Just ask for P's bias term.
         getRep().calcBiasForMultiplyByPVA(state, true, false, false, biasp);
     } else {
-        Vector tmpbias(mp); // contiguous
+        ScratchVector scratchBias(mp); // contiguous
+        Vector& tmpbias = *scratchBias;
         getRep().calcBiasForMultiplyByPVA(state, true, false, false, tmpbias);
         biasp = tmpbias;
     }
@@ -937,10 +944,11 @@ calcBodyAccelerationFromUDot(const State&         state,
     if (knownUDot.size() == 0) {
         // Acceleration is just the coriolis acceleration.
         const SBTreeVelocityCache& vc = getRep().getTreeVelocityCache(state);
-        const Array_<SpatialVec>& tca = vc.totalCoriolisAcceleration;
-        const Vector_<SpatialVec> 
-            AC_GB(tca.size(), (const Real*)tca.begin(), true); // shallow ref
-        A_GB = AC_GB;
+        const Array_<SpatialVec,MobilizedBodyIndex>& tca = 
+            vc.totalCoriolisAcceleration;
+        A_GB.resize(tca.size());
+        for (MobilizedBodyIndex mbx(0); mbx < (int)tca.size(); ++mbx)
+            A_GB[mbx] = tca[mbx];
         return;
     }
 
@@ -958,8 +966,8 @@ calcBodyAccelerationFromUDot(const State&         state,
     // If the arguments use contiguous memory we'll work in place, otherwise
     // we'll work in contiguous temporaries and copy back.
 
-    Vector              udotspace; // allocate only if we need to
-    Vector_<SpatialVec> Aspace;
+    ScratchVector              udotspace; // borrow only if we need to
+    ScratchVector_<SpatialVec> Aspace;
 
     const Vector*        udotp;
     Vector_<SpatialVec>* Ap;
@@ -967,17 +975,16 @@ calcBodyAccelerationFromUDot(const State&         state,
     if (knownUDot.hasContiguousData()) {
         udotp = &knownUDot;
     } else {
-        udotspace.resize(nu); // contiguous memory
-        udotspace(0, nu) = knownUDot; // prevent reallocation
-        udotp = (const Vector*)&udotspace;
+        Vector& copy = udotspace.borrow(nu); // contiguous memory
+        copy = knownUDot; // copy, no reallocation
+        udotp = &copy;
     }
 
     bool needToCopyBack = false;
     if (A_GB.hasContiguousData()) {
         Ap = &A_GB;
     } else {
-        Aspace.resize(nb); // contiguous memory
-        Ap = &Aspace;
+        Ap = &Aspace.borrow(nb); // contiguous memory
         needToCopyBack = true;
     }
 
@@ -1003,13 +1010,13 @@ void SimbodyMatterSubsystem::multiplyByN
         return;
     }
 
-    Vector inSpace, outSpace; // allocate if needed
-    const Vector* inp  = inIsContig  ? &in  : (const Vector*)&inSpace;
-    Vector*       outp = outIsContig ? &out : &outSpace;
-    if (!inIsContig) {
-        inSpace.resize(in.size());
-        inSpace(0, in.size()) = in; // prevent reallocation
-    }
+    const int nq = getRep().getNQ(s), nu = getRep().getNU(s);
+    ScratchVector inSpace, outSpace; // borrow if needed
+    const Vector* inp  = inIsContig  ? &in  : &inSpace.borrow(in.size());
+    Vector*       outp = outIsContig ? &out
+                                   : &outSpace.borrow(matrixOnRight ? nu : nq);
+    if (!inIsContig)
+        *inSpace = in; // copy, no reallocation
 
     getRep().multiplyByN(s,matrixOnRight,*inp,*outp);
 
@@ -1028,13 +1035,13 @@ void SimbodyMatterSubsystem::multiplyByNInv
         return;
     }
 
-    Vector inSpace, outSpace; // allocate if needed
-    const Vector* inp  = inIsContig  ? &in  : (const Vector*)&inSpace;
-    Vector*       outp = outIsContig ? &out : &outSpace;
-    if (!inIsContig) {
-        inSpace.resize(in.size());
-        inSpace(0, in.size()) = in; // prevent reallocation
-    }
+    const int nq = getRep().getNQ(s), nu = getRep().getNU(s);
+    ScratchVector inSpace, outSpace; // borrow if needed
+    const Vector* inp  = inIsContig  ? &in  : &inSpace.borrow(in.size());
+    Vector*       outp = outIsContig ? &out
+                                   : &outSpace.borrow(matrixOnRight ? nq : nu);
+    if (!inIsContig)
+        *inSpace = in; // copy, no reallocation
 
     getRep().multiplyByNInv(s,matrixOnRight,*inp,*outp); 
 
@@ -1053,13 +1060,13 @@ void SimbodyMatterSubsystem::multiplyByNDot
         return;
     }
 
-    Vector inSpace, outSpace; // allocate if needed
-    const Vector* inp  = inIsContig  ? &in  : (const Vector*)&inSpace;
-    Vector*       outp = outIsContig ? &out : &outSpace;
-    if (!inIsContig) {
-        inSpace.resize(in.size());
-        inSpace(0, in.size()) = in; // prevent reallocation
-    }
+    const int nq = getRep().getNQ(s), nu = getRep().getNU(s);
+    ScratchVector inSpace, outSpace; // borrow if needed
+    const Vector* inp  = inIsContig  ? &in  : &inSpace.borrow(in.size());
+    Vector*       outp = outIsContig ? &out
+                                   : &outSpace.borrow(matrixOnRight ? nu : nq);
+    if (!inIsContig)
+        *inSpace = in; // copy, no reallocation
 
     getRep().multiplyByNDot(s,matrixOnRight,*inp,*outp); 
 
@@ -1092,18 +1099,17 @@ void SimbodyMatterSubsystem::multiplyBySystemJacobian
     const bool uIsContig  = u.hasContiguousData();
     const bool JuIsContig = Ju.hasContiguousData();
 
-    Vector u_contig; Vector_<SpatialVec> Ju_contig; // allocate only if needed
-    const Vector*        up  = uIsContig  ? &u  : (const Vector*)&u_contig;
-    Vector_<SpatialVec>* Jup = JuIsContig ? &Ju : &Ju_contig;
-    if (!uIsContig) {
-        u_contig.resize(nu);
-        u_contig(0, nu) = u; // prevent reallocation
-    }
+    // Borrow only if needed.
+    ScratchVector u_contig; ScratchVector_<SpatialVec> Ju_contig;
+    const Vector*        up  = uIsContig  ? &u  : &u_contig.borrow(nu);
+    Vector_<SpatialVec>* Jup = JuIsContig ? &Ju : &Ju_contig.borrow(nb);
+    if (!uIsContig)
+        *u_contig = u; // copy, no reallocation
 
     rep.multiplyBySystemJacobian(s, *up, *Jup);
 
     if (!JuIsContig)
-        Ju = Ju_contig;
+        Ju = *Ju_contig;
 }
 
 
@@ -1124,19 +1130,18 @@ void SimbodyMatterSubsystem::multiplyBySystemJacobianTranspose
     const bool F_GIsContig  = F_G.hasContiguousData();
     const bool fIsContig    = f.hasContiguousData();
 
-    Vector_<SpatialVec> F_G_contig; Vector f_contig; // allocate only if needed
-    const Vector_<SpatialVec>* F_Gp = F_GIsContig ? 
-                                &F_G : (const Vector_<SpatialVec>*)&F_G_contig;
-    Vector* fp   = fIsContig  ? &f  : &f_contig;
-    if (!F_GIsContig) {
-        F_G_contig.resize(nb);
-        F_G_contig(0, nb) = F_G; // prevent reallocation
-    }
+    // Borrow only if needed.
+    ScratchVector_<SpatialVec> F_G_contig; ScratchVector f_contig;
+    const Vector_<SpatialVec>* F_Gp = F_GIsContig ? &F_G 
+                                                  : &F_G_contig.borrow(nb);
+    Vector* fp   = fIsContig  ? &f  : &f_contig.borrow(nu);
+    if (!F_GIsContig)
+        *F_G_contig = F_G; // copy, no reallocation
 
     rep.multiplyBySystemJacobianTranspose(s, *F_Gp, *fp); 
 
     if (!fIsContig)
-        f = f_contig;
+        f = *f_contig;
 }
 
 
@@ -1218,9 +1223,9 @@ void SimbodyMatterSubsystem::calcBiasForSystemJacobian
     const SBTreeVelocityCache& vc = getRep().getTreeVelocityCache(state);
     const Array_<SpatialVec,MobilizedBodyIndex>& tca = 
         vc.totalCoriolisAcceleration;
-    const Vector_<SpatialVec> 
-        AC_GB(tca.size(), (const Real*)tca.begin(), true); // shallow ref
-    JDotu = AC_GB;
+    JDotu.resize(tca.size());
+    for (MobilizedBodyIndex mbx(0); mbx < (int)tca.size(); ++mbx)
+        JDotu[mbx] = tca[mbx];
 }
 
 
@@ -1286,13 +1291,14 @@ void SimbodyMatterSubsystem::multiplyByStationJacobian
 
     // First use the System Jacobian to obtain spatial velocities for *all*
     // mobilized body frames, at a cost of 12*(nb+nu) flops.
-    Vector_<SpatialVec> Ju(nb); // temp Ju=J_G*u (contiguous)
+    ScratchVector_<SpatialVec> scratchJu(nb); // temp Ju=J_G*u (contiguous)
+    Vector_<SpatialVec>& Ju = *scratchJu;
     if (u.hasContiguousData())
         rep.multiplyBySystemJacobian(state,u,Ju); 
     else {
-        Vector contig_u(nu); // contiguous data
-        contig_u(0,nu) = u;  // no reallocation
-        rep.multiplyBySystemJacobian(state,contig_u,Ju); 
+        ScratchVector contig_u(nu); // contiguous data
+        *contig_u = u;              // no reallocation
+        rep.multiplyBySystemJacobian(state,*contig_u,Ju); 
     }
 
     // Then for each station task, determine its linear velocity at a cost of
@@ -1342,11 +1348,12 @@ void SimbodyMatterSubsystem::multiplyByStationJacobianTranspose
 
     f.resize(nu); // might not be contiguous
     const bool fIsContig = f.hasContiguousData();
-    Vector f_contig; // will get allocated only if used below
-    Vector* fp = fIsContig ? &f  : &f_contig;
+    ScratchVector f_contig; // will get borrowed only if used below
+    Vector* fp = fIsContig ? &f  : &f_contig.borrow(nu);
 
     // Need an array putting a spatial force on *every* body.
-    Vector_<SpatialVec> F_G(nb); F_G.setToZero();
+    ScratchVector_<SpatialVec> scratchF_G(nb);
+    Vector_<SpatialVec>& F_G = *scratchF_G; F_G.setToZero();
 
     // Collect the applied task forces into F_G.
     for (int task=0; task < nt; ++task) {
@@ -1362,7 +1369,7 @@ void SimbodyMatterSubsystem::multiplyByStationJacobianTranspose
     rep.multiplyBySystemJacobianTranspose(state,F_G,*fp); // 18nb+11nu flops
 
     if (!fIsContig)
-        f = f_contig; // copy result out
+        f = *f_contig; // copy result out
 }
 
 
@@ -1393,8 +1400,10 @@ void SimbodyMatterSubsystem::calcStationJacobian
     // We're assuming that 3*nt << nu so that it is cheaper to calculate ~JS
     // than JS, using ~J*F rather than J*u.
     // TODO: check dimensions and use whichever method is cheaper.
-    Vector_<SpatialVec> F_G(nb); F_G.setToZero();
-    Vector col(nu); // temporary to hold column of ~J_G
+    ScratchVector_<SpatialVec> scratchF_G(nb);
+    ScratchVector scratchCol(nu); // temporary to hold column of ~J_G
+    Vector_<SpatialVec>& F_G = *scratchF_G; F_G.setToZero();
+    Vector& col = *scratchCol;
     for (int task=0; task < nt; ++task) {
         const MobilizedBodyIndex mobodx = onBodyB[task];
         SimTK_INDEXCHECK(mobodx, nb,
@@ -1403,14 +1412,14 @@ void SimbodyMatterSubsystem::calcStationJacobian
         const Vec3 p_BS_G = 
             mobod.expressVectorInGroundFrame(state, p_BS[task]);    // 15 flops
 
-        // Calculate the 3 rows of JS corresponding to this task.
-        RowVectorView_<Vec3> row = JS_G[task];
+        // Calculate the 3 rows of JS corresponding to this task. We fill
+        // in the elements directly since a row view would need the heap.
         SpatialVec& Fb = F_G[mobodx]; // the only one we'll change
         for (int i=0; i < 3; ++i) {
             Fb[1][i] = 1;
             Fb[0] = p_BS_G % Fb[1]; // r X F (9 flops)
             rep.multiplyBySystemJacobianTranspose(state,F_G,col);// 18nb+11nu flops
-            for (int r=0; r < nu; ++r) row[r][i] = col[r]; 
+            for (int r=0; r < nu; ++r) JS_G(task,r)[i] = col[r]; 
             Fb[1][i] = 0;
             Fb[0] = 0;
         }
@@ -1445,8 +1454,10 @@ void SimbodyMatterSubsystem::calcStationJacobian
     // We're assuming that 3*nt << nu so that it is cheaper to calculate ~JS
     // than JS, using ~J*F rather than J*u.
     // TODO: check dimensions and use whichever method is cheaper.
-    Vector_<SpatialVec> F_G(nb); F_G.setToZero();
-    Vector col(nu); // contiguous temporary to hold column of ~J_G
+    ScratchVector_<SpatialVec> scratchF_G(nb);
+    ScratchVector scratchCol(nu); // contiguous temp to hold column of ~J_G
+    Vector_<SpatialVec>& F_G = *scratchF_G; F_G.setToZero();
+    Vector& col = *scratchCol;
     for (int task=0; task < nt; ++task) {
         const MobilizedBodyIndex mobodx = onBodyB[task];
         SimTK_INDEXCHECK(mobodx, nb,
@@ -1461,7 +1472,7 @@ void SimbodyMatterSubsystem::calcStationJacobian
             Fb[1][i] = 1;
             Fb[0] = p_BS_G % Fb[1]; // r X F (9 flops)
             rep.multiplyBySystemJacobianTranspose(state,F_G,col);// 18nb+11nu flops
-            JS_G[3*task + i] = ~col; 
+            for (int r=0; r < nu; ++r) JS_G(3*task + i, r) = col[r]; 
             Fb[1][i] = 0;
             Fb[0] = 0;
         }
@@ -1580,13 +1591,14 @@ void SimbodyMatterSubsystem::multiplyByFrameJacobian
 
     // First use the System Jacobian to obtain spatial velocities for *all*
     // mobilized body frames, at a cost of 12*(nb+nu) flops.
-    Vector_<SpatialVec> Ju(nb); // temp Ju=J_G*u (contiguous)
+    ScratchVector_<SpatialVec> scratchJu(nb); // temp Ju=J_G*u (contiguous)
+    Vector_<SpatialVec>& Ju = *scratchJu;
     if (u.hasContiguousData())
         rep.multiplyBySystemJacobian(state,u,Ju); 
     else {
-        Vector contig_u(nu); // contiguous data
-        contig_u(0,nu) = u;  // no reallocation
-        rep.multiplyBySystemJacobian(state,contig_u,Ju); 
+        ScratchVector contig_u(nu); // contiguous data
+        *contig_u = u;              // no reallocation
+        rep.multiplyBySystemJacobian(state,*contig_u,Ju); 
     }
 
     // Then for each frame task, determine its linear velocity at a cost of
@@ -1635,11 +1647,12 @@ void SimbodyMatterSubsystem::multiplyByFrameJacobianTranspose
 
     f.resize(nu); // might not be contiguous
     const bool fIsContig = f.hasContiguousData();
-    Vector f_contig; // will get allocated only if used below
-    Vector* fp = fIsContig ? &f  : &f_contig;
+    ScratchVector f_contig; // will get borrowed only if used below
+    Vector* fp = fIsContig ? &f  : &f_contig.borrow(nu);
 
     // Need an array putting a spatial force on each body.
-    Vector_<SpatialVec> F_G(nb); F_G.setToZero();
+    ScratchVector_<SpatialVec> scratchF_G(nb);
+    Vector_<SpatialVec>& F_G = *scratchF_G; F_G.setToZero();
 
     // Collect the applied task forces into F_G.
     for (int task=0; task < nt; ++task) {
@@ -1657,7 +1670,7 @@ void SimbodyMatterSubsystem::multiplyByFrameJacobianTranspose
     rep.multiplyBySystemJacobianTranspose(state,F_G,*fp); // 18nb+11nu flops
 
     if (!fIsContig)
-        f = f_contig; // copy result out
+        f = *f_contig; // copy result out
 }
 
 
@@ -1689,8 +1702,10 @@ void SimbodyMatterSubsystem::calcFrameJacobian
     // We're assuming that 6*nt << nu so that it is cheaper to calculate ~JF
     // than JF, using ~J*F rather than J*u.
     // TODO: check dimensions and use whichever method is cheaper.
-    Vector_<SpatialVec> F_G(nb); F_G.setToZero();
-    Vector col(nu); // temporary to hold column of ~J_G
+    ScratchVector_<SpatialVec> scratchF_G(nb);
+    ScratchVector scratchCol(nu); // temporary to hold column of ~J_G
+    Vector_<SpatialVec>& F_G = *scratchF_G; F_G.setToZero();
+    Vector& col = *scratchCol;
     for (int task=0; task < nt; ++task) {
         const MobilizedBodyIndex mobodx = onBodyB[task];
         SimTK_INDEXCHECK(mobodx, nb,
@@ -1699,15 +1714,15 @@ void SimbodyMatterSubsystem::calcFrameJacobian
         const Vec3 p_BA_G = 
             mobod.expressVectorInGroundFrame(state, p_BA[task]);    // 15 flops
 
-        // Calculate the 6 rows of JS corresponding to this task.
-        RowVectorView_<SpatialVec> row = JF_G[task];
+        // Calculate the 6 rows of JS corresponding to this task. We fill
+        // in the elements directly since a row view would need the heap.
         SpatialVec& Fb = F_G[mobodx]; // the only one we'll change
 
         // Rotational part.
         for (int i=0; i < 3; ++i) {
             Fb[0][i] = 1;
             rep.multiplyBySystemJacobianTranspose(state,F_G,col);// 18nb+11nu flops
-            for (int r=0; r < nu; ++r) row[r][0][i] = col[r]; 
+            for (int r=0; r < nu; ++r) JF_G(task,r)[0][i] = col[r]; 
             Fb[0][i] = 0;
         }
 
@@ -1716,7 +1731,7 @@ void SimbodyMatterSubsystem::calcFrameJacobian
             Fb[1][i] = 1;
             Fb[0] = p_BA_G % Fb[1]; // r X F (9 flops)
             rep.multiplyBySystemJacobianTranspose(state,F_G,col);// 18nb+11nu flops
-            for (int r=0; r < nu; ++r) row[r][1][i] = col[r]; 
+            for (int r=0; r < nu; ++r) JF_G(task,r)[1][i] = col[r]; 
             Fb[1][i] = 0;
             Fb[0] = 0;
         }
@@ -1753,8 +1768,10 @@ void SimbodyMatterSubsystem::calcFrameJacobian
     // We're assuming that 6*nt << nu so that it is cheaper to calculate ~JF
     // than JF, using ~J*F rather than J*u.
     // TODO: check dimensions and use whichever method is cheaper.
-    Vector_<SpatialVec> F_G(nb); F_G.setToZero();
-    Vector col(nu); // temporary to hold column of ~J_G
+    ScratchVector_<SpatialVec> scratchF_G(nb);
+    ScratchVector scratchCol(nu); // temporary to hold column of ~J_G
+    Vector_<SpatialVec>& F_G = *scratchF_G; F_G.setToZero();
+    Vector& col = *scratchCol;
     for (int task=0; task < nt; ++task) {
         const MobilizedBodyIndex mobodx = onBodyB[task];
         SimTK_INDEXCHECK(mobodx, nb,
@@ -1770,7 +1787,7 @@ void SimbodyMatterSubsystem::calcFrameJacobian
         for (int i=0; i < 3; ++i) {
             Fb[0][i] = 1;
             rep.multiplyBySystemJacobianTranspose(state,F_G,col);// 18nb+11nu flops
-            JF_G[6*task + i] = ~col;
+            for (int r=0; r < nu; ++r) JF_G(6*task + i, r) = col[r];
             Fb[0][i] = 0;
         }
 
@@ -1779,7 +1796,7 @@ void SimbodyMatterSubsystem::calcFrameJacobian
             Fb[1][i] = 1;
             Fb[0] = p_BA_G % Fb[1]; // r X F (9 flops)
             rep.multiplyBySystemJacobianTranspose(state,F_G,col);// 18nb+11nu flops
-            JF_G[6*task + 3 + i] = ~col;
+            for (int r=0; r < nu; ++r) JF_G(6*task + 3 + i, r) = col[r];
             Fb[1][i] = 0;
             Fb[0] = 0;
         }
@@ -34,6 +34,7 @@
 #include "MultibodySystemRep.h"
 #include "MobilizedBodyImpl.h"
 #include "ConstraintImpl.h"
+#include "ScratchMemory.h"
 
 #include <string>
 #include <iostream>
@@ -2389,11 +2390,12 @@ multiplyByPVATranspose( const State&     s,
     if (nu==0) return;
     if (m==0) {allfuVector.setToZero(); return;}
 
-    // Allocate a temporary body forces vector here. We'll map these to 
+    // Borrow a temporary body forces vector here. We'll map these to 
     // generalized forces as the penultimate step, then add those into 
     // the output argument allfuVector which will have already accumulated 
     // all directly-generated mobility forces.
-    Vector_<SpatialVec> allF_GVector(nb);
+    ScratchVector_<SpatialVec> scratchF_G(nb);
+    Vector_<SpatialVec>& allF_GVector = *scratchF_G;
 
     // We'll be accumulating constraint forces into these Vectors so zero 
     // them now. Multiple constraints may contribute to forces on the same 
@@ -2416,13 +2418,16 @@ multiplyByPVATranspose( const State&     s,
     // These Arrays are for one constraint at a time. We need separate 
     // memory for these because constrained bodies and constrained u's are
     // not ordered the same as the global ones, nor are they necessarily
-    // contiguous in the global arrays. We're declaring these arrays
+    // contiguous in the global arrays. These are scratch arrays declared
     // outside the loop to avoid heap allocation -- they will grow to the
     // max size needed by any constraint, then get resized as needed without
-    // further heap allocation.
-    Array_<SpatialVec,ConstrainedBodyIndex> oneF_G; // body spatial forces
-    Array_<Real,      ConstrainedUIndex>    onefu;  // u-space generalized forces     
-    Array_<Real,      ConstrainedQIndex>    onefq;  // q-space generalized forces     
+    // further heap allocation, in this call or later ones.
+    ScratchArray_<SpatialVec,ConstrainedBodyIndex> scratchOneF_G; // body forces
+    ScratchArray_<Real,      ConstrainedUIndex>    scratchOnefu;  // u-space
+    ScratchArray_<Real,      ConstrainedQIndex>    scratchOnefq;  // q-space
+    Array_<SpatialVec,ConstrainedBodyIndex>& oneF_G = *scratchOneF_G;
+    Array_<Real,      ConstrainedUIndex>&    onefu  = *scratchOnefu;
+    Array_<Real,      ConstrainedQIndex>&    onefq  = *scratchOnefq;
 
     // Loop over all enabled constraints, ask them to generate forces, and
     // accumulate the results in the global problem arrays (allF_G,allfu).
@@ -2496,9 +2501,9 @@ multiplyByPVATranspose( const State&     s,
 
     // Map the body forces into u-space generalized forces.
     // 12*nu + 18*nb flops.
-    Vector ftmp(nu);
-    multiplyBySystemJacobianTranspose(s, allF_GVector, ftmp);
-    allfuVector += ftmp;
+    ScratchVector ftmp(nu);
+    multiplyBySystemJacobianTranspose(s, allF_GVector, *ftmp);
+    allfuVector += *ftmp;
 }
 
 
@@ -2567,11 +2572,11 @@ multiplyByPqTranspose(  const State&     state,
                         const Vector&    lambdap,
                         Vector&          fq) const
 {
-    Vector fu;
+    ScratchVector fu(getNU(state));
     // Calculate fu = ~P*lambdap.
-    multiplyByPVATranspose(state, true, false, false, lambdap, fu);
+    multiplyByPVATranspose(state, true, false, false, lambdap, *fu);
     // Calculate fq = ~(N^-1) * fu = ~(~fu * N^-1)
-    multiplyByNInv(state, true/*transpose*/,fu,fq);
+    multiplyByNInv(state, true/*transpose*/,*fu,fq);
 }
 
 
@@ -2825,16 +2830,20 @@ calcBiasForMultiplyByPVA(const State& s,
     // or acceleration-only Constraint in turn; we're declaring it outside the 
     // loop to minimize heap allocation (resizing down doesn't normally free 
     // heap space). This won't be used if we have only holonomic constraints.
-    Array_<SpatialVec,ConstrainedBodyIndex> AC_AB;
+    ScratchArray_<SpatialVec,ConstrainedBodyIndex> scratchAC_AB;
+    Array_<SpatialVec,ConstrainedBodyIndex>& AC_AB = *scratchAC_AB;
 
     // Subarrays of these all-zero arrays will be used to supply zero body
     // velocities and qdots (holonomic) or zero udots (nonholonomic and
     // acceleration-only) for each Constraint in turn; we're declaring 
     // them outside the loop to minimize heap allocation. They'll grow until 
     // they hit the maximum size needed by any Constraint.
-    Array_<SpatialVec,ConstrainedBodyIndex> zeroV_AB;
-    Array_<Real,      ConstrainedQIndex>    zeroQDot;
-    Array_<Real,      ConstrainedUIndex>    zeroUDot;
+    ScratchArray_<SpatialVec,ConstrainedBodyIndex> scratchZeroV_AB;
+    ScratchArray_<Real,      ConstrainedQIndex>    scratchZeroQDot;
+    ScratchArray_<Real,      ConstrainedUIndex>    scratchZeroUDot;
+    Array_<SpatialVec,ConstrainedBodyIndex>& zeroV_AB = *scratchZeroV_AB;
+    Array_<Real,      ConstrainedQIndex>&    zeroQDot = *scratchZeroQDot;
+    Array_<Real,      ConstrainedUIndex>&    zeroUDot = *scratchZeroUDot;
 
     // Loop over all enabled constraints, ask them to generate constraint
     // errors, and collect those in the output bias vector.
@@ -2981,15 +2990,18 @@ calcBiasForAccelerationConstraints(const State& s,
     // turn; we're declaring it outside the 
     // loop to minimize heap allocation (resizing down doesn't normally free 
     // heap space).
-    Array_<SpatialVec,ConstrainedBodyIndex> AC_AB;
+    ScratchArray_<SpatialVec,ConstrainedBodyIndex> scratchAC_AB;
+    Array_<SpatialVec,ConstrainedBodyIndex>& AC_AB = *scratchAC_AB;
 
     // Subarrays of these all-zero arrays will be used to supply zero qdotdots
     // (holonomic) or zero udots (nonholonomic and
     // acceleration-only) for each Constraint in turn; we're declaring 
     // them outside the loop to minimize heap allocation. They'll grow until 
     // they hit the maximum size needed by any Constraint.
-    Array_<Real,      ConstrainedQIndex>    zeroQDotDot;
-    Array_<Real,      ConstrainedUIndex>    zeroUDot;
+    ScratchArray_<Real,      ConstrainedQIndex>    scratchZeroQDotDot;
+    ScratchArray_<Real,      ConstrainedUIndex>    scratchZeroUDot;
+    Array_<Real,      ConstrainedQIndex>&    zeroQDotDot = *scratchZeroQDotDot;
+    Array_<Real,      ConstrainedUIndex>&    zeroUDot    = *scratchZeroUDot;
 
     // Loop over all enabled constraints, ask them to generate constraint
     // errors, and collect those in the output bias vector.
@@ -3114,8 +3126,10 @@ multiplyByPq(const State&   s,
 
     // Generate a u-like Vector via ulike = N^-1 * qlike. Then use that to
     // calculate spatial velocities V_GB = J * ulike.
-    Vector ulike(nu);
-    Vector_<SpatialVec> V_GB(nb);
+    ScratchVector scratchULike(nu);
+    ScratchVector_<SpatialVec> scratchV_GB(nb);
+    Vector&              ulike = *scratchULike;
+    Vector_<SpatialVec>& V_GB  = *scratchV_GB;
     multiplyByNInv(s, false, qlike, ulike);   // cheap
     multiplyBySystemJacobian(s, ulike, V_GB); // 12*(nu+nb) flops
 
@@ -3131,9 +3145,11 @@ multiplyByPq(const State&   s,
     // velocities for the constrained bodies of each Constraint in turn; 
     // we're declaring it outside the loop to minimize heap allocation 
     // (resizing down doesn't normally free heap space).
-    Array_<SpatialVec,ConstrainedBodyIndex> V_AB;
+    ScratchArray_<SpatialVec,ConstrainedBodyIndex> scratchV_AB;
+    Array_<SpatialVec,ConstrainedBodyIndex>& V_AB = *scratchV_AB;
     // Same, but for each constraint's qdot subset.
-    Array_<Real,ConstrainedQIndex> qdot;
+    ScratchArray_<Real,ConstrainedQIndex> scratchQDot;
+    Array_<Real,ConstrainedQIndex>& qdot = *scratchQDot;
 
     // Loop over all enabled constraints, ask them to generate constraint
     // errors, and collect those in the output vector, subtracting off the bias
@@ -3285,7 +3301,8 @@ multiplyByPVA(  const State&     s,
     // body spatial accelerations A=J*udot + Jdot*u, depending on how we're
     // interpreting the ulike argument (as a u for holonomic constraints,
     // and as udot for everything else).
-    Vector_<SpatialVec> Julike(nb);
+    ScratchVector_<SpatialVec> scratchJulike(nb);
+    Vector_<SpatialVec>& Julike = *scratchJulike;
     multiplyBySystemJacobian(s, ulike, Julike); // 12*(nu+nb) flops
 
     // Julike serves as V_GB when we're interpreting ulike as u.
@@ -3294,10 +3311,11 @@ multiplyByPVA(  const State&     s,
 
     // If we're doing any nonholonomic or acceleration-only constraints, we'll 
     // finish calculating body spatial accelerations and put them here.
-    Array_<SpatialVec,MobilizedBodyIndex> allA_GB;
+    ScratchArray_<SpatialVec,MobilizedBodyIndex> scratchA_GB;
+    Array_<SpatialVec,MobilizedBodyIndex>& allA_GB = *scratchA_GB;
     if (mNonholo || mAccOnly) {
         allA_GB.resize(nb);
-        const Array_<SpatialVec>& 
+        const Array_<SpatialVec,MobilizedBodyIndex>& 
             allAC_GB = getTreeVelocityCache(s).totalCoriolisAcceleration;
         for (MobilizedBodyIndex b(0); b < nb; ++b)
             allA_GB[b] = allV_GB[b] + allAC_GB[b]; // i.e., J*udot + Jdot*u
@@ -3306,7 +3324,8 @@ multiplyByPVA(  const State&     s,
     // If we're going to be dealing with holonomic (position) constraints,
     // generate a q-like Vector via qlike = N * ulike since the position
     // error derivative routine wants qdots.
-    Vector qlike(nq);
+    ScratchVector scratchQLike(nq);
+    Vector& qlike = *scratchQLike;
     if (mHolo)
         multiplyByN(s, false, ulike, qlike);   // cheap
 
@@ -3322,17 +3341,21 @@ multiplyByPVA(  const State&     s,
     // turn; we're declaring it outside the loop to minimize heap allocation 
     // (resizing down doesn't normally free heap space). This won't be used 
     // if we aren't processing holonomic constraints.
-    Array_<SpatialVec,ConstrainedBodyIndex> V_AB;
+    ScratchArray_<SpatialVec,ConstrainedBodyIndex> scratchV_AB;
+    Array_<SpatialVec,ConstrainedBodyIndex>& V_AB = *scratchV_AB;
     // Same, but for each holonomic constraint's qdot subset.
-    Array_<Real,ConstrainedQIndex> qdot;
+    ScratchArray_<Real,ConstrainedQIndex> scratchQDot;
+    Array_<Real,ConstrainedQIndex>& qdot = *scratchQDot;
 
     // This array will be resized and filled with the Ancestor-relative
     // accelerations for the constrained bodies of each velocity
     // or acceleration-only Constraint in turn. This won't be used if we have 
     // only holonomic constraints.
-    Array_<SpatialVec,ConstrainedBodyIndex> A_AB;
+    ScratchArray_<SpatialVec,ConstrainedBodyIndex> scratchA_AB;
+    Array_<SpatialVec,ConstrainedBodyIndex>& A_AB = *scratchA_AB;
     // Same, but for each nonholonomic/acconly constraint's udot subset.
-    Array_<Real,ConstrainedUIndex> udot;
+    ScratchArray_<Real,ConstrainedUIndex> scratchUDot;
+    Array_<Real,ConstrainedUIndex>& udot = *scratchUDot;
 
     // Loop over all enabled constraints, ask them to generate constraint
     // errors, and collect those in the output argument PVAu. Remove bias
@@ -3525,40 +3548,107 @@ calcGMInvGt(const State&   s,
     GMInvGt.resize(m,m);
     if (m==0) return;
 
-    // If the output matrix doesn't have columns in contiguous memory, we'll
-    // allocate a contiguous-memory temp that we can use to hold one column
-    // at a time as we compute them.
-    const bool columnsAreContiguous = GMInvGt(0).hasContiguousData();
-    Vector GMInvGt_j(columnsAreContiguous ? 0 : m);
-
-    // These two temporaries are always needed to hold one column of Gt,
-    // then one column of M^-1 * Gt.
-    Vector Gtcol(nu), MInvGtcol(nu);
+    // These temporaries hold one column of Gt, then one column of M^-1 * Gt,
+    // then one column of G M^-1 Gt. We copy the last one into the output
+    // element by element since even a column view would cost a heap
+    // allocation.
+    ScratchVector scratchGtcol(nu), scratchMInvGtcol(nu), scratchCol(m);
+    Vector& Gtcol = *scratchGtcol; Vector& MInvGtcol = *scratchMInvGtcol;
+    Vector& col = *scratchCol;
 
     // Precalculate bias so we can perform multiplication by G efficiently.
-    Vector bias(m);
+    ScratchVector scratchBias(m);
+    Vector& bias = *scratchBias;
     calcBiasForMultiplyByPVA(s,true,true,true,bias);
    
     // Lambda is used to pluck out one column at a time of Gt. Exactly one
     // element at a time of lambda will be 1, the rest are 0.
-    Vector lambda(m, Real(0));
+    ScratchVector scratchLambda(m);
+    Vector& lambda = *scratchLambda;
+    lambda.setToZero();
 
     for (int j=0; j < m; ++j) {
         lambda[j] = 1;
         multiplyByPVATranspose(s, true, true, true, lambda, Gtcol);
         lambda[j] = 0;
         multiplyByMInv(s, Gtcol, MInvGtcol);
-        if (columnsAreContiguous)
-            multiplyByPVA(s, true, true, true, bias, MInvGtcol, GMInvGt(j));
-        else {
-            multiplyByPVA(s, true, true, true, bias, MInvGtcol, GMInvGt_j);
-            GMInvGt(j) = GMInvGt_j;
-        }
+        multiplyByPVA(s, true, true, true, bias, MInvGtcol, col);
+        for (int i=0; i < m; ++i)
+            GMInvGt(i,j) = col[i];
     }
 } 
 
 
 
+//==============================================================================
+//                          CALC G M^-1 ~G BLOCKS
+//==============================================================================
+// When the multipliers can be split into groups that have no coupling with one
+// another (for example, constraints acting on different free bodies) we can
+// form the diagonal blocks for all the groups at once by plucking out one 
+// column from every group in each pass. The nonzeros of ~G*lambda for 
+// different groups then involve disjoint mobilities, and so do their 
+// M^-1*~G*lambda, so we can read each group's column from the rows that 
+// belong to that group.
+//
+// Complexity is O(k*n + m*k) where k is the size of the largest group; 
+// storage is O(sum of squared group sizes) rather than O(m^2).
+void SimbodyMatterSubsystemRep::
+calcGMInvGtBlocks(const State&                           s,
+                  const Array_<Array_<MultiplierIndex> >& groups,
+                  Array_<Matrix>&                        blocks) const
+{
+    const SBInstanceCache& ic = getInstanceCache(s);
+
+    // Global problem dimensions.
+    const int mHolo    = ic.totalNHolonomicConstraintEquationsInUse;
+    const int mNonholo = ic.totalNNonholonomicConstraintEquationsInUse;
+    const int mAccOnly = ic.totalNAccelerationOnlyConstraintEquationsInUse;
+    const int m        = mHolo+mNonholo+mAccOnly;  
+    const int nu       = getNU(s);
+
+    const int ng = (int)groups.size();
+    blocks.resize(ng);
+    int maxSize = 0;
+    for (int g=0; g < ng; ++g) {
+        const int sz = (int)groups[g].size();
+        blocks[g].resize(sz, sz);
+        maxSize = std::max(maxSize, sz);
+    }
+    if (maxSize == 0) return;
+
+    ScratchVector scratchGtcol(nu), scratchMInvGtcol(nu), scratchCol(m);
+    Vector& Gtcol = *scratchGtcol; Vector& MInvGtcol = *scratchMInvGtcol;
+    Vector& col = *scratchCol;
+    ScratchVector scratchBias(m);
+    Vector& bias = *scratchBias;
+    calcBiasForMultiplyByPVA(s,true,true,true,bias);
+    ScratchVector scratchLambda(m);
+    Vector& lambda = *scratchLambda;
+    lambda.setToZero();
+
+    for (int j=0; j < maxSize; ++j) {
+        for (int g=0; g < ng; ++g)
+            if (j < (int)groups[g].size()) {
+                assert(0 <= groups[g][j] && groups[g][j] < m);
+                lambda[groups[g][j]] = 1;
+            }
+        multiplyByPVATranspose(s, true, true, true, lambda, Gtcol);
+        multiplyByMInv(s, Gtcol, MInvGtcol);
+        multiplyByPVA(s, true, true, true, bias, MInvGtcol, col);
+        for (int g=0; g < ng; ++g) {
+            const Array_<MultiplierIndex>& group = groups[g];
+            if (j >= (int)group.size()) continue;
+            lambda[group[j]] = 0;
+            Matrix& block = blocks[g];
+            for (int i=0; i < (int)group.size(); ++i)
+                block(i,j) = col[group[i]];
+        }
+    }
+}
+
+
+
 // =============================================================================
 //                     SOLVE FOR CONSTRAINT IMPULSES
 // =============================================================================
@@ -3691,9 +3781,12 @@ calcConstraintAccelerationErrors
     // These arrays will be resized and filled with the input needs of each 
     // Constraint in turn. We're declaring them outside the loop to minimize 
     // heap allocation (resizing down doesn't normally free heap space). 
-    Array_<SpatialVec,ConstrainedBodyIndex> A_AB;
-    Array_<Real,ConstrainedQIndex> qdd; // holonomic only
-    Array_<Real,ConstrainedUIndex> ud;  // nonholonomic or acc-only
+    ScratchArray_<SpatialVec,ConstrainedBodyIndex> scratchA_AB;
+    ScratchArray_<Real,ConstrainedQIndex> scratchQdd;
+    ScratchArray_<Real,ConstrainedUIndex> scratchUd;
+    Array_<SpatialVec,ConstrainedBodyIndex>& A_AB = *scratchA_AB;
+    Array_<Real,ConstrainedQIndex>& qdd = *scratchQdd; // holonomic only
+    Array_<Real,ConstrainedUIndex>& ud  = *scratchUd;  // nonholo or acc-only
 
     // Loop over all enabled constraints, ask them to generate constraint
     // errors, and collect those in the output argument pvaerr.
@@ -5377,8 +5470,8 @@ void SimbodyMatterSubsystemRep::multiplyByMInv(const State& s,
     assert(MInvf.hasContiguousData());
 
     // Temporaries
-    Array_<Real>        eps(nu);
-    Array_<SpatialVec>  z(nb), zPlus(nb), A_GB(nb);
+    ScratchArray_<Real>        eps(nu);
+    ScratchArray_<SpatialVec>  z(nb), zPlus(nb), A_GB(nb);
 
     // Point to raw data of input arguments.
     const Real* fPtr     = &f[0];       
@@ -5388,14 +5481,14 @@ void SimbodyMatterSubsystemRep::multiplyByMInv(const State& s,
         for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
             node.multiplyByMInvPass1Inward(ic,tpc,abc,
-                fPtr, z.begin(), zPlus.begin(), eps.begin());
+                fPtr, z->begin(), zPlus->begin(), eps->begin());
         }
 
     for (int i=0 ; i<(int)rbNodeLevels.size() ; i++)
         for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
             node.multiplyByMInvPass2Outward(ic,tpc,abc, 
-                eps.cbegin(), A_GB.begin(), MInvfPtr);
+                eps->cbegin(), A_GB->begin(), MInvfPtr);
         }
 }
 //............................. CALC M INVERSE F ...............................
@@ -5427,7 +5520,7 @@ void SimbodyMatterSubsystemRep::multiplyByM(const State&    s,
     assert(Ma.hasContiguousData());
 
     // Temporaries
-    Array_<SpatialVec>  fTmp(nb), A_GB(nb);
+    ScratchArray_<SpatialVec>  fTmp(nb), A_GB(nb);
 
     // Point to raw data of input arguments.
     const Real* aPtr    = &a[0];       
@@ -5436,13 +5529,14 @@ void SimbodyMatterSubsystemRep::multiplyByM(const State&    s,
     for (int i=0 ; i<(int)rbNodeLevels.size() ; i++)
         for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
-            node.multiplyByMPass1Outward(tpc, aPtr, A_GB.begin());
+            node.multiplyByMPass1Outward(tpc, aPtr, A_GB->begin());
         }
 
     for (int i=rbNodeLevels.size()-1 ; i>=0 ; i--) 
         for (int j=0 ; j<(int)rbNodeLevels[i].size() ; j++) {
             const RigidBodyNode& node = *rbNodeLevels[i][j];
-            node.multiplyByMPass2Inward(tpc,A_GB.cbegin(),fTmp.begin(),MaPtr);
+            node.multiplyByMPass2Inward(tpc,A_GB->cbegin(),fTmp->begin(),
+                                        MaPtr);
         }
 }
 
@@ -5547,10 +5641,11 @@ void SimbodyMatterSubsystemRep::calcTreeResidualForces(const State& s,
     const Vector_<SpatialVec>* pAppliedBodyForces = &appliedBodyForces;
     const Vector*              pKnownUdot         = &knownUdot;
 
-    Vector              zeroPerMobility;
-    Vector_<SpatialVec> zeroPerBody;
+    ScratchVector              scratchZeroPerMobility;
+    ScratchVector_<SpatialVec> scratchZeroPerBody;
     if (appliedMobilityForces.size()==0 || knownUdot.size()==0) {
-        zeroPerMobility.resize(getNumMobilities());
+        Vector& zeroPerMobility = 
+            scratchZeroPerMobility.borrow(getNumMobilities());
         zeroPerMobility = 0;
         if (appliedMobilityForces.size()==0) 
             pAppliedMobForces = &zeroPerMobility;
@@ -5558,7 +5653,8 @@ void SimbodyMatterSubsystemRep::calcTreeResidualForces(const State& s,
             pKnownUdot        = &zeroPerMobility;
     }
     if (appliedBodyForces.size()==0) {
-        zeroPerBody.resize(getNumBodies());
+        Vector_<SpatialVec>& zeroPerBody = 
+            scratchZeroPerBody.borrow(getNumBodies());
         zeroPerBody = SpatialVec(Vec3(0),Vec3(0));
         pAppliedBodyForces = &zeroPerBody;
     }
@@ -5584,8 +5680,9 @@ void SimbodyMatterSubsystemRep::calcTreeResidualForces(const State& s,
     assert(residualMobilityForces.hasContiguousData());
 
 
-    // Allocate temporary.
-    Vector_<SpatialVec> allFTmp(getNumBodies());
+    // Borrow temporary.
+    ScratchVector_<SpatialVec> scratchFTmp(getNumBodies());
+    Vector_<SpatialVec>& allFTmp = *scratchFTmp;
 
     // Make pointers to (contiguous) Vector data for fast access.
     const Real* knownUdotPtr = &(*pKnownUdot)[0];
@@ -6335,7 +6432,8 @@ void SimbodyMatterSubsystemRep::multiplyBySystemJacobianTranspose
 
     const SBTreePositionCache& tpc = getTreePositionCache(s);
 
-    Vector_<SpatialVec> zTemp(getNumBodies()); zTemp.setToZero();
+    ScratchVector_<SpatialVec> scratchZ(getNumBodies());
+    Vector_<SpatialVec>& zTemp = *scratchZ; zTemp.setToZero();
     const SpatialVec* xPtr = X.size() ? &X[0] : NULL;
     Real* jtxPtr = JtX.size() ? &JtX[0] : NULL;
     SpatialVec* zPtr = zTemp.size() ? &zTemp[0] : NULL;
@@ -6371,7 +6469,8 @@ void SimbodyMatterSubsystemRep::calcTreeEquivalentMobilityForces(const State& s,
     assert(bodyForces.hasContiguousData());
     assert(mobilityForces.hasContiguousData());
 
-    Vector_<SpatialVec> allZ(getNumBodies());
+    ScratchVector_<SpatialVec> scratchZ(getNumBodies());
+    Vector_<SpatialVec>& allZ = *scratchZ;
     const SpatialVec* bodyForcePtr = bodyForces.size() ? &bodyForces[0] : NULL;
     Real* mobilityForcePtr = mobilityForces.size() ? &mobilityForces[0] : NULL;
     SpatialVec* zPtr = allZ.size() ? &allZ[0] : NULL;
@@ -937,6 +937,15 @@ public:
     void calcGMInvGt(const State&   state,
                      Matrix&        GMInvGt) const;
 
+    // Calculate only the diagonal blocks of G * M^-1 * G^T that correspond
+    // to the given groups of multipliers, which must be mutually uncoupled.
+    // One column of each block is obtained from each application of the
+    // O(n) operators, so the cost is O(k*n) where k is the size of the
+    // largest group.
+    void calcGMInvGtBlocks(const State&                           state,
+                           const Array_<Array_<MultiplierIndex> >& groups,
+                           Array_<Matrix>&                        blocks) const;
+
     // Use factored GMInvGt to solve GMinvGt*impulse=deltaV. The main benefit
     // of this method is that it promises to use the same method Simbody does
     // to deal with constraint redundancies.
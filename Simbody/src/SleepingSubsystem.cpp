@@ -0,0 +1,561 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+#include "SimTKcommon.h"
+#include "simbody/internal/common.h"
+#include "simbody/internal/MultibodySystem.h"
+#include "simbody/internal/SimbodyMatterSubsystem.h"
+#include "simbody/internal/MobilizedBody.h"
+#include "simbody/internal/Constraint.h"
+#include "simbody/internal/ContactTrackerSubsystem.h"
+#include "simbody/internal/SleepingSubsystem.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace SimTK;
+
+namespace {
+// The bounding sphere of one contact surface, fixed in its body's frame.
+struct SleepBubble {
+    MobilizedBodyIndex  mobod;
+    Vec3                center_B;
+    Real                radius;
+};
+
+// A pair of bubbles whose bounding spheres are separated by gap.
+struct NearbyBubbles {
+    NearbyBubbles(int i, int j, Real gap) : i(i), j(j), gap(gap) {}
+    int i, j; Real gap;
+};
+}
+
+namespace SimTK {
+
+//==============================================================================
+//                       SLEEPING SUBSYSTEM :: IMPL
+//==============================================================================
+class SleepingSubsystem::Impl : public Subsystem::Guts {
+public:
+explicit Impl(const ContactTrackerSubsystem* tracker)
+:   m_tracker(tracker), m_linThreshold(Real(0.01)),
+    m_angThreshold(Real(0.05)), m_sleepDelay(Real(0.5)),
+    m_checkInterval(Real(0.1)), m_wakeMargin(Real(0.01)),
+    m_checkHandler(0) {}
+
+Impl* cloneImpl() const override
+{   return new Impl(*this); }
+
+const MultibodySystem& getMultibodySystem() const
+{   return MultibodySystem::downcast(getSystem()); }
+const SimbodyMatterSubsystem& getMatterSubsystem() const
+{   return getMultibodySystem().getMatterSubsystem(); }
+
+// Island number for each mobilized body, or -1 if awake.
+const Array_<int,MobilizedBodyIndex>& getIslands(const State& s) const {
+    return Value<Array_<int,MobilizedBodyIndex> >::downcast
+        (getDiscreteVariable(s, m_islandsIx));
+}
+Array_<int,MobilizedBodyIndex>& updIslands(State& s) const {
+    return Value<Array_<int,MobilizedBodyIndex> >::updDowncast
+        (updDiscreteVariable(s, m_islandsIx));
+}
+// For base bodies only, the time at which the subtree was last seen to come
+// to rest, or NaN if it was moving at the last check.
+const Array_<Real,MobilizedBodyIndex>& getSlowSince(const State& s) const {
+    return Value<Array_<Real,MobilizedBodyIndex> >::downcast
+        (getDiscreteVariable(s, m_slowSinceIx));
+}
+Array_<Real,MobilizedBodyIndex>& updSlowSince(State& s) const {
+    return Value<Array_<Real,MobilizedBodyIndex> >::updDowncast
+        (updDiscreteVariable(s, m_slowSinceIx));
+}
+
+int realizeSubsystemTopologyImpl(State& state) const override {
+    // Briefly allow writing into the Topology cache; after this the
+    // Topology cache is const.
+    Impl* wThis = const_cast<Impl*>(this);
+
+    const SimbodyMatterSubsystem& matter = getMatterSubsystem();
+    const int nb = matter.getNumBodies();
+
+    wThis->m_base.resize(nb);
+    wThis->m_bubbles.clear();
+    wThis->m_base[MobilizedBodyIndex(0)] = MobilizedBodyIndex(0);
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        const MobilizedBody& mobod = matter.getMobilizedBody(mbx);
+        wThis->m_base[mbx] =
+            mobod.getBaseMobilizedBody().getMobilizedBodyIndex();
+        const Body& body = mobod.getBody();
+        for (int i=0; i < body.getNumContactSurfaces(); ++i) {
+            SleepBubble bubble;
+            Vec3 center_S;
+            body.getContactSurface(i).getShape()
+                .getBoundingSphere(center_S, bubble.radius);
+            if (!isFinite(bubble.radius))
+                continue; // e.g. a half space; can't wake anything
+            bubble.mobod    = mbx;
+            bubble.center_B = body.getContactSurfaceTransform(i) * center_S;
+            wThis->m_bubbles.push_back(bubble);
+        }
+    }
+
+    wThis->m_islandsIx = allocateDiscreteVariable(state, Stage::Instance,
+        new Value<Array_<int,MobilizedBodyIndex> >
+            (Array_<int,MobilizedBodyIndex>(nb, -1)));
+    wThis->m_slowSinceIx = allocateDiscreteVariable(state, Stage::Report,
+        new Value<Array_<Real,MobilizedBodyIndex> >
+            (Array_<Real,MobilizedBodyIndex>(nb, NaN)));
+    // The wake witness is calculated at most once per realization of the
+    // positions, and only if someone asks for it.
+    wThis->m_wakeWitnessIx = allocateLazyCacheEntry(state, Stage::Position,
+        new Value<Real>(NaN));
+    return 0;
+}
+
+// Find the pairs of bubbles on different bodies for which the first body is
+// awake, the second is not Ground, and the gap between them is less than
+// range. We sweep along x as the ContactTrackerSubsystem does. The centers
+// are those of all the bubbles.
+void findNearbyBubbles(const Array_<int,MobilizedBodyIndex>& islands,
+                       const Array_<Vec3>& centers, Real range,
+                       Array_<NearbyBubbles>& nearby) const {
+    nearby.clear();
+    const int n = (int)m_bubbles.size();
+    Array_<std::pair<Real,int> > starts; starts.reserve(n);
+    for (int i=0; i < n; ++i)
+        starts.push_back(std::make_pair(centers[i][0]-m_bubbles[i].radius,i));
+    std::sort(starts.begin(), starts.end());
+
+    for (int k1=0; k1 < n; ++k1) {
+        const int i = starts[k1].second;
+        const Real end1 = centers[i][0] + m_bubbles[i].radius + range;
+        for (int k2=k1+1; k2 < n && starts[k2].first <= end1; ++k2) {
+            const int j = starts[k2].second;
+            const MobilizedBodyIndex mi = m_bubbles[i].mobod,
+                                     mj = m_bubbles[j].mobod;
+            if (mi == mj || (islands[mi] >= 0 && islands[mj] >= 0))
+                continue; // same body, or neither one awake
+            const Real gap = (centers[i]-centers[j]).norm()
+                             - m_bubbles[i].radius - m_bubbles[j].radius;
+            if (gap >= range) continue;
+            if (islands[mi] < 0) nearby.push_back(NearbyBubbles(i, j, gap));
+            else                 nearby.push_back(NearbyBubbles(j, i, gap));
+        }
+    }
+}
+
+void calcBubbleCenters(const State& state, Array_<Vec3>& centers) const {
+    const SimbodyMatterSubsystem& matter = getMatterSubsystem();
+    centers.resize(m_bubbles.size());
+    for (unsigned i=0; i < m_bubbles.size(); ++i)
+        centers[i] = matter.getMobilizedBody(m_bubbles[i].mobod)
+                           .getBodyTransform(state) * m_bubbles[i].center_B;
+}
+
+// This is the witness function for the wake event, calculated once per
+// realization of the positions. We must already have been realized through
+// Position stage to use the cached value.
+Real getWakeWitness(const State& state) const {
+    if (!isCacheValueRealized(state, m_wakeWitnessIx)) {
+        Value<Real>::updDowncast(updCacheEntry(state, m_wakeWitnessIx)) =
+            calcWakeWitness(state);
+        markCacheValueRealized(state, m_wakeWitnessIx);
+    }
+    return Value<Real>::downcast(getCacheEntry(state, m_wakeWitnessIx));
+}
+
+// The wake witness is the smallest gap, less the wake margin, between a
+// moving bubble and a sleeping one; we don't look farther than the wake
+// margin so this is clamped to that value.
+Real calcWakeWitness(const State& state) const {
+    const Array_<int,MobilizedBodyIndex>& islands = getIslands(state);
+    if (std::find_if(islands.begin(), islands.end(),
+                     [](int island) {return island >= 0;}) == islands.end())
+        return m_wakeMargin; // nothing is asleep
+
+    Array_<Vec3> centers;
+    calcBubbleCenters(state, centers);
+    Array_<NearbyBubbles> nearby;
+    findNearbyBubbles(islands, centers, 2*m_wakeMargin, nearby);
+    Real witness = m_wakeMargin;
+    for (unsigned k=0; k < nearby.size(); ++k)
+        if (islands[m_bubbles[nearby[k].j].mobod] >= 0)
+            witness = std::min(witness, nearby[k].gap - m_wakeMargin);
+    return witness;
+}
+
+// Wake every island that has a bubble near an awake one. Bodies that wake up
+// may be near other sleeping islands so we repeat until nothing changes.
+void wakeApproachedIslands(State& state) const {
+    getSystem().realize(state, Stage::Position);
+    const Array_<int,MobilizedBodyIndex>& islands = getIslands(state);
+    Array_<Vec3> centers;
+    calcBubbleCenters(state, centers);
+    Array_<NearbyBubbles> nearby;
+    bool wokeSome = true;
+    while (wokeSome) {
+        wokeSome = false;
+        findNearbyBubbles(islands, centers, Real(1.5)*m_wakeMargin, nearby);
+        for (unsigned k=0; k < nearby.size(); ++k) {
+            const int island = islands[m_bubbles[nearby[k].j].mobod];
+            if (island >= 0) {
+                wakeIsland(state, island);
+                wokeSome = true;
+            }
+        }
+    }
+}
+
+void wakeIsland(State& state, int island) const {
+    const SimbodyMatterSubsystem& matter = getMatterSubsystem();
+    Array_<int,MobilizedBodyIndex>& islands = updIslands(state);
+    Array_<Real,MobilizedBodyIndex>& slowSince = updSlowSince(state);
+    for (MobilizedBodyIndex mbx(1); mbx < islands.size(); ++mbx) {
+        if (islands[mbx] != island) continue;
+        islands[mbx] = -1;
+        slowSince[m_base[mbx]] = NaN;
+        matter.getMobilizedBody(mbx).unlock(state);
+        m_tracker->setBodyAsleep(state, mbx, false);
+    }
+}
+
+void wakeAll(State& state) const {
+    const Array_<int,MobilizedBodyIndex>& islands = getIslands(state);
+    for (MobilizedBodyIndex mbx(1); mbx < islands.size(); ++mbx)
+        if (islands[mbx] >= 0)
+            wakeIsland(state, islands[mbx]);
+}
+
+void putRestingIslandsToSleep(State& state) const;
+
+SimTK_DOWNCAST(Impl, Subsystem::Guts);
+
+    // TOPOLOGY STATE
+const ContactTrackerSubsystem*  m_tracker;
+Real                            m_linThreshold;
+Real                            m_angThreshold;
+Real                            m_sleepDelay;
+Real                            m_checkInterval;
+Real                            m_wakeMargin;
+// This is owned by the System.
+PeriodicEventHandler*           m_checkHandler;
+
+    // TOPOLOGY CACHE
+Array_<MobilizedBodyIndex,MobilizedBodyIndex>   m_base;
+Array_<SleepBubble>                             m_bubbles;
+DiscreteVariableIndex                           m_islandsIx;
+DiscreteVariableIndex                           m_slowSinceIx;
+CacheEntryIndex                                 m_wakeWitnessIx;
+};
+
+//------------------------------------------------------------------------------
+//                        PUT RESTING ISLANDS TO SLEEP
+//------------------------------------------------------------------------------
+// Islands are formed with union-find over the base bodies, joining those that
+// share a Constraint, an active contact, or (if already asleep) an island. An
+// island can sleep if every awake subtree in it has been at rest for the
+// sleep delay and can be locked. It mustn't then be near a moving body, or
+// the wake witness would start out negative and never trigger; since
+// neighboring islands may be going to sleep too we settle that iteratively.
+void SleepingSubsystem::Impl::putRestingIslandsToSleep(State& state) const {
+    const MultibodySystem& mbs = getMultibodySystem();
+    const SimbodyMatterSubsystem& matter = mbs.getMatterSubsystem();
+    mbs.realize(state, Stage::Velocity);
+
+    const Real t = state.getTime();
+    const int nb = matter.getNumBodies();
+    const Array_<int,MobilizedBodyIndex>& islands = getIslands(state);
+
+    // Find the awake subtrees that are at rest now and can be locked.
+    Array_<bool,MobilizedBodyIndex> slow(nb, true), lockable(nb, true);
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        if (islands[mbx] >= 0) continue;
+        const MobilizedBody& mobod = matter.getMobilizedBody(mbx);
+        const SpatialVec& V_GB = mobod.getBodyVelocity(state);
+        if (   V_GB[0].normSqr() > square(m_angThreshold)
+            || V_GB[1].normSqr() > square(m_linThreshold))
+            slow[m_base[mbx]] = false;
+        if (mobod.isLocked(state) || mobod.hasMotion())
+            lockable[m_base[mbx]] = false;
+    }
+
+    // Record when each subtree came to rest. This is a Report stage change.
+    const Array_<Real,MobilizedBodyIndex>& prevSlowSince = getSlowSince(state);
+    bool slowSinceChanged = false;
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        if (m_base[mbx] != mbx || islands[mbx] >= 0) continue;
+        if (slow[mbx] == isNaN(prevSlowSince[mbx]))
+        {   slowSinceChanged = true; break; }
+    }
+    if (slowSinceChanged) {
+        Array_<Real,MobilizedBodyIndex>& slowSince = updSlowSince(state);
+        for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+            if (m_base[mbx] != mbx || islands[mbx] >= 0) continue;
+            if (!slow[mbx])                 slowSince[mbx] = NaN;
+            else if (isNaN(slowSince[mbx])) slowSince[mbx] = t;
+        }
+    }
+    const Array_<Real,MobilizedBodyIndex>& slowSince = getSlowSince(state);
+
+    // Union-find over the base bodies.
+    Array_<MobilizedBodyIndex,MobilizedBodyIndex> parent(nb);
+    for (MobilizedBodyIndex mbx(0); mbx < nb; ++mbx) parent[mbx] = mbx;
+    auto findRoot = [&parent](MobilizedBodyIndex b) {
+        while (parent[b] != b) b = parent[b] = parent[parent[b]];
+        return b;
+    };
+    auto join = [&](MobilizedBodyIndex b1, MobilizedBodyIndex b2) {
+        if (b1 == 0 || b2 == 0) return; // Ground doesn't connect
+        parent[findRoot(m_base[b1])] = findRoot(m_base[b2]);
+    };
+
+    for (ConstraintIndex cx(0); cx < matter.getNumConstraints(); ++cx) {
+        const Constraint& constraint = matter.getConstraint(cx);
+        if (constraint.isDisabled(state)) continue;
+        MobilizedBodyIndex first;
+        for (ConstrainedBodyIndex cbx(0);
+             cbx < constraint.getNumConstrainedBodies(); ++cbx) {
+            const MobilizedBodyIndex mbx = constraint
+                .getMobilizedBodyFromConstrainedBody(cbx)
+                .getMobilizedBodyIndex();
+            if (mbx == 0) continue;
+            if (!first.isValid()) first = mbx; else join(first, mbx);
+        }
+        for (ConstrainedMobilizerIndex cmx(0);
+             cmx < constraint.getNumConstrainedMobilizers(); ++cmx) {
+            const MobilizedBodyIndex mbx = constraint
+                .getMobilizedBodyFromConstrainedMobilizer(cmx)
+                .getMobilizedBodyIndex();
+            if (mbx == 0) continue;
+            if (!first.isValid()) first = mbx; else join(first, mbx);
+        }
+    }
+
+    const ContactSnapshot& contacts = m_tracker->getActiveContacts(state);
+    for (int i=0; i < contacts.getNumContacts(); ++i) {
+        const Contact& contact = contacts.getContact(i);
+        if (contact.getCondition() == Contact::Broken) continue;
+        join(m_tracker->getMobilizedBody(contact.getSurface1())
+                                                .getMobilizedBodyIndex(),
+             m_tracker->getMobilizedBody(contact.getSurface2())
+                                                .getMobilizedBodyIndex());
+    }
+
+    Array_<MobilizedBodyIndex> islandMember(nb); // any body in each island
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        const int island = islands[mbx];
+        if (island < 0) continue;
+        if (!islandMember[island].isValid()) islandMember[island] = mbx;
+        else join(islandMember[island], mbx);
+    }
+
+    // Decide which groups (by root) are candidates for sleeping.
+    Array_<bool,MobilizedBodyIndex> candidate(nb, true), hasAwake(nb, false);
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        if (m_base[mbx] != mbx || islands[mbx] >= 0) continue;
+        const MobilizedBodyIndex root = findRoot(mbx);
+        hasAwake[root] = true;
+        if (!lockable[mbx] || isNaN(slowSince[mbx])
+            || t - slowSince[mbx] < m_sleepDelay)
+            candidate[root] = false;
+    }
+    for (MobilizedBodyIndex mbx(0); mbx < nb; ++mbx)
+        candidate[mbx] = candidate[mbx] && hasAwake[mbx];
+
+    // Rule out candidates near moving bodies that aren't candidates.
+    Array_<Vec3> centers;
+    calcBubbleCenters(state, centers);
+    Array_<NearbyBubbles> nearby;
+    findNearbyBubbles(islands, centers, m_wakeMargin, nearby);
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (unsigned k=0; k < nearby.size(); ++k) {
+            const MobilizedBodyIndex mi = m_bubbles[nearby[k].i].mobod,
+                                     mj = m_bubbles[nearby[k].j].mobod;
+            const MobilizedBodyIndex ri = findRoot(m_base[mi]),
+                                     rj = findRoot(m_base[mj]);
+            if (ri == rj) continue;
+            // mi is awake; mj may or may not be.
+            if (candidate[ri] && !candidate[rj] && islands[mj] < 0)
+            {   candidate[ri] = false; changed = true; }
+            else if (!candidate[ri] && candidate[rj])
+            {   candidate[rj] = false; changed = true; }
+        }
+    }
+
+    // Lock the newly sleeping bodies. An island is numbered by its root.
+    for (MobilizedBodyIndex mbx(1); mbx < nb; ++mbx) {
+        const MobilizedBodyIndex root = findRoot(m_base[mbx]);
+        if (!candidate[root]) continue;
+        Array_<int,MobilizedBodyIndex>& updislands = updIslands(state);
+        const bool wasAwake = updislands[mbx] < 0;
+        updislands[mbx] = (int)root;
+        if (!wasAwake) continue;
+        const MobilizedBody& mobod = matter.getMobilizedBody(mbx);
+        const int nu = mobod.getNumU(state);
+        if (nu) {
+            // A velocity lock doesn't change u so we have to zero it here,
+            // otherwise the integrator sees a jump in u at the next step.
+            for (int i=0; i < nu; ++i) mobod.setOneU(state, i, 0);
+            mobod.lockAt(state, Vector(nu, Real(0)), Motion::Velocity);
+        }
+        m_tracker->setBodyAsleep(state, mbx, true);
+    }
+}
+
+//==============================================================================
+//                          SLEEP EVENT HANDLERS
+//==============================================================================
+namespace {
+class SleepCheckHandler : public PeriodicEventHandler {
+public:
+    SleepCheckHandler(const SleepingSubsystem::Impl& impl, Real interval)
+    :   PeriodicEventHandler(interval), m_impl(impl) {}
+    void handleEvent(State& state, Real accuracy,
+                     bool& shouldTerminate) const override
+    {   m_impl.putRestingIslandsToSleep(state); }
+private:
+    const SleepingSubsystem::Impl& m_impl;
+};
+
+// The witness depends only on positions, but handlers are evaluated before
+// this subsystem has been realized to their stage. Asking for Velocity stage
+// means the witness can be taken from our Position stage cache.
+class WakeHandler : public TriggeredEventHandler {
+public:
+    explicit WakeHandler(const SleepingSubsystem::Impl& impl)
+    :   TriggeredEventHandler(Stage::Velocity), m_impl(impl)
+    {   getTriggerInfo().setTriggerOnRisingSignTransition(false); }
+    Real getValue(const State& state) const override
+    {   return m_impl.getWakeWitness(state); }
+    void handleEvent(State& state, Real accuracy,
+                     bool& shouldTerminate) const override
+    {   m_impl.wakeApproachedIslands(state); }
+private:
+    const SleepingSubsystem::Impl& m_impl;
+};
+}
+
+} // namespace SimTK
+
+//==============================================================================
+//                           SLEEPING SUBSYSTEM
+//==============================================================================
+
+bool SleepingSubsystem::isInstanceOf(const Subsystem& s) {
+    return Impl::isA(s.getSubsystemGuts());
+}
+const SleepingSubsystem& SleepingSubsystem::
+downcast(const Subsystem& s) {
+    assert(isInstanceOf(s));
+    return static_cast<const SleepingSubsystem&>(s);
+}
+SleepingSubsystem& SleepingSubsystem::
+updDowncast(Subsystem& s) {
+    assert(isInstanceOf(s));
+    return static_cast<SleepingSubsystem&>(s);
+}
+
+const SleepingSubsystem::Impl& SleepingSubsystem::
+getImpl() const {
+    return SimTK_DYNAMIC_CAST_DEBUG<const Impl&>(getSubsystemGuts());
+}
+SleepingSubsystem::Impl& SleepingSubsystem::
+updImpl() {
+    return SimTK_DYNAMIC_CAST_DEBUG<Impl&>(updSubsystemGuts());
+}
+
+SleepingSubsystem::SleepingSubsystem()
+{   adoptSubsystemGuts(new Impl(0)); }
+
+SleepingSubsystem::SleepingSubsystem(MultibodySystem& mbs,
+                                     ContactTrackerSubsystem& tracker)
+{   adoptSubsystemGuts(new Impl(&tracker));
+    mbs.adoptSubsystem(*this); // steal ownership
+    Impl& impl = updImpl();
+    impl.m_checkHandler = new SleepCheckHandler(impl, impl.m_checkInterval);
+    mbs.addEventHandler(impl.m_checkHandler);
+    mbs.addEventHandler(new WakeHandler(impl)); }
+
+SleepingSubsystem& SleepingSubsystem::
+setLinearVelocityThreshold(Real speed) {
+    SimTK_APIARGCHECK1_ALWAYS(speed >= 0, "SleepingSubsystem",
+        "setLinearVelocityThreshold", "Illegal speed %g.", speed);
+    updImpl().m_linThreshold = speed;
+    return *this;
+}
+SleepingSubsystem& SleepingSubsystem::
+setAngularVelocityThreshold(Real angularSpeed) {
+    SimTK_APIARGCHECK1_ALWAYS(angularSpeed >= 0, "SleepingSubsystem",
+        "setAngularVelocityThreshold", "Illegal angular speed %g.",
+        angularSpeed);
+    updImpl().m_angThreshold = angularSpeed;
+    return *this;
+}
+SleepingSubsystem& SleepingSubsystem::setSleepDelay(Real delay) {
+    SimTK_APIARGCHECK1_ALWAYS(delay >= 0, "SleepingSubsystem",
+        "setSleepDelay", "Illegal delay %g.", delay);
+    updImpl().m_sleepDelay = delay;
+    return *this;
+}
+SleepingSubsystem& SleepingSubsystem::setCheckInterval(Real interval) {
+    SimTK_APIARGCHECK1_ALWAYS(interval > 0, "SleepingSubsystem",
+        "setCheckInterval", "Illegal interval %g.", interval);
+    Impl& impl = updImpl();
+    impl.m_checkInterval = interval;
+    if (impl.m_checkHandler)
+        impl.m_checkHandler->setEventInterval(interval);
+    return *this;
+}
+SleepingSubsystem& SleepingSubsystem::setWakeMargin(Real margin) {
+    SimTK_APIARGCHECK1_ALWAYS(margin > 0, "SleepingSubsystem",
+        "setWakeMargin", "Illegal margin %g.", margin);
+    updImpl().m_wakeMargin = margin;
+    return *this;
+}
+
+Real SleepingSubsystem::getLinearVelocityThreshold() const
+{   return getImpl().m_linThreshold; }
+Real SleepingSubsystem::getAngularVelocityThreshold() const
+{   return getImpl().m_angThreshold; }
+Real SleepingSubsystem::getSleepDelay() const
+{   return getImpl().m_sleepDelay; }
+Real SleepingSubsystem::getCheckInterval() const
+{   return getImpl().m_checkInterval; }
+Real SleepingSubsystem::getWakeMargin() const
+{   return getImpl().m_wakeMargin; }
+
+bool SleepingSubsystem::
+isAsleep(const State& state, MobilizedBodyIndex mobod) const
+{   return getImpl().getIslands(state)[mobod] >= 0; }
+
+int SleepingSubsystem::getNumSleepingBodies(const State& state) const {
+    const Array_<int,MobilizedBodyIndex>& islands = getImpl().getIslands(state);
+    return (int)std::count_if(islands.begin(), islands.end(),
+                              [](int island) {return island >= 0;});
+}
+
+void SleepingSubsystem::wakeAll(State& state) const
+{   getImpl().wakeAll(state); }
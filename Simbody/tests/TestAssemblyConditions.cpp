@@ -0,0 +1,241 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Check the analytic error Jacobians of the Markers and OrientationSensors
+// assembly conditions against central differences of their errors, and
+// make sure that tracking a moving set of observations still works.
+
+#include "SimTKsimbody.h"
+#include "SimTKcommon/Testing.h"
+
+using namespace SimTK;
+using namespace std;
+
+struct MarkedChain {
+    MarkedChain() : matter(system) {
+        Body::Rigid body(MassProperties(1.0, Vec3(0), Inertia(1)));
+        links.push_back(MobilizedBody::Free(matter.Ground(), Vec3(0),
+                                            body, Vec3(0)));
+        links.push_back(MobilizedBody::Ball(links[0], Vec3(0,-.5,0),
+                                            body, Vec3(0,.5,0)));
+        links.push_back(MobilizedBody::Pin(links[1], Vec3(0,-.5,0),
+                                           body, Vec3(0,.5,0)));
+        system.realizeTopology();
+
+        markers = new Markers();
+        osensors = new OrientationSensors();
+        for (unsigned i=0; i < links.size(); ++i) {
+            const MobilizedBodyIndex mbx = links[i].getMobilizedBodyIndex();
+            markers->addMarker(mbx, Vec3(.1, .2*i, -.3));
+            markers->addMarker(mbx, Vec3(-.2, .1, .1*i));
+            osensors->addOSensor("", mbx, Rotation(Real(i), UnitVec3(1,1,0)));
+        }
+        Array_<Markers::MarkerIx> mOrder;
+        for (Markers::MarkerIx mx(0); mx < markers->getNumMarkers(); ++mx)
+            mOrder.push_back(mx);
+        markers->defineObservationOrder(mOrder);
+        Array_<OrientationSensors::OSensorIx> oOrder;
+        for (OrientationSensors::OSensorIx ox(0);
+             ox < osensors->getNumOSensors(); ++ox)
+            oOrder.push_back(ox);
+        osensors->defineObservationOrder(oOrder);
+    }
+
+    // A configuration depending on the parameter t.
+    State getState(Real t) const {
+        State state = system.getDefaultState();
+        for (int i=0; i < state.getNQ(); ++i)
+            state.updQ()[i] = Real(0.3)*std::sin(Real(i+1) + t);
+        system.realize(state, Stage::Position);
+        return state;
+    }
+
+    // Move all the observations to where the markers and sensors are in
+    // the given state.
+    void observe(const State& state) {
+        Markers::ObservationIx mox(0);
+        for (Markers::MarkerIx mx(0); mx < markers->getNumMarkers(); ++mx) {
+            const MobilizedBody& mobod =
+                matter.getMobilizedBody(markers->getMarkerBody(mx));
+            markers->moveOneObservation(mox++,
+                mobod.findStationLocationInGround(state,
+                                                  markers->getMarkerStation(mx)));
+        }
+        OrientationSensors::ObservationIx oox(0);
+        for (OrientationSensors::OSensorIx ox(0);
+             ox < osensors->getNumOSensors(); ++ox) {
+            const MobilizedBody& mobod =
+                matter.getMobilizedBody(osensors->getOSensorBody(ox));
+            osensors->moveOneObservation(oox++,
+                mobod.getBodyRotation(state)*osensors->getOSensorStation(ox));
+        }
+    }
+
+    MultibodySystem                 system;
+    SimbodyMatterSubsystem          matter;
+    Array_<MobilizedBody>           links;
+    Markers*                        markers;
+    OrientationSensors*             osensors;
+};
+
+// Compare the condition's analytic error Jacobian with central differences
+// of its errors, perturbing each free q of the Assembler's internal state.
+static void checkErrorJacobian(const Assembler& assembler,
+                               const AssemblyCondition& cond) {
+    const MultibodySystem& system = assembler.getMultibodySystem();
+    State state = assembler.getInternalState();
+    system.realize(state, Stage::Position);
+
+    const int nErr = cond.getNumErrors(state);
+    const int nFree = assembler.getNumFreeQs();
+    Matrix J;
+    SimTK_TEST(cond.calcErrorJacobian(state, J) == 0);
+    SimTK_TEST(J.nrow() == nErr && J.ncol() == nFree);
+
+    const Real h = 1e-6;
+    Vector errPlus(nErr), errMinus(nErr);
+    for (Assembler::FreeQIndex fx(0); fx < nFree; ++fx) {
+        const QIndex qx = assembler.getQIndexOfFreeQ(fx);
+        State perturbed = state;
+        perturbed.updQ()[qx] = state.getQ()[qx] + h;
+        system.realize(perturbed, Stage::Position);
+        cond.calcErrors(perturbed, errPlus);
+        perturbed.updQ()[qx] = state.getQ()[qx] - h;
+        system.realize(perturbed, Stage::Position);
+        cond.calcErrors(perturbed, errMinus);
+        const Vector numCol = (errPlus - errMinus) / (2*h);
+        SimTK_TEST_EQ_TOL(J(fx), numCol, 1e-6);
+    }
+}
+
+void testMarkerJacobian() {
+    MarkedChain chain;
+    Assembler assembler(chain.system);
+    assembler.adoptAssemblyGoal(chain.markers);
+    chain.observe(chain.getState(0.5));
+    assembler.initialize(chain.getState(0));
+
+    State state = assembler.getInternalState();
+    chain.system.realize(state, Stage::Position);
+    SimTK_TEST(chain.markers->getNumErrors(state)
+               == 3*chain.markers->getNumMarkers());
+    Vector err;
+    chain.markers->calcErrors(state, err);
+    SimTK_TEST(err.normRMS() > 0.01);
+    checkErrorJacobian(assembler, *chain.markers);
+
+    // A missing observation produces zero errors and Jacobian rows.
+    chain.markers->moveOneObservation(Markers::ObservationIx(1), Vec3(NaN));
+    chain.markers->calcErrors(state, err);
+    Matrix J;
+    chain.markers->calcErrorJacobian(state, J);
+    for (int i=3; i < 6; ++i) {
+        SimTK_TEST(err[i] == 0);
+        SimTK_TEST(J[i].norm() == 0);
+    }
+    checkErrorJacobian(assembler, *chain.markers);
+}
+
+void testOSensorJacobian() {
+    MarkedChain chain;
+    Assembler assembler(chain.system);
+    assembler.adoptAssemblyGoal(chain.osensors);
+    chain.observe(chain.getState(0.5));
+    assembler.initialize(chain.getState(0));
+
+    State state = assembler.getInternalState();
+    chain.system.realize(state, Stage::Position);
+    SimTK_TEST(chain.osensors->getNumErrors(state)
+               == 3*chain.osensors->getNumOSensors());
+    Vector err;
+    chain.osensors->calcErrors(state, err);
+    SimTK_TEST(err.normRMS() > 0.1);
+    checkErrorJacobian(assembler, *chain.osensors);
+
+    // Errors are rotation vectors so should vanish at the observations.
+    chain.observe(state);
+    chain.osensors->calcErrors(state, err);
+    SimTK_TEST_EQ_TOL(err.norm(), 0, 1e-12);
+    checkErrorJacobian(assembler, *chain.osensors);
+}
+
+// Track a sequence of frames with the sensors as goals, then with the
+// markers as requirements so that the analytic Jacobians are used.
+void testTracking() {
+    MarkedChain chain;
+    Assembler assembler(chain.system);
+    assembler.adoptAssemblyGoal(chain.markers);
+    assembler.adoptAssemblyGoal(chain.osensors);
+    assembler.setAccuracy(1e-8);
+    chain.observe(chain.getState(0));
+    assembler.initialize(chain.getState(0.05));
+    assembler.assemble();
+
+    for (int frame=1; frame <= 10; ++frame) {
+        const State expected = chain.getState(Real(0.01)*frame);
+        chain.observe(expected);
+        assembler.track();
+        State state = assembler.getInternalState();
+        chain.system.realize(state, Stage::Position);
+        Real goal;
+        chain.markers->calcGoal(state, goal);
+        SimTK_TEST_EQ_TOL(goal, 0, 1e-8);
+        chain.osensors->calcGoal(state, goal);
+        SimTK_TEST_EQ_TOL(goal, 0, 1e-8);
+    }
+
+    // One marker per body so that there are fewer requirements than q's.
+    MarkedChain required;
+    Markers* few = new Markers();
+    for (unsigned i=0; i < required.links.size(); ++i)
+        few->addMarker(required.links[i].getMobilizedBodyIndex(),
+                       Vec3(.1, .2*i, -.3));
+    Array_<Markers::MarkerIx> order;
+    for (Markers::MarkerIx mx(0); mx < few->getNumMarkers(); ++mx)
+        order.push_back(mx);
+    few->defineObservationOrder(order);
+    Assembler strict(required.system);
+    strict.adoptAssemblyGoal(few, Infinity);
+    strict.setAccuracy(1e-8);
+    required.markers = few;
+    required.observe(required.getState(0));
+    strict.initialize(required.getState(0.05));
+    strict.assemble();
+    for (int frame=1; frame <= 10; ++frame) {
+        required.observe(required.getState(Real(0.01)*frame));
+        strict.track();
+        State state = strict.getInternalState();
+        required.system.realize(state, Stage::Position);
+        Vector err;
+        few->calcErrors(state, err);
+        SimTK_TEST_EQ_TOL(err.norm(), 0, 1e-6);
+    }
+}
+
+int main() {
+    SimTK_START_TEST("TestAssemblyConditions");
+        SimTK_SUBTEST(testMarkerJacobian);
+        SimTK_SUBTEST(testOSensorJacobian);
+        SimTK_SUBTEST(testTracking);
+    SimTK_END_TEST();
+}
@@ -0,0 +1,206 @@
+/* -------------------------------------------------------------------------- *
+ *              Simbody(tm): Test BinaryDataEventReporter                     *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Record a double pendulum simulation with a BinaryDataEventReporter, read
+the file back, and compare it with the States saved by an ordinary reporter
+at the same times. */
+
+#include "Simbody.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+using std::cout; using std::endl;
+
+using namespace SimTK;
+
+const char* FileName = "TestBinaryDataEventReporter.bin";
+
+// Saves a copy of every reported State.
+class StateSaver : public PeriodicEventReporter {
+public:
+    explicit StateSaver(Real interval) : PeriodicEventReporter(interval) {}
+    void handleEvent(const State& state) const override {
+        m_states.push_back(state);
+    }
+    const Array_<State>& getStates() const {return m_states;}
+private:
+    mutable Array_<State>   m_states;
+};
+
+static void testRecordAndRead() {
+    MultibodySystem         system;
+    SimbodyMatterSubsystem  matter(system);
+    GeneralForceSubsystem   forces(system);
+    Force::Gravity          gravity(forces, matter, -YAxis, 9.8);
+
+    Body::Rigid body(MassProperties(1, Vec3(0), UnitInertia(1)));
+    MobilizedBody::Pin link1(matter.Ground(), Transform(),
+                             body, Transform(Vec3(0,1,0)));
+    MobilizedBody::Ball link2(link1, Transform(),
+                              body, Transform(Vec3(0,1,0)));
+    Measure::Time time(forces);
+
+    // A small block size so that there are several full blocks and a
+    // partial one at the end.
+    const Real Interval = 0.01;
+    BinaryDataEventReporter* reporter =
+        new BinaryDataEventReporter(system, FileName, Interval, 7);
+    reporter->addQ();
+    reporter->addU();
+    reporter->addMeasure(time, "t");
+    reporter->addBodyPose(link2, "link2");
+    system.addEventReporter(reporter);
+    StateSaver* saver = new StateSaver(Interval);
+    system.addEventReporter(saver);
+
+    State state = system.realizeTopology();
+    link1.setOneQ(state, 0, 0.5);
+    link2.setQToFitRotation(state, Rotation(0.3, XAxis));
+    link2.setUToFitAngularVelocity(state, Vec3(0.1, 0.2, -1));
+
+    RungeKuttaMersonIntegrator integ(system);
+    TimeStepper ts(system, integ);
+    ts.initialize(state);
+    ts.stepTo(1);
+
+    // No channels may be added once recording has started.
+    SimTK_TEST_MUST_THROW(reporter->addU());
+
+    reporter->close();
+    reporter->close(); // harmless
+
+    const Array_<State>& states = saver->getStates();
+    const int nq = state.getNQ(), nu = state.getNU();
+    SimTK_TEST(reporter->getNumRows() == (int)states.size());
+    SimTK_TEST(states.size() > 30); // several blocks
+
+    BinaryDataEventReporter::Reader data(FileName);
+    SimTK_TEST(data.getNumChannels() == 1 + nq + nu + 1 + 7);
+    SimTK_TEST(data.getNumRows() == (int)states.size());
+    SimTK_TEST(data.getChannelName(0) == "time");
+    SimTK_TEST(data.getChannelName(1) == "q0");
+    SimTK_TEST(data.getChannelName(1+nq) == "u0");
+    SimTK_TEST(data.findChannelIndex("t") == 1+nq+nu);
+    SimTK_TEST(data.findChannelIndex("link2.qw") == 2+nq+nu);
+    SimTK_TEST(data.findChannelIndex("link2.pz") == 8+nq+nu);
+    SimTK_TEST(data.findChannelIndex("nonesuch") == -1);
+
+    const int tChan = data.findChannelIndex("t");
+    const int poseChan = data.findChannelIndex("link2.qw");
+    for (int r=0; r < data.getNumRows(); ++r) {
+        State s = states[r];
+        system.realize(s, Stage::Position);
+        const RowVectorView row = data.getData().row(r);
+        SimTK_TEST(row[0] == s.getTime());
+        SimTK_TEST(data.getTimes()[r] == s.getTime());
+        for (int i=0; i < nq; ++i)
+            SimTK_TEST(row[1+i] == s.getQ()[i]);
+        for (int i=0; i < nu; ++i)
+            SimTK_TEST(row[1+nq+i] == s.getU()[i]);
+        SimTK_TEST(data.getChannel(tChan)[r] == s.getTime());
+
+        const Transform& X_GB = link2.getBodyTransform(s);
+        const Quaternion quat = X_GB.R().convertRotationToQuaternion();
+        for (int i=0; i < 4; ++i)
+            SimTK_TEST(row[poseChan+i] == quat[i]);
+        for (int i=0; i < 3; ++i)
+            SimTK_TEST(row[poseChan+4+i] == X_GB.p()[i]);
+    }
+
+    std::remove(FileName);
+}
+
+// A reporter that never reports still writes a readable file.
+static void testNoReports() {
+    MultibodySystem         system;
+    SimbodyMatterSubsystem  matter(system);
+    MobilizedBody::Pin link(matter.Ground(), Transform(),
+        Body::Rigid(MassProperties(1, Vec3(0), UnitInertia(1))),
+        Transform(Vec3(0,1,0)));
+
+    BinaryDataEventReporter* reporter =
+        new BinaryDataEventReporter(system, FileName, 0.1);
+    reporter->addQ();
+    system.addEventReporter(reporter);
+    system.realizeTopology();
+    reporter->close();
+    SimTK_TEST(reporter->getNumRows() == 0);
+
+    BinaryDataEventReporter::Reader data(FileName);
+    SimTK_TEST(data.getNumChannels() == 2);
+    SimTK_TEST(data.getChannelName(1) == "q0");
+    SimTK_TEST(data.getNumRows() == 0);
+
+    std::remove(FileName);
+}
+
+// The System owns the reporter, so when a reporter that was never closed is
+// destroyed along with its System it must write the file without the System's
+// help. With no reports, the q's can't be listed.
+static void testDestroyWithoutClose() {
+    {
+        MultibodySystem         system;
+        SimbodyMatterSubsystem  matter(system);
+        MobilizedBody::Pin link(matter.Ground(), Transform(),
+            Body::Rigid(MassProperties(1, Vec3(0), UnitInertia(1))),
+            Transform(Vec3(0,1,0)));
+        Measure::Time time(matter);
+
+        BinaryDataEventReporter* reporter =
+            new BinaryDataEventReporter(system, FileName, 0.1);
+        reporter->addQ();
+        reporter->addMeasure(time, "t");
+        reporter->addBodyPose(link, "link");
+        system.addEventReporter(reporter);
+        system.realizeTopology();
+    }
+
+    BinaryDataEventReporter::Reader data(FileName);
+    SimTK_TEST(data.getNumChannels() == 1 + 1 + 7);
+    SimTK_TEST(data.getChannelName(1) == "t");
+    SimTK_TEST(data.findChannelIndex("link.pz") == 8);
+    SimTK_TEST(data.getNumRows() == 0);
+
+    std::remove(FileName);
+}
+
+static void testBadFiles() {
+    std::remove(FileName);
+    SimTK_TEST_MUST_THROW(BinaryDataEventReporter::Reader data(FileName));
+
+    {std::ofstream junk(FileName, std::ios_base::binary);
+    junk << "This is not a SimTK binary data file.";}
+    SimTK_TEST_MUST_THROW(BinaryDataEventReporter::Reader data(FileName));
+
+    std::remove(FileName);
+}
+
+int main() {
+    SimTK_START_TEST("TestBinaryDataEventReporter");
+        SimTK_SUBTEST(testRecordAndRead);
+        SimTK_SUBTEST(testNoReports);
+        SimTK_SUBTEST(testDestroyWithoutClose);
+        SimTK_SUBTEST(testBadFiles);
+    SimTK_END_TEST();
+}
@@ -0,0 +1,123 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Build a chain of bodies with several cables running along it, some over
+// via points only and some wrapping a sphere, and check that solving the
+// cable paths on several threads gives the same answers as solving them one
+// after another.
+
+#include "SimTKsimbody.h"
+#include "SimTKcommon/Testing.h"
+
+using namespace SimTK;
+using namespace std;
+
+static const Real Rad = 0.25;
+static const int  NumViaCables = 6;
+
+struct CableChain {
+    CableChain() : matter(system), cables(system) {
+        Body::Rigid body(MassProperties(1.0, Vec3(0), Inertia(1)));
+        MobilizedBody parent = matter.Ground();
+        for (int i=0; i < 4; ++i) {
+            links.push_back(MobilizedBody::Ball(parent, Transform(Vec3(0)),
+                                                body, Transform(Vec3(0,1,0))));
+            parent = links.back();
+        }
+
+        // A cable wrapping a sphere, set up the same way as in the
+        // ExampleCablePath program.
+        CablePath wrapped(cables, links[0], Vec3(Rad,0,0),
+                                  links[3], Vec3(0,0,Rad));
+        CableObstacle::ViaPoint via(wrapped, links[1], Rad*UnitVec3(1,1,0));
+        CableObstacle::Surface sphere(wrapped, links[2], Transform(),
+                                      ContactGeometry::Sphere(Rad));
+        sphere.setContactPointHints(Rad*UnitVec3(-.25,.04,0.08),
+                                    Rad*UnitVec3(-.05,-.25,-.04));
+        paths.push_back(wrapped);
+
+        for (int i=0; i < NumViaCables; ++i) {
+            const Real angle = 2*Pi*i/NumViaCables;
+            const Vec3 offset(Rad*std::cos(angle), 0, Rad*std::sin(angle));
+            CablePath path(cables, matter.Ground(), offset,
+                                   links[3], offset);
+            for (int j=0; j < 3; ++j)
+                CableObstacle::ViaPoint(path, links[j], 2*offset);
+            paths.push_back(path);
+        }
+        system.realizeTopology();
+    }
+
+    State getState() const {
+        State state = system.getDefaultState();
+        for (int i=0; i < state.getNQ(); ++i)
+            state.updQ()[i] = Real(0.1)*std::sin(Real(i+1));
+        for (int i=0; i < state.getNU(); ++i)
+            state.updU()[i] = Real(0.2)*std::cos(Real(i+1));
+        return state;
+    }
+
+    MultibodySystem                 system;
+    SimbodyMatterSubsystem          matter;
+    CableTrackerSubsystem           cables;
+    Array_<MobilizedBody::Ball>     links;
+    Array_<CablePath>               paths;
+};
+
+void testParallelMatchesSerial() {
+    CableChain chain;
+    SimTK_TEST(chain.cables.getNumThreads() == 1);
+    SimTK_TEST(chain.cables.getNumCablePaths() == NumViaCables+1);
+
+    State serial = chain.getState();
+    chain.system.realize(serial, Stage::Velocity);
+
+    chain.cables.setNumThreads(4);
+    SimTK_TEST(chain.cables.getNumThreads() == 4);
+    State parallel = chain.getState();
+    chain.system.realize(parallel, Stage::Velocity);
+
+    for (unsigned i=0; i < chain.paths.size(); ++i) {
+        const CablePath& path = chain.paths[i];
+        SimTK_TEST(path.getCableLength(parallel)
+                   == path.getCableLength(serial));
+        SimTK_TEST(path.getCableLengthDot(parallel)
+                   == path.getCableLengthDot(serial));
+        SimTK_TEST(path.getNumPathSolverIterations(parallel)
+                   == path.getNumPathSolverIterations(serial));
+        SimTK_TEST(path.getPathSolverCPUTime(parallel) >= 0);
+    }
+
+    // Only the wrapped cable has unknowns to iterate on.
+    SimTK_TEST(chain.paths[0].getNumPathSolverIterations(serial) > 0);
+    for (int i=1; i <= NumViaCables; ++i)
+        SimTK_TEST(chain.paths[i].getNumPathSolverIterations(serial) == 0);
+
+    SimTK_TEST_MUST_THROW(chain.cables.setNumThreads(0));
+}
+
+int main() {
+    SimTK_START_TEST("TestCableTrackerSubsystem");
+        SimTK_SUBTEST(testParallelMatchesSerial);
+    SimTK_END_TEST();
+}
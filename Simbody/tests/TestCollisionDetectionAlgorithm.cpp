@@ -23,6 +23,7 @@
 
 #include "SimTKsimbody.h"
 
+#include <algorithm>
 #include <set>
 
 using namespace SimTK;
@@ -281,10 +282,11 @@ void testEllipsoidEllipsoid() {
  * Check the set of faces in a contact.
  */
 
-void verifyContactFaces(int* expected, int numExpected, const set<int>& found) {
+void verifyContactFaces(int* expected, int numExpected, 
+                        const Array_<int>& found) {
     ASSERT(numExpected == found.size());
     for (int i = 0; i < numExpected; i++) {
-        ASSERT(found.find(expected[i]) != found.end());
+        ASSERT(std::binary_search(found.begin(), found.end(), expected[i]));
     }
 }
 
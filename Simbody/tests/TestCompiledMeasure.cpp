@@ -0,0 +1,167 @@
+/* -------------------------------------------------------------------------- *
+ *              Simbody(tm): Test Compiled Measures                           *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Check that a Measure_<T>::Compiled gives the same values as the expression
+it was compiled from, shares common subexpressions, folds constants, and picks
+up changes to the expression's measures. */
+
+#include "Simbody.h"
+
+#include <iostream>
+using std::cout; using std::endl;
+
+using namespace SimTK;
+
+class Model {
+public:
+    Model() : matter(system), forces(system) {}
+
+    MultibodySystem         system;
+    SimbodyMatterSubsystem  matter;
+    GeneralForceSubsystem   forces;
+};
+
+// An expression in which the same sum is built twice with its operands
+// swapped, and so is its scaled version, plus a constant subexpression.
+static void testSharingAndFolding() {
+    Model model;
+    Subsystem& sub = model.forces;
+
+    Measure::Time     t(sub);
+    Measure::Variable x(sub, Stage::Time, 2);
+    Measure::Sinusoid sn(sub, 1.5, 3, 0.2);
+
+    Measure::Plus   a(sub, x, t);
+    Measure::Plus   b(sub, t, x);
+    Measure::Scale  c(sub, 2, a);
+    Measure::Scale  d(sub, 2, b);
+    Measure::Minus  e(sub, c, sn);
+    Measure::Plus   f(sub, e, d);
+    Measure::Scale  h(sub, 0.5, Measure::Plus(sub, Measure::Constant(sub, 1),
+                                                   Measure::Constant(sub, 2)));
+    Measure::Plus   root(sub, f, h);
+
+    Measure::Compiled compiled(sub, root);
+    SimTK_TEST(compiled.getExpressionMeasure().isSameMeasure(root));
+
+    State state = model.system.realizeTopology();
+    cout << "leaves=" << compiled.getNumLeaves() 
+         << " operations=" << compiled.getNumOperations() << endl;
+    SimTK_TEST(compiled.getNumLeaves() == 3);     // t, x, sn
+    SimTK_TEST(compiled.getNumOperations() == 5); // a, c, e, f, root
+    SimTK_TEST(compiled.getDependsOnStage() == root.getDependsOnStage());
+
+    for (int i=0; i < 5; ++i) {
+        state.setTime(0.1*i);
+        x.setValue(state, i-1.5);
+        model.system.realize(state, Stage::Time);
+
+        const Real tv = state.getTime(), xv = i-1.5;
+        const Real expected = 
+            2*(xv+tv) - 1.5*std::sin(3*tv+0.2) + 2*(tv+xv) + 1.5;
+        SimTK_TEST_EQ(compiled.getValue(state), expected);
+        SimTK_TEST(compiled.getValue(state) == root.getValue(state));
+
+        // Changing the variable invalidates the compiled value.
+        x.setValue(state, 10*i);
+        model.system.realize(state, Stage::Time);
+        SimTK_TEST(compiled.getValue(state) == root.getValue(state));
+    }
+}
+
+// Changing a Constant or scale factor in the expression is a topological
+// change, after which the expression is compiled again.
+static void testRecompile() {
+    Model model;
+    Subsystem& sub = model.forces;
+
+    Measure::Time      t(sub);
+    Measure::Constant  k(sub, 3);
+    Measure::Scale     scaled(sub, 4, Measure::Plus(sub, t, k));
+    Measure::Compiled  compiled(sub, scaled);
+
+    State state = model.system.realizeTopology();
+    state.setTime(0.5);
+    model.system.realize(state, Stage::Time);
+    SimTK_TEST_EQ(compiled.getValue(state), 4*(0.5+3));
+
+    k.setValue(-1);
+    state = model.system.realizeTopology();
+    state.setTime(0.5);
+    model.system.realize(state, Stage::Time);
+    SimTK_TEST_EQ(compiled.getValue(state), 4*(0.5-1));
+    SimTK_TEST(compiled.getValue(state) == scaled.getValue(state));
+
+    // An expression made only of constants is folded completely.
+    Measure::Minus constant(sub, Measure::Constant(sub, 5), k);
+    Measure::Compiled folded(sub, constant);
+    state = model.system.realizeTopology();
+    model.system.realize(state, Stage::Model);
+    SimTK_TEST(folded.getNumLeaves() == 0);
+    SimTK_TEST(folded.getNumOperations() == 0);
+    SimTK_TEST(folded.getDependsOnStage() == Stage::Topology);
+    SimTK_TEST_EQ(folded.getValue(state), 6);
+}
+
+// Aggregate types work too, with a leaf shared by several paths.
+static void testVecAndVector() {
+    Model model;
+    Subsystem& sub = model.forces;
+
+    Measure_<Vec3>::Variable  p(sub, Stage::Position, Vec3(1,2,3));
+    Measure_<Vec3>::Constant  offset(sub, Vec3(0.5,0,-1));
+    Measure_<Vec3>::Minus     rel(sub, p, offset);
+    Measure_<Vec3>::Plus      sum(sub, Measure_<Vec3>::Scale(sub, -2, rel), p);
+    Measure_<Vec3>::Compiled  compiledVec3(sub, sum);
+
+    Measure_<Vector>::Variable v(sub, Stage::Position, Vector(4, 1.));
+    Measure_<Vector>::Plus     twice(sub, v, v);
+    Measure_<Vector>::Compiled compiledVector(sub, 
+        Measure_<Vector>::Minus(sub, twice, Measure_<Vector>::One(sub, 4)));
+
+    State state = model.system.realizeTopology();
+    SimTK_TEST(compiledVec3.getNumLeaves() == 1);
+    SimTK_TEST(compiledVec3.getNumOperations() == 3);
+    SimTK_TEST(compiledVector.getNumLeaves() == 1);
+    SimTK_TEST(compiledVector.getNumOperations() == 2);
+
+    p.setValue(state, Vec3(-1,4,0.25));
+    Vector vv(4); vv[0]=1; vv[1]=-2; vv[2]=0.5; vv[3]=7;
+    v.setValue(state, vv);
+    model.system.realize(state, Stage::Position);
+
+    SimTK_TEST_EQ(compiledVec3.getValue(state), 
+                  -2*(Vec3(-1,4,0.25)-Vec3(0.5,0,-1)) + Vec3(-1,4,0.25));
+    SimTK_TEST(compiledVec3.getValue(state) == sum.getValue(state));
+    Vector expected(4);
+    for (int i=0; i < 4; ++i) expected[i] = 2*vv[i] - 1;
+    SimTK_TEST_EQ(compiledVector.getValue(state), expected);
+}
+
+int main() {
+    SimTK_START_TEST("TestCompiledMeasure");
+        SimTK_SUBTEST(testSharingAndFolding);
+        SimTK_SUBTEST(testRecompile);
+        SimTK_SUBTEST(testVecAndVector);
+    SimTK_END_TEST();
+}
@@ -0,0 +1,189 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Check that calculating contact forces on several threads gives exactly the
+// same answers as using one, and that force generators can be replaced after
+// the subsystem has been realized.
+
+#include "SimTKsimbody.h"
+#include "SimTKcommon/Testing.h"
+
+using namespace SimTK;
+using namespace std;
+
+// A row of spheres and mesh spheres pressed into the floor and into each
+// other, with some velocity so friction and dissipation are exercised.
+struct ContactPile {
+    ContactPile() : matter(system), tracker(system), contact(system, tracker)
+    {
+        const ContactMaterial material(1e6, 0.5, 0.8, 0.6, 0.1);
+        matter.Ground().updBody().addContactSurface(
+            Transform(Rotation(-Pi/2, ZAxis), Vec3(0)),
+            ContactSurface(ContactGeometry::HalfSpace(), material));
+        Body::Rigid ball(MassProperties(1, Vec3(0), UnitInertia(1)));
+        ball.addContactSurface(Transform(),
+            ContactSurface(ContactGeometry::Sphere(Radius), material));
+        Body::Rigid meshBall(MassProperties(1, Vec3(0), UnitInertia(1)));
+        meshBall.addContactSurface(Transform(),
+            ContactSurface(ContactGeometry::TriangleMesh(
+                PolygonalMesh::createSphereMesh(Radius, 2)), material, 0.01));
+        for (int i=0; i < NumBodies; ++i)
+            bodies.push_back(MobilizedBody::Free(matter.Ground(),
+                Vec3(1.9*Radius*i, 0, 0), i%3==2 ? meshBall : ball, Vec3(0)));
+    }
+
+    State getState() const {
+        State state = system.realizeTopology();
+        for (int i=0; i < NumBodies; ++i) {
+            bodies[i].setQToFitTranslation(state,
+                                           Vec3(0, 0.98*Radius, .001*i));
+            bodies[i].setUToFitVelocity(state,
+                SpatialVec(Vec3(0, 0, .1*i), Vec3(.01*i, -.02, 0)));
+        }
+        system.realize(state, Stage::Dynamics);
+        return state;
+    }
+
+    static const int NumBodies = 20;
+    static const Real Radius;
+    MultibodySystem                 system;
+    SimbodyMatterSubsystem          matter;
+    ContactTrackerSubsystem         tracker;
+    CompliantContactSubsystem       contact;
+    Array_<MobilizedBody::Free>     bodies;
+};
+const Real ContactPile::Radius = 0.1;
+
+void testThreadedForcesMatch() {
+    ContactPile pile;
+    SimTK_TEST(pile.contact.getNumThreads() == 1);
+    State state = pile.getState();
+    const int nForces = pile.contact.getNumContactForces(state);
+    // Every body touches the floor, and neighbors overlap too.
+    SimTK_TEST(nForces > ContactPile::NumBodies);
+    Array_<ContactForce> forces1;
+    for (int i=0; i < nForces; ++i)
+        forces1.push_back(pile.contact.getContactForce(state, i));
+    const Vector_<SpatialVec> F1 = 
+        pile.system.getRigidBodyForces(state, Stage::Dynamics);
+
+    for (int nThreads=2; nThreads <= 5; nThreads += 3) {
+        pile.contact.setNumThreads(nThreads);
+        SimTK_TEST(pile.contact.getNumThreads() == nThreads);
+        // Recalculate the forces without tracking the contacts again.
+        state.invalidateAllCacheAtOrAbove(Stage::Velocity);
+        pile.system.realize(state, Stage::Dynamics);
+        SimTK_TEST(pile.contact.getNumContactForces(state) == nForces);
+        for (int i=0; i < nForces; ++i) {
+            const ContactForce& fN = pile.contact.getContactForce(state, i);
+            SimTK_TEST(forces1[i].getContactId() == fN.getContactId());
+            SimTK_TEST(forces1[i].getForceOnSurface2() 
+                       == fN.getForceOnSurface2());
+            SimTK_TEST(forces1[i].getContactPoint() == fN.getContactPoint());
+            SimTK_TEST(forces1[i].getPotentialEnergy() 
+                       == fN.getPotentialEnergy());
+        }
+        const Vector_<SpatialVec>& FN = 
+            pile.system.getRigidBodyForces(state, Stage::Dynamics);
+        for (int b=0; b < F1.size(); ++b)
+            SimTK_TEST(F1[b] == FN[b]);
+    }
+
+    SimTK_TEST_MUST_THROW(pile.contact.setNumThreads(0));
+}
+
+// A generator that produces a fixed force for every Contact it is given.
+class ConstantForceGenerator : public ContactForceGenerator {
+public:
+    explicit ConstantForceGenerator(ContactTypeId type)
+    :   ContactForceGenerator(type) {}
+    void calcContactForce(const State&, const Contact& overlapping,
+                          const SpatialVec&, ContactForce& force) const
+                          override {
+        force = ContactForce(overlapping.getContactId(), Vec3(0),
+                             SpatialVec(Vec3(0), Vec3(0, 1, 0)), 0, 0);
+    }
+    void calcContactPatch(const State&, const Contact&, const SpatialVec&,
+                          ContactPatch& patch) const override
+    {   patch.clear(); }
+};
+
+void testReplaceGenerator() {
+    ContactPile pile;
+    State state = pile.getState();
+    SimTK_TEST(pile.contact.getContactForce(state, 0).getForceOnSurface2()[1]
+               != Vec3(0, 1, 0));
+
+    pile.contact.adoptForceGenerator(
+        new ConstantForceGenerator(CircularPointContact::classTypeId()));
+    state = pile.getState();
+    // Spheres against the floor or each other are circular point contacts;
+    // mesh contacts still get elastic foundation forces.
+    int nConstant = 0;
+    for (int i=0; i < pile.contact.getNumContactForces(state); ++i)
+        if (pile.contact.getContactForce(state, i).getForceOnSurface2()[1]
+            == Vec3(0, 1, 0)) ++nConstant;
+    SimTK_TEST(nConstant > 0);
+    SimTK_TEST(nConstant < pile.contact.getNumContactForces(state));
+}
+
+// A convex hull box pressed into the floor should be pushed straight up,
+// with a force generated at each of its bottom corners.
+void testConvexHullOnFloor() {
+    MultibodySystem             system;
+    SimbodyMatterSubsystem      matter(system);
+    ContactTrackerSubsystem     tracker(system);
+    CompliantContactSubsystem   contact(system, tracker);
+    const ContactMaterial material(1e6, 0.5, 0, 0, 0);
+    matter.Ground().updBody().addContactSurface(
+        Transform(Rotation(-Pi/2, ZAxis), Vec3(0)),
+        ContactSurface(ContactGeometry::HalfSpace(), material));
+    Body::Rigid box(MassProperties(1, Vec3(0), UnitInertia(1)));
+    box.addContactSurface(Transform(), ContactSurface(
+        ContactGeometry::ConvexHull(
+            PolygonalMesh::createBrickMesh(Vec3(0.1))), material));
+    MobilizedBody::Free body(matter.Ground(), Transform(), box, Transform());
+
+    State state = system.realizeTopology();
+    body.setQToFitTranslation(state, Vec3(0, 0.099, 0));
+    system.realize(state, Stage::Dynamics);
+    SimTK_TEST(contact.getNumContactForces(state) == 1);
+    ContactPatch patch;
+    SimTK_TEST(contact.calcContactPatchDetailsById(state,
+        contact.getContactForce(state, 0).getContactId(), patch));
+    SimTK_TEST(patch.getNumDetails() == 4);
+    const SpatialVec& F = 
+        system.getRigidBodyForces(state, Stage::Dynamics)[body.getMobilizedBodyIndex()];
+    SimTK_TEST(F[1][YAxis] > 0);
+    SimTK_TEST_EQ_TOL(F[1][XAxis], 0, 1e-10);
+    SimTK_TEST_EQ_TOL(F[1][ZAxis], 0, 1e-10);
+    SimTK_TEST_EQ_TOL(F[0], Vec3(0), 1e-10);
+}
+
+int main() {
+    SimTK_START_TEST("TestCompliantContactSubsystem");
+        SimTK_SUBTEST(testThreadedForcesMatch);
+        SimTK_SUBTEST(testReplaceGenerator);
+        SimTK_SUBTEST(testConvexHullOnFloor);
+    SimTK_END_TEST();
+}
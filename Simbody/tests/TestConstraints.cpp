@@ -579,9 +579,85 @@ void testConstraintMatrices() {
     matter.calcProjectedMInv(state, GMInvGt); // O(m*n)
     SimTK_TEST_EQ(GMInvGt, numGMInvGt);
 
+    // Everything is coupled here so there can be only one group, but the 
+    // multipliers needn't be in order.
+    Array_<Array_<MultiplierIndex> > groups(1);
+    for (int i=m-1; i >= 0; --i)
+        groups[0].push_back(MultiplierIndex(i));
+    Array_<Matrix> blocks;
+    matter.calcProjectedMInv(state, groups, blocks);
+    SimTK_TEST(blocks.size() == groups.size());
+    for (unsigned g=0; g < groups.size(); ++g) {
+        const int mg = (int)groups[g].size();
+        SimTK_TEST(blocks[g].nrow() == mg && blocks[g].ncol() == mg);
+        for (int i=0; i < mg; ++i)
+            for (int j=0; j < mg; ++j)
+                SimTK_TEST_EQ(blocks[g](i,j), 
+                              GMInvGt(groups[g][i], groups[g][j]));
+    }
+
     delete &system;
 }
 
+// Free bodies tied to Ground are uncoupled in G M\ ~G unless a constraint 
+// connects them; check that the blocks for groups of uncoupled multipliers
+// match the full matrix, and that the off-block entries really are zero.
+void testProjectedMInvBlocks() {
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    const MassProperties mprops(1, Vec3(.01,.02,.03), Inertia(1,1.1,1.2));
+    Array_<MobilizedBody::Free> bodies;
+    for (int i=0; i < 4; ++i) {
+        bodies.push_back(MobilizedBody::Free(matter.Ground(), 
+                                             Transform(Vec3(i,0,0)),
+                                             Body::Rigid(mprops), Transform()));
+        Constraint::Ball(matter.Ground(), Vec3(i,1,0), 
+                         bodies.back(), Vec3(0,1,0));
+    }
+    // Bodies 2 and 3 are tied together, so they form one group.
+    Constraint::Rod(bodies[2], Vec3(.1,0,0), bodies[3], Vec3(0,.2,0), 1.);
+
+    State state = system.realizeTopology();
+    for (int i=0; i < 4; ++i)
+        bodies[i].setQToFitTransform(state, 
+            Transform(Rotation(.1*i, XAxis), Vec3(i,.05,.1*i)));
+    system.realize(state, Stage::Position);
+
+    Array_<Array_<MultiplierIndex> > groups(3);
+    for (MultiplierIndex mx(0); mx < 3; ++mx) {
+        groups[0].push_back(mx);
+        groups[1].push_back(MultiplierIndex(3+mx));
+        groups[2].push_back(MultiplierIndex(6+mx));
+        groups[2].push_back(MultiplierIndex(9+mx));
+    }
+    groups[2].push_back(MultiplierIndex(12));
+    SimTK_TEST(matter.getNMultipliers(state) == 13);
+
+    Matrix GMInvGt;
+    matter.calcProjectedMInv(state, GMInvGt);
+    Array_<Matrix> blocks;
+    matter.calcProjectedMInv(state, groups, blocks);
+    SimTK_TEST(blocks.size() == groups.size());
+
+    Array_<int> groupOf(13);
+    for (unsigned g=0; g < groups.size(); ++g)
+        for (unsigned i=0; i < groups[g].size(); ++i)
+            groupOf[groups[g][i]] = g;
+    for (int i=0; i < 13; ++i)
+        for (int j=0; j < 13; ++j)
+            if (groupOf[i] != groupOf[j])
+                SimTK_TEST(GMInvGt(i,j) == 0);
+
+    for (unsigned g=0; g < groups.size(); ++g) {
+        const int mg = (int)groups[g].size();
+        SimTK_TEST(blocks[g].nrow() == mg && blocks[g].ncol() == mg);
+        for (int i=0; i < mg; ++i)
+            for (int j=0; j < mg; ++j)
+                SimTK_TEST_EQ(blocks[g](i,j), 
+                              GMInvGt(groups[g][i], groups[g][j]));
+    }
+}
+
 // Test the operator SimbodyMatterSubsystem::calcConstraintAccelerationErrors(),
 // which computes pvaerr = G udot - b. For the most part, we just ensure that
 // this operator gives results consistent with other methods.
@@ -737,6 +813,7 @@ int main() {
         SimTK_SUBTEST(testWeldConstraintWithPreAssembly);
         SimTK_SUBTEST(testConstraintForces);
         SimTK_SUBTEST(testConstraintMatrices);
+        SimTK_SUBTEST(testProjectedMInvBlocks);
         SimTK_SUBTEST(testConstraintAccelerationErrors);
         SimTK_SUBTEST(testDisablingConstraints);
     SimTK_END_TEST();
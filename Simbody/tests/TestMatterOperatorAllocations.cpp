@@ -0,0 +1,251 @@
+/* -------------------------------------------------------------------------- *
+ *              Simbody(tm): Test Matter Operator Allocations                 *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* The O(n) operators of SimbodyMatterSubsystem get their temporaries from
+per-thread scratch memory, so once they have been called a few times they
+shouldn't touch the heap at all. Here we replace the global operator new so
+that we can count heap allocations while the operators are called repeatedly
+with the same State and arguments. The output arguments are already the right
+size, as they would be in a control loop.
+
+On Windows the replacement operator new doesn't see allocations made inside
+the Simbody DLLs, so there this test just checks that the operators run. */
+
+#include "Simbody.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+using std::cout; using std::endl;
+
+using namespace SimTK;
+
+static long numAllocations = 0;
+
+void* operator new(std::size_t size) {
+    ++numAllocations;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {return ::operator new(size);}
+void operator delete(void* p) noexcept {std::free(p);}
+void operator delete[](void* p) noexcept {std::free(p);}
+
+// A tree with a closed loop and holonomic, nonholonomic, and
+// acceleration-only constraints.
+class Model {
+public:
+    Model() : matter(system), forces(system),
+        gravity(forces, matter, -YAxis, 9.8)
+    {
+        Body::Rigid body(MassProperties(1, Vec3(0.1,0.2,0.3),
+                                        UnitInertia(1,1.2,1.4)));
+        MobilizedBody::Free base(matter.Ground(), Transform(),
+                                 body, Transform());
+        MobilizedBody::Pin link1(base, Transform(Vec3(0,-1,0)),
+                                 body, Transform(Vec3(0,1,0)));
+        MobilizedBody::Ball link2(link1, Transform(Vec3(0,-1,0)),
+                                  body, Transform(Vec3(0,1,0)));
+        MobilizedBody::Slider link3(link2, Transform(Vec3(0,-1,0)),
+                                    body, Transform(Vec3(0,1,0)));
+        MobilizedBody::Universal link4(base, Transform(Vec3(1,0,0)),
+                                       body, Transform(Vec3(-1,0,0)));
+        MobilizedBody::Pin link5(link4, Transform(Vec3(1,0,0)),
+                                 body, Transform(Vec3(-1,0,0)));
+
+        Constraint::Ball(link3, Vec3(0,-1,0), link5, Vec3(1,0,0));
+        Constraint::NoSlip1D(matter.Ground(), Vec3(0), UnitVec3(XAxis),
+                             matter.Ground(), link1);
+        Constraint::ConstantAcceleration(link3, MobilizerUIndex(0), 0.5);
+
+        bodies.push_back(link2); stations.push_back(Vec3(0.1,0.2,0.3));
+        bodies.push_back(link5); stations.push_back(Vec3(-1,0,0.5));
+        bodies.push_back(base);  stations.push_back(Vec3(0));
+
+        state = system.realizeTopology();
+        base.setQToFitTransform(state, Transform(Rotation(0.3, XAxis),
+                                                 Vec3(0.1,2,0.3)));
+        Random::Uniform rand(-1, 1);
+        for (int i=0; i < state.getNU(); ++i)
+            state.updU()[i] = rand.getValue();
+        system.realize(state, Stage::Velocity);
+    }
+
+    MultibodySystem                 system;
+    SimbodyMatterSubsystem          matter;
+    GeneralForceSubsystem           forces;
+    Force::Gravity                  gravity;
+    Array_<MobilizedBodyIndex>      bodies;
+    Array_<Vec3>                    stations;
+    State                           state;
+};
+
+// Arguments and results for the operators. All are allocated here so that
+// only the operators themselves are measured.
+class Workspace {
+public:
+    explicit Workspace(const Model& model) {
+        const State& s = model.state;
+        const int nq = s.getNQ(), nu = s.getNU();
+        const int nb = model.matter.getNumBodies();
+        const int ns = (int)model.bodies.size();
+        const int m  = s.getNMultipliers();
+        // The position error count includes quaternion normalization, so
+        // get the number of holonomic constraint equations from their bias.
+        model.matter.calcBiasForMultiplyByPq(s, biasp);
+        const int mp = biasp.size();
+        SimTK_TEST(nu > 0 && m > 0 && mp > 0);
+
+        q.resize(nq); u.resize(nu); u2.resize(nu); lambda.resize(m);
+        lambdap.resize(mp); bodyForces.resize(nb); stationForces.resize(ns);
+        frameForces.resize(ns);
+        for (int i=0; i < nq; ++i) q[i] = i+1;
+        for (int i=0; i < nu; ++i) u[i] = 1-i;
+        for (int i=0; i < m;  ++i) lambda[i] = 0.5*i;
+        for (int i=0; i < mp; ++i) lambdap[i] = i-0.5;
+        bodyForces = SpatialVec(Vec3(1,2,3), Vec3(-1,0,1));
+        stationForces = Vec3(0.1,-2,3);
+        frameForces = SpatialVec(Vec3(0,1,0), Vec3(2,0,1));
+
+        fu.resize(nu); fq.resize(nq); qlike.resize(nq); ulike.resize(nu);
+        Gu.resize(m); bias.resize(m); Pqq.resize(mp);
+        pvaerr.resize(m); JuBody.resize(nb); JSu.resize(ns); JFu.resize(ns);
+        JSDotu.resize(ns); JFDotu.resize(6*ns); A_GB.resize(nb);
+        JS.resize(ns, nu); JF.resize(ns, nu); GMInvGt.resize(m, m);
+
+        // Two groups that together include every multiplier.
+        groups.resize(2);
+        for (int i=0; i < m; ++i)
+            groups[i%2].push_back(MultiplierIndex(i));
+    }
+
+    Vector q, u, u2, lambda, lambdap, fu, fq, qlike, ulike, Gu, bias, Pqq,
+           biasp, pvaerr, JFDotu;
+    Vector_<SpatialVec> bodyForces, frameForces, JuBody, JFu, A_GB;
+    Vector_<Vec3> stationForces, JSu, JSDotu;
+    Matrix_<Vec3> JS;
+    Matrix_<SpatialVec> JF;
+    Matrix GMInvGt;
+    Array_<Array_<MultiplierIndex> > groups;
+    Array_<Matrix> blocks;
+};
+
+// Call each of the operators once. We don't care about the results here;
+// TestMassMatrix and others check those.
+static void callOperators(const Model& model, Workspace& w) {
+    const SimbodyMatterSubsystem& matter = model.matter;
+    const State& s = model.state;
+
+    matter.multiplyByM(s, w.u, w.fu);
+    matter.multiplyByMInv(s, w.fu, w.u2);
+    matter.calcResidualForceIgnoringConstraints(s, w.fu, w.bodyForces, w.u,
+                                                w.u2);
+
+    matter.calcBiasForMultiplyByG(s, w.bias);
+    matter.multiplyByG(s, w.u, w.bias, w.Gu);
+    matter.multiplyByGTranspose(s, w.lambda, w.fu);
+    matter.calcBiasForAccelerationConstraints(s, w.bias);
+    matter.calcConstraintAccelerationErrors(s, w.u, w.pvaerr);
+    matter.calcBiasForMultiplyByPq(s, w.biasp);
+    matter.multiplyByPq(s, w.q, w.biasp, w.Pqq);
+    matter.multiplyByPqTranspose(s, w.lambdap, w.fq);
+    matter.calcProjectedMInv(s, w.GMInvGt);
+    matter.calcProjectedMInv(s, w.groups, w.blocks);
+
+    matter.multiplyByN(s, false, w.u, w.qlike);
+    matter.multiplyByNInv(s, false, w.qlike, w.ulike);
+    matter.multiplyByNDot(s, true, w.q, w.ulike);
+
+    matter.multiplyBySystemJacobian(s, w.u, w.JuBody);
+    matter.multiplyBySystemJacobianTranspose(s, w.bodyForces, w.fu);
+    matter.calcBiasForSystemJacobian(s, w.JuBody);
+    matter.calcBodyAccelerationFromUDot(s, w.u, w.A_GB);
+    matter.calcTreeEquivalentMobilityForces(s, w.bodyForces, w.fu);
+
+    matter.multiplyByStationJacobian(s, model.bodies, model.stations,
+                                     w.u, w.JSu);
+    matter.multiplyByStationJacobianTranspose(s, model.bodies,
+        model.stations, w.stationForces, w.fu);
+    matter.calcStationJacobian(s, model.bodies, model.stations, w.JS);
+    matter.calcBiasForStationJacobian(s, model.bodies, model.stations,
+                                      w.JSDotu);
+
+    matter.multiplyByFrameJacobian(s, model.bodies, model.stations,
+                                   w.u, w.JFu);
+    matter.multiplyByFrameJacobianTranspose(s, model.bodies, model.stations,
+                                            w.frameForces, w.fu);
+    matter.calcFrameJacobian(s, model.bodies, model.stations, w.JF);
+    matter.calcBiasForFrameJacobian(s, model.bodies, model.stations,
+                                    w.JFDotu);
+}
+
+static void testNoAllocationsInSteadyState() {
+    Model model;
+    Workspace w(model);
+
+    // The first calls fill the scratch pools.
+    callOperators(model, w);
+    callOperators(model, w);
+
+    const long before = numAllocations;
+    for (int i=0; i < 10; ++i)
+        callOperators(model, w);
+    const long numInLoop = numAllocations - before;
+    cout << "heap allocations in 10 passes: " << numInLoop << endl;
+    SimTK_TEST(numInLoop == 0);
+}
+
+// Arguments that aren't contiguous in memory are copied into scratch
+// Vectors, so they don't cause allocation either.
+static void testNoAllocationsWithViews() {
+    Model model;
+    const SimbodyMatterSubsystem& matter = model.matter;
+    const State& s = model.state;
+    const int nu = s.getNU();
+
+    // Matrix diagonals are strided.
+    Matrix A(nu, nu), F(nu, nu), AF(nu, nu);
+    VectorView a = A.updDiag(), f = F.updDiag(), af = AF.updDiag();
+    for (int i=0; i < nu; ++i) a[i] = i-2;
+    SimTK_TEST(!a.hasContiguousData());
+
+    for (int pass=0; pass < 3; ++pass) {
+        const long before = numAllocations;
+        matter.multiplyByM(s, a, f);
+        matter.multiplyByMInv(s, f, af);
+        const long numInCalls = numAllocations - before;
+        if (pass > 0) // the first pass fills the scratch pools
+            SimTK_TEST(numInCalls == 0);
+    }
+
+    // Make sure the results were copied out.
+    SimTK_TEST_EQ_TOL(af, a, 1e-10);
+}
+
+int main() {
+    SimTK_START_TEST("TestMatterOperatorAllocations");
+        SimTK_SUBTEST(testNoAllocationsInSteadyState);
+        SimTK_SUBTEST(testNoAllocationsWithViews);
+    SimTK_END_TEST();
+}
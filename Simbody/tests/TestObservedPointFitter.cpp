@@ -202,9 +202,151 @@ static void testConstrained() {
     testObservedPointFitter(true);
 }
 
+// Return the weighted RMS distance of the stations from their targets.
+static Real calcRMSError
+   (const MultibodySystem& mbs, const State& state, 
+    const Array_<MobilizedBodyIndex>& bodyIxs, 
+    const Array_<Array_<Vec3> >& stations, 
+    const Array_<Array_<Vec3> >& targetLocations, 
+    const Array_<Array_<Real> >& weights) 
+{
+    mbs.realize(state, Stage::Position);
+    const SimbodyMatterSubsystem& matter = mbs.getMatterSubsystem();
+    Real error = 0, totalWeight = 0;
+    for (int i = 0; i < (int)bodyIxs.size(); ++i) {
+        const MobilizedBody& body = matter.getMobilizedBody(bodyIxs[i]);
+        for (int j = 0; j < (int)stations[i].size(); ++j) {
+            error += weights[i][j]*(targetLocations[i][j]-body.getBodyTransform(state)*stations[i][j]).normSqr();
+            totalWeight += weights[i][j];
+        }
+    }
+    return std::sqrt(error/totalWeight);
+}
+
+// Fit a smooth marker trajectory for a chain whose joints use quaternions,
+// frame by frame with refineFit() and all at once with findBestFitTrajectory().
+static void testTrajectory() {
+    MultibodySystem mbs;
+    SimbodyMatterSubsystem matter(mbs);
+    Body::Rigid body = Body::Rigid(MassProperties(1, Vec3(0), Inertia(1)));
+    MobilizedBody::Free base(matter.Ground(), Transform(), body, Transform());
+    MobilizedBody::Ball link1(base, Transform(Vec3(0, -BOND_LENGTH, 0)), body, Transform());
+    MobilizedBody::Pin link2(link1, Transform(Vec3(0, -BOND_LENGTH, 0)), body, Transform());
+    MobilizedBody::Slider link3(link2, Transform(Vec3(0, -BOND_LENGTH, 0)), body, Transform());
+    MobilizedBody::Ball link4(link3, Transform(Vec3(0, -BOND_LENGTH, 0)), body, Transform());
+    State s = mbs.realizeTopology();
+    mbs.realizeModel(s);
+    SimTK_TEST(!matter.getUseEulerAngles(s));
+
+    Array_<MobilizedBodyIndex> bodyIxs;
+    bodyIxs.push_back(base.getMobilizedBodyIndex());
+    bodyIxs.push_back(link1.getMobilizedBodyIndex());
+    bodyIxs.push_back(link2.getMobilizedBodyIndex());
+    bodyIxs.push_back(link3.getMobilizedBodyIndex());
+    bodyIxs.push_back(link4.getMobilizedBodyIndex());
+    Array_<Array_<Vec3> > stations(bodyIxs.size());
+    Array_<Array_<Real> > weights(bodyIxs.size());
+    for (int i = 0; i < (int)bodyIxs.size(); ++i) {
+        stations[i].push_back(Vec3(.1, 0, 0));
+        stations[i].push_back(Vec3(0, .1, .05));
+        stations[i].push_back(Vec3(-.05, 0, .1));
+        weights[i].resize(3, 1);
+    }
+    // This station is ignored; its targets will be wrong.
+    stations[2].push_back(Vec3(.2, .2, .2));
+    weights[2].push_back(0);
+
+    // Generate the targets from a smooth motion.
+    const int NumFrames = 30;
+    const Vector q0 = s.getQ();
+    Array_<Array_<Array_<Vec3> > > targetTrajectory(NumFrames);
+    Array_<State> expected(NumFrames, s);
+    for (int k = 0; k < NumFrames; ++k) {
+        State& sk = expected[k];
+        for (int i = 0; i < sk.getNQ(); ++i)
+            sk.updQ()[i] = q0[i] + Real(0.3)*std::sin(Real(0.05)*k + i);
+        mbs.realize(sk, Stage::Time);
+        matter.normalizeQuaternions(sk);
+        mbs.realize(sk, Stage::Position);
+        targetTrajectory[k].resize(bodyIxs.size());
+        for (int i = 0; i < (int)bodyIxs.size(); ++i) {
+            const MobilizedBody& mobod = matter.getMobilizedBody(bodyIxs[i]);
+            for (int j = 0; j < (int)stations[i].size(); ++j)
+                targetTrajectory[k][i].push_back(mobod.getBodyTransform(sk)*stations[i][j]);
+        }
+        targetTrajectory[k][2].back() += Vec3(1, 2, 3);
+    }
+
+    // Frame by frame, starting near the answer for the first frame.
+    State state = expected[0];
+    state.updQ() += Real(0.02);
+    mbs.realize(state, Stage::Time);
+    matter.normalizeQuaternions(state);
+    for (int k = 0; k < NumFrames; ++k) {
+        const Real err = ObservedPointFitter::refineFit(mbs, state, bodyIxs, stations, targetTrajectory[k], weights, TOL);
+        SimTK_TEST(err < TOL);
+        SimTK_TEST_EQ_TOL(err, calcRMSError(mbs, state, bodyIxs, stations, targetTrajectory[k], weights), 1e-12);
+        for (int i = 0; i < (int)bodyIxs.size(); ++i) {
+            const MobilizedBody& mobod = matter.getMobilizedBody(bodyIxs[i]);
+            SimTK_TEST_EQ_TOL(mobod.getBodyTransform(state), mobod.getBodyTransform(expected[k]), 10*TOL);
+        }
+    }
+
+    // The whole trajectory, with one and with several threads. The first
+    // frame of each thread's segment is solved by findBestFit() from scratch,
+    // which is less precise; the rest are refined from the frame before.
+    for (int numThreads = 1; numThreads <= 3; numThreads += 2) {
+        Array_<State> states;
+        Array_<Real> errors;
+        ObservedPointFitter::findBestFitTrajectory(mbs, s, bodyIxs, stations, targetTrajectory, weights, states, errors, TOL, numThreads);
+        SimTK_TEST(states.size() == NumFrames && errors.size() == NumFrames);
+        for (int k = 0; k < NumFrames; ++k) {
+            const bool segmentStart = (k*numThreads) % NumFrames == 0;
+            SimTK_TEST(errors[k] < (segmentStart ? Real(0.03) : TOL));
+            SimTK_TEST_EQ_TOL(errors[k], calcRMSError(mbs, states[k], bodyIxs, stations, targetTrajectory[k], weights), 1e-6);
+        }
+    }
+}
+
+// Start a Ball mobilizer that uses Euler angles next to gimbal lock, far from
+// the targets, so that the first Levenberg-Marquardt steps are rejected and
+// the fitter must recover from the restored q's.
+static void testRejectedSteps() {
+    MultibodySystem mbs;
+    SimbodyMatterSubsystem matter(mbs);
+    Body::Rigid body = Body::Rigid(MassProperties(1, Vec3(0), Inertia(1)));
+    MobilizedBody::Ball ball(matter.Ground(), Transform(), body, Transform());
+    State state = mbs.realizeTopology();
+    matter.setUseEulerAngles(state, true);
+    mbs.realizeModel(state);
+
+    Array_<MobilizedBodyIndex> bodyIxs(1, ball.getMobilizedBodyIndex());
+    Array_<Array_<Vec3> > stations(1);
+    Array_<Array_<Real> > weights(1);
+    stations[0].push_back(Vec3(1, 0, 0));
+    stations[0].push_back(Vec3(0, 1, 0));
+    stations[0].push_back(Vec3(0, 0, 1));
+    weights[0].resize(3, 1);
+
+    const Rotation R_GB(BodyRotationSequence, Real(2.5), XAxis, 
+                        Real(-1), YAxis, Real(2), ZAxis);
+    Array_<Array_<Vec3> > targetLocations(1);
+    for (int j = 0; j < 3; ++j)
+        targetLocations[0].push_back(R_GB*stations[0][j]);
+
+    ball.setQToFitRotation(state, Rotation());
+    state.updQ()[1] = Pi/2 - Real(1e-3);
+    const Real err = ObservedPointFitter::refineFit(mbs, state, bodyIxs, stations, targetLocations, weights, TOL);
+    SimTK_TEST(err < TOL);
+    SimTK_TEST_EQ_TOL(err, calcRMSError(mbs, state, bodyIxs, stations, targetLocations, weights), 1e-12);
+    SimTK_TEST_EQ_TOL(ball.getBodyRotation(state), R_GB, 10*TOL);
+}
+
 int main() {
     SimTK_START_TEST("TestObservedPointFitter");
         SimTK_SUBTEST(testUnconstrained);
         SimTK_SUBTEST(testConstrained);
+        SimTK_SUBTEST(testTrajectory);
+        SimTK_SUBTEST(testRejectedSteps);
     SimTK_END_TEST();
 }
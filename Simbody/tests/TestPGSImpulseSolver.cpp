@@ -0,0 +1,180 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Check warm starting, multithreaded sweeps, and stats of the PGS impulse
+// solver on a synthetic problem with many frictional contacts.
+
+#include "SimTKsimbody.h"
+#include "SimTKcommon/Testing.h"
+
+using namespace SimTK;
+using namespace std;
+
+// A set of free bodies, each touching the ground at one or two frictional
+// contacts.
+// Each contact has multipliers (Fx, Fy, N) whose constraint Jacobian rows
+// involve only the 6 mobilities of its body, so contacts on different bodies
+// are uncoupled. A = G ~G (unit mass matrix).
+struct ContactProblem {
+    ContactProblem(int nBodies, int contactsPerBody, Real mu) {
+        assert(contactsPerBody==1 || contactsPerBody==2);
+        Random::Uniform rand(-1, 1); rand.setSeed(17);
+        const int nc = nBodies*contactsPerBody, m = 3*nc;
+        Matrix G(m, 6*nBodies, Real(0));
+        for (int k=0; k < nc; ++k) {
+            const int body = k / contactsPerBody;
+            const int first = 6*body + 3*(k % 2);
+            for (int i=0; i < 3; ++i) {
+                for (int j=0; j < 6; ++j)
+                    G(3*k+i, 6*body+j) = 0.3*rand.getValue();
+                G(3*k+i, first+i) += 1; // keep A well conditioned
+            }
+        }
+        A = G*~G;
+        D.resize(m); D = 1e-3;
+        verr.resize(m);
+        for (int k=0; k < nc; ++k) {
+            verr[3*k]   = rand.getValue();              // sliding
+            verr[3*k+1] = rand.getValue();
+            verr[3*k+2] = rand.getValue() - 0.5;        // mostly approaching
+        }
+        for (int k=0; k < nc; ++k) {
+            uniContact.push_back();
+            ImpulseSolver::UniContactRT& rt = uniContact.back();
+            rt.m_ucx = UnilateralContactIndex(k);
+            rt.m_Fk.push_back(MultiplierIndex(3*k));
+            rt.m_Fk.push_back(MultiplierIndex(3*k+1));
+            rt.m_Nk = MultiplierIndex(3*k+2);
+            rt.m_type = ImpulseSolver::Participating;
+            rt.m_effMu = mu;
+            for (int i=0; i < 3; ++i)
+                participating.push_back(MultiplierIndex(3*k+i));
+        }
+    }
+
+    // Returns the impulse; verr is left unchanged.
+    Vector solve(const PGSImpulseSolver& solver, int phase=0) {
+        Vector piExpand(A.nrow(), Real(0)), verrStart(verr), verrApplied, pi;
+        Array_<ImpulseSolver::UncondRT>                 unconditional;
+        Array_<ImpulseSolver::UniSpeedRT>               uniSpeed;
+        Array_<ImpulseSolver::BoundedRT>                bounded;
+        Array_<ImpulseSolver::ConstraintLtdFrictionRT>  consLtdFriction;
+        Array_<ImpulseSolver::StateLtdFrictionRT>       stateLtdFriction;
+        const bool converged = solver.solve(phase, participating, A, D,
+            Array_<MultiplierIndex>(), piExpand, verrStart, verrApplied, pi,
+            unconditional, uniContact, uniSpeed, bounded, consLtdFriction,
+            stateLtdFriction);
+        SimTK_TEST(converged);
+        return pi;
+    }
+
+    Matrix                                  A;
+    Vector                                  D, verr;
+    Array_<MultiplierIndex>                 participating;
+    Array_<ImpulseSolver::UniContactRT>     uniContact;
+};
+
+void testWarmStart() {
+    ContactProblem problem(10, 2, 0.5);
+    PGSImpulseSolver solver(0.01);
+    solver.setMaxIterations(1000);
+    SimTK_TEST(solver.getUseWarmStart());
+
+    const Vector pi0 = problem.solve(solver);
+    const long long coldIters = solver.getNumIterations(0);
+    SimTK_TEST(solver.getNumSolves(0) == 1);
+    SimTK_TEST(solver.getNumFailures(0) == 0);
+    SimTK_TEST(coldIters > 2);
+    SimTK_TEST(solver.getSolveTime(0) > 0);
+
+    // Solving the same problem again should start at the answer.
+    const Vector pi1 = problem.solve(solver);
+    SimTK_TEST(solver.getNumSolves(0) == 2);
+    SimTK_TEST(solver.getNumIterations(0) - coldIters <= 2);
+    SimTK_TEST_EQ_TOL(pi0, pi1, 1e-4);
+
+    // Warm starting is kept separately for each phase.
+    solver.clearStats();
+    problem.solve(solver, 1);
+    SimTK_TEST(solver.getNumIterations(1) == coldIters);
+    SimTK_TEST(solver.getNumSolves(0) == 0);
+
+    // Retaining all the contacts keeps their impulses; retaining none of
+    // them is the same as a cold start.
+    Array_<UnilateralContactIndex> all;
+    for (unsigned k=0; k < problem.uniContact.size(); ++k)
+        all.push_back(problem.uniContact[k].m_ucx);
+    solver.clearStats();
+    solver.retainWarmStart(all);
+    problem.solve(solver);
+    SimTK_TEST(solver.getNumIterations(0) <= 2);
+    solver.clearStats();
+    solver.retainWarmStart(Array_<UnilateralContactIndex>());
+    problem.solve(solver);
+    SimTK_TEST(solver.getNumIterations(0) == coldIters);
+
+    // Forgetting the saved impulses gets us back to a cold start.
+    solver.clearStats();
+    solver.clearWarmStart();
+    problem.solve(solver);
+    SimTK_TEST(solver.getNumIterations(0) == coldIters);
+
+    solver.clearStats();
+    solver.setUseWarmStart(false);
+    problem.solve(solver);
+    problem.solve(solver);
+    SimTK_TEST(solver.getNumIterations(0) == 2*coldIters);
+}
+
+void testParallelSweep() {
+    // Enough contacts per color to use the threads. With friction there can
+    // be many solutions so we compare to the serial sweep only for a 
+    // frictionless problem, which has a unique answer.
+    ContactProblem problem(40, 2, 0.5), frictionless(40, 2, 0);
+    PGSImpulseSolver serial(0.01), two(0.01), four(0.01);
+    for (PGSImpulseSolver* s : {&serial, &two, &four}) {
+        s->setMaxIterations(1000);
+        s->setUseWarmStart(false);
+    }
+    two.setNumThreads(2);
+    four.setNumThreads(4);
+    SimTK_TEST(four.getNumThreads() == 4);
+    SimTK_TEST_MUST_THROW(four.setNumThreads(0));
+
+    // The colored sweep visits contacts in a different order than the
+    // serial one, but the number of threads doesn't matter.
+    const Vector piTwo  = problem.solve(two);
+    const Vector piFour = problem.solve(four);
+    SimTK_TEST((piTwo - piFour).normInf() == 0);
+    SimTK_TEST(two.getNumIterations(0) == four.getNumIterations(0));
+
+    const Vector piSerial = frictionless.solve(serial);
+    SimTK_TEST_EQ_TOL(frictionless.solve(four), piSerial, 1e-4);
+}
+
+int main() {
+    SimTK_START_TEST("TestPGSImpulseSolver");
+        SimTK_SUBTEST(testWarmStart);
+        SimTK_SUBTEST(testParallelSweep);
+    SimTK_END_TEST();
+}
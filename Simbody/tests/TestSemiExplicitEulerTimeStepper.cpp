@@ -0,0 +1,348 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Drop several boxes onto the ground, each touching at its four lower
+// corners. The boxes don't interact so each is a separate island for the 
+// impulse solver. Check that they come to rest, and that solving the 
+// islands on several threads gives the same answer as solving them serially.
+
+#include "SimTKsimbody.h"
+#include "SimTKcommon/Testing.h"
+
+using namespace SimTK;
+using namespace std;
+
+static const int  NumBoxes = 5;
+static const Vec3 HalfDims(.1, .05, .2);
+
+struct BoxesOnGround {
+    BoxesOnGround() : matter(system), forces(system),
+        gravity(forces, matter, -ZAxis, 9.81)
+    {
+        const Body::Rigid boxBody(MassProperties(1, Vec3(0), 
+                                  UnitInertia::brick(HalfDims)));
+        for (int b=0; b < NumBoxes; ++b) {
+            boxes.push_back(MobilizedBody::Free(matter.Ground(), 
+                                                Vec3(b,0,0), boxBody, Vec3(0)));
+            for (int i=-1; i<=1; i+=2)
+            for (int j=-1; j<=1; j+=2) {
+                const Vec3 pt = Vec3(i,j,-1).elementwiseMultiply(HalfDims);
+                matter.adoptUnilateralContact(new PointPlaneContact
+                   (matter.updGround(), ZAxis, 0., boxes.back(), pt, 
+                    0., .8, .5, 0.));
+            }
+        }
+        system.realizeTopology();
+    }
+
+    State getInitialState() const {
+        State state = system.getDefaultState();
+        for (int b=0; b < NumBoxes; ++b) {
+            boxes[b].setQToFitTranslation(state, 
+                Vec3(0, .01*b, HalfDims[2] + .02*(b+1)));
+            boxes[b].setUToFitLinearVelocity(state, Vec3(.3*b, -.1, 0));
+            boxes[b].setUToFitAngularVelocity(state, Vec3(0, 0, .5*b));
+        }
+        return state;
+    }
+
+    MultibodySystem                 system;
+    SimbodyMatterSubsystem          matter;
+    GeneralForceSubsystem           forces;
+    Force::Gravity                  gravity;
+    Array_<MobilizedBody::Free>     boxes;
+};
+
+static Vector simulate(const BoxesOnGround& model, 
+                       SemiExplicitEulerTimeStepper::ImpulseSolverType type,
+                       int numThreads, Real finalTime) {
+    SemiExplicitEulerTimeStepper ts(model.system);
+    ts.setImpulseSolverType(type);
+    ts.setNumThreads(numThreads);
+    ts.setAccuracy(1e-3);
+    ts.setConstraintTolerance(1e-4);
+    ts.initialize(model.getInitialState());
+    const Real h = .005;
+    for (int i=1; h*i <= finalTime + h/2; ++i)
+        ts.stepTo(h*i);
+    const State& state = ts.getState();
+    Vector result(state.getNQ() + state.getNU());
+    result(0, state.getNQ()) = state.getQ();
+    result(state.getNQ(), state.getNU()) = state.getU();
+    return result;
+}
+
+void testBoxesComeToRest() {
+    BoxesOnGround model;
+    SemiExplicitEulerTimeStepper ts(model.system);
+    ts.setImpulseSolverType(SemiExplicitEulerTimeStepper::PLUS);
+    ts.initialize(model.getInitialState());
+    const Real h = .005;
+    for (int i=1; i <= 300; ++i)
+        ts.stepTo(h*i);
+    const State& state = ts.getState();
+    for (int b=0; b < NumBoxes; ++b) {
+        const Transform& X_GB = model.boxes[b].getBodyTransform(state);
+        SimTK_TEST_EQ_TOL(X_GB.p()[2], HalfDims[2], 1e-2);
+        SimTK_TEST_EQ_TOL(model.boxes[b].getBodyVelocity(state), 
+                          SpatialVec(Vec3(0)), 1e-2);
+    }
+}
+
+void testThreadedIslands() {
+    BoxesOnGround model;
+    for (int type=0; type < 2; ++type) {
+        const SemiExplicitEulerTimeStepper::ImpulseSolverType solverType =
+            type==0 ? SemiExplicitEulerTimeStepper::PLUS 
+                    : SemiExplicitEulerTimeStepper::PGS;
+        const Vector serial   = simulate(model, solverType, 1, .5);
+        const Vector threaded = simulate(model, solverType, 3, .5);
+        SimTK_TEST_EQ_TOL(serial, threaded, 1e-12);
+    }
+}
+
+// A PGS solver that counts the copies made of it.
+static int numClones = 0;
+class CountingSolver : public PGSImpulseSolver {
+public:
+    explicit CountingSolver(Real roll2slip) : PGSImpulseSolver(roll2slip) {}
+    CountingSolver* clone() const override {
+        ++numClones;
+        CountingSolver* copy = new CountingSolver(*this);
+        copy->clearStats();
+        return copy;
+    }
+};
+
+// The copies of the solver used on other threads are made once, and again
+// only when the solver settings or the number of threads change.
+void testSolverClonesReused() {
+    BoxesOnGround model;
+    SemiExplicitEulerTimeStepper ts(model.system);
+    ts.setImpulseSolver(new CountingSolver(.01));
+    ts.setNumThreads(3);
+    ts.initialize(model.getInitialState());
+    numClones = 0;
+    const Real h = .005;
+    int step = 0;
+    while (step < 60) ts.stepTo(h*++step);
+    SimTK_TEST(numClones == 2);
+
+    ts.updImpulseSolver().setMaxIterations(50);
+    while (step < 70) ts.stepTo(h*++step);
+    SimTK_TEST(numClones == 4);
+
+    ts.setNumThreads(2);
+    while (step < 80) ts.stepTo(h*++step);
+    SimTK_TEST(numClones == 5);
+}
+
+// Scheduled and triggered events are handled at the end of the step in which
+// they occur, and a handler's request to terminate ends the simulation.
+class CountingPeriodicHandler : public PeriodicEventHandler {
+public:
+    explicit CountingPeriodicHandler(Real interval) 
+    :   PeriodicEventHandler(interval), count(0) {}
+    void handleEvent(State&, Real, bool&) const override {++count;}
+    mutable int count;
+};
+
+// Counts the times a body's height drops through a given level.
+class LevelCrossingHandler : public TriggeredEventHandler {
+public:
+    LevelCrossingHandler(const MobilizedBody& body, Real level)
+    :   TriggeredEventHandler(Stage::Position), body(body), level(level),
+        count(0), time(NaN) 
+    {   getTriggerInfo().setTriggerOnRisingSignTransition(false); }
+    Real getValue(const State& state) const override
+    {   return body.getBodyOriginLocation(state)[1] - level; }
+    void handleEvent(State& state, Real, bool&) const override
+    {   ++count; time = state.getTime(); }
+    const MobilizedBody& body;
+    Real level;
+    mutable int count;
+    mutable Real time;
+};
+
+class TerminateHandler : public ScheduledEventHandler {
+public:
+    explicit TerminateHandler(Real time) : time(time) {}
+    Real getNextEventTime(const State& state, bool includeCurrentTime) 
+        const override
+    {   return time > state.getTime() 
+               || (includeCurrentTime && time == state.getTime())
+               ? time : Infinity; }
+    void handleEvent(State&, Real, bool& shouldTerminate) const override
+    {   shouldTerminate = true; }
+    Real time;
+};
+
+void testEvents() {
+    MultibodySystem         system;
+    SimbodyMatterSubsystem  matter(system);
+    GeneralForceSubsystem   forces(system);
+    Force::Gravity          gravity(forces, matter, -YAxis, 9.81);
+    MobilizedBody::Slider   body(matter.Ground(), Rotation(Pi/2, ZAxis),
+        Body::Rigid(MassProperties(1, Vec3(0), UnitInertia(1))), 
+        Rotation(Pi/2, ZAxis));
+    CountingPeriodicHandler* periodic = new CountingPeriodicHandler(.1);
+    LevelCrossingHandler* crossing = new LevelCrossingHandler(body, .5);
+    system.addEventHandler(periodic);
+    system.addEventHandler(crossing);
+    system.addEventHandler(new TerminateHandler(.395));
+    system.realizeTopology();
+
+    // The body falls from height 1, passing .5 at t=sqrt(1/9.81)=.319.
+    State state = system.getDefaultState();
+    body.setOneQ(state, 0, 1);
+    SemiExplicitEulerTimeStepper ts(system);
+    ts.initialize(state);
+    const Real h = .01;
+    int step = 0;
+    while (ts.stepTo(h*++step) != Integrator::EndOfSimulation)
+        SimTK_TEST(step < 100);
+
+    SimTK_TEST(ts.isSimulationOver());
+    SimTK_TEST_EQ(ts.getTime(), h*40);
+    SimTK_TEST(periodic->count == 3);
+    SimTK_TEST(crossing->count == 1);
+    SimTK_TEST(std::sqrt(1/9.81) <= crossing->time 
+               && crossing->time <= std::sqrt(1/9.81) + h);
+    SimTK_TEST_MUST_THROW(ts.stepTo(h*++step));
+
+    // Initializing starts the simulation over.
+    ts.initialize(state);
+    SimTK_TEST(!ts.isSimulationOver());
+    SimTK_TEST(ts.stepTo(h) == Integrator::ReachedScheduledEvent);
+}
+
+// A ball resting on the ground is put to sleep by a SleepingSubsystem. While
+// it sleeps its contact with the ground gets no impulse and is left disabled;
+// another ball sliding into it wakes it up.
+static const Real Radius = .1;
+struct SleepingBalls {
+    SleepingBalls() : matter(system), forces(system), tracker(system),
+        sleeping(system, tracker), gravity(forces, matter, -YAxis, 9.81)
+    {
+        matter.Ground().updBody().addContactSurface(
+            Transform(Rotation(-Pi/2, ZAxis), Vec3(0)),
+            ContactSurface(ContactGeometry::HalfSpace(), ContactMaterial()));
+        Body::Rigid ballBody(MassProperties(1, Vec3(0), 
+                                            UnitInertia::sphere(Radius)));
+        ballBody.addContactSurface(Transform(),
+            ContactSurface(ContactGeometry::Sphere(Radius), ContactMaterial()));
+        // The second one is the projectile.
+        for (int i=0; i < 2; ++i) {
+            balls.push_back(MobilizedBody::Free(matter.Ground(), 
+                Vec3(i==0 ? 0 : -2, 0, 0), ballBody, Vec3(0)));
+            groundContacts.push_back(matter.adoptUnilateralContact(
+                new SpherePlaneContact(matter.updGround(), YAxis, 0., 
+                                       balls.back(), Vec3(0), Radius, 
+                                       0., 0., 0., 0.)));
+        }
+        matter.adoptUnilateralContact(new SphereSphereContact
+           (balls[0], Vec3(0), Radius, balls[1], Vec3(0), Radius, 
+            0., 0., 0., 0.));
+        sleeping.setSleepDelay(0.2).setCheckInterval(0.05);
+        system.realizeTopology();
+    }
+
+    State getInitialState() const {
+        State state = system.getDefaultState();
+        for (int i=0; i < 2; ++i)
+            balls[i].setQToFitTranslation(state, Vec3(0, Radius + .01, 0));
+        return state;
+    }
+
+    bool isGroundContactLocked(const State& state, int i) const {
+        return matter.getUnilateralContact(groundContacts[i])
+                     .isLocked(state);
+    }
+
+    bool isGroundContactEnabled(const State& state, int i) const {
+        return matter.getUnilateralContact(groundContacts[i])
+                     .isEnabled(state);
+    }
+
+    MultibodySystem                 system;
+    SimbodyMatterSubsystem          matter;
+    GeneralForceSubsystem           forces;
+    ContactTrackerSubsystem         tracker;
+    SleepingSubsystem               sleeping;
+    Force::Gravity                  gravity;
+    Array_<MobilizedBody::Free>     balls;
+    Array_<UnilateralContactIndex>  groundContacts;
+};
+
+void testSleepingBodies() {
+    SleepingBalls model;
+    const SleepingSubsystem& sleeping = model.sleeping;
+    SemiExplicitEulerTimeStepper ts(model.system);
+    ts.initialize(model.getInitialState());
+    const Real h = .005;
+    int step = 0;
+    while (step < 200) ts.stepTo(h*++step);
+
+    SimTK_TEST(sleeping.getNumSleepingBodies(ts.getState()) == 2);
+    for (int i=0; i < 2; ++i) {
+        SimTK_TEST(model.balls[i].isLocked(ts.getState()));
+        SimTK_TEST(model.isGroundContactLocked(ts.getState(), i));
+        SimTK_TEST(!model.isGroundContactEnabled(ts.getState(), i));
+    }
+    const Vec3 restingPosition = 
+        model.balls[0].getBodyOriginLocation(ts.getState());
+    SimTK_TEST_EQ_TOL(restingPosition[1], Radius, 1e-3);
+
+    // Send the projectile towards the resting ball, which goes back to sleep
+    // while it is on its way.
+    State state = ts.getState();
+    sleeping.wakeAll(state);
+    model.balls[1].setUToFitLinearVelocity(state, Vec3(2,0,0));
+    ts.initialize(state);
+    SimTK_TEST(!model.isGroundContactLocked(ts.getState(), 1));
+    while (step < 300) {
+        ts.stepTo(h*++step);
+        SimTK_TEST(model.isGroundContactEnabled(ts.getState(), 1));
+    }
+    SimTK_TEST(sleeping.isAsleep(ts.getState(), model.balls[0]));
+    SimTK_TEST(!model.isGroundContactEnabled(ts.getState(), 0));
+    SimTK_TEST_EQ(model.balls[0].getBodyOriginLocation(ts.getState()),
+                  restingPosition);
+
+    while (step < 500) ts.stepTo(h*++step);
+    SimTK_TEST(!sleeping.isAsleep(ts.getState(), model.balls[0]));
+    SimTK_TEST(!model.isGroundContactLocked(ts.getState(), 0));
+    SimTK_TEST(model.isGroundContactEnabled(ts.getState(), 0));
+    SimTK_TEST(model.balls[0].getBodyOriginLocation(ts.getState())[0] 
+               > restingPosition[0] + Radius);
+}
+
+int main() {
+    SimTK_START_TEST("TestSemiExplicitEulerTimeStepper");
+        SimTK_SUBTEST(testBoxesComeToRest);
+        SimTK_SUBTEST(testThreadedIslands);
+        SimTK_SUBTEST(testSolverClonesReused);
+        SimTK_SUBTEST(testEvents);
+        SimTK_SUBTEST(testSleepingBodies);
+    SimTK_END_TEST();
+}
@@ -0,0 +1,131 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Drop some balls onto a frictionless floor and check that they go to sleep 
+// once they settle, then slide another ball into one of them and check that 
+// it wakes up.
+
+#include "SimTKsimbody.h"
+#include "SimTKcommon/Testing.h"
+
+using namespace SimTK;
+using namespace std;
+
+static const Real Radius = 0.1;
+static const int  NumBalls = 3;
+
+struct BallsOnFloor {
+    BallsOnFloor() : matter(system), forces(system), tracker(system),
+        contact(system, tracker), sleeping(system, tracker),
+        gravity(forces, matter, -YAxis, 9.81)
+    {
+        const ContactMaterial material(1e6, 0.5, 0, 0, 0);
+        matter.Ground().updBody().addContactSurface(
+            Transform(Rotation(-Pi/2, ZAxis), Vec3(0)),
+            ContactSurface(ContactGeometry::HalfSpace(), material));
+        Body::Rigid ballBody(MassProperties(1, Vec3(0), 
+                                            UnitInertia::sphere(Radius)));
+        ballBody.addContactSurface(Transform(),
+            ContactSurface(ContactGeometry::Sphere(Radius), material));
+        // The last one is the projectile.
+        for (int i=0; i <= NumBalls; ++i)
+            balls.push_back(MobilizedBody::Free(matter.Ground(), 
+                Vec3(i==NumBalls ? -2 : i, 0, 0), ballBody, Vec3(0)));
+        sleeping.setSleepDelay(0.2).setCheckInterval(0.05);
+        system.realizeTopology();
+    }
+
+    State getInitialState() const {
+        State state = system.getDefaultState();
+        for (int i=0; i <= NumBalls; ++i)
+            balls[i].setQToFitTranslation(state, 
+                                          Vec3(0, Radius + .02*(i+1), 0));
+        return state;
+    }
+
+    MultibodySystem                 system;
+    SimbodyMatterSubsystem          matter;
+    GeneralForceSubsystem           forces;
+    ContactTrackerSubsystem         tracker;
+    CompliantContactSubsystem       contact;
+    SleepingSubsystem               sleeping;
+    Force::Gravity                  gravity;
+    Array_<MobilizedBody::Free>     balls;
+};
+
+void testSleepAndWake() {
+    BallsOnFloor model;
+    const SleepingSubsystem& sleeping = model.sleeping;
+
+    RungeKuttaMersonIntegrator integ(model.system);
+    integ.setAccuracy(1e-4);
+    TimeStepper ts(model.system, integ);
+    ts.initialize(model.getInitialState());
+    ts.stepTo(2);
+
+    // Everything has settled and gone to sleep.
+    // A sleep check at the final time leaves the state at Instance stage.
+    State state = integ.getState();
+    model.system.realize(state, Stage::Dynamics);
+    SimTK_TEST(sleeping.getNumSleepingBodies(state) == NumBalls+1);
+    for (int i=0; i <= NumBalls; ++i) {
+        SimTK_TEST(sleeping.isAsleep(state, model.balls[i]));
+        SimTK_TEST(model.tracker.isBodyAsleep(state, model.balls[i]));
+        SimTK_TEST(model.balls[i].isLocked(state));
+        SimTK_TEST_EQ(model.balls[i].getBodyVelocity(state), SpatialVec(Vec3(0)));
+    }
+    // Contacts among sleeping bodies and Ground aren't tracked, but they are
+    // carried over unchanged, so they are still active; they produce no force.
+    SimTK_TEST(model.tracker.getActiveContacts(state).getNumContacts() 
+               == NumBalls+1);
+    SimTK_TEST(model.contact.getNumContactForces(state) == 0);
+
+    // Now send the projectile towards the first ball. The others go back to
+    // sleep while it is on its way.
+    sleeping.wakeAll(state);
+    SimTK_TEST(sleeping.getNumSleepingBodies(state) == 0);
+    SimTK_TEST(!model.balls[0].isLocked(state));
+    model.balls[NumBalls].setUToFitLinearVelocity(state, Vec3(2,0,0));
+    const Vec3 restingPosition = 
+        model.balls[0].getBodyOriginLocation(integ.getState());
+    ts.initialize(state);
+    ts.stepTo(2.6);
+    SimTK_TEST(sleeping.getNumSleepingBodies(integ.getState()) == NumBalls);
+    SimTK_TEST(sleeping.isAsleep(integ.getState(), model.balls[0]));
+    SimTK_TEST(!sleeping.isAsleep(integ.getState(), model.balls[NumBalls]));
+
+    ts.stepTo(3.2);
+    state = integ.getState();
+    model.system.realize(state, Stage::Position);
+    SimTK_TEST(!sleeping.isAsleep(state, model.balls[0]));
+    SimTK_TEST(model.balls[0].getBodyOriginLocation(state)[0] 
+               > restingPosition[0] + Radius);
+    // The other balls weren't disturbed.
+    SimTK_TEST(sleeping.isAsleep(state, model.balls[1]));
+}
+
+int main() {
+    SimTK_START_TEST("TestSleepingSubsystem");
+        SimTK_SUBTEST(testSleepAndWake);
+    SimTK_END_TEST();
+}
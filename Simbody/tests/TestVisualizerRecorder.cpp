@@ -0,0 +1,185 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+// Check that a recording Visualizer writes a complete, correctly indexed
+// file without needing the simbody-visualizer display.
+
+#include "SimTKsimbody.h"
+#include "SimTKcommon/Testing.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace SimTK;
+using namespace std;
+
+// These must match the protocol definitions in VisualizerProtocol.h.
+static const unsigned char StartOfScene = 2;
+static const unsigned char EndOfScene   = 3;
+
+static vector<unsigned char> readWholeFile(const string& fileName) {
+    vector<unsigned char> data;
+    FILE* file = fopen(fileName.c_str(), "rb");
+    SimTK_TEST(file != nullptr);
+    unsigned char buffer[4096];
+    size_t n;
+    while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        data.insert(data.end(), buffer, buffer + n);
+    fclose(file);
+    return data;
+}
+
+static long long getLongLong(const vector<unsigned char>& data, size_t pos) {
+    long long value;
+    memcpy(&value, &data[pos], sizeof(long long));
+    return value;
+}
+
+void testRecording() {
+    const string fileName = "TestVisualizerRecorder.simviz";
+    const int NumFrames = 7;
+
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    GeneralForceSubsystem forces(system);
+    Force::Gravity gravity(forces, matter, -YAxis, 9.8);
+    Body::Rigid body(MassProperties(1, Vec3(0), UnitInertia(1)));
+    body.addDecoration(Transform(), DecorativeBrick(Vec3(.1, .2, .3)));
+    MobilizedBody::Pin pendulum(matter.Ground(), Transform(Vec3(0)),
+                                body, Transform(Vec3(0, 1, 0)));
+
+    {
+        Visualizer viz = Visualizer::createRecorder(system, fileName);
+        SimTK_TEST(viz.isRecording());
+        // A user mesh makes the recording contain a mesh definition too.
+        viz.addDecoration(MobilizedBodyIndex(0), Transform(),
+            DecorativeMesh(PolygonalMesh::createSphereMesh(1, 2)));
+        viz.setBackgroundColor(Blue);
+
+        State state = system.realizeTopology();
+        for (int i=0; i < NumFrames; ++i) {
+            state.updTime() = 0.1*i;
+            pendulum.setAngle(state, 0.1*i);
+            viz.report(state);
+        }
+        // The last reference to the Visualizer goes away here, which
+        // completes the file.
+    }
+
+    const vector<unsigned char> data = readWholeFile(fileName);
+    SimTK_TEST(data.size() > 32);
+    SimTK_TEST(memcmp(&data[0], "SimTKviz", 8) == 0);
+    SimTK_TEST(memcmp(&data[data.size()-8], "SimTKidx", 8) == 0);
+
+    const size_t footerPos = data.size() - 24;
+    const long long numFrames = getLongLong(data, footerPos);
+    const long long indexPos  = getLongLong(data, footerPos + 8);
+    SimTK_TEST(numFrames == NumFrames);
+    SimTK_TEST(indexPos + 8*numFrames == (long long)footerPos);
+
+    // Every indexed offset must point at a complete frame.
+    long long prevFrameEnd = 0;
+    for (int i=0; i < numFrames; ++i) {
+        const long long offset = getLongLong(data, (size_t)(indexPos + 8*i));
+        SimTK_TEST(offset >= prevFrameEnd);
+        SimTK_TEST(data[(size_t)offset] == StartOfScene);
+        unsigned frameSize;
+        memcpy(&frameSize, &data[(size_t)offset + 1], sizeof(unsigned));
+        const long long frameEnd = offset + 1 + sizeof(unsigned) + frameSize;
+        SimTK_TEST(frameEnd <= indexPos);
+        SimTK_TEST(data[(size_t)frameEnd - 1] == EndOfScene);
+        float simTime;
+        memcpy(&simTime, &data[(size_t)offset + 1 + sizeof(unsigned)],
+               sizeof(float));
+        SimTK_TEST_EQ_TOL(simTime, 0.1*i, 1e-6);
+        prevFrameEnd = frameEnd;
+    }
+
+    remove(fileName.c_str());
+}
+
+void testShutdownCompletesRecording() {
+    const string fileName = "TestVisualizerRecorderShutdown.simviz";
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    Visualizer viz = Visualizer::createRecorder(system, fileName);
+    State state = system.realizeTopology();
+    viz.report(state);
+    viz.shutdown();
+    viz.report(state); // ignored
+
+    const vector<unsigned char> data = readWholeFile(fileName);
+    SimTK_TEST(memcmp(&data[data.size()-8], "SimTKidx", 8) == 0);
+    SimTK_TEST(getLongLong(data, data.size()-24) == 1);
+    remove(fileName.c_str());
+}
+
+// Meshes used to be limited to 65535 vertices; make sure a bigger one can
+// be sent now.
+void testLargeMesh() {
+    const string fileName = "TestVisualizerRecorderLargeMesh.simviz";
+    const int N = 300; // N*N vertices
+    PolygonalMesh grid;
+    for (int i=0; i < N; ++i)
+        for (int j=0; j < N; ++j)
+            grid.addVertex(Vec3(i, j, 0));
+    for (int i=0; i < N-1; ++i)
+        for (int j=0; j < N-1; ++j) {
+            Array_<int> quad;
+            quad.push_back(i*N+j);     quad.push_back((i+1)*N+j);
+            quad.push_back((i+1)*N+j+1); quad.push_back(i*N+j+1);
+            grid.addFace(quad);
+        }
+    SimTK_TEST(grid.getNumVertices() > 65535);
+
+    MultibodySystem system;
+    SimbodyMatterSubsystem matter(system);
+    {
+        Visualizer viz = Visualizer::createRecorder(system, fileName);
+        // Several instances of the same mesh.
+        for (int i=0; i < 3; ++i)
+            viz.addDecoration(MobilizedBodyIndex(0), Vec3(0, 0, i),
+                              DecorativeMesh(grid));
+        State state = system.realizeTopology();
+        viz.report(state);
+        viz.report(state);
+    }
+    const vector<unsigned char> data = readWholeFile(fileName);
+    // The mesh is defined only once even though it is drawn six times; a
+    // definition is 3 floats per vertex plus a count and 4 indices per quad.
+    const size_t meshSize = (size_t)N*N*3*sizeof(float) 
+                            + (size_t)(N-1)*(N-1)*5*sizeof(unsigned);
+    SimTK_TEST(data.size() > meshSize);
+    SimTK_TEST(data.size() < meshSize + 10000);
+    SimTK_TEST(getLongLong(data, data.size()-24) == 2);
+    remove(fileName.c_str());
+}
+
+int main() {
+    SimTK_START_TEST("TestVisualizerRecorder");
+        SimTK_SUBTEST(testRecording);
+        SimTK_SUBTEST(testShutdownCompletesRecording);
+        SimTK_SUBTEST(testLargeMesh);
+    SimTK_END_TEST();
+}
@@ -0,0 +1,132 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Report how many frames per second Assembler::track() can follow a moving
+set of marker and orientation sensor observations on a 10-body chain, with
+the observations as goals and with the markers as requirements (which uses
+their error Jacobians). */
+
+#include "SimTKsimbody.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+static const int NumBodies = 10;
+static const int NumFrames = 500;
+
+struct Chain {
+    Chain() : matter(system) {
+        Body::Rigid body(MassProperties(1.0, Vec3(0), Inertia(1)));
+        MobilizedBody parent = matter.Ground();
+        for (int i=0; i < NumBodies; ++i) {
+            parent = MobilizedBody::Ball(parent, Vec3(0,-.5,0),
+                                         body, Vec3(0,.5,0));
+            links.push_back(parent);
+        }
+        system.realizeTopology();
+    }
+
+    State getState(Real t) const {
+        State state = system.getDefaultState();
+        matter.setUseEulerAngles(state, true);
+        system.realizeModel(state);
+        for (int i=0; i < state.getNQ(); ++i)
+            state.updQ()[i] = Real(0.3)*std::sin(Real(i+1) + t);
+        system.realize(state, Stage::Position);
+        return state;
+    }
+
+    MultibodySystem         system;
+    SimbodyMatterSubsystem  matter;
+    Array_<MobilizedBody>   links;
+};
+
+static void trackFrames(const char* label, bool markersRequired) {
+    Chain chain;
+    Markers* markers = new Markers();
+    OrientationSensors* osensors = new OrientationSensors();
+    // As requirements, only every other body is marked to leave the
+    // optimizer some freedom.
+    for (int i=0; i < NumBodies; ++i) {
+        if (!markersRequired || i%2 == 0)
+            markers->addMarker(chain.links[i].getMobilizedBodyIndex(),
+                               Vec3(.1, 0, .1));
+        if (!markersRequired)
+            osensors->addOSensor("", chain.links[i].getMobilizedBodyIndex(),
+                                 Rotation());
+    }
+    Array_<Markers::MarkerIx> mOrder;
+    for (Markers::MarkerIx mx(0); mx < markers->getNumMarkers(); ++mx)
+        mOrder.push_back(mx);
+    markers->defineObservationOrder(mOrder);
+    Array_<OrientationSensors::OSensorIx> oOrder;
+    for (OrientationSensors::OSensorIx ox(0);
+         ox < osensors->getNumOSensors(); ++ox)
+        oOrder.push_back(ox);
+    osensors->defineObservationOrder(oOrder);
+
+    Assembler assembler(chain.system);
+    assembler.setAccuracy(1e-6);
+    assembler.adoptAssemblyGoal(markers, markersRequired ? Infinity : 1);
+    if (!markersRequired)
+        assembler.adoptAssemblyGoal(osensors);
+    else
+        delete osensors;
+
+    const double start = realTime();
+    for (int frame=0; frame < NumFrames; ++frame) {
+        const State observed = chain.getState(Real(frame)/100);
+        Markers::ObservationIx mox(0);
+        for (int i=0; i < NumBodies; ++i) {
+            const MobilizedBody& body = chain.links[i];
+            if (!markersRequired || i%2 == 0)
+                markers->moveOneObservation(mox++,
+                    body.findStationLocationInGround(observed,Vec3(.1,0,.1)));
+            if (!markersRequired)
+                osensors->moveOneObservation
+                   (OrientationSensors::ObservationIx(i),
+                    body.getBodyRotation(observed));
+        }
+        if (frame == 0) {
+            assembler.initialize(chain.getState(0.05));
+            assembler.assemble();
+        } else
+            assembler.track();
+    }
+    const double elapsed = realTime() - start;
+    printf("%-24s %8.1f frames/s (%d frames, %lld assembly steps)\n", label,
+           NumFrames/elapsed, NumFrames,
+           (long long)assembler.getNumAssemblySteps());
+}
+
+int main() {
+    try {
+        trackFrames("markers+sensors as goals", false);
+        trackFrames("markers as requirements", true);
+    } catch (const std::exception& e) {
+        printf("EXCEPTION: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,121 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Compare the cost of recording every q and u of a 20-body chain at a high
+rate with TextDataEventReporter (written to a file) and with
+BinaryDataEventReporter, against the same simulation with a reporter that
+does nothing (which still makes the integrator stop at every report time). */
+
+#include "SimTKsimbody.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+using namespace SimTK;
+
+static const int  NumBodies = 20;
+static const Real ReportInterval = 0.0002;
+static const Real FinalTime = 2;
+
+// Returns all the q's followed by all the u's.
+class QAndU : public TextDataEventReporter::UserFunction<Vector> {
+public:
+    Vector evaluate(const System&, const State& state) override {
+        Vector qu(state.getNQ() + state.getNU());
+        qu(0, state.getNQ()) = state.getQ();
+        qu(state.getNQ(), state.getNU()) = state.getU();
+        return qu;
+    }
+};
+
+class NullReporter : public PeriodicEventReporter {
+public:
+    explicit NullReporter(Real interval) : PeriodicEventReporter(interval) {}
+    void handleEvent(const State&) const override {}
+};
+
+enum Output {None, Text, Binary};
+
+static void simulate(const char* label, Output output) {
+    MultibodySystem         system;
+    SimbodyMatterSubsystem  matter(system);
+    GeneralForceSubsystem   forces(system);
+    Force::Gravity          gravity(forces, matter, -YAxis, 9.8);
+    Body::Rigid body(MassProperties(1.0, Vec3(0), Inertia(1)));
+    MobilizedBody parent = matter.Ground();
+    for (int i=0; i < NumBodies; ++i)
+        parent = MobilizedBody::Ball(parent, Vec3(0,-.5,0),
+                                     body, Vec3(0,.5,0));
+
+    // TextDataEventReporter writes to std::cout; send that to a file.
+    std::ofstream textFile;
+    std::streambuf* coutBuf = std::cout.rdbuf();
+    BinaryDataEventReporter* binary = nullptr;
+    if (output == None)
+        system.addEventReporter(new NullReporter(ReportInterval));
+    else if (output == Text) {
+        textFile.open("BinaryDataReporterBenchmark.txt");
+        std::cout.rdbuf(textFile.rdbuf());
+        system.addEventReporter(
+            new TextDataEventReporter(system, new QAndU(), ReportInterval));
+    } else if (output == Binary) {
+        binary = new BinaryDataEventReporter
+           (system, "BinaryDataReporterBenchmark.bin", ReportInterval);
+        binary->addQ();
+        binary->addU();
+        system.addEventReporter(binary);
+    }
+
+    State state = system.realizeTopology();
+    for (int i=0; i < state.getNQ(); ++i)
+        state.updQ()[i] = Real(0.1)*std::sin(Real(i));
+
+    const double start = realTime();
+    RungeKuttaMersonIntegrator integ(system);
+    integ.setAccuracy(1e-4);
+    TimeStepper ts(system, integ);
+    ts.initialize(state);
+    ts.stepTo(FinalTime);
+    if (binary) binary->close();
+    textFile.close();
+    const double elapsed = realTime() - start;
+    std::cout.rdbuf(coutBuf);
+
+    printf("%-8s %8.3f s (%d reports)\n", label, elapsed,
+           (int)(FinalTime/ReportInterval) + 1);
+}
+
+int main() {
+    try {
+        simulate("none", None);
+        simulate("text", Text);
+        simulate("binary", Binary);
+    } catch (const std::exception& e) {
+        printf("EXCEPTION: %s\n", e.what());
+        return 1;
+    }
+    std::remove("BinaryDataReporterBenchmark.txt");
+    std::remove("BinaryDataReporterBenchmark.bin");
+    return 0;
+}
@@ -0,0 +1,98 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Compare the cost of evaluating a signal built from 20 Plus, Minus, and Scale
+measures on top of a few leaf measures, directly and through a
+Measure::Compiled, after each change of time. */
+
+#include "SimTKsimbody.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+static const int NumLevels = 10;
+static const int NumSamples = 200000;
+
+// Each level adds two measures; the sums alternate the order of their
+// operands.
+static Measure buildSignal(Subsystem& sub, const Measure& t, 
+                           const Measure& x, const Measure& wave) {
+    Measure signal = x;
+    for (int i=0; i < NumLevels; ++i) {
+        const Measure sum = (i%2 == 0) ? Measure(Measure::Plus(sub, signal, t))
+                                       : Measure(Measure::Plus(sub, t, signal));
+        signal = (i%3 == 0) ? Measure(Measure::Minus(sub, sum, wave))
+                            : Measure(Measure::Scale(sub, 0.5, sum));
+    }
+    return signal;
+}
+
+static double timeSamples(const MultibodySystem& system, State& state,
+                          const Measure& m, Real& checksum) {
+    checksum = 0;
+    const double start = realTime();
+    for (int i=0; i < NumSamples; ++i) {
+        state.setTime(i*1e-4);
+        system.realize(state, Stage::Time);
+        checksum += m.getValue(state);
+    }
+    return realTime() - start;
+}
+
+int main() {
+    try {
+        MultibodySystem         system;
+        SimbodyMatterSubsystem  matter(system);
+        GeneralForceSubsystem   forces(system);
+
+        Measure::Time     t(forces);
+        Measure::Variable x(forces, Stage::Time, 0.25);
+        Measure::Sinusoid wave(forces, 2, 5);
+        const Measure signal = buildSignal(forces, t, x, wave);
+        Measure::Compiled compiled(forces, signal);
+
+        State state = system.realizeTopology();
+        printf("%d measures compiled to %d operations on %d leaves\n",
+               2*NumLevels, compiled.getNumOperations(), 
+               compiled.getNumLeaves());
+
+        // Realizing the State alone, for reference.
+        Measure::Constant none(forces, 0);
+        state = system.realizeTopology();
+        Real sumNone, sumDirect, sumCompiled;
+        const double tNone = timeSamples(system, state, none, sumNone);
+        const double tDirect = timeSamples(system, state, signal, sumDirect);
+        const double tCompiled = 
+            timeSamples(system, state, compiled, sumCompiled);
+
+        printf("realize only %8.3f s\n", tNone);
+        printf("direct       %8.3f s\n", tDirect);
+        printf("compiled     %8.3f s\n", tCompiled);
+        printf("checksums %.17g %.17g\n", sumDirect, sumCompiled);
+    } catch (const std::exception& e) {
+        printf("EXCEPTION: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
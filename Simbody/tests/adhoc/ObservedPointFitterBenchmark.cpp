@@ -0,0 +1,103 @@
+/* -------------------------------------------------------------------------- *
+ *                               Simbody(tm)                                  *
+ * -------------------------------------------------------------------------- *
+ * This is part of the SimTK biosimulation toolkit originating from           *
+ * Simbios, the NIH National Center for Physics-Based Simulation of           *
+ * Biological Structures at Stanford, funded under the NIH Roadmap for        *
+ * Medical Research, grant U54 GM072970. See https://simtk.org/home/simbody.  *
+ *                                                                            *
+ * Portions copyright (c) 2026 the Authors.                                   *
+ * Authors: agent                                                             *
+ * Contributors:                                                              *
+ *                                                                            *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may    *
+ * not use this file except in compliance with the License. You may obtain a  *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.         *
+ *                                                                            *
+ * Unless required by applicable law or agreed to in writing, software        *
+ * distributed under the License is distributed on an "AS IS" BASIS,          *
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.   *
+ * See the License for the specific language governing permissions and        *
+ * limitations under the License.                                             *
+ * -------------------------------------------------------------------------- */
+
+/* Report how fast a marker trajectory for a 10-body chain is fit by calling
+ObservedPointFitter::findBestFit() for every frame, and by
+findBestFitTrajectory() with one and with four threads. */
+
+#include "SimTKsimbody.h"
+
+#include <cstdio>
+
+using namespace SimTK;
+
+static const int NumBodies = 10;
+static const int NumFrames = 200;
+
+int main() {
+    try {
+        MultibodySystem system;
+        SimbodyMatterSubsystem matter(system);
+        Body::Rigid body(MassProperties(1.0, Vec3(0), Inertia(1)));
+        Array_<MobilizedBodyIndex> bodyIxs;
+        MobilizedBody parent = matter.Ground();
+        for (int i=0; i < NumBodies; ++i) {
+            parent = MobilizedBody::Ball(parent, Vec3(0,-.5,0),
+                                         body, Vec3(0,.5,0));
+            bodyIxs.push_back(parent.getMobilizedBodyIndex());
+        }
+        State state = system.realizeTopology();
+
+        Array_<Array_<Vec3> > stations(NumBodies);
+        Array_<Array_<Real> > weights(NumBodies);
+        for (int i=0; i < NumBodies; ++i) {
+            stations[i].push_back(Vec3(.1,0,0));
+            stations[i].push_back(Vec3(0,0,.1));
+            stations[i].push_back(Vec3(-.1,.2,0));
+            weights[i].resize(3, 1);
+        }
+
+        Array_<Array_<Array_<Vec3> > > targets(NumFrames);
+        State frame = state;
+        for (int k=0; k < NumFrames; ++k) {
+            for (int i=0; i < frame.getNQ(); ++i)
+                frame.updQ()[i] = state.getQ()[i]
+                                + Real(0.3)*std::sin(Real(0.02)*k + i);
+            system.realize(frame, Stage::Time);
+            matter.normalizeQuaternions(frame);
+            system.realize(frame, Stage::Position);
+            targets[k].resize(NumBodies);
+            for (int i=0; i < NumBodies; ++i)
+                for (const Vec3& station : stations[i])
+                    targets[k][i].push_back(matter.getMobilizedBody(bodyIxs[i])
+                                    .getBodyTransform(frame)*station);
+        }
+
+        double start = realTime();
+        State s = state;
+        Real maxError = 0;
+        for (int k=0; k < NumFrames; ++k)
+            maxError = std::max(maxError, ObservedPointFitter::findBestFit
+                (system, s, bodyIxs, stations, targets[k], weights));
+        printf("%-32s %8.1f frames/s (max error %g)\n",
+               "findBestFit() per frame", NumFrames/(realTime()-start),
+               maxError);
+
+        for (int numThreads = 1; numThreads <= 4; numThreads *= 4) {
+            Array_<State> states;
+            Array_<Real> errors;
+            start = realTime();
+            ObservedPointFitter::findBestFitTrajectory(system, state, bodyIxs,
+                stations, targets, weights, states, errors, 0.001, numThreads);
+            const double elapsed = realTime()-start;
+            maxError = 0;
+            for (Real e : errors) maxError = std::max(maxError, e);
+            printf("findBestFitTrajectory(), %d thr %8.1f frames/s "
+                   "(max error %g)\n", numThreads, NumFrames/elapsed, maxError);
+        }
+    } catch (const std::exception& e) {
+        printf("EXCEPTION: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}